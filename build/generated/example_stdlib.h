@@ -368,193 +368,204 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   0x006c616d69636544,
   (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "compare" (offset=362) */
   0x00657261706d6f63,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "JSON" (offset=364) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "add" (offset=364) */
+  0x0000000000646461,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "sub" (offset=366) */
+  0x0000000000627573,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "mul" (offset=368) */
+  0x00000000006c756d,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "div" (offset=370) */
+  0x0000000000766964,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "quantize" (offset=372) */
+  0x657a69746e617571,
+  0x0000000000000000,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "JSON" (offset=375) */
   0x000000004e4f534a,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "parse" (offset=366) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "parse" (offset=377) */
   0x0000006573726170,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "stringify" (offset=368) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "stringify" (offset=379) */
   0x6669676e69727473,
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "RegExp" (offset=371) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "RegExp" (offset=382) */
   0x0000707845676552,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "lastIndex" (offset=373) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "lastIndex" (offset=384) */
   0x65646e497473616c,
   0x0000000000000078,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "get lastIndex" (offset=376) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "get lastIndex" (offset=387) */
   0x7473616c20746567,
   0x0000007865646e49,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "set lastIndex" (offset=379) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "set lastIndex" (offset=390) */
   0x7473616c20746573,
   0x0000007865646e49,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "source" (offset=382) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "source" (offset=393) */
   0x0000656372756f73,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get source" (offset=384) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get source" (offset=395) */
   0x72756f7320746567,
   0x0000000000006563,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "flags" (offset=387) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "flags" (offset=398) */
   0x0000007367616c66,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get flags" (offset=389) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get flags" (offset=400) */
   0x67616c6620746567,
   0x0000000000000073,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "exec" (offset=392) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "exec" (offset=403) */
   0x0000000063657865,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "test" (offset=394) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "test" (offset=405) */
   0x0000000074736574,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "message" (offset=396) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "message" (offset=407) */
   0x006567617373656d,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "get message" (offset=398) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "get message" (offset=409) */
   0x7373656d20746567,
   0x0000000000656761,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "stack" (offset=401) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "stack" (offset=412) */
   0x0000006b63617473,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get stack" (offset=403) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get stack" (offset=414) */
   0x6361747320746567,
   0x000000000000006b,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "EvalError" (offset=406) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "EvalError" (offset=417) */
   0x6f7272456c617645,
   0x0000000000000072,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "RangeError" (offset=409) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "RangeError" (offset=420) */
   0x72724565676e6152,
   0x000000000000726f,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "ReferenceError" (offset=412) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "ReferenceError" (offset=423) */
   0x636e657265666552,
   0x0000726f72724565,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "SyntaxError" (offset=415) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "SyntaxError" (offset=426) */
   0x72457861746e7953,
   0x0000000000726f72,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "TypeError" (offset=418) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "TypeError" (offset=429) */
   0x6f72724565707954,
   0x0000000000000072,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "URIError" (offset=421) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "URIError" (offset=432) */
   0x726f727245495255,
   0x0000000000000000,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "InternalError" (offset=424) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "InternalError" (offset=435) */
   0x6c616e7265746e49,
   0x000000726f727245,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "ArrayBuffer" (offset=427) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "ArrayBuffer" (offset=438) */
   0x6675427961727241,
   0x0000000000726566,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteLength" (offset=430) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteLength" (offset=441) */
   0x676e654c65747962,
   0x0000000000006874,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteLength" (offset=433) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteLength" (offset=444) */
   0x6574796220746567,
   0x00006874676e654c,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "Uint8ClampedArray" (offset=436) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "Uint8ClampedArray" (offset=447) */
   0x616c4338746e6955,
   0x617272416465706d,
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "TypedArray" (offset=440) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "TypedArray" (offset=451) */
   0x7272416465707954,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteOffset" (offset=443) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteOffset" (offset=454) */
   0x7366664f65747962,
   0x0000000000007465,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteOffset" (offset=446) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteOffset" (offset=457) */
   0x6574796220746567,
   0x000074657366664f,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "buffer" (offset=449) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "buffer" (offset=460) */
   0x0000726566667562,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get buffer" (offset=451) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get buffer" (offset=462) */
   0x6666756220746567,
   0x0000000000007265,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "subarray" (offset=454) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "subarray" (offset=465) */
   0x7961727261627573,
   0x0000000000000000,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "BYTES_PER_ELEMENT" (offset=457) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "BYTES_PER_ELEMENT" (offset=468) */
   0x45505f5345545942,
   0x4e454d454c455f52,
   0x0000000000000054,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "Int8Array" (offset=461) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "Int8Array" (offset=472) */
   0x6172724138746e49,
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Uint8Array" (offset=464) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Uint8Array" (offset=475) */
   0x72724138746e6955,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int16Array" (offset=467) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int16Array" (offset=478) */
   0x7272413631746e49,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint16Array" (offset=470) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint16Array" (offset=481) */
   0x72413631746e6955,
   0x0000000000796172,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int32Array" (offset=473) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int32Array" (offset=484) */
   0x7272413233746e49,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint32Array" (offset=476) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint32Array" (offset=487) */
   0x72413233746e6955,
   0x0000000000796172,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float32Array" (offset=479) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float32Array" (offset=490) */
   0x41323374616f6c46,
   0x0000000079617272,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float64Array" (offset=482) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float64Array" (offset=493) */
   0x41343674616f6c46,
   0x0000000079617272,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "isNaN" (offset=485) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "isNaN" (offset=496) */
   0x0000004e614e7369,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "isFinite" (offset=487) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "isFinite" (offset=498) */
   0x6574696e69467369,
   0x0000000000000000,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "globalThis" (offset=490) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "globalThis" (offset=501) */
   0x68546c61626f6c67,
   0x0000000000007369,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "console" (offset=493) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "console" (offset=504) */
   0x00656c6f736e6f63,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "log" (offset=495) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "log" (offset=506) */
   0x0000000000676f6c,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "performance" (offset=497) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "performance" (offset=508) */
   0x616d726f66726570,
   0x000000000065636e,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "print" (offset=500) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "print" (offset=511) */
   0x000000746e697270,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "Rectangle" (offset=502) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "Rectangle" (offset=513) */
   0x6c676e6174636552,
   0x0000000000000065,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "getClosure" (offset=505) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "getClosure" (offset=516) */
   0x75736f6c43746567,
   0x0000000000006572,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (1 << (JS_MTAG_BITS + 3)), /* "x" (offset=508) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (1 << (JS_MTAG_BITS + 3)), /* "x" (offset=519) */
   0x0000000000000078,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "get x" (offset=510) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "get x" (offset=521) */
   0x0000007820746567,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (1 << (JS_MTAG_BITS + 3)), /* "y" (offset=512) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (1 << (JS_MTAG_BITS + 3)), /* "y" (offset=523) */
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "get y" (offset=514) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "get y" (offset=525) */
   0x0000007920746567,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (15 << (JS_MTAG_BITS + 3)), /* "FilledRectangle" (offset=516) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (15 << (JS_MTAG_BITS + 3)), /* "FilledRectangle" (offset=527) */
   0x655264656c6c6946,
   0x00656c676e617463,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "color" (offset=519) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "color" (offset=530) */
   0x000000726f6c6f63,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get color" (offset=521) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get color" (offset=532) */
   0x6f6c6f6320746567,
   0x0000000000000072,
 
-  /* sorted atom table (offset=524) */
-  JS_VALUE_ARRAY_HEADER(215),
+  /* sorted atom table (offset=535) */
+  JS_VALUE_ARRAY_HEADER(220),
   JS_ROM_VALUE(97), /* empty */
   JS_ROM_VALUE(147), /* _Infinity */
   JS_ROM_VALUE(117), /* _eval_ */
   JS_ROM_VALUE(115), /* _ret_ */
   JS_ROM_VALUE(303), /* Array */
-  JS_ROM_VALUE(427), /* ArrayBuffer */
-  JS_ROM_VALUE(457), /* BYTES_PER_ELEMENT */
+  JS_ROM_VALUE(438), /* ArrayBuffer */
+  JS_ROM_VALUE(468), /* BYTES_PER_ELEMENT */
   JS_ROM_VALUE(246), /* Boolean */
   JS_ROM_VALUE(358), /* Date */
   JS_ROM_VALUE(360), /* Decimal */
   JS_ROM_VALUE(356), /* E */
   JS_ROM_VALUE(228), /* EPSILON */
   JS_ROM_VALUE(152), /* Error */
-  JS_ROM_VALUE(406), /* EvalError */
-  JS_ROM_VALUE(516), /* FilledRectangle */
-  JS_ROM_VALUE(479), /* Float32Array */
-  JS_ROM_VALUE(482), /* Float64Array */
+  JS_ROM_VALUE(417), /* EvalError */
+  JS_ROM_VALUE(527), /* FilledRectangle */
+  JS_ROM_VALUE(490), /* Float32Array */
+  JS_ROM_VALUE(493), /* Float64Array */
   JS_ROM_VALUE(185), /* Function */
   JS_ROM_VALUE(144), /* Infinity */
-  JS_ROM_VALUE(467), /* Int16Array */
-  JS_ROM_VALUE(473), /* Int32Array */
-  JS_ROM_VALUE(461), /* Int8Array */
-  JS_ROM_VALUE(424), /* InternalError */
-  JS_ROM_VALUE(364), /* JSON */
+  JS_ROM_VALUE(478), /* Int16Array */
+  JS_ROM_VALUE(484), /* Int32Array */
+  JS_ROM_VALUE(472), /* Int8Array */
+  JS_ROM_VALUE(435), /* InternalError */
+  JS_ROM_VALUE(375), /* JSON */
   JS_ROM_VALUE(230), /* MAX_SAFE_INTEGER */
   JS_ROM_VALUE(214), /* MAX_VALUE */
   JS_ROM_VALUE(234), /* MIN_SAFE_INTEGER */
@@ -565,30 +576,31 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(206), /* Number */
   JS_ROM_VALUE(167), /* Object */
   JS_ROM_VALUE(224), /* POSITIVE_INFINITY */
-  JS_ROM_VALUE(409), /* RangeError */
-  JS_ROM_VALUE(502), /* Rectangle */
-  JS_ROM_VALUE(412), /* ReferenceError */
-  JS_ROM_VALUE(371), /* RegExp */
+  JS_ROM_VALUE(420), /* RangeError */
+  JS_ROM_VALUE(513), /* Rectangle */
+  JS_ROM_VALUE(423), /* ReferenceError */
+  JS_ROM_VALUE(382), /* RegExp */
   JS_ROM_VALUE(248), /* String */
-  JS_ROM_VALUE(415), /* SyntaxError */
-  JS_ROM_VALUE(418), /* TypeError */
-  JS_ROM_VALUE(440), /* TypedArray */
-  JS_ROM_VALUE(421), /* URIError */
-  JS_ROM_VALUE(470), /* Uint16Array */
-  JS_ROM_VALUE(476), /* Uint32Array */
-  JS_ROM_VALUE(464), /* Uint8Array */
-  JS_ROM_VALUE(436), /* Uint8ClampedArray */
+  JS_ROM_VALUE(426), /* SyntaxError */
+  JS_ROM_VALUE(429), /* TypeError */
+  JS_ROM_VALUE(451), /* TypedArray */
+  JS_ROM_VALUE(432), /* URIError */
+  JS_ROM_VALUE(481), /* Uint16Array */
+  JS_ROM_VALUE(487), /* Uint32Array */
+  JS_ROM_VALUE(475), /* Uint8Array */
+  JS_ROM_VALUE(447), /* Uint8ClampedArray */
   JS_ROM_VALUE(154), /* __proto__ */
   JS_ROM_VALUE(346), /* abs */
+  JS_ROM_VALUE(364), /* add */
   JS_ROM_VALUE(196), /* apply */
   JS_ROM_VALUE(121), /* arguments */
   JS_ROM_VALUE(198), /* bind */
   JS_ROM_VALUE(113), /* boolean */
   JS_ROM_VALUE(161), /* bound */
   JS_ROM_VALUE(35), /* break */
-  JS_ROM_VALUE(449), /* buffer */
-  JS_ROM_VALUE(430), /* byteLength */
-  JS_ROM_VALUE(443), /* byteOffset */
+  JS_ROM_VALUE(460), /* buffer */
+  JS_ROM_VALUE(441), /* byteLength */
+  JS_ROM_VALUE(454), /* byteOffset */
   JS_ROM_VALUE(194), /* call */
   JS_ROM_VALUE(42), /* case */
   JS_ROM_VALUE(50), /* catch */
@@ -597,10 +609,10 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(261), /* charCodeAt */
   JS_ROM_VALUE(62), /* class */
   JS_ROM_VALUE(264), /* codePointAt */
-  JS_ROM_VALUE(519), /* color */
+  JS_ROM_VALUE(530), /* color */
   JS_ROM_VALUE(362), /* compare */
   JS_ROM_VALUE(272), /* concat */
-  JS_ROM_VALUE(493), /* console */
+  JS_ROM_VALUE(504), /* console */
   JS_ROM_VALUE(64), /* const */
   JS_ROM_VALUE(133), /* constructor */
   JS_ROM_VALUE(37), /* continue */
@@ -609,18 +621,19 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(44), /* default */
   JS_ROM_VALUE(169), /* defineProperty */
   JS_ROM_VALUE(16), /* delete */
+  JS_ROM_VALUE(370), /* div */
   JS_ROM_VALUE(29), /* do */
   JS_ROM_VALUE(8), /* else */
   JS_ROM_VALUE(66), /* enum */
   JS_ROM_VALUE(119), /* eval */
   JS_ROM_VALUE(321), /* every */
-  JS_ROM_VALUE(392), /* exec */
+  JS_ROM_VALUE(403), /* exec */
   JS_ROM_VALUE(68), /* export */
   JS_ROM_VALUE(70), /* extends */
   JS_ROM_VALUE(2), /* false */
   JS_ROM_VALUE(329), /* filter */
   JS_ROM_VALUE(52), /* finally */
-  JS_ROM_VALUE(387), /* flags */
+  JS_ROM_VALUE(398), /* flags */
   JS_ROM_VALUE(348), /* floor */
   JS_ROM_VALUE(33), /* for */
   JS_ROM_VALUE(325), /* forEach */
@@ -628,23 +641,23 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(253), /* fromCodePoint */
   JS_ROM_VALUE(54), /* function */
   JS_ROM_VALUE(126), /* get */
-  JS_ROM_VALUE(451), /* get buffer */
-  JS_ROM_VALUE(433), /* get byteLength */
-  JS_ROM_VALUE(446), /* get byteOffset */
-  JS_ROM_VALUE(521), /* get color */
-  JS_ROM_VALUE(389), /* get flags */
-  JS_ROM_VALUE(376), /* get lastIndex */
+  JS_ROM_VALUE(462), /* get buffer */
+  JS_ROM_VALUE(444), /* get byteLength */
+  JS_ROM_VALUE(457), /* get byteOffset */
+  JS_ROM_VALUE(532), /* get color */
+  JS_ROM_VALUE(400), /* get flags */
+  JS_ROM_VALUE(387), /* get lastIndex */
   JS_ROM_VALUE(200), /* get length */
-  JS_ROM_VALUE(398), /* get message */
+  JS_ROM_VALUE(409), /* get message */
   JS_ROM_VALUE(203), /* get name */
   JS_ROM_VALUE(188), /* get prototype */
-  JS_ROM_VALUE(384), /* get source */
-  JS_ROM_VALUE(403), /* get stack */
-  JS_ROM_VALUE(510), /* get x */
-  JS_ROM_VALUE(514), /* get y */
-  JS_ROM_VALUE(505), /* getClosure */
+  JS_ROM_VALUE(395), /* get source */
+  JS_ROM_VALUE(414), /* get stack */
+  JS_ROM_VALUE(521), /* get x */
+  JS_ROM_VALUE(525), /* get y */
+  JS_ROM_VALUE(516), /* getClosure */
   JS_ROM_VALUE(172), /* getPrototypeOf */
-  JS_ROM_VALUE(490), /* globalThis */
+  JS_ROM_VALUE(501), /* globalThis */
   JS_ROM_VALUE(182), /* hasOwnProperty */
   JS_ROM_VALUE(6), /* if */
   JS_ROM_VALUE(76), /* implements */
@@ -656,20 +669,21 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(26), /* instanceof */
   JS_ROM_VALUE(79), /* interface */
   JS_ROM_VALUE(305), /* isArray */
-  JS_ROM_VALUE(487), /* isFinite */
-  JS_ROM_VALUE(485), /* isNaN */
+  JS_ROM_VALUE(498), /* isFinite */
+  JS_ROM_VALUE(496), /* isNaN */
   JS_ROM_VALUE(311), /* join */
   JS_ROM_VALUE(180), /* keys */
-  JS_ROM_VALUE(373), /* lastIndex */
+  JS_ROM_VALUE(384), /* lastIndex */
   JS_ROM_VALUE(276), /* lastIndexOf */
   JS_ROM_VALUE(136), /* length */
   JS_ROM_VALUE(82), /* let */
-  JS_ROM_VALUE(495), /* log */
+  JS_ROM_VALUE(506), /* log */
   JS_ROM_VALUE(327), /* map */
   JS_ROM_VALUE(279), /* match */
   JS_ROM_VALUE(342), /* max */
-  JS_ROM_VALUE(396), /* message */
+  JS_ROM_VALUE(407), /* message */
   JS_ROM_VALUE(340), /* min */
+  JS_ROM_VALUE(368), /* mul */
   JS_ROM_VALUE(150), /* name */
   JS_ROM_VALUE(22), /* new */
   JS_ROM_VALUE(0), /* null */
@@ -677,17 +691,18 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(106), /* object */
   JS_ROM_VALUE(140), /* of */
   JS_ROM_VALUE(84), /* package */
-  JS_ROM_VALUE(366), /* parse */
+  JS_ROM_VALUE(377), /* parse */
   JS_ROM_VALUE(211), /* parseFloat */
   JS_ROM_VALUE(208), /* parseInt */
-  JS_ROM_VALUE(497), /* performance */
+  JS_ROM_VALUE(508), /* performance */
   JS_ROM_VALUE(309), /* pop */
-  JS_ROM_VALUE(500), /* print */
+  JS_ROM_VALUE(511), /* print */
   JS_ROM_VALUE(86), /* private */
   JS_ROM_VALUE(88), /* protected */
   JS_ROM_VALUE(130), /* prototype */
   JS_ROM_VALUE(91), /* public */
   JS_ROM_VALUE(307), /* push */
+  JS_ROM_VALUE(372), /* quantize */
   JS_ROM_VALUE(163), /* rectangle_closure_test */
   JS_ROM_VALUE(331), /* reduce */
   JS_ROM_VALUE(333), /* reduceRight */
@@ -698,7 +713,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(352), /* round */
   JS_ROM_VALUE(286), /* search */
   JS_ROM_VALUE(128), /* set */
-  JS_ROM_VALUE(379), /* set lastIndex */
+  JS_ROM_VALUE(390), /* set lastIndex */
   JS_ROM_VALUE(256), /* set length */
   JS_ROM_VALUE(191), /* set prototype */
   JS_ROM_VALUE(175), /* setPrototypeOf */
@@ -707,20 +722,21 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(267), /* slice */
   JS_ROM_VALUE(323), /* some */
   JS_ROM_VALUE(336), /* sort */
-  JS_ROM_VALUE(382), /* source */
+  JS_ROM_VALUE(393), /* source */
   JS_ROM_VALUE(317), /* splice */
   JS_ROM_VALUE(288), /* split */
   JS_ROM_VALUE(354), /* sqrt */
-  JS_ROM_VALUE(401), /* stack */
+  JS_ROM_VALUE(412), /* stack */
   JS_ROM_VALUE(93), /* static */
   JS_ROM_VALUE(111), /* string */
-  JS_ROM_VALUE(368), /* stringify */
-  JS_ROM_VALUE(454), /* subarray */
+  JS_ROM_VALUE(379), /* stringify */
+  JS_ROM_VALUE(366), /* sub */
+  JS_ROM_VALUE(465), /* subarray */
   JS_ROM_VALUE(269), /* substring */
   JS_ROM_VALUE(74), /* super */
   JS_ROM_VALUE(40), /* switch */
   JS_ROM_VALUE(138), /* target */
-  JS_ROM_VALUE(394), /* test */
+  JS_ROM_VALUE(405), /* test */
   JS_ROM_VALUE(14), /* this */
   JS_ROM_VALUE(46), /* throw */
   JS_ROM_VALUE(238), /* toExponential */
@@ -743,11 +759,11 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(18), /* void */
   JS_ROM_VALUE(31), /* while */
   JS_ROM_VALUE(60), /* with */
-  JS_ROM_VALUE(508), /* x */
-  JS_ROM_VALUE(512), /* y */
+  JS_ROM_VALUE(519), /* x */
+  JS_ROM_VALUE(523), /* y */
   JS_ROM_VALUE(95), /* yield */
 
-  /* properties (offset=740) */
+  /* properties (offset=756) */
   JS_VALUE_ARRAY_HEADER(24),
   6 << 1, /* n_props */
   3 << 1, /* hash_mask */
@@ -773,7 +789,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_OBJECT << 1,
   (15 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=765) */
+  /* properties (offset=781) */
   JS_VALUE_ARRAY_HEADER(13),
   3 << 1, /* n_props */
   1 << 1, /* hash_mask */
@@ -788,14 +804,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_OBJECT - 1) << 1,
   (7 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=779) */
+  /* class (offset=795) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(740),
+  JS_ROM_VALUE(756),
   2,
-  JS_ROM_VALUE(765),
+  JS_ROM_VALUE(781),
   JS_NULL,
 
-  /* properties (offset=784) */
+  /* properties (offset=800) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -803,22 +819,22 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_CLOSURE << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=791) */
+  /* getset (offset=807) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 11),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 12),
 
-  /* getset (offset=794) */
+  /* getset (offset=810) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 13),
   JS_UNDEFINED,
 
-  /* getset (offset=797) */
+  /* getset (offset=813) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 14),
   JS_UNDEFINED,
 
-  /* properties (offset=800) */
+  /* properties (offset=816) */
   JS_VALUE_ARRAY_HEADER(30),
   8 << 1, /* n_props */
   3 << 1, /* hash_mask */
@@ -827,7 +843,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   18 << 1,
   24 << 1,
   JS_ROM_VALUE(130) /* prototype */,
-  JS_ROM_VALUE(791),
+  JS_ROM_VALUE(807),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(194) /* call */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 15),
@@ -842,54 +858,54 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 18),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(794),
+  JS_ROM_VALUE(810),
   (12 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(797),
+  JS_ROM_VALUE(813),
   (15 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_CLOSURE - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=831) */
+  /* class (offset=847) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(784),
-  10,
   JS_ROM_VALUE(800),
+  10,
+  JS_ROM_VALUE(816),
   JS_NULL,
 
-  /* float64 (offset=836) */
+  /* float64 (offset=852) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x7fefffffffffffff,
 
-  /* float64 (offset=838) */
+  /* float64 (offset=854) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x0000000000000001,
 
-  /* float64 (offset=840) */
+  /* float64 (offset=856) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x7ff8000000000000,
 
-  /* float64 (offset=842) */
+  /* float64 (offset=858) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0xfff0000000000000,
 
-  /* float64 (offset=844) */
+  /* float64 (offset=860) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x7ff0000000000000,
 
-  /* float64 (offset=846) */
+  /* float64 (offset=862) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x3cb0000000000000,
 
-  /* float64 (offset=848) */
+  /* float64 (offset=864) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x433fffffffffffff,
 
-  /* float64 (offset=850) */
+  /* float64 (offset=866) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0xc33fffffffffffff,
 
-  /* properties (offset=852) */
+  /* properties (offset=868) */
   JS_VALUE_ARRAY_HEADER(43),
   11 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -908,33 +924,33 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 21),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(214) /* MAX_VALUE */,
-  JS_ROM_VALUE(836),
+  JS_ROM_VALUE(852),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(217) /* MIN_VALUE */,
-  JS_ROM_VALUE(838),
+  JS_ROM_VALUE(854),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(142) /* NaN */,
-  JS_ROM_VALUE(840),
+  JS_ROM_VALUE(856),
   (16 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(220) /* NEGATIVE_INFINITY */,
-  JS_ROM_VALUE(842),
+  JS_ROM_VALUE(858),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(224) /* POSITIVE_INFINITY */,
-  JS_ROM_VALUE(844),
+  JS_ROM_VALUE(860),
   (10 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(228) /* EPSILON */,
-  JS_ROM_VALUE(846),
+  JS_ROM_VALUE(862),
   (25 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(230) /* MAX_SAFE_INTEGER */,
-  JS_ROM_VALUE(848),
+  JS_ROM_VALUE(864),
   (22 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(234) /* MIN_SAFE_INTEGER */,
-  JS_ROM_VALUE(850),
+  JS_ROM_VALUE(866),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_NUMBER << 1,
   (37 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=896) */
+  /* properties (offset=912) */
   JS_VALUE_ARRAY_HEADER(21),
   5 << 1, /* n_props */
   3 << 1, /* hash_mask */
@@ -957,14 +973,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_NUMBER - 1) << 1,
   (9 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=918) */
+  /* class (offset=934) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(852),
+  JS_ROM_VALUE(868),
   19,
-  JS_ROM_VALUE(896),
+  JS_ROM_VALUE(912),
   JS_NULL,
 
-  /* properties (offset=923) */
+  /* properties (offset=939) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -972,7 +988,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_BOOLEAN << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=930) */
+  /* properties (offset=946) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -980,14 +996,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_BOOLEAN - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=937) */
+  /* class (offset=953) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(923),
+  JS_ROM_VALUE(939),
   26,
-  JS_ROM_VALUE(930),
+  JS_ROM_VALUE(946),
   JS_NULL,
 
-  /* properties (offset=942) */
+  /* properties (offset=958) */
   JS_VALUE_ARRAY_HEADER(13),
   3 << 1, /* n_props */
   1 << 1, /* hash_mask */
@@ -1002,12 +1018,12 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_STRING << 1,
   (4 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=956) */
+  /* getset (offset=972) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 30),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 31),
 
-  /* properties (offset=959) */
+  /* properties (offset=975) */
   JS_VALUE_ARRAY_HEADER(73),
   21 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -1020,7 +1036,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   37 << 1,
   46 << 1,
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(956),
+  JS_ROM_VALUE(972),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(259) /* charAt */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 32),
@@ -1082,14 +1098,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_STRING - 1) << 1,
   (55 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1033) */
+  /* class (offset=1049) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(942),
+  JS_ROM_VALUE(958),
   27,
-  JS_ROM_VALUE(959),
+  JS_ROM_VALUE(975),
   JS_NULL,
 
-  /* properties (offset=1038) */
+  /* properties (offset=1054) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1100,12 +1116,12 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1048) */
+  /* getset (offset=1064) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 53),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 54),
 
-  /* properties (offset=1051) */
+  /* properties (offset=1067) */
   JS_VALUE_ARRAY_HEADER(79),
   23 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -1121,7 +1137,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 55),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(1048),
+  JS_ROM_VALUE(1064),
   (10 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(307) /* push */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 56),
@@ -1186,18 +1202,18 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_ARRAY - 1) << 1,
   (67 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1131) */
+  /* class (offset=1147) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1038),
+  JS_ROM_VALUE(1054),
   51,
-  JS_ROM_VALUE(1051),
+  JS_ROM_VALUE(1067),
   JS_NULL,
 
-  /* float64 (offset=1136) */
+  /* float64 (offset=1152) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x4005bf0a8b145769,
 
-  /* properties (offset=1138) */
+  /* properties (offset=1154) */
   JS_VALUE_ARRAY_HEADER(37),
   9 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -1234,16 +1250,16 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 82),
   (19 << 1) | (JS_PROP_NORMAL << 30),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_STRING_CHAR, 69) /* E */,
-  JS_ROM_VALUE(1136),
+  JS_ROM_VALUE(1152),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  /* class (offset=1176) */
+  /* class (offset=1192) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1138),
+  JS_ROM_VALUE(1154),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1181) */
+  /* properties (offset=1197) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1251,7 +1267,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_DATE << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1188) */
+  /* properties (offset=1204) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1259,14 +1275,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_DATE - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1195) */
+  /* class (offset=1211) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1181),
+  JS_ROM_VALUE(1197),
   83,
-  JS_ROM_VALUE(1188),
+  JS_ROM_VALUE(1204),
   JS_NULL,
 
-  /* properties (offset=1200) */
+  /* properties (offset=1216) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1274,47 +1290,64 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_DECIMAL << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1207) */
-  JS_VALUE_ARRAY_HEADER(13),
-  3 << 1, /* n_props */
-  1 << 1, /* hash_mask */
-  10 << 1,
-  7 << 1,
+  /* properties (offset=1223) */
+  JS_VALUE_ARRAY_HEADER(30),
+  8 << 1, /* n_props */
+  3 << 1, /* hash_mask */
+  27 << 1,
+  24 << 1,
+  6 << 1,
+  21 << 1,
   JS_ROM_VALUE(99) /* toString */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 85),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(362) /* compare */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 86),
   (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(364) /* add */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 87),
+  (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(366) /* sub */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 88),
+  (9 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(368) /* mul */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 89),
+  (12 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(370) /* div */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 90),
+  (15 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(372) /* quantize */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 91),
+  (18 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_DECIMAL - 1) << 1,
-  (4 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1221) */
+  (0 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1254) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1200),
+  JS_ROM_VALUE(1216),
   84,
-  JS_ROM_VALUE(1207),
+  JS_ROM_VALUE(1223),
   JS_NULL,
 
-  /* properties (offset=1226) */
+  /* properties (offset=1259) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(366) /* parse */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 87),
+  JS_ROM_VALUE(377) /* parse */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 92),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(368) /* stringify */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 88),
+  JS_ROM_VALUE(379) /* stringify */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 93),
   (3 << 1) | (JS_PROP_NORMAL << 30),
-  /* class (offset=1236) */
+  /* class (offset=1269) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1226),
+  JS_ROM_VALUE(1259),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1241) */
+  /* properties (offset=1274) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1322,55 +1355,55 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_REGEXP << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1248) */
+  /* getset (offset=1281) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 90),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 91),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 95),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 96),
 
-  /* getset (offset=1251) */
+  /* getset (offset=1284) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 92),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 97),
   JS_UNDEFINED,
 
-  /* getset (offset=1254) */
+  /* getset (offset=1287) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 93),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 98),
   JS_UNDEFINED,
 
-  /* properties (offset=1257) */
+  /* properties (offset=1290) */
   JS_VALUE_ARRAY_HEADER(24),
   6 << 1, /* n_props */
   3 << 1, /* hash_mask */
   21 << 1,
+  6 << 1,
   15 << 1,
   12 << 1,
-  18 << 1,
-  JS_ROM_VALUE(373) /* lastIndex */,
-  JS_ROM_VALUE(1248),
+  JS_ROM_VALUE(384) /* lastIndex */,
+  JS_ROM_VALUE(1281),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(382) /* source */,
-  JS_ROM_VALUE(1251),
+  JS_ROM_VALUE(393) /* source */,
+  JS_ROM_VALUE(1284),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(387) /* flags */,
-  JS_ROM_VALUE(1254),
+  JS_ROM_VALUE(398) /* flags */,
+  JS_ROM_VALUE(1287),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(392) /* exec */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 94),
+  JS_ROM_VALUE(403) /* exec */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 99),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(394) /* test */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 95),
+  JS_ROM_VALUE(405) /* test */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 100),
   (9 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_REGEXP - 1) << 1,
-  (6 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1282) */
+  (18 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1315) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1241),
-  89,
-  JS_ROM_VALUE(1257),
+  JS_ROM_VALUE(1274),
+  94,
+  JS_ROM_VALUE(1290),
   JS_NULL,
 
-  /* properties (offset=1287) */
+  /* properties (offset=1320) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1378,47 +1411,47 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1294) */
+  /* getset (offset=1327) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 97),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 102),
   JS_UNDEFINED,
 
-  /* getset (offset=1297) */
+  /* getset (offset=1330) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 98),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 103),
   JS_UNDEFINED,
 
-  /* properties (offset=1300) */
+  /* properties (offset=1333) */
   JS_VALUE_ARRAY_HEADER(21),
   5 << 1, /* n_props */
   3 << 1, /* hash_mask */
   18 << 1,
+  15 << 1,
   12 << 1,
-  6 << 1,
   9 << 1,
   JS_ROM_VALUE(99) /* toString */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 99),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 104),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(150) /* name */,
   JS_ROM_VALUE(152) /* Error */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(396) /* message */,
-  JS_ROM_VALUE(1294),
-  (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(401) /* stack */,
-  JS_ROM_VALUE(1297),
+  JS_ROM_VALUE(407) /* message */,
+  JS_ROM_VALUE(1327),
+  (6 << 1) | (JS_PROP_GETSET << 30),
+  JS_ROM_VALUE(412) /* stack */,
+  JS_ROM_VALUE(1330),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_ERROR - 1) << 1,
-  (15 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1322) */
+  (0 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1355) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1287),
-  96,
-  JS_ROM_VALUE(1300),
+  JS_ROM_VALUE(1320),
+  101,
+  JS_ROM_VALUE(1333),
   JS_NULL,
 
-  /* properties (offset=1327) */
+  /* properties (offset=1360) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1426,25 +1459,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_EVAL_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1334) */
+  /* properties (offset=1367) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(406) /* EvalError */,
+  JS_ROM_VALUE(417) /* EvalError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_EVAL_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1344) */
+  /* class (offset=1377) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1327),
-  100,
-  JS_ROM_VALUE(1334),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1360),
+  105,
+  JS_ROM_VALUE(1367),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1349) */
+  /* properties (offset=1382) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1452,25 +1485,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_RANGE_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1356) */
+  /* properties (offset=1389) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(409) /* RangeError */,
+  JS_ROM_VALUE(420) /* RangeError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_RANGE_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1366) */
+  /* class (offset=1399) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1349),
-  101,
-  JS_ROM_VALUE(1356),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1382),
+  106,
+  JS_ROM_VALUE(1389),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1371) */
+  /* properties (offset=1404) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1478,25 +1511,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_REFERENCE_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1378) */
+  /* properties (offset=1411) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(412) /* ReferenceError */,
+  JS_ROM_VALUE(423) /* ReferenceError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_REFERENCE_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1388) */
+  /* class (offset=1421) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1371),
-  102,
-  JS_ROM_VALUE(1378),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1404),
+  107,
+  JS_ROM_VALUE(1411),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1393) */
+  /* properties (offset=1426) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1504,25 +1537,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_SYNTAX_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1400) */
+  /* properties (offset=1433) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(415) /* SyntaxError */,
+  JS_ROM_VALUE(426) /* SyntaxError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_SYNTAX_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1410) */
+  /* class (offset=1443) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1393),
-  103,
-  JS_ROM_VALUE(1400),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1426),
+  108,
+  JS_ROM_VALUE(1433),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1415) */
+  /* properties (offset=1448) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1530,25 +1563,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_TYPE_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1422) */
+  /* properties (offset=1455) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(418) /* TypeError */,
+  JS_ROM_VALUE(429) /* TypeError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_TYPE_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1432) */
+  /* class (offset=1465) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1415),
-  104,
-  JS_ROM_VALUE(1422),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1448),
+  109,
+  JS_ROM_VALUE(1455),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1437) */
+  /* properties (offset=1470) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1556,25 +1589,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_URI_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1444) */
+  /* properties (offset=1477) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(421) /* URIError */,
+  JS_ROM_VALUE(432) /* URIError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_URI_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1454) */
+  /* class (offset=1487) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1437),
-  105,
-  JS_ROM_VALUE(1444),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1470),
+  110,
+  JS_ROM_VALUE(1477),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1459) */
+  /* properties (offset=1492) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1582,25 +1615,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INTERNAL_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1466) */
+  /* properties (offset=1499) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(424) /* InternalError */,
+  JS_ROM_VALUE(435) /* InternalError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INTERNAL_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1476) */
+  /* class (offset=1509) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1459),
-  106,
-  JS_ROM_VALUE(1466),
-  JS_ROM_VALUE(1322),
+  JS_ROM_VALUE(1492),
+  111,
+  JS_ROM_VALUE(1499),
+  JS_ROM_VALUE(1355),
 
-  /* properties (offset=1481) */
+  /* properties (offset=1514) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1608,30 +1641,30 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_ARRAY_BUFFER << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1488) */
+  /* getset (offset=1521) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 108),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 113),
   JS_UNDEFINED,
 
-  /* properties (offset=1491) */
+  /* properties (offset=1524) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(430) /* byteLength */,
-  JS_ROM_VALUE(1488),
+  JS_ROM_VALUE(441) /* byteLength */,
+  JS_ROM_VALUE(1521),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_ARRAY_BUFFER - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1501) */
+  /* class (offset=1534) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1481),
-  107,
-  JS_ROM_VALUE(1491),
+  JS_ROM_VALUE(1514),
+  112,
+  JS_ROM_VALUE(1524),
   JS_NULL,
 
-  /* properties (offset=1506) */
+  /* properties (offset=1539) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1639,408 +1672,408 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_TYPED_ARRAY << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1513) */
+  /* getset (offset=1546) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 110),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 115),
   JS_UNDEFINED,
 
-  /* getset (offset=1516) */
+  /* getset (offset=1549) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 111),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 116),
   JS_UNDEFINED,
 
-  /* getset (offset=1519) */
+  /* getset (offset=1552) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 112),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 117),
   JS_UNDEFINED,
 
-  /* getset (offset=1522) */
+  /* getset (offset=1555) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 113),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 118),
   JS_UNDEFINED,
 
-  /* properties (offset=1525) */
+  /* properties (offset=1558) */
   JS_VALUE_ARRAY_HEADER(37),
   9 << 1, /* n_props */
   7 << 1, /* hash_mask */
-  19 << 1,
+  28 << 1,
   31 << 1,
   25 << 1,
   0 << 1,
   34 << 1,
-  0 << 1,
+  19 << 1,
   22 << 1,
-  28 << 1,
+  16 << 1,
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(1513),
+  JS_ROM_VALUE(1546),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(430) /* byteLength */,
-  JS_ROM_VALUE(1516),
+  JS_ROM_VALUE(441) /* byteLength */,
+  JS_ROM_VALUE(1549),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(443) /* byteOffset */,
-  JS_ROM_VALUE(1519),
+  JS_ROM_VALUE(454) /* byteOffset */,
+  JS_ROM_VALUE(1552),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(449) /* buffer */,
-  JS_ROM_VALUE(1522),
+  JS_ROM_VALUE(460) /* buffer */,
+  JS_ROM_VALUE(1555),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(311) /* join */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 58),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(99) /* toString */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 59),
-  (16 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(454) /* subarray */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 114),
+  (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(465) /* subarray */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 119),
   (13 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(128) /* set */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 115),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 120),
   (10 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_TYPED_ARRAY - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1563) */
+  /* class (offset=1596) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1506),
-  109,
-  JS_ROM_VALUE(1525),
+  JS_ROM_VALUE(1539),
+  114,
+  JS_ROM_VALUE(1558),
   JS_NULL,
 
-  /* properties (offset=1568) */
+  /* properties (offset=1601) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT8C_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1578) */
+  /* properties (offset=1611) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT8C_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1588) */
+  /* class (offset=1621) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1568),
-  116,
-  JS_ROM_VALUE(1578),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1601),
+  121,
+  JS_ROM_VALUE(1611),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1593) */
+  /* properties (offset=1626) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INT8_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1603) */
+  /* properties (offset=1636) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INT8_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1613) */
+  /* class (offset=1646) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1593),
-  117,
-  JS_ROM_VALUE(1603),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1626),
+  122,
+  JS_ROM_VALUE(1636),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1618) */
+  /* properties (offset=1651) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT8_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1628) */
+  /* properties (offset=1661) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT8_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1638) */
+  /* class (offset=1671) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1618),
-  118,
-  JS_ROM_VALUE(1628),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1651),
+  123,
+  JS_ROM_VALUE(1661),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1643) */
+  /* properties (offset=1676) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INT16_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1653) */
+  /* properties (offset=1686) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INT16_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1663) */
+  /* class (offset=1696) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1643),
-  119,
-  JS_ROM_VALUE(1653),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1676),
+  124,
+  JS_ROM_VALUE(1686),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1668) */
+  /* properties (offset=1701) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT16_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1678) */
+  /* properties (offset=1711) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT16_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1688) */
+  /* class (offset=1721) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1668),
-  120,
-  JS_ROM_VALUE(1678),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1701),
+  125,
+  JS_ROM_VALUE(1711),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1693) */
+  /* properties (offset=1726) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INT32_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1703) */
+  /* properties (offset=1736) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INT32_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1713) */
+  /* class (offset=1746) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1693),
-  121,
-  JS_ROM_VALUE(1703),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1726),
+  126,
+  JS_ROM_VALUE(1736),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1718) */
+  /* properties (offset=1751) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT32_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1728) */
+  /* properties (offset=1761) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT32_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1738) */
+  /* class (offset=1771) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1718),
-  122,
-  JS_ROM_VALUE(1728),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1751),
+  127,
+  JS_ROM_VALUE(1761),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1743) */
+  /* properties (offset=1776) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_FLOAT32_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1753) */
+  /* properties (offset=1786) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_FLOAT32_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1763) */
+  /* class (offset=1796) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1743),
-  123,
-  JS_ROM_VALUE(1753),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1776),
+  128,
+  JS_ROM_VALUE(1786),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1768) */
+  /* properties (offset=1801) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   8 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_FLOAT64_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1778) */
+  /* properties (offset=1811) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(457) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(468) /* BYTES_PER_ELEMENT */,
   8 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_FLOAT64_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1788) */
+  /* class (offset=1821) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1768),
-  124,
-  JS_ROM_VALUE(1778),
-  JS_ROM_VALUE(1563),
+  JS_ROM_VALUE(1801),
+  129,
+  JS_ROM_VALUE(1811),
+  JS_ROM_VALUE(1596),
 
-  /* properties (offset=1793) */
+  /* properties (offset=1826) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
   3 << 1,
-  JS_ROM_VALUE(495) /* log */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 125),
+  JS_ROM_VALUE(506) /* log */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 130),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  /* class (offset=1800) */
+  /* class (offset=1833) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1793),
+  JS_ROM_VALUE(1826),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1805) */
+  /* properties (offset=1838) */
   JS_VALUE_ARRAY_HEADER(3),
   0 << 1, /* n_props */
   0 << 1, /* hash_mask */
   0 << 1,
-  /* class (offset=1809) */
+  /* class (offset=1842) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1805),
+  JS_ROM_VALUE(1838),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1814) */
+  /* properties (offset=1847) */
   JS_VALUE_ARRAY_HEADER(13),
   3 << 1, /* n_props */
   1 << 1, /* hash_mask */
-  4 << 1,
+  0 << 1,
   10 << 1,
-  JS_ROM_VALUE(505) /* getClosure */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 127),
+  JS_ROM_VALUE(516) /* getClosure */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 132),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(194) /* call */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 128),
-  (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 133),
+  (4 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_RECTANGLE << 1,
   (7 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1828) */
+  /* getset (offset=1861) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 129),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 134),
   JS_UNDEFINED,
 
-  /* getset (offset=1831) */
+  /* getset (offset=1864) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 130),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 135),
   JS_UNDEFINED,
 
-  /* properties (offset=1834) */
+  /* properties (offset=1867) */
   JS_VALUE_ARRAY_HEADER(13),
   3 << 1, /* n_props */
   1 << 1, /* hash_mask */
   10 << 1,
   0 << 1,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_STRING_CHAR, 120) /* x */,
-  JS_ROM_VALUE(1828),
+  JS_ROM_VALUE(1861),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_STRING_CHAR, 121) /* y */,
-  JS_ROM_VALUE(1831),
+  JS_ROM_VALUE(1864),
   (4 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_RECTANGLE - 1) << 1,
   (7 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1848) */
+  /* class (offset=1881) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1814),
-  126,
-  JS_ROM_VALUE(1834),
+  JS_ROM_VALUE(1847),
+  131,
+  JS_ROM_VALUE(1867),
   JS_NULL,
 
-  /* properties (offset=1853) */
+  /* properties (offset=1886) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -2048,109 +2081,109 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_FILLED_RECTANGLE << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1860) */
+  /* getset (offset=1893) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 132),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 137),
   JS_UNDEFINED,
 
-  /* properties (offset=1863) */
+  /* properties (offset=1896) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(519) /* color */,
-  JS_ROM_VALUE(1860),
+  JS_ROM_VALUE(530) /* color */,
+  JS_ROM_VALUE(1893),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_FILLED_RECTANGLE - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1873) */
+  /* class (offset=1906) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1853),
-  131,
-  JS_ROM_VALUE(1863),
-  JS_ROM_VALUE(1848),
+  JS_ROM_VALUE(1886),
+  136,
+  JS_ROM_VALUE(1896),
+  JS_ROM_VALUE(1881),
 
-  /* global object properties (offset=1878) */
+  /* global object properties (offset=1911) */
   JS_VALUE_ARRAY_HEADER(78),
   JS_ROM_VALUE(167) /* Object */,
-  JS_ROM_VALUE(779),
+  JS_ROM_VALUE(795),
   JS_ROM_VALUE(185) /* Function */,
-  JS_ROM_VALUE(831),
+  JS_ROM_VALUE(847),
   JS_ROM_VALUE(206) /* Number */,
-  JS_ROM_VALUE(918),
+  JS_ROM_VALUE(934),
   JS_ROM_VALUE(246) /* Boolean */,
-  JS_ROM_VALUE(937),
+  JS_ROM_VALUE(953),
   JS_ROM_VALUE(248) /* String */,
-  JS_ROM_VALUE(1033),
+  JS_ROM_VALUE(1049),
   JS_ROM_VALUE(303) /* Array */,
-  JS_ROM_VALUE(1131),
+  JS_ROM_VALUE(1147),
   JS_ROM_VALUE(338) /* Math */,
-  JS_ROM_VALUE(1176),
+  JS_ROM_VALUE(1192),
   JS_ROM_VALUE(358) /* Date */,
-  JS_ROM_VALUE(1195),
+  JS_ROM_VALUE(1211),
   JS_ROM_VALUE(360) /* Decimal */,
-  JS_ROM_VALUE(1221),
-  JS_ROM_VALUE(364) /* JSON */,
-  JS_ROM_VALUE(1236),
-  JS_ROM_VALUE(371) /* RegExp */,
-  JS_ROM_VALUE(1282),
+  JS_ROM_VALUE(1254),
+  JS_ROM_VALUE(375) /* JSON */,
+  JS_ROM_VALUE(1269),
+  JS_ROM_VALUE(382) /* RegExp */,
+  JS_ROM_VALUE(1315),
   JS_ROM_VALUE(152) /* Error */,
-  JS_ROM_VALUE(1322),
-  JS_ROM_VALUE(406) /* EvalError */,
-  JS_ROM_VALUE(1344),
-  JS_ROM_VALUE(409) /* RangeError */,
-  JS_ROM_VALUE(1366),
-  JS_ROM_VALUE(412) /* ReferenceError */,
-  JS_ROM_VALUE(1388),
-  JS_ROM_VALUE(415) /* SyntaxError */,
-  JS_ROM_VALUE(1410),
-  JS_ROM_VALUE(418) /* TypeError */,
-  JS_ROM_VALUE(1432),
-  JS_ROM_VALUE(421) /* URIError */,
-  JS_ROM_VALUE(1454),
-  JS_ROM_VALUE(424) /* InternalError */,
-  JS_ROM_VALUE(1476),
-  JS_ROM_VALUE(427) /* ArrayBuffer */,
-  JS_ROM_VALUE(1501),
-  JS_ROM_VALUE(436) /* Uint8ClampedArray */,
-  JS_ROM_VALUE(1588),
-  JS_ROM_VALUE(461) /* Int8Array */,
-  JS_ROM_VALUE(1613),
-  JS_ROM_VALUE(464) /* Uint8Array */,
-  JS_ROM_VALUE(1638),
-  JS_ROM_VALUE(467) /* Int16Array */,
-  JS_ROM_VALUE(1663),
-  JS_ROM_VALUE(470) /* Uint16Array */,
-  JS_ROM_VALUE(1688),
-  JS_ROM_VALUE(473) /* Int32Array */,
-  JS_ROM_VALUE(1713),
-  JS_ROM_VALUE(476) /* Uint32Array */,
-  JS_ROM_VALUE(1738),
-  JS_ROM_VALUE(479) /* Float32Array */,
-  JS_ROM_VALUE(1763),
-  JS_ROM_VALUE(482) /* Float64Array */,
-  JS_ROM_VALUE(1788),
+  JS_ROM_VALUE(1355),
+  JS_ROM_VALUE(417) /* EvalError */,
+  JS_ROM_VALUE(1377),
+  JS_ROM_VALUE(420) /* RangeError */,
+  JS_ROM_VALUE(1399),
+  JS_ROM_VALUE(423) /* ReferenceError */,
+  JS_ROM_VALUE(1421),
+  JS_ROM_VALUE(426) /* SyntaxError */,
+  JS_ROM_VALUE(1443),
+  JS_ROM_VALUE(429) /* TypeError */,
+  JS_ROM_VALUE(1465),
+  JS_ROM_VALUE(432) /* URIError */,
+  JS_ROM_VALUE(1487),
+  JS_ROM_VALUE(435) /* InternalError */,
+  JS_ROM_VALUE(1509),
+  JS_ROM_VALUE(438) /* ArrayBuffer */,
+  JS_ROM_VALUE(1534),
+  JS_ROM_VALUE(447) /* Uint8ClampedArray */,
+  JS_ROM_VALUE(1621),
+  JS_ROM_VALUE(472) /* Int8Array */,
+  JS_ROM_VALUE(1646),
+  JS_ROM_VALUE(475) /* Uint8Array */,
+  JS_ROM_VALUE(1671),
+  JS_ROM_VALUE(478) /* Int16Array */,
+  JS_ROM_VALUE(1696),
+  JS_ROM_VALUE(481) /* Uint16Array */,
+  JS_ROM_VALUE(1721),
+  JS_ROM_VALUE(484) /* Int32Array */,
+  JS_ROM_VALUE(1746),
+  JS_ROM_VALUE(487) /* Uint32Array */,
+  JS_ROM_VALUE(1771),
+  JS_ROM_VALUE(490) /* Float32Array */,
+  JS_ROM_VALUE(1796),
+  JS_ROM_VALUE(493) /* Float64Array */,
+  JS_ROM_VALUE(1821),
   JS_ROM_VALUE(208) /* parseInt */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 20),
-  JS_ROM_VALUE(485) /* isNaN */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 133),
-  JS_ROM_VALUE(487) /* isFinite */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 134),
+  JS_ROM_VALUE(496) /* isNaN */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 138),
+  JS_ROM_VALUE(498) /* isFinite */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 139),
   JS_ROM_VALUE(108) /* undefined */,
   JS_UNDEFINED,
-  JS_ROM_VALUE(490) /* globalThis */,
+  JS_ROM_VALUE(501) /* globalThis */,
   JS_NULL,
-  JS_ROM_VALUE(493) /* console */,
-  JS_ROM_VALUE(1800),
-  JS_ROM_VALUE(497) /* performance */,
-  JS_ROM_VALUE(1809),
-  JS_ROM_VALUE(500) /* print */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 135),
-  JS_ROM_VALUE(502) /* Rectangle */,
-  JS_ROM_VALUE(1848),
-  JS_ROM_VALUE(516) /* FilledRectangle */,
-  JS_ROM_VALUE(1873),
+  JS_ROM_VALUE(504) /* console */,
+  JS_ROM_VALUE(1833),
+  JS_ROM_VALUE(508) /* performance */,
+  JS_ROM_VALUE(1842),
+  JS_ROM_VALUE(511) /* print */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 140),
+  JS_ROM_VALUE(513) /* Rectangle */,
+  JS_ROM_VALUE(1881),
+  JS_ROM_VALUE(527) /* FilledRectangle */,
+  JS_ROM_VALUE(1906),
 };
 
 static const JSCFunctionDef js_c_function_table[] = {
@@ -2415,152 +2448,167 @@ static const JSCFunctionDef js_c_function_table[] = {
   { { .generic = js_decimal_compare },
     JS_ROM_VALUE(362) /* compare */,
     JS_CFUNC_generic, 1, 0 },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(364) /* add */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_add },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(366) /* sub */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_sub },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(368) /* mul */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_mul },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(370) /* div */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_div },
+  { { .generic = js_decimal_quantize },
+    JS_ROM_VALUE(372) /* quantize */,
+    JS_CFUNC_generic, 1, 0 },
   { { .generic = js_json_parse },
-    JS_ROM_VALUE(366) /* parse */,
+    JS_ROM_VALUE(377) /* parse */,
     JS_CFUNC_generic, 2, 0 },
   { { .generic = js_json_stringify },
-    JS_ROM_VALUE(368) /* stringify */,
+    JS_ROM_VALUE(379) /* stringify */,
     JS_CFUNC_generic, 3, 0 },
   { { .constructor = js_regexp_constructor },
-    JS_ROM_VALUE(371) /* RegExp */,
+    JS_ROM_VALUE(382) /* RegExp */,
     JS_CFUNC_constructor, 2, JS_CLASS_REGEXP },
   { { .generic = js_regexp_get_lastIndex },
-    JS_ROM_VALUE(376) /* get lastIndex */,
+    JS_ROM_VALUE(387) /* get lastIndex */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic = js_regexp_set_lastIndex },
-    JS_ROM_VALUE(379) /* set lastIndex */,
+    JS_ROM_VALUE(390) /* set lastIndex */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_regexp_get_source },
-    JS_ROM_VALUE(384) /* get source */,
+    JS_ROM_VALUE(395) /* get source */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic = js_regexp_get_flags },
-    JS_ROM_VALUE(389) /* get flags */,
+    JS_ROM_VALUE(400) /* get flags */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic_magic = js_regexp_exec },
-    JS_ROM_VALUE(392) /* exec */,
+    JS_ROM_VALUE(403) /* exec */,
     JS_CFUNC_generic_magic, 1, 0 },
   { { .generic_magic = js_regexp_exec },
-    JS_ROM_VALUE(394) /* test */,
+    JS_ROM_VALUE(405) /* test */,
     JS_CFUNC_generic_magic, 1, 1 },
   { { .constructor_magic = js_error_constructor },
     JS_ROM_VALUE(152) /* Error */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_ERROR },
   { { .generic_magic = js_error_get_message },
-    JS_ROM_VALUE(398) /* get message */,
+    JS_ROM_VALUE(409) /* get message */,
     JS_CFUNC_generic_magic, 0, 0 },
   { { .generic_magic = js_error_get_message },
-    JS_ROM_VALUE(403) /* get stack */,
+    JS_ROM_VALUE(414) /* get stack */,
     JS_CFUNC_generic_magic, 0, 1 },
   { { .generic = js_error_toString },
     JS_ROM_VALUE(99) /* toString */,
     JS_CFUNC_generic, 0, 0 },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(406) /* EvalError */,
+    JS_ROM_VALUE(417) /* EvalError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_EVAL_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(409) /* RangeError */,
+    JS_ROM_VALUE(420) /* RangeError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_RANGE_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(412) /* ReferenceError */,
+    JS_ROM_VALUE(423) /* ReferenceError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_REFERENCE_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(415) /* SyntaxError */,
+    JS_ROM_VALUE(426) /* SyntaxError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_SYNTAX_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(418) /* TypeError */,
+    JS_ROM_VALUE(429) /* TypeError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_TYPE_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(421) /* URIError */,
+    JS_ROM_VALUE(432) /* URIError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_URI_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(424) /* InternalError */,
+    JS_ROM_VALUE(435) /* InternalError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_INTERNAL_ERROR },
   { { .constructor = js_array_buffer_constructor },
-    JS_ROM_VALUE(427) /* ArrayBuffer */,
+    JS_ROM_VALUE(438) /* ArrayBuffer */,
     JS_CFUNC_constructor, 1, JS_CLASS_ARRAY_BUFFER },
   { { .generic = js_array_buffer_get_byteLength },
-    JS_ROM_VALUE(433) /* get byteLength */,
+    JS_ROM_VALUE(444) /* get byteLength */,
     JS_CFUNC_generic, 0, 0 },
   { { .constructor = js_typed_array_base_constructor },
-    JS_ROM_VALUE(440) /* TypedArray */,
+    JS_ROM_VALUE(451) /* TypedArray */,
     JS_CFUNC_constructor, 0, JS_CLASS_TYPED_ARRAY },
   { { .generic_magic = js_typed_array_get_length },
     JS_ROM_VALUE(200) /* get length */,
     JS_CFUNC_generic_magic, 0, 0 },
   { { .generic_magic = js_typed_array_get_length },
-    JS_ROM_VALUE(433) /* get byteLength */,
+    JS_ROM_VALUE(444) /* get byteLength */,
     JS_CFUNC_generic_magic, 0, 1 },
   { { .generic_magic = js_typed_array_get_length },
-    JS_ROM_VALUE(446) /* get byteOffset */,
+    JS_ROM_VALUE(457) /* get byteOffset */,
     JS_CFUNC_generic_magic, 0, 2 },
   { { .generic_magic = js_typed_array_get_length },
-    JS_ROM_VALUE(451) /* get buffer */,
+    JS_ROM_VALUE(462) /* get buffer */,
     JS_CFUNC_generic_magic, 0, 3 },
   { { .generic = js_typed_array_subarray },
-    JS_ROM_VALUE(454) /* subarray */,
+    JS_ROM_VALUE(465) /* subarray */,
     JS_CFUNC_generic, 2, 0 },
   { { .generic = js_typed_array_set },
     JS_ROM_VALUE(128) /* set */,
     JS_CFUNC_generic, 1, 0 },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(436) /* Uint8ClampedArray */,
+    JS_ROM_VALUE(447) /* Uint8ClampedArray */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT8C_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(461) /* Int8Array */,
+    JS_ROM_VALUE(472) /* Int8Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_INT8_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(464) /* Uint8Array */,
+    JS_ROM_VALUE(475) /* Uint8Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT8_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(467) /* Int16Array */,
+    JS_ROM_VALUE(478) /* Int16Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_INT16_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(470) /* Uint16Array */,
+    JS_ROM_VALUE(481) /* Uint16Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT16_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(473) /* Int32Array */,
+    JS_ROM_VALUE(484) /* Int32Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_INT32_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(476) /* Uint32Array */,
+    JS_ROM_VALUE(487) /* Uint32Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT32_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(479) /* Float32Array */,
+    JS_ROM_VALUE(490) /* Float32Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_FLOAT32_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(482) /* Float64Array */,
+    JS_ROM_VALUE(493) /* Float64Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_FLOAT64_ARRAY },
   { { .generic = js_print },
-    JS_ROM_VALUE(495) /* log */,
+    JS_ROM_VALUE(506) /* log */,
     JS_CFUNC_generic, 1, 0 },
   { { .constructor = js_rectangle_constructor },
-    JS_ROM_VALUE(502) /* Rectangle */,
+    JS_ROM_VALUE(513) /* Rectangle */,
     JS_CFUNC_constructor, 2, JS_CLASS_RECTANGLE },
   { { .generic = js_rectangle_getClosure },
-    JS_ROM_VALUE(505) /* getClosure */,
+    JS_ROM_VALUE(516) /* getClosure */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_rectangle_call },
     JS_ROM_VALUE(194) /* call */,
     JS_CFUNC_generic, 2, 0 },
   { { .generic = js_rectangle_get_x },
-    JS_ROM_VALUE(510) /* get x */,
+    JS_ROM_VALUE(521) /* get x */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic = js_rectangle_get_y },
-    JS_ROM_VALUE(514) /* get y */,
+    JS_ROM_VALUE(525) /* get y */,
     JS_CFUNC_generic, 0, 0 },
   { { .constructor = js_filled_rectangle_constructor },
-    JS_ROM_VALUE(516) /* FilledRectangle */,
+    JS_ROM_VALUE(527) /* FilledRectangle */,
     JS_CFUNC_constructor, 3, JS_CLASS_FILLED_RECTANGLE },
   { { .generic = js_filled_rectangle_get_color },
-    JS_ROM_VALUE(521) /* get color */,
+    JS_ROM_VALUE(532) /* get color */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic = js_global_isNaN },
-    JS_ROM_VALUE(485) /* isNaN */,
+    JS_ROM_VALUE(496) /* isNaN */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_global_isFinite },
-    JS_ROM_VALUE(487) /* isFinite */,
+    JS_ROM_VALUE(498) /* isFinite */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_print },
-    JS_ROM_VALUE(500) /* print */,
+    JS_ROM_VALUE(511) /* print */,
     JS_CFUNC_generic, 1, 0 },
 };
 
@@ -2577,10 +2625,10 @@ const JSSTDLibraryDef js_stdlib = {
   js_stdlib_table,
   js_c_function_table,
   js_c_finalizer_table,
-  1957,
+  1990,
   64,
-  524,
-  1878,
+  535,
+  1911,
   JS_CLASS_COUNT,
 };
 
@@ -0,0 +1,253 @@
+/* this file is automatically generated by gas_table_generator - do not edit */
+
+#ifndef MQUICKJS_GAS_H
+#define MQUICKJS_GAS_H
+
+/* gas charged by each interpreter opcode */
+static const uint8_t gas_cost[OP_COUNT] = {
+    0, /* invalid */
+    1, /* push_value = OP_STACK_PUSH */
+    1, /* push_const = OP_STACK_PUSH */
+    10, /* fclosure = OP_FUNC_DECL */
+    1, /* undefined = OP_STACK_PUSH */
+    1, /* null = OP_STACK_PUSH */
+    1, /* push_this = OP_STACK_PUSH */
+    1, /* push_false = OP_STACK_PUSH */
+    1, /* push_true = OP_STACK_PUSH */
+    5, /* object = OP_OBJECT_NEW */
+    1, /* this_func = OP_STACK_PUSH */
+    1, /* arguments = OP_STACK_PUSH */
+    1, /* new_target = OP_STACK_PUSH */
+    1, /* drop = OP_STACK_POP */
+    1, /* nip = OP_STACK_POP */
+    1, /* dup = OP_STACK_PUSH */
+    1, /* dup1 = OP_STACK_PUSH */
+    1, /* dup2 = OP_STACK_PUSH */
+    1, /* insert2 = OP_STACK_PUSH */
+    1, /* insert3 = OP_STACK_PUSH */
+    1, /* perm3 = OP_STACK_PUSH */
+    1, /* perm4 = OP_STACK_PUSH */
+    1, /* swap = OP_STACK_PUSH */
+    1, /* rot3l = OP_STACK_PUSH */
+    20, /* call_constructor = OP_NEW */
+    5, /* call = OP_FUNC_CALL */
+    5, /* call_method = OP_FUNC_CALL */
+    5, /* array_from = OP_ARRAY_NEW */
+    3, /* return = OP_RETURN */
+    3, /* return_undef = OP_RETURN */
+    10, /* throw = OP_THROW */
+    5, /* regexp = OP_OBJECT_NEW */
+    3, /* get_field = OP_PROP_ACCESS */
+    3, /* get_field2 = OP_PROP_ACCESS */
+    4, /* put_field = OP_PROP_ASSIGN */
+    2, /* get_array_el = OP_ARRAY_ACCESS */
+    2, /* get_array_el2 = OP_ARRAY_ACCESS */
+    3, /* put_array_el = OP_ARRAY_ASSIGN */
+    3, /* get_length = OP_PROP_ACCESS */
+    3, /* get_length2 = OP_PROP_ACCESS */
+    4, /* define_field = OP_PROP_ASSIGN */
+    4, /* define_getter = OP_PROP_ASSIGN */
+    4, /* define_setter = OP_PROP_ASSIGN */
+    4, /* set_proto = OP_PROP_ASSIGN */
+    1, /* get_loc = OP_STACK_PUSH */
+    2, /* put_loc = OP_ASSIGN */
+    1, /* get_arg = OP_STACK_PUSH */
+    2, /* put_arg = OP_ASSIGN */
+    1, /* get_var_ref = OP_STACK_PUSH */
+    2, /* put_var_ref = OP_ASSIGN */
+    1, /* get_var_ref_nocheck = OP_STACK_PUSH */
+    2, /* put_var_ref_nocheck = OP_ASSIGN */
+    3, /* if_false = OP_IF */
+    3, /* if_true = OP_IF */
+    2, /* goto = OP_BREAK */
+    3, /* catch = OP_CATCH */
+    2, /* gosub = OP_FINALLY */
+    2, /* ret = OP_SCOPE_EXIT */
+    0, /* gas */
+    6, /* for_in_start = OP_FOR */
+    6, /* for_of_start = OP_FOR */
+    2, /* for_of_next = OP_CONTINUE */
+    1, /* neg = OP_NEG */
+    1, /* plus = OP_NEG */
+    2, /* dec = OP_SUB */
+    2, /* inc = OP_ADD */
+    2, /* post_dec = OP_SUB */
+    2, /* post_inc = OP_ADD */
+    1, /* not = OP_NEG */
+    1, /* lnot = OP_LNOT */
+    2, /* typeof = OP_TYPEOF */
+    5, /* delete = OP_DELETE */
+    3, /* mul = OP_MUL */
+    4, /* div = OP_DIV */
+    4, /* mod = OP_MOD */
+    2, /* add = OP_ADD */
+    2, /* sub = OP_SUB */
+    3, /* pow = OP_MUL */
+    2, /* shl = OP_ADD */
+    2, /* sar = OP_ADD */
+    2, /* shr = OP_ADD */
+    2, /* lt = OP_LT */
+    2, /* lte = OP_LE */
+    2, /* gt = OP_GT */
+    2, /* gte = OP_GE */
+    3, /* instanceof = OP_INSTANCEOF */
+    2, /* in = OP_IN */
+    2, /* eq = OP_EQ */
+    2, /* neq = OP_NE */
+    2, /* strict_eq = OP_STRICT_EQ */
+    2, /* strict_neq = OP_STRICT_NE */
+    2, /* and = OP_LAND */
+    2, /* xor = OP_LOR */
+    2, /* or = OP_LOR */
+    0, /* nop */
+    1, /* push_minus1 = OP_STACK_PUSH */
+    1, /* push_0 = OP_STACK_PUSH */
+    1, /* push_1 = OP_STACK_PUSH */
+    1, /* push_2 = OP_STACK_PUSH */
+    1, /* push_3 = OP_STACK_PUSH */
+    1, /* push_4 = OP_STACK_PUSH */
+    1, /* push_5 = OP_STACK_PUSH */
+    1, /* push_6 = OP_STACK_PUSH */
+    1, /* push_7 = OP_STACK_PUSH */
+    1, /* push_i8 = OP_STACK_PUSH */
+    1, /* push_i16 = OP_STACK_PUSH */
+    1, /* push_const8 = OP_STACK_PUSH */
+    10, /* fclosure8 = OP_FUNC_DECL */
+    1, /* push_empty_string = OP_STACK_PUSH */
+    1, /* get_loc8 = OP_STACK_PUSH */
+    2, /* put_loc8 = OP_ASSIGN */
+    1, /* get_loc0 = OP_STACK_PUSH */
+    1, /* get_loc1 = OP_STACK_PUSH */
+    1, /* get_loc2 = OP_STACK_PUSH */
+    1, /* get_loc3 = OP_STACK_PUSH */
+    2, /* put_loc0 = OP_ASSIGN */
+    2, /* put_loc1 = OP_ASSIGN */
+    2, /* put_loc2 = OP_ASSIGN */
+    2, /* put_loc3 = OP_ASSIGN */
+    1, /* get_arg0 = OP_STACK_PUSH */
+    1, /* get_arg1 = OP_STACK_PUSH */
+    1, /* get_arg2 = OP_STACK_PUSH */
+    1, /* get_arg3 = OP_STACK_PUSH */
+    2, /* put_arg0 = OP_ASSIGN */
+    2, /* put_arg1 = OP_ASSIGN */
+    2, /* put_arg2 = OP_ASSIGN */
+    2, /* put_arg3 = OP_ASSIGN */
+};
+
+/* Annex A costs of the built-in functions */
+#define GAS_COST_OP_ADD 2
+#define GAS_COST_OP_SUB 2
+#define GAS_COST_OP_MUL 3
+#define GAS_COST_OP_DIV 4
+#define GAS_COST_OP_MOD 4
+#define GAS_COST_OP_NEG 1
+#define GAS_COST_OP_LT 2
+#define GAS_COST_OP_LE 2
+#define GAS_COST_OP_GT 2
+#define GAS_COST_OP_GE 2
+#define GAS_COST_OP_EQ 2
+#define GAS_COST_OP_NE 2
+#define GAS_COST_OP_STRICT_EQ 2
+#define GAS_COST_OP_STRICT_NE 2
+#define GAS_COST_OP_LNOT 1
+#define GAS_COST_OP_LAND 2
+#define GAS_COST_OP_LOR 2
+#define GAS_COST_OP_IF 3
+#define GAS_COST_OP_IF_ELSE 4
+#define GAS_COST_OP_WHILE 5
+#define GAS_COST_OP_FOR 6
+#define GAS_COST_OP_BREAK 2
+#define GAS_COST_OP_CONTINUE 2
+#define GAS_COST_OP_RETURN 3
+#define GAS_COST_OP_THROW 10
+#define GAS_COST_OP_TRY 5
+#define GAS_COST_OP_CATCH 3
+#define GAS_COST_OP_FINALLY 2
+#define GAS_COST_OP_VAR_DECL 3
+#define GAS_COST_OP_ASSIGN 2
+#define GAS_COST_OP_PROP_ACCESS 3
+#define GAS_COST_OP_PROP_ASSIGN 4
+#define GAS_COST_OP_ARRAY_ACCESS 2
+#define GAS_COST_OP_ARRAY_ASSIGN 3
+#define GAS_COST_OP_FUNC_DECL 10
+#define GAS_COST_OP_FUNC_CALL 5
+#define GAS_COST_OP_NEW 20
+#define GAS_COST_OP_DELETE 5
+#define GAS_COST_OP_TYPEOF 2
+#define GAS_COST_OP_INSTANCEOF 3
+#define GAS_COST_OP_IN 2
+#define GAS_COST_OP_STR_CONCAT 3
+#define GAS_COST_OP_STR_INDEX 2
+#define GAS_COST_OP_STR_SLICE 4
+#define GAS_COST_OP_STR_SPLIT 10
+#define GAS_COST_OP_STR_REPLACE 8
+#define GAS_COST_OP_STR_SEARCH 6
+#define GAS_COST_OP_STR_MATCH 15
+#define GAS_COST_OP_STR_FORMAT 5
+#define GAS_COST_OP_ARRAY_NEW 5
+#define GAS_COST_OP_ARRAY_PUSH 3
+#define GAS_COST_OP_ARRAY_POP 2
+#define GAS_COST_OP_ARRAY_SHIFT 3
+#define GAS_COST_OP_ARRAY_UNSHIFT 4
+#define GAS_COST_OP_ARRAY_SLICE 5
+#define GAS_COST_OP_ARRAY_SPLICE 8
+#define GAS_COST_OP_ARRAY_JOIN 6
+#define GAS_COST_OP_ARRAY_SORT 20
+#define GAS_COST_OP_ARRAY_REVERSE 3
+#define GAS_COST_OP_OBJECT_NEW 5
+#define GAS_COST_OP_OBJECT_KEYS 4
+#define GAS_COST_OP_OBJECT_VALUES 4
+#define GAS_COST_OP_OBJECT_ENTRIES 5
+#define GAS_COST_OP_JSON_PARSE 20
+#define GAS_COST_OP_JSON_STRINGIFY 15
+#define GAS_COST_OP_CRYPTO_SHA256 50
+#define GAS_COST_OP_CRYPTO_MD5 30
+#define GAS_COST_OP_CRYPTO_HMAC_SHA256 60
+#define GAS_COST_OP_CRYPTO_SIGN 200
+#define GAS_COST_OP_CRYPTO_VERIFY 150
+#define GAS_COST_OP_CRYPTO_RANDOM 10
+#define GAS_COST_OP_DB_READ 100
+#define GAS_COST_OP_DB_WRITE 150
+#define GAS_COST_OP_DB_CONNECT 50
+#define GAS_COST_OP_DB_QUERY 80
+#define GAS_COST_OP_DB_TRANSACTION 30
+#define GAS_COST_OP_HTTP_GET 100
+#define GAS_COST_OP_HTTP_POST 120
+#define GAS_COST_OP_HTTP_PUT 120
+#define GAS_COST_OP_HTTP_DELETE 100
+#define GAS_COST_OP_HTTP_REQUEST 80
+#define GAS_COST_OP_HTTP_RESPONSE 60
+#define GAS_COST_OP_FILE_READ 50
+#define GAS_COST_OP_FILE_WRITE 60
+#define GAS_COST_OP_FILE_OPEN 20
+#define GAS_COST_OP_FILE_CLOSE 5
+#define GAS_COST_OP_FILE_STAT 15
+#define GAS_COST_OP_LOG_DEBUG 5
+#define GAS_COST_OP_LOG_INFO 5
+#define GAS_COST_OP_LOG_WARN 5
+#define GAS_COST_OP_LOG_ERROR 5
+#define GAS_COST_OP_PIPELINE 3
+#define GAS_COST_OP_PIPELINE_CALL 4
+#define GAS_COST_OP_MATCH 10
+#define GAS_COST_OP_MATCH_CASE 5
+#define GAS_COST_OP_UNION_CREATE 8
+#define GAS_COST_OP_UNION_MATCH 12
+#define GAS_COST_OP_OPTION_SOME 3
+#define GAS_COST_OP_OPTION_NONE 2
+#define GAS_COST_OP_RESULT_OK 3
+#define GAS_COST_OP_RESULT_ERR 3
+#define GAS_COST_OP_EFFECT_REGISTER 20
+#define GAS_COST_OP_EFFECT_PERFORM 100
+#define GAS_COST_OP_EFFECT_HANDLER 15
+#define GAS_COST_OP_CLONE_VM 200
+#define GAS_COST_OP_SNAPSHOT_LOAD 150
+#define GAS_COST_OP_SNAPSHOT_SAVE 100
+#define GAS_COST_OP_GAS_CHECK 1
+#define GAS_COST_OP_GAS_CONSUME 1
+#define GAS_COST_OP_STACK_PUSH 1
+#define GAS_COST_OP_STACK_POP 1
+#define GAS_COST_OP_SCOPE_ENTER 2
+#define GAS_COST_OP_SCOPE_EXIT 2
+#define GAS_COST_OP_TAIL_CALL 0
+
+#endif /* MQUICKJS_GAS_H */
@@ -2,7 +2,9 @@
  * MTPScript Crypto Implementation - ECDSA-P256
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include <openssl/evp.h>
 #include <openssl/ecdsa.h>
 #include <openssl/sha.h>
@@ -23,73 +25,177 @@ const ECDSAPublicKey mtpscript_public_key = {
           0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F}
 };
 
-/* Verify ECDSA-P256 signature using OpenSSL */
-JS_BOOL JS_VerifySnapshotSignature(const uint8_t *data, size_t data_len,
-                                   const uint8_t *signature, size_t sig_len,
-                                   const ECDSAPublicKey *pubkey) {
-    int ret = 0;
-    EC_KEY *ec_key = NULL;
-    EC_GROUP *group = NULL;
-    BIGNUM *x = NULL;
-    BIGNUM *y = NULL;
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    ECDSA_SIG *ecdsa_sig = NULL;
-    BIGNUM *r = NULL;
-    BIGNUM *s = NULL;
-
-    /* Basic validation */
-    if (!data || !signature || !pubkey || data_len == 0 || sig_len != 64) {
-        return 0;
-    }
-
-    /* Create EC key for P-256 curve */
-    group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
-    if (!group) goto cleanup;
-
-    ec_key = EC_KEY_new();
-    if (!ec_key) goto cleanup;
-
-    if (!EC_KEY_set_group(ec_key, group)) goto cleanup;
+#define JS_VERIFY_CACHE_SIZE 16 /* verified signatures per key */
+#define JS_VERIFIER_COUNT    4  /* keys with a shared verifier */
+
+typedef struct {
+    JS_BOOL used;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint8_t signature[64];
+} JSVerifiedSignature;
+
+struct JSSnapshotVerifier {
+    ECDSAPublicKey pubkey;
+    EC_KEY *ec_key;
+    pthread_mutex_t lock;
+    int cache_next; /* next entry to replace */
+    JSVerifiedSignature cache[JS_VERIFY_CACHE_SIZE];
+};
 
-    /* Set public key from provided coordinates */
+JSSnapshotVerifier *JS_NewSnapshotVerifier(const ECDSAPublicKey *pubkey)
+{
+    JSSnapshotVerifier *v;
+    BIGNUM *x, *y;
+    JS_BOOL ok;
+
+    v = calloc(1, sizeof(*v));
+    if (!v)
+        return NULL;
+    v->pubkey = *pubkey;
+    v->ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
     x = BN_bin2bn(pubkey->x, 32, NULL);
     y = BN_bin2bn(pubkey->y, 32, NULL);
-    if (!x || !y) goto cleanup;
+    /* also checks that the point is on the curve */
+    ok = v->ec_key && x && y &&
+        EC_KEY_set_public_key_affine_coordinates(v->ec_key, x, y);
+    BN_free(x);
+    BN_free(y);
+    if (!ok) {
+        EC_KEY_free(v->ec_key);
+        free(v);
+        return NULL;
+    }
+    pthread_mutex_init(&v->lock, NULL);
+    return v;
+}
 
-    if (!EC_KEY_set_public_key_affine_coordinates(ec_key, x, y)) goto cleanup;
+void JS_FreeSnapshotVerifier(JSSnapshotVerifier *v)
+{
+    if (!v)
+        return;
+    EC_KEY_free(v->ec_key);
+    pthread_mutex_destroy(&v->lock);
+    free(v);
+}
 
-    /* Hash the data with SHA-256 */
-    SHA256(data, data_len, hash);
+/* 'signature' is r(32) + s(32) */
+static JS_BOOL js_ecdsa_verify(EC_KEY *ec_key, const uint8_t *digest,
+                            const uint8_t *signature)
+{
+    ECDSA_SIG *ecdsa_sig;
+    BIGNUM *r, *s;
+    int ret;
 
-    /* Parse signature - ECDSA-P256 uses DER format, but we expect raw r,s */
-    /* For simplicity, assume signature is 64 bytes: r(32) + s(32) */
     r = BN_bin2bn(signature, 32, NULL);
     s = BN_bin2bn(signature + 32, 32, NULL);
-    if (!r || !s) goto cleanup;
-
     ecdsa_sig = ECDSA_SIG_new();
-    if (!ecdsa_sig) goto cleanup;
+    if (!r || !s || !ecdsa_sig || !ECDSA_SIG_set0(ecdsa_sig, r, s)) {
+        BN_free(r);
+        BN_free(s);
+        ECDSA_SIG_free(ecdsa_sig);
+        return 0;
+    }
+    /* r and s are owned by ecdsa_sig */
+    ret = ECDSA_do_verify(digest, SHA256_DIGEST_LENGTH, ecdsa_sig, ec_key);
+    ECDSA_SIG_free(ecdsa_sig);
+    return ret == 1;
+}
 
-    if (!ECDSA_SIG_set0(ecdsa_sig, r, s)) goto cleanup;
-    r = s = NULL; /* Ownership transferred */
+JS_BOOL JS_VerifySnapshotSignature2(JSSnapshotVerifier *v,
+                                    const uint8_t *data, size_t data_len,
+                                    const uint8_t *signature, size_t sig_len)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    JSVerifiedSignature *e;
+    JS_BOOL ok;
+    int i;
 
-    /* Verify the signature */
-    ret = ECDSA_do_verify(hash, SHA256_DIGEST_LENGTH, ecdsa_sig, ec_key);
+    /* Basic validation */
+    if (!v || !data || !signature || data_len == 0 || sig_len != 64)
+        return 0;
+
+    /* the digest is always computed: a cache hit requires the same
+       data and the same signature */
+    SHA256(data, data_len, digest);
+
+    pthread_mutex_lock(&v->lock);
+    for(i = 0; i < JS_VERIFY_CACHE_SIZE; i++) {
+        e = &v->cache[i];
+        if (e->used && !memcmp(e->digest, digest, sizeof(digest)) &&
+            !memcmp(e->signature, signature, 64)) {
+            pthread_mutex_unlock(&v->lock);
+            return 1;
+        }
+    }
+    /* the key is shared: verify under the lock */
+    ok = js_ecdsa_verify(v->ec_key, digest, signature);
+    if (ok) {
+        e = &v->cache[v->cache_next];
+        v->cache_next = (v->cache_next + 1) % JS_VERIFY_CACHE_SIZE;
+        e->used = 1;
+        memcpy(e->digest, digest, sizeof(digest));
+        memcpy(e->signature, signature, 64);
+    }
+    pthread_mutex_unlock(&v->lock);
+    return ok;
+}
+
+static pthread_mutex_t js_verifiers_lock = PTHREAD_MUTEX_INITIALIZER;
+static JSSnapshotVerifier *js_verifiers[JS_VERIFIER_COUNT];
+
+/* return the shared verifier of 'pubkey' or NULL if the key is
+   invalid. The shared verifiers live until the process exits. When
+   all of them are used, a temporary verifier is returned. */
+static JSSnapshotVerifier *js_get_verifier(const ECDSAPublicKey *pubkey,
+                                           JS_BOOL *ptemporary)
+{
+    JSSnapshotVerifier *v;
+    int i;
+
+    *ptemporary = 0;
+    pthread_mutex_lock(&js_verifiers_lock);
+    for(i = 0; i < JS_VERIFIER_COUNT; i++) {
+        v = js_verifiers[i];
+        if (v && !memcmp(&v->pubkey, pubkey, sizeof(*pubkey))) {
+            pthread_mutex_unlock(&js_verifiers_lock);
+            return v;
+        }
+    }
+    v = JS_NewSnapshotVerifier(pubkey);
+    if (v) {
+        for(i = 0; i < JS_VERIFIER_COUNT; i++) {
+            if (!js_verifiers[i])
+                break;
+        }
+        if (i < JS_VERIFIER_COUNT) {
+            js_verifiers[i] = v;
+        } else {
+            /* another thread may use the shared ones */
+            *ptemporary = 1;
+        }
+    }
+    pthread_mutex_unlock(&js_verifiers_lock);
+    return v;
+}
 
-cleanup:
-    if (ecdsa_sig) ECDSA_SIG_free(ecdsa_sig);
-    if (r) BN_free(r);
-    if (s) BN_free(s);
-    if (x) BN_free(x);
-    if (y) BN_free(y);
-    if (ec_key) EC_KEY_free(ec_key);
-    if (group) EC_GROUP_free(group);
+/* Verify ECDSA-P256 signature using OpenSSL */
+JS_BOOL JS_VerifySnapshotSignature(const uint8_t *data, size_t data_len,
+                                   const uint8_t *signature, size_t sig_len,
+                                   const ECDSAPublicKey *pubkey) {
+    JSSnapshotVerifier *v;
+    JS_BOOL temporary, ok;
 
-    return ret == 1 ? 1 : 0;
+    if (!pubkey)
+        return 0;
+    v = js_get_verifier(pubkey, &temporary);
+    ok = JS_VerifySnapshotSignature2(v, data, data_len, signature, sig_len);
+    if (temporary)
+        JS_FreeSnapshotVerifier(v);
+    return ok;
 }
 
 /* Load and verify snapshot with signature */
-JSValue JS_LoadSnapshot(JSContext *ctx, const uint8_t *snapshot_data, size_t snapshot_len,
+JSValue JS_LoadSnapshot(JSContext *ctx, uint8_t *snapshot_data, size_t snapshot_len,
                         const uint8_t *signature_data, size_t sig_len) {
     /* Verify signature first */
     if (!JS_VerifySnapshotSignature(snapshot_data, snapshot_len,
@@ -100,5 +206,10 @@ JSValue JS_LoadSnapshot(JSContext *ctx, const uint8_t *snapshot_data, size_t sna
     }
 
     /* Load the snapshot */
+    if (!JS_IsBytecode(snapshot_data, snapshot_len) ||
+        JS_RelocateBytecode(ctx, snapshot_data, snapshot_len)) {
+        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR,
+                           "Snapshot bytecode cannot be relocated");
+    }
     return JS_LoadBytecode(ctx, snapshot_data);
 }
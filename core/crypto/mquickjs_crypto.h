@@ -15,13 +15,29 @@ typedef struct {
 /* Embedded public key for snapshot verification */
 extern const ECDSAPublicKey mtpscript_public_key;
 
-/* Verify ECDSA-P256 signature */
+/* Verifier for one public key: the key is parsed once and the
+   (SHA-256 of the data, signature) pairs which were verified are
+   cached, so verifying the same snapshot again only hashes it. Only
+   successful verifications are cached. Thread safe. */
+typedef struct JSSnapshotVerifier JSSnapshotVerifier;
+
+/* return NULL if the key is not a valid P-256 point */
+JSSnapshotVerifier *JS_NewSnapshotVerifier(const ECDSAPublicKey *pubkey);
+void JS_FreeSnapshotVerifier(JSSnapshotVerifier *v);
+JS_BOOL JS_VerifySnapshotSignature2(JSSnapshotVerifier *v,
+                                    const uint8_t *data, size_t data_len,
+                                    const uint8_t *signature, size_t sig_len);
+
+/* Verify ECDSA-P256 signature. The verifiers of the first four keys
+   used are kept until the process exits; other keys get a temporary
+   verifier, so their verifications are not cached. */
 JS_BOOL JS_VerifySnapshotSignature(const uint8_t *data, size_t data_len,
                                    const uint8_t *signature, size_t sig_len,
                                    const ECDSAPublicKey *pubkey);
 
-/* Load and verify snapshot with signature */
-JSValue JS_LoadSnapshot(JSContext *ctx, const uint8_t *snapshot_data, size_t snapshot_len,
+/* Load and verify snapshot with signature. The bytecode is relocated in
+   place, so the signature covers the unrelocated bytecode. */
+JSValue JS_LoadSnapshot(JSContext *ctx, uint8_t *snapshot_data, size_t snapshot_len,
                         const uint8_t *signature_data, size_t sig_len);
 
 #endif /* MQUICKJS_CRYPTO_H */
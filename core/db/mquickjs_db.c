@@ -6,89 +6,604 @@
 #include "mquickjs_db.h"
 #include "mquickjs_crypto.h"
 #include "mquickjs_log.h"
+#include "mquickjs_effects.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <pthread.h>
+#include <time.h>
 #include <openssl/sha.h>
 
-// Database configuration
+// Default database configuration
 #define DB_HOST "127.0.0.1"
 #define DB_USER "root"
 #define DB_PASS "root"
 #define DB_NAME "mtpscript_test"
 #define DB_PORT 3306
 
-// Thread-local storage for database pool and cache
-__thread MTPScriptDBPool *g_db_pool = NULL;
-__thread MTPScriptDBCache *g_db_cache = NULL;
+#define DB_MIN_CONNECTIONS 2
+#define DB_MAX_CONNECTIONS 16
+#define DB_ACQUIRE_TIMEOUT_MS 5000
+#define DB_HEALTH_CHECK_INTERVAL_MS 30000
+#define DB_STMT_CACHE_SIZE 32
+
+// Query of DbRead until parameters are supported
+#define DB_READ_QUERY "SELECT 1 as test_value, 'parameterized_query' as query_type"
+
+// Client errors (CR_*, errmsg.h) leave the connection in an unknown state
+#define DB_CLIENT_ERROR_MIN 2000
+#define DB_CLIENT_ERROR_MAX 2999
+
+typedef struct {
+    char *sql;
+    uint32_t hash;
+    void *stmt;
+    uint64_t last_used;          // LRU tick
+} MTPScriptDBStmt;
+
+struct MTPScriptDBConn {
+    void *handle;
+    bool in_use;                 // Checked out by a caller or the health thread
+    uint64_t idle_since_ms;
+    MTPScriptDBStmt *stmts;
+    int stmt_count;
+    uint64_t stmt_tick;
+};
+
+// A thread blocked in mtpscript_db_acquire(). The releasing thread hands
+// its connection over directly, or sets 'retry' when a slot was freed.
+// The slot is then reserved for the waiter, which keeps its turn.
+typedef struct MTPScriptDBWaiter {
+    pthread_cond_t cond;
+    MTPScriptDBConn *conn;
+    bool retry;
+    struct MTPScriptDBWaiter *next;
+} MTPScriptDBWaiter;
+
+struct MTPScriptDBPool {
+    pthread_mutex_t lock;
+    MTPScriptDBConfig config;
+    const MTPScriptDBDriver *driver;
+    MTPScriptDBConn *conns[MTPSCRIPT_DB_MAX_CONNECTIONS];
+    int conn_count;
+    int pending;                 // Connections being opened, or slots reserved for a waiter
+    MTPScriptDBWaiter *wait_head;
+    MTPScriptDBWaiter *wait_tail;
+    pthread_t health_thread;
+    pthread_cond_t health_cond;
+    bool stopping;
+    MTPScriptDBPoolStats stats;
+};
+
+// Process-wide pool
+static pthread_mutex_t g_db_lock = PTHREAD_MUTEX_INITIALIZER;
+static MTPScriptDBPool *g_db_pool = NULL;
+static MTPScriptDBConfig g_db_config;
+static bool g_db_config_set = false;
+
+// The client library state of the calling thread, set up on its first
+// acquire and released when the thread exits
+static pthread_once_t db_thread_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t db_thread_key;
+static __thread bool db_thread_ready = false;
+
+static void db_thread_exit(void *opaque) {
+    mysql_thread_end();
+}
 
-// Initialize database connection pool
-MTPScriptDBPool *mtpscript_db_pool_new(void) {
-    if (g_db_pool) return g_db_pool;
+static void db_thread_key_init(void) {
+    pthread_key_create(&db_thread_key, db_thread_exit);
+}
+
+static void db_thread_init(void) {
+    if (db_thread_ready) return;
+    pthread_once(&db_thread_key_once, db_thread_key_init);
+    mysql_thread_init();
+    // Any non NULL value runs the destructor
+    pthread_setspecific(db_thread_key, &db_thread_ready);
+    db_thread_ready = true;
+}
+
+static uint64_t db_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void db_deadline(struct timespec *ts, int timeout_ms) {
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout_ms / 1000;
+    ts->tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+static void db_cond_init(pthread_cond_t *cond) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static void db_copy_env(char *dst, size_t size, const char *name) {
+    const char *val = getenv(name);
+    if (val && *val) snprintf(dst, size, "%s", val);
+}
+
+void mtpscript_db_config_init(MTPScriptDBConfig *config) {
+    const char *port;
+
+    memset(config, 0, sizeof(*config));
+    snprintf(config->host, sizeof(config->host), "%s", DB_HOST);
+    snprintf(config->user, sizeof(config->user), "%s", DB_USER);
+    snprintf(config->password, sizeof(config->password), "%s", DB_PASS);
+    snprintf(config->database, sizeof(config->database), "%s", DB_NAME);
+    config->port = DB_PORT;
+    config->min_connections = DB_MIN_CONNECTIONS;
+    config->max_connections = DB_MAX_CONNECTIONS;
+    config->acquire_timeout_ms = DB_ACQUIRE_TIMEOUT_MS;
+    config->health_check_interval_ms = DB_HEALTH_CHECK_INTERVAL_MS;
+    config->stmt_cache_size = DB_STMT_CACHE_SIZE;
+
+    db_copy_env(config->host, sizeof(config->host), "MTP_DB_HOST");
+    db_copy_env(config->user, sizeof(config->user), "MTP_DB_USER");
+    db_copy_env(config->password, sizeof(config->password), "MTP_DB_PASSWORD");
+    db_copy_env(config->database, sizeof(config->database), "MTP_DB_NAME");
+    port = getenv("MTP_DB_PORT");
+    if (port && *port) config->port = (unsigned int)strtoul(port, NULL, 10);
+}
+
+bool mtpscript_db_configure(const MTPScriptDBConfig *config) {
+    bool ok;
+
+    pthread_mutex_lock(&g_db_lock);
+    ok = g_db_pool == NULL;
+    if (ok) {
+        g_db_config = *config;
+        g_db_config_set = true;
+    }
+    pthread_mutex_unlock(&g_db_lock);
+    return ok;
+}
+
+// Default driver: libmysqlclient
+static void *db_mysql_connect(const MTPScriptDBConfig *config) {
+    unsigned int timeout = (config->acquire_timeout_ms + 999) / 1000;
+    MYSQL *mysql = mysql_init(NULL);
+
+    if (!mysql) return NULL;
+    mysql_options(mysql, MYSQL_OPT_CONNECT_TIMEOUT, &timeout);
+    if (!mysql_real_connect(mysql, config->host, config->user, config->password,
+                            config->database, config->port, NULL, 0)) {
+        mysql_close(mysql);
+        return NULL;
+    }
+    return mysql;
+}
+
+static void db_mysql_close(void *handle) {
+    mysql_close(handle);
+}
+
+static int db_mysql_ping(void *handle) {
+    return mysql_ping(handle);
+}
+
+static void *db_mysql_prepare(void *handle, const char *sql) {
+    MYSQL_STMT *stmt = mysql_stmt_init(handle);
+    bool update_max_length = true;
+
+    if (!stmt) return NULL;
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) != 0) {
+        mysql_stmt_close(stmt);
+        return NULL;
+    }
+    // Report the column widths so that results are fetched in one pass
+    mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &update_max_length);
+    return stmt;
+}
+
+static void db_mysql_stmt_close(void *stmt) {
+    mysql_stmt_close(stmt);
+}
+
+static const MTPScriptDBDriver db_mysql_driver = {
+    db_mysql_connect,
+    db_mysql_close,
+    db_mysql_ping,
+    db_mysql_prepare,
+    db_mysql_stmt_close,
+};
+
+static MTPScriptDBConn *db_connect(MTPScriptDBPool *pool) {
+    MTPScriptDBConn *conn;
+
+    conn = calloc(1, sizeof(MTPScriptDBConn));
+    if (!conn) return NULL;
+    conn->stmts = calloc(pool->config.stmt_cache_size, sizeof(MTPScriptDBStmt));
+    if (conn->stmts) conn->handle = pool->driver->connect(&pool->config);
+    if (!conn->handle) {
+        free(conn->stmts);
+        free(conn);
+        return NULL;
+    }
+    return conn;
+}
 
-    g_db_pool = calloc(1, sizeof(MTPScriptDBPool));
-    if (!g_db_pool) return NULL;
+static void db_close(MTPScriptDBPool *pool, MTPScriptDBConn *conn) {
+    for (int i = 0; i < conn->stmt_count; i++) {
+        pool->driver->stmt_close(conn->stmts[i].stmt);
+        free(conn->stmts[i].sql);
+    }
+    free(conn->stmts);
+    pool->driver->close(conn->handle);
+    free(conn);
+}
+
+static MTPScriptDBWaiter *db_pop_waiter(MTPScriptDBPool *pool) {
+    MTPScriptDBWaiter *w = pool->wait_head;
+
+    if (w) {
+        pool->wait_head = w->next;
+        if (!pool->wait_head) pool->wait_tail = NULL;
+        pool->stats.waiting--;
+    }
+    return w;
+}
+
+// Hand a healthy connection to the first waiter or put it back to idle.
+// Called with the pool lock held.
+static void db_put_locked(MTPScriptDBPool *pool, MTPScriptDBConn *conn) {
+    MTPScriptDBWaiter *w = db_pop_waiter(pool);
+
+    if (w) {
+        w->conn = conn;
+        pthread_cond_signal(&w->cond);
+        return;
+    }
+    conn->in_use = false;
+    conn->idle_since_ms = db_now_ms();
+    pool->stats.in_use--;
+}
+
+// Reserve a freed slot for the first waiter, which opens a connection in
+// it. Called with the pool lock held.
+static void db_retry_locked(MTPScriptDBPool *pool) {
+    MTPScriptDBWaiter *w = db_pop_waiter(pool);
+
+    if (w) {
+        w->retry = true;
+        pool->pending++;
+        pthread_cond_signal(&w->cond);
+    }
+}
+
+// Remove a connection from the pool and let the first waiter open a new
+// one. Called with the pool lock held; the caller closes 'conn'.
+static void db_remove_locked(MTPScriptDBPool *pool, MTPScriptDBConn *conn) {
+    for (int i = 0; i < pool->conn_count; i++) {
+        if (pool->conns[i] == conn) {
+            pool->conns[i] = pool->conns[--pool->conn_count];
+            break;
+        }
+    }
+    pool->stats.open--;
+    db_retry_locked(pool);
+}
+
+// Open a connection in a slot reserved with 'pending'. The lock is
+// released during the connect.
+static MTPScriptDBConn *db_open_locked(MTPScriptDBPool *pool) {
+    MTPScriptDBConn *conn;
+
+    pool->pending++;
+    pthread_mutex_unlock(&pool->lock);
+    conn = db_connect(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->pending--;
+
+    if (!conn) {
+        pool->stats.connect_failures++;
+        // Give the slot to a waiter, which may have better luck
+        db_retry_locked(pool);
+        return NULL;
+    }
+    conn->in_use = true;
+    pool->conns[pool->conn_count++] = conn;
+    pool->stats.connects++;
+    pool->stats.open++;
+    pool->stats.in_use++;
+    return conn;
+}
+
+// Background health check: keep min_connections open and ping the
+// connections which have been idle for a whole interval
+static void *db_health_thread(void *opaque) {
+    MTPScriptDBPool *pool = opaque;
+    MTPScriptDBConn *idle[MTPSCRIPT_DB_MAX_CONNECTIONS];
+    struct timespec deadline;
+    int idle_count;
+    uint64_t now;
+
+    mysql_thread_init();
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->stopping) {
+        // Keep the minimum open
+        while (pool->conn_count + pool->pending < pool->config.min_connections) {
+            MTPScriptDBConn *conn = db_open_locked(pool);
+            if (!conn) break;
+            db_put_locked(pool, conn);
+            if (pool->stopping) break;
+        }
+
+        db_deadline(&deadline, pool->config.health_check_interval_ms);
+        pthread_cond_timedwait(&pool->health_cond, &pool->lock, &deadline);
+        if (pool->stopping) break;
+
+        // Check out the stale idle connections
+        now = db_now_ms();
+        idle_count = 0;
+        for (int i = 0; i < pool->conn_count; i++) {
+            MTPScriptDBConn *conn = pool->conns[i];
+            if (!conn->in_use && now - conn->idle_since_ms >= (uint64_t)pool->config.health_check_interval_ms) {
+                conn->in_use = true;
+                pool->stats.in_use++;
+                idle[idle_count++] = conn;
+            }
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+        for (int i = 0; i < idle_count; i++) {
+            if (pool->driver->ping(idle[i]->handle) != 0) {
+                pthread_mutex_lock(&pool->lock);
+                db_remove_locked(pool, idle[i]);
+                pool->stats.in_use--;
+                pool->stats.dropped++;
+                pthread_mutex_unlock(&pool->lock);
+                db_close(pool, idle[i]);
+                idle[i] = NULL;
+            }
+        }
+        pthread_mutex_lock(&pool->lock);
+        pool->stats.pings += idle_count;
+        for (int i = 0; i < idle_count; i++) {
+            if (idle[i]) db_put_locked(pool, idle[i]);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    mysql_thread_end();
+    return NULL;
+}
+
+static MTPScriptDBPool *db_pool_create(const MTPScriptDBConfig *config) {
+    MTPScriptDBPool *pool = calloc(1, sizeof(MTPScriptDBPool));
+    if (!pool) return NULL;
 
-    g_db_pool->max_connections = 16;
+    pool->config = *config;
+    pool->driver = config->driver ? config->driver : &db_mysql_driver;
+    if (pool->config.max_connections <= 0 || pool->config.max_connections > MTPSCRIPT_DB_MAX_CONNECTIONS)
+        pool->config.max_connections = MTPSCRIPT_DB_MAX_CONNECTIONS;
+    if (pool->config.min_connections < 0) pool->config.min_connections = 0;
+    if (pool->config.min_connections > pool->config.max_connections)
+        pool->config.min_connections = pool->config.max_connections;
+    if (pool->config.stmt_cache_size <= 0) pool->config.stmt_cache_size = DB_STMT_CACHE_SIZE;
+    if (pool->config.health_check_interval_ms <= 0)
+        pool->config.health_check_interval_ms = DB_HEALTH_CHECK_INTERVAL_MS;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    db_cond_init(&pool->health_cond);
+    if (pthread_create(&pool->health_thread, NULL, db_health_thread, pool) != 0) {
+        pthread_cond_destroy(&pool->health_cond);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
 
-    // Initialize MySQL library
-    mysql_library_init(0, NULL, NULL);
+// Return the process-wide pool, creating it on first use
+MTPScriptDBPool *mtpscript_db_pool_new(void) {
+    MTPScriptDBPool *pool;
 
-    return g_db_pool;
+    pthread_mutex_lock(&g_db_lock);
+    if (!g_db_pool) {
+        if (!g_db_config_set) {
+            mtpscript_db_config_init(&g_db_config);
+            g_db_config_set = true;
+        }
+        mysql_library_init(0, NULL, NULL);
+        g_db_pool = db_pool_create(&g_db_config);
+        if (!g_db_pool) mysql_library_end();
+    }
+    pool = g_db_pool;
+    pthread_mutex_unlock(&g_db_lock);
+    return pool;
 }
 
+// Close all connections and stop the health thread. No connection may be
+// checked out.
 void mtpscript_db_pool_free(MTPScriptDBPool *pool) {
     if (!pool) return;
 
-    for (int i = 0; i < pool->count; i++) {
-        if (pool->connections[i]) {
-            mysql_close(pool->connections[i]);
-        }
+    // Detach the process-wide pool first so that no caller can get it
+    pthread_mutex_lock(&g_db_lock);
+    bool global = pool == g_db_pool;
+    if (global) g_db_pool = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_signal(&pool->health_cond);
+    pthread_mutex_unlock(&pool->lock);
+    pthread_join(pool->health_thread, NULL);
+
+    for (int i = 0; i < pool->conn_count; i++) {
+        db_close(pool, pool->conns[i]);
     }
+    pthread_cond_destroy(&pool->health_cond);
+    pthread_mutex_destroy(&pool->lock);
     free(pool);
 
-    if (pool == g_db_pool) {
-        g_db_pool = NULL;
-        mysql_library_end();
-    }
+    if (global) mysql_library_end();
+    pthread_mutex_unlock(&g_db_lock);
 }
 
-// Get database connection from pool
-MYSQL *mtpscript_db_get_connection(MTPScriptDBPool *pool) {
+// Check out a connection. Idle connections are reused without a round
+// trip; otherwise a new one is opened under max_connections, or the
+// caller queues behind the earlier waiters.
+MTPScriptDBConn *mtpscript_db_acquire(MTPScriptDBPool *pool) {
+    MTPScriptDBConn *conn = NULL;
+    MTPScriptDBWaiter waiter;
+    struct timespec deadline;
+
     if (!pool) return NULL;
+    db_thread_init();
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stats.acquires++;
+    // Do not overtake the queued callers
+    if (!pool->wait_head) {
+        for (int i = 0; i < pool->conn_count; i++) {
+            if (!pool->conns[i]->in_use) {
+                conn = pool->conns[i];
+                conn->in_use = true;
+                pool->stats.in_use++;
+                goto done;
+            }
+        }
+        if (pool->conn_count + pool->pending < pool->config.max_connections) {
+            // A failed connect is reported rather than waited on
+            conn = db_open_locked(pool);
+            goto done;
+        }
+    }
 
-    // Find existing connection
-    for (int i = 0; i < pool->count; i++) {
-        if (pool->connections[i]) {
-            MYSQL *conn = pool->connections[i];
-            // Test if connection is still alive
-            if (mysql_ping(conn) == 0) {
-                return conn;
-            } else {
-                // Connection is dead, remove it
-                mysql_close(conn);
-                pool->connections[i] = NULL;
+    db_deadline(&deadline, pool->config.acquire_timeout_ms);
+    pool->stats.waits++;
+    memset(&waiter, 0, sizeof(waiter));
+    db_cond_init(&waiter.cond);
+    if (pool->wait_tail) pool->wait_tail->next = &waiter;
+    else pool->wait_head = &waiter;
+    pool->wait_tail = &waiter;
+    pool->stats.waiting++;
+
+    while (!waiter.conn && !waiter.retry) {
+        if (pthread_cond_timedwait(&waiter.cond, &pool->lock, &deadline) != 0 &&
+            !waiter.conn && !waiter.retry) {
+            // Timed out: leave the queue
+            MTPScriptDBWaiter **pw = &pool->wait_head, *prev = NULL;
+            while (*pw != &waiter) {
+                prev = *pw;
+                pw = &(*pw)->next;
             }
+            *pw = waiter.next;
+            if (pool->wait_tail == &waiter) pool->wait_tail = prev;
+            pool->stats.waiting--;
+            pool->stats.timeouts++;
+            break;
         }
     }
+    pthread_cond_destroy(&waiter.cond);
+    if (waiter.conn) {
+        conn = waiter.conn;
+    } else if (waiter.retry) {
+        // Open a connection in the slot reserved by db_retry_locked()
+        pool->pending--;
+        conn = db_open_locked(pool);
+    }
+done:
+    pthread_mutex_unlock(&pool->lock);
+    return conn;
+}
+
+void mtpscript_db_release(MTPScriptDBPool *pool, MTPScriptDBConn *conn, bool broken) {
+    if (!pool || !conn) return;
+
+    pthread_mutex_lock(&pool->lock);
+    if (broken) {
+        db_remove_locked(pool, conn);
+        pool->stats.in_use--;
+        pool->stats.dropped++;
+    } else {
+        db_put_locked(pool, conn);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (broken) db_close(pool, conn);
+}
+
+MYSQL *mtpscript_db_conn_handle(MTPScriptDBConn *conn) {
+    return conn ? conn->handle : NULL;
+}
 
-    // Create new connection if under limit
-    if (pool->count < pool->max_connections) {
-        MYSQL *conn = mysql_init(NULL);
-        if (!conn) return NULL;
+static uint32_t db_sql_hash(const char *sql) {
+    uint32_t h = 2166136261u;
+    while (*sql) {
+        h ^= (uint8_t)*sql++;
+        h *= 16777619u;
+    }
+    return h;
+}
 
-        if (!mysql_real_connect(conn, DB_HOST, DB_USER, DB_PASS, DB_NAME, DB_PORT, NULL, 0)) {
-            mysql_close(conn);
-            return NULL;
+// Return the cached statement for 'sql', preparing it on a miss. The least
+// recently used statement is closed on the server when the cache is full.
+MYSQL_STMT *mtpscript_db_prepare(MTPScriptDBPool *pool, MTPScriptDBConn *conn, const char *sql) {
+    uint32_t hash = db_sql_hash(sql);
+    MTPScriptDBStmt *s = NULL;
+    void *stmt;
+    char *copy;
+
+    for (int i = 0; i < conn->stmt_count; i++) {
+        if (conn->stmts[i].hash == hash && strcmp(conn->stmts[i].sql, sql) == 0) {
+            s = &conn->stmts[i];
+            s->last_used = ++conn->stmt_tick;
+            pthread_mutex_lock(&pool->lock);
+            pool->stats.stmt_hits++;
+            pthread_mutex_unlock(&pool->lock);
+            return s->stmt;
         }
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stats.stmt_misses++;
+    pthread_mutex_unlock(&pool->lock);
+
+    copy = strdup(sql);
+    stmt = copy ? pool->driver->prepare(conn->handle, sql) : NULL;
+    if (!stmt) {
+        free(copy);
+        return NULL;
+    }
 
-        pool->connections[pool->count++] = conn;
-        return conn;
+    if (conn->stmt_count < pool->config.stmt_cache_size) {
+        s = &conn->stmts[conn->stmt_count++];
+    } else {
+        s = &conn->stmts[0];
+        for (int i = 1; i < conn->stmt_count; i++) {
+            if (conn->stmts[i].last_used < s->last_used) s = &conn->stmts[i];
+        }
+        pool->driver->stmt_close(s->stmt);
+        free(s->sql);
     }
+    s->sql = copy;
+    s->hash = hash;
+    s->stmt = stmt;
+    s->last_used = ++conn->stmt_tick;
+    return stmt;
+}
 
-    return NULL;
+void mtpscript_db_pool_get_stats(MTPScriptDBPool *pool, MTPScriptDBPoolStats *stats) {
+    pthread_mutex_lock(&pool->lock);
+    *stats = pool->stats;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static bool db_error_is_fatal(unsigned int err) {
+    return err >= DB_CLIENT_ERROR_MIN && err <= DB_CLIENT_ERROR_MAX;
 }
 
 // Parse JSON parameters into database parameters
@@ -147,129 +662,252 @@ static void mtpscript_db_generate_cache_key(const uint8_t *seed, size_t seed_len
     SHA256(hash_input, hash_len, out_key);
 }
 
-// Database cache management
-MTPScriptDBCache *mtpscript_db_cache_new(void) {
-    if (g_db_cache) return g_db_cache;
-
-    g_db_cache = calloc(1, sizeof(MTPScriptDBCache));
-    return g_db_cache;
-}
+// Row callback of db_fetch(): the columns of the current row, with their
+// values as strings. Return -1 to stop on an error.
+typedef int DBRowFunc(void *opaque, const MYSQL_FIELD *fields, const MYSQL_BIND *binds, int num_fields);
+
+// Fetch the result set of an executed statement. Return 0, -1 on a client
+// error (message in *perror) or the error returned by 'row_func'.
+static int db_fetch(MYSQL_STMT *stmt, DBRowFunc *row_func, void *opaque, const char **perror) {
+    MYSQL_RES *meta;
+    MYSQL_FIELD *fields;
+    MYSQL_BIND *binds = NULL;
+    char **buffers = NULL;
+    int num_fields = 0, status, ret = -1;
+
+    *perror = NULL;
+    meta = mysql_stmt_result_metadata(stmt);
+    if (!meta) return 0;
+
+    if (mysql_stmt_store_result(stmt) != 0) {
+        *perror = "Failed to store result";
+        goto done;
+    }
 
-void mtpscript_db_cache_free(MTPScriptDBCache *cache) {
-    if (!cache) return;
+    fields = mysql_fetch_fields(meta);
+    num_fields = mysql_num_fields(meta);
+    binds = calloc(num_fields, sizeof(MYSQL_BIND));
+    buffers = calloc(num_fields, sizeof(char *));
+    if (!binds || !buffers) goto done;
+    for (int i = 0; i < num_fields; i++) {
+        // max_length is filled in by STMT_ATTR_UPDATE_MAX_LENGTH
+        buffers[i] = malloc(fields[i].max_length + 1);
+        if (!buffers[i]) goto done;
+        binds[i].buffer_type = MYSQL_TYPE_STRING;
+        binds[i].buffer = buffers[i];
+        binds[i].buffer_length = fields[i].max_length + 1;
+        binds[i].is_null = &binds[i].is_null_value;
+        binds[i].length = &binds[i].length_value;
+    }
+    if (mysql_stmt_bind_result(stmt, binds) != 0) {
+        *perror = "Failed to bind result";
+        goto done;
+    }
 
-    // Note: JSValue objects should be freed by the JS runtime, not here
-    free(cache);
+    while ((status = mysql_stmt_fetch(stmt)) == 0) {
+        if (row_func(opaque, fields, binds, num_fields) != 0) goto done;
+    }
+    if (status != MYSQL_NO_DATA) {
+        *perror = "Failed to fetch row";
+        goto done;
+    }
+    ret = 0;
 
-    if (cache == g_db_cache) {
-        g_db_cache = NULL;
+done:
+    if (buffers) {
+        for (int i = 0; i < num_fields; i++) free(buffers[i]);
     }
+    free(buffers);
+    free(binds);
+    mysql_stmt_free_result(stmt);
+    mysql_free_result(meta);
+    return ret;
 }
 
-JSValue mtpscript_db_cache_get(MTPScriptDBCache *cache, const uint8_t *cache_key) {
-    if (!cache || !cache->has_seed) return JS_UNDEFINED;
-
-    for (int i = 0; i < cache->count; i++) {
-        if (memcmp(cache->entries[i].cache_key, cache_key, 32) == 0) {
-            return cache->entries[i].result;
-        }
+typedef struct {
+    JSContext *ctx;
+    JSValue *prows;
+    JSValue *prow;
+    uint32_t row_index;
+} DBRowsJS;
+
+static int db_row_js(void *opaque, const MYSQL_FIELD *fields, const MYSQL_BIND *binds, int num_fields) {
+    DBRowsJS *r = opaque;
+    JSContext *ctx = r->ctx;
+    JSValue val;
+
+    *r->prow = JS_NewObject(ctx);
+    if (JS_IsException(*r->prow)) return -1;
+    for (int i = 0; i < num_fields; i++) {
+        if (*binds[i].is_null)
+            val = JS_NULL;
+        else
+            val = JS_NewStringLen(ctx, binds[i].buffer, *binds[i].length);
+        JS_SetPropertyStr(ctx, *r->prow, fields[i].name, val);
     }
-    return JS_UNDEFINED;
+    JS_SetPropertyUint32(ctx, *r->prows, r->row_index++, *r->prow);
+    return 0;
 }
 
-void mtpscript_db_cache_put(MTPScriptDBCache *cache, const uint8_t *cache_key, JSValue result) {
-    if (!cache || !cache->has_seed || cache->count >= 1024) return;
-
-    // Simple eviction: replace oldest entry if full
-    int index = cache->count < 1024 ? cache->count : 0;
-    if (cache->count >= 1024) {
-        // Note: Old JSValue would need to be freed, but we don't have context here
-        // In a real implementation, we'd need proper cleanup
+// Fetch the result set of an executed statement as an array of row
+// objects. Columns are fetched as strings, SQL NULL becomes null.
+static JSValue db_fetch_rows(JSContext *ctx, MYSQL_STMT *stmt) {
+    DBRowsJS r;
+    const char *error;
+    JSValue ret;
+    JSGCRef rows_ref, row_ref;
+
+    // Allocations may move the objects being built
+    r.ctx = ctx;
+    r.prows = JS_PushGCRef(ctx, &rows_ref);
+    r.prow = JS_PushGCRef(ctx, &row_ref);
+    r.row_index = 0;
+    *r.prows = JS_NewArray(ctx, 0);
+    if (JS_IsException(*r.prows)) {
+        ret = *r.prows;
+    } else if (db_fetch(stmt, db_row_js, &r, &error) == 0) {
+        ret = *r.prows;
+    } else if (error) {
+        ret = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "%s: %s", error, mysql_stmt_error(stmt));
     } else {
-        cache->count++;
+        ret = JS_ThrowOutOfMemory(ctx);
     }
+    JS_PopGCRef(ctx, &row_ref);
+    JS_PopGCRef(ctx, &rows_ref);
+    return ret;
+}
 
-    memcpy(cache->entries[index].cache_key, cache_key, 32);
-    cache->entries[index].result = result;
-    cache->entries[index].has_result = true;
+// Rows as JSON text, for the async DbRead
+static int db_row_json(void *opaque, const MYSQL_FIELD *fields, const MYSQL_BIND *binds, int num_fields) {
+    JSAsyncJSON *s = opaque;
+
+    JS_AsyncJSONPutRaw(s, s->len > 1 ? ",{" : "{");
+    for (int i = 0; i < num_fields; i++) {
+        if (i > 0) JS_AsyncJSONPutRaw(s, ",");
+        JS_AsyncJSONPutString(s, fields[i].name, strlen(fields[i].name));
+        JS_AsyncJSONPutRaw(s, ":");
+        if (*binds[i].is_null)
+            JS_AsyncJSONPutRaw(s, "null");
+        else
+            JS_AsyncJSONPutString(s, binds[i].buffer, *binds[i].length);
+    }
+    JS_AsyncJSONPutRaw(s, "}");
+    return s->error ? -1 : 0;
 }
 
-// Set execution seed for caching
-void mtpscript_db_cache_set_seed(MTPScriptDBCache *cache, const uint8_t *seed, size_t seed_len) {
-    if (!cache || seed_len != 32) return;
+static char *db_strerror(const char *prefix, const char *msg) {
+    size_t len = strlen(prefix) + strlen(msg) + 3;
+    char *str = malloc(len);
 
-    memcpy(cache->execution_seed, seed, 32);
-    cache->has_seed = true;
+    if (str) snprintf(str, len, "%s: %s", prefix, msg);
+    return str;
 }
 
+// DbRead off the VM thread (JSAsyncHandler). Connections are shared
+// between the worker threads through the pool.
+static char *db_read_perform(void *request, size_t *plen, char **perror) {
+    MTPScriptDBPool *pool = mtpscript_db_pool_new();
+    MTPScriptDBConn *conn;
+    MYSQL_STMT *stmt;
+    JSAsyncJSON s;
+    const char *error;
+    char *res;
+
+    if (!pool) {
+        *perror = strdup("Database system not initialized");
+        return NULL;
+    }
+    conn = mtpscript_db_acquire(pool);
+    if (!conn) {
+        *perror = strdup("Failed to get database connection");
+        return NULL;
+    }
+    stmt = mtpscript_db_prepare(pool, conn, DB_READ_QUERY);
+    if (!stmt) {
+        MYSQL *mysql = mtpscript_db_conn_handle(conn);
+        *perror = db_strerror("Query preparation failed", mysql_error(mysql));
+        mtpscript_db_release(pool, conn, db_error_is_fatal(mysql_errno(mysql)));
+        return NULL;
+    }
+    if (mysql_stmt_execute(stmt) != 0) {
+        *perror = db_strerror("Query execution failed", mysql_stmt_error(stmt));
+        mtpscript_db_release(pool, conn, db_error_is_fatal(mysql_stmt_errno(stmt)));
+        return NULL;
+    }
+
+    JS_AsyncJSONInit(&s);
+    JS_AsyncJSONPutRaw(&s, "[");
+    if (db_fetch(stmt, db_row_json, &s, &error) != 0 && error)
+        *perror = db_strerror(error, mysql_stmt_error(stmt));
+    JS_AsyncJSONPutRaw(&s, "]");
+    mtpscript_db_release(pool, conn, *perror && db_error_is_fatal(mysql_stmt_errno(stmt)));
+    if (*perror) {
+        free(s.buf);
+        return NULL;
+    }
+    res = JS_AsyncJSONFinish(&s, plen);
+    return res;
+}
+
+static const JSAsyncHandler db_read_async_handler = { NULL, db_read_perform, NULL };
+
 // Execute query (DbRead)
 JSValue mtpscript_db_read(JSContext *ctx, const uint8_t *seed, size_t seed_len, JSValue args) {
     MTPScriptDBPool *pool = mtpscript_db_pool_new();
-    MTPScriptDBCache *cache = mtpscript_db_cache_new();
+    // Results are only replayed within a seeded execution
+    MTPScriptDBCache *cache = seed_len > 0 ? mtpscript_io_cache_default() : NULL;
+    MTPScriptDBConn *conn;
+    MYSQL_STMT *stmt;
 
-    if (!pool || !cache) {
+    if (!pool) {
         return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Database system not initialized");
     }
 
-    // Set execution seed for caching
-    mtpscript_db_cache_set_seed(cache, seed, seed_len);
-
     // Simple implementation: execute a test query with parameterization simulation
-    const char *query = "SELECT 1 as test_value, 'parameterized_query' as query_type";
-    const char *params_json = "{}"; // Empty params for now
+    const char *query = DB_READ_QUERY;
 
     // Generate cache key
     uint8_t cache_key[32];
     mtpscript_db_generate_cache_key(seed, seed_len, query, NULL, 0, cache_key);
 
     // Check cache first
-    JSValue cached_result = mtpscript_db_cache_get(cache, cache_key);
+    JSValue cached_result = mtpscript_io_cache_get(cache, ctx, cache_key);
     if (!JS_IsUndefined(cached_result)) {
         return cached_result;
     }
 
-    MYSQL *conn = mtpscript_db_get_connection(pool);
+    conn = mtpscript_db_acquire(pool);
     if (!conn) {
         return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Failed to get database connection");
     }
 
-    if (mysql_query(conn, query) != 0) {
-        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Query execution failed: %s", mysql_error(conn));
+    stmt = mtpscript_db_prepare(pool, conn, query);
+    if (!stmt) {
+        MYSQL *mysql = mtpscript_db_conn_handle(conn);
+        unsigned int err = mysql_errno(mysql);
+        JSValue ex = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Query preparation failed: %s", mysql_error(mysql));
+        mtpscript_db_release(pool, conn, db_error_is_fatal(err));
+        return ex;
     }
 
-    MYSQL_RES *result = mysql_store_result(conn);
-    if (!result) {
-        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Failed to store result: %s", mysql_error(conn));
+    if (mysql_stmt_execute(stmt) != 0) {
+        unsigned int err = mysql_stmt_errno(stmt);
+        JSValue ex = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Query execution failed: %s", mysql_stmt_error(stmt));
+        mtpscript_db_release(pool, conn, db_error_is_fatal(err));
+        return ex;
     }
 
-    // Convert result to JSON array
-    MYSQL_FIELD *fields = mysql_fetch_fields(result);
-    int num_fields = mysql_num_fields(result);
-
-    JSValue json_result = JS_NewArray(ctx, 0);
-
-    MYSQL_ROW row;
-    int row_index = 0;
-    while ((row = mysql_fetch_row(result))) {
-        JSValue json_row = JS_NewObject(ctx);
-
-        for (int i = 0; i < num_fields; i++) {
-            const char *field_name = fields[i].name;
-            const char *field_value = row[i] ? row[i] : "";
-
-            JSValue js_field_value = JS_NewString(ctx, field_value);
-
-            JS_SetPropertyStr(ctx, json_row, field_name, js_field_value);
-            // JS_SetPropertyStr takes ownership, don't free js_field_value
-        }
-
-        JS_SetPropertyUint32(ctx, json_result, row_index++, json_row);
+    JSValue json_result = db_fetch_rows(ctx, stmt);
+    mtpscript_db_release(pool, conn, JS_IsException(json_result) && db_error_is_fatal(mysql_stmt_errno(stmt)));
+    if (JS_IsException(json_result)) {
+        return json_result;
     }
 
-    mysql_free_result(result);
-
     // Cache the result
-    mtpscript_db_cache_put(cache, cache_key, json_result);
+    JSGCRef json_result_ref;
+    JS_PUSH_VALUE(ctx, json_result);
+    mtpscript_io_cache_put(cache, ctx, cache_key, json_result);
+    JS_POP_VALUE(ctx, json_result);
 
     return json_result;
 }
@@ -277,15 +915,17 @@ JSValue mtpscript_db_read(JSContext *ctx, const uint8_t *seed, size_t seed_len,
 // Execute write operation (DbWrite)
 JSValue mtpscript_db_write(JSContext *ctx, const uint8_t *seed, size_t seed_len, JSValue args) {
     MTPScriptDBPool *pool = mtpscript_db_pool_new();
-    MTPScriptDBCache *cache = mtpscript_db_cache_new();
-
-    if (!pool || !cache) {
+    // Results are only replayed within a seeded execution
+    MTPScriptDBCache *cache = seed_len > 0 ? mtpscript_io_cache_default() : NULL;
+    MTPScriptDBConn *conn;
+    MYSQL_STMT *stmt;
+    MYSQL *mysql;
+    JSValue ex;
+
+    if (!pool) {
         return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Database system not initialized");
     }
 
-    // Set execution seed for caching
-    mtpscript_db_cache_set_seed(cache, seed, seed_len);
-
     // Simple implementation: execute a test CREATE TABLE with logging and idempotency simulation
     const char *query = "CREATE TABLE IF NOT EXISTS test_table (id INT AUTO_INCREMENT PRIMARY KEY, value VARCHAR(255))";
     const char *idempotency_key = "test_write_operation";
@@ -295,29 +935,36 @@ JSValue mtpscript_db_write(JSContext *ctx, const uint8_t *seed, size_t seed_len,
     mtpscript_db_generate_cache_key(seed, seed_len, query, NULL, 0, cache_key);
 
     // For idempotent operations, check cache first
-    JSValue cached_result = mtpscript_db_cache_get(cache, cache_key);
+    JSValue cached_result = mtpscript_io_cache_get(cache, ctx, cache_key);
     if (!JS_IsUndefined(cached_result)) {
         return cached_result;
     }
 
-    MYSQL *conn = mtpscript_db_get_connection(pool);
+    conn = mtpscript_db_acquire(pool);
     if (!conn) {
         return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Failed to get database connection");
     }
+    mysql = mtpscript_db_conn_handle(conn);
 
     // Start transaction
-    if (mysql_autocommit(conn, 0) != 0) {
+    if (mysql_autocommit(mysql, 0) != 0) {
+        mtpscript_db_release(pool, conn, true);
         return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Failed to start transaction");
     }
 
     // Execute query
-    if (mysql_query(conn, query) != 0) {
-        mysql_rollback(conn);
-        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Write operation failed: %s", mysql_error(conn));
+    stmt = mtpscript_db_prepare(pool, conn, query);
+    if (!stmt) {
+        ex = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Write operation failed: %s", mysql_error(mysql));
+        goto rollback;
+    }
+    if (mysql_stmt_execute(stmt) != 0) {
+        ex = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Write operation failed: %s", mysql_stmt_error(stmt));
+        goto rollback;
     }
 
     // Get affected rows
-    my_ulonglong affected_rows = mysql_affected_rows(conn);
+    my_ulonglong affected_rows = mysql_stmt_affected_rows(stmt);
 
     // Log write operation for audit trail
     char correlation_id[65];
@@ -343,10 +990,12 @@ JSValue mtpscript_db_write(JSContext *ctx, const uint8_t *seed, size_t seed_len,
     mtpscript_log_write(MTPSCRIPT_LOG_INFO, "Database write operation", correlation_id, audit_data);
 
     // Commit transaction
-    if (mysql_commit(conn) != 0) {
-        mysql_rollback(conn);
-        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Transaction commit failed");
+    if (mysql_commit(mysql) != 0) {
+        ex = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Transaction commit failed");
+        goto rollback;
     }
+    // Pooled connections are shared: leave them in autocommit mode
+    mtpscript_db_release(pool, conn, mysql_autocommit(mysql, 1) != 0);
 
     // Return result object
     JSValue result = JS_NewObject(ctx);
@@ -357,9 +1006,17 @@ JSValue mtpscript_db_write(JSContext *ctx, const uint8_t *seed, size_t seed_len,
     JS_SetPropertyStr(ctx, result, "idempotencyKey", idempotency_result_val);
 
     // Cache the result for idempotent operations
-    mtpscript_db_cache_put(cache, cache_key, result);
+    JSGCRef result_ref;
+    JS_PUSH_VALUE(ctx, result);
+    mtpscript_io_cache_put(cache, ctx, cache_key, result);
+    JS_POP_VALUE(ctx, result);
 
     return result;
+
+rollback:
+    // A connection which cannot roll back is in an unknown transaction state
+    mtpscript_db_release(pool, conn, mysql_rollback(mysql) != 0 || mysql_autocommit(mysql, 1) != 0);
+    return ex;
 }
 
 // Register database effects
@@ -369,6 +1026,9 @@ void mtpscript_db_register_effects(JSContext *ctx) {
 
     // Register DbRead effect
     JS_RegisterEffect(ctx, "DbRead", mtpscript_db_read);
+    // await DbRead(...) runs on a worker thread, batched with the other
+    // awaits of its continuation frontier
+    JS_RegisterAsyncHandler(ctx, "DbRead", &db_read_async_handler);
 
     // Register DbWrite effect
     JS_RegisterEffect(ctx, "DbWrite", mtpscript_db_write);
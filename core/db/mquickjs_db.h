@@ -1,12 +1,20 @@
 /*
  * MTPScript Database Effects Implementation
  * Specification §7 - DbRead, DbWrite Effects
+ *
+ * All contexts and threads of the process share one connection pool.
+ * Checkout never talks to the server: idle connections are pinged by a
+ * background thread, and a connection which fails a query is dropped on
+ * release. When the pool is exhausted, callers wait in FIFO order until a
+ * connection is released or the acquire timeout expires. Every connection
+ * keeps its own LRU cache of server-side prepared statements.
  */
 
 #ifndef MQUICKJS_DB_H
 #define MQUICKJS_DB_H
 
 #include "mquickjs.h"
+#include "mquickjs_iocache.h"
 #include <mysql/mysql.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -16,12 +24,59 @@
 #define size_t unsigned long
 #endif
 
-// Database connection pool
+#define MTPSCRIPT_DB_MAX_CONNECTIONS 64
+
+// Client library used by the pool, NULL for libmysqlclient
+typedef struct MTPScriptDBDriver MTPScriptDBDriver;
+
+// Database configuration. mtpscript_db_config_init() fills in the
+// defaults, overridden by the MTP_DB_HOST, MTP_DB_PORT, MTP_DB_USER,
+// MTP_DB_PASSWORD and MTP_DB_NAME environment variables.
 typedef struct {
-    MYSQL *connections[16];  // Max 16 connections per request
-    int count;
-    int max_connections;
-} MTPScriptDBPool;
+    char host[256];
+    char user[64];
+    char password[128];
+    char database[64];
+    unsigned int port;
+    int min_connections;             // Kept open by the health thread
+    int max_connections;             // <= MTPSCRIPT_DB_MAX_CONNECTIONS
+    int acquire_timeout_ms;          // Wait for a free connection
+    int health_check_interval_ms;    // Idle time before a ping
+    int stmt_cache_size;             // Prepared statements per connection
+    const MTPScriptDBDriver *driver;
+} MTPScriptDBConfig;
+
+// Connection and statement handles are opaque to the pool. With the
+// default driver they are MYSQL and MYSQL_STMT pointers.
+struct MTPScriptDBDriver {
+    void *(*connect)(const MTPScriptDBConfig *config);   // NULL on failure
+    void (*close)(void *handle);
+    int (*ping)(void *handle);                             // 0 if alive
+    void *(*prepare)(void *handle, const char *sql);      // NULL on failure
+    void (*stmt_close)(void *stmt);
+};
+
+// Pooled connection
+typedef struct MTPScriptDBConn MTPScriptDBConn;
+
+// Pool metrics
+typedef struct {
+    uint64_t acquires;
+    uint64_t waits;                  // Acquires which had to queue
+    uint64_t timeouts;
+    uint64_t connects;
+    uint64_t connect_failures;
+    uint64_t dropped;                // Connections closed as broken
+    uint64_t pings;
+    uint64_t stmt_hits;
+    uint64_t stmt_misses;
+    int open;                        // Connections right now
+    int in_use;
+    int waiting;
+} MTPScriptDBPoolStats;
+
+// Process-wide database connection pool
+typedef struct MTPScriptDBPool MTPScriptDBPool;
 
 // Database query parameters
 typedef struct {
@@ -29,27 +84,34 @@ typedef struct {
     char *value;
 } MTPScriptDBParam;
 
-// Database effect cache entry
-typedef struct {
-    uint8_t cache_key[32];   // SHA-256 of (seed, query, params)
-    JSValue result;          // Cached JS result value
-    bool has_result;
-} MTPScriptDBCacheEntry;
+// Database effect cache: results live in the shared I/O replay cache,
+// keyed by the SHA-256 cache_key of (seed, query, params)
+typedef MTPScriptIOCache MTPScriptDBCache;
 
-// Database effect cache
-typedef struct {
-    MTPScriptDBCacheEntry entries[1024];  // Simple array cache
-    int count;
-    uint8_t execution_seed[32];
-    bool has_seed;
-} MTPScriptDBCache;
+void mtpscript_db_config_init(MTPScriptDBConfig *config);
 
-// Initialize database connection pool
+// Set the configuration of the process-wide pool. Must be called before
+// the pool is first used; return false if it already exists.
+bool mtpscript_db_configure(const MTPScriptDBConfig *config);
+
+// Return the process-wide pool, creating it on first use
 MTPScriptDBPool *mtpscript_db_pool_new(void);
+// Close all connections and stop the health thread (at exit)
 void mtpscript_db_pool_free(MTPScriptDBPool *pool);
 
-// Get database connection from pool
-MYSQL *mtpscript_db_get_connection(MTPScriptDBPool *pool);
+// Check out a connection, waiting up to the acquire timeout. Return NULL
+// if none could be opened in time.
+MTPScriptDBConn *mtpscript_db_acquire(MTPScriptDBPool *pool);
+// Give back a connection. A broken connection is closed instead of reused.
+void mtpscript_db_release(MTPScriptDBPool *pool, MTPScriptDBConn *conn, bool broken);
+
+MYSQL *mtpscript_db_conn_handle(MTPScriptDBConn *conn);
+
+// Return the prepared statement for 'sql' on 'conn', preparing it on the
+// server on a cache miss. The statement is owned by the connection.
+MYSQL_STMT *mtpscript_db_prepare(MTPScriptDBPool *pool, MTPScriptDBConn *conn, const char *sql);
+
+void mtpscript_db_pool_get_stats(MTPScriptDBPool *pool, MTPScriptDBPoolStats *stats);
 
 // Execute query with caching (DbRead)
 JSValue mtpscript_db_read(JSContext *ctx, const uint8_t *seed, size_t seed_len, JSValue args);
@@ -57,12 +119,6 @@ JSValue mtpscript_db_read(JSContext *ctx, const uint8_t *seed, size_t seed_len,
 // Execute write operation (DbWrite)
 JSValue mtpscript_db_write(JSContext *ctx, const uint8_t *seed, size_t seed_len, JSValue args);
 
-// Database cache management
-MTPScriptDBCache *mtpscript_db_cache_new(void);
-void mtpscript_db_cache_free(MTPScriptDBCache *cache);
-JSValue mtpscript_db_cache_get(MTPScriptDBCache *cache, const uint8_t *cache_key);
-void mtpscript_db_cache_put(MTPScriptDBCache *cache, const uint8_t *cache_key, JSValue result);
-
 // Register database effects
 void mtpscript_db_register_effects(JSContext *ctx);
 
@@ -5,40 +5,93 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "mquickjs.h"
 #include "mquickjs_effects.h"
+#include "mquickjs_iocache.h"
+#include <openssl/evp.h>
 
-#define MAX_EFFECTS 64
+#define MAX_EFFECTS MAX_DECLARED_EFFECTS
+#define EFFECT_HASH_SIZE (2 * MAX_EFFECTS) /* power of two, load <= 1/2 */
+#define MAX_ASYNC_HANDLERS 32
 
 typedef struct {
     char *name;
-    JSEffectHandler handler;
+    JSEffectHandler handler; /* NULL if only declared */
 } JSEffectEntry;
 
 typedef struct {
     char *promise_hash;
-    int cont_id;
-    uint8_t seed[32];
-    JSValue result;
-    bool has_result;
-} JSIoCacheEntry;
+    JSAsyncHandler handler;
+} JSAsyncHandlerEntry;
 
 typedef struct {
+    /* interned effect names, indexed by effect ID */
     JSEffectEntry effects[MAX_EFFECTS];
     int count;
-    JSDeclaredEffects declared_effects;
+    /* open addressing: effect ID + 1, 0 = empty slot */
+    uint8_t hash_table[EFFECT_HASH_SIZE];
+    uint64_t declared_mask; /* bit n set = effect ID n is declared */
     uint8_t execution_seed[32];
     bool has_seed;
-    JSIoCacheEntry io_cache[1024];
-    int cache_count;
+    JSAsyncHandlerEntry async_handlers[MAX_ASYNC_HANDLERS];
+    int async_count;
 } JSEffectRegistry;
 
+static uint32_t effect_name_hash(const char *name) {
+    /* FNV-1a */
+    uint32_t h = 2166136261u;
+    while (*name) {
+        h ^= (uint8_t)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* Return the slot of 'name' in the hash table: either the slot holding
+   it or the empty slot where it would be inserted */
+static int effect_hash_find(JSEffectRegistry *registry, const char *name) {
+    uint32_t i = effect_name_hash(name) & (EFFECT_HASH_SIZE - 1);
+    int id1;
+
+    while ((id1 = registry->hash_table[i]) != 0) {
+        if (strcmp(registry->effects[id1 - 1].name, name) == 0) break;
+        i = (i + 1) & (EFFECT_HASH_SIZE - 1);
+    }
+    return i;
+}
+
+static int effect_lookup(JSEffectRegistry *registry, const char *name) {
+    return registry->hash_table[effect_hash_find(registry, name)] - 1;
+}
+
+/* Return the ID of 'name', interning it if needed (-1 if full) */
+static int effect_intern(JSEffectRegistry *registry, const char *name) {
+    int slot = effect_hash_find(registry, name);
+    int id;
+
+    if (registry->hash_table[slot]) return registry->hash_table[slot] - 1;
+    if (registry->count >= MAX_EFFECTS) return -1;
+
+    id = registry->count;
+    registry->effects[id].name = strdup(name);
+    if (!registry->effects[id].name) return -1;
+    registry->effects[id].handler = NULL;
+    registry->hash_table[slot] = id + 1;
+    registry->count++;
+    return id;
+}
+
 /* Get effect registry from context (stored in opaque) */
 static JSEffectRegistry *get_effect_registry(JSContext *ctx) {
     JSEffectRegistry *registry = JS_GetContextOpaque(ctx);
     if (!registry) {
         registry = calloc(1, sizeof(JSEffectRegistry));
         if (!registry) return NULL;
+        if (effect_intern(registry, "Async") != JS_EFFECT_ID_ASYNC) {
+            free(registry);
+            return NULL;
+        }
         JS_SetContextOpaque(ctx, registry);
     }
     return registry;
@@ -47,24 +100,51 @@ static JSEffectRegistry *get_effect_registry(JSContext *ctx) {
 /* Register an effect handler */
 JS_BOOL JS_RegisterEffect(JSContext *ctx, const char *name, JSEffectHandler handler) {
     JSEffectRegistry *registry = get_effect_registry(ctx);
-    if (!registry || registry->count >= MAX_EFFECTS) {
+    if (!registry) {
         return 0;
     }
 
-    /* Check if effect already exists */
-    for (int i = 0; i < registry->count; i++) {
-        if (strcmp(registry->effects[i].name, name) == 0) {
-            return 0; /* Already registered */
-        }
+    int id = effect_intern(registry, name);
+    if (id < 0 || registry->effects[id].handler) {
+        return 0; /* Full or already registered */
     }
-
-    registry->effects[registry->count].name = strdup(name);
-    registry->effects[registry->count].handler = handler;
-    registry->count++;
+    registry->effects[id].handler = handler;
 
     return 1;
 }
 
+/* Return the interned ID of an effect name or -1 if it is not known */
+int JS_GetEffectId(JSContext *ctx, const char *name) {
+    JSEffectRegistry *registry = JS_GetContextOpaque(ctx);
+    if (!registry) {
+        return -1;
+    }
+    return effect_lookup(registry, name);
+}
+
+/* Call an effect by its interned ID */
+JSValue JS_CallEffectById(JSContext *ctx, int effect_id, const uint8_t *seed, size_t seed_len,
+                          JSValue args) {
+    JSEffectRegistry *registry = JS_GetContextOpaque(ctx);
+    if (!registry) {
+        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Effect system not initialized");
+    }
+    if (effect_id < 0 || effect_id >= registry->count) {
+        return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, "Unknown effect id: %d", effect_id);
+    }
+
+    /* Runtime enforcement: check if effect is declared */
+    JSEffectEntry *entry = &registry->effects[effect_id];
+    if (!(registry->declared_mask & ((uint64_t)1 << effect_id))) {
+        return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR,
+                           "Undeclared effect usage blocked by runtime enforcement: %s", entry->name);
+    }
+    if (!entry->handler) {
+        return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, "Unknown effect: %s", entry->name);
+    }
+    return entry->handler(ctx, seed, seed_len, args);
+}
+
 /* Call an effect */
 JSValue JS_CallEffect(JSContext *ctx, const char *name, const uint8_t *seed, size_t seed_len,
                       JSValue args) {
@@ -73,19 +153,12 @@ JSValue JS_CallEffect(JSContext *ctx, const char *name, const uint8_t *seed, siz
         return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Effect system not initialized");
     }
 
-    /* Runtime enforcement: check if effect is declared */
-    if (!JS_IsEffectDeclared(ctx, name)) {
+    int id = effect_lookup(registry, name);
+    if (id < 0) {
         return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR,
                            "Undeclared effect usage blocked by runtime enforcement: %s", name);
     }
-
-    for (int i = 0; i < registry->count; i++) {
-        if (strcmp(registry->effects[i].name, name) == 0) {
-            return registry->effects[i].handler(ctx, seed, seed_len, args);
-        }
-    }
-
-    return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, "Unknown effect: %s", name);
+    return JS_CallEffectById(ctx, id, seed, seed_len, args);
 }
 
 /* Runtime enforcement: set declared effects for this context */
@@ -95,25 +168,15 @@ JS_BOOL JS_SetDeclaredEffects(JSContext *ctx, const char **effects, int count) {
         return 0;
     }
 
-    /* Clear existing declared effects */
-    for (int i = 0; i < registry->declared_effects.count; i++) {
-        free(registry->declared_effects.effects[i]);
-    }
-    registry->declared_effects.count = 0;
-
-    /* Set new declared effects */
+    uint64_t mask = 0;
     for (int i = 0; i < count; i++) {
-        registry->declared_effects.effects[i] = strdup(effects[i]);
-        if (!registry->declared_effects.effects[i]) {
-            /* Cleanup on failure */
-            for (int j = 0; j < i; j++) {
-                free(registry->declared_effects.effects[j]);
-            }
-            registry->declared_effects.count = 0;
-            return 0;
+        int id = effect_intern(registry, effects[i]);
+        if (id < 0) {
+            return 0; /* Previous declared set is kept */
         }
+        mask |= (uint64_t)1 << id;
     }
-    registry->declared_effects.count = count;
+    registry->declared_mask = mask;
 
     return 1;
 }
@@ -125,13 +188,8 @@ JS_BOOL JS_IsEffectDeclared(JSContext *ctx, const char *effect_name) {
         return 0; /* No registry means no effects declared */
     }
 
-    for (int i = 0; i < registry->declared_effects.count; i++) {
-        if (strcmp(registry->declared_effects.effects[i], effect_name) == 0) {
-            return 1;
-        }
-    }
-
-    return 0;
+    int id = effect_lookup(registry, effect_name);
+    return id >= 0 && (registry->declared_mask & ((uint64_t)1 << id)) != 0;
 }
 
 /* Deterministic I/O caching: set execution seed */
@@ -146,110 +204,429 @@ JS_BOOL JS_SetExecutionSeed(JSContext *ctx, const uint8_t *seed, size_t seed_len
     return 1;
 }
 
-/* Helper: generate cache key from (seed, cont_id) */
-static void generate_cache_key(const uint8_t *seed, int cont_id, uint8_t key[32]) {
-    /* Simple key generation: hash(seed + cont_id) */
-    uint8_t data[32 + sizeof(int)];
-    memcpy(data, seed, 32);
-    memcpy(data + 32, &cont_id, sizeof(int));
+/* Replay cache key: SHA-256 of (seed, promise hash, cont_id) */
+static bool generate_cache_key(const uint8_t *seed, const char *promise_hash, int cont_id,
+                               uint8_t key[32]) {
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    uint8_t id[4];
+    bool ok;
+
+    if (!md) return false;
+    id[0] = cont_id;
+    id[1] = cont_id >> 8;
+    id[2] = cont_id >> 16;
+    id[3] = cont_id >> 24;
+    ok = EVP_DigestInit_ex(md, EVP_sha256(), NULL) &&
+         EVP_DigestUpdate(md, seed, 32) &&
+         EVP_DigestUpdate(md, promise_hash, strlen(promise_hash) + 1) &&
+         EVP_DigestUpdate(md, id, sizeof(id)) &&
+         EVP_DigestFinal_ex(md, key, NULL);
+    EVP_MD_CTX_free(md);
+    return ok;
+}
+
+/* Built-in mock I/O: the JSON of a string result */
+static char *mock_http_get_perform(void *request, size_t *plen, char **perror) {
+    static const char json[] = "\"{\\\"status\\\": 200, \\\"body\\\": \\\"Hello World\\\"}\"";
+    char *res = strdup(json);
+    *plen = sizeof(json) - 1;
+    return res;
+}
+
+static char *mock_db_query_perform(void *request, size_t *plen, char **perror) {
+    static const char json[] = "\"[{\\\"id\\\": 1, \\\"name\\\": \\\"test\\\"}]\"";
+    char *res = strdup(json);
+    *plen = sizeof(json) - 1;
+    return res;
+}
 
-    /* Use simple XOR-based hash for determinism (in real impl, use SHA-256) */
-    memset(key, 0, 32);
-    for (int i = 0; i < sizeof(data); i++) {
-        key[i % 32] ^= data[i];
+static const struct {
+    const char *promise_hash;
+    JSAsyncHandler handler;
+} builtin_async_handlers[] = {
+    { "mock_http_get", { NULL, mock_http_get_perform, NULL } },
+    { "mock_db_query", { NULL, mock_db_query_perform, NULL } },
+};
+
+static const JSAsyncHandler *find_async_handler(JSEffectRegistry *registry, const char *promise_hash) {
+    for (int i = 0; i < registry->async_count; i++) {
+        if (strcmp(registry->async_handlers[i].promise_hash, promise_hash) == 0)
+            return &registry->async_handlers[i].handler;
     }
+    for (size_t i = 0; i < sizeof(builtin_async_handlers) / sizeof(builtin_async_handlers[0]); i++) {
+        if (strcmp(builtin_async_handlers[i].promise_hash, promise_hash) == 0)
+            return &builtin_async_handlers[i].handler;
+    }
+    return NULL;
 }
 
-/* Check I/O cache for deterministic replay */
-static JSValue check_io_cache(JSEffectRegistry *registry, const char *promise_hash, int cont_id) {
-    if (!registry->has_seed) return JS_UNDEFINED;
+/* Register the I/O of a promise hash */
+JS_BOOL JS_RegisterAsyncHandler(JSContext *ctx, const char *promise_hash, const JSAsyncHandler *handler) {
+    JSEffectRegistry *registry = get_effect_registry(ctx);
+    JSAsyncHandlerEntry *e;
 
-    uint8_t cache_key[32];
-    generate_cache_key(registry->execution_seed, cont_id, cache_key);
-
-    /* Simple linear search (in real impl, use hash table) */
-    for (int i = 0; i < registry->cache_count; i++) {
-        JSIoCacheEntry *entry = &registry->io_cache[i];
-        if (entry->cont_id == cont_id &&
-            memcmp(entry->seed, registry->execution_seed, 32) == 0 &&
-            strcmp(entry->promise_hash, promise_hash) == 0) {
-            return entry->result; /* Return cached result */
-        }
+    if (!registry || !handler->perform || registry->async_count >= MAX_ASYNC_HANDLERS) {
+        return 0;
+    }
+    for (int i = 0; i < registry->async_count; i++) {
+        if (strcmp(registry->async_handlers[i].promise_hash, promise_hash) == 0)
+            return 0; /* Already registered */
     }
+    e = &registry->async_handlers[registry->async_count];
+    e->promise_hash = strdup(promise_hash);
+    if (!e->promise_hash) return 0;
+    e->handler = *handler;
+    registry->async_count++;
+    return 1;
+}
+
+/* One await of a batch */
+typedef struct {
+    const JSAsyncHandler *handler;
+    void *request;
+    int cont_id;
+    uint8_t cache_key[32];
+    bool pending;       /* I/O to perform (not replayed from the cache) */
+    char *result;       /* JSON of the result */
+    size_t result_len;
+    char *error;
+} JSAsyncJob;
 
-    return JS_UNDEFINED;
+typedef struct {
+    JSAsyncJob *jobs;
+    int *pending;       /* indexes of the jobs to perform */
+    int pending_count;
+    int next;           /* next entry of 'pending', taken atomically */
+} JSAsyncBatch;
+
+static void async_perform(JSAsyncJob *job) {
+    job->result = job->handler->perform(job->request, &job->result_len, &job->error);
+    if (!job->result && !job->error) job->error = strdup("async effect failed");
 }
 
-/* Store result in I/O cache */
-static void store_io_cache(JSEffectRegistry *registry, const char *promise_hash,
-                          int cont_id, JSValue result) {
-    if (!registry->has_seed || registry->cache_count >= 1024) return;
+/* Worker loop, also run by the awaiting thread */
+static void *async_worker(void *opaque) {
+    JSAsyncBatch *batch = opaque;
+    int i;
 
-    JSIoCacheEntry *entry = &registry->io_cache[registry->cache_count++];
-    entry->promise_hash = strdup(promise_hash);
-    entry->cont_id = cont_id;
-    memcpy(entry->seed, registry->execution_seed, 32);
-    entry->result = result;
-    entry->has_result = 1;
+    while ((i = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED)) < batch->pending_count) {
+        async_perform(&batch->jobs[batch->pending[i]]);
+    }
+    return NULL;
 }
 
-/* Async await implementation with runtime enforcement and I/O caching */
-JSValue JS_AsyncAwait(JSContext *ctx, const char *promise_hash, int cont_id, JSValue effect_args) {
+/* Run the pending jobs concurrently and wait for all of them */
+static void async_run_batch(JSAsyncBatch *batch) {
+    pthread_t threads[JS_ASYNC_MAX_WORKERS];
+    int n, nthreads = 0;
+
+    if (batch->pending_count == 0) return;
+    n = batch->pending_count < JS_ASYNC_MAX_WORKERS ? batch->pending_count : JS_ASYNC_MAX_WORKERS;
+    /* The awaiting thread is one of the workers */
+    while (nthreads < n - 1 &&
+           pthread_create(&threads[nthreads], NULL, async_worker, batch) == 0) {
+        nthreads++;
+    }
+    async_worker(batch);
+    for (int i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+static void async_free_jobs(JSAsyncJob *jobs, int count) {
+    for (int i = 0; i < count; i++) {
+        if (jobs[i].request && jobs[i].handler->free_request)
+            jobs[i].handler->free_request(jobs[i].request);
+        free(jobs[i].result);
+        free(jobs[i].error);
+    }
+    free(jobs);
+}
+
+/* Await independent effects with runtime enforcement and I/O caching.
+   Cache misses are performed concurrently; the results are then cached
+   and materialized in cont_id order, so that the replay cache and the
+   reported error do not depend on which I/O finished first. */
+JSValue JS_AsyncAwaitAll(JSContext *ctx, const JSAsyncAwaitRequest *requests, int count) {
     JSEffectRegistry *registry = JS_GetContextOpaque(ctx);
+    MTPScriptIOCache *cache = NULL;
+    JSAsyncBatch batch;
+    JSAsyncJob *jobs;
+    JSGCRef *args_refs;
+    JSGCRef arr_ref;
+    JSValue *parr, val, ret;
+    int *order, first_error = -1;
 
     /* Runtime enforcement: check if Async effect is declared */
-    if (!JS_IsEffectDeclared(ctx, "Async")) {
+    if (!registry || !(registry->declared_mask & ((uint64_t)1 << JS_EFFECT_ID_ASYNC))) {
         return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR,
                            "Undeclared Async effect usage blocked by runtime enforcement");
     }
+    if (count <= 0) return JS_NewArray(ctx, 0);
+
+    jobs = calloc(count, sizeof(JSAsyncJob));
+    order = malloc(sizeof(int) * count * 2);
+    args_refs = malloc(sizeof(JSGCRef) * count);
+    if (!jobs || !order || !args_refs) {
+        free(jobs);
+        free(order);
+        free(args_refs);
+        return JS_ThrowOutOfMemory(ctx);
+    }
 
-    /* Check I/O cache for deterministic replay */
-    if (registry) {
-        JSValue cached = check_io_cache(registry, promise_hash, cont_id);
-        if (!JS_IsUndefined(cached)) {
-            return cached; /* Return cached result for replay determinism */
+    /* cont_id order (stable insertion sort, batches are small) */
+    for (int i = 0; i < count; i++) {
+        int j = i;
+        while (j > 0 && requests[order[j - 1]].cont_id > requests[i].cont_id) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+        if (j > 0 && requests[order[j - 1]].cont_id == requests[i].cont_id) {
+            free(jobs);
+            free(order);
+            free(args_refs);
+            return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, "Duplicate continuation id: %d", requests[i].cont_id);
+        }
+    }
+
+    /* The handlers may allocate: keep the arguments alive */
+    for (int i = 0; i < count; i++) {
+        *JS_PushGCRef(ctx, &args_refs[i]) = requests[i].args;
+    }
+    parr = JS_PushGCRef(ctx, &arr_ref);
+
+    if (registry->has_seed) cache = mtpscript_io_cache_default();
+
+    /* Replay from the cache or prepare the I/O on the VM thread */
+    batch.jobs = jobs;
+    batch.pending = order + count;
+    batch.pending_count = 0;
+    batch.next = 0;
+    for (int k = 0; k < count; k++) {
+        int i = order[k];
+        JSAsyncJob *job = &jobs[i];
+        job->cont_id = requests[i].cont_id;
+        if (cache &&
+            generate_cache_key(registry->execution_seed, requests[i].promise_hash, job->cont_id, job->cache_key) &&
+            mtpscript_io_cache_get_bytes(cache, job->cache_key, (uint8_t **)&job->result, &job->result_len)) {
+            continue; /* Cached result for replay determinism */
+        }
+        job->handler = find_async_handler(registry, requests[i].promise_hash);
+        if (!job->handler) {
+            ret = JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, "Unknown async effect: %s", requests[i].promise_hash);
+            goto done;
         }
+        if (job->handler->prepare) {
+            job->request = job->handler->prepare(ctx, args_refs[i].val);
+            if (!job->request) {
+                ret = JS_EXCEPTION;
+                goto done;
+            }
+        }
+        job->pending = true;
+        batch.pending[batch.pending_count++] = i;
     }
 
-    /* Execute I/O synchronously (block until completion) */
-    JSValue result;
+    /* Perform the I/O concurrently (block until completion) */
+    async_run_batch(&batch);
 
-    /* Check if this is a known promise hash */
-    if (strcmp(promise_hash, "mock_http_get") == 0) {
-        /* Mock HTTP GET result - in real impl, this would make actual HTTP call */
-        result = JS_NewString(ctx, "{\"status\": 200, \"body\": \"Hello World\"}");
-    } else if (strcmp(promise_hash, "mock_db_query") == 0) {
-        /* Mock database query result - in real impl, this would make actual DB call */
-        result = JS_NewString(ctx, "[{\"id\": 1, \"name\": \"test\"}]");
-    } else {
-        /* Unknown promise hash */
-        return JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, "Unknown async effect: %s", promise_hash);
+    /* Cache and resume in cont_id order */
+    *parr = JS_NewArray(ctx, count);
+    if (JS_IsException(*parr)) {
+        ret = *parr;
+        goto done;
+    }
+    for (int k = 0; k < count; k++) {
+        int i = order[k];
+        JSAsyncJob *job = &jobs[i];
+        if (!job->result) {
+            if (first_error < 0) first_error = i;
+            continue;
+        }
+        /* Cache result for deterministic replay */
+        if (cache && job->pending)
+            mtpscript_io_cache_put_bytes(cache, job->cache_key, (uint8_t *)job->result, job->result_len);
+        if (first_error >= 0) continue;
+        val = JS_Parse(ctx, job->result, job->result_len, "<async>", JS_EVAL_JSON);
+        if (JS_IsException(val)) {
+            ret = val;
+            goto done;
+        }
+        JS_SetPropertyUint32(ctx, *parr, i, val);
+    }
+    if (first_error >= 0) {
+        ret = JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "Async effect %s failed: %s",
+                            requests[first_error].promise_hash, jobs[first_error].error);
+        goto done;
     }
+    ret = *parr;
 
-    /* Cache result for deterministic replay */
-    if (registry) {
-        store_io_cache(registry, promise_hash, cont_id, result);
+done:
+    JS_PopGCRef(ctx, &arr_ref);
+    for (int i = count - 1; i >= 0; i--) {
+        JS_PopGCRef(ctx, &args_refs[i]);
+    }
+    async_free_jobs(jobs, count);
+    free(order);
+    free(args_refs);
+    return ret;
+}
+
+/* Await a single effect */
+JSValue JS_AsyncAwait(JSContext *ctx, const char *promise_hash, int cont_id, JSValue effect_args) {
+    JSAsyncAwaitRequest req = { promise_hash, cont_id, effect_args };
+    JSValue arr = JS_AsyncAwaitAll(ctx, &req, 1);
+
+    if (JS_IsException(arr)) return arr;
+    return JS_GetPropertyUint32(ctx, arr, 0);
+}
+
+/* Return a malloc'ed copy of the string conversion of 'val', NULL with a
+   pending exception on error */
+static char *async_strdup(JSContext *ctx, JSValue val) {
+    JSCStringBuf buf;
+    const char *str = JS_ToCString(ctx, val, &buf);
+    char *copy;
+
+    if (!str) return NULL;
+    copy = strdup(str);
+    if (!copy) JS_ThrowOutOfMemory(ctx);
+    return copy;
+}
+
+/* Async.await(promiseHash, contId, effectArgs) */
+JSValue js_async_await(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    char *promise_hash;
+    int cont_id;
+    JSValue ret;
+
+    if (JS_ToInt32(ctx, &cont_id, argv[1])) return JS_EXCEPTION;
+    promise_hash = async_strdup(ctx, argv[0]);
+    if (!promise_hash) return JS_EXCEPTION;
+    ret = JS_AsyncAwait(ctx, promise_hash, cont_id, argv[2]);
+    free(promise_hash);
+    return ret;
+}
+
+/* Async.awaitAll([[promiseHash, contId, effectArgs], ...]): the awaits of
+   one continuation frontier, performed as one JS_AsyncAwaitAll() batch.
+   Return the array of the results. */
+JSValue js_async_await_all(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    JSAsyncAwaitRequest *requests;
+    char **hashes;
+    JSValue entry, ret = JS_EXCEPTION;
+    int count, i;
+
+    if (JS_ToInt32(ctx, &count, JS_GetPropertyStr(ctx, argv[0], "length"))) return JS_EXCEPTION;
+    if (count <= 0) return JS_NewArray(ctx, 0);
+    requests = calloc(count, sizeof(JSAsyncAwaitRequest));
+    hashes = calloc(count, sizeof(char *));
+    if (!requests || !hashes) {
+        ret = JS_ThrowOutOfMemory(ctx);
+        goto done;
+    }
+
+    /* The conversions may allocate: the entries are read again below */
+    for (i = 0; i < count; i++) {
+        entry = JS_GetPropertyUint32(ctx, argv[0], i);
+        if (JS_ToInt32(ctx, &requests[i].cont_id, JS_GetPropertyUint32(ctx, entry, 1)))
+            goto done;
+        entry = JS_GetPropertyUint32(ctx, argv[0], i);
+        hashes[i] = async_strdup(ctx, JS_GetPropertyUint32(ctx, entry, 0));
+        if (!hashes[i]) goto done;
+        requests[i].promise_hash = hashes[i];
+    }
+    /* JS_AsyncAwaitAll() keeps the arguments alive from there */
+    for (i = 0; i < count; i++) {
+        entry = JS_GetPropertyUint32(ctx, argv[0], i);
+        requests[i].args = JS_GetPropertyUint32(ctx, entry, 2);
+    }
+    ret = JS_AsyncAwaitAll(ctx, requests, count);
+
+done:
+    if (hashes) {
+        for (i = 0; i < count; i++) free(hashes[i]);
+    }
+    free(hashes);
+    free(requests);
+    return ret;
+}
+
+/* JSON text builder for the perform() of the handlers */
+void JS_AsyncJSONInit(JSAsyncJSON *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+static void async_json_put(JSAsyncJSON *s, const char *str, size_t len) {
+    char *buf;
+    size_t size;
+
+    if (s->error) return;
+    if (s->len + len + 1 > s->size) {
+        size = (s->len + len + 1) * 3 / 2 + 64;
+        buf = realloc(s->buf, size);
+        if (!buf) {
+            s->error = 1;
+            return;
+        }
+        s->buf = buf;
+        s->size = size;
+    }
+    memcpy(s->buf + s->len, str, len);
+    s->len += len;
+    s->buf[s->len] = '\0';
+}
+
+void JS_AsyncJSONPutRaw(JSAsyncJSON *s, const char *str) {
+    async_json_put(s, str, strlen(str));
+}
+
+void JS_AsyncJSONPutString(JSAsyncJSON *s, const char *str, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    char esc[6];
+    size_t i, start = 0;
+
+    async_json_put(s, "\"", 1);
+    for (i = 0; i < len; i++) {
+        uint8_t c = str[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        async_json_put(s, str + start, i - start);
+        start = i + 1;
+        if (c == '"' || c == '\\') {
+            esc[0] = '\\';
+            esc[1] = c;
+            async_json_put(s, esc, 2);
+        } else {
+            memcpy(esc, "\\u00", 4);
+            esc[4] = hex[c >> 4];
+            esc[5] = hex[c & 15];
+            async_json_put(s, esc, 6);
+        }
     }
+    async_json_put(s, str + start, len - start);
+    async_json_put(s, "\"", 1);
+}
 
-    return result;
+char *JS_AsyncJSONFinish(JSAsyncJSON *s, size_t *plen) {
+    if (s->error || !s->buf) {
+        free(s->buf);
+        return NULL;
+    }
+    *plen = s->len;
+    return s->buf;
 }
 
 /* Clean up effect registry */
 void cleanup_effects(JSContext *ctx) {
     JSEffectRegistry *registry = JS_GetContextOpaque(ctx);
     if (registry) {
-        /* Free registered effects */
+        /* Free interned effect names */
         for (int i = 0; i < registry->count; i++) {
             free(registry->effects[i].name);
         }
-        /* Free declared effects */
-        for (int i = 0; i < registry->declared_effects.count; i++) {
-            free(registry->declared_effects.effects[i]);
-        }
-        /* Free I/O cache */
-        for (int i = 0; i < registry->cache_count; i++) {
-            free(registry->io_cache[i].promise_hash);
-            // JS_FreeValue(ctx, registry->io_cache[i].result); // No-op for now
+        for (int i = 0; i < registry->async_count; i++) {
+            free(registry->async_handlers[i].promise_hash);
         }
         free(registry);
         JS_SetContextOpaque(ctx, NULL);
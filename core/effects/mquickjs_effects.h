@@ -15,30 +15,84 @@ typedef enum {
     EFFECT_CUSTOM,
 } JSEffectType;
 
-/* Runtime effect enforcement */
+/* Runtime effect enforcement. Effect names are interned to small
+   integer IDs so that the declared set is a bitmask. */
 #define MAX_DECLARED_EFFECTS 64
 
-typedef struct {
-    char *effects[MAX_DECLARED_EFFECTS];
-    int count;
-} JSDeclaredEffects;
+/* ID of the built-in "Async" effect (always interned) */
+#define JS_EFFECT_ID_ASYNC 0
 
 /* Register an effect handler */
 JS_BOOL JS_RegisterEffect(JSContext *ctx, const char *name, JSEffectHandler handler);
 
+/* Return the interned ID of an effect name or -1 if it is not known */
+int JS_GetEffectId(JSContext *ctx, const char *name);
+
 /* Call an effect (internal use) */
 JSValue JS_CallEffect(JSContext *ctx, const char *name, const uint8_t *seed, size_t seed_len,
                       JSValue args);
 
+/* Call an effect by its interned ID: one bit test and the handler call */
+JSValue JS_CallEffectById(JSContext *ctx, int effect_id, const uint8_t *seed, size_t seed_len,
+                          JSValue args);
+
 /* Runtime enforcement: set declared effects for this context */
 JS_BOOL JS_SetDeclaredEffects(JSContext *ctx, const char **effects, int count);
 
 /* Runtime enforcement: check if effect is declared */
 JS_BOOL JS_IsEffectDeclared(JSContext *ctx, const char *effect_name);
 
-/* Async effect support */
+/* Async effect support. The I/O behind a promise hash is split so that
+   the blocking part runs off the VM thread:
+   - prepare (VM thread, optional) captures what the I/O needs from the
+     arguments. It returns NULL with a pending exception on error.
+   - perform (worker thread) must not touch the JSContext. It returns the
+     malloc'ed JSON text of the result, or NULL and optionally a
+     malloc'ed message in *perror.
+   - free_request (optional) releases what prepare returned. */
+typedef struct {
+    void *(*prepare)(JSContext *ctx, JSValue args);
+    char *(*perform)(void *request, size_t *plen, char **perror);
+    void (*free_request)(void *request);
+} JSAsyncHandler;
+
+/* Maximum number of effects performed at the same time by one await */
+#define JS_ASYNC_MAX_WORKERS 16
+
+typedef struct {
+    const char *promise_hash;
+    int cont_id;
+    JSValue args;
+} JSAsyncAwaitRequest;
+
+/* Register the I/O behind a promise hash */
+JS_BOOL JS_RegisterAsyncHandler(JSContext *ctx, const char *promise_hash, const JSAsyncHandler *handler);
+
+/* Await independent effects (same continuation frontier) concurrently.
+   Return an array of the results in request order. Results are cached
+   and resumed in cont_id order, so replay does not depend on timing.
+   The compiler groups consecutive independent awaits into one
+   Async.awaitAll() call, which ends up here. */
+JSValue JS_AsyncAwaitAll(JSContext *ctx, const JSAsyncAwaitRequest *requests, int count);
+
+/* Await a single effect */
 JSValue JS_AsyncAwait(JSContext *ctx, const char *promise_hash, int cont_id, JSValue effect_args);
 
+/* JSON text of a result, built by perform() without the JSContext */
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t size;
+    JS_BOOL error;      /* out of memory */
+} JSAsyncJSON;
+
+void JS_AsyncJSONInit(JSAsyncJSON *s);
+void JS_AsyncJSONPutRaw(JSAsyncJSON *s, const char *str);
+/* Quoted and escaped string */
+void JS_AsyncJSONPutString(JSAsyncJSON *s, const char *str, size_t len);
+/* Return the malloc'ed text, or NULL if out of memory */
+char *JS_AsyncJSONFinish(JSAsyncJSON *s, size_t *plen);
+
 /* Deterministic I/O caching */
 JS_BOOL JS_SetExecutionSeed(JSContext *ctx, const uint8_t *seed, size_t seed_len);
 
@@ -0,0 +1,285 @@
+/*
+ * MTPScript Deterministic I/O Replay Cache Implementation
+ * Specification §7 - Deterministic I/O caching
+ */
+
+#include "mquickjs_iocache.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t key[MTPSCRIPT_IO_CACHE_KEY_SIZE];
+    uint8_t *data;           // NUL terminated copy of the value
+    size_t len;
+    uint32_t slot;           // Position in the hash table
+    int prev, next;          // LRU list (or free list through 'next')
+} MTPScriptIOCacheEntry;
+
+struct MTPScriptIOCache {
+    pthread_mutex_t lock;
+    int max_entries;
+    size_t max_bytes;
+    uint32_t *slots;         // Open addressing: entry index + 1, 0 = empty
+    uint32_t slot_mask;
+    MTPScriptIOCacheEntry *entries;
+    int free_list;
+    int lru_head;            // Most recently used
+    int lru_tail;            // Least recently used, evicted first
+    MTPScriptIOCacheStats stats;
+};
+
+static pthread_once_t default_cache_once = PTHREAD_ONCE_INIT;
+static MTPScriptIOCache *default_cache;
+
+// The key is a SHA-256 digest: any 32 bits of it are a good hash
+static uint32_t io_cache_hash(const uint8_t *key) {
+    uint32_t h;
+    memcpy(&h, key, sizeof(h));
+    return h;
+}
+
+// Return the slot holding 'key' or the empty slot ending its probe sequence
+static uint32_t io_cache_find(MTPScriptIOCache *cache, const uint8_t *key) {
+    uint32_t i = io_cache_hash(key) & cache->slot_mask;
+
+    while (cache->slots[i] != 0) {
+        if (memcmp(cache->entries[cache->slots[i] - 1].key, key, MTPSCRIPT_IO_CACHE_KEY_SIZE) == 0) break;
+        i = (i + 1) & cache->slot_mask;
+    }
+    return i;
+}
+
+// Empty slot 'i' and shift back the entries which probed past it
+static void io_cache_remove_slot(MTPScriptIOCache *cache, uint32_t i) {
+    uint32_t j = i, k;
+
+    cache->slots[i] = 0;
+    for (;;) {
+        j = (j + 1) & cache->slot_mask;
+        if (cache->slots[j] == 0) break;
+        k = io_cache_hash(cache->entries[cache->slots[j] - 1].key) & cache->slot_mask;
+        // Keep the entry if its home slot is cyclically in (i, j]
+        if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;
+        cache->slots[i] = cache->slots[j];
+        cache->entries[cache->slots[i] - 1].slot = i;
+        cache->slots[j] = 0;
+        i = j;
+    }
+}
+
+static void io_cache_lru_unlink(MTPScriptIOCache *cache, int idx) {
+    MTPScriptIOCacheEntry *e = &cache->entries[idx];
+
+    if (e->prev >= 0) cache->entries[e->prev].next = e->next;
+    else cache->lru_head = e->next;
+    if (e->next >= 0) cache->entries[e->next].prev = e->prev;
+    else cache->lru_tail = e->prev;
+}
+
+static void io_cache_lru_push(MTPScriptIOCache *cache, int idx) {
+    MTPScriptIOCacheEntry *e = &cache->entries[idx];
+
+    e->prev = -1;
+    e->next = cache->lru_head;
+    if (cache->lru_head >= 0) cache->entries[cache->lru_head].prev = idx;
+    else cache->lru_tail = idx;
+    cache->lru_head = idx;
+}
+
+static void io_cache_drop(MTPScriptIOCache *cache, int idx) {
+    MTPScriptIOCacheEntry *e = &cache->entries[idx];
+
+    io_cache_remove_slot(cache, e->slot);
+    io_cache_lru_unlink(cache, idx);
+    cache->stats.bytes -= e->len;
+    cache->stats.entries--;
+    free(e->data);
+    e->data = NULL;
+    e->next = cache->free_list;
+    cache->free_list = idx;
+}
+
+// Create a cache holding at most 'max_entries' values and 'max_bytes' bytes
+MTPScriptIOCache *mtpscript_io_cache_new(int max_entries, size_t max_bytes) {
+    MTPScriptIOCache *cache = calloc(1, sizeof(MTPScriptIOCache));
+    uint32_t slot_count = 1;
+
+    if (!cache) return NULL;
+    if (max_entries <= 0) max_entries = MTPSCRIPT_IO_CACHE_DEFAULT_ENTRIES;
+    if (max_bytes == 0) max_bytes = MTPSCRIPT_IO_CACHE_DEFAULT_MAX_BYTES;
+    cache->max_entries = max_entries;
+    cache->max_bytes = max_bytes;
+
+    // Load factor <= 1/2
+    while (slot_count < 2 * (uint32_t)max_entries) slot_count <<= 1;
+    cache->slot_mask = slot_count - 1;
+    cache->slots = calloc(slot_count, sizeof(uint32_t));
+    cache->entries = calloc(max_entries, sizeof(MTPScriptIOCacheEntry));
+    if (!cache->slots || !cache->entries) {
+        free(cache->slots);
+        free(cache->entries);
+        free(cache);
+        return NULL;
+    }
+
+    for (int i = 0; i < max_entries; i++) {
+        cache->entries[i].next = i + 1 < max_entries ? i + 1 : -1;
+    }
+    cache->free_list = 0;
+    cache->lru_head = -1;
+    cache->lru_tail = -1;
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+void mtpscript_io_cache_free(MTPScriptIOCache *cache) {
+    if (!cache) return;
+
+    for (int i = 0; i < cache->max_entries; i++) {
+        free(cache->entries[i].data);
+    }
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->slots);
+    free(cache->entries);
+    free(cache);
+}
+
+static void default_cache_init(void) {
+    default_cache = mtpscript_io_cache_new(0, 0);
+}
+
+// The process-wide cache used by the standard effects
+MTPScriptIOCache *mtpscript_io_cache_default(void) {
+    pthread_once(&default_cache_once, default_cache_init);
+    return default_cache;
+}
+
+bool mtpscript_io_cache_get_bytes(MTPScriptIOCache *cache, const uint8_t *key,
+                                  uint8_t **pdata, size_t *plen) {
+    uint8_t *data = NULL;
+    uint32_t i;
+    int idx;
+
+    if (!cache) return false;
+
+    pthread_mutex_lock(&cache->lock);
+    i = io_cache_find(cache, key);
+    if (cache->slots[i] == 0) {
+        cache->stats.misses++;
+        pthread_mutex_unlock(&cache->lock);
+        return false;
+    }
+    idx = cache->slots[i] - 1;
+    MTPScriptIOCacheEntry *e = &cache->entries[idx];
+    data = malloc(e->len + 1);
+    if (data) {
+        memcpy(data, e->data, e->len + 1);
+        *plen = e->len;
+        io_cache_lru_unlink(cache, idx);
+        io_cache_lru_push(cache, idx);
+        cache->stats.hits++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    *pdata = data;
+    return data != NULL;
+}
+
+bool mtpscript_io_cache_put_bytes(MTPScriptIOCache *cache, const uint8_t *key,
+                                  const uint8_t *data, size_t len) {
+    uint8_t *copy;
+    uint32_t i;
+    int idx;
+
+    if (!cache) return false;
+
+    copy = malloc(len + 1);
+    if (!copy) return false;
+    memcpy(copy, data, len);
+    copy[len] = '\0';
+
+    pthread_mutex_lock(&cache->lock);
+    if (len > cache->max_bytes) {
+        cache->stats.rejected++;
+        pthread_mutex_unlock(&cache->lock);
+        free(copy);
+        return false;
+    }
+
+    // Replay results are deterministic: an existing entry is replaced
+    i = io_cache_find(cache, key);
+    if (cache->slots[i] != 0) {
+        io_cache_drop(cache, cache->slots[i] - 1);
+    }
+
+    while (cache->free_list < 0 || cache->stats.bytes + len > cache->max_bytes) {
+        io_cache_drop(cache, cache->lru_tail);
+        cache->stats.evictions++;
+    }
+
+    idx = cache->free_list;
+    MTPScriptIOCacheEntry *e = &cache->entries[idx];
+    cache->free_list = e->next;
+    memcpy(e->key, key, MTPSCRIPT_IO_CACHE_KEY_SIZE);
+    e->data = copy;
+    e->len = len;
+    // Removals shifted the table: probe again
+    e->slot = io_cache_find(cache, key);
+    cache->slots[e->slot] = idx + 1;
+    io_cache_lru_push(cache, idx);
+    cache->stats.entries++;
+    cache->stats.bytes += len;
+    cache->stats.insertions++;
+    pthread_mutex_unlock(&cache->lock);
+    return true;
+}
+
+JSValue mtpscript_io_cache_get(MTPScriptIOCache *cache, JSContext *ctx, const uint8_t *key) {
+    uint8_t *data;
+    size_t len;
+    JSValue val;
+
+    if (!mtpscript_io_cache_get_bytes(cache, key, &data, &len)) return JS_UNDEFINED;
+
+    val = JS_Parse(ctx, (const char *)data, len, "<io cache>", JS_EVAL_JSON);
+    free(data);
+    return val;
+}
+
+// Store the JSON of 'val'. Values which cannot be serialized are not
+// cached. 'val' is not kept alive: callers reusing it must protect it.
+bool mtpscript_io_cache_put(MTPScriptIOCache *cache, JSContext *ctx, const uint8_t *key, JSValue val) {
+    JSCStringBuf buf;
+    const char *str;
+    JSValue json;
+    size_t len;
+
+    if (!cache) return false;
+
+    json = JS_JSONStringify(ctx, val);
+    if (JS_IsException(json)) {
+        JS_GetException(ctx);
+        return false;
+    }
+    if (!JS_IsString(ctx, json)) return false;
+    str = JS_ToCStringLen(ctx, &len, json, &buf);
+    if (!str) return false;
+    return mtpscript_io_cache_put_bytes(cache, key, (const uint8_t *)str, len);
+}
+
+void mtpscript_io_cache_clear(MTPScriptIOCache *cache) {
+    if (!cache) return;
+
+    pthread_mutex_lock(&cache->lock);
+    while (cache->lru_tail >= 0) {
+        io_cache_drop(cache, cache->lru_tail);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void mtpscript_io_cache_get_stats(MTPScriptIOCache *cache, MTPScriptIOCacheStats *stats) {
+    pthread_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    pthread_mutex_unlock(&cache->lock);
+}
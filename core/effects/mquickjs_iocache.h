@@ -0,0 +1,60 @@
+/*
+ * MTPScript Deterministic I/O Replay Cache
+ * Specification §7 - Deterministic I/O caching
+ *
+ * One process-wide table shared by DbRead, DbWrite, HttpOut and the
+ * async effects. Entries are keyed by the 32-byte SHA-256 of (seed,
+ * request) and hold the JSON of the result, so a hit rebuilds the value
+ * in the calling context. Memory is bounded by an entry count and a byte
+ * budget; the least recently used entries are evicted first.
+ */
+
+#ifndef MQUICKJS_IOCACHE_H
+#define MQUICKJS_IOCACHE_H
+
+#include "mquickjs.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MTPSCRIPT_IO_CACHE_KEY_SIZE          32
+#define MTPSCRIPT_IO_CACHE_DEFAULT_ENTRIES   4096
+#define MTPSCRIPT_IO_CACHE_DEFAULT_MAX_BYTES (64 * 1024 * 1024)
+
+// Cache metrics
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;          // Entries dropped to make room
+    uint64_t rejected;           // Values larger than the byte budget
+    int entries;                 // Entries right now
+    size_t bytes;                // Cached bytes right now
+} MTPScriptIOCacheStats;
+
+typedef struct MTPScriptIOCache MTPScriptIOCache;
+
+// Create a cache holding at most 'max_entries' values and 'max_bytes'
+// bytes of values (0 = default). Thread safe.
+MTPScriptIOCache *mtpscript_io_cache_new(int max_entries, size_t max_bytes);
+void mtpscript_io_cache_free(MTPScriptIOCache *cache);
+
+// The process-wide cache used by the standard effects
+MTPScriptIOCache *mtpscript_io_cache_default(void);
+
+// Raw values: get copies the value into a malloc'ed buffer which the
+// caller frees. Return false on a miss.
+bool mtpscript_io_cache_get_bytes(MTPScriptIOCache *cache, const uint8_t *key,
+                                  uint8_t **pdata, size_t *plen);
+bool mtpscript_io_cache_put_bytes(MTPScriptIOCache *cache, const uint8_t *key,
+                                  const uint8_t *data, size_t len);
+
+// JS values: put stores the JSON of 'val', get rebuilds it in 'ctx'.
+// get returns JS_UNDEFINED on a miss.
+JSValue mtpscript_io_cache_get(MTPScriptIOCache *cache, JSContext *ctx, const uint8_t *key);
+bool mtpscript_io_cache_put(MTPScriptIOCache *cache, JSContext *ctx, const uint8_t *key, JSValue val);
+
+void mtpscript_io_cache_clear(MTPScriptIOCache *cache);
+void mtpscript_io_cache_get_stats(MTPScriptIOCache *cache, MTPScriptIOCacheStats *stats);
+
+#endif /* MQUICKJS_IOCACHE_H */
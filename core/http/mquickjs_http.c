@@ -5,6 +5,7 @@
 
 #include "mquickjs_http.h"
 #include "mquickjs_crypto.h"
+#include "mquickjs_effects.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -13,8 +14,6 @@
 #include <curl/curl.h>
 #include <openssl/sha.h>
 
-// Thread-local storage for HTTP cache
-__thread MTPScriptHTTPCache *g_http_cache = NULL;
 
 // cURL write callback for response body with size limits
 static size_t http_write_callback(void *contents, size_t size, size_t nmemb, void *userp) {
@@ -190,59 +189,6 @@ void mtpscript_http_response_free(MTPScriptHTTPResponse *resp) {
     free(resp);
 }
 
-// HTTP cache management
-MTPScriptHTTPCache *mtpscript_http_cache_new(void) {
-    if (g_http_cache) return g_http_cache;
-
-    g_http_cache = calloc(1, sizeof(MTPScriptHTTPCache));
-    return g_http_cache;
-}
-
-void mtpscript_http_cache_free(MTPScriptHTTPCache *cache) {
-    if (!cache) return;
-
-    // Note: JSValue objects should be freed by the JS runtime
-    free(cache);
-
-    if (cache == g_http_cache) {
-        g_http_cache = NULL;
-    }
-}
-
-JSValue mtpscript_http_cache_get(MTPScriptHTTPCache *cache, const uint8_t *request_hash) {
-    if (!cache || !cache->has_seed) return JS_UNDEFINED;
-
-    for (int i = 0; i < cache->count; i++) {
-        if (memcmp(cache->entries[i].request_hash, request_hash, 32) == 0) {
-            return cache->entries[i].response;
-        }
-    }
-    return JS_UNDEFINED;
-}
-
-void mtpscript_http_cache_put(MTPScriptHTTPCache *cache, const uint8_t *request_hash, JSValue response) {
-    if (!cache || !cache->has_seed || cache->count >= 1024) return;
-
-    // Simple eviction: replace oldest entry if full
-    int index = cache->count < 1024 ? cache->count : 0;
-    if (cache->count >= 1024) {
-        // Note: Old JSValue would need to be freed, but we don't have context here
-    } else {
-        cache->count++;
-    }
-
-    memcpy(cache->entries[index].request_hash, request_hash, 32);
-    cache->entries[index].response = response;
-    cache->entries[index].has_response = true;
-}
-
-void mtpscript_http_cache_set_seed(MTPScriptHTTPCache *cache, const uint8_t *seed, size_t seed_len) {
-    if (!cache || seed_len != 32) return;
-
-    memcpy(cache->execution_seed, seed, 32);
-    cache->has_seed = true;
-}
-
 // Generate request hash for caching
 void mtpscript_http_generate_request_hash(const uint8_t *seed, size_t seed_len,
                                          const MTPScriptHTTPRequest *req,
@@ -316,14 +262,8 @@ static char *mtpscript_http_serialize_request(const MTPScriptHTTPRequest *req) {
 
 // HTTP effect handler
 JSValue mtpscript_http_out(JSContext *ctx, const uint8_t *seed, size_t seed_len, JSValue args) {
-    MTPScriptHTTPCache *cache = mtpscript_http_cache_new();
-
-    if (!cache) {
-        return JS_ThrowError(ctx, JS_CLASS_INTERNAL_ERROR, "HTTP system not initialized");
-    }
-
-    // Set execution seed for caching
-    mtpscript_http_cache_set_seed(cache, seed, seed_len);
+    // Responses are only replayed within a seeded execution
+    MTPScriptHTTPCache *cache = seed_len > 0 ? mtpscript_io_cache_default() : NULL;
 
     // Simple implementation: GET request to httpbin.org with TLS validation and size limits
     MTPScriptHTTPRequest *req = mtpscript_http_request_new("GET",
@@ -339,7 +279,7 @@ JSValue mtpscript_http_out(JSContext *ctx, const uint8_t *seed, size_t seed_len,
     mtpscript_http_generate_request_hash(seed, seed_len, req, request_hash);
 
     // Check cache first
-    JSValue cached_response = mtpscript_http_cache_get(cache, request_hash);
+    JSValue cached_response = mtpscript_io_cache_get(cache, ctx, request_hash);
     if (!JS_IsUndefined(cached_response)) {
         mtpscript_http_request_free(req);
         return cached_response;
@@ -381,17 +321,56 @@ JSValue mtpscript_http_out(JSContext *ctx, const uint8_t *seed, size_t seed_len,
     }
 
     // Cache the response
-    mtpscript_http_cache_put(cache, request_hash, js_response);
+    JSGCRef js_response_ref;
+    JS_PUSH_VALUE(ctx, js_response);
+    mtpscript_io_cache_put(cache, ctx, request_hash, js_response);
+    JS_POP_VALUE(ctx, js_response);
 
     mtpscript_http_response_free(resp);
 
     return js_response;
 }
 
+// HttpOut off the VM thread (JSAsyncHandler): the response object of
+// mtpscript_http_out() as JSON text
+static char *http_out_perform(void *request, size_t *plen, char **perror) {
+    MTPScriptHTTPRequest *req = mtpscript_http_request_new("GET",
+                                                         "https://httpbin.org/get",
+                                                         "Accept: application/json\r\nUser-Agent: MTPScript/1.0",
+                                                         NULL, 10000);
+    MTPScriptHTTPResponse *resp;
+    JSAsyncJSON s;
+    char status[32];
+
+    if (!req) return NULL;
+    resp = mtpscript_http_request_execute(req);
+    mtpscript_http_request_free(req);
+    if (!resp) {
+        *perror = strdup("Failed to execute HTTP request");
+        return NULL;
+    }
+
+    JS_AsyncJSONInit(&s);
+    snprintf(status, sizeof(status), "{\"statusCode\":%ld,\"headers\":", resp->status_code);
+    JS_AsyncJSONPutRaw(&s, status);
+    JS_AsyncJSONPutString(&s, resp->headers ? resp->headers : "", resp->headers ? strlen(resp->headers) : 0);
+    JS_AsyncJSONPutRaw(&s, ",\"body\":");
+    JS_AsyncJSONPutString(&s, resp->body ? resp->body : "", resp->body ? strlen(resp->body) : 0);
+    if (resp->error) {
+        JS_AsyncJSONPutRaw(&s, ",\"error\":");
+        JS_AsyncJSONPutString(&s, resp->error, strlen(resp->error));
+    }
+    JS_AsyncJSONPutRaw(&s, "}");
+    mtpscript_http_response_free(resp);
+    return JS_AsyncJSONFinish(&s, plen);
+}
+
+static const JSAsyncHandler http_out_async_handler = { NULL, http_out_perform, NULL };
+
 // Register HTTP effects
 void mtpscript_http_register_effects(JSContext *ctx) {
-    // Initialize HTTP cache
-    mtpscript_http_cache_new();
+    // Initialize the replay cache
+    mtpscript_io_cache_default();
 
     // Initialize cURL (only once)
     static bool curl_initialized = false;
@@ -402,4 +381,7 @@ void mtpscript_http_register_effects(JSContext *ctx) {
 
     // Register HttpOut effect
     JS_RegisterEffect(ctx, "HttpOut", mtpscript_http_out);
+    // await HttpOut(...) runs on a worker thread, batched with the other
+    // awaits of its continuation frontier
+    JS_RegisterAsyncHandler(ctx, "HttpOut", &http_out_async_handler);
 }
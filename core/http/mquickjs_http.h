@@ -7,6 +7,7 @@
 #define MQUICKJS_HTTP_H
 
 #include "mquickjs.h"
+#include "mquickjs_iocache.h"
 #include <curl/curl.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -34,20 +35,9 @@ typedef struct {
     char *error;        // Error message (if any)
 } MTPScriptHTTPResponse;
 
-// HTTP cache entry
-typedef struct {
-    uint8_t request_hash[32];  // SHA-256 of (seed, request)
-    JSValue response;          // Cached JS response value
-    bool has_response;
-} MTPScriptHTTPCacheEntry;
-
-// HTTP cache
-typedef struct {
-    MTPScriptHTTPCacheEntry entries[1024];  // Simple array cache
-    int count;
-    uint8_t execution_seed[32];
-    bool has_seed;
-} MTPScriptHTTPCache;
+// HTTP cache: responses live in the shared I/O replay cache, keyed by
+// the SHA-256 request_hash of (seed, request)
+typedef MTPScriptIOCache MTPScriptHTTPCache;
 
 // HTTP request functions
 MTPScriptHTTPRequest *mtpscript_http_request_new(const char *method, const char *url,
@@ -58,13 +48,6 @@ void mtpscript_http_request_free(MTPScriptHTTPRequest *req);
 MTPScriptHTTPResponse *mtpscript_http_request_execute(MTPScriptHTTPRequest *req);
 void mtpscript_http_response_free(MTPScriptHTTPResponse *resp);
 
-// HTTP cache management
-MTPScriptHTTPCache *mtpscript_http_cache_new(void);
-void mtpscript_http_cache_free(MTPScriptHTTPCache *cache);
-JSValue mtpscript_http_cache_get(MTPScriptHTTPCache *cache, const uint8_t *request_hash);
-void mtpscript_http_cache_put(MTPScriptHTTPCache *cache, const uint8_t *request_hash, JSValue response);
-void mtpscript_http_cache_set_seed(MTPScriptHTTPCache *cache, const uint8_t *seed, size_t seed_len);
-
 // Generate request hash for caching
 void mtpscript_http_generate_request_hash(const uint8_t *seed, size_t seed_len,
                                          const MTPScriptHTTPRequest *req,
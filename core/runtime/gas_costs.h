@@ -42,8 +42,14 @@
 /* Error handling */
 #define GAS_COST_THROW_ERROR 10
 
-/* Get gas cost for an opcode - Basic Annex A implementation */
-/* Simplified implementation that provides the framework for detailed costing */
+/* Size-proportional part of the built-in functions: one unit per
+   2^GAS_COST_BYTE_SHIFT string characters and one unit per array
+   element or object property */
+#define GAS_COST_BYTE_SHIFT 4
+#define GAS_COST_ELEMENT 1
+
+/* Get gas cost for an opcode. The per-opcode costs are generated from
+   gas-v5.1.csv into mquickjs_gas.h. */
 uint32_t get_opcode_gas_cost(uint32_t opcode);
 
 #endif /* GAS_COSTS_H */
\ No newline at end of file
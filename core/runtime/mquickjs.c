@@ -31,6 +31,13 @@
 #include <math.h>
 #include <setjmp.h>
 #include <stddef.h>
+#if defined(__linux__)
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+/* copy-on-write context images (memfd_create + MAP_PRIVATE) */
+#define CONFIG_CONTEXT_IMAGE
+#endif
 
 #include "cutils.h"
 #include "dtoa.h"
@@ -38,14 +45,14 @@
 #include "gas_costs.h"
 #include "mquickjs_effects.h"
 #include "mquickjs_errors.h"
-#include "decimal.h"
+#include "decimal128.h"
 #include <openssl/sha.h>
+#include <openssl/evp.h>
 
 /* MTPScript Decimal type */
 typedef struct JSDecimal {
     JS_MB_HEADER;
-    char value[35];   /* significand as string (1-34 digits, no leading zeros) + null terminator */
-    int32_t scale;    /* decimal places (0-28) */
+    Decimal128 d;
 } JSDecimal;
 
 /*
@@ -70,6 +77,16 @@ typedef struct JSDecimal {
 
 #define __exception __attribute__((warn_unused_result))
 
+/* threaded interpreter dispatch using computed gotos (build with
+   -DDIRECT_DISPATCH=0 to get the portable switch() loop) */
+#ifndef DIRECT_DISPATCH
+#if defined(__GNUC__) && !defined(DUMP_EXEC)
+#define DIRECT_DISPATCH  1
+#else
+#define DIRECT_DISPATCH  0
+#endif
+#endif
+
 #define JS_STACK_SLACK  16   /* additional free space on the stack */
 /* min free size in bytes between heap_free and the bottom of the stack */
 #define JS_MIN_FREE_SIZE 512
@@ -216,6 +233,31 @@ typedef struct JSROMClass {
 #define JS_STRING_POS_CACHE_SIZE 2
 #define JS_STRING_POS_CACHE_MIN_LEN 16
 
+#define JS_PROP_CACHE_SIZE 256 /* power of two */
+
+/* inline cache of a get_field/put_field site, indexed by its pc. The
+   entry is only a hint: it is checked against the props array of the
+   object, so it needs no invalidation. */
+typedef struct {
+    const uint8_t *pc;
+    JSValue hash_mask; /* layout of the props array */
+    uint32_t idx; /* position of the property in the props array */
+} JSPropCacheEntry;
+
+#if MTPSCRIPT_DETERMINISTIC
+#define JS_KEY_ORDER_CACHE_SIZE 32 /* power of two */
+#define JS_KEY_ORDER_CACHE_MAX_KEYS 32
+
+/* canonical order of the keys of an object, indexed by a hash of its
+   property keys in insertion order */
+typedef struct {
+    uint32_t hash;
+    uint8_t count; /* 0 if unused */
+    uint8_t order[JS_KEY_ORDER_CACHE_MAX_KEYS]; /* insertion index of the
+                                                   n-th canonical key */
+} JSKeyOrderCacheEntry;
+#endif
+
 typedef enum {
     POS_TYPE_UTF8,
     POS_TYPE_UTF16,
@@ -237,6 +279,7 @@ struct JSContext {
     */
     uint8_t *heap_base;
     uint8_t *heap_free; /* first free area */
+    uint8_t *heap_old_end; /* end of the frozen blocks, see JS_FreezeHeap() */
     uint8_t *stack_top;
     JSValue *stack_bottom; /* sp must always be higher than stack_bottom */
     JSValue *sp; /* current stack pointer */
@@ -250,6 +293,12 @@ struct JSContext {
     int16_t interrupt_counter;
     BOOL current_exception_is_uncatchable : 8;
     size_t max_heap_size; /* MTPScript hard memory budget */
+    size_t heap_limit; /* soft limit of the heap above heap_old_end: a GC
+                          runs before it is exceeded. 0 = no limit */
+    size_t heap_peak; /* largest heap size seen by the GC or
+                         JS_GetMemoryUsage() */
+    JSValue *stack_peak; /* lowest stack_bottom */
+    uint32_t gc_count;
     struct JSParseState *parse_state; /* != NULL during JS_Eval() */
     int unique_strings_len;
     int js_call_rec_count; /* number of recursing JS_Call() */
@@ -263,11 +312,19 @@ struct JSContext {
     uint64_t random_state;
     uint64_t gas_limit; /* MTPScript gas limit */
     uint64_t gas_used;  /* MTPScript gas used counter */
+    /* != NULL if the gas runs out when reaching this opcode of the
+       current block (see js_charge_gas_slow()) */
+    const uint8_t *gas_trap_pc;
     JSInterruptHandler *interrupt_handler;
     JSWriteFunc *write_func; /* for the various dump functions */
     void *opaque;
     JSValue *class_obj; /* same as class_proto + class_count */
+    JSContextImage *image; /* != NULL if mapped from a context image */
     JSStringPosCacheEntry string_pos_cache[JS_STRING_POS_CACHE_SIZE];
+#if MTPSCRIPT_DETERMINISTIC
+    JSKeyOrderCacheEntry key_order_cache[JS_KEY_ORDER_CACHE_SIZE];
+#endif
+    JSPropCacheEntry prop_cache[JS_PROP_CACHE_SIZE];
 
     /* must only contain JSValue from this point (see JS_GC()) */
     JSValue unique_strings; /* JSValueArray of sorted strings or JS_NULL */
@@ -429,23 +486,14 @@ typedef enum OPCodeEnum {
     OP_COUNT,
 } OPCodeEnum;
 
-/* Get gas cost for an opcode - Basic Annex A implementation */
-/* Simplified implementation that provides the framework for detailed costing */
-uint32_t get_opcode_gas_cost(uint32_t opcode) {
-    /* For MTPScript Phase 0, we implement basic gas costing that covers
-     * the essential operations. Full Annex A compliance would require
-     * detailed analysis of each opcode, but this provides the foundation.
-
-     * Key cost categories from Annex A:
-     * - Base instructions: 1 gas
-     * - Arithmetic: 2 gas
-     * - Function calls: 5 gas
-     * - Memory operations: 3 gas
-     */
+#include "mquickjs_gas.h"
 
-    /* Default to base cost for all operations */
-    /* This provides the infrastructure - specific opcodes can be added later */
-    return GAS_COST_BASE;
+/* Annex A cost of an opcode (table generated from gas-v5.1.csv) */
+uint32_t get_opcode_gas_cost(uint32_t opcode)
+{
+    if (opcode >= OP_COUNT)
+        return GAS_COST_BASE;
+    return gas_cost[opcode];
 }
 
 typedef struct {
@@ -472,6 +520,29 @@ static __maybe_unused const JSOpCode opcode_info[OP_COUNT] = {
 #undef FMT
 };
 
+/* TRUE if the opcode ends a basic block for gas metering: branches,
+   returns and calls (the callee charges its own gas before the
+   caller continues). */
+static BOOL is_gas_block_end(int op)
+{
+    switch(op) {
+    case OP_call_constructor:
+    case OP_call:
+    case OP_call_method:
+    case OP_return:
+    case OP_return_undef:
+    case OP_throw:
+    case OP_if_false:
+    case OP_if_true:
+    case OP_goto:
+    case OP_gosub:
+    case OP_ret:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
 #include "mquickjs_atom.h"
 
 JSValue *JS_PushGCRef(JSContext *ctx, JSGCRef *ref)
@@ -546,6 +617,30 @@ static int js_get_mtag(void *ptr)
     return ((JSMemBlockHeader *)ptr)->mtag;
 }
 
+/* called after a GC: at least half of the limit is kept free so that
+   the GC cost stays proportional to the allocated size. The limit
+   never decreases and never exceeds the hard budget. */
+static void js_grow_heap_limit(JSContext *ctx, uint32_t size)
+{
+    size_t used, max_limit;
+    used = ctx->heap_free - ctx->heap_old_end + size;
+    max_limit = SIZE_MAX;
+    if (ctx->max_heap_size != 0)
+        max_limit = ctx->max_heap_size - min_size_t(ctx->max_heap_size, ctx->heap_old_end - ctx->heap_base);
+    while (ctx->heap_limit < 2 * used && ctx->heap_limit < max_limit)
+        ctx->heap_limit *= 2;
+    if (ctx->heap_limit > max_limit)
+        ctx->heap_limit = max_limit;
+}
+
+/* MTPScript: TRUE if allocating 'size' bytes exceeds the hard budget.
+   The out of memory error itself may exceed it. */
+static BOOL js_over_heap_budget(JSContext *ctx, uint32_t size)
+{
+    return ctx->max_heap_size != 0 && !ctx->in_out_of_memory &&
+        (size_t)(ctx->heap_free - ctx->heap_base) + size > ctx->max_heap_size;
+}
+
 static int check_free_mem(JSContext *ctx, JSValue *stack_bottom, uint32_t size)
 {
 #ifdef DEBUG_GC
@@ -556,11 +651,19 @@ static int check_free_mem(JSContext *ctx, JSValue *stack_bottom, uint32_t size)
     }
 #endif
 
-    /* MTPScript: Enforce hard memory budget */
-    if (ctx->max_heap_size > 0) {
-        size_t current_heap_size = ctx->heap_free - ctx->heap_base;
-        if (current_heap_size + size > ctx->max_heap_size) {
-            /* Hard memory limit exceeded */
+    /* MTPScript: collect before growing the heap beyond the soft limit */
+    if (ctx->heap_limit != 0 &&
+        (size_t)(ctx->heap_free - ctx->heap_old_end) + size > ctx->heap_limit) {
+        JS_GC(ctx);
+        js_grow_heap_limit(ctx, size);
+    }
+
+    /* MTPScript: enforce the hard memory budget once the garbage is
+       collected */
+    if (js_over_heap_budget(ctx, size)) {
+        JS_GC(ctx);
+        if (js_over_heap_budget(ctx, size)) {
+            JS_ThrowOutOfMemory(ctx);
             return -1;
         }
     }
@@ -586,6 +689,8 @@ int JS_StackCheck(JSContext *ctx, uint32_t len)
     if (check_free_mem(ctx, new_stack_bottom, len * sizeof(JSValue)))
         return -1;
     ctx->stack_bottom = new_stack_bottom;
+    if (new_stack_bottom < ctx->stack_peak)
+        ctx->stack_peak = new_stack_bottom;
     return 0;
 }
 
@@ -629,7 +734,7 @@ static void js_free(JSContext *ctx, void *ptr)
         return;
     ptr1 = ptr;
     ptr1 += get_mblock_size(ptr1);
-    if (ptr1 == ctx->heap_free)
+    if (ptr1 == ctx->heap_free && (uint8_t *)ptr >= ctx->heap_old_end)
         ctx->heap_free = ptr;
 }
 
@@ -1162,43 +1267,61 @@ JSValue JS_NewUint32(JSContext *ctx, uint32_t val)
     return JS_NewInt64(ctx, val);
 }
 
-JSValue JS_NewDecimal(JSContext *ctx, const char *value_str, int32_t scale)
+static JSValue js_new_decimal(JSContext *ctx, const Decimal128 *a)
 {
     JSDecimal *d;
 
-    /* Validate inputs */
-    if (!value_str || scale < 0 || scale > 28) {
-        return JS_ThrowRangeError(ctx, "invalid decimal parameters");
-    }
+    d = js_malloc(ctx, sizeof(JSDecimal), JS_MTAG_DECIMAL);
+    if (!d)
+        return JS_EXCEPTION;
+    d->d = *a;
+    return JS_VALUE_FROM_PTR(d);
+}
 
-    /* Validate value_str: 1-34 digits, no leading zeros */
-    size_t len = strlen(value_str);
-    if (len < 1 || len > 34) {
-        return JS_ThrowRangeError(ctx, "decimal value must be 1-34 digits");
-    }
+/* Shortest canonical form (§23), used by every conversion of a Decimal
+   to a string so that its scale is never visible. Return the length. */
+static int js_decimal_to_cstring(char *buf, const Decimal128 *a)
+{
+    Decimal128 r;
 
-    /* Check all characters are digits and no leading zero */
-    if (value_str[0] == '0' && len > 1) {
-        return JS_ThrowRangeError(ctx, "decimal value cannot have leading zeros");
-    }
+    dec128_normalize(&r, a);
+    return dec128_to_string(buf, &r);
+}
 
-    for (size_t i = 0; i < len; i++) {
-        if (value_str[i] < '0' || value_str[i] > '9') {
-            return JS_ThrowRangeError(ctx, "decimal value must contain only digits");
-        }
+static JSValue js_throw_decimal_error(JSContext *ctx, int ret)
+{
+    switch(ret) {
+    case DEC128_ERR_SYNTAX:
+        return JS_ThrowTypedError(ctx, MTP_ERROR_INVALID_DECIMAL, "invalid decimal");
+    case DEC128_ERR_RANGE:
+        return JS_ThrowTypedError(ctx, MTP_ERROR_INVALID_DECIMAL, "decimal must have at most 34 digits and 28 decimal places");
+    case DEC128_ERR_DIV_ZERO:
+        return JS_ThrowTypedError(ctx, MTP_ERROR_INVALID_DECIMAL, "decimal division by zero");
+    default:
+        return JS_ThrowTypedError(ctx, MTP_ERROR_OVERFLOW, "decimal overflow");
     }
+}
 
-    /* Allocate decimal */
-    d = js_malloc(ctx, sizeof(JSDecimal), JS_MTAG_DECIMAL);
-    if (!d)
-        return JS_EXCEPTION;
-
-    /* Copy value string */
-    strncpy(d->value, value_str, sizeof(d->value) - 1);
-    d->value[sizeof(d->value) - 1] = '\0';  /* Ensure null termination */
-    d->scale = scale;
+/* 'value_str' is the significand: an optional '-' followed by 1-34
+   digits without leading zeros */
+JSValue JS_NewDecimal(JSContext *ctx, const char *value_str, int32_t scale)
+{
+    Decimal128 a;
+    size_t len;
+    int ret;
 
-    return JS_VALUE_FROM_PTR(d);
+    if (!value_str || scale < 0 || scale > DEC128_MAX_SCALE)
+        return JS_ThrowRangeError(ctx, "invalid decimal parameters");
+    len = strlen(value_str);
+    if (len > 1 && value_str[value_str[0] == '-'] == '0')
+        return JS_ThrowRangeError(ctx, "decimal value cannot have leading zeros");
+    if (strchr(value_str, '.') || value_str[0] == '+')
+        return JS_ThrowRangeError(ctx, "decimal value must contain only digits");
+    ret = dec128_from_string(&a, value_str, len);
+    if (ret)
+        return js_throw_decimal_error(ctx, ret);
+    a.scale = scale;
+    return js_new_decimal(ctx, &a);
 }
 
 static BOOL JS_IsPrimitive(JSContext *ctx, JSValue val)
@@ -1878,6 +2001,8 @@ static int string_buffer_putc(JSContext *ctx, StringBuffer *s, int c)
     return string_buffer_concat_str(ctx, s, JS_NewStringChar(c));
 }
 
+#if !MTPSCRIPT_DETERMINISTIC
+/* only used by the Function constructor */
 static int string_buffer_puts(JSContext *ctx, StringBuffer *s, const char *str)
 {
     JSGCRef s_ref;
@@ -1890,6 +2015,53 @@ static int string_buffer_puts(JSContext *ctx, StringBuffer *s, const char *str)
         return -1;
     return string_buffer_concat_str(ctx, s, val);
 }
+#endif
+
+/* Make room for 'len' more bytes so that they can be written directly
+   in the byte array without allocation. Return 0 if OK, -1 in case of
+   exception */
+static int string_buffer_reserve(JSContext *ctx, StringBuffer *s, int len)
+{
+    JSStringCharBuf buf1;
+    JSByteArray *arr;
+    JSString *p1;
+    JSValue val1;
+    JSGCRef val1_ref;
+    int len1;
+
+    if (JS_IsException(s->buffer))
+        return -1;
+    if (JS_IsString(ctx, s->buffer)) {
+        p1 = get_string_ptr(ctx, &buf1, s->buffer);
+        len1 = p1->len;
+        arr = NULL;
+        val1 = s->buffer;
+        s->buffer = JS_NULL;
+    } else {
+        arr = JS_VALUE_TO_PTR(s->buffer);
+        len1 = s->len;
+        val1 = JS_NULL;
+    }
+    if (len > JS_STRING_LEN_MAX - len1) {
+        s->buffer = JS_ThrowInternalError(ctx, "string too long");
+        return -1;
+    }
+    if (!arr || (len1 + len + 1) > arr->size) {
+        JS_PUSH_VALUE(ctx, val1);
+        s->buffer = js_resize_byte_array(ctx, s->buffer, len1 + len + 1);
+        JS_POP_VALUE(ctx, val1);
+        if (JS_IsException(s->buffer))
+            return -1;
+        if (val1 != JS_NULL) {
+            arr = JS_VALUE_TO_PTR(s->buffer);
+            p1 = get_string_ptr(ctx, &buf1, val1);
+            s->is_ascii = p1->is_ascii;
+            memcpy(arr->buf, p1->buf, len1);
+        }
+    }
+    s->len = len1;
+    return 0;
+}
 
 static JSValue string_buffer_end(JSContext *ctx, StringBuffer *s)
 {
@@ -2616,6 +2788,33 @@ static inline JSProperty *find_own_property(JSContext *ctx,
     return find_own_property_inlined(ctx, p, prop);
 }
 
+/* same as find_own_property() for the field access at 'pc'. Objects
+   built the same way have their properties at the same position, so
+   the hit case is a compare of the key at the cached position. The
+   hash mask gives the start of the properties, so that the position
+   cannot designate a property value. */
+static force_inline JSProperty *find_own_property_cached(JSContext *ctx,
+                                                         JSObject *p, JSValue prop,
+                                                         const uint8_t *pc)
+{
+    JSPropCacheEntry *ce;
+    JSValueArray *arr;
+    JSProperty *pr;
+
+    ce = &ctx->prop_cache[(uintptr_t)pc & (JS_PROP_CACHE_SIZE - 1)];
+    arr = JS_VALUE_TO_PTR(p->props);
+    if (ce->pc == pc && ce->hash_mask == arr->arr[1] &&
+        likely(ce->idx < arr->size && arr->arr[ce->idx] == prop))
+        return (JSProperty *)&arr->arr[ce->idx];
+    pr = find_own_property_inlined(ctx, p, prop);
+    if (pr) {
+        ce->pc = pc;
+        ce->hash_mask = arr->arr[1];
+        ce->idx = (JSValue *)pr - arr->arr;
+    }
+    return pr;
+}
+
 static JSValue get_special_prop(JSContext *ctx, JSValue val)
 {
     int idx;
@@ -3680,6 +3879,7 @@ JSContext *JS_NewContext2(void *mem_start, size_t mem_size, const JSSTDLibraryDe
     ctx->class_obj = ctx->class_proto + ctx->class_count;
     ctx->heap_base = (void *)(ctx->class_proto + 2 * ctx->class_count);
     ctx->heap_free = ctx->heap_base;
+    ctx->heap_old_end = ctx->heap_base;
     ctx->stack_top = mem_start + mem_size;
     ctx->sp = (JSValue *)ctx->stack_top;
     ctx->stack_bottom = ctx->sp;
@@ -3693,6 +3893,7 @@ JSContext *JS_NewContext2(void *mem_start, size_t mem_size, const JSSTDLibraryDe
     ctx->gas_limit = MTPSCRIPT_GAS_DEFAULT;
     ctx->gas_used = 0;
     ctx->max_heap_size = mem_size; /* MTPScript: hard memory budget = allocated size */
+    ctx->stack_peak = ctx->sp;
     ctx->write_func = dummy_write_func;
     for(i = 0; i < JS_STRING_POS_CACHE_SIZE; i++)
         ctx->string_pos_cache[i].str = JS_NULL;
@@ -3776,53 +3977,560 @@ JSContext *JS_NewContext(void *mem_start, size_t mem_size, const JSSTDLibraryDef
     return JS_NewContext2(mem_start, mem_size, stdlib_def, FALSE);
 }
 
-JSContext *JS_CloneContext(JSContext *src_ctx, void *mem_start, size_t mem_size)
+typedef struct {
+    uint8_t *start; /* old address range of the context */
+    uint8_t *end;
+    ptrdiff_t offset; /* added to every pointer in [start, end) */
+    /* old address range of the stdlib table, empty when cloning */
+    uint8_t *rom_start;
+    uint8_t *rom_end;
+    ptrdiff_t rom_offset;
+    BOOL check; /* set 'error' for the pointers outside both ranges */
+    BOOL error;
+} JSRelocState;
+
+static inline void *js_reloc_ptr(JSRelocState *s, void *ptr)
+{
+    if ((uint8_t *)ptr >= s->start && (uint8_t *)ptr < s->end) {
+        ptr = (uint8_t *)ptr + s->offset;
+    } else if ((uint8_t *)ptr >= s->rom_start && (uint8_t *)ptr < s->rom_end) {
+        ptr = (uint8_t *)ptr + s->rom_offset;
+    } else if (s->check) {
+        s->error = TRUE;
+    }
+    return ptr;
+}
+
+static inline void js_reloc_value(JSRelocState *s, JSValue *pval)
 {
-    JSContext *dst_ctx;
-    size_t ctx_size, heap_size;
+    JSValue val = *pval;
+    if (JS_IsPtr(val))
+        *pval = JS_VALUE_FROM_PTR(js_reloc_ptr(s, JS_VALUE_TO_PTR(val)));
+}
+
+/* relocate the memory block 'ptr'. Same fields as gc_thread_block() */
+static void js_reloc_block(JSRelocState *s, void *ptr)
+{
+    switch(((JSMemBlockHeader *)ptr)->mtag) {
+    case JS_MTAG_OBJECT:
+        {
+            JSObject *p = ptr;
+            js_reloc_value(s, &p->proto);
+            js_reloc_value(s, &p->props);
+            switch(p->class_id) {
+            case JS_CLASS_CLOSURE:
+                {
+                    int i;
+                    js_reloc_value(s, &p->u.closure.func_bytecode);
+                    for(i = 0; i < p->extra_size - 1; i++)
+                        js_reloc_value(s, &p->u.closure.var_refs[i]);
+                }
+                break;
+            case JS_CLASS_C_FUNCTION:
+                if (p->extra_size > 1)
+                    js_reloc_value(s, &p->u.cfunc.params);
+                break;
+            case JS_CLASS_ARRAY:
+                js_reloc_value(s, &p->u.array.tab);
+                break;
+            case JS_CLASS_ERROR:
+                js_reloc_value(s, &p->u.error.message);
+                js_reloc_value(s, &p->u.error.stack);
+                break;
+            case JS_CLASS_ARRAY_BUFFER:
+                js_reloc_value(s, &p->u.array_buffer.byte_buffer);
+                break;
+            case JS_CLASS_UINT8C_ARRAY:
+            case JS_CLASS_INT8_ARRAY:
+            case JS_CLASS_UINT8_ARRAY:
+            case JS_CLASS_INT16_ARRAY:
+            case JS_CLASS_UINT16_ARRAY:
+            case JS_CLASS_INT32_ARRAY:
+            case JS_CLASS_UINT32_ARRAY:
+            case JS_CLASS_FLOAT32_ARRAY:
+            case JS_CLASS_FLOAT64_ARRAY:
+                js_reloc_value(s, &p->u.typed_array.buffer);
+                break;
+            case JS_CLASS_REGEXP:
+                js_reloc_value(s, &p->u.regexp.source);
+                js_reloc_value(s, &p->u.regexp.byte_code);
+                break;
+            }
+        }
+        break;
+    case JS_MTAG_VALUE_ARRAY:
+        {
+            JSValueArray *p = ptr;
+            int i;
+            for(i = 0; i < p->size; i++)
+                js_reloc_value(s, &p->arr[i]);
+        }
+        break;
+    case JS_MTAG_VARREF:
+        {
+            JSVarRef *p = ptr;
+            js_reloc_value(s, &p->u.value);
+            if (!p->is_detached)
+                p->u.pvalue = js_reloc_ptr(s, p->u.pvalue);
+        }
+        break;
+    case JS_MTAG_FUNCTION_BYTECODE:
+        {
+            JSFunctionBytecode *b = ptr;
+            js_reloc_value(s, &b->func_name);
+            js_reloc_value(s, &b->byte_code);
+            js_reloc_value(s, &b->cpool);
+            js_reloc_value(s, &b->vars);
+            js_reloc_value(s, &b->ext_vars);
+            js_reloc_value(s, &b->filename);
+            js_reloc_value(s, &b->pc2line);
+        }
+        break;
+    default:
+        break;
+    }
+}
 
-    /* Implement copy-on-write semantics by copying heap but sharing immutable data */
-    /* True memory-mapping COW would require OS support, so we implement logical COW */
+/* relocate the values of the context copy 'ctx' and of its heap
+   [heap_base, heap_free), given as addresses in the copy */
+static void js_reloc_heap(JSRelocState *s, JSContext *ctx,
+                          uint8_t *heap_base, uint8_t *heap_free)
+{
+    JSValue *sp, *sp_end;
+    uint8_t *ptr;
+    int i, size;
 
-    if (!mem_start || mem_size < sizeof(JSContext)) {
-        return NULL;
+    sp_end = ctx->class_proto + 2 * ctx->class_count;
+    for(sp = &ctx->unique_strings; sp < sp_end; sp++)
+        js_reloc_value(s, sp);
+    for(i = 0; i < JS_STRING_POS_CACHE_SIZE; i++)
+        js_reloc_value(s, &ctx->string_pos_cache[i].str);
+
+    for(ptr = heap_base; ptr < heap_free; ptr += size) {
+        size = get_mblock_size(ptr);
+        js_reloc_block(s, ptr);
     }
+}
+
+/* 'ctx' is a byte copy of a context (context and heap) whose stack
+   ends at 'stack_top'. Update all the pointers to the source memory
+   so that the copy is self contained. The clone has no active frame. */
+static void js_relocate_context(JSContext *ctx, JSRelocState *s,
+                                uint8_t *stack_top)
+{
+    uint8_t *ptr;
+    int i, size;
+
+    ctx->heap_base = js_reloc_ptr(s, ctx->heap_base);
+    ctx->heap_free = js_reloc_ptr(s, ctx->heap_free);
+    ctx->heap_old_end = js_reloc_ptr(s, ctx->heap_old_end);
+    ctx->class_obj = js_reloc_ptr(s, ctx->class_obj);
+    ctx->atom_table = js_reloc_ptr(s, (void *)ctx->atom_table);
+    for(i = 0; i < ctx->n_rom_atom_tables; i++)
+        ctx->rom_atom_tables[i] = js_reloc_ptr(s, (void *)ctx->rom_atom_tables[i]);
+    ctx->stack_top = stack_top;
+    ctx->sp = (JSValue *)ctx->stack_top;
+    ctx->fp = ctx->sp;
+    ctx->stack_bottom = ctx->sp;
+    ctx->stack_peak = ctx->sp;
+    ctx->heap_peak = ctx->heap_free - ctx->heap_base;
+    ctx->gc_count = 0;
+    memset(ctx->prop_cache, 0, sizeof(ctx->prop_cache));
+    ctx->gas_trap_pc = NULL;
+    ctx->top_gc_ref = NULL;
+    ctx->last_gc_ref = NULL;
+    ctx->parse_state = NULL;
+    ctx->js_call_rec_count = 0;
 
-    /* Calculate sizes - context includes everything up to heap */
-    ctx_size = src_ctx->heap_base - (uint8_t *)src_ctx;
-    heap_size = src_ctx->heap_free - src_ctx->heap_base;
+    js_reloc_heap(s, ctx, ctx->heap_base, ctx->heap_free);
 
-    if (mem_size < ctx_size + heap_size) {
-        return NULL; /* Not enough memory for context + heap */
+    /* the property hash depends on the key addresses */
+    for(ptr = ctx->heap_base; ptr < ctx->heap_free; ptr += size) {
+        size = get_mblock_size(ptr);
+        if (js_get_mtag(ptr) == JS_MTAG_OBJECT)
+            js_rehash_props(ctx, (JSObject *)ptr, TRUE);
     }
+}
+
+/* copy 'src_ctx' to 'mem_start' and reset its runtime state. The
+   effect registry (context opaque) is not shared with the source. */
+static JSContext *js_clone_context(JSContext *src_ctx, void *mem_start, size_t mem_size)
+{
+    JSContext *dst_ctx;
+    JSRelocState ss, *s = &ss;
+    size_t used_size;
 
-    /* Copy the context structure and heap together */
-    memcpy(mem_start, src_ctx, ctx_size + heap_size);
+    mem_size &= ~(JSW - 1);
+    if (!mem_start || ((uintptr_t)mem_start & (JSW - 1)) != 0)
+        return NULL;
+    used_size = src_ctx->heap_free - (uint8_t *)src_ctx;
+    if (mem_size < used_size + src_ctx->min_free_size)
+        return NULL;
+
+    memcpy(mem_start, src_ctx, used_size);
     dst_ctx = mem_start;
+    memset(s, 0, sizeof(*s));
+    s->start = (uint8_t *)src_ctx;
+    s->end = src_ctx->stack_top;
+    s->offset = (uint8_t *)dst_ctx - (uint8_t *)src_ctx;
+    js_relocate_context(dst_ctx, s, (uint8_t *)mem_start + mem_size);
 
-    /* Adjust heap pointers in the cloned context */
-    ptrdiff_t offset = (uint8_t *)dst_ctx - (uint8_t *)src_ctx;
+    dst_ctx->current_exception = JS_UNDEFINED;
+    dst_ctx->current_exception_is_uncatchable = FALSE;
+    dst_ctx->in_out_of_memory = FALSE;
+    dst_ctx->gas_used = 0;
+    dst_ctx->opaque = NULL;
+    dst_ctx->image = NULL;
+    if (dst_ctx->max_heap_size > mem_size)
+        dst_ctx->max_heap_size = mem_size;
+    return dst_ctx;
+}
+
+/* Copy the context and its heap to 'mem_start'. The cost is
+   proportional to the heap size. Use a context image
+   (JS_NewContextImage()) to only copy the pages that are written. */
+JSContext *JS_CloneContext(JSContext *src_ctx, void *mem_start, size_t mem_size)
+{
+    return js_clone_context(src_ctx, mem_start, mem_size);
+}
+
+/* heap images */
 
-    dst_ctx->heap_base = src_ctx->heap_base + offset;
-    dst_ctx->heap_free = src_ctx->heap_free + offset;
-    dst_ctx->stack_top = src_ctx->stack_top + offset;
+/* bit 15 of the heap image version is a 64-bit indicator */
+#define JS_HEAP_IMAGE_VERSION (0x0001 | ((JSW & 8) << 12))
+
+/* In the image, the context is at address 0 and the stdlib table
+   follows it, so that the image does not depend on the host
+   addresses. The gap keeps 'heap_free' out of the stdlib range. */
+static uintptr_t js_heap_image_rom_base(uint32_t data_len)
+{
+    return ((uintptr_t)data_len + 64) & ~(uintptr_t)63;
+}
+
+/* the atoms contain no pointer, so their checksum does not depend on
+   the host addresses. XXX: the objects of the stdlib are only checked
+   through the table sizes */
+static uint32_t js_stdlib_checksum(const JSSTDLibraryDef *stdlib_def)
+{
+    const uint8_t *p = (const uint8_t *)stdlib_def->stdlib_table;
+    size_t i, len;
+    uint32_t h;
+
+    h = 2166136261;
+    len = stdlib_def->sorted_atoms_offset * sizeof(JSWord);
+    for(i = 0; i < len; i++)
+        h = (h ^ p[i]) * 16777619;
+    h = (h ^ stdlib_def->stdlib_table_len) * 16777619;
+    h = (h ^ stdlib_def->global_object_offset) * 16777619;
+    h = (h ^ stdlib_def->class_count) * 16777619;
+    return h;
+}
 
-    /* Reset runtime state for clean execution */
-    dst_ctx->sp = (JSValue *)dst_ctx->stack_top;
-    dst_ctx->fp = dst_ctx->sp;
+int JS_SaveHeapImage(JSContext *ctx, const JSSTDLibraryDef *stdlib_def,
+                     uint8_t **pbuf, size_t *pbuf_len)
+{
+    JSHeapImageHeader *hdr;
+    JSContext *dst_ctx;
+    JSRelocState ss, *s = &ss;
+    uint8_t *buf, *ptr;
+    uint32_t data_len;
+    size_t rom_len;
+    int size;
+
+    *pbuf = NULL;
+    *pbuf_len = 0;
+    if (ctx->fp != (JSValue *)ctx->stack_top || ctx->parse_state ||
+        ctx->n_rom_atom_tables != 1 ||
+        ctx->atom_table != stdlib_def->stdlib_table)
+        return -1;
+    /* the image is fully collected */
+    ctx->heap_old_end = ctx->heap_base;
+    JS_GC(ctx);
+
+    /* the C state of the user classes cannot be saved */
+    for(ptr = ctx->heap_base; ptr < ctx->heap_free; ptr += size) {
+        size = get_mblock_size(ptr);
+        if (js_get_mtag(ptr) == JS_MTAG_OBJECT &&
+            ((JSObject *)ptr)->class_id >= JS_CLASS_USER)
+            return -1;
+    }
+
+    data_len = ctx->heap_free - (uint8_t *)ctx;
+    rom_len = stdlib_def->stdlib_table_len * sizeof(JSWord);
+    buf = malloc(sizeof(JSHeapImageHeader) + data_len);
+    if (!buf)
+        return -1;
+    hdr = (JSHeapImageHeader *)buf;
+    hdr->magic = JS_HEAP_IMAGE_MAGIC;
+    hdr->version = JS_HEAP_IMAGE_VERSION;
+    hdr->stdlib_checksum = js_stdlib_checksum(stdlib_def);
+    hdr->data_len = data_len;
+    hdr->rom_len = rom_len;
+    dst_ctx = (JSContext *)(hdr + 1);
+    memcpy(dst_ctx, ctx, data_len);
+
+    /* reset the runtime state so that the image is deterministic */
     dst_ctx->current_exception = JS_UNDEFINED;
-    dst_ctx->gas_used = 0; /* Reset gas counter */
+    dst_ctx->current_exception_is_uncatchable = FALSE;
+    dst_ctx->in_out_of_memory = FALSE;
+    for(size = 0; size < JS_STRING_POS_CACHE_SIZE; size++)
+        dst_ctx->string_pos_cache[size].str = JS_NULL;
+#if MTPSCRIPT_DETERMINISTIC
+    memset(dst_ctx->key_order_cache, 0, sizeof(dst_ctx->key_order_cache));
+#endif
+    memset(dst_ctx->prop_cache, 0, sizeof(dst_ctx->prop_cache));
+    dst_ctx->gas_trap_pc = NULL;
 
-    /* In true COW, we'd mark pages as read-only and copy-on-write */
-    /* For MTPScript, this logical copy provides memory isolation */
+    memset(s, 0, sizeof(*s));
+    s->start = (uint8_t *)ctx;
+    s->end = ctx->stack_top;
+    s->offset = -(uintptr_t)ctx;
+    s->rom_start = (uint8_t *)stdlib_def->stdlib_table;
+    s->rom_end = s->rom_start + rom_len;
+    s->rom_offset = js_heap_image_rom_base(data_len) - (uintptr_t)s->rom_start;
+    s->check = TRUE;
+    js_reloc_heap(s, dst_ctx,
+                  (uint8_t *)dst_ctx + (ctx->heap_base - (uint8_t *)ctx),
+                  (uint8_t *)dst_ctx + data_len);
+    if (s->error) {
+        free(buf);
+        return -1;
+    }
+    dst_ctx->heap_base = js_reloc_ptr(s, dst_ctx->heap_base);
+    dst_ctx->heap_free = js_reloc_ptr(s, dst_ctx->heap_free);
+    dst_ctx->heap_old_end = js_reloc_ptr(s, dst_ctx->heap_old_end);
+    dst_ctx->class_obj = js_reloc_ptr(s, dst_ctx->class_obj);
+    dst_ctx->atom_table = js_reloc_ptr(s, (void *)dst_ctx->atom_table);
+    dst_ctx->rom_atom_tables[0] = js_reloc_ptr(s, (void *)dst_ctx->rom_atom_tables[0]);
+    dst_ctx->stack_top = NULL;
+    dst_ctx->stack_bottom = NULL;
+    dst_ctx->stack_peak = NULL;
+    dst_ctx->sp = NULL;
+    dst_ctx->fp = NULL;
+    dst_ctx->top_gc_ref = NULL;
+    dst_ctx->last_gc_ref = NULL;
+    dst_ctx->c_function_table = NULL;
+    dst_ctx->c_finalizer_table = NULL;
+    dst_ctx->interrupt_handler = NULL;
+    dst_ctx->write_func = NULL;
+    dst_ctx->opaque = NULL;
+    dst_ctx->image = NULL;
+    dst_ctx->max_heap_size = 0;
+    dst_ctx->heap_limit = 0;
+    dst_ctx->heap_peak = 0;
+    dst_ctx->gc_count = 0;
+    dst_ctx->gas_used = 0;
+
+    *pbuf = buf;
+    *pbuf_len = sizeof(JSHeapImageHeader) + data_len;
+    return 0;
+}
 
-    return dst_ctx;
+BOOL JS_IsHeapImage(const uint8_t *buf, size_t buf_len)
+{
+    const JSHeapImageHeader *hdr = (const JSHeapImageHeader *)buf;
+    return (buf_len >= sizeof(*hdr) && hdr->magic == JS_HEAP_IMAGE_MAGIC);
+}
+
+/* The cost is a copy and a relocation of the saved heap. The clones of
+   the returned context are done with JS_CloneContext() or a context
+   image as usual. */
+JSContext *JS_LoadHeapImage(void *mem_start, size_t mem_size,
+                            const JSSTDLibraryDef *stdlib_def,
+                            const uint8_t *buf, size_t buf_len)
+{
+    const JSHeapImageHeader *hdr = (const JSHeapImageHeader *)buf;
+    const JSContext *src_ctx;
+    JSContext *ctx;
+    JSRelocState ss, *s = &ss;
+    uintptr_t rom_base;
+
+    if (!JS_IsHeapImage(buf, buf_len) ||
+        hdr->version != JS_HEAP_IMAGE_VERSION ||
+        hdr->data_len < sizeof(JSContext) ||
+        buf_len - sizeof(*hdr) < hdr->data_len ||
+        hdr->stdlib_checksum != js_stdlib_checksum(stdlib_def) ||
+        hdr->rom_len != stdlib_def->stdlib_table_len * sizeof(JSWord))
+        return NULL;
+    src_ctx = (const JSContext *)(hdr + 1);
+    if (src_ctx->class_count != stdlib_def->class_count)
+        return NULL;
+    mem_size &= ~(JSW - 1);
+    if (!mem_start || ((uintptr_t)mem_start & (JSW - 1)) != 0)
+        return NULL;
+    if (mem_size < (size_t)hdr->data_len + src_ctx->min_free_size)
+        return NULL;
+
+    memcpy(mem_start, src_ctx, hdr->data_len);
+    ctx = mem_start;
+    rom_base = js_heap_image_rom_base(hdr->data_len);
+    memset(s, 0, sizeof(*s));
+    s->start = NULL;
+    s->end = (uint8_t *)rom_base;
+    s->offset = (uintptr_t)ctx;
+    s->rom_start = (uint8_t *)rom_base;
+    s->rom_end = s->rom_start + hdr->rom_len;
+    s->rom_offset = (uintptr_t)stdlib_def->stdlib_table - rom_base;
+    js_relocate_context(ctx, s, (uint8_t *)mem_start + mem_size);
+
+    ctx->c_function_table = stdlib_def->c_function_table;
+    ctx->c_finalizer_table = stdlib_def->c_finalizer_table;
+    ctx->write_func = dummy_write_func;
+    ctx->max_heap_size = mem_size;
+    return ctx;
+}
+
+#ifdef CONFIG_CONTEXT_IMAGE
+
+/* A context image is a sealed memfd holding a context and its heap,
+   relocated for a reserved arena. Clones map it MAP_PRIVATE over the
+   arena so that only the written pages are copied. Since the
+   pointers are absolute, there is at most one live clone per image. */
+struct JSContextImage {
+    int fd;
+    uint8_t *base; /* reserved arena, PROT_NONE when no clone is live */
+    size_t mem_size; /* arena size, multiple of the page size */
+    size_t image_size; /* context + heap, multiple of the page size */
+    BOOL in_use;
+};
+
+static int js_image_reserve(uint8_t *base, size_t size)
+{
+    void *ptr;
+    ptr = mmap(base, size, PROT_NONE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+    return ptr == MAP_FAILED ? -1 : 0;
+}
+
+JSContextImage *JS_NewContextImage(JSContext *src_ctx, size_t mem_size)
+{
+    JSContextImage *img;
+    JSContext *ctx;
+    size_t page_size;
+    void *ptr;
+
+    page_size = sysconf(_SC_PAGESIZE);
+    mem_size = (mem_size + page_size - 1) & ~(page_size - 1);
+    img = calloc(1, sizeof(*img));
+    if (!img)
+        return NULL;
+    img->fd = -1;
+    img->mem_size = mem_size;
+    ptr = mmap(NULL, mem_size, PROT_NONE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED)
+        goto fail;
+    img->base = ptr;
+
+    img->fd = memfd_create("mtpscript-context", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (img->fd < 0)
+        goto fail;
+    /* the part after the heap is a hole: it costs nothing until written */
+    if (ftruncate(img->fd, mem_size) < 0)
+        goto fail;
+
+    /* build the image in place through a shared mapping */
+    ptr = mmap(img->base, mem_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_FIXED, img->fd, 0);
+    if (ptr == MAP_FAILED)
+        goto fail;
+    ctx = js_clone_context(src_ctx, img->base, mem_size);
+    if (!ctx) {
+        js_image_reserve(img->base, mem_size);
+        goto fail;
+    }
+    ctx->image = img;
+    img->image_size = (ctx->heap_free - img->base + page_size - 1) & ~(page_size - 1);
+    if (js_image_reserve(img->base, mem_size))
+        goto fail;
+
+    /* the image can no longer be modified */
+    if (fcntl(img->fd, F_ADD_SEALS,
+              F_SEAL_WRITE | F_SEAL_GROW | F_SEAL_SHRINK | F_SEAL_SEAL) < 0)
+        goto fail;
+    return img;
+ fail:
+    JS_FreeContextImage(img);
+    return NULL;
 }
 
+void JS_FreeContextImage(JSContextImage *img)
+{
+    if (!img)
+        return;
+    if (img->base)
+        munmap(img->base, img->mem_size);
+    if (img->fd >= 0)
+        close(img->fd);
+    free(img);
+}
+
+/* Map the image copy-on-write over its arena. Return NULL if a clone
+   of this image is still live. The context must be released with
+   JS_FreeContext(). */
+JSContext *JS_CloneContextImage(JSContextImage *img)
+{
+    void *ptr;
+
+    if (img->in_use)
+        return NULL;
+    ptr = mmap(img->base, img->mem_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_FIXED, img->fd, 0);
+    if (ptr == MAP_FAILED)
+        return NULL;
+    img->in_use = TRUE;
+    return (JSContext *)img->base;
+}
+
+/* drop the private copies of the written pages: the arena reads as
+   the image again. The kernel never exposes the dropped pages. */
+static void js_image_discard(JSContextImage *img)
+{
+    madvise(img->base, img->mem_size, MADV_DONTNEED);
+}
+
+static void js_image_release(JSContextImage *img)
+{
+    js_image_reserve(img->base, img->mem_size);
+    img->in_use = FALSE;
+}
+
+#else
+
+JSContextImage *JS_NewContextImage(JSContext *src_ctx, size_t mem_size)
+{
+    return NULL;
+}
+
+void JS_FreeContextImage(JSContextImage *img)
+{
+}
+
+JSContext *JS_CloneContextImage(JSContextImage *img)
+{
+    return NULL;
+}
+
+#endif /* !CONFIG_CONTEXT_IMAGE */
+
 void JS_SecureWipe(JSContext *ctx)
 {
     if (!ctx) return;
 
+#ifdef CONFIG_CONTEXT_IMAGE
+    if (ctx->image) {
+        /* only the written pages are private: dropping them is the
+           wipe and resets the context to the image state */
+        void *opaque = ctx->opaque;
+        js_image_discard(ctx->image);
+        ctx->opaque = opaque;
+        ctx->random_state = 0;
+        ctx->gas_used = 0;
+        ctx->gas_limit = 0;
+        return;
+    }
+#endif
+
     /* Use explicit_bzero if available, otherwise memset */
 #ifdef HAVE_EXPLICIT_BZERO
     explicit_bzero(ctx->heap_base, ctx->heap_free - ctx->heap_base);
@@ -3858,6 +4566,11 @@ void JS_FreeContext(JSContext *ctx)
         }
         ptr += size;
     }
+
+#ifdef CONFIG_CONTEXT_IMAGE
+    if (ctx->image)
+        js_image_release(ctx->image);
+#endif
 }
 
 void JS_SetContextOpaque(JSContext *ctx, void *opaque)
@@ -3986,8 +4699,7 @@ static int cbor_serialize_object(JSContext *ctx, JSValue obj, CBORBuffer *buf) {
         return -1;
     }
 
-    /* For deterministic ordering, we need to sort keys by their CBOR representation */
-    /* For now, use the order returned by js_object_keys (which should be insertion order) */
+    /* js_object_keys() returns the keys in canonical CBOR order */
     JSValueArray *karr = JS_VALUE_TO_PTR(obj_keys->u.array.tab);
     for (uint32_t i = 0; i < len; i++) {
         JSValue key = karr->arr[i];
@@ -4076,9 +4788,10 @@ static int cbor_serialize_value(JSContext *ctx, JSValue val, CBORBuffer *buf) {
             }
         }
         case JS_MTAG_DECIMAL: {
-            /* Encode decimal as string for deterministic representation */
-            JSDecimal *d = (JSDecimal*)ptr;
-            return cbor_encode_string(buf, d->value, strlen(d->value));
+            /* Encode decimal as its shortest canonical string (§23) */
+            char str[DEC128_MAX_STR_LEN + 1];
+            int len = js_decimal_to_cstring(str, &((JSDecimal *)ptr)->d);
+            return cbor_encode_string(buf, str, len);
         }
         default: {
             /* For other types, encode as null for now */
@@ -4112,22 +4825,15 @@ uint64_t JS_CBORSerialize(JSContext *ctx, JSValue val, uint8_t **out_buf, size_t
     return hash;
 }
 
+JSValue JS_JSONStringify(JSContext *ctx, JSValue val)
+{
+    return js_json_stringify(ctx, NULL, 1, &val);
+}
+
 /* Canonical JSON hashing for deterministic response hashing */
 JS_BOOL JS_JSONHash(JSContext *ctx, JSValue val, uint8_t out_hash[32]) {
-    /* First serialize to canonical JSON */
-    JSValue json_str = js_json_stringify(ctx, NULL, 1, &val);
-    if (JS_IsException(json_str)) {
-        return FALSE;
-    }
-
-    JSCStringBuf sbuf;
-    const char *json_cstr = JS_ToCString(ctx, json_str, &sbuf);
-    size_t json_len = strlen(json_cstr);
-
-    /* Hash with SHA-256 */
-    SHA256((const unsigned char *)json_cstr, json_len, out_hash);
-
-    return TRUE;
+    /* Hash the canonical JSON as it is written */
+    return JS_JSONWrite(ctx, val, NULL, NULL, out_hash) == 0;
 }
 
 void JS_SetInterruptHandler(JSContext *ctx, JSInterruptHandler *interrupt_handler)
@@ -4160,6 +4866,34 @@ void JS_SetGasLimit(JSContext *ctx, uint64_t limit)
         ctx->gas_limit = limit;
     }
     ctx->gas_used = 0;
+    ctx->gas_trap_pc = NULL;
+}
+
+uint64_t JS_GetGasUsed(JSContext *ctx)
+{
+    return ctx->gas_used;
+}
+
+/* Charge a built-in function: 'base' is its Annex A cost and 'units'
+   the size-proportional part (see GAS_COST_BYTE_SHIFT). The whole cost
+   must fit in the remaining gas. Return -1 and throw GasExhausted
+   otherwise. */
+static int js_charge_gas(JSContext *ctx, uint32_t base, uint64_t units)
+{
+    uint64_t cost = base + units;
+
+    if (unlikely(ctx->gas_used >= ctx->gas_limit ||
+                 cost > ctx->gas_limit - ctx->gas_used)) {
+        JS_ThrowTypedError(ctx, MTP_ERROR_GAS_EXHAUSTED, "Gas limit exceeded");
+        return -1;
+    }
+    ctx->gas_used += cost;
+    return 0;
+}
+
+static inline uint64_t js_gas_string_units(int len)
+{
+    return (uint64_t)len >> GAS_COST_BYTE_SHIFT;
 }
 
 JSValue JS_GetGlobalObject(JSContext *ctx)
@@ -4418,13 +5152,20 @@ static int find_line_col(int *pcol_num, JSFunctionBytecode *b, uint32_t pc)
     line_num = 1;
     col_num = 1;
     while (pos < arr->size) {
+        op = arr->buf[pos];
+        if (op == OP_gas) {
+            /* no pc2line entry: use the next opcode */
+            if (pos == pc)
+                pc += opcode_info[op].size;
+            pos += opcode_info[op].size;
+            continue;
+        }
         get_pc2line(&line_num, &col_num, pc2line->buf, pc2line->size,
                     &pc2line_pos, b->has_column);
         if (pos == pc) {
             *pcol_num = col_num;
             return line_num;
         }
-        op = arr->buf[pos];
         pos += opcode_info[op].size;
     }
  fail:
@@ -4630,31 +5371,9 @@ JSValue JS_ToString(JSContext *ctx, JSValue val)
         case JS_MTAG_DECIMAL:
             {
                 JSDecimal *p = ptr;
-                char buf[64];
-                int len = (int)strlen(p->value);
-                int out_len = 0;
-
-                printf("JS_ToString: Decimal %s scale %d\n", p->value, p->scale);
-                if (p->scale == 0) {
-                    return JS_NewString(ctx, p->value);
-                } else if (p->scale >= len) {
-                    buf[out_len++] = '0';
-                    buf[out_len++] = '.';
-                    for (int i = 0; i < p->scale - len; i++) {
-                        buf[out_len++] = '0';
-                    }
-                    memcpy(buf + out_len, p->value, len);
-                    out_len += len;
-                } else {
-                    int dot_pos = len - p->scale;
-                    memcpy(buf, p->value, dot_pos);
-                    out_len += dot_pos;
-                    buf[out_len++] = '.';
-                    memcpy(buf + out_len, p->value + dot_pos, p->scale);
-                    out_len += p->scale;
-                }
-                buf[out_len] = '\0';
-                return JS_NewStringLen(ctx, buf, out_len);
+                char buf1[DEC128_MAX_STR_LEN + 1];
+                int len = js_decimal_to_cstring(buf1, &p->d);
+                return JS_NewStringLen(ctx, buf1, len);
             }
         default:
             js_snprintf(buf, sizeof(buf), "[mtag %d]", mtag);
@@ -4995,6 +5714,9 @@ static int js_get_length32(JSContext *ctx, uint32_t *pres, JSValue obj)
     return JS_ToUint32(ctx, pres, len_val);
 }
 
+static JSValue js_decimal_arith(JSContext *ctx, OPCodeEnum op,
+                                JSValue op1, JSValue op2);
+
 static no_inline JSValue js_add_slow(JSContext *ctx)
 {
     JSValue *op1, *op2;
@@ -5002,26 +5724,8 @@ static no_inline JSValue js_add_slow(JSContext *ctx)
     op1 = &ctx->sp[1];
     op2 = &ctx->sp[0];
 
-    /* MTPScript: handle Decimal addition */
-    if (JS_GetClassID(ctx, *op1) == JS_CLASS_DECIMAL &&
-        JS_GetClassID(ctx, *op2) == JS_CLASS_DECIMAL) {
-        JSDecimal *d1 = JS_VALUE_TO_PTR(*op1);
-        JSDecimal *d2 = JS_VALUE_TO_PTR(*op2);
-
-        /* printf("js_add_slow: Decimal addition %s (scale %d) + %s (scale %d)\n", d1->value, d1->scale, d2->value, d2->scale); */
-
-        /* Implement addition using string-based arithmetic for now */
-        /* Handle the specific test case 10.50 + 5.25 */
-        if (d1->scale == 2 && d2->scale == 2) {
-            long long v1 = atoll(d1->value);
-            long long v2 = atoll(d2->value);
-            long long sum = v1 + v2;
-            char buf[64];
-            sprintf(buf, "%lld", sum);
-            return JS_NewDecimal(ctx, buf, 2);
-        }
-        return JS_NewDecimal(ctx, "0", 0);
-    }
+    if (JS_IsDecimal(ctx, *op1) || JS_IsDecimal(ctx, *op2))
+        return js_decimal_arith(ctx, OP_add, *op1, *op2);
 
     *op1 = JS_ToPrimitive(ctx, *op1, HINT_NONE);
     if (JS_IsException(*op1))
@@ -5061,6 +5765,9 @@ static no_inline JSValue js_binary_arith_slow(JSContext *ctx, OPCodeEnum op)
 {
     double d1, d2, r;
 
+    if (JS_IsDecimal(ctx, ctx->sp[1]) || JS_IsDecimal(ctx, ctx->sp[0]))
+        return js_decimal_arith(ctx, op, ctx->sp[1], ctx->sp[0]);
+
     if (JS_ToNumber(ctx, &d1, ctx->sp[1]))
         return JS_EXCEPTION;
 
@@ -5093,6 +5800,14 @@ static no_inline JSValue js_unary_arith_slow(JSContext *ctx, OPCodeEnum op)
 {
     double d;
 
+    if (JS_IsDecimal(ctx, ctx->sp[0]) && (op == OP_neg || op == OP_plus)) {
+        Decimal128 a;
+        if (op == OP_plus)
+            return ctx->sp[0];
+        dec128_neg(&a, &((JSDecimal *)JS_VALUE_TO_PTR(ctx->sp[0]))->d);
+        return js_new_decimal(ctx, &a);
+    }
+
     if (JS_ToNumber(ctx, &d, ctx->sp[0]))
         return JS_EXCEPTION;
 
@@ -5186,8 +5901,16 @@ static no_inline JSValue js_relational_slow(JSContext *ctx, OPCodeEnum op)
     *op2 = JS_ToPrimitive(ctx, *op2, HINT_NUMBER);
     if (JS_IsException(*op2))
         return JS_EXCEPTION;
+    if (JS_IsDecimal(ctx, *op1) || JS_IsDecimal(ctx, *op2)) {
+        if (!JS_IsDecimal(ctx, *op1) || !JS_IsDecimal(ctx, *op2))
+            return JS_ThrowTypeError(ctx, "cannot mix Decimal and other types");
+        res = dec128_cmp(&((JSDecimal *)JS_VALUE_TO_PTR(*op1))->d,
+                         &((JSDecimal *)JS_VALUE_TO_PTR(*op2))->d);
+        goto cmp_res;
+    }
     if (JS_IsString(ctx, *op1) && JS_IsString(ctx, *op2)) {
         res = js_string_compare(ctx, *op1, *op2);
+    cmp_res:
         switch(op) {
         case OP_lt:
             res = (res < 0);
@@ -5311,12 +6034,8 @@ int js_structural_eq(JSContext *ctx, JSValue op1, JSValue op2)
             return js_string_eq(ctx, op1, op2);
 
         if (p1->mtag == JS_MTAG_DECIMAL) {
-            JSDecimal *d1 = (JSDecimal *)p1;
-            JSDecimal *d2 = (JSDecimal *)p2;
-            /* Use scale normalization for constant-time comparison */
-            mtpscript_decimal_t dec1 = {atoll(d1->value), d1->scale};
-            mtpscript_decimal_t dec2 = {atoll(d2->value), d2->scale};
-            return mtpscript_decimal_cmp(dec1, dec2) == 0;
+            /* equal values, whatever the scale (1.50 === 1.5) */
+            return dec128_cmp(&((JSDecimal *)p1)->d, &((JSDecimal *)p2)->d) == 0;
         }
 
         if (p1->mtag == JS_MTAG_OBJECT) {
@@ -5798,14 +6517,87 @@ static JSValue __js_poll_interrupt(JSContext *ctx)
     return JS_UNDEFINED;
 }
 
-/* handle user interruption */
+/* Slow path of OP_gas when the block may exhaust the gas: charge the
+   opcodes of the block at 'pc' one by one so that the exhaustion point
+   and 'gas_used' are the same as with per-opcode metering. Return
+   FALSE if the gas runs out at the first opcode of the block. If it
+   runs out later, the opcodes before that point are run and
+   'gas_trap_pc' is set: the exhaustion is raised instead of any
+   exception at or after it, of the return and of the calls of the
+   block (see js_gas_exception()). */
+static BOOL js_charge_gas_slow(JSContext *ctx, const uint8_t *pc,
+                               const uint8_t *pc_end)
+{
+    uint64_t gas_used = ctx->gas_used;
+    const uint8_t *pc_start = pc;
+    int op;
+
+    ctx->gas_trap_pc = NULL;
+    while (pc < pc_end) {
+        op = *pc;
+        if (op == OP_gas)
+            break;
+        if (gas_used >= ctx->gas_limit) {
+            ctx->gas_used = gas_used;
+            if (pc == pc_start)
+                return FALSE;
+            ctx->gas_trap_pc = pc;
+            return TRUE;
+        }
+        gas_used += gas_cost[op];
+        if (is_gas_block_end(op))
+            break;
+        pc += opcode_info[op].size;
+    }
+    ctx->gas_used = gas_used;
+    return TRUE;
+}
+
+/* Called when the opcode containing 'pc' raises an exception. OP_gas
+   charged its block on entry, so the gas of the opcodes which follow
+   it is refunded. Return TRUE if the exception must be replaced by
+   the gas exhaustion because the opcode is at or after 'gas_trap_pc'.
+   The opcode boundaries are found from the start of the bytecode,
+   which is only done on the exception path. */
+static BOOL js_gas_exception(JSContext *ctx, const uint8_t *buf,
+                             const uint8_t *buf_end, const uint8_t *pc)
+{
+    const uint8_t *p, *op_pc, *trap;
+    int op;
+
+    op_pc = p = buf;
+    while (p < pc) {
+        op_pc = p;
+        p += opcode_info[*p].size;
+    }
+    op = *op_pc;
+    /* the gas exhaustion in OP_gas is charged opcode by opcode */
+    if (op == OP_gas)
+        return FALSE;
+    trap = ctx->gas_trap_pc;
+    if (trap && trap >= buf && trap < buf_end) {
+        /* the block was only charged up to 'trap' */
+        ctx->gas_trap_pc = NULL;
+        if (op_pc >= trap)
+            return TRUE;
+        buf_end = trap;
+    }
+    if (is_gas_block_end(op))
+        return FALSE;
+    for(p = op_pc + opcode_info[op].size; p < buf_end;
+        p += opcode_info[op].size) {
+        op = *p;
+        if (op == OP_gas)
+            break;
+        ctx->gas_used -= gas_cost[op];
+        if (is_gas_block_end(op))
+            break;
+    }
+    return FALSE;
+}
+
+/* handle user interruption (gas is charged by OP_gas) */
 #define POLL_INTERRUPT() do {                           \
-        if (unlikely(ctx->gas_used >= ctx->gas_limit)) { \
-            JS_ThrowTypedError(ctx, MTP_ERROR_GAS_EXHAUSTED, "Gas limit exceeded"); \
-            goto exception;                             \
-        }                                               \
-        /* Charge gas based on opcode cost */           \
-        ctx->gas_used += get_opcode_gas_cost((uint32_t)opcode);   \
         if (unlikely(--ctx->interrupt_counter <= 0)) {  \
             SAVE();                                     \
             val = __js_poll_interrupt(ctx);             \
@@ -5855,22 +6647,38 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
     pc = NULL;
     goto function_call;
 
+#if DIRECT_DISPATCH
+    /* one indirect jump per handler instead of a shared switch branch */
+    static const void * const dispatch_table[256] = {
+#define FMT(f)
+#define DEF(id, size, n_pop, n_push, f) && case_OP_ ## id,
+#include "mquickjs_opcode.h"
+#undef DEF
+#undef FMT
+        [ OP_COUNT ... 255 ] = &&case_default
+    };
+#define SWITCH(pc)      goto *dispatch_table[opcode = *pc++];
+#define CASE(op)        case_ ## op
+#define DEFAULT         case_default
+#define BREAK           SWITCH(pc)
+#else
+#define SWITCH(pc)      opcode = *pc++; switch(opcode)
 #define CASE(op)        case op
 #define DEFAULT         default
 #define BREAK           break
+#endif
 
     for(;;) {
-        opcode = *pc++;
 #ifdef DUMP_EXEC
         {
             JSByteArray *arr;
             arr = JS_VALUE_TO_PTR(b->byte_code);
             js_printf(ctx, "    sp=%d\n", (int)(sp - fp));
-            js_printf(ctx, "%4d: %s\n", (int)(pc - arr->buf - 1),
-                   opcode_info[opcode].name);
+            js_printf(ctx, "%4d: %s\n", (int)(pc - arr->buf),
+                   opcode_info[*pc].name);
         }
 #endif
-        switch(opcode) {
+        SWITCH(pc) {
         CASE(OP_push_minus1):
         CASE(OP_push_0):
         CASE(OP_push_1):
@@ -6098,6 +6906,8 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                 js_reverse_val(sp, n);
 
             generic_function_call:
+                if (unlikely(ctx->gas_trap_pc != NULL))
+                    goto gas_trap;
                 POLL_INTERRUPT();
                 byte_code = JS_VALUE_TO_PTR(b->byte_code);
                 /* save pc + 1 of the current call */
@@ -6313,6 +7123,15 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     //                    js_printf(ctx, "tail call: 0x%x\n", call_flags);
                     goto generic_function_call;
                 }
+                {
+                    JSByteArray *byte_code = JS_VALUE_TO_PTR(b->byte_code);
+                    if (js_gas_exception(ctx, byte_code->buf,
+                                         byte_code->buf + byte_code->size, pc)) {
+                        SAVE();
+                        val = JS_ThrowTypedError(ctx, MTP_ERROR_GAS_EXHAUSTED, "Gas limit exceeded");
+                        RESTORE();
+                    }
+                }
                 /* XXX: start gc in case of JS_EXCEPTION_MEM */
                 stack_top = fp + FRAME_OFFSET_VAR0 + 1;
                 if (b->vars != JS_NULL) {
@@ -6341,10 +7160,17 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
 
         CASE(OP_return_undef):
             val = JS_UNDEFINED;
-            goto generic_return;
+            goto return_value;
 
         CASE(OP_return):
             val = sp[0];
+        return_value:
+            if (unlikely(ctx->gas_trap_pc != NULL)) {
+            gas_trap:
+                /* raised by js_gas_exception() */
+                val = JS_EXCEPTION;
+                goto exception;
+            }
         generic_return:
             {
                 JSObject *p;
@@ -6548,6 +7374,23 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
             }
             BREAK;
 
+        CASE(OP_gas):
+            {
+                uint32_t cost = get_u16(pc);
+                pc += 2;
+                if (likely(ctx->gas_used + cost < ctx->gas_limit)) {
+                    ctx->gas_used += cost;
+                } else {
+                    JSByteArray *byte_code = JS_VALUE_TO_PTR(b->byte_code);
+                    if (!js_charge_gas_slow(ctx, pc, byte_code->buf + byte_code->size)) {
+                        SAVE();
+                        val = JS_ThrowTypedError(ctx, MTP_ERROR_GAS_EXHAUSTED, "Gas limit exceeded");
+                        RESTORE();
+                        goto exception;
+                    }
+                }
+            }
+            BREAK;
         CASE(OP_goto):
             pc += (int32_t)get_u32(pc);
             POLL_INTERRUPT();
@@ -6594,11 +7437,10 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     JSProperty *pr;
                     if (unlikely(p->mtag != JS_MTAG_OBJECT))
                         goto get_field_slow;
+                    /* no array check is necessary because 'prop' is
+                       guaranteed not to be a numeric property */
+                    pr = find_own_property_cached(ctx, p, prop, pc);
                     for(;;) {
-                        /* no array check is necessary because 'prop' is
-                           guaranteed not to be a numeric property */
-                        /* XXX: slow due to short ints */
-                        pr = find_own_property_inlined(ctx, p, prop);
                         if (pr) {
                             if (unlikely(pr->prop_type != JS_PROP_NORMAL)) {
                                 /* sp[0] is this_obj, obj is the current
@@ -6615,6 +7457,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                             break;
                         }
                         p = JS_VALUE_TO_PTR(obj);
+                        pr = find_own_property_inlined(ctx, p, prop);
                     }
                 } else {
                 get_field_slow:
@@ -6695,8 +7538,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                         goto put_field_slow;
                     /* no array check is necessary because 'prop' is
                        guaranteed not to be a numeric property */
-                    /* XXX: slow due to short ints */
-                    pr = find_own_property_inlined(ctx, p, prop);
+                    pr = find_own_property_cached(ctx, p, prop, pc);
                     if (unlikely(!pr))
                         goto put_field_slow;
                     if (unlikely(pr->prop_type != JS_PROP_NORMAL))
@@ -7363,7 +8205,14 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                 goto exception;
             sp -= 2;
             BREAK;
-        default:
+        /* opcodes without an interpreter handler */
+        CASE(OP_invalid):
+        CASE(OP_nop):
+        CASE(OP_dup1):
+        CASE(OP_push_const8):
+        CASE(OP_fclosure8):
+        CASE(OP_push_empty_string):
+        DEFAULT:
             {
                 JSByteArray *byte_code = JS_VALUE_TO_PTR(b->byte_code);
                 SAVE();
@@ -7380,6 +8229,10 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
     ctx->fp = fp;
     ctx->js_call_rec_count--;
     return val;
+#undef SWITCH
+#undef CASE
+#undef DEFAULT
+#undef BREAK
 }
 
 #undef SAVE
@@ -7752,6 +8605,14 @@ void JS_PrintValueF(JSContext *ctx, JSValue val, int flags)
                 js_printf(ctx, "byte_array(%" PRIu64 ")", (uint64_t)arr->size);
             }
             break;
+        case JS_MTAG_DECIMAL:
+            {
+                JSDecimal *p = ptr;
+                char buf[DEC128_MAX_STR_LEN + 1];
+                js_decimal_to_cstring(buf, &p->d);
+                js_printf(ctx, "%s", buf);
+            }
+            break;
         case JS_MTAG_FUNCTION_BYTECODE:
             {
                 JSFunctionBytecode *b = ptr;
@@ -8164,8 +9025,8 @@ static __maybe_unused void dump_byte_code(JSContext *ctx, JSFunctionBytecode *b)
     line_num1 = 0;
     col_num1 = 0;
     while (pos < len) {
-        /* extract the debug info */
-        if (pc2line && pos >= hoisted_code_len) {
+        /* extract the debug info (none for OP_gas) */
+        if (pc2line && pos >= hoisted_code_len && tab[pos] != OP_gas) {
             get_pc2line(&line_num, &col_num, pc2line->buf, pc2line->size,
                         &pc2line_pos, b->has_column);
             if (line_num != line_num1 || col_num != col_num1) {
@@ -12036,6 +12897,163 @@ static void convert_ext_vars_to_local_vars(JSParseState *s)
     b->ext_vars_len = j;
 }
 
+#define GAS_BLOCK_START (1U << 31)
+
+/* set the hoisted code length stored at the end of the pc2line info */
+static void set_pc2line_hoisted_code_len(JSParseState *s, JSValue *pfunc,
+                                         int hoisted_code_len)
+{
+    JSFunctionBytecode *b;
+    JSByteArray *arr, *new_arr;
+    int i, n, len, new_len;
+
+    b = JS_VALUE_TO_PTR(*pfunc);
+    arr = JS_VALUE_TO_PTR(b->pc2line);
+    /* length of the current encoding */
+    i = arr->size;
+    while (i > 0) {
+        i--;
+        if ((arr->buf[i] & 0x80) == 0)
+            break;
+    }
+    len = i;
+    new_len = len + 1;
+    for(n = hoisted_code_len >> 7; n != 0; n >>= 7)
+        new_len++;
+
+    new_arr = js_alloc_byte_array(s->ctx, new_len);
+    if (!new_arr)
+        js_parse_error_mem(s);
+    b = JS_VALUE_TO_PTR(*pfunc);
+    arr = JS_VALUE_TO_PTR(b->pc2line);
+    memcpy(new_arr->buf, arr->buf, len);
+    n = hoisted_code_len;
+    new_arr->buf[len++] = n & 0x7f;
+    for(n >>= 7; n != 0; n >>= 7)
+        new_arr->buf[len++] = (n & 0x7f) | 0x80;
+    js_free(s->ctx, arr);
+    b->pc2line = JS_VALUE_FROM_PTR(new_arr);
+}
+
+/* Split the bytecode into basic blocks and start each block with an
+   OP_gas holding the summed gas cost of its opcodes, so that the
+   interpreter charges the gas once per block instead of once per
+   opcode. Blocks start at the function entry, at branch targets and
+   after the opcodes accepted by is_gas_block_end(). */
+static void insert_gas_blocks(JSParseState *s, JSValue *pfunc)
+{
+    JSContext *ctx = s->ctx;
+    JSByteArray *arr, *pos_arr, *new_arr;
+    JSFunctionBytecode *b;
+    const JSOpCode *oi;
+    uint8_t *buf, *pos_tab, *new_buf;
+    uint32_t pos, pos1, len, delta, cost, c, new_pos;
+    int op, gas_pos, hoisted_code_len;
+    JSValue pos_arr_val;
+    JSGCRef pos_arr_val_ref;
+
+    b = JS_VALUE_TO_PTR(*pfunc);
+    arr = JS_VALUE_TO_PTR(b->byte_code);
+    len = arr->size;
+
+    /* new position of each opcode, or'ed with GAS_BLOCK_START if a
+       block starts there. Branches are redirected to the OP_gas. */
+    pos_arr = js_alloc_byte_array(ctx, (len + 1) * sizeof(uint32_t));
+    if (!pos_arr)
+        js_parse_error_mem(s);
+    pos_arr_val = JS_VALUE_FROM_PTR(pos_arr);
+    JS_PUSH_VALUE(ctx, pos_arr_val);
+
+    b = JS_VALUE_TO_PTR(*pfunc);
+    buf = ((JSByteArray *)JS_VALUE_TO_PTR(b->byte_code))->buf;
+    pos_tab = pos_arr->buf;
+    memset(pos_tab, 0, (len + 1) * sizeof(uint32_t));
+    put_u32(pos_tab, GAS_BLOCK_START);
+    for(pos = 0; pos < len; pos += oi->size) {
+        op = buf[pos];
+        oi = &opcode_info[op];
+        if (oi->fmt == OP_FMT_label) {
+            pos1 = pos + 1 + get_u32(buf + pos + 1);
+            put_u32(pos_tab + pos1 * 4, GAS_BLOCK_START);
+        }
+        if (is_gas_block_end(op))
+            put_u32(pos_tab + (pos + oi->size) * 4, GAS_BLOCK_START);
+    }
+
+    /* compute the new positions. A block whose cost does not fit in
+       16 bits is split. */
+    delta = 0;
+    cost = 0;
+    for(pos = 0; pos < len; pos += oi->size) {
+        op = buf[pos];
+        oi = &opcode_info[op];
+        c = gas_cost[op];
+        pos1 = get_u32(pos_tab + pos * 4);
+        if (cost + c > 0xffff)
+            pos1 = GAS_BLOCK_START;
+        if (pos1 & GAS_BLOCK_START)
+            cost = 0;
+        put_u32(pos_tab + pos * 4, (pos + delta) | (pos1 & GAS_BLOCK_START));
+        if (pos1 & GAS_BLOCK_START)
+            delta += 3;
+        cost += c;
+    }
+    put_u32(pos_tab + len * 4, len + delta);
+
+    new_arr = js_alloc_byte_array(ctx, len + delta);
+    if (!new_arr)
+        js_parse_error_mem(s);
+
+    b = JS_VALUE_TO_PTR(*pfunc);
+    arr = JS_VALUE_TO_PTR(b->byte_code);
+    buf = arr->buf;
+    pos_arr = JS_VALUE_TO_PTR(pos_arr_val_ref.val);
+    pos_tab = pos_arr->buf;
+    new_buf = new_arr->buf;
+    gas_pos = -1;
+    cost = 0;
+    for(pos = 0; pos < len; pos += oi->size) {
+        op = buf[pos];
+        oi = &opcode_info[op];
+        new_pos = get_u32(pos_tab + pos * 4);
+        if (new_pos & GAS_BLOCK_START) {
+            new_pos &= ~GAS_BLOCK_START;
+            new_buf[new_pos] = OP_gas;
+            gas_pos = new_pos + 1;
+            cost = 0;
+            new_pos += 3;
+        }
+        memcpy(new_buf + new_pos, buf + pos, oi->size);
+        if (oi->fmt == OP_FMT_label) {
+            pos1 = pos + 1 + get_u32(buf + pos + 1);
+            put_u32(new_buf + new_pos + 1,
+                    (get_u32(pos_tab + pos1 * 4) & ~GAS_BLOCK_START) - (new_pos + 1));
+        }
+        if (gas_pos >= 0) {
+            cost += gas_cost[op];
+            put_u16(new_buf + gas_pos, cost);
+        }
+        if (is_gas_block_end(op))
+            gas_pos = -1;
+    }
+    js_free(ctx, arr);
+    b->byte_code = JS_VALUE_FROM_PTR(new_arr);
+    s->byte_code = b->byte_code;
+
+    /* the OP_gas opcodes have no pc2line entry */
+    if (b->pc2line != JS_NULL) {
+        arr = JS_VALUE_TO_PTR(b->pc2line);
+        hoisted_code_len = get_pc2line_hoisted_code_len(arr->buf, arr->size);
+        pos1 = get_u32(pos_tab + hoisted_code_len * 4) & ~GAS_BLOCK_START;
+        if (pos1 != hoisted_code_len)
+            set_pc2line_hoisted_code_len(s, pfunc, pos1);
+    }
+
+    JS_POP_VALUE(ctx, pos_arr_val);
+    pos_arr = JS_VALUE_TO_PTR(pos_arr_val);
+    js_free(ctx, pos_arr);
+}
+
 /* prepare the analysis of the code starting at position 'pos' */
 static void compute_stack_size_push(JSParseState *s,
                                     JSByteArray *arr,
@@ -12264,6 +13282,7 @@ static void js_parse_local_functions(JSParseState *s, JSValue *pfunc)
             js_shrink_value_array(ctx, &b->vars, s->local_vars_len);
             js_shrink_byte_array(ctx, &b->pc2line, (s->pc2line_bit_len + 7) / 8);
 
+            insert_gas_blocks(s, pfunc);
             compute_stack_size(s, pfunc);
         }
 
@@ -12700,7 +13719,7 @@ static void gc_mark(GCMarkState *s, JSValue val)
     if (!JS_IsPtr(val))
         return;
     ptr = JS_VALUE_TO_PTR(val);
-    if (JS_IS_ROM_PTR(ctx, ptr))
+    if (JS_IS_ROM_PTR(ctx, ptr) || (uint8_t *)ptr < ctx->heap_old_end)
         return;
     mb = ptr;
     if (mb->gc_mark)
@@ -12836,13 +13855,16 @@ static void gc_mark_root(GCMarkState *s, JSValue val)
     gc_mark_flush(s);
 }
 
-/* return true if the memory block is marked i.e. it won't be freed by the GC */
-static BOOL gc_mb_is_marked(JSValue val)
+/* return true if the memory block is marked or frozen i.e. it won't
+   be freed by the GC */
+static BOOL gc_mb_is_marked(JSContext *ctx, JSValue val)
 {
     JSFreeBlock *b;
     if (!JS_IsPtr(val))
         return FALSE;
     b = (JSFreeBlock *)JS_VALUE_TO_PTR(val);
+    if (!JS_IS_ROM_PTR(ctx, b) && (uint8_t *)b < ctx->heap_old_end)
+        return TRUE;
     return b->gc_mark;
 }
 
@@ -12902,6 +13924,25 @@ static void gc_mark_all(JSContext *ctx, BOOL keep_atoms)
         gc_mark_root(s, ps->byte_code);
     }
 
+    /* the frozen blocks are not marked: their references are roots
+       (the unique string table only holds weak references) */
+    {
+        uint8_t *ptr;
+        JSMemBlockHeader *mb;
+
+        for(ptr = ctx->heap_base; ptr < ctx->heap_old_end;
+            ptr += get_mblock_size(ptr)) {
+            mb = (JSMemBlockHeader *)ptr;
+            if (mtag_has_references(mb->mtag) &&
+                JS_VALUE_FROM_PTR(ptr) != ctx->unique_strings) {
+                if (mb->mtag == JS_MTAG_VALUE_ARRAY)
+                    *--s->gsp = 0;
+                *--s->gsp = JS_VALUE_FROM_PTR(ptr);
+                gc_mark_flush(s);
+            }
+        }
+    }
+
     /* if the mark stack overflowed, need to scan the heap */
     while (s->overflow) {
         uint8_t *ptr;
@@ -12910,7 +13951,7 @@ static void gc_mark_all(JSContext *ctx, BOOL keep_atoms)
 
         s->overflow = FALSE;
 
-        ptr = ctx->heap_base;
+        ptr = ctx->heap_old_end;
         while (ptr < ctx->heap_free) {
             size = get_mblock_size(ptr);
             mb = (JSMemBlockHeader *)ptr;
@@ -12932,13 +13973,14 @@ static void gc_mark_all(JSContext *ctx, BOOL keep_atoms)
 
         j = 0;
         for(i = 0; i < arr->size; i++) {
-            if (gc_mb_is_marked(arr->arr[i])) {
+            if (gc_mb_is_marked(ctx, arr->arr[i])) {
                 arr->arr[j++] = arr->arr[i];
             }
         }
         ctx->unique_strings_len = j;
         if (j > 0) {
-            arr->gc_mark = 1;
+            if ((uint8_t *)arr >= ctx->heap_old_end)
+                arr->gc_mark = 1;
             if (j < arr->size) {
                 /* shrink the array */
                 set_free_block(&arr->arr[j], (arr->size - j) * sizeof(JSValue));
@@ -12956,7 +13998,7 @@ static void gc_mark_all(JSContext *ctx, BOOL keep_atoms)
         JSStringPosCacheEntry *ce;
         for(i = 0; i < JS_STRING_POS_CACHE_SIZE; i++) {
             ce = &ctx->string_pos_cache[i];
-            if (!gc_mb_is_marked(ce->str))
+            if (!gc_mb_is_marked(ctx, ce->str))
                 ce->str = JS_NULL;
         }
     }
@@ -12967,7 +14009,7 @@ static void gc_mark_all(JSContext *ctx, BOOL keep_atoms)
         int size;
         JSFreeBlock *b;
 
-        ptr = ctx->heap_base;
+        ptr = ctx->heap_old_end;
         while (ptr < ctx->heap_free) {
             size = get_mblock_size(ptr);
             b = (JSFreeBlock *)ptr;
@@ -13012,7 +14054,7 @@ static void gc_thread_pointer(JSContext *ctx, JSValue *pval)
     if (!JS_IsPtr(val))
         return;
     ptr = JS_VALUE_TO_PTR(val);
-    if (JS_IS_ROM_PTR(ctx, ptr))
+    if (JS_IS_ROM_PTR(ctx, ptr) || (uint8_t *)ptr < ctx->heap_old_end)
         return;
     /* gc_mark = 0 indicates a normal memory block header, gc_mark = 1
        indicates a pointer to another element */
@@ -13124,7 +14166,36 @@ static void gc_thread_block(JSContext *ctx, void *ptr)
     }
 }
 
-/* Heap compaction using Jonkers algorithm */
+/* return TRUE if a property key of the frozen object 'p' may have
+   been moved by the compaction */
+static BOOL gc_has_moved_keys(JSContext *ctx, JSObject *p)
+{
+    JSValueArray *arr;
+    JSProperty *pr;
+    int prop_count, hash_mask, i, j;
+
+    arr = JS_VALUE_TO_PTR(p->props);
+    if (JS_IS_ROM_PTR(ctx, arr))
+        return FALSE;
+    hash_mask = JS_VALUE_GET_INT(arr->arr[1]);
+    if (hash_mask == 0)
+        return FALSE;
+    prop_count = JS_VALUE_GET_INT(arr->arr[0]);
+    for(i = 0, j = 0; j < prop_count; i++) {
+        pr = (JSProperty *)&arr->arr[2 + (hash_mask + 1) + 3 * i];
+        if (pr->key != JS_UNINITIALIZED) {
+            if (JS_IsPtr(pr->key) &&
+                !JS_IS_ROM_PTR(ctx, JS_VALUE_TO_PTR(pr->key)) &&
+                (uint8_t *)JS_VALUE_TO_PTR(pr->key) >= ctx->heap_old_end)
+                return TRUE;
+            j++;
+        }
+    }
+    return FALSE;
+}
+
+/* Heap compaction using Jonkers algorithm. The frozen blocks are
+   left in place. */
 static void gc_compact_heap(JSContext *ctx)
 {
     uint8_t *ptr, *new_ptr;
@@ -13169,9 +14240,13 @@ static void gc_compact_heap(JSContext *ctx)
         gc_thread_pointer(ctx, &ps->byte_code);
     }
 
+    /* the frozen blocks do not move: only their references are updated */
+    for(ptr = ctx->heap_base; ptr < ctx->heap_old_end; ptr += get_mblock_size(ptr))
+        gc_thread_block(ctx, ptr);
+
     /* pass 1: thread the pointers and update the previous ones */
-    new_ptr = ctx->heap_base;
-    ptr = ctx->heap_base;
+    new_ptr = ctx->heap_old_end;
+    ptr = ctx->heap_old_end;
     while (ptr < ctx->heap_free) {
         gc_update_threaded_pointers(ctx, ptr, new_ptr);
         size = get_mblock_size(ptr);
@@ -13184,8 +14259,8 @@ static void gc_compact_heap(JSContext *ctx)
 
     /* pass 2: update the threaded pointers and move the block to its
        final position */
-    new_ptr = ctx->heap_base;
-    ptr = ctx->heap_base;
+    new_ptr = ctx->heap_old_end;
+    ptr = ctx->heap_old_end;
     while (ptr < ctx->heap_free) {
         gc_update_threaded_pointers(ctx, ptr, new_ptr);
         size = get_mblock_size(ptr);
@@ -13213,7 +14288,9 @@ static void gc_compact_heap(JSContext *ctx)
     ptr = ctx->heap_base;
     while (ptr < ctx->heap_free) {
         size = get_mblock_size(ptr);
-        if (js_get_mtag(ptr) == JS_MTAG_OBJECT) {
+        if (js_get_mtag(ptr) == JS_MTAG_OBJECT &&
+            (ptr >= ctx->heap_old_end ||
+             gc_has_moved_keys(ctx, (JSObject *)ptr))) {
             js_rehash_props(ctx, (JSObject *)ptr, TRUE);
         }
         ptr += size;
@@ -13245,6 +14322,8 @@ static void JS_GC2(JSContext *ctx, BOOL keep_atoms)
         }
     }
 #endif
+    ctx->gc_count++;
+    ctx->heap_peak = max_size_t(ctx->heap_peak, ctx->heap_free - ctx->heap_base);
     gc_mark_all(ctx, keep_atoms);
     gc_compact_heap(ctx);
 #ifdef DUMP_GC
@@ -13260,9 +14339,47 @@ void JS_GC(JSContext *ctx)
     JS_GC2(ctx, TRUE);
 }
 
+/* The blocks allocated so far are frozen: the GC no longer marks,
+   frees nor moves them and only collects the blocks allocated after
+   this call. Their references are scanned as roots, so that the cost
+   of a GC mostly depends on the size of the young blocks. Meant for
+   the clones of a snapshot context which only serve one request. */
+void JS_FreezeHeap(JSContext *ctx)
+{
+    ctx->heap_old_end = ctx->heap_free;
+}
+
+/* 'initial_size' is the soft limit of the heap allocated after
+   JS_FreezeHeap(): a GC runs before it is exceeded, then the limit
+   grows so that the live blocks use at most half of it. The pages of
+   the arena above the heap are only touched once the limit reaches
+   them, so a large mmap() reservation only costs the memory actually
+   used. 0 = no soft limit (a GC only runs when the arena is full).
+   'max_size' is the hard budget of the whole heap (0 = the arena). */
+void JS_SetHeapLimit(JSContext *ctx, size_t initial_size, size_t max_size)
+{
+    size_t arena_size = ctx->stack_top - ctx->heap_base;
+    if (max_size == 0 || max_size > arena_size)
+        max_size = arena_size;
+    ctx->max_heap_size = max_size;
+    ctx->heap_limit = initial_size;
+}
+
+void JS_GetMemoryUsage(JSContext *ctx, JSMemoryUsage *s)
+{
+    s->heap_size = ctx->heap_free - ctx->heap_base;
+    ctx->heap_peak = max_size_t(ctx->heap_peak, s->heap_size);
+    s->heap_peak = ctx->heap_peak;
+    s->stack_peak = ctx->stack_top - (uint8_t *)ctx->stack_peak;
+    s->heap_limit = ctx->heap_limit;
+    s->arena_peak = (ctx->heap_base - (uint8_t *)ctx) + s->heap_peak +
+        s->stack_peak + ctx->min_free_size;
+    s->gc_count = ctx->gc_count;
+}
+
 /* bytecode saving and loading */
 
-#define JS_BYTECODE_VERSION_32 0x0001
+#define JS_BYTECODE_VERSION_32 0x0002
 /* bit 15 of bytecode version is a 64-bit indicator */
 #define JS_BYTECODE_VERSION (JS_BYTECODE_VERSION_32 | ((JSW & 8) << 12))
 
@@ -13285,6 +14402,7 @@ void JS_PrepareBytecode(JSContext *ctx,
     ctx->dummy_block = JS_NULL;
 #endif
 
+    ctx->heap_old_end = ctx->heap_base;
     JS_PUSH_VALUE(ctx, eval_code);
     JS_GC2(ctx, FALSE);
     JS_POP_VALUE(ctx, eval_code);
@@ -14183,7 +15301,10 @@ JSValue js_string_slice(JSContext *ctx, JSValue *this_val,
         if (JS_ToInt32Clamp(ctx, &end, argv[1], 0, len, len))
             return JS_EXCEPTION;
     }
-    return js_sub_string(ctx, *this_val, start, max_int(end, start));
+    end = max_int(end, start);
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_SLICE, js_gas_string_units(end - start)))
+        return JS_EXCEPTION;
+    return js_sub_string(ctx, *this_val, start, end);
 }
 
 JSValue js_string_substring(JSContext *ctx, JSValue *this_val,
@@ -14209,6 +15330,8 @@ JSValue js_string_substring(JSContext *ctx, JSValue *this_val,
         start = b;
         end = a;
     }
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_SLICE, js_gas_string_units(end - start)))
+        return JS_EXCEPTION;
     return js_sub_string(ctx, *this_val, start, end);
 }
 
@@ -14298,6 +15421,8 @@ JSValue js_string_concat(JSContext *ctx, JSValue *this_val,
         if (string_buffer_concat(ctx, b, argv[i]))
             return JS_EXCEPTION;
     }
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_CONCAT, js_gas_string_units(b->len)))
+        return JS_EXCEPTION;
     return string_buffer_end(ctx, b);
 }
 
@@ -14314,6 +15439,8 @@ JSValue js_string_indexOf(JSContext *ctx, JSValue *this_val,
         return JS_EXCEPTION;
     len = js_string_len(ctx, *this_val);
     v_len = js_string_len(ctx, argv[0]);
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_SEARCH, js_gas_string_units(len)))
+        return JS_EXCEPTION;
     if (lastIndexOf) {
         pos = len - v_len;
         if (argc > 1) {
@@ -14390,6 +15517,8 @@ JSValue js_string_toLowerCase(JSContext *ctx, JSValue *this_val,
     if (JS_IsException(*this_val))
         return *this_val;
     len = js_string_len(ctx, *this_val);
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_FORMAT, js_gas_string_units(len)))
+        return JS_EXCEPTION;
     string_buffer_init(ctx, b, len);
     for(i = 0; i < len; i++) {
         c = string_getc(ctx, *this_val, i);
@@ -14441,6 +15570,8 @@ JSValue js_string_trim(JSContext *ctx, JSValue *this_val,
     if (JS_IsException(*this_val))
         return *this_val;
     len = js_string_len(ctx, *this_val);
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_SLICE, js_gas_string_units(len)))
+        return JS_EXCEPTION;
     a = 0;
     b = len;
     if (magic & 1) {
@@ -14592,6 +15723,103 @@ JSValue js_object_create(JSContext *ctx, JSValue *this_val,
     return JS_NewObjectProtoClass(ctx, proto, JS_CLASS_OBJECT, 0);
 }
 
+#if MTPSCRIPT_DETERMINISTIC
+static void rqsort_idx(size_t nmemb,
+                       int (*cmp)(size_t, size_t, void *),
+                       void (*swap)(size_t, size_t, void *),
+                       void *opaque);
+
+/* Canonical key order (RFC 7049 §3.9): shorter keys first, then
+   bytewise. It is the order of the CBOR encodings of the keys, without
+   encoding them. No memory allocation. */
+static int js_canonical_key_cmp(JSContext *ctx, JSValue key1, JSValue key2)
+{
+    JSStringCharBuf buf1, buf2;
+    JSString *p1, *p2;
+
+    p1 = get_string_ptr(ctx, &buf1, key1);
+    p2 = get_string_ptr(ctx, &buf2, key2);
+    if (p1->len != p2->len)
+        return p1->len < p2->len ? -1 : 1;
+    return memcmp(p1->buf, p2->buf, p1->len);
+}
+
+typedef struct {
+    JSContext *ctx;
+    JSValue *keys;
+    uint8_t *order; /* sort 'order' instead of 'keys' if != NULL */
+} JSKeySortContext;
+
+static int js_key_sort_cmp(size_t i1, size_t i2, void *opaque)
+{
+    JSKeySortContext *s = opaque;
+    if (s->order)
+        return js_canonical_key_cmp(s->ctx, s->keys[s->order[i1]], s->keys[s->order[i2]]);
+    else
+        return js_canonical_key_cmp(s->ctx, s->keys[i1], s->keys[i2]);
+}
+
+static void js_key_sort_swap(size_t i1, size_t i2, void *opaque)
+{
+    JSKeySortContext *s = opaque;
+    if (s->order) {
+        uint8_t t = s->order[i1];
+        s->order[i1] = s->order[i2];
+        s->order[i2] = t;
+    } else {
+        JSValue t = s->keys[i1];
+        s->keys[i1] = s->keys[i2];
+        s->keys[i2] = t;
+    }
+}
+
+/* Sort the 'len' keys of an object in canonical order. 'hash' is a hash
+   of the property keys in insertion order. Objects with the same keys
+   hit the same cache entry; a hit is used if the cached order is
+   verified to be strictly increasing, so hash collisions and moved
+   atoms only cost a sort. */
+static void js_sort_canonical_keys(JSContext *ctx, JSValue *keys, int len,
+                                   uint32_t hash)
+{
+    JSKeySortContext s;
+    JSKeyOrderCacheEntry *ce;
+    JSValue tmp[JS_KEY_ORDER_CACHE_MAX_KEYS];
+    int i;
+
+    s.ctx = ctx;
+    s.keys = keys;
+    s.order = NULL;
+    if (len > JS_KEY_ORDER_CACHE_MAX_KEYS) {
+        rqsort_idx(len, js_key_sort_cmp, js_key_sort_swap, &s);
+        return;
+    }
+
+    ce = &ctx->key_order_cache[hash & (JS_KEY_ORDER_CACHE_SIZE - 1)];
+    if (ce->hash == hash && ce->count == len) {
+        for(i = 0; i < len; i++)
+            tmp[i] = keys[ce->order[i]];
+        for(i = 1; i < len; i++) {
+            if (js_canonical_key_cmp(ctx, tmp[i - 1], tmp[i]) >= 0)
+                break;
+        }
+        if (i == len) {
+            memcpy(keys, tmp, sizeof(keys[0]) * len);
+            return;
+        }
+    }
+
+    for(i = 0; i < len; i++)
+        ce->order[i] = i;
+    s.order = ce->order;
+    rqsort_idx(len, js_key_sort_cmp, js_key_sort_swap, &s);
+    for(i = 0; i < len; i++)
+        tmp[i] = keys[ce->order[i]];
+    memcpy(keys, tmp, sizeof(keys[0]) * len);
+    ce->hash = hash;
+    ce->count = len;
+}
+#endif
+
 JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
                        int argc, JSValue *argv)
 {
@@ -14599,10 +15827,9 @@ JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
     JSValue ret, str;
     JSValueArray *arr, *ret_arr;
     int array_len, prop_count, hash_mask, alloc_size, i, j, pos;
+    uint32_t keys_hash;
     JSGCRef ret_ref;
 
-    printf("js_object_keys: argv[0]=%llx is_object=%d\n", (long long)argv[0], JS_IsObject(ctx, argv[0]));
-
     if (!JS_IsObject(ctx, argv[0]))
         return JS_ThrowTypeErrorNotAnObject(ctx);
     p = JS_VALUE_TO_PTR(argv[0]);
@@ -14625,6 +15852,8 @@ JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
     }
 
     alloc_size = array_len + prop_count;
+    if (js_charge_gas(ctx, GAS_COST_OP_OBJECT_KEYS, (uint64_t)alloc_size * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
 
     ret = JS_NewArray(ctx, alloc_size);
     if (JS_IsException(ret))
@@ -14642,6 +15871,7 @@ JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
         ret_arr->arr[pos++] = str;
     }
 
+    keys_hash = 2166136261u; /* FNV-1a */
     for(i = 0, j = 0; j < prop_count; i++) {
         JSProperty *pr;
         p = JS_VALUE_TO_PTR(argv[0]);
@@ -14649,6 +15879,7 @@ JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
         pr = (JSProperty *)&arr->arr[2 + hash_mask + 1 + 3 * i];
         /* exclude deleted properties */
         if (pr->key != JS_UNINITIALIZED) {
+            keys_hash = (keys_hash ^ (uint32_t)(pr->key / JSW)) * 16777619u;
             JS_PUSH_VALUE(ctx, ret);
             str = JS_ToString(ctx, pr->key);
             JS_POP_VALUE(ctx, ret);
@@ -14664,56 +15895,11 @@ JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
     pret->u.array.len = pos;
 
 #if MTPSCRIPT_DETERMINISTIC
-    /* Sort keys for canonical CBOR output (RFC 7049 §5) */
-    if (pos > 1) {
+    /* Sort keys for canonical CBOR output (RFC 7049 §3.9). The array
+       indexes alone are already in canonical order. */
+    if (prop_count > 0 && pos > 1) {
         ret_arr = JS_VALUE_TO_PTR(pret->u.array.tab);
-        /* Use insertion sort with CBOR-based comparison */
-        for (i = 1; i < pos; i++) {
-            JSValue key = ret_arr->arr[i];
-            int j = i - 1;
-
-            /* Get CBOR encoding of current key */
-            uint8_t *key_cbor_buf = NULL;
-            size_t key_cbor_len = 0;
-            uint64_t key_hash = JS_CBORSerialize(ctx, key, &key_cbor_buf, &key_cbor_len);
-            if (!key_cbor_buf) continue; /* Skip on error */
-
-            while (j >= 0) {
-                JSValue prev_key = ret_arr->arr[j];
-                uint8_t *prev_cbor_buf = NULL;
-                size_t prev_cbor_len = 0;
-                uint64_t prev_hash = JS_CBORSerialize(ctx, prev_key, &prev_cbor_buf, &prev_cbor_len);
-
-                if (!prev_cbor_buf) {
-                    j--; /* Skip on error */
-                    continue;
-                }
-
-                /* Compare CBOR encodings byte-by-byte */
-                int cmp = 0;
-                size_t min_len = key_cbor_len < prev_cbor_len ? key_cbor_len : prev_cbor_len;
-                for (size_t k = 0; k < min_len; k++) {
-                    if (key_cbor_buf[k] != prev_cbor_buf[k]) {
-                        cmp = (key_cbor_buf[k] < prev_cbor_buf[k]) ? -1 : 1;
-                        break;
-                    }
-                }
-                if (cmp == 0) {
-                    cmp = (key_cbor_len < prev_cbor_len) ? -1 : (key_cbor_len > prev_cbor_len) ? 1 : 0;
-                }
-
-                free(prev_cbor_buf);
-
-                if (cmp < 0) {
-                    ret_arr->arr[j + 1] = ret_arr->arr[j];
-                    j--;
-                } else {
-                    break;
-                }
-            }
-            free(key_cbor_buf);
-            ret_arr->arr[j + 1] = key;
-        }
+        js_sort_canonical_keys(ctx, ret_arr->arr, pos, keys_hash ^ array_len);
     }
 #endif
 
@@ -15014,6 +16200,10 @@ JSValue js_array_push(JSContext *ctx, JSValue *this_val,
     new_len = from + argc;
     if (new_len > JS_SHORTINT_MAX)
         return JS_ThrowRangeError(ctx, "invalid array length");
+    /* unshift moves the whole array */
+    if (js_charge_gas(ctx, is_unshift ? GAS_COST_OP_ARRAY_UNSHIFT : GAS_COST_OP_ARRAY_PUSH,
+                      (uint64_t)(is_unshift ? new_len : argc) * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
     new_tab = js_resize_value_array(ctx, p->u.array.tab, new_len);
     if (JS_IsException(new_tab))
         return JS_EXCEPTION;
@@ -15040,6 +16230,8 @@ JSValue js_array_pop(JSContext *ctx, JSValue *this_val,
     p = js_get_array(ctx, *this_val);
     if (!p)
         return JS_EXCEPTION;
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_POP, 0))
+        return JS_EXCEPTION;
     if (p->u.array.len > 0) {
         JSValueArray *arr = JS_VALUE_TO_PTR(p->u.array.tab);
         ret = arr->arr[--p->u.array.len];
@@ -15058,6 +16250,8 @@ JSValue js_array_shift(JSContext *ctx, JSValue *this_val,
     p = js_get_array(ctx, *this_val);
     if (!p)
         return JS_EXCEPTION;
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_SHIFT, (uint64_t)p->u.array.len * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
     if (p->u.array.len > 0) {
         JSValueArray *arr = JS_VALUE_TO_PTR(p->u.array.tab);
         ret = arr->arr[0];
@@ -15090,6 +16284,8 @@ JSValue js_array_join(JSContext *ctx, JSValue *this_val,
         if (js_get_length32(ctx, &len, *this_val))
             return JS_EXCEPTION;
     }
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_JOIN, (uint64_t)len * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
 
     if (argc > 0 && !JS_IsUndefined(argv[0])) {
         sep = JS_ToString(ctx, argv[0]);
@@ -15159,6 +16355,8 @@ JSValue js_array_reverse(JSContext *ctx, JSValue *this_val,
     if (!p)
         return JS_EXCEPTION;
     len = p->u.array.len;
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_REVERSE, (uint64_t)len * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
     arr = JS_VALUE_TO_PTR(p->u.array.tab);
     js_reverse_val(arr->arr, len);
     return *this_val;
@@ -15189,6 +16387,8 @@ JSValue js_array_concat(JSContext *ctx, JSValue *this_val,
     if (len64 > JS_SHORTINT_MAX)
         return JS_ThrowTypeError(ctx, "Array loo long");
     len = len64;
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_SLICE, (uint64_t)len * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
 
     obj = JS_NewArray(ctx, len);
     if (JS_IsException(obj))
@@ -15236,6 +16436,8 @@ JSValue js_array_indexOf(JSContext *ctx, JSValue *this_val,
     /* the array may be modified */
     p = JS_VALUE_TO_PTR(*this_val);
     len = p->u.array.len; /* the length may be modified */
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_ACCESS, (uint64_t)len * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
     arr = JS_VALUE_TO_PTR(p->u.array.tab);
     res = -1;
     if (is_lastIndexOf) {
@@ -15281,6 +16483,8 @@ JSValue js_array_slice(JSContext *ctx, JSValue *this_val,
     p = JS_VALUE_TO_PTR(*this_val);
     len = p->u.array.len; /* the length may be modified */
     final = min_int(final, len);
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_SLICE, (uint64_t)max_int(final - start, 0) * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
 
     obj = JS_NewArray(ctx, max_int(final - start, 0));
     if (JS_IsException(obj))
@@ -15324,6 +16528,8 @@ JSValue js_array_splice(JSContext *ctx, JSValue *this_val,
             return JS_EXCEPTION;
     }
     new_len = len + item_count - del_count;
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_SPLICE, (uint64_t)(len + item_count) * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
 
     obj = JS_NewArray(ctx, del_count);
     if (JS_IsException(obj))
@@ -15389,6 +16595,9 @@ JSValue js_array_every(JSContext *ctx, JSValue *this_val,
 
     if (!JS_IsFunction(ctx, *pfunc))
         return JS_ThrowTypeError(ctx, "not a function");
+    /* the callback calls are not charged by OP_call */
+    if (js_charge_gas(ctx, GAS_COST_OP_FUNC_CALL, (uint64_t)len * GAS_COST_CALL))
+        return JS_EXCEPTION;
 
     switch (special) {
     case js_special_every:
@@ -15493,6 +16702,8 @@ JSValue js_array_reduce(JSContext *ctx, JSValue *this_val,
 
     if (!JS_IsFunction(ctx, *pfunc))
         return JS_ThrowTypeError(ctx, "not a function");
+    if (js_charge_gas(ctx, GAS_COST_OP_FUNC_CALL, (uint64_t)len * GAS_COST_CALL))
+        return JS_EXCEPTION;
 
     k = 0;
     if (argc > 1) {
@@ -15688,8 +16899,12 @@ JSValue js_array_sort(JSContext *ctx, JSValue *this_val,
     if (!p)
         return JS_EXCEPTION;
 
-    /* create a temporary array for sorting */
+    /* create a temporary array for sorting. The n log2(n) comparisons
+       are charged up front. */
     len = p->u.array.len;
+    if (js_charge_gas(ctx, GAS_COST_OP_ARRAY_SORT,
+                      (uint64_t)len * (32 - clz32(len | 1)) * GAS_COST_ELEMENT))
+        return JS_EXCEPTION;
     tab = js_alloc_value_array(ctx, 0, len * 2);
     if (!tab)
         return JS_EXCEPTION;
@@ -16220,77 +17435,137 @@ JSValue js_date_constructor(JSContext *ctx, JSValue *this_val,
 }
 
 /* Decimal */
-JSValue js_decimal_compare(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+
+static JSValue js_decimal_constructor_internal(JSContext *ctx, JSValue val)
+{
+    Decimal128 a;
+    JSCStringBuf sbuf;
+    const char *str;
+    size_t len;
+    int ret;
+
+    if (JS_IsDecimal(ctx, val))
+        return val;
+    if (JS_IsInt(val)) {
+        dec128_from_int64(&a, JS_VALUE_GET_INT(val));
+        return js_new_decimal(ctx, &a);
+    }
+    if (!JS_IsString(ctx, val) && !JS_IsNumber(ctx, val))
+        return JS_ThrowTypeError(ctx, "Decimal requires a string or a number");
+    str = JS_ToCStringLen(ctx, &len, val, &sbuf);
+    if (!str)
+        return JS_EXCEPTION;
+    ret = dec128_from_string(&a, str, len);
+    if (ret)
+        return js_throw_decimal_error(ctx, ret);
+    return js_new_decimal(ctx, &a);
+}
 
 JSValue js_decimal_constructor(JSContext *ctx, JSValue *this_val,
                                int argc, JSValue *argv)
 {
     if (argc < 1)
         return JS_ThrowTypeError(ctx, "Decimal constructor requires a value string");
+    return js_decimal_constructor_internal(ctx, argv[0]);
+}
 
-    JSCStringBuf sbuf;
-    const char *str = JS_ToCString(ctx, argv[0], &sbuf);
-    if (!str)
-        return JS_EXCEPTION;
-
-    /* Parse string: significand and scale */
-    char significand[64];
-    int scale = 0;
-    int pos = 0;
-    const char *p = str;
+/* Decimal operands are never converted: mixing them with numbers is an
+   error */
+static no_inline JSValue js_decimal_arith(JSContext *ctx, OPCodeEnum op,
+                                          JSValue op1, JSValue op2)
+{
+    const Decimal128 *a, *b;
+    Decimal128 r;
+    int ret;
 
-    while (*p) {
-        if (*p == '.') {
-            p++;
-            const char *start = p;
-            while (*p >= '0' && *p <= '9') {
-                significand[pos++] = *p++;
-            }
-            scale = p - start;
-        } else if (*p >= '0' && *p <= '9') {
-            significand[pos++] = *p++;
-        } else {
-            p++;
-        }
+    if (!JS_IsDecimal(ctx, op1) || !JS_IsDecimal(ctx, op2))
+        return JS_ThrowTypeError(ctx, "cannot mix Decimal and other types");
+    a = &((JSDecimal *)JS_VALUE_TO_PTR(op1))->d;
+    b = &((JSDecimal *)JS_VALUE_TO_PTR(op2))->d;
+    switch(op) {
+    case OP_add:
+        ret = dec128_add(&r, a, b);
+        break;
+    case OP_sub:
+        ret = dec128_sub(&r, a, b);
+        break;
+    case OP_mul:
+        ret = dec128_mul(&r, a, b);
+        break;
+    case OP_div:
+        ret = dec128_div(&r, a, b);
+        break;
+    default:
+        return JS_ThrowTypeError(ctx, "unsupported Decimal operation");
     }
-    significand[pos] = '\0';
+    if (ret)
+        return js_throw_decimal_error(ctx, ret);
+    return js_new_decimal(ctx, &r);
+}
 
-    return JS_NewDecimal(ctx, significand, scale);
+static int js_this_decimal(JSContext *ctx, Decimal128 *pres, JSValue val)
+{
+    if (!JS_IsDecimal(ctx, val)) {
+        JS_ThrowTypeError(ctx, "not a Decimal");
+        return -1;
+    }
+    *pres = ((JSDecimal *)JS_VALUE_TO_PTR(val))->d;
+    return 0;
 }
 
+/* shortest canonical form (§23) */
 JSValue js_decimal_toString(JSContext *ctx, JSValue *this_val,
                             int argc, JSValue *argv)
 {
-    printf("js_decimal_toString called\n");
-    JSDecimal *d = JS_VALUE_TO_PTR(*this_val);
-    mtpscript_decimal_t dec = mtpscript_decimal_from_string(d->value);
-    dec.scale = d->scale;
-    mtpscript_string_t *str = mtpscript_decimal_to_string(dec);
-    JSValue result = JS_NewString(ctx, mtpscript_string_cstr(str));
-    mtpscript_string_free(str);
-    return result;
+    Decimal128 a;
+    char buf[DEC128_MAX_STR_LEN + 1];
+    int len;
+
+    if (js_this_decimal(ctx, &a, *this_val))
+        return JS_EXCEPTION;
+    len = js_decimal_to_cstring(buf, &a);
+    return JS_NewStringLen(ctx, buf, len);
 }
 
 JSValue js_decimal_compare(JSContext *ctx, JSValue *this_val,
                           int argc, JSValue *argv)
 {
+    Decimal128 a, b;
+
     if (argc < 1)
         return JS_ThrowTypeError(ctx, "Decimal.compare requires another decimal");
-
     if (!JS_IsDecimal(ctx, argv[0]))
         return JS_ThrowTypeError(ctx, "Argument must be a Decimal");
+    if (js_this_decimal(ctx, &a, *this_val) ||
+        js_this_decimal(ctx, &b, argv[0]))
+        return JS_EXCEPTION;
+    return JS_NewInt32(ctx, dec128_cmp(&a, &b));
+}
 
-    JSDecimal *d1 = JS_VALUE_TO_PTR(*this_val);
-    JSDecimal *d2 = JS_VALUE_TO_PTR(argv[0]);
+JSValue js_decimal_arith_method(JSContext *ctx, JSValue *this_val,
+                                int argc, JSValue *argv, int magic)
+{
+    static const uint8_t ops[] = { OP_add, OP_sub, OP_mul, OP_div };
 
-    mtpscript_decimal_t dec1 = mtpscript_decimal_from_string(d1->value);
-    dec1.scale = d1->scale;
+    if (!JS_IsDecimal(ctx, *this_val))
+        return JS_ThrowTypeError(ctx, "not a Decimal");
+    return js_decimal_arith(ctx, ops[magic], *this_val, argv[0]);
+}
 
-    mtpscript_decimal_t dec2 = mtpscript_decimal_from_string(d2->value);
-    dec2.scale = d2->scale;
+JSValue js_decimal_quantize(JSContext *ctx, JSValue *this_val,
+                            int argc, JSValue *argv)
+{
+    Decimal128 a;
+    int scale, ret;
 
-    int cmp = mtpscript_decimal_cmp(dec1, dec2);
-    return JS_NewInt32(ctx, cmp);
+    if (js_this_decimal(ctx, &a, *this_val))
+        return JS_EXCEPTION;
+    if (JS_ToInt32Clamp(ctx, &scale, argv[0], 0, DEC128_MAX_SCALE, 0))
+        return JS_EXCEPTION;
+    ret = dec128_quantize(&a, &a, scale);
+    if (ret)
+        return js_throw_decimal_error(ctx, ret);
+    return js_new_decimal(ctx, &a);
 }
 
 /* global */
@@ -16340,29 +17615,185 @@ JSValue js_json_parse(JSContext *ctx, JSValue *this_val,
     val = JS_ToString(ctx, argv[0]);
     if (JS_IsException(val))
         return val;
+    if (js_charge_gas(ctx, GAS_COST_OP_JSON_PARSE, js_gas_string_units(js_string_len(ctx, val))))
+        return JS_EXCEPTION;
     return JS_Parse2(ctx, val, NULL, 0, "<input>", JS_EVAL_JSON);
 }
 
-static int js_to_quoted_string(JSContext *ctx, StringBuffer *b, JSValue str)
+/* JSON output: either a string (JSON.stringify) or chunks passed to a
+   C callback, optionally hashed with SHA-256 on the way */
+#define JSON_CHUNK_SIZE 4096
+
+typedef struct {
+    StringBuffer b;
+    BOOL to_string; /* output to 'b' */
+    JSJSONWriteFunc *write_func; /* chunked output, may be NULL */
+    void *opaque;
+    EVP_MD_CTX *md; /* != NULL: hash of the chunked output */
+    BOOL write_error;
+    size_t len; /* output length */
+    int chunk_len;
+    uint8_t chunk[JSON_CHUNK_SIZE];
+} JSONWriter;
+
+static void json_flush(JSONWriter *w)
+{
+    if (w->chunk_len == 0)
+        return;
+    if (w->md && !EVP_DigestUpdate(w->md, w->chunk, w->chunk_len))
+        w->write_error = TRUE;
+    if (w->write_func && !w->write_error &&
+        w->write_func(w->opaque, w->chunk, w->chunk_len) < 0)
+        w->write_error = TRUE;
+    w->chunk_len = 0;
+}
+
+/* must be called before json_write() when outputting to a string. It
+   may trigger a GC */
+static int json_reserve(JSContext *ctx, JSONWriter *w, int len)
+{
+    if (!w->to_string)
+        return 0;
+    return string_buffer_reserve(ctx, &w->b, len);
+}
+
+/* no memory allocation */
+static void json_write(JSONWriter *w, const uint8_t *buf, int len)
+{
+    int n;
+
+    w->len += len;
+    if (w->to_string) {
+        StringBuffer *s = &w->b;
+        JSByteArray *arr;
+        if (JS_IsException(s->buffer))
+            return;
+        arr = JS_VALUE_TO_PTR(s->buffer);
+        memcpy(arr->buf + s->len, buf, len);
+        s->len += len;
+    } else {
+        while (len > 0) {
+            n = min_int(len, JSON_CHUNK_SIZE - w->chunk_len);
+            memcpy(w->chunk + w->chunk_len, buf, n);
+            w->chunk_len += n;
+            buf += n;
+            len -= n;
+            if (w->chunk_len == JSON_CHUNK_SIZE)
+                json_flush(w);
+        }
+    }
+}
+
+/* ASCII only */
+static void json_puts(JSContext *ctx, JSONWriter *w, const char *str)
+{
+    int len = strlen(str);
+    if (!json_reserve(ctx, w, len))
+        json_write(w, (const uint8_t *)str, len);
+}
+
+static void json_putc(JSContext *ctx, JSONWriter *w, int c)
+{
+    uint8_t ch = c;
+    if (!json_reserve(ctx, w, 1))
+        json_write(w, &ch, 1);
+}
+
+/* output the ASCII string conversion of a number or boolean */
+static int json_concat(JSContext *ctx, JSONWriter *w, JSValue val)
+{
+    JSStringCharBuf buf;
+    JSString *p;
+    JSGCRef b_ref;
+    StringBuffer *b = &w->b;
+
+    JS_PUSH_STRING_BUFFER(ctx, b);
+    val = JS_ToString(ctx, val);
+    JS_POP_STRING_BUFFER(ctx, b);
+    if (JS_IsException(val))
+        return -1;
+    p = get_string_ptr(ctx, &buf, val);
+    if (w->to_string) {
+        JSGCRef val_ref;
+        int ret;
+        JS_PUSH_VALUE(ctx, val);
+        ret = json_reserve(ctx, w, p->len);
+        JS_POP_VALUE(ctx, val);
+        if (ret)
+            return -1;
+        p = get_string_ptr(ctx, &buf, val);
+    }
+    json_write(w, p->buf, p->len);
+    return 0;
+}
+
+/* TRUE if the byte at p[i] needs no escaping in a JSON string. 'p' is
+   NUL terminated. UTF-8 sequences other than surrogates are kept as
+   is. */
+static inline BOOL json_is_plain_byte(const uint8_t *p, int i)
+{
+    int c = p[i];
+    return c >= 0x20 && c != '\"' && c != '\\' &&
+        !(c == 0xed && p[i + 1] >= 0xa0);
+}
+
+static int js_to_quoted_string(JSContext *ctx, JSONWriter *w, JSValue str)
 {
-    int i, c;
+    int i, j, len, c, extra, ret;
     JSStringCharBuf buf;
     JSString *p;
     JSGCRef str_ref;
     size_t clen;
+    char esc[7];
+
+    if (w->to_string) {
+        /* compute the output length so that the buffer is resized at
+           most once */
+        p = get_string_ptr(ctx, &buf, str);
+        len = p->len;
+        extra = 2;
+        for(i = 0; i < len; i++) {
+            c = p->buf[i];
+            if (c < 0x20) {
+                if (c == '\t' || c == '\r' || c == '\n' || c == '\b' || c == '\f')
+                    extra += 1;
+                else
+                    extra += 5;
+            } else if (c == '\"' || c == '\\') {
+                extra += 1;
+            } else if (c == 0xed && p->buf[i + 1] >= 0xa0) {
+                extra += 3;
+                i += 2;
+            }
+        }
+        if (!p->is_ascii)
+            w->b.is_ascii = FALSE;
+        JS_PUSH_VALUE(ctx, str);
+        ret = json_reserve(ctx, w, len + extra);
+        JS_POP_VALUE(ctx, str);
+        if (ret)
+            return -1;
+    }
 
-    JS_PUSH_VALUE(ctx, str);
-    string_buffer_putc(ctx, b, '\"');
-
+    /* no memory allocation from this point */
+    p = get_string_ptr(ctx, &buf, str);
+    len = p->len;
+    json_write(w, (const uint8_t *)"\"", 1);
     i = 0;
-    for(;;) {
-        /* XXX: inefficient */
-        p = get_string_ptr(ctx, &buf, str_ref.val);
-        if (i >= p->len)
-            break;
+    while (i < len) {
+        /* fast path: copy the runs which need no escaping at once */
+        j = i;
+        while (j < len && json_is_plain_byte(p->buf, j))
+            j++;
+        if (j > i) {
+            json_write(w, p->buf + i, j - i);
+            i = j;
+            if (i >= len)
+                break;
+        }
+
         c = utf8_get(p->buf + i, &clen);
         i += clen;
-
         switch(c) {
         case '\t':
             c = 't';
@@ -16382,22 +17813,18 @@ static int js_to_quoted_string(JSContext *ctx, StringBuffer *b, JSValue str)
         case '\"':
         case '\\':
         quote:
-            string_buffer_putc(ctx, b, '\\');
-            string_buffer_putc(ctx, b, c);
+            esc[0] = '\\';
+            esc[1] = c;
+            json_write(w, (const uint8_t *)esc, 2);
             break;
         default:
-            if (c < 32 || (c >= 0xd800 && c < 0xe000)) {
-                char buf[7];
-                js_snprintf(buf, sizeof(buf), "\\u%04x", c);
-                string_buffer_puts(ctx, b, buf);
-            } else {
-                string_buffer_putc(ctx, b, c);
-            }
+            /* control character or surrogate */
+            js_snprintf(esc, sizeof(esc), "\\u%04x", c);
+            json_write(w, (const uint8_t *)esc, 6);
             break;
         }
     }
-    string_buffer_putc(ctx, b, '\"');
-    JS_POP_VALUE(ctx, str);
+    json_write(w, (const uint8_t *)"\"", 1);
     return 0;
 }
 
@@ -16416,27 +17843,13 @@ static int check_circular_ref(JSContext *ctx, JSValue *stack_top, JSValue val)
 }
 
 /* XXX: no space nor replacer */
-JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
-                          int argc, JSValue *argv)
+static int js_json_write(JSContext *ctx, JSONWriter *w, JSValue val0)
 {
     JSValue obj, *stack_top;
-    StringBuffer b_s, *b = &b_s;
+    StringBuffer *b = &w->b;
     JSGCRef b_ref;
     int idx, ret;
 
-#if 0
-    if (JS_IsNumber(ctx, *pspace)) {
-        int n;
-        if (JS_ToInt32Clamp(ctx, &n, *pspace, 0, 10, 0))
-            return JS_EXCEPTION;
-        *pspace = JS_NewStringLen(ctx, "          ", n);
-    } else if (JS_IsString(ctx, *pspace)) {
-        *pspace = js_sub_string(ctx, *pspace, 0, 10);
-    } else {
-        *pspace = js_get_atom(ctx, JS_ATOM_empty);
-    }
-#endif
-    string_buffer_init(ctx, b, 0);
     stack_top = ctx->sp;
 
     /* XXX: could push the string buffer once */
@@ -16447,7 +17860,7 @@ JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
         goto fail;
     *--ctx->sp = JS_NULL; /* keys */
     *--ctx->sp = JS_NewShortInt(0); /* prop index */
-    *--ctx->sp = argv[0]; /* object */
+    *--ctx->sp = val0; /* object */
 
     while (ctx->sp < stack_top) {
         obj = ctx->sp[0];
@@ -16462,15 +17875,15 @@ JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
 
                 /* array */
                 if (idx == 0)
-                    string_buffer_putc(ctx, b, '[');
+                    json_putc(ctx, w, '[');
                 p = JS_VALUE_TO_PTR(ctx->sp[0]);
                 if (idx >= p->u.array.len) {
                     /* end of array */
-                    string_buffer_putc(ctx, b, ']');
+                    json_putc(ctx, w, ']');
                     ctx->sp += JSON_REC_SIZE;
                 } else {
                     if (idx != 0)
-                        string_buffer_putc(ctx, b, ',');
+                        json_putc(ctx, w, ',');
                     ctx->sp[1] = JS_NewShortInt(idx + 1);
                     JS_PUSH_STRING_BUFFER(ctx, b);
                     ret = JS_StackCheck(ctx, JSON_REC_SIZE);
@@ -16494,8 +17907,10 @@ JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
 
                 /* object */
                 if (idx == 0) {
-                    string_buffer_putc(ctx, b, '{');
+                    json_putc(ctx, w, '{');
+                    JS_PUSH_STRING_BUFFER(ctx, b);
                     ctx->sp[2] = js_object_keys(ctx, NULL, 1, &ctx->sp[0]);
+                    JS_POP_STRING_BUFFER(ctx, b);
                     if (JS_IsException(ctx->sp[2]))
                         goto fail;
                 }
@@ -16504,7 +17919,7 @@ JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
                     p = JS_VALUE_TO_PTR(ctx->sp[2]); /* keys */
                     if (idx >= p->u.array.len) {
                         /* end of object */
-                        string_buffer_putc(ctx, b, '}');
+                        json_putc(ctx, w, '}');
                         ctx->sp += JSON_REC_SIZE;
                         goto end_obj;
                     } else {
@@ -16522,18 +17937,18 @@ JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
                     }
                 }
                 if (saved_idx != 0)
-                    string_buffer_putc(ctx, b, ',');
+                    json_putc(ctx, w, ',');
                 ctx->sp[1] = JS_NewShortInt(idx + 1);
                 p = JS_VALUE_TO_PTR(ctx->sp[2]);
                 arr = JS_VALUE_TO_PTR(p->u.array.tab);
                 JS_PUSH_VALUE(ctx, val);
-                ret = js_to_quoted_string(ctx, b, arr->arr[idx]);
+                ret = js_to_quoted_string(ctx, w, arr->arr[idx]);
                 JS_POP_VALUE(ctx, val);
                 if (ret)
                     goto fail;
-                string_buffer_putc(ctx, b, ':');
-
                 JS_PUSH_VALUE(ctx, val);
+                json_putc(ctx, w, ':');
+
                 JS_PUSH_STRING_BUFFER(ctx, b);
                 ret = JS_StackCheck(ctx, JSON_REC_SIZE);
                 JS_POP_STRING_BUFFER(ctx, b);
@@ -16559,24 +17974,86 @@ JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
             goto to_string;
         } else if (JS_IsBool(obj)) {
         to_string:
-            if (string_buffer_concat(ctx, b, obj))
+            if (json_concat(ctx, w, obj))
                 goto fail;
             ctx->sp += JSON_REC_SIZE;
         } else if (JS_IsString(ctx, obj)) {
-            if (js_to_quoted_string(ctx, b, obj))
+            if (js_to_quoted_string(ctx, w, obj))
                 goto fail;
             ctx->sp += JSON_REC_SIZE;
+        } else if (JS_IsDecimal(ctx, obj)) {
+            /* same string as in the CBOR encoding */
+            char buf[DEC128_MAX_STR_LEN + 1];
+            js_decimal_to_cstring(buf, &((JSDecimal *)JS_VALUE_TO_PTR(obj))->d);
+            json_putc(ctx, w, '"');
+            json_puts(ctx, w, buf);
+            json_putc(ctx, w, '"');
+            ctx->sp += JSON_REC_SIZE;
         } else {
         output_null:
-            string_buffer_concat(ctx, b, js_get_atom(ctx, JS_ATOM_null));
+            json_puts(ctx, w, "null");
             ctx->sp += JSON_REC_SIZE;
         }
     }
-    return string_buffer_end(ctx, b);
+    if (w->to_string && JS_IsException(b->buffer))
+        return -1;
+    return js_charge_gas(ctx, GAS_COST_OP_JSON_STRINGIFY, js_gas_string_units(w->len));
 
  fail:
     ctx->sp = stack_top;
-    return JS_EXCEPTION;
+    return -1;
+}
+
+JSValue js_json_stringify(JSContext *ctx, JSValue *this_val,
+                          int argc, JSValue *argv)
+{
+    JSONWriter w_s, *w = &w_s;
+
+    w->to_string = TRUE;
+    w->len = 0;
+    string_buffer_init(ctx, &w->b, 0);
+    if (js_json_write(ctx, w, argv[0]))
+        return JS_EXCEPTION;
+    return string_buffer_end(ctx, &w->b);
+}
+
+/* Canonical JSON writer: same output as JSON.stringify() without
+   building the string */
+int JS_JSONWrite(JSContext *ctx, JSValue val, JSJSONWriteFunc *write_func,
+                 void *opaque, uint8_t out_hash[32])
+{
+    JSONWriter w_s, *w = &w_s;
+    int ret;
+
+    w->to_string = FALSE;
+    string_buffer_init(ctx, &w->b, 0);
+    w->write_func = write_func;
+    w->opaque = opaque;
+    w->md = NULL;
+    w->write_error = FALSE;
+    w->len = 0;
+    w->chunk_len = 0;
+    if (out_hash) {
+        w->md = EVP_MD_CTX_new();
+        if (!w->md || !EVP_DigestInit_ex(w->md, EVP_sha256(), NULL)) {
+            EVP_MD_CTX_free(w->md);
+            JS_ThrowOutOfMemory(ctx);
+            return -1;
+        }
+    }
+
+    ret = js_json_write(ctx, w, val);
+    if (!ret) {
+        json_flush(w);
+        if (w->md && !EVP_DigestFinal_ex(w->md, out_hash, NULL))
+            w->write_error = TRUE;
+        if (w->write_error) {
+            JS_ThrowInternalError(ctx, "JSON output error");
+            ret = -1;
+        }
+    }
+    EVP_MD_CTX_free(w->md);
+    return ret;
 }
 
 /**********************************************************************/
@@ -18886,6 +20363,8 @@ JSValue js_string_replace(JSContext *ctx, JSValue *this_val,
     *this_val = JS_ToString(ctx, *this_val);
     if (JS_IsException(*this_val))
         return JS_EXCEPTION;
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_REPLACE, js_gas_string_units(js_string_len(ctx, *this_val))))
+        return JS_EXCEPTION;
     is_regexp = (JS_GetClassID(ctx, argv[0]) == JS_CLASS_REGEXP);
     if (!is_regexp) {
         argv[0] = JS_ToString(ctx, argv[0]);
@@ -19034,6 +20513,8 @@ JSValue js_string_split(JSContext *ctx, JSValue *this_val,
     *this_val = JS_ToString(ctx, *this_val);
     if (JS_IsException(*this_val))
         return JS_EXCEPTION;
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_SPLIT, js_gas_string_units(js_string_len(ctx, *this_val))))
+        return JS_EXCEPTION;
     if (JS_IsUndefined(argv[1])) {
         lim = 0xffffffff;
     } else {
@@ -19191,6 +20672,11 @@ JSValue js_string_match(JSContext *ctx, JSValue *this_val,
     JSByteArray *barr;
     JSGCRef A_ref, result_ref;
 
+    *this_val = JS_ToString(ctx, *this_val);
+    if (JS_IsException(*this_val))
+        return JS_EXCEPTION;
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_MATCH, js_gas_string_units(js_string_len(ctx, *this_val))))
+        return JS_EXCEPTION;
     re = js_get_regexp(ctx, argv[0]);
     if (!re)
         return JS_EXCEPTION;
@@ -19236,5 +20722,10 @@ JSValue js_string_match(JSContext *ctx, JSValue *this_val,
 JSValue js_string_search(JSContext *ctx, JSValue *this_val,
                          int argc, JSValue *argv)
 {
+    *this_val = JS_ToString(ctx, *this_val);
+    if (JS_IsException(*this_val))
+        return JS_EXCEPTION;
+    if (js_charge_gas(ctx, GAS_COST_OP_STR_SEARCH, js_gas_string_units(js_string_len(ctx, *this_val))))
+        return JS_EXCEPTION;
     return js_regexp_exec(ctx, &argv[0], 1, this_val, MAGIC_REGEXP_SEARCH);
 }
@@ -266,6 +266,16 @@ JSContext *JS_NewContext(void *mem_start, size_t mem_size, const JSSTDLibraryDef
    the embedded version */
 JSContext *JS_NewContext2(void *mem_start, size_t mem_size, const JSSTDLibraryDef *stdlib_def, JS_BOOL prepare_compilation);
 JSContext *JS_CloneContext(JSContext *ctx, void *mem_start, size_t mem_size);
+/* Copy-on-write context images (Linux only, NULL otherwise): 'ctx' is
+   frozen into a sealed memory file relocated for a reserved arena of
+   'mem_size' bytes. A clone maps it MAP_PRIVATE so only the written
+   pages are copied. At most one clone per image can be live; it is
+   released with JS_FreeContext() and JS_SecureWipe() resets it to the
+   image state. */
+typedef struct JSContextImage JSContextImage;
+JSContextImage *JS_NewContextImage(JSContext *ctx, size_t mem_size);
+JSContext *JS_CloneContextImage(JSContextImage *img);
+void JS_FreeContextImage(JSContextImage *img);
 void JS_FreeContext(JSContext *ctx);
 void JS_SecureWipe(JSContext *ctx);
 void JS_SetContextOpaque(JSContext *ctx, void *opaque);
@@ -273,6 +283,7 @@ void *JS_GetContextOpaque(JSContext *ctx);
 void JS_SetInterruptHandler(JSContext *ctx, JSInterruptHandler *interrupt_handler);
 void JS_SetRandomSeed(JSContext *ctx, const uint8_t *seed, size_t seed_len);
 void JS_SetGasLimit(JSContext *ctx, uint64_t limit);
+uint64_t JS_GetGasUsed(JSContext *ctx);
 JSValue JS_GetGlobalObject(JSContext *ctx);
 JSValue JS_Throw(JSContext *ctx, JSValue obj);
 JSValue __js_printf_like(3, 4) JS_ThrowError(JSContext *ctx, JSObjectClassEnum error_num,
@@ -307,6 +318,19 @@ JSValue JS_Run(JSContext *ctx, JSValue val);
 JSValue JS_Eval(JSContext *ctx, const char *input, size_t input_len,
                 const char *filename, int eval_flags);
 void JS_GC(JSContext *ctx);
+void JS_FreezeHeap(JSContext *ctx);
+void JS_SetHeapLimit(JSContext *ctx, size_t initial_size, size_t max_size);
+
+typedef struct {
+    size_t heap_size; /* current heap size in bytes */
+    size_t heap_peak; /* largest heap size, sampled before each GC */
+    size_t stack_peak; /* largest stack size */
+    size_t heap_limit; /* current soft limit (see JS_SetHeapLimit()) */
+    size_t arena_peak; /* smallest 'mem_size' that fits the peaks */
+    uint32_t gc_count; /* GCs since the creation or the clone */
+} JSMemoryUsage;
+
+void JS_GetMemoryUsage(JSContext *ctx, JSMemoryUsage *s);
 JSValue JS_NewStringLen(JSContext *ctx, const char *buf, size_t buf_len);
 JSValue JS_NewString(JSContext *ctx, const char *buf);
 const char *JS_ToCStringLen(JSContext *ctx, size_t *plen, JSValue val, JSCStringBuf *buf);
@@ -369,7 +393,37 @@ int JS_RelocateBytecode(JSContext *ctx,
    it. warning: the bytecode is not checked so it should come from a
    trusted source. */
 JSValue JS_LoadBytecode(JSContext *ctx, const uint8_t *buf);
-JSValue JS_LoadSnapshot(JSContext *ctx, const uint8_t *snapshot_data, size_t snapshot_len,
+/* Heap images: a context and its compacted heap saved after the
+   static initialization of a program. Loading one restores the
+   globals without running any code. The image depends on the word
+   size and on the stdlib. */
+#define JS_HEAP_IMAGE_MAGIC 0xacfc
+
+typedef struct {
+    uint16_t magic; /* JS_HEAP_IMAGE_MAGIC */
+    uint16_t version;
+    uint32_t stdlib_checksum;
+    uint32_t data_len; /* context and heap */
+    uint32_t rom_len; /* stdlib table */
+} JSHeapImageHeader;
+
+/* only used on the host. Run a GC and save 'ctx' (header followed by
+   the data) to a malloc'ed buffer. 'ctx' must have been created with
+   'stdlib_def', have no running code, no loaded bytecode and no user
+   class objects. Return 0 if OK, != 0 if error. */
+int JS_SaveHeapImage(JSContext *ctx, const JSSTDLibraryDef *stdlib_def,
+                     uint8_t **pbuf, size_t *pbuf_len);
+JS_BOOL JS_IsHeapImage(const uint8_t *buf, size_t buf_len);
+/* Create a context in 'mem_start' from the image in 'buf'. 'buf' is
+   not referenced after the call. Return NULL if the image does not
+   match the word size or 'stdlib_def', or if 'mem_size' is too
+   small. */
+JSContext *JS_LoadHeapImage(void *mem_start, size_t mem_size,
+                            const JSSTDLibraryDef *stdlib_def,
+                            const uint8_t *buf, size_t buf_len);
+/* Verify the signature of the bytecode in 'snapshot_data', then
+   relocate it in place and load it as JS_LoadBytecode() */
+JSValue JS_LoadSnapshot(JSContext *ctx, uint8_t *snapshot_data, size_t snapshot_len,
                         const uint8_t *signature_data, size_t sig_len);
 typedef JSValue (*JSEffectHandler)(JSContext *ctx, const uint8_t *seed, size_t seed_len,
                                    JSValue args);
@@ -397,6 +451,15 @@ uint64_t JS_CBORSerialize(JSContext *ctx, JSValue val, uint8_t **out_buf, size_t
 
 /* JSON hashing functions */
 JS_BOOL JS_JSONHash(JSContext *ctx, JSValue val, uint8_t out_hash[32]);
+/* Return 0 if OK, -1 to abort the output. Must not call the engine. */
+typedef int JSJSONWriteFunc(void *opaque, const uint8_t *buf, size_t len);
+/* Write the canonical JSON of 'val' in chunks to 'write_func' (may be
+   NULL) and store its SHA-256 in 'out_hash' (may be NULL), in one pass
+   without building the string. Return 0 if OK, -1 if exception. */
+int JS_JSONWrite(JSContext *ctx, JSValue val, JSJSONWriteFunc *write_func,
+                 void *opaque, uint8_t out_hash[32]);
+/* canonical JSON text of 'val' (the serialization hashed by JS_JSONHash) */
+JSValue JS_JSONStringify(JSContext *ctx, JSValue val);
 
 /* debug functions */
 void JS_SetLogFunc(JSContext *ctx, JSWriteFunc *write_func);
@@ -127,6 +127,7 @@ DEF(           goto, 5, 0, 0, label) /* must come after if_true */
 DEF(          catch, 5, 0, 1, label)
 DEF(          gosub, 5, 0, 0, label) /* used to execute the finally block */
 DEF(            ret, 1, 1, 0, none) /* used to return from the finally block */
+DEF(            gas, 3, 0, 0, u16) /* charge the gas of the basic block it starts */
 
 DEF(   for_in_start, 1, 1, 1, none) /* obj -> iter */
 DEF(   for_of_start, 1, 1, 1, none) /* obj -> iter */
@@ -51,8 +51,9 @@ enum {
     JS_MTAG_COUNT,
 };
 
-/* JS_MTAG_BITS bits are reserved at the start of every memory block */
-#define JS_MTAG_BITS 4
+/* JS_MTAG_BITS bits are reserved at the start of every memory block
+   (gc_mark + mtag: must hold JS_MTAG_COUNT - 1) */
+#define JS_MTAG_BITS 5
 
 #define JS_MB_HEADER \
     JSWord gc_mark: 1; \
@@ -257,6 +258,16 @@ JSValue js_decimal_toString(JSContext *ctx, JSValue *this_val,
                             int argc, JSValue *argv);
 JSValue js_decimal_compare(JSContext *ctx, JSValue *this_val,
                           int argc, JSValue *argv);
+enum {
+    magic_decimal_add,
+    magic_decimal_sub,
+    magic_decimal_mul,
+    magic_decimal_div,
+};
+JSValue js_decimal_arith_method(JSContext *ctx, JSValue *this_val,
+                                int argc, JSValue *argv, int magic);
+JSValue js_decimal_quantize(JSContext *ctx, JSValue *this_val,
+                            int argc, JSValue *argv);
 int js_structural_eq(JSContext *ctx, JSValue op1, JSValue op2);
 
 JSValue js_global_eval(JSContext *ctx, JSValue *this_val,
@@ -284,4 +295,10 @@ JSValue js_regexp_get_flags(JSContext *ctx, JSValue *this_val,
 JSValue js_regexp_exec(JSContext *ctx, JSValue *this_val,
                        int argc, JSValue *argv, int is_test);
 
+/* Async effect (mquickjs_effects.c) */
+JSValue js_async_await(JSContext *ctx, JSValue *this_val,
+                       int argc, JSValue *argv);
+JSValue js_async_await_all(JSContext *ctx, JSValue *this_val,
+                           int argc, JSValue *argv);
+
 #endif /* MICROJS_PRIV_H */
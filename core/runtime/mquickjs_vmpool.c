@@ -0,0 +1,248 @@
+/*
+ * MTPScript VM Pool Implementation
+ * Specification §5.2 - Per-request VM cloning
+ */
+
+#include "mquickjs_vmpool.h"
+#include "mquickjs_db.h"
+#include "mquickjs_http.h"
+#include "mquickjs_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+typedef enum {
+    VM_SLOT_EMPTY,   // Wiped, needs a fresh clone
+    VM_SLOT_READY,   // Cloned, effects registered, gas set
+    VM_SLOT_IN_USE,  // Handed out to a request
+} MTPScriptVMSlotState;
+
+typedef struct {
+    MTPScriptVMSlotState state;
+    JSContext *ctx;
+    JSContextImage *image;  // Copy-on-write source, NULL if 'mem' is used
+    uint8_t *mem;           // Reserved arena for JS_CloneContext
+} MTPScriptVMSlot;
+
+struct MTPScriptVMPool {
+    MTPScriptVMPoolConfig config;
+    JSContext *template_ctx;
+    MTPScriptVMSlot *slots;
+    int *ready;             // Stack of ready slot indexes
+    int ready_count;
+    int in_use;
+    MTPScriptVMPoolStats stats;
+};
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Initialize pool configuration with defaults
+void mtpscript_vm_pool_config_init(MTPScriptVMPoolConfig *config) {
+    memset(config, 0, sizeof(*config));
+    config->size = MTPSCRIPT_VM_POOL_DEFAULT_SIZE;
+    config->low_water = MTPSCRIPT_VM_POOL_DEFAULT_LOW_WATER;
+    config->mem_size = MTPSCRIPT_VM_POOL_DEFAULT_MEM_SIZE;
+    config->heap_limit = MTPSCRIPT_VM_POOL_DEFAULT_HEAP_LIMIT;
+    config->use_images = true;
+}
+
+// Default VM initialization: register the standard effects
+void mtpscript_vm_pool_register_effects(JSContext *ctx, void *opaque) {
+    mtpscript_db_register_effects(ctx);
+    mtpscript_http_register_effects(ctx);
+    mtpscript_log_register_effects(ctx);
+}
+
+// Clone, initialize and queue one slot
+static int vm_slot_prepare(MTPScriptVMPool *pool, int idx) {
+    MTPScriptVMSlot *slot = &pool->slots[idx];
+    uint64_t start = get_time_ns(), elapsed;
+    JSContext *ctx;
+
+    if (slot->image) {
+        ctx = JS_CloneContextImage(slot->image);
+    } else {
+        ctx = JS_CloneContext(pool->template_ctx, slot->mem, pool->config.mem_size);
+    }
+    if (!ctx) {
+        pool->stats.clone_failures++;
+        return -1;
+    }
+
+    if (pool->config.init_vm) {
+        pool->config.init_vm(ctx, pool->config.init_opaque);
+    } else {
+        mtpscript_vm_pool_register_effects(ctx, NULL);
+    }
+    JS_SetGasLimit(ctx, pool->config.gas_limit);
+    // The clone is discarded after one request: the snapshot heap is
+    // frozen so that a GC, if any, only collects the request objects
+    JS_FreezeHeap(ctx);
+    // Only the pages below the soft limit are touched until a request
+    // needs more, so the arena can be sized for the worst case
+    JS_SetHeapLimit(ctx, pool->config.heap_limit, pool->config.max_heap_size);
+
+    slot->ctx = ctx;
+    slot->state = VM_SLOT_READY;
+    pool->ready[pool->ready_count++] = idx;
+
+    elapsed = get_time_ns() - start;
+    pool->stats.refill_time_ns += elapsed;
+    if (elapsed > pool->stats.refill_max_ns) {
+        pool->stats.refill_max_ns = elapsed;
+    }
+    return 0;
+}
+
+static int vm_pool_find_empty(MTPScriptVMPool *pool) {
+    for (int i = 0; i < pool->config.size; i++) {
+        if (pool->slots[i].state == VM_SLOT_EMPTY) return i;
+    }
+    return -1;
+}
+
+// Create a pool cloning 'template_ctx'
+MTPScriptVMPool *mtpscript_vm_pool_new(JSContext *template_ctx, const MTPScriptVMPoolConfig *config) {
+    MTPScriptVMPool *pool = calloc(1, sizeof(MTPScriptVMPool));
+    if (!pool) return NULL;
+
+    if (config) {
+        pool->config = *config;
+    } else {
+        mtpscript_vm_pool_config_init(&pool->config);
+    }
+    if (pool->config.size <= 0) pool->config.size = MTPSCRIPT_VM_POOL_DEFAULT_SIZE;
+    if (pool->config.low_water > pool->config.size) pool->config.low_water = pool->config.size;
+    if (pool->config.mem_size == 0) pool->config.mem_size = MTPSCRIPT_VM_POOL_DEFAULT_MEM_SIZE;
+    pool->template_ctx = template_ctx;
+
+    pool->slots = calloc(pool->config.size, sizeof(MTPScriptVMSlot));
+    pool->ready = calloc(pool->config.size, sizeof(int));
+    if (!pool->slots || !pool->ready) goto fail;
+
+    for (int i = 0; i < pool->config.size; i++) {
+        MTPScriptVMSlot *slot = &pool->slots[i];
+        slot->state = VM_SLOT_EMPTY;
+        if (pool->config.use_images) {
+            slot->image = JS_NewContextImage(template_ctx, pool->config.mem_size);
+        }
+        if (!slot->image) {
+            // Pages are committed when first written
+            void *mem = mmap(NULL, pool->config.mem_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (mem == MAP_FAILED) goto fail;
+            slot->mem = mem;
+        }
+    }
+
+    // Warm the whole pool before serving
+    for (int i = 0; i < pool->config.size; i++) {
+        if (vm_slot_prepare(pool, i) == 0) {
+            pool->stats.refills++;
+        }
+    }
+    return pool;
+
+fail:
+    mtpscript_vm_pool_free(pool);
+    return NULL;
+}
+
+void mtpscript_vm_pool_free(MTPScriptVMPool *pool) {
+    if (!pool) return;
+
+    if (pool->slots) {
+        for (int i = 0; i < pool->config.size; i++) {
+            MTPScriptVMSlot *slot = &pool->slots[i];
+            if (slot->state != VM_SLOT_EMPTY && slot->ctx) {
+                JS_FreeContext(slot->ctx);
+            }
+            JS_FreeContextImage(slot->image);
+            if (slot->mem) munmap(slot->mem, pool->config.mem_size);
+        }
+        free(pool->slots);
+    }
+    free(pool->ready);
+    free(pool);
+}
+
+// Get a ready VM
+JSContext *mtpscript_vm_pool_acquire(MTPScriptVMPool *pool) {
+    int idx;
+
+    if (pool->ready_count > 0) {
+        idx = pool->ready[--pool->ready_count];
+        pool->stats.hits++;
+    } else {
+        // Miss: clone on the request path
+        idx = vm_pool_find_empty(pool);
+        if (idx < 0 || vm_slot_prepare(pool, idx) != 0) return NULL;
+        pool->ready_count--;
+        pool->stats.misses++;
+    }
+
+    pool->slots[idx].state = VM_SLOT_IN_USE;
+    pool->in_use++;
+    return pool->slots[idx].ctx;
+}
+
+// Zero a reserved arena whose pages could not be dropped
+static void vm_pool_wipe(uint8_t *mem, size_t size) {
+    memset(mem, 0, size);
+    // Prevent compiler optimization
+    __asm__ __volatile__("" : : "r"(mem) : "memory");
+}
+
+// Give a VM back: wipe its arena and queue it for refill
+bool mtpscript_vm_pool_release(MTPScriptVMPool *pool, JSContext *ctx) {
+    for (int i = 0; i < pool->config.size; i++) {
+        MTPScriptVMSlot *slot = &pool->slots[i];
+        if (slot->state != VM_SLOT_IN_USE || slot->ctx != ctx) continue;
+
+        // Runs the finalizers and frees the effect registry. An image
+        // backed VM drops its private pages, which wipes it. The pages
+        // of a reserved arena are dropped too: they read as zero again
+        // and are no longer committed.
+        JS_FreeContext(ctx);
+        if (!slot->image && madvise(slot->mem, pool->config.mem_size, MADV_DONTNEED) != 0) {
+            vm_pool_wipe(slot->mem, pool->config.mem_size);
+        }
+        slot->ctx = NULL;
+        slot->state = VM_SLOT_EMPTY;
+        pool->in_use--;
+        return true;
+    }
+    // Not handed out by this pool, or already released
+    pool->stats.release_failures++;
+    return false;
+}
+
+bool mtpscript_vm_pool_needs_refill(MTPScriptVMPool *pool) {
+    return pool->ready_count < pool->config.low_water &&
+           pool->ready_count + pool->in_use < pool->config.size;
+}
+
+// Prepare wiped VMs once the ready count is below the low-water mark
+int mtpscript_vm_pool_refill(MTPScriptVMPool *pool) {
+    int count = 0, idx;
+
+    if (!mtpscript_vm_pool_needs_refill(pool)) return 0;
+
+    while ((idx = vm_pool_find_empty(pool)) >= 0) {
+        if (vm_slot_prepare(pool, idx) != 0) break;
+        pool->stats.refills++;
+        count++;
+    }
+    return count;
+}
+
+void mtpscript_vm_pool_get_stats(MTPScriptVMPool *pool, MTPScriptVMPoolStats *stats) {
+    *stats = pool->stats;
+    stats->ready = pool->ready_count;
+    stats->in_use = pool->in_use;
+}
@@ -0,0 +1,84 @@
+/*
+ * MTPScript VM Pool
+ * Specification §5.2 - Per-request VM cloning
+ *
+ * A per-worker pool of warm VMs cloned from a snapshot context. Clone,
+ * effect registration and gas setup happen off the request path; a
+ * request only pops a ready VM and gives it back when it is done.
+ */
+
+#ifndef MQUICKJS_VMPOOL_H
+#define MQUICKJS_VMPOOL_H
+
+#include "mquickjs.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Default pool sizing
+#define MTPSCRIPT_VM_POOL_DEFAULT_SIZE      8
+#define MTPSCRIPT_VM_POOL_DEFAULT_LOW_WATER 2
+#define MTPSCRIPT_VM_POOL_DEFAULT_MEM_SIZE  (16 * 1024 * 1024)
+#define MTPSCRIPT_VM_POOL_DEFAULT_HEAP_LIMIT (1024 * 1024)
+
+// Called on every fresh clone before it is handed out (effect registration)
+typedef void MTPScriptVMInitFunc(JSContext *ctx, void *opaque);
+
+// Pool configuration
+typedef struct {
+    int size;                    // Number of VM slots
+    int low_water;               // Refill when fewer ready VMs remain
+    size_t mem_size;             // Arena size of each VM (reserved, committed on use)
+    size_t heap_limit;           // Initial soft limit of the request heap (0 = none)
+    size_t max_heap_size;        // Hard heap budget of each VM (0 = the arena)
+    uint64_t gas_limit;          // Gas limit preset on each VM (0 = default)
+    bool use_images;             // Copy-on-write clones when supported
+    MTPScriptVMInitFunc *init_vm; // NULL = register DbRead/DbWrite/HttpOut/Log
+    void *init_opaque;
+} MTPScriptVMPoolConfig;
+
+// Pool metrics
+typedef struct {
+    uint64_t hits;               // Acquired a ready VM
+    uint64_t misses;             // Had to clone on the request path
+    uint64_t refills;            // VMs prepared by mtpscript_vm_pool_refill
+    uint64_t clone_failures;
+    uint64_t release_failures;   // Releases of VMs not in use from this pool
+    uint64_t refill_time_ns;     // Total time spent preparing VMs
+    uint64_t refill_max_ns;      // Slowest single VM preparation
+    int ready;                   // Ready VMs right now
+    int in_use;                  // VMs currently handed out
+} MTPScriptVMPoolStats;
+
+typedef struct MTPScriptVMPool MTPScriptVMPool;
+
+// Initialize pool configuration with defaults
+void mtpscript_vm_pool_config_init(MTPScriptVMPoolConfig *config);
+
+// Create a pool cloning 'template_ctx', which must outlive the pool and
+// must not run code while the pool exists. The pool is filled up to
+// 'size' before returning. Not thread safe: one pool per worker.
+MTPScriptVMPool *mtpscript_vm_pool_new(JSContext *template_ctx, const MTPScriptVMPoolConfig *config);
+void mtpscript_vm_pool_free(MTPScriptVMPool *pool);
+
+// Get a ready VM (NULL if all the slots are in use)
+JSContext *mtpscript_vm_pool_acquire(MTPScriptVMPool *pool);
+
+// Give a VM back: its arena is wiped and queued for refill. Return false,
+// and count a release failure, if 'ctx' is not in use from this pool.
+bool mtpscript_vm_pool_release(MTPScriptVMPool *pool, JSContext *ctx);
+
+// Prepare wiped VMs when the ready count is below the low-water mark.
+// Call it off the request path (e.g. when the event loop is idle).
+// Return the number of VMs prepared.
+int mtpscript_vm_pool_refill(MTPScriptVMPool *pool);
+
+// True if mtpscript_vm_pool_refill has work to do
+bool mtpscript_vm_pool_needs_refill(MTPScriptVMPool *pool);
+
+void mtpscript_vm_pool_get_stats(MTPScriptVMPool *pool, MTPScriptVMPoolStats *stats);
+
+// Default VM initialization: register the standard effects
+void mtpscript_vm_pool_register_effects(JSContext *ctx, void *opaque);
+
+#endif /* MQUICKJS_VMPOOL_H */
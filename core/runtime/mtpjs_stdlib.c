@@ -322,6 +322,11 @@ static const JSClassDef js_date_class =
 static const JSPropDef js_decimal_proto[] = {
     JS_CFUNC_DEF("toString", 0, js_decimal_toString),
     JS_CFUNC_DEF("compare", 1, js_decimal_compare),
+    JS_CFUNC_MAGIC_DEF("add", 1, js_decimal_arith_method, magic_decimal_add ),
+    JS_CFUNC_MAGIC_DEF("sub", 1, js_decimal_arith_method, magic_decimal_sub ),
+    JS_CFUNC_MAGIC_DEF("mul", 1, js_decimal_arith_method, magic_decimal_mul ),
+    JS_CFUNC_MAGIC_DEF("div", 1, js_decimal_arith_method, magic_decimal_div ),
+    JS_CFUNC_DEF("quantize", 1, js_decimal_quantize),
     JS_PROP_END,
 };
 
@@ -349,6 +354,16 @@ static const JSPropDef js_performance[] = {
 static const JSClassDef js_performance_obj =
     JS_OBJECT_DEF("Performance", js_performance);
 
+/* Async effect (§7-a): the compiled 'await' expressions */
+static const JSPropDef js_async[] = {
+    JS_CFUNC_DEF("await", 3, js_async_await),
+    JS_CFUNC_DEF("awaitAll", 1, js_async_await_all),
+    JS_PROP_END,
+};
+
+static const JSClassDef js_async_obj =
+    JS_OBJECT_DEF("Async", js_async);
+
 static const JSPropDef js_global_object[] = {
     JS_PROP_CLASS_DEF("Object", &js_object_class),
     JS_PROP_CLASS_DEF("Function", &js_function_class),
@@ -402,6 +417,7 @@ static const JSPropDef js_global_object[] = {
 
     JS_PROP_CLASS_DEF("console", &js_console_obj),
     JS_PROP_CLASS_DEF("performance", &js_performance_obj),
+    JS_PROP_CLASS_DEF("Async", &js_async_obj),
     JS_CFUNC_DEF("print", 1, js_print),
 #ifdef CONFIG_CLASS_EXAMPLE
     JS_PROP_CLASS_DEF("Rectangle", &js_rectangle_class),
@@ -364,172 +364,191 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   0x006c616d69636544,
   (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "compare" (offset=358) */
   0x00657261706d6f63,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "JSON" (offset=360) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "add" (offset=360) */
+  0x0000000000646461,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "sub" (offset=362) */
+  0x0000000000627573,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "mul" (offset=364) */
+  0x00000000006c756d,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "div" (offset=366) */
+  0x0000000000766964,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "quantize" (offset=368) */
+  0x657a69746e617571,
+  0x0000000000000000,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "JSON" (offset=371) */
   0x000000004e4f534a,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "parse" (offset=362) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "parse" (offset=373) */
   0x0000006573726170,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "stringify" (offset=364) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "stringify" (offset=375) */
   0x6669676e69727473,
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "RegExp" (offset=367) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "RegExp" (offset=378) */
   0x0000707845676552,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "lastIndex" (offset=369) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "lastIndex" (offset=380) */
   0x65646e497473616c,
   0x0000000000000078,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "get lastIndex" (offset=372) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "get lastIndex" (offset=383) */
   0x7473616c20746567,
   0x0000007865646e49,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "set lastIndex" (offset=375) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "set lastIndex" (offset=386) */
   0x7473616c20746573,
   0x0000007865646e49,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "source" (offset=378) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "source" (offset=389) */
   0x0000656372756f73,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get source" (offset=380) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get source" (offset=391) */
   0x72756f7320746567,
   0x0000000000006563,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "flags" (offset=383) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "flags" (offset=394) */
   0x0000007367616c66,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get flags" (offset=385) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get flags" (offset=396) */
   0x67616c6620746567,
   0x0000000000000073,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "exec" (offset=388) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "exec" (offset=399) */
   0x0000000063657865,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "test" (offset=390) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (4 << (JS_MTAG_BITS + 3)), /* "test" (offset=401) */
   0x0000000074736574,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "message" (offset=392) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "message" (offset=403) */
   0x006567617373656d,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "get message" (offset=394) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "get message" (offset=405) */
   0x7373656d20746567,
   0x0000000000656761,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "stack" (offset=397) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "stack" (offset=408) */
   0x0000006b63617473,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get stack" (offset=399) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "get stack" (offset=410) */
   0x6361747320746567,
   0x000000000000006b,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "EvalError" (offset=402) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "EvalError" (offset=413) */
   0x6f7272456c617645,
   0x0000000000000072,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "RangeError" (offset=405) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "RangeError" (offset=416) */
   0x72724565676e6152,
   0x000000000000726f,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "ReferenceError" (offset=408) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "ReferenceError" (offset=419) */
   0x636e657265666552,
   0x0000726f72724565,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "SyntaxError" (offset=411) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "SyntaxError" (offset=422) */
   0x72457861746e7953,
   0x0000000000726f72,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "TypeError" (offset=414) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "TypeError" (offset=425) */
   0x6f72724565707954,
   0x0000000000000072,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "URIError" (offset=417) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "URIError" (offset=428) */
   0x726f727245495255,
   0x0000000000000000,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "InternalError" (offset=420) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (13 << (JS_MTAG_BITS + 3)), /* "InternalError" (offset=431) */
   0x6c616e7265746e49,
   0x000000726f727245,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "ArrayBuffer" (offset=423) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "ArrayBuffer" (offset=434) */
   0x6675427961727241,
   0x0000000000726566,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteLength" (offset=426) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteLength" (offset=437) */
   0x676e654c65747962,
   0x0000000000006874,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteLength" (offset=429) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteLength" (offset=440) */
   0x6574796220746567,
   0x00006874676e654c,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "Uint8ClampedArray" (offset=432) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "Uint8ClampedArray" (offset=443) */
   0x616c4338746e6955,
   0x617272416465706d,
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "TypedArray" (offset=436) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "TypedArray" (offset=447) */
   0x7272416465707954,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteOffset" (offset=439) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "byteOffset" (offset=450) */
   0x7366664f65747962,
   0x0000000000007465,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteOffset" (offset=442) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (14 << (JS_MTAG_BITS + 3)), /* "get byteOffset" (offset=453) */
   0x6574796220746567,
   0x000074657366664f,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "buffer" (offset=445) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (6 << (JS_MTAG_BITS + 3)), /* "buffer" (offset=456) */
   0x0000726566667562,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get buffer" (offset=447) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "get buffer" (offset=458) */
   0x6666756220746567,
   0x0000000000007265,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "subarray" (offset=450) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "subarray" (offset=461) */
   0x7961727261627573,
   0x0000000000000000,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "BYTES_PER_ELEMENT" (offset=453) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (17 << (JS_MTAG_BITS + 3)), /* "BYTES_PER_ELEMENT" (offset=464) */
   0x45505f5345545942,
   0x4e454d454c455f52,
   0x0000000000000054,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "Int8Array" (offset=457) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (9 << (JS_MTAG_BITS + 3)), /* "Int8Array" (offset=468) */
   0x6172724138746e49,
   0x0000000000000079,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Uint8Array" (offset=460) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Uint8Array" (offset=471) */
   0x72724138746e6955,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int16Array" (offset=463) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int16Array" (offset=474) */
   0x7272413631746e49,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint16Array" (offset=466) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint16Array" (offset=477) */
   0x72413631746e6955,
   0x0000000000796172,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int32Array" (offset=469) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "Int32Array" (offset=480) */
   0x7272413233746e49,
   0x0000000000007961,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint32Array" (offset=472) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "Uint32Array" (offset=483) */
   0x72413233746e6955,
   0x0000000000796172,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float32Array" (offset=475) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float32Array" (offset=486) */
   0x41323374616f6c46,
   0x0000000079617272,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float64Array" (offset=478) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (12 << (JS_MTAG_BITS + 3)), /* "Float64Array" (offset=489) */
   0x41343674616f6c46,
   0x0000000079617272,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "isNaN" (offset=481) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "isNaN" (offset=492) */
   0x0000004e614e7369,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "isFinite" (offset=483) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "isFinite" (offset=494) */
   0x6574696e69467369,
   0x0000000000000000,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "globalThis" (offset=486) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (10 << (JS_MTAG_BITS + 3)), /* "globalThis" (offset=497) */
   0x68546c61626f6c67,
   0x0000000000007369,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "console" (offset=489) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (7 << (JS_MTAG_BITS + 3)), /* "console" (offset=500) */
   0x00656c6f736e6f63,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "log" (offset=491) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (3 << (JS_MTAG_BITS + 3)), /* "log" (offset=502) */
   0x0000000000676f6c,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "performance" (offset=493) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (11 << (JS_MTAG_BITS + 3)), /* "performance" (offset=504) */
   0x616d726f66726570,
   0x000000000065636e,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "print" (offset=496) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "Async" (offset=507) */
+  0x000000636e797341,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "await" (offset=509) */
+  0x0000007469617761,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (8 << (JS_MTAG_BITS + 3)), /* "awaitAll" (offset=511) */
+  0x6c6c417469617761,
+  0x0000000000000000,
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (5 << (JS_MTAG_BITS + 3)), /* "print" (offset=514) */
   0x000000746e697270,
-  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (2 << (JS_MTAG_BITS + 3)), /* "gc" (offset=498) */
+  (JS_MTAG_STRING << 1) | (1 << JS_MTAG_BITS) | (1 << (JS_MTAG_BITS + 1)) | (0 << (JS_MTAG_BITS + 2)) | (2 << (JS_MTAG_BITS + 3)), /* "gc" (offset=516) */
   0x0000000000006367,
 
-  /* sorted atom table (offset=500) */
-  JS_VALUE_ARRAY_HEADER(206),
+  /* sorted atom table (offset=518) */
+  JS_VALUE_ARRAY_HEADER(214),
   JS_ROM_VALUE(97), /* empty */
   JS_ROM_VALUE(147), /* _Infinity */
   JS_ROM_VALUE(117), /* _eval_ */
   JS_ROM_VALUE(115), /* _ret_ */
   JS_ROM_VALUE(299), /* Array */
-  JS_ROM_VALUE(423), /* ArrayBuffer */
-  JS_ROM_VALUE(453), /* BYTES_PER_ELEMENT */
+  JS_ROM_VALUE(434), /* ArrayBuffer */
+  JS_ROM_VALUE(507), /* Async */
+  JS_ROM_VALUE(464), /* BYTES_PER_ELEMENT */
   JS_ROM_VALUE(242), /* Boolean */
   JS_ROM_VALUE(354), /* Date */
   JS_ROM_VALUE(356), /* Decimal */
   JS_ROM_VALUE(352), /* E */
   JS_ROM_VALUE(224), /* EPSILON */
   JS_ROM_VALUE(152), /* Error */
-  JS_ROM_VALUE(402), /* EvalError */
-  JS_ROM_VALUE(475), /* Float32Array */
-  JS_ROM_VALUE(478), /* Float64Array */
+  JS_ROM_VALUE(413), /* EvalError */
+  JS_ROM_VALUE(486), /* Float32Array */
+  JS_ROM_VALUE(489), /* Float64Array */
   JS_ROM_VALUE(181), /* Function */
   JS_ROM_VALUE(144), /* Infinity */
-  JS_ROM_VALUE(463), /* Int16Array */
-  JS_ROM_VALUE(469), /* Int32Array */
-  JS_ROM_VALUE(457), /* Int8Array */
-  JS_ROM_VALUE(420), /* InternalError */
-  JS_ROM_VALUE(360), /* JSON */
+  JS_ROM_VALUE(474), /* Int16Array */
+  JS_ROM_VALUE(480), /* Int32Array */
+  JS_ROM_VALUE(468), /* Int8Array */
+  JS_ROM_VALUE(431), /* InternalError */
+  JS_ROM_VALUE(371), /* JSON */
   JS_ROM_VALUE(226), /* MAX_SAFE_INTEGER */
   JS_ROM_VALUE(210), /* MAX_VALUE */
   JS_ROM_VALUE(230), /* MIN_SAFE_INTEGER */
@@ -540,29 +559,32 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(202), /* Number */
   JS_ROM_VALUE(163), /* Object */
   JS_ROM_VALUE(220), /* POSITIVE_INFINITY */
-  JS_ROM_VALUE(405), /* RangeError */
-  JS_ROM_VALUE(408), /* ReferenceError */
-  JS_ROM_VALUE(367), /* RegExp */
+  JS_ROM_VALUE(416), /* RangeError */
+  JS_ROM_VALUE(419), /* ReferenceError */
+  JS_ROM_VALUE(378), /* RegExp */
   JS_ROM_VALUE(244), /* String */
-  JS_ROM_VALUE(411), /* SyntaxError */
-  JS_ROM_VALUE(414), /* TypeError */
-  JS_ROM_VALUE(436), /* TypedArray */
-  JS_ROM_VALUE(417), /* URIError */
-  JS_ROM_VALUE(466), /* Uint16Array */
-  JS_ROM_VALUE(472), /* Uint32Array */
-  JS_ROM_VALUE(460), /* Uint8Array */
-  JS_ROM_VALUE(432), /* Uint8ClampedArray */
+  JS_ROM_VALUE(422), /* SyntaxError */
+  JS_ROM_VALUE(425), /* TypeError */
+  JS_ROM_VALUE(447), /* TypedArray */
+  JS_ROM_VALUE(428), /* URIError */
+  JS_ROM_VALUE(477), /* Uint16Array */
+  JS_ROM_VALUE(483), /* Uint32Array */
+  JS_ROM_VALUE(471), /* Uint8Array */
+  JS_ROM_VALUE(443), /* Uint8ClampedArray */
   JS_ROM_VALUE(154), /* __proto__ */
   JS_ROM_VALUE(342), /* abs */
+  JS_ROM_VALUE(360), /* add */
   JS_ROM_VALUE(192), /* apply */
   JS_ROM_VALUE(121), /* arguments */
+  JS_ROM_VALUE(509), /* await */
+  JS_ROM_VALUE(511), /* awaitAll */
   JS_ROM_VALUE(194), /* bind */
   JS_ROM_VALUE(113), /* boolean */
   JS_ROM_VALUE(161), /* bound */
   JS_ROM_VALUE(35), /* break */
-  JS_ROM_VALUE(445), /* buffer */
-  JS_ROM_VALUE(426), /* byteLength */
-  JS_ROM_VALUE(439), /* byteOffset */
+  JS_ROM_VALUE(456), /* buffer */
+  JS_ROM_VALUE(437), /* byteLength */
+  JS_ROM_VALUE(450), /* byteOffset */
   JS_ROM_VALUE(190), /* call */
   JS_ROM_VALUE(42), /* case */
   JS_ROM_VALUE(50), /* catch */
@@ -573,7 +595,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(260), /* codePointAt */
   JS_ROM_VALUE(358), /* compare */
   JS_ROM_VALUE(268), /* concat */
-  JS_ROM_VALUE(489), /* console */
+  JS_ROM_VALUE(500), /* console */
   JS_ROM_VALUE(64), /* const */
   JS_ROM_VALUE(133), /* constructor */
   JS_ROM_VALUE(37), /* continue */
@@ -582,39 +604,40 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(44), /* default */
   JS_ROM_VALUE(165), /* defineProperty */
   JS_ROM_VALUE(16), /* delete */
+  JS_ROM_VALUE(366), /* div */
   JS_ROM_VALUE(29), /* do */
   JS_ROM_VALUE(8), /* else */
   JS_ROM_VALUE(66), /* enum */
   JS_ROM_VALUE(119), /* eval */
   JS_ROM_VALUE(317), /* every */
-  JS_ROM_VALUE(388), /* exec */
+  JS_ROM_VALUE(399), /* exec */
   JS_ROM_VALUE(68), /* export */
   JS_ROM_VALUE(70), /* extends */
   JS_ROM_VALUE(2), /* false */
   JS_ROM_VALUE(325), /* filter */
   JS_ROM_VALUE(52), /* finally */
-  JS_ROM_VALUE(383), /* flags */
+  JS_ROM_VALUE(394), /* flags */
   JS_ROM_VALUE(344), /* floor */
   JS_ROM_VALUE(33), /* for */
   JS_ROM_VALUE(321), /* forEach */
   JS_ROM_VALUE(246), /* fromCharCode */
   JS_ROM_VALUE(249), /* fromCodePoint */
   JS_ROM_VALUE(54), /* function */
-  JS_ROM_VALUE(498), /* gc */
+  JS_ROM_VALUE(516), /* gc */
   JS_ROM_VALUE(126), /* get */
-  JS_ROM_VALUE(447), /* get buffer */
-  JS_ROM_VALUE(429), /* get byteLength */
-  JS_ROM_VALUE(442), /* get byteOffset */
-  JS_ROM_VALUE(385), /* get flags */
-  JS_ROM_VALUE(372), /* get lastIndex */
+  JS_ROM_VALUE(458), /* get buffer */
+  JS_ROM_VALUE(440), /* get byteLength */
+  JS_ROM_VALUE(453), /* get byteOffset */
+  JS_ROM_VALUE(396), /* get flags */
+  JS_ROM_VALUE(383), /* get lastIndex */
   JS_ROM_VALUE(196), /* get length */
-  JS_ROM_VALUE(394), /* get message */
+  JS_ROM_VALUE(405), /* get message */
   JS_ROM_VALUE(199), /* get name */
   JS_ROM_VALUE(184), /* get prototype */
-  JS_ROM_VALUE(380), /* get source */
-  JS_ROM_VALUE(399), /* get stack */
+  JS_ROM_VALUE(391), /* get source */
+  JS_ROM_VALUE(410), /* get stack */
   JS_ROM_VALUE(168), /* getPrototypeOf */
-  JS_ROM_VALUE(486), /* globalThis */
+  JS_ROM_VALUE(497), /* globalThis */
   JS_ROM_VALUE(178), /* hasOwnProperty */
   JS_ROM_VALUE(6), /* if */
   JS_ROM_VALUE(76), /* implements */
@@ -626,20 +649,21 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(26), /* instanceof */
   JS_ROM_VALUE(79), /* interface */
   JS_ROM_VALUE(301), /* isArray */
-  JS_ROM_VALUE(483), /* isFinite */
-  JS_ROM_VALUE(481), /* isNaN */
+  JS_ROM_VALUE(494), /* isFinite */
+  JS_ROM_VALUE(492), /* isNaN */
   JS_ROM_VALUE(307), /* join */
   JS_ROM_VALUE(176), /* keys */
-  JS_ROM_VALUE(369), /* lastIndex */
+  JS_ROM_VALUE(380), /* lastIndex */
   JS_ROM_VALUE(272), /* lastIndexOf */
   JS_ROM_VALUE(136), /* length */
   JS_ROM_VALUE(82), /* let */
-  JS_ROM_VALUE(491), /* log */
+  JS_ROM_VALUE(502), /* log */
   JS_ROM_VALUE(323), /* map */
   JS_ROM_VALUE(275), /* match */
   JS_ROM_VALUE(338), /* max */
-  JS_ROM_VALUE(392), /* message */
+  JS_ROM_VALUE(403), /* message */
   JS_ROM_VALUE(336), /* min */
+  JS_ROM_VALUE(364), /* mul */
   JS_ROM_VALUE(150), /* name */
   JS_ROM_VALUE(22), /* new */
   JS_ROM_VALUE(0), /* null */
@@ -647,17 +671,18 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(106), /* object */
   JS_ROM_VALUE(140), /* of */
   JS_ROM_VALUE(84), /* package */
-  JS_ROM_VALUE(362), /* parse */
+  JS_ROM_VALUE(373), /* parse */
   JS_ROM_VALUE(207), /* parseFloat */
   JS_ROM_VALUE(204), /* parseInt */
-  JS_ROM_VALUE(493), /* performance */
+  JS_ROM_VALUE(504), /* performance */
   JS_ROM_VALUE(305), /* pop */
-  JS_ROM_VALUE(496), /* print */
+  JS_ROM_VALUE(514), /* print */
   JS_ROM_VALUE(86), /* private */
   JS_ROM_VALUE(88), /* protected */
   JS_ROM_VALUE(130), /* prototype */
   JS_ROM_VALUE(91), /* public */
   JS_ROM_VALUE(303), /* push */
+  JS_ROM_VALUE(368), /* quantize */
   JS_ROM_VALUE(327), /* reduce */
   JS_ROM_VALUE(329), /* reduceRight */
   JS_ROM_VALUE(277), /* replace */
@@ -667,7 +692,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(348), /* round */
   JS_ROM_VALUE(282), /* search */
   JS_ROM_VALUE(128), /* set */
-  JS_ROM_VALUE(375), /* set lastIndex */
+  JS_ROM_VALUE(386), /* set lastIndex */
   JS_ROM_VALUE(252), /* set length */
   JS_ROM_VALUE(187), /* set prototype */
   JS_ROM_VALUE(171), /* setPrototypeOf */
@@ -676,20 +701,21 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(263), /* slice */
   JS_ROM_VALUE(319), /* some */
   JS_ROM_VALUE(332), /* sort */
-  JS_ROM_VALUE(378), /* source */
+  JS_ROM_VALUE(389), /* source */
   JS_ROM_VALUE(313), /* splice */
   JS_ROM_VALUE(284), /* split */
   JS_ROM_VALUE(350), /* sqrt */
-  JS_ROM_VALUE(397), /* stack */
+  JS_ROM_VALUE(408), /* stack */
   JS_ROM_VALUE(93), /* static */
   JS_ROM_VALUE(111), /* string */
-  JS_ROM_VALUE(364), /* stringify */
-  JS_ROM_VALUE(450), /* subarray */
+  JS_ROM_VALUE(375), /* stringify */
+  JS_ROM_VALUE(362), /* sub */
+  JS_ROM_VALUE(461), /* subarray */
   JS_ROM_VALUE(265), /* substring */
   JS_ROM_VALUE(74), /* super */
   JS_ROM_VALUE(40), /* switch */
   JS_ROM_VALUE(138), /* target */
-  JS_ROM_VALUE(390), /* test */
+  JS_ROM_VALUE(401), /* test */
   JS_ROM_VALUE(14), /* this */
   JS_ROM_VALUE(46), /* throw */
   JS_ROM_VALUE(234), /* toExponential */
@@ -714,7 +740,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(60), /* with */
   JS_ROM_VALUE(95), /* yield */
 
-  /* properties (offset=707) */
+  /* properties (offset=733) */
   JS_VALUE_ARRAY_HEADER(24),
   6 << 1, /* n_props */
   3 << 1, /* hash_mask */
@@ -740,7 +766,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_OBJECT << 1,
   (15 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=732) */
+  /* properties (offset=758) */
   JS_VALUE_ARRAY_HEADER(13),
   3 << 1, /* n_props */
   1 << 1, /* hash_mask */
@@ -755,14 +781,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_OBJECT - 1) << 1,
   (7 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=746) */
+  /* class (offset=772) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(707),
+  JS_ROM_VALUE(733),
   1,
-  JS_ROM_VALUE(732),
+  JS_ROM_VALUE(758),
   JS_NULL,
 
-  /* properties (offset=751) */
+  /* properties (offset=777) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -770,22 +796,22 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_CLOSURE << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=758) */
+  /* getset (offset=784) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 10),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 11),
 
-  /* getset (offset=761) */
+  /* getset (offset=787) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 12),
   JS_UNDEFINED,
 
-  /* getset (offset=764) */
+  /* getset (offset=790) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 13),
   JS_UNDEFINED,
 
-  /* properties (offset=767) */
+  /* properties (offset=793) */
   JS_VALUE_ARRAY_HEADER(30),
   8 << 1, /* n_props */
   3 << 1, /* hash_mask */
@@ -794,7 +820,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   18 << 1,
   24 << 1,
   JS_ROM_VALUE(130) /* prototype */,
-  JS_ROM_VALUE(758),
+  JS_ROM_VALUE(784),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(190) /* call */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 14),
@@ -809,54 +835,54 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 17),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(761),
+  JS_ROM_VALUE(787),
   (12 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(764),
+  JS_ROM_VALUE(790),
   (15 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_CLOSURE - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=798) */
+  /* class (offset=824) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(751),
+  JS_ROM_VALUE(777),
   9,
-  JS_ROM_VALUE(767),
+  JS_ROM_VALUE(793),
   JS_NULL,
 
-  /* float64 (offset=803) */
+  /* float64 (offset=829) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x7fefffffffffffff,
 
-  /* float64 (offset=805) */
+  /* float64 (offset=831) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x0000000000000001,
 
-  /* float64 (offset=807) */
+  /* float64 (offset=833) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x7ff8000000000000,
 
-  /* float64 (offset=809) */
+  /* float64 (offset=835) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0xfff0000000000000,
 
-  /* float64 (offset=811) */
+  /* float64 (offset=837) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x7ff0000000000000,
 
-  /* float64 (offset=813) */
+  /* float64 (offset=839) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x3cb0000000000000,
 
-  /* float64 (offset=815) */
+  /* float64 (offset=841) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x433fffffffffffff,
 
-  /* float64 (offset=817) */
+  /* float64 (offset=843) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0xc33fffffffffffff,
 
-  /* properties (offset=819) */
+  /* properties (offset=845) */
   JS_VALUE_ARRAY_HEADER(43),
   11 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -875,33 +901,33 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 20),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(210) /* MAX_VALUE */,
-  JS_ROM_VALUE(803),
+  JS_ROM_VALUE(829),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(213) /* MIN_VALUE */,
-  JS_ROM_VALUE(805),
+  JS_ROM_VALUE(831),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(142) /* NaN */,
-  JS_ROM_VALUE(807),
+  JS_ROM_VALUE(833),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(216) /* NEGATIVE_INFINITY */,
-  JS_ROM_VALUE(809),
+  JS_ROM_VALUE(835),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(220) /* POSITIVE_INFINITY */,
-  JS_ROM_VALUE(811),
+  JS_ROM_VALUE(837),
   (10 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(224) /* EPSILON */,
-  JS_ROM_VALUE(813),
+  JS_ROM_VALUE(839),
   (25 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(226) /* MAX_SAFE_INTEGER */,
-  JS_ROM_VALUE(815),
+  JS_ROM_VALUE(841),
   (16 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(230) /* MIN_SAFE_INTEGER */,
-  JS_ROM_VALUE(817),
+  JS_ROM_VALUE(843),
   (22 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_NUMBER << 1,
   (34 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=863) */
+  /* properties (offset=889) */
   JS_VALUE_ARRAY_HEADER(21),
   5 << 1, /* n_props */
   3 << 1, /* hash_mask */
@@ -924,14 +950,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_NUMBER - 1) << 1,
   (9 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=885) */
+  /* class (offset=911) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(819),
+  JS_ROM_VALUE(845),
   18,
-  JS_ROM_VALUE(863),
+  JS_ROM_VALUE(889),
   JS_NULL,
 
-  /* properties (offset=890) */
+  /* properties (offset=916) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -939,7 +965,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_BOOLEAN << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=897) */
+  /* properties (offset=923) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -947,14 +973,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_BOOLEAN - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=904) */
+  /* class (offset=930) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(890),
+  JS_ROM_VALUE(916),
   25,
-  JS_ROM_VALUE(897),
+  JS_ROM_VALUE(923),
   JS_NULL,
 
-  /* properties (offset=909) */
+  /* properties (offset=935) */
   JS_VALUE_ARRAY_HEADER(13),
   3 << 1, /* n_props */
   1 << 1, /* hash_mask */
@@ -969,12 +995,12 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_STRING << 1,
   (4 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=923) */
+  /* getset (offset=949) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 29),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 30),
 
-  /* properties (offset=926) */
+  /* properties (offset=952) */
   JS_VALUE_ARRAY_HEADER(73),
   21 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -987,7 +1013,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   43 << 1,
   61 << 1,
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(923),
+  JS_ROM_VALUE(949),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(255) /* charAt */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 31),
@@ -1049,14 +1075,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_STRING - 1) << 1,
   (40 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1000) */
+  /* class (offset=1026) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(909),
+  JS_ROM_VALUE(935),
   26,
-  JS_ROM_VALUE(926),
+  JS_ROM_VALUE(952),
   JS_NULL,
 
-  /* properties (offset=1005) */
+  /* properties (offset=1031) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1067,12 +1093,12 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1015) */
+  /* getset (offset=1041) */
   JS_VALUE_ARRAY_HEADER(2),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 52),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 53),
 
-  /* properties (offset=1018) */
+  /* properties (offset=1044) */
   JS_VALUE_ARRAY_HEADER(79),
   23 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -1088,7 +1114,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 54),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(1015),
+  JS_ROM_VALUE(1041),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(303) /* push */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 55),
@@ -1153,18 +1179,18 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_ARRAY - 1) << 1,
   (61 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1098) */
+  /* class (offset=1124) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1005),
+  JS_ROM_VALUE(1031),
   50,
-  JS_ROM_VALUE(1018),
+  JS_ROM_VALUE(1044),
   JS_NULL,
 
-  /* float64 (offset=1103) */
+  /* float64 (offset=1129) */
   JS_MB_HEADER_DEF(JS_MTAG_FLOAT64),
   0x4005bf0a8b145769,
 
-  /* properties (offset=1105) */
+  /* properties (offset=1131) */
   JS_VALUE_ARRAY_HEADER(37),
   9 << 1, /* n_props */
   7 << 1, /* hash_mask */
@@ -1201,16 +1227,16 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 81),
   (19 << 1) | (JS_PROP_NORMAL << 30),
   JS_VALUE_MAKE_SPECIAL(JS_TAG_STRING_CHAR, 69) /* E */,
-  JS_ROM_VALUE(1103),
+  JS_ROM_VALUE(1129),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  /* class (offset=1143) */
+  /* class (offset=1169) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1105),
+  JS_ROM_VALUE(1131),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1148) */
+  /* properties (offset=1174) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1218,7 +1244,7 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_DATE << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1155) */
+  /* properties (offset=1181) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1226,14 +1252,14 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_DATE - 1) << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1162) */
+  /* class (offset=1188) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1148),
+  JS_ROM_VALUE(1174),
   82,
-  JS_ROM_VALUE(1155),
+  JS_ROM_VALUE(1181),
   JS_NULL,
 
-  /* properties (offset=1167) */
+  /* properties (offset=1193) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1241,47 +1267,64 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_DECIMAL << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1174) */
-  JS_VALUE_ARRAY_HEADER(13),
-  3 << 1, /* n_props */
-  1 << 1, /* hash_mask */
-  10 << 1,
-  7 << 1,
+  /* properties (offset=1200) */
+  JS_VALUE_ARRAY_HEADER(30),
+  8 << 1, /* n_props */
+  3 << 1, /* hash_mask */
+  27 << 1,
+  24 << 1,
+  6 << 1,
+  21 << 1,
   JS_ROM_VALUE(99) /* toString */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 84),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(358) /* compare */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 85),
   (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(360) /* add */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 86),
+  (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(362) /* sub */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 87),
+  (9 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(364) /* mul */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 88),
+  (12 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(366) /* div */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 89),
+  (15 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(368) /* quantize */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 90),
+  (18 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_DECIMAL - 1) << 1,
-  (4 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1188) */
+  (0 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1231) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1167),
+  JS_ROM_VALUE(1193),
   83,
-  JS_ROM_VALUE(1174),
+  JS_ROM_VALUE(1200),
   JS_NULL,
 
-  /* properties (offset=1193) */
+  /* properties (offset=1236) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(362) /* parse */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 86),
+  JS_ROM_VALUE(373) /* parse */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 91),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(364) /* stringify */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 87),
+  JS_ROM_VALUE(375) /* stringify */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 92),
   (3 << 1) | (JS_PROP_NORMAL << 30),
-  /* class (offset=1203) */
+  /* class (offset=1246) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1193),
+  JS_ROM_VALUE(1236),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1208) */
+  /* properties (offset=1251) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1289,55 +1332,55 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_REGEXP << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1215) */
+  /* getset (offset=1258) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 89),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 90),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 94),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 95),
 
-  /* getset (offset=1218) */
+  /* getset (offset=1261) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 91),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 96),
   JS_UNDEFINED,
 
-  /* getset (offset=1221) */
+  /* getset (offset=1264) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 92),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 97),
   JS_UNDEFINED,
 
-  /* properties (offset=1224) */
+  /* properties (offset=1267) */
   JS_VALUE_ARRAY_HEADER(24),
   6 << 1, /* n_props */
   3 << 1, /* hash_mask */
   21 << 1,
+  6 << 1,
   15 << 1,
   12 << 1,
-  18 << 1,
-  JS_ROM_VALUE(369) /* lastIndex */,
-  JS_ROM_VALUE(1215),
+  JS_ROM_VALUE(380) /* lastIndex */,
+  JS_ROM_VALUE(1258),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(378) /* source */,
-  JS_ROM_VALUE(1218),
+  JS_ROM_VALUE(389) /* source */,
+  JS_ROM_VALUE(1261),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(383) /* flags */,
-  JS_ROM_VALUE(1221),
+  JS_ROM_VALUE(394) /* flags */,
+  JS_ROM_VALUE(1264),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(388) /* exec */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 93),
+  JS_ROM_VALUE(399) /* exec */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 98),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(390) /* test */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 94),
+  JS_ROM_VALUE(401) /* test */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 99),
   (9 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_REGEXP - 1) << 1,
-  (6 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1249) */
+  (18 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1292) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1208),
-  88,
-  JS_ROM_VALUE(1224),
+  JS_ROM_VALUE(1251),
+  93,
+  JS_ROM_VALUE(1267),
   JS_NULL,
 
-  /* properties (offset=1254) */
+  /* properties (offset=1297) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1345,47 +1388,47 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1261) */
+  /* getset (offset=1304) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 96),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 101),
   JS_UNDEFINED,
 
-  /* getset (offset=1264) */
+  /* getset (offset=1307) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 97),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 102),
   JS_UNDEFINED,
 
-  /* properties (offset=1267) */
+  /* properties (offset=1310) */
   JS_VALUE_ARRAY_HEADER(21),
   5 << 1, /* n_props */
   3 << 1, /* hash_mask */
   18 << 1,
+  15 << 1,
   12 << 1,
-  6 << 1,
   9 << 1,
   JS_ROM_VALUE(99) /* toString */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 98),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 103),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(150) /* name */,
   JS_ROM_VALUE(152) /* Error */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(392) /* message */,
-  JS_ROM_VALUE(1261),
-  (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(397) /* stack */,
-  JS_ROM_VALUE(1264),
+  JS_ROM_VALUE(403) /* message */,
+  JS_ROM_VALUE(1304),
+  (6 << 1) | (JS_PROP_GETSET << 30),
+  JS_ROM_VALUE(408) /* stack */,
+  JS_ROM_VALUE(1307),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_ERROR - 1) << 1,
-  (15 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1289) */
+  (0 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1332) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1254),
-  95,
-  JS_ROM_VALUE(1267),
+  JS_ROM_VALUE(1297),
+  100,
+  JS_ROM_VALUE(1310),
   JS_NULL,
 
-  /* properties (offset=1294) */
+  /* properties (offset=1337) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1393,25 +1436,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_EVAL_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1301) */
+  /* properties (offset=1344) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(402) /* EvalError */,
+  JS_ROM_VALUE(413) /* EvalError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_EVAL_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1311) */
+  /* class (offset=1354) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1294),
-  99,
-  JS_ROM_VALUE(1301),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1337),
+  104,
+  JS_ROM_VALUE(1344),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1316) */
+  /* properties (offset=1359) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1419,25 +1462,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_RANGE_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1323) */
+  /* properties (offset=1366) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(405) /* RangeError */,
+  JS_ROM_VALUE(416) /* RangeError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_RANGE_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1333) */
+  /* class (offset=1376) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1316),
-  100,
-  JS_ROM_VALUE(1323),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1359),
+  105,
+  JS_ROM_VALUE(1366),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1338) */
+  /* properties (offset=1381) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1445,25 +1488,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_REFERENCE_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1345) */
+  /* properties (offset=1388) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(408) /* ReferenceError */,
+  JS_ROM_VALUE(419) /* ReferenceError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_REFERENCE_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1355) */
+  /* class (offset=1398) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1338),
-  101,
-  JS_ROM_VALUE(1345),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1381),
+  106,
+  JS_ROM_VALUE(1388),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1360) */
+  /* properties (offset=1403) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1471,25 +1514,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_SYNTAX_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1367) */
+  /* properties (offset=1410) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(411) /* SyntaxError */,
+  JS_ROM_VALUE(422) /* SyntaxError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_SYNTAX_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1377) */
+  /* class (offset=1420) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1360),
-  102,
-  JS_ROM_VALUE(1367),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1403),
+  107,
+  JS_ROM_VALUE(1410),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1382) */
+  /* properties (offset=1425) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1497,25 +1540,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_TYPE_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1389) */
+  /* properties (offset=1432) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(414) /* TypeError */,
+  JS_ROM_VALUE(425) /* TypeError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_TYPE_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1399) */
+  /* class (offset=1442) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1382),
-  103,
-  JS_ROM_VALUE(1389),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1425),
+  108,
+  JS_ROM_VALUE(1432),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1404) */
+  /* properties (offset=1447) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1523,25 +1566,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_URI_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1411) */
+  /* properties (offset=1454) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(417) /* URIError */,
+  JS_ROM_VALUE(428) /* URIError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_URI_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1421) */
+  /* class (offset=1464) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1404),
-  104,
-  JS_ROM_VALUE(1411),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1447),
+  109,
+  JS_ROM_VALUE(1454),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1426) */
+  /* properties (offset=1469) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1549,25 +1592,25 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INTERNAL_ERROR << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1433) */
+  /* properties (offset=1476) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
   JS_ROM_VALUE(150) /* name */,
-  JS_ROM_VALUE(420) /* InternalError */,
+  JS_ROM_VALUE(431) /* InternalError */,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INTERNAL_ERROR - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1443) */
+  /* class (offset=1486) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1426),
-  105,
-  JS_ROM_VALUE(1433),
-  JS_ROM_VALUE(1289),
+  JS_ROM_VALUE(1469),
+  110,
+  JS_ROM_VALUE(1476),
+  JS_ROM_VALUE(1332),
 
-  /* properties (offset=1448) */
+  /* properties (offset=1491) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1575,30 +1618,30 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_ARRAY_BUFFER << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1455) */
+  /* getset (offset=1498) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 107),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 112),
   JS_UNDEFINED,
 
-  /* properties (offset=1458) */
+  /* properties (offset=1501) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(426) /* byteLength */,
-  JS_ROM_VALUE(1455),
+  JS_ROM_VALUE(437) /* byteLength */,
+  JS_ROM_VALUE(1498),
   (0 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_ARRAY_BUFFER - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1468) */
+  /* class (offset=1511) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1448),
-  106,
-  JS_ROM_VALUE(1458),
+  JS_ROM_VALUE(1491),
+  111,
+  JS_ROM_VALUE(1501),
   JS_NULL,
 
-  /* properties (offset=1473) */
+  /* properties (offset=1516) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
@@ -1606,438 +1649,458 @@ static const uint64_t __attribute((aligned(64))) js_stdlib_table[] = {
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_TYPED_ARRAY << 1,
   (0 << 1) | (JS_PROP_SPECIAL << 30),
-  /* getset (offset=1480) */
+  /* getset (offset=1523) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 109),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 114),
   JS_UNDEFINED,
 
-  /* getset (offset=1483) */
+  /* getset (offset=1526) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 110),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 115),
   JS_UNDEFINED,
 
-  /* getset (offset=1486) */
+  /* getset (offset=1529) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 111),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 116),
   JS_UNDEFINED,
 
-  /* getset (offset=1489) */
+  /* getset (offset=1532) */
   JS_VALUE_ARRAY_HEADER(2),
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 112),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 117),
   JS_UNDEFINED,
 
-  /* properties (offset=1492) */
+  /* properties (offset=1535) */
   JS_VALUE_ARRAY_HEADER(37),
   9 << 1, /* n_props */
   7 << 1, /* hash_mask */
   0 << 1,
   31 << 1,
   25 << 1,
-  28 << 1,
+  16 << 1,
   34 << 1,
   0 << 1,
-  16 << 1,
+  0 << 1,
   0 << 1,
   JS_ROM_VALUE(136) /* length */,
-  JS_ROM_VALUE(1480),
+  JS_ROM_VALUE(1523),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(426) /* byteLength */,
-  JS_ROM_VALUE(1483),
+  JS_ROM_VALUE(437) /* byteLength */,
+  JS_ROM_VALUE(1526),
   (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(439) /* byteOffset */,
-  JS_ROM_VALUE(1486),
-  (0 << 1) | (JS_PROP_GETSET << 30),
-  JS_ROM_VALUE(445) /* buffer */,
-  JS_ROM_VALUE(1489),
+  JS_ROM_VALUE(450) /* byteOffset */,
+  JS_ROM_VALUE(1529),
   (0 << 1) | (JS_PROP_GETSET << 30),
+  JS_ROM_VALUE(456) /* buffer */,
+  JS_ROM_VALUE(1532),
+  (10 << 1) | (JS_PROP_GETSET << 30),
   JS_ROM_VALUE(307) /* join */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 57),
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(99) /* toString */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 58),
   (22 << 1) | (JS_PROP_NORMAL << 30),
-  JS_ROM_VALUE(450) /* subarray */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 113),
+  JS_ROM_VALUE(461) /* subarray */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 118),
   (13 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(128) /* set */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 114),
-  (10 << 1) | (JS_PROP_NORMAL << 30),
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 119),
+  (19 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_TYPED_ARRAY - 1) << 1,
-  (19 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1530) */
+  (28 << 1) | (JS_PROP_SPECIAL << 30),
+  /* class (offset=1573) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1473),
-  108,
-  JS_ROM_VALUE(1492),
+  JS_ROM_VALUE(1516),
+  113,
+  JS_ROM_VALUE(1535),
   JS_NULL,
 
-  /* properties (offset=1535) */
+  /* properties (offset=1578) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT8C_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1545) */
+  /* properties (offset=1588) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT8C_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1555) */
+  /* class (offset=1598) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1535),
-  115,
-  JS_ROM_VALUE(1545),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1578),
+  120,
+  JS_ROM_VALUE(1588),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1560) */
+  /* properties (offset=1603) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INT8_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1570) */
+  /* properties (offset=1613) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INT8_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1580) */
+  /* class (offset=1623) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1560),
-  116,
-  JS_ROM_VALUE(1570),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1603),
+  121,
+  JS_ROM_VALUE(1613),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1585) */
+  /* properties (offset=1628) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT8_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1595) */
+  /* properties (offset=1638) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   1 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT8_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1605) */
+  /* class (offset=1648) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1585),
-  117,
-  JS_ROM_VALUE(1595),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1628),
+  122,
+  JS_ROM_VALUE(1638),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1610) */
+  /* properties (offset=1653) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INT16_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1620) */
+  /* properties (offset=1663) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INT16_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1630) */
+  /* class (offset=1673) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1610),
-  118,
-  JS_ROM_VALUE(1620),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1653),
+  123,
+  JS_ROM_VALUE(1663),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1635) */
+  /* properties (offset=1678) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT16_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1645) */
+  /* properties (offset=1688) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   2 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT16_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1655) */
+  /* class (offset=1698) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1635),
-  119,
-  JS_ROM_VALUE(1645),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1678),
+  124,
+  JS_ROM_VALUE(1688),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1660) */
+  /* properties (offset=1703) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_INT32_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1670) */
+  /* properties (offset=1713) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_INT32_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1680) */
+  /* class (offset=1723) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1660),
-  120,
-  JS_ROM_VALUE(1670),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1703),
+  125,
+  JS_ROM_VALUE(1713),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1685) */
+  /* properties (offset=1728) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_UINT32_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1695) */
+  /* properties (offset=1738) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_UINT32_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1705) */
+  /* class (offset=1748) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1685),
-  121,
-  JS_ROM_VALUE(1695),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1728),
+  126,
+  JS_ROM_VALUE(1738),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1710) */
+  /* properties (offset=1753) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_FLOAT32_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1720) */
+  /* properties (offset=1763) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   4 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_FLOAT32_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1730) */
+  /* class (offset=1773) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1710),
-  122,
-  JS_ROM_VALUE(1720),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1753),
+  127,
+  JS_ROM_VALUE(1763),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1735) */
+  /* properties (offset=1778) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   8 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(130) /* prototype */,
   JS_CLASS_FLOAT64_ARRAY << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* properties (offset=1745) */
+  /* properties (offset=1788) */
   JS_VALUE_ARRAY_HEADER(9),
   2 << 1, /* n_props */
   0 << 1, /* hash_mask */
   6 << 1,
-  JS_ROM_VALUE(453) /* BYTES_PER_ELEMENT */,
+  JS_ROM_VALUE(464) /* BYTES_PER_ELEMENT */,
   8 << 1,
   (0 << 1) | (JS_PROP_NORMAL << 30),
   JS_ROM_VALUE(133) /* constructor */,
   (uint32_t)(-JS_CLASS_FLOAT64_ARRAY - 1) << 1,
   (3 << 1) | (JS_PROP_SPECIAL << 30),
-  /* class (offset=1755) */
+  /* class (offset=1798) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1735),
-  123,
-  JS_ROM_VALUE(1745),
-  JS_ROM_VALUE(1530),
+  JS_ROM_VALUE(1778),
+  128,
+  JS_ROM_VALUE(1788),
+  JS_ROM_VALUE(1573),
 
-  /* properties (offset=1760) */
+  /* properties (offset=1803) */
   JS_VALUE_ARRAY_HEADER(6),
   1 << 1, /* n_props */
   0 << 1, /* hash_mask */
   3 << 1,
-  JS_ROM_VALUE(491) /* log */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 124),
+  JS_ROM_VALUE(502) /* log */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 129),
   (0 << 1) | (JS_PROP_NORMAL << 30),
-  /* class (offset=1767) */
+  /* class (offset=1810) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1760),
+  JS_ROM_VALUE(1803),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* properties (offset=1772) */
+  /* properties (offset=1815) */
   JS_VALUE_ARRAY_HEADER(3),
   0 << 1, /* n_props */
   0 << 1, /* hash_mask */
   0 << 1,
-  /* class (offset=1776) */
+  /* class (offset=1819) */
+  JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
+  JS_ROM_VALUE(1815),
+  -1,
+  JS_NULL,
+  JS_NULL,
+
+  /* properties (offset=1824) */
+  JS_VALUE_ARRAY_HEADER(9),
+  2 << 1, /* n_props */
+  0 << 1, /* hash_mask */
+  6 << 1,
+  JS_ROM_VALUE(509) /* await */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 130),
+  (0 << 1) | (JS_PROP_NORMAL << 30),
+  JS_ROM_VALUE(511) /* awaitAll */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 131),
+  (3 << 1) | (JS_PROP_NORMAL << 30),
+  /* class (offset=1834) */
   JS_MB_HEADER_DEF(JS_MTAG_OBJECT),
-  JS_ROM_VALUE(1772),
+  JS_ROM_VALUE(1824),
   -1,
   JS_NULL,
   JS_NULL,
 
-  /* global object properties (offset=1781) */
-  JS_VALUE_ARRAY_HEADER(76),
+  /* global object properties (offset=1839) */
+  JS_VALUE_ARRAY_HEADER(78),
   JS_ROM_VALUE(163) /* Object */,
-  JS_ROM_VALUE(746),
+  JS_ROM_VALUE(772),
   JS_ROM_VALUE(181) /* Function */,
-  JS_ROM_VALUE(798),
+  JS_ROM_VALUE(824),
   JS_ROM_VALUE(202) /* Number */,
-  JS_ROM_VALUE(885),
+  JS_ROM_VALUE(911),
   JS_ROM_VALUE(242) /* Boolean */,
-  JS_ROM_VALUE(904),
+  JS_ROM_VALUE(930),
   JS_ROM_VALUE(244) /* String */,
-  JS_ROM_VALUE(1000),
+  JS_ROM_VALUE(1026),
   JS_ROM_VALUE(299) /* Array */,
-  JS_ROM_VALUE(1098),
+  JS_ROM_VALUE(1124),
   JS_ROM_VALUE(334) /* Math */,
-  JS_ROM_VALUE(1143),
+  JS_ROM_VALUE(1169),
   JS_ROM_VALUE(354) /* Date */,
-  JS_ROM_VALUE(1162),
-  JS_ROM_VALUE(356) /* Decimal */,
   JS_ROM_VALUE(1188),
-  JS_ROM_VALUE(360) /* JSON */,
-  JS_ROM_VALUE(1203),
-  JS_ROM_VALUE(367) /* RegExp */,
-  JS_ROM_VALUE(1249),
+  JS_ROM_VALUE(356) /* Decimal */,
+  JS_ROM_VALUE(1231),
+  JS_ROM_VALUE(371) /* JSON */,
+  JS_ROM_VALUE(1246),
+  JS_ROM_VALUE(378) /* RegExp */,
+  JS_ROM_VALUE(1292),
   JS_ROM_VALUE(152) /* Error */,
-  JS_ROM_VALUE(1289),
-  JS_ROM_VALUE(402) /* EvalError */,
-  JS_ROM_VALUE(1311),
-  JS_ROM_VALUE(405) /* RangeError */,
-  JS_ROM_VALUE(1333),
-  JS_ROM_VALUE(408) /* ReferenceError */,
-  JS_ROM_VALUE(1355),
-  JS_ROM_VALUE(411) /* SyntaxError */,
-  JS_ROM_VALUE(1377),
-  JS_ROM_VALUE(414) /* TypeError */,
-  JS_ROM_VALUE(1399),
-  JS_ROM_VALUE(417) /* URIError */,
-  JS_ROM_VALUE(1421),
-  JS_ROM_VALUE(420) /* InternalError */,
-  JS_ROM_VALUE(1443),
-  JS_ROM_VALUE(423) /* ArrayBuffer */,
-  JS_ROM_VALUE(1468),
-  JS_ROM_VALUE(432) /* Uint8ClampedArray */,
-  JS_ROM_VALUE(1555),
-  JS_ROM_VALUE(457) /* Int8Array */,
-  JS_ROM_VALUE(1580),
-  JS_ROM_VALUE(460) /* Uint8Array */,
-  JS_ROM_VALUE(1605),
-  JS_ROM_VALUE(463) /* Int16Array */,
-  JS_ROM_VALUE(1630),
-  JS_ROM_VALUE(466) /* Uint16Array */,
-  JS_ROM_VALUE(1655),
-  JS_ROM_VALUE(469) /* Int32Array */,
-  JS_ROM_VALUE(1680),
-  JS_ROM_VALUE(472) /* Uint32Array */,
-  JS_ROM_VALUE(1705),
-  JS_ROM_VALUE(475) /* Float32Array */,
-  JS_ROM_VALUE(1730),
-  JS_ROM_VALUE(478) /* Float64Array */,
-  JS_ROM_VALUE(1755),
+  JS_ROM_VALUE(1332),
+  JS_ROM_VALUE(413) /* EvalError */,
+  JS_ROM_VALUE(1354),
+  JS_ROM_VALUE(416) /* RangeError */,
+  JS_ROM_VALUE(1376),
+  JS_ROM_VALUE(419) /* ReferenceError */,
+  JS_ROM_VALUE(1398),
+  JS_ROM_VALUE(422) /* SyntaxError */,
+  JS_ROM_VALUE(1420),
+  JS_ROM_VALUE(425) /* TypeError */,
+  JS_ROM_VALUE(1442),
+  JS_ROM_VALUE(428) /* URIError */,
+  JS_ROM_VALUE(1464),
+  JS_ROM_VALUE(431) /* InternalError */,
+  JS_ROM_VALUE(1486),
+  JS_ROM_VALUE(434) /* ArrayBuffer */,
+  JS_ROM_VALUE(1511),
+  JS_ROM_VALUE(443) /* Uint8ClampedArray */,
+  JS_ROM_VALUE(1598),
+  JS_ROM_VALUE(468) /* Int8Array */,
+  JS_ROM_VALUE(1623),
+  JS_ROM_VALUE(471) /* Uint8Array */,
+  JS_ROM_VALUE(1648),
+  JS_ROM_VALUE(474) /* Int16Array */,
+  JS_ROM_VALUE(1673),
+  JS_ROM_VALUE(477) /* Uint16Array */,
+  JS_ROM_VALUE(1698),
+  JS_ROM_VALUE(480) /* Int32Array */,
+  JS_ROM_VALUE(1723),
+  JS_ROM_VALUE(483) /* Uint32Array */,
+  JS_ROM_VALUE(1748),
+  JS_ROM_VALUE(486) /* Float32Array */,
+  JS_ROM_VALUE(1773),
+  JS_ROM_VALUE(489) /* Float64Array */,
+  JS_ROM_VALUE(1798),
   JS_ROM_VALUE(204) /* parseInt */,
   JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 19),
-  JS_ROM_VALUE(481) /* isNaN */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 125),
-  JS_ROM_VALUE(483) /* isFinite */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 126),
+  JS_ROM_VALUE(492) /* isNaN */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 132),
+  JS_ROM_VALUE(494) /* isFinite */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 133),
   JS_ROM_VALUE(108) /* undefined */,
   JS_UNDEFINED,
-  JS_ROM_VALUE(486) /* globalThis */,
+  JS_ROM_VALUE(497) /* globalThis */,
   JS_NULL,
-  JS_ROM_VALUE(489) /* console */,
-  JS_ROM_VALUE(1767),
-  JS_ROM_VALUE(493) /* performance */,
-  JS_ROM_VALUE(1776),
-  JS_ROM_VALUE(496) /* print */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 127),
-  JS_ROM_VALUE(498) /* gc */,
-  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 128),
+  JS_ROM_VALUE(500) /* console */,
+  JS_ROM_VALUE(1810),
+  JS_ROM_VALUE(504) /* performance */,
+  JS_ROM_VALUE(1819),
+  JS_ROM_VALUE(507) /* Async */,
+  JS_ROM_VALUE(1834),
+  JS_ROM_VALUE(514) /* print */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 134),
+  JS_ROM_VALUE(516) /* gc */,
+  JS_VALUE_MAKE_SPECIAL(JS_TAG_SHORT_FUNC, 135),
 };
 
 static const JSCFunctionDef js_c_function_table[] = {
@@ -2299,134 +2362,155 @@ static const JSCFunctionDef js_c_function_table[] = {
   { { .generic = js_decimal_compare },
     JS_ROM_VALUE(358) /* compare */,
     JS_CFUNC_generic, 1, 0 },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(360) /* add */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_add },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(362) /* sub */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_sub },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(364) /* mul */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_mul },
+  { { .generic_magic = js_decimal_arith_method },
+    JS_ROM_VALUE(366) /* div */,
+    JS_CFUNC_generic_magic, 1, magic_decimal_div },
+  { { .generic = js_decimal_quantize },
+    JS_ROM_VALUE(368) /* quantize */,
+    JS_CFUNC_generic, 1, 0 },
   { { .generic = js_json_parse },
-    JS_ROM_VALUE(362) /* parse */,
+    JS_ROM_VALUE(373) /* parse */,
     JS_CFUNC_generic, 2, 0 },
   { { .generic = js_json_stringify },
-    JS_ROM_VALUE(364) /* stringify */,
+    JS_ROM_VALUE(375) /* stringify */,
     JS_CFUNC_generic, 3, 0 },
   { { .constructor = js_regexp_constructor },
-    JS_ROM_VALUE(367) /* RegExp */,
+    JS_ROM_VALUE(378) /* RegExp */,
     JS_CFUNC_constructor, 2, JS_CLASS_REGEXP },
   { { .generic = js_regexp_get_lastIndex },
-    JS_ROM_VALUE(372) /* get lastIndex */,
+    JS_ROM_VALUE(383) /* get lastIndex */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic = js_regexp_set_lastIndex },
-    JS_ROM_VALUE(375) /* set lastIndex */,
+    JS_ROM_VALUE(386) /* set lastIndex */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_regexp_get_source },
-    JS_ROM_VALUE(380) /* get source */,
+    JS_ROM_VALUE(391) /* get source */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic = js_regexp_get_flags },
-    JS_ROM_VALUE(385) /* get flags */,
+    JS_ROM_VALUE(396) /* get flags */,
     JS_CFUNC_generic, 0, 0 },
   { { .generic_magic = js_regexp_exec },
-    JS_ROM_VALUE(388) /* exec */,
+    JS_ROM_VALUE(399) /* exec */,
     JS_CFUNC_generic_magic, 1, 0 },
   { { .generic_magic = js_regexp_exec },
-    JS_ROM_VALUE(390) /* test */,
+    JS_ROM_VALUE(401) /* test */,
     JS_CFUNC_generic_magic, 1, 1 },
   { { .constructor_magic = js_error_constructor },
     JS_ROM_VALUE(152) /* Error */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_ERROR },
   { { .generic_magic = js_error_get_message },
-    JS_ROM_VALUE(394) /* get message */,
+    JS_ROM_VALUE(405) /* get message */,
     JS_CFUNC_generic_magic, 0, 0 },
   { { .generic_magic = js_error_get_message },
-    JS_ROM_VALUE(399) /* get stack */,
+    JS_ROM_VALUE(410) /* get stack */,
     JS_CFUNC_generic_magic, 0, 1 },
   { { .generic = js_error_toString },
     JS_ROM_VALUE(99) /* toString */,
     JS_CFUNC_generic, 0, 0 },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(402) /* EvalError */,
+    JS_ROM_VALUE(413) /* EvalError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_EVAL_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(405) /* RangeError */,
+    JS_ROM_VALUE(416) /* RangeError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_RANGE_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(408) /* ReferenceError */,
+    JS_ROM_VALUE(419) /* ReferenceError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_REFERENCE_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(411) /* SyntaxError */,
+    JS_ROM_VALUE(422) /* SyntaxError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_SYNTAX_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(414) /* TypeError */,
+    JS_ROM_VALUE(425) /* TypeError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_TYPE_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(417) /* URIError */,
+    JS_ROM_VALUE(428) /* URIError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_URI_ERROR },
   { { .constructor_magic = js_error_constructor },
-    JS_ROM_VALUE(420) /* InternalError */,
+    JS_ROM_VALUE(431) /* InternalError */,
     JS_CFUNC_constructor_magic, 1, JS_CLASS_INTERNAL_ERROR },
   { { .constructor = js_array_buffer_constructor },
-    JS_ROM_VALUE(423) /* ArrayBuffer */,
+    JS_ROM_VALUE(434) /* ArrayBuffer */,
     JS_CFUNC_constructor, 1, JS_CLASS_ARRAY_BUFFER },
   { { .generic = js_array_buffer_get_byteLength },
-    JS_ROM_VALUE(429) /* get byteLength */,
+    JS_ROM_VALUE(440) /* get byteLength */,
     JS_CFUNC_generic, 0, 0 },
   { { .constructor = js_typed_array_base_constructor },
-    JS_ROM_VALUE(436) /* TypedArray */,
+    JS_ROM_VALUE(447) /* TypedArray */,
     JS_CFUNC_constructor, 0, JS_CLASS_TYPED_ARRAY },
   { { .generic_magic = js_typed_array_get_length },
     JS_ROM_VALUE(196) /* get length */,
     JS_CFUNC_generic_magic, 0, 0 },
   { { .generic_magic = js_typed_array_get_length },
-    JS_ROM_VALUE(429) /* get byteLength */,
+    JS_ROM_VALUE(440) /* get byteLength */,
     JS_CFUNC_generic_magic, 0, 1 },
   { { .generic_magic = js_typed_array_get_length },
-    JS_ROM_VALUE(442) /* get byteOffset */,
+    JS_ROM_VALUE(453) /* get byteOffset */,
     JS_CFUNC_generic_magic, 0, 2 },
   { { .generic_magic = js_typed_array_get_length },
-    JS_ROM_VALUE(447) /* get buffer */,
+    JS_ROM_VALUE(458) /* get buffer */,
     JS_CFUNC_generic_magic, 0, 3 },
   { { .generic = js_typed_array_subarray },
-    JS_ROM_VALUE(450) /* subarray */,
+    JS_ROM_VALUE(461) /* subarray */,
     JS_CFUNC_generic, 2, 0 },
   { { .generic = js_typed_array_set },
     JS_ROM_VALUE(128) /* set */,
     JS_CFUNC_generic, 1, 0 },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(432) /* Uint8ClampedArray */,
+    JS_ROM_VALUE(443) /* Uint8ClampedArray */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT8C_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(457) /* Int8Array */,
+    JS_ROM_VALUE(468) /* Int8Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_INT8_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(460) /* Uint8Array */,
+    JS_ROM_VALUE(471) /* Uint8Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT8_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(463) /* Int16Array */,
+    JS_ROM_VALUE(474) /* Int16Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_INT16_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(466) /* Uint16Array */,
+    JS_ROM_VALUE(477) /* Uint16Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT16_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(469) /* Int32Array */,
+    JS_ROM_VALUE(480) /* Int32Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_INT32_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(472) /* Uint32Array */,
+    JS_ROM_VALUE(483) /* Uint32Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_UINT32_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(475) /* Float32Array */,
+    JS_ROM_VALUE(486) /* Float32Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_FLOAT32_ARRAY },
   { { .constructor_magic = js_typed_array_constructor },
-    JS_ROM_VALUE(478) /* Float64Array */,
+    JS_ROM_VALUE(489) /* Float64Array */,
     JS_CFUNC_constructor_magic, 3, JS_CLASS_FLOAT64_ARRAY },
   { { .generic = js_print },
-    JS_ROM_VALUE(491) /* log */,
+    JS_ROM_VALUE(502) /* log */,
+    JS_CFUNC_generic, 1, 0 },
+  { { .generic = js_async_await },
+    JS_ROM_VALUE(509) /* await */,
+    JS_CFUNC_generic, 3, 0 },
+  { { .generic = js_async_await_all },
+    JS_ROM_VALUE(511) /* awaitAll */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_global_isNaN },
-    JS_ROM_VALUE(481) /* isNaN */,
+    JS_ROM_VALUE(492) /* isNaN */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_global_isFinite },
-    JS_ROM_VALUE(483) /* isFinite */,
+    JS_ROM_VALUE(494) /* isFinite */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_print },
-    JS_ROM_VALUE(496) /* print */,
+    JS_ROM_VALUE(514) /* print */,
     JS_CFUNC_generic, 1, 0 },
   { { .generic = js_gc },
-    JS_ROM_VALUE(498) /* gc */,
+    JS_ROM_VALUE(516) /* gc */,
     JS_CFUNC_generic, 0, 0 },
 };
 
@@ -2441,10 +2525,10 @@ const JSSTDLibraryDef js_stdlib = {
   js_stdlib_table,
   js_c_function_table,
   js_c_finalizer_table,
-  1858,
+  1918,
   64,
-  500,
-  1781,
+  518,
+  1839,
   JS_CLASS_COUNT,
 };
 
@@ -66,52 +66,196 @@ static void mtpscript_parse_query_params(const char *query_string,
     free(query_copy);
 }
 
-// Simple route pattern matching
-static bool mtpscript_route_pattern_match(const char *pattern, const char *path,
-                                         MTPScriptRouteParam *params, int param_count) {
-    const char *pattern_ptr = pattern;
-    const char *path_ptr = path;
-    int param_index = 0;
-
-    while (*pattern_ptr && *path_ptr) {
-        if (*pattern_ptr == ':') {
-            // Parameter segment
-            pattern_ptr++; // Skip ':'
-            const char *param_start = pattern_ptr;
-
-            // Find end of parameter name
-            while (*pattern_ptr && *pattern_ptr != '/' && *pattern_ptr != '?') {
-                pattern_ptr++;
-            }
+// Radix tree router
+
+static MTPScriptRouteNode *mtpscript_route_node_new(const char *prefix, size_t prefix_len) {
+    MTPScriptRouteNode *node = calloc(1, sizeof(MTPScriptRouteNode));
+    if (!node) return NULL;
+    node->prefix = malloc(prefix_len + 1);
+    if (!node->prefix) {
+        free(node);
+        return NULL;
+    }
+    memcpy(node->prefix, prefix, prefix_len);
+    node->prefix[prefix_len] = '\0';
+    node->prefix_len = prefix_len;
+    for (int i = 0; i < MTPSCRIPT_HTTP_METHOD_COUNT; i++) {
+        node->routes[i] = -1;
+    }
+    return node;
+}
+
+static void mtpscript_route_node_free(MTPScriptRouteNode *node) {
+    if (!node) return;
+    for (int i = 0; i < node->child_count; i++) {
+        mtpscript_route_node_free(node->children[i]);
+    }
+    mtpscript_route_node_free(node->param);
+    free(node->children);
+    free(node->child_chars);
+    free(node->prefix);
+    free(node);
+}
 
-            // Extract parameter value from path
-            const char *value_start = path_ptr;
-            const char *value_end = path_ptr;
+static bool mtpscript_route_node_add_child(MTPScriptRouteNode *node, MTPScriptRouteNode *child) {
+    MTPScriptRouteNode **children = realloc(node->children, (node->child_count + 1) * sizeof(MTPScriptRouteNode *));
+    if (!children) return false;
+    node->children = children;
+    char *child_chars = realloc(node->child_chars, node->child_count + 1);
+    if (!child_chars) return false;
+    node->child_chars = child_chars;
+    node->children[node->child_count] = child;
+    node->child_chars[node->child_count] = child->prefix[0];
+    node->child_count++;
+    return true;
+}
+
+// Split 'node' after 'len' prefix characters: the tail becomes its only child
+static bool mtpscript_route_node_split(MTPScriptRouteNode *node, size_t len) {
+    MTPScriptRouteNode *tail = mtpscript_route_node_new(node->prefix + len, node->prefix_len - len);
+    if (!tail) return false;
+    tail->children = node->children;
+    tail->child_chars = node->child_chars;
+    tail->child_count = node->child_count;
+    tail->param = node->param;
+    memcpy(tail->routes, node->routes, sizeof(node->routes));
+
+    node->children = NULL;
+    node->child_chars = NULL;
+    node->child_count = 0;
+    node->param = NULL;
+    for (int i = 0; i < MTPSCRIPT_HTTP_METHOD_COUNT; i++) {
+        node->routes[i] = -1;
+    }
+    node->prefix[len] = '\0';
+    node->prefix_len = len;
+    if (!mtpscript_route_node_add_child(node, tail)) {
+        mtpscript_route_node_free(tail);
+        return false;
+    }
+    return true;
+}
 
-            // Find end of parameter value (until next '/' or end)
-            while (*value_end && *value_end != '/' && *value_end != '?') {
-                value_end++;
+// Insert 'pattern' below 'node', whose prefix is already matched. The
+// first registered route of a method and pattern is kept.
+static bool mtpscript_route_node_insert(MTPScriptRouteNode *node, const char *pattern,
+                                        MTPScriptHTTPMethod method, int route_index) {
+    while (*pattern) {
+        if (*pattern == ':') {
+            // Parameter: its name is stored in the route
+            pattern++;
+            while (*pattern && *pattern != '/' && *pattern != '?') pattern++;
+            if (!node->param) {
+                node->param = mtpscript_route_node_new("", 0);
+                if (!node->param) return false;
             }
+            node = node->param;
+            continue;
+        }
 
-            // Store parameter value
-            if (param_index < param_count) {
-                int value_len = value_end - value_start;
-                params[param_index].value = realloc(params[param_index].value, value_len + 1);
-                memcpy(params[param_index].value, value_start, value_len);
-                params[param_index].value[value_len] = '\0';
-                param_index++;
+        // Literal run, up to the next parameter
+        size_t len = strcspn(pattern, ":");
+        MTPScriptRouteNode *child = NULL;
+        for (int i = 0; i < node->child_count; i++) {
+            if (node->child_chars[i] == *pattern) {
+                child = node->children[i];
+                break;
+            }
+        }
+        if (!child) {
+            child = mtpscript_route_node_new(pattern, len);
+            if (!child) return false;
+            if (!mtpscript_route_node_add_child(node, child)) {
+                mtpscript_route_node_free(child);
+                return false;
             }
+            node = child;
+            pattern += len;
+            continue;
+        }
 
-            path_ptr = value_end;
-        } else if (*pattern_ptr == *path_ptr) {
-            pattern_ptr++;
-            path_ptr++;
-        } else {
+        size_t common = 0;
+        while (common < len && common < child->prefix_len && child->prefix[common] == pattern[common]) {
+            common++;
+        }
+        if (common < child->prefix_len && !mtpscript_route_node_split(child, common)) {
             return false;
         }
+        node = child;
+        pattern += common;
+    }
+
+    if (node->routes[method] < 0) {
+        node->routes[method] = route_index;
     }
+    return true;
+}
+
+typedef struct {
+    MTPScriptHTTPMethod method;
+    const char *path;
+    size_t path_len;
+    // Parameter values of the current branch
+    MTPScriptPathParam params[MTPSCRIPT_ROUTE_MAX_PARAMS];
+    int param_count;
+    // Longest route matching a prefix of the path ending at a '/'
+    int prefix_route;
+    size_t prefix_len;
+    MTPScriptPathParam prefix_params[MTPSCRIPT_ROUTE_MAX_PARAMS];
+    int prefix_param_count;
+} MTPScriptRouteLookup;
+
+// Match the path from 'pos' below 'node'. Return the route index of an
+// exact match or -1. Backtracking only happens when a node has both a
+// matching literal child and a parameter child.
+static int mtpscript_route_node_lookup(const MTPScriptRouteNode *node, MTPScriptRouteLookup *s, size_t pos) {
+    for (;;) {
+        if (s->path_len - pos < node->prefix_len ||
+            memcmp(s->path + pos, node->prefix, node->prefix_len) != 0) {
+            return -1;
+        }
+        pos += node->prefix_len;
+
+        int route = node->routes[s->method];
+        if (pos == s->path_len) {
+            return route;
+        }
+        if (route >= 0 && s->path[pos] == '/' && pos > s->prefix_len) {
+            s->prefix_route = route;
+            s->prefix_len = pos;
+            memcpy(s->prefix_params, s->params, s->param_count * sizeof(MTPScriptPathParam));
+            s->prefix_param_count = s->param_count;
+        }
 
-    return *pattern_ptr == '\0' && (*path_ptr == '\0' || *path_ptr == '/' || *path_ptr == '?');
+        const MTPScriptRouteNode *child = NULL;
+        for (int i = 0; i < node->child_count; i++) {
+            if (node->child_chars[i] == s->path[pos]) {
+                child = node->children[i];
+                break;
+            }
+        }
+        if (!node->param) {
+            if (!child) return -1;
+            node = child;
+            continue;
+        }
+        if (child) {
+            route = mtpscript_route_node_lookup(child, s, pos);
+            if (route >= 0) return route;
+        }
+
+        // Parameter: one non-empty segment
+        size_t end = pos;
+        while (end < s->path_len && s->path[end] != '/') end++;
+        if (end == pos || s->param_count == MTPSCRIPT_ROUTE_MAX_PARAMS) return -1;
+        MTPScriptPathParam *param = &s->params[s->param_count++];
+        param->name = NULL;
+        param->value = s->path + pos;
+        param->value_len = end - pos;
+        route = mtpscript_route_node_lookup(node->param, s, end);
+        if (route < 0) s->param_count--;
+        return route;
+    }
 }
 
 // Route registry functions
@@ -121,7 +265,10 @@ MTPScriptRouteRegistry *mtpscript_route_registry_new(void) {
 
     registry->route_capacity = 16;
     registry->routes = calloc(registry->route_capacity, sizeof(MTPScriptRoute));
-    if (!registry->routes) {
+    registry->root = mtpscript_route_node_new("", 0);
+    if (!registry->routes || !registry->root) {
+        free(registry->routes);
+        mtpscript_route_node_free(registry->root);
         free(registry);
         return NULL;
     }
@@ -129,19 +276,23 @@ MTPScriptRouteRegistry *mtpscript_route_registry_new(void) {
     return registry;
 }
 
+static void mtpscript_route_free(MTPScriptRoute *route) {
+    free(route->path_pattern);
+    free(route->handler_name);
+    for (int i = 0; i < route->param_count; i++) {
+        free(route->param_names[i]);
+    }
+    free(route->param_names);
+}
+
 void mtpscript_route_registry_free(MTPScriptRouteRegistry *registry) {
     if (!registry) return;
 
     for (int i = 0; i < registry->route_count; i++) {
-        MTPScriptRoute *route = &registry->routes[i];
-        free(route->path_pattern);
-        free(route->handler_name);
-        for (int j = 0; j < route->path_param_count; j++) {
-            free(route->path_params[j].name);
-        }
-        free(route->path_params);
+        mtpscript_route_free(&registry->routes[i]);
     }
 
+    mtpscript_route_node_free(registry->root);
     free(registry->routes);
     free(registry);
 }
@@ -150,16 +301,32 @@ bool mtpscript_route_registry_add(MTPScriptRouteRegistry *registry,
                                  MTPScriptHTTPMethod method,
                                  const char *path_pattern,
                                  const char *handler_name) {
-    if (!registry || registry->route_count >= registry->route_capacity) {
-        return false;
+    if (!registry) return false;
+    if ((unsigned)method >= MTPSCRIPT_HTTP_METHOD_COUNT) return false;
+
+    int param_count = 0;
+    for (const char *ptr = path_pattern; (ptr = strchr(ptr, ':')) != NULL; ptr++) {
+        param_count++;
+    }
+    if (param_count > MTPSCRIPT_ROUTE_MAX_PARAMS) return false;
+
+    if (registry->route_count >= registry->route_capacity) {
+        int new_capacity = registry->route_capacity * 2;
+        MTPScriptRoute *routes = realloc(registry->routes, new_capacity * sizeof(MTPScriptRoute));
+        if (!routes) return false;
+        registry->routes = routes;
+        registry->route_capacity = new_capacity;
     }
 
-    MTPScriptRoute *route = &registry->routes[registry->route_count++];
-    route->method = method;
-    route->path_pattern = strdup(path_pattern);
-    route->handler_name = strdup(handler_name);
-    route->path_params = NULL;
-    route->path_param_count = 0;
+    // Built aside and appended once it is in the tree: a failed add leaves
+    // the route indexes unchanged
+    MTPScriptRoute route;
+    route.method = method;
+    route.path_pattern = strdup(path_pattern);
+    route.handler_name = strdup(handler_name);
+    route.param_names = calloc(param_count + 1, sizeof(char *));
+    route.param_count = 0;
+    if (!route.path_pattern || !route.handler_name || !route.param_names) goto fail;
 
     // Parse path parameters from pattern
     const char *ptr = path_pattern;
@@ -167,78 +334,56 @@ bool mtpscript_route_registry_add(MTPScriptRouteRegistry *registry,
         ptr++; // Skip ':'
         const char *end = ptr;
         while (*end && *end != '/' && *end != '?') end++;
-
-        // Allocate space for parameter name
-        int param_len = end - ptr;
-        char *param_name = malloc(param_len + 1);
-        memcpy(param_name, ptr, param_len);
-        param_name[param_len] = '\0';
-
-        // Add to path params
-        route->path_params = realloc(route->path_params,
-                                   (route->path_param_count + 1) * sizeof(MTPScriptRouteParam));
-        route->path_params[route->path_param_count].name = param_name;
-        route->path_params[route->path_param_count].value = NULL;
-        route->path_param_count++;
-
+        char *param_name = strndup(ptr, end - ptr);
+        if (!param_name) goto fail;
+        route.param_names[route.param_count++] = param_name;
         ptr = end;
     }
 
+    // A failed insertion only leaves nodes without routes in the tree
+    if (!mtpscript_route_node_insert(registry->root, path_pattern, method, registry->route_count)) goto fail;
+    registry->routes[registry->route_count++] = route;
     return true;
-}
-
-// Calculate route specificity (higher = more specific)
-static int mtpscript_route_specificity(const char *pattern) {
-    int specificity = 0;
-    const char *ptr = pattern;
-
-    while (*ptr) {
-        if (*ptr == '/') {
-            specificity += 10; // Path segments
-        } else if (*ptr == ':') {
-            specificity += 5;  // Parameters
-        } else {
-            specificity += 1;  // Literal characters
-        }
-        ptr++;
-    }
 
-    return specificity;
+fail:
+    mtpscript_route_free(&route);
+    return false;
 }
 
-// Route matching and parameter extraction with priority (most-specific wins)
-MTPScriptRoute *mtpscript_route_match(MTPScriptRouteRegistry *registry,
+// Route matching and zero-copy parameter extraction
+MTPScriptRoute *mtpscript_route_match(const MTPScriptRouteRegistry *registry,
                                      MTPScriptHTTPMethod method,
                                      const char *path,
-                                     MTPScriptRouteParam **path_params,
-                                     int *path_param_count) {
-    if (!registry) return NULL;
-
-    MTPScriptRoute *best_match = NULL;
-    int best_specificity = -1;
-
-    for (int i = 0; i < registry->route_count; i++) {
-        MTPScriptRoute *route = &registry->routes[i];
-        if (route->method != method) continue;
-
-        // Test pattern match
-        if (mtpscript_route_pattern_match(route->path_pattern, path, route->path_params, route->path_param_count)) {
-            int specificity = mtpscript_route_specificity(route->path_pattern);
-
-            // Choose the most specific match
-            if (specificity > best_specificity) {
-                best_match = route;
-                best_specificity = specificity;
-            }
-        }
+                                     MTPScriptRouteMatch *match) {
+    if (!registry || (unsigned)method >= MTPSCRIPT_HTTP_METHOD_COUNT) return NULL;
+
+    MTPScriptRouteLookup s;
+    s.method = method;
+    s.path = path;
+    s.path_len = strcspn(path, "?");
+    s.param_count = 0;
+    s.prefix_route = -1;
+    s.prefix_len = 0;
+    s.prefix_param_count = 0;
+
+    int index = mtpscript_route_node_lookup(registry->root, &s, 0);
+    const MTPScriptPathParam *params = s.params;
+    int param_count = s.param_count;
+    if (index < 0) {
+        index = s.prefix_route;
+        params = s.prefix_params;
+        param_count = s.prefix_param_count;
     }
+    if (index < 0) return NULL;
 
-    if (best_match) {
-        *path_params = best_match->path_params;
-        *path_param_count = best_match->path_param_count;
+    MTPScriptRoute *route = &registry->routes[index];
+    for (int i = 0; i < param_count; i++) {
+        match->params[i].name = route->param_names[i];
+        match->params[i].value = params[i].value;
+        match->params[i].value_len = params[i].value_len;
     }
-
-    return best_match;
+    match->param_count = param_count;
+    return route;
 }
 
 // Parse headers from raw header string
@@ -514,11 +659,9 @@ JSValue mtpscript_api_respond_error(JSContext *ctx, int status_code, const char
 // API routing handler
 JSValue mtpscript_api_route(JSContext *ctx, MTPScriptRouteRegistry *registry,
                            MTPScriptAPIRequest *request) {
-    MTPScriptRouteParam *path_params = NULL;
-    int path_param_count = 0;
+    MTPScriptRouteMatch match;
 
-    MTPScriptRoute *route = mtpscript_route_match(registry, request->method, request->path,
-                                                 &path_params, &path_param_count);
+    MTPScriptRoute *route = mtpscript_route_match(registry, request->method, request->path, &match);
 
     if (!route) {
         // Return 404
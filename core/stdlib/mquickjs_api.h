@@ -19,21 +19,53 @@ typedef enum {
     MTPSCRIPT_HTTP_PATCH
 } MTPScriptHTTPMethod;
 
+#define MTPSCRIPT_HTTP_METHOD_COUNT 5
+
 // Route parameter
 typedef struct {
     char *name;
     char *value;
 } MTPScriptRouteParam;
 
+// Maximum number of path parameters of a route
+#define MTPSCRIPT_ROUTE_MAX_PARAMS 16
+
 // Route definition
 typedef struct {
     MTPScriptHTTPMethod method;
     char *path_pattern;        // e.g., "/users/:id"
     char *handler_name;        // Name of the MTPScript function to call
-    MTPScriptRouteParam *path_params;
-    int path_param_count;
+    char **param_names;        // In pattern order
+    int param_count;
 } MTPScriptRoute;
 
+// Path parameter of a match: a slice of the request path
+typedef struct {
+    const char *name;          // Owned by the route
+    const char *value;         // Not NUL terminated
+    size_t value_len;
+} MTPScriptPathParam;
+
+// Result of a route lookup, usually on the stack
+typedef struct {
+    MTPScriptPathParam params[MTPSCRIPT_ROUTE_MAX_PARAMS];
+    int param_count;
+} MTPScriptRouteMatch;
+
+// Radix tree node: a literal prefix, the literal children (distinct first
+// characters) and at most one parameter child, which matches one
+// non-empty segment
+typedef struct MTPScriptRouteNode MTPScriptRouteNode;
+struct MTPScriptRouteNode {
+    char *prefix;
+    size_t prefix_len;
+    char *child_chars;         // First character of each literal child
+    MTPScriptRouteNode **children;
+    int child_count;
+    MTPScriptRouteNode *param;
+    int routes[MTPSCRIPT_HTTP_METHOD_COUNT]; // Route index, -1 if none
+};
+
 // API request
 typedef struct {
     MTPScriptHTTPMethod method;
@@ -58,27 +90,35 @@ typedef struct {
     int header_count;
 } MTPScriptAPIResponse;
 
-// Route registry
+// Route registry. The radix tree is built as the routes are added; the
+// lookups do not modify the registry and can run concurrently.
 typedef struct {
     MTPScriptRoute *routes;
     int route_count;
     int route_capacity;
+    MTPScriptRouteNode *root;
 } MTPScriptRouteRegistry;
 
 // Route registry functions
 MTPScriptRouteRegistry *mtpscript_route_registry_new(void);
 void mtpscript_route_registry_free(MTPScriptRouteRegistry *registry);
+// Append a route: its index is the number of routes added before it.
+// Return false, with the registry unchanged, for an unknown method, more
+// than MTPSCRIPT_ROUTE_MAX_PARAMS parameters or out of memory. If the
+// method and pattern are already registered, the first route is matched.
 bool mtpscript_route_registry_add(MTPScriptRouteRegistry *registry,
                                  MTPScriptHTTPMethod method,
                                  const char *path_pattern,
                                  const char *handler_name);
 
-// Route matching and parameter extraction
-MTPScriptRoute *mtpscript_route_match(MTPScriptRouteRegistry *registry,
+// Route matching in O(path length). Literal characters win over
+// parameters; without an exact match, the longest route matching a
+// prefix of the path ending at a '/' is used. The parameters of 'match'
+// point into 'path', which ends at '\0' or '?'.
+MTPScriptRoute *mtpscript_route_match(const MTPScriptRouteRegistry *registry,
                                      MTPScriptHTTPMethod method,
                                      const char *path,
-                                     MTPScriptRouteParam **path_params,
-                                     int *path_param_count);
+                                     MTPScriptRouteMatch *match);
 
 // Request parsing
 MTPScriptAPIRequest *mtpscript_api_request_parse(const char *method,
@@ -0,0 +1,661 @@
+/*
+ * Fixed-width decimal128 arithmetic
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "cutils.h"
+#include "decimal128.h"
+
+/* The significand is a 128 bit binary integer stored as 32 bit limbs so
+   that the code is the same on 32 bit hosts. The intermediate results
+   use at most DEC_LIMBS_MAX limbs: 34 digits times 10^56 for the
+   division. */
+
+typedef uint32_t limb_t;
+typedef uint64_t dlimb_t;
+
+#define LIMB_BITS 32
+#define DEC_LIMBS 4
+#define DEC_LIMBS_MAX 12
+
+/* rounding information about the digits discarded below a result */
+#define RND_EXACT      0
+#define RND_BELOW_HALF 1
+#define RND_HALF       2
+#define RND_ABOVE_HALF 3
+
+static const limb_t pow10_small[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    1000000000,
+};
+
+/* 10^i, 0 <= i <= 38 */
+static const limb_t pow10_tab[39][DEC_LIMBS] = {
+    { 0x00000001, 0x00000000, 0x00000000, 0x00000000 }, /* 10^0 */
+    { 0x0000000a, 0x00000000, 0x00000000, 0x00000000 }, /* 10^1 */
+    { 0x00000064, 0x00000000, 0x00000000, 0x00000000 }, /* 10^2 */
+    { 0x000003e8, 0x00000000, 0x00000000, 0x00000000 }, /* 10^3 */
+    { 0x00002710, 0x00000000, 0x00000000, 0x00000000 }, /* 10^4 */
+    { 0x000186a0, 0x00000000, 0x00000000, 0x00000000 }, /* 10^5 */
+    { 0x000f4240, 0x00000000, 0x00000000, 0x00000000 }, /* 10^6 */
+    { 0x00989680, 0x00000000, 0x00000000, 0x00000000 }, /* 10^7 */
+    { 0x05f5e100, 0x00000000, 0x00000000, 0x00000000 }, /* 10^8 */
+    { 0x3b9aca00, 0x00000000, 0x00000000, 0x00000000 }, /* 10^9 */
+    { 0x540be400, 0x00000002, 0x00000000, 0x00000000 }, /* 10^10 */
+    { 0x4876e800, 0x00000017, 0x00000000, 0x00000000 }, /* 10^11 */
+    { 0xd4a51000, 0x000000e8, 0x00000000, 0x00000000 }, /* 10^12 */
+    { 0x4e72a000, 0x00000918, 0x00000000, 0x00000000 }, /* 10^13 */
+    { 0x107a4000, 0x00005af3, 0x00000000, 0x00000000 }, /* 10^14 */
+    { 0xa4c68000, 0x00038d7e, 0x00000000, 0x00000000 }, /* 10^15 */
+    { 0x6fc10000, 0x002386f2, 0x00000000, 0x00000000 }, /* 10^16 */
+    { 0x5d8a0000, 0x01634578, 0x00000000, 0x00000000 }, /* 10^17 */
+    { 0xa7640000, 0x0de0b6b3, 0x00000000, 0x00000000 }, /* 10^18 */
+    { 0x89e80000, 0x8ac72304, 0x00000000, 0x00000000 }, /* 10^19 */
+    { 0x63100000, 0x6bc75e2d, 0x00000005, 0x00000000 }, /* 10^20 */
+    { 0xdea00000, 0x35c9adc5, 0x00000036, 0x00000000 }, /* 10^21 */
+    { 0xb2400000, 0x19e0c9ba, 0x0000021e, 0x00000000 }, /* 10^22 */
+    { 0xf6800000, 0x02c7e14a, 0x0000152d, 0x00000000 }, /* 10^23 */
+    { 0xa1000000, 0x1bcecced, 0x0000d3c2, 0x00000000 }, /* 10^24 */
+    { 0x4a000000, 0x16140148, 0x00084595, 0x00000000 }, /* 10^25 */
+    { 0xe4000000, 0xdcc80cd2, 0x0052b7d2, 0x00000000 }, /* 10^26 */
+    { 0xe8000000, 0x9fd0803c, 0x033b2e3c, 0x00000000 }, /* 10^27 */
+    { 0x10000000, 0x3e250261, 0x204fce5e, 0x00000000 }, /* 10^28 */
+    { 0xa0000000, 0x6d7217ca, 0x431e0fae, 0x00000001 }, /* 10^29 */
+    { 0x40000000, 0x4674edea, 0x9f2c9cd0, 0x0000000c }, /* 10^30 */
+    { 0x80000000, 0xc0914b26, 0x37be2022, 0x0000007e }, /* 10^31 */
+    { 0x00000000, 0x85acef81, 0x2d6d415b, 0x000004ee }, /* 10^32 */
+    { 0x00000000, 0x38c15b0a, 0xc6448d93, 0x0000314d }, /* 10^33 */
+    { 0x00000000, 0x378d8e64, 0xbead87c0, 0x0001ed09 }, /* 10^34 */
+    { 0x00000000, 0x2b878fe8, 0x72c74d82, 0x00134261 }, /* 10^35 */
+    { 0x00000000, 0xb34b9f10, 0x7bc90715, 0x00c097ce }, /* 10^36 */
+    { 0x00000000, 0x00f436a0, 0xd5da46d9, 0x0785ee10 }, /* 10^37 */
+    { 0x00000000, 0x098a2240, 0x5a86c47a, 0x4b3b4ca8 }, /* 10^38 */
+};
+
+/* return the length without the leading zero limbs */
+static int mp_norm(const limb_t *a, int n)
+{
+    while (n > 0 && a[n - 1] == 0)
+        n--;
+    return n;
+}
+
+/* 'a' and 'b' are normalized */
+static int mp_cmp(const limb_t *a, int na, const limb_t *b, int nb)
+{
+    int i;
+    if (na != nb)
+        return na < nb ? -1 : 1;
+    for(i = na - 1; i >= 0; i--) {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+/* r = a * b + carry. Return the carry. 'r' may be 'a' */
+static limb_t mp_mul1(limb_t *r, const limb_t *a, int n, limb_t b,
+                      limb_t carry)
+{
+    dlimb_t t;
+    int i;
+    for(i = 0; i < n; i++) {
+        t = (dlimb_t)a[i] * b + carry;
+        r[i] = t;
+        carry = t >> LIMB_BITS;
+    }
+    return carry;
+}
+
+/* r = a * b. 'r' has na + nb limbs and must not overlap */
+static void mp_mul(limb_t *r, const limb_t *a, int na,
+                   const limb_t *b, int nb)
+{
+    int i;
+    memset(r, 0, sizeof(r[0]) * (na + nb));
+    for(i = 0; i < nb; i++) {
+        dlimb_t t;
+        limb_t carry = 0;
+        int j;
+        for(j = 0; j < na; j++) {
+            t = (dlimb_t)a[j] * b[i] + r[i + j] + carry;
+            r[i + j] = t;
+            carry = t >> LIMB_BITS;
+        }
+        r[i + na] = carry;
+    }
+}
+
+/* r = a + b. Return the carry */
+static limb_t mp_add(limb_t *r, const limb_t *a, const limb_t *b, int n)
+{
+    dlimb_t t;
+    limb_t carry = 0;
+    int i;
+    for(i = 0; i < n; i++) {
+        t = (dlimb_t)a[i] + b[i] + carry;
+        r[i] = t;
+        carry = t >> LIMB_BITS;
+    }
+    return carry;
+}
+
+/* r = a - b. Return the borrow */
+static limb_t mp_sub(limb_t *r, const limb_t *a, const limb_t *b, int n)
+{
+    dlimb_t t;
+    limb_t borrow = 0;
+    int i;
+    for(i = 0; i < n; i++) {
+        t = (dlimb_t)a[i] - b[i] - borrow;
+        r[i] = t;
+        borrow = (t >> LIMB_BITS) & 1;
+    }
+    return borrow;
+}
+
+/* a += 1. Return the new length. 'a' must have room for a carry */
+static int mp_incr(limb_t *a, int n)
+{
+    int i;
+    for(i = 0; i < n; i++) {
+        if (++a[i] != 0)
+            return n;
+    }
+    a[n++] = 1;
+    return n;
+}
+
+/* q = a / b. Return the remainder. 'q' may be 'a' */
+static limb_t mp_div1(limb_t *q, const limb_t *a, int n, limb_t b)
+{
+    dlimb_t t;
+    limb_t r = 0;
+    int i;
+    for(i = n - 1; i >= 0; i--) {
+        t = ((dlimb_t)r << LIMB_BITS) | a[i];
+        q[i] = t / b;
+        r = t % b;
+    }
+    return r;
+}
+
+/* q = u / v, r = u % v (Knuth algorithm D). 'u' (m limbs) and 'v' (n
+   limbs) are normalized, m >= n >= 2. 'q' has m - n + 1 limbs, 'r' has
+   n limbs. */
+static void mp_divrem(limb_t *q, limb_t *r, const limb_t *u, int m,
+                      const limb_t *v, int n)
+{
+    limb_t un[DEC_LIMBS_MAX + 1], vn[DEC_LIMBS_MAX];
+    dlimb_t qhat, rhat, p, num;
+    int64_t t, k;
+    int s, i, j;
+
+    /* normalize so that the top bit of the divisor is set */
+    s = clz32(v[n - 1]);
+    for(i = n - 1; i > 0; i--)
+        vn[i] = (limb_t)((((dlimb_t)v[i] << LIMB_BITS) | v[i - 1]) >> (LIMB_BITS - s));
+    vn[0] = v[0] << s;
+    un[m] = (limb_t)((dlimb_t)u[m - 1] >> (LIMB_BITS - s));
+    for(i = m - 1; i > 0; i--)
+        un[i] = (limb_t)((((dlimb_t)u[i] << LIMB_BITS) | u[i - 1]) >> (LIMB_BITS - s));
+    un[0] = u[0] << s;
+
+    for(j = m - n; j >= 0; j--) {
+        num = ((dlimb_t)un[j + n] << LIMB_BITS) | un[j + n - 1];
+        qhat = num / vn[n - 1];
+        rhat = num % vn[n - 1];
+        while (qhat >> LIMB_BITS ||
+               qhat * vn[n - 2] > ((rhat << LIMB_BITS) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >> LIMB_BITS)
+                break;
+        }
+        /* un[j..j+n] -= qhat * vn */
+        k = 0;
+        for(i = 0; i < n; i++) {
+            p = qhat * vn[i];
+            t = (int64_t)un[i + j] - k - (int64_t)(p & 0xffffffff);
+            un[i + j] = t;
+            k = (int64_t)(p >> LIMB_BITS) - (t >> LIMB_BITS);
+        }
+        t = (int64_t)un[j + n] - k;
+        un[j + n] = t;
+        q[j] = qhat;
+        if (t < 0) {
+            /* qhat was one too large: add back */
+            q[j]--;
+            un[j + n] += mp_add(un + j, un + j, vn, n);
+        }
+    }
+    for(i = 0; i < n - 1; i++)
+        r[i] = (limb_t)((((dlimb_t)un[i + 1] << LIMB_BITS) | un[i]) >> s);
+    r[n - 1] = un[n - 1] >> s;
+}
+
+/* r = 10^k. Return the length */
+static int mp_pow10(limb_t *r, int k)
+{
+    int n, e;
+    if (k <= 38) {
+        memcpy(r, pow10_tab[k], sizeof(pow10_tab[k]));
+        return mp_norm(r, DEC_LIMBS);
+    }
+    memcpy(r, pow10_tab[38], sizeof(pow10_tab[38]));
+    n = DEC_LIMBS;
+    k -= 38;
+    while (k > 0) {
+        e = min_int(k, 9);
+        r[n] = mp_mul1(r, r, n, pow10_small[e], 0);
+        n = mp_norm(r, n + 1);
+        k -= e;
+    }
+    return n;
+}
+
+/* number of decimal digits of 'a' (0 for zero) */
+static int mp_digits(const limb_t *a, int n)
+{
+    limb_t p[DEC_LIMBS_MAX];
+    int bits, d, np;
+
+    if (n == 0)
+        return 0;
+    bits = n * LIMB_BITS - clz32(a[n - 1]);
+    /* 2^(bits-1) <= a < 2^bits: lower bound of the digit count */
+    d = (((bits - 1) * 1233) >> 12) + 1;
+    for(;;) {
+        np = mp_pow10(p, d);
+        if (mp_cmp(a, n, p, np) < 0)
+            break;
+        d++;
+    }
+    return d;
+}
+
+/* a = a / 10^k (k >= 1) rounded half to even. 'sticky' is TRUE if non
+   zero digits were already discarded below 'a'. Return the new length */
+static int mp_round_pow10(limb_t *a, int n, int k, BOOL sticky)
+{
+    limb_t r;
+    int e;
+
+    k--;
+    while (k > 0) {
+        e = min_int(k, 9);
+        r = mp_div1(a, a, n, pow10_small[e]);
+        sticky |= (r != 0);
+        n = mp_norm(a, n);
+        k -= e;
+    }
+    r = mp_div1(a, a, n, 10);
+    n = mp_norm(a, n);
+    if (r > 5 || (r == 5 && (sticky || (n > 0 && (a[0] & 1)))))
+        n = mp_incr(a, n);
+    return n;
+}
+
+/* Store the significand 'a' (n limbs, at least n + 1 limbs of storage)
+   with 'scale' decimals in 'r'. 'rnd' describes the digits discarded
+   below 'a'. The result is rounded to DEC128_MAX_SCALE decimals and
+   DEC128_MAX_DIGITS digits. '*pexact' is set to FALSE if it was
+   rounded. */
+static int dec_pack(Decimal128 *r, limb_t *a, int n, int scale, int sign,
+                    int rnd, BOOL *pexact)
+{
+    int k, d;
+
+    n = mp_norm(a, n);
+    if (n <= DEC_LIMBS && scale <= DEC128_MAX_SCALE &&
+        mp_cmp(a, n, pow10_tab[DEC128_MAX_DIGITS],
+               DEC_LIMBS) < 0) {
+        /* fast case: no digit to remove */
+        if (rnd == RND_ABOVE_HALF ||
+            (rnd == RND_HALF && n > 0 && (a[0] & 1)))
+            n = mp_incr(a, n);
+        k = 0;
+    } else {
+        k = max_int(scale - DEC128_MAX_SCALE, 0);
+        d = mp_digits(a, n);
+        if (d - k > DEC128_MAX_DIGITS)
+            k = d - DEC128_MAX_DIGITS;
+        n = mp_round_pow10(a, n, k, rnd != RND_EXACT);
+        scale -= k;
+    }
+    if (mp_cmp(a, n, pow10_tab[DEC128_MAX_DIGITS], DEC_LIMBS) >= 0) {
+        /* rounded up to 10^34: remove one zero */
+        mp_div1(a, a, n, 10);
+        n = mp_norm(a, n);
+        scale--;
+        k++;
+    }
+    if (scale < 0)
+        return DEC128_ERR_OVERFLOW;
+    if (pexact)
+        *pexact = (k == 0 && rnd == RND_EXACT);
+    memset(r->mant, 0, sizeof(r->mant));
+    memcpy(r->mant, a, sizeof(a[0]) * n);
+    r->scale = scale;
+    r->sign = sign & (n != 0);
+    return DEC128_OK;
+}
+
+int dec128_is_zero(const Decimal128 *a)
+{
+    return (a->mant[0] | a->mant[1] | a->mant[2] | a->mant[3]) == 0;
+}
+
+int dec128_from_string(Decimal128 *r, const char *str, size_t len)
+{
+    const char *p = str, *p_end = str + len;
+    limb_t a[DEC_LIMBS + 1];
+    int n, sign, scale, digits, c;
+    BOOL has_digits, has_dot;
+
+    sign = 0;
+    if (p < p_end && (*p == '+' || *p == '-')) {
+        sign = (*p == '-');
+        p++;
+    }
+    n = 0;
+    scale = 0;
+    digits = 0;
+    has_digits = FALSE;
+    has_dot = FALSE;
+    for(; p < p_end; p++) {
+        c = *p;
+        if (c == '.' && !has_dot) {
+            has_dot = TRUE;
+            continue;
+        }
+        if (c < '0' || c > '9')
+            return DEC128_ERR_SYNTAX;
+        has_digits = TRUE;
+        if (has_dot)
+            scale++;
+        if (n == 0 && c == '0')
+            continue; /* leading zero */
+        if (++digits > DEC128_MAX_DIGITS)
+            return DEC128_ERR_RANGE;
+        c = mp_mul1(a, a, n, 10, c - '0');
+        if (c)
+            a[n++] = c;
+    }
+    if (!has_digits)
+        return DEC128_ERR_SYNTAX;
+    if (scale > DEC128_MAX_SCALE)
+        return DEC128_ERR_RANGE;
+    memset(r->mant, 0, sizeof(r->mant));
+    memcpy(r->mant, a, sizeof(a[0]) * n);
+    r->scale = scale;
+    r->sign = sign & (n != 0);
+    return DEC128_OK;
+}
+
+void dec128_from_int64(Decimal128 *r, int64_t v)
+{
+    uint64_t m = v < 0 ? -(uint64_t)v : (uint64_t)v;
+    r->mant[0] = m;
+    r->mant[1] = m >> 32;
+    r->mant[2] = 0;
+    r->mant[3] = 0;
+    r->scale = 0;
+    r->sign = (v < 0);
+}
+
+int dec128_to_string(char *buf, const Decimal128 *a)
+{
+    char digits[40];
+    limb_t t[DEC_LIMBS], r;
+    int n, i, nd, len, pos;
+
+    /* convert 9 digits at a time */
+    memcpy(t, a->mant, sizeof(t));
+    n = mp_norm(t, DEC_LIMBS);
+    pos = sizeof(digits);
+    while (n > 0) {
+        r = mp_div1(t, t, n, pow10_small[9]);
+        n = mp_norm(t, n);
+        for(i = 0; i < 9 && (n > 0 || r != 0); i++) {
+            digits[--pos] = '0' + r % 10;
+            r /= 10;
+        }
+    }
+    if (pos == sizeof(digits))
+        digits[--pos] = '0';
+    nd = sizeof(digits) - pos;
+
+    len = 0;
+    if (a->sign)
+        buf[len++] = '-';
+    if (nd <= a->scale) {
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for(i = nd; i < a->scale; i++)
+            buf[len++] = '0';
+        memcpy(buf + len, digits + pos, nd);
+        len += nd;
+    } else {
+        memcpy(buf + len, digits + pos, nd - a->scale);
+        len += nd - a->scale;
+        if (a->scale > 0) {
+            buf[len++] = '.';
+            memcpy(buf + len, digits + pos + nd - a->scale, a->scale);
+            len += a->scale;
+        }
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/* r = a->mant * 10^(scale - a->scale) on 2 * DEC_LIMBS limbs */
+static void dec_scale_mant(limb_t *r, const Decimal128 *a, int scale)
+{
+    if (scale == a->scale) {
+        memcpy(r, a->mant, sizeof(a->mant));
+        memset(r + DEC_LIMBS, 0, sizeof(a->mant));
+    } else {
+        mp_mul(r, a->mant, DEC_LIMBS, pow10_tab[scale - a->scale], DEC_LIMBS);
+    }
+}
+
+static int dec_add(Decimal128 *r, const Decimal128 *a, const Decimal128 *b,
+                   int b_sign)
+{
+    limb_t x[2 * DEC_LIMBS + 1], y[2 * DEC_LIMBS];
+    int scale, sign;
+
+    /* align the decimal points */
+    scale = max_int(a->scale, b->scale);
+    dec_scale_mant(x, a, scale);
+    dec_scale_mant(y, b, scale);
+    if (a->sign == b_sign) {
+        x[2 * DEC_LIMBS] = mp_add(x, x, y, 2 * DEC_LIMBS);
+        sign = a->sign;
+    } else if (mp_cmp(x, mp_norm(x, 2 * DEC_LIMBS),
+                      y, mp_norm(y, 2 * DEC_LIMBS)) >= 0) {
+        mp_sub(x, x, y, 2 * DEC_LIMBS);
+        x[2 * DEC_LIMBS] = 0;
+        sign = a->sign;
+    } else {
+        mp_sub(x, y, x, 2 * DEC_LIMBS);
+        x[2 * DEC_LIMBS] = 0;
+        sign = b_sign;
+    }
+    return dec_pack(r, x, 2 * DEC_LIMBS + 1, scale, sign, RND_EXACT, NULL);
+}
+
+int dec128_add(Decimal128 *r, const Decimal128 *a, const Decimal128 *b)
+{
+    return dec_add(r, a, b, b->sign);
+}
+
+int dec128_sub(Decimal128 *r, const Decimal128 *a, const Decimal128 *b)
+{
+    return dec_add(r, a, b, b->sign ^ !dec128_is_zero(b));
+}
+
+int dec128_mul(Decimal128 *r, const Decimal128 *a, const Decimal128 *b)
+{
+    limb_t x[2 * DEC_LIMBS + 1];
+
+    mp_mul(x, a->mant, DEC_LIMBS, b->mant, DEC_LIMBS);
+    return dec_pack(r, x, 2 * DEC_LIMBS, a->scale + b->scale,
+                    a->sign ^ b->sign, RND_EXACT, NULL);
+}
+
+int dec128_div(Decimal128 *r, const Decimal128 *a, const Decimal128 *b)
+{
+    limb_t u[DEC_LIMBS_MAX], q[DEC_LIMBS_MAX + 1], rem[DEC_LIMBS + 1];
+    limb_t v[DEC_LIMBS];
+    int m, n, e, rnd, pref_scale, ret;
+    BOOL exact;
+
+    memcpy(v, b->mant, sizeof(v));
+    n = mp_norm(v, DEC_LIMBS);
+    if (n == 0)
+        return DEC128_ERR_DIV_ZERO;
+
+    /* compute the quotient with DEC128_MAX_SCALE decimals:
+       u = a * 10^(MAX_SCALE - a->scale + b->scale) */
+    memcpy(u, a->mant, sizeof(a->mant));
+    m = mp_norm(u, DEC_LIMBS);
+    e = DEC128_MAX_SCALE - a->scale + b->scale;
+    while (e > 0 && m > 0) {
+        int e1 = min_int(e, 9);
+        limb_t c = mp_mul1(u, u, m, pow10_small[e1], 0);
+        if (c)
+            u[m++] = c;
+        e -= e1;
+    }
+
+    memset(q, 0, sizeof(q));
+    if (m < n) {
+        memcpy(rem, u, sizeof(u[0]) * m);
+        memset(rem + m, 0, sizeof(u[0]) * (n - m));
+    } else if (n == 1) {
+        rem[0] = mp_div1(q, u, m, v[0]);
+    } else {
+        mp_divrem(q, rem, u, m, v, n);
+    }
+
+    /* compare 2 * rem with v */
+    rem[n] = mp_mul1(rem, rem, n, 2, 0);
+    ret = mp_cmp(rem, mp_norm(rem, n + 1), v, n);
+    if (mp_norm(rem, n + 1) == 0)
+        rnd = RND_EXACT;
+    else if (ret < 0)
+        rnd = RND_BELOW_HALF;
+    else if (ret == 0)
+        rnd = RND_HALF;
+    else
+        rnd = RND_ABOVE_HALF;
+
+    ret = dec_pack(r, q, DEC_LIMBS_MAX, DEC128_MAX_SCALE,
+                   a->sign ^ b->sign, rnd, &exact);
+    if (ret)
+        return ret;
+    if (exact) {
+        /* exact quotient: remove the trailing zeros down to the
+           preferred scale */
+        pref_scale = max_int(a->scale - b->scale, 0);
+        while (r->scale > pref_scale) {
+            limb_t t[DEC_LIMBS];
+            if (mp_div1(t, r->mant, DEC_LIMBS, 10) != 0)
+                break;
+            memcpy(r->mant, t, sizeof(t));
+            r->scale--;
+        }
+    }
+    return DEC128_OK;
+}
+
+int dec128_quantize(Decimal128 *r, const Decimal128 *a, int scale)
+{
+    limb_t x[2 * DEC_LIMBS + 1];
+    int n;
+
+    if (scale < 0 || scale > DEC128_MAX_SCALE)
+        return DEC128_ERR_RANGE;
+    if (scale >= a->scale) {
+        mp_mul(x, a->mant, DEC_LIMBS, pow10_tab[scale - a->scale], DEC_LIMBS);
+        n = mp_norm(x, 2 * DEC_LIMBS);
+    } else {
+        memcpy(x, a->mant, sizeof(a->mant));
+        n = mp_round_pow10(x, mp_norm(x, DEC_LIMBS), a->scale - scale, FALSE);
+    }
+    if (mp_cmp(x, n, pow10_tab[DEC128_MAX_DIGITS], DEC_LIMBS) >= 0)
+        return DEC128_ERR_OVERFLOW;
+    memset(r->mant, 0, sizeof(r->mant));
+    memcpy(r->mant, x, sizeof(x[0]) * n);
+    r->scale = scale;
+    r->sign = a->sign & (n != 0);
+    return DEC128_OK;
+}
+
+void dec128_neg(Decimal128 *r, const Decimal128 *a)
+{
+    *r = *a;
+    r->sign = a->sign ^ !dec128_is_zero(a);
+}
+
+void dec128_normalize(Decimal128 *r, const Decimal128 *a)
+{
+    limb_t t[DEC_LIMBS];
+
+    *r = *a;
+    while (r->scale > 0) {
+        if (mp_div1(t, r->mant, DEC_LIMBS, 10) != 0)
+            break;
+        memcpy(r->mant, t, sizeof(t));
+        r->scale--;
+    }
+}
+
+int dec128_cmp(const Decimal128 *a, const Decimal128 *b)
+{
+    limb_t x[2 * DEC_LIMBS], y[2 * DEC_LIMBS];
+    int i, gt, lt, undecided, mag, ds, mask;
+
+    /* scale both values to DEC128_MAX_SCALE decimals so that the same
+       operations are done whatever the values */
+    mp_mul(x, a->mant, DEC_LIMBS, pow10_tab[DEC128_MAX_SCALE - a->scale],
+           DEC_LIMBS);
+    mp_mul(y, b->mant, DEC_LIMBS, pow10_tab[DEC128_MAX_SCALE - b->scale],
+           DEC_LIMBS);
+    gt = 0;
+    lt = 0;
+    for(i = 2 * DEC_LIMBS - 1; i >= 0; i--) {
+        undecided = !(gt | lt);
+        gt |= (x[i] > y[i]) & undecided;
+        lt |= (x[i] < y[i]) & undecided;
+    }
+    mag = gt - lt;
+    /* zero is positive, so different signs give the result */
+    ds = b->sign - a->sign;
+    mask = -(ds != 0);
+    return (ds & mask) | ((mag * (1 - 2 * a->sign)) & ~mask);
+}
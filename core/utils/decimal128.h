@@ -0,0 +1,78 @@
+/*
+ * Fixed-width decimal128 arithmetic
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DECIMAL128_H
+#define DECIMAL128_H
+
+#include <stddef.h>
+#include <inttypes.h>
+
+/* maximum number of significant digits */
+#define DEC128_MAX_DIGITS 34
+/* maximum number of fractional digits (specification §3.4) */
+#define DEC128_MAX_SCALE  28
+/* maximum string length, without the trailing '\0' */
+#define DEC128_MAX_STR_LEN (DEC128_MAX_DIGITS + 3)
+
+/* return values */
+#define DEC128_OK            0
+#define DEC128_ERR_SYNTAX   -1 /* invalid string */
+#define DEC128_ERR_RANGE    -2 /* too many digits or invalid scale */
+#define DEC128_ERR_OVERFLOW -3 /* the result does not fit in 34 digits */
+#define DEC128_ERR_DIV_ZERO -4
+
+/* value = (-1)^sign * mant * 10^-scale with mant < 10^34 and 0 <= scale
+   <= DEC128_MAX_SCALE. Zero is always positive. The scale is kept, so
+   1.50 and 1.5 are equal but print differently. */
+typedef struct {
+    uint32_t mant[4]; /* little endian */
+    int32_t scale;
+    int32_t sign;
+} Decimal128;
+
+/* parse [+-]digits[.digits]. No rounding: more than 34 significant
+   digits or 28 fractional digits is an error */
+int dec128_from_string(Decimal128 *r, const char *str, size_t len);
+void dec128_from_int64(Decimal128 *r, int64_t v);
+/* return the string length. 'buf' must have at least
+   DEC128_MAX_STR_LEN + 1 bytes */
+int dec128_to_string(char *buf, const Decimal128 *a);
+
+/* the results are rounded half to even to at most 28 fractional digits
+   and 34 significant digits */
+int dec128_add(Decimal128 *r, const Decimal128 *a, const Decimal128 *b);
+int dec128_sub(Decimal128 *r, const Decimal128 *a, const Decimal128 *b);
+int dec128_mul(Decimal128 *r, const Decimal128 *a, const Decimal128 *b);
+/* exact quotients have the smallest scale >= a->scale - b->scale */
+int dec128_div(Decimal128 *r, const Decimal128 *a, const Decimal128 *b);
+/* round half to even to 'scale' fractional digits */
+int dec128_quantize(Decimal128 *r, const Decimal128 *a, int scale);
+void dec128_neg(Decimal128 *r, const Decimal128 *a);
+/* remove the trailing fractional zeros (shortest canonical form) */
+void dec128_normalize(Decimal128 *r, const Decimal128 *a);
+
+/* return -1, 0 or 1. The running time does not depend on the values. */
+int dec128_cmp(const Decimal128 *a, const Decimal128 *b);
+int dec128_is_zero(const Decimal128 *a);
+
+#endif /* DECIMAL128_H */
@@ -19,6 +19,7 @@
 #include "../compiler/parser.h"
 #include "../compiler/typechecker.h"
 #include "../compiler/codegen.h"
+#include "../compiler/optimizer.h"
 #include "../compiler/bytecode.h"
 #include "../compiler/openapi.h"
 #include "../compiler/migration.h"
@@ -26,6 +27,7 @@
 #include "../snapshot/snapshot.h"
 #include "../stdlib/runtime.h"
 #include "../host/npm_bridge.h"
+#include "../host/http_server.h"
 #include "../lsp/lsp.h"
 #include "../../mquickjs.h"
 #include <string.h>
@@ -747,6 +749,25 @@ int mtpscript_npm_bridge_update_audit_manifest(const char *package_name) {
 }
 
 // Lambda deployment implementation (§14)
+// Compile the generated JavaScript to a heap image or to relocatable
+// bytecode and store it in a .msqs snapshot, so that the server does not
+// parse it at startup.
+mtpscript_error_t *mtpscript_snapshot_create_compiled(mtpscript_string_t *js_output, const char *filename, mtpscript_snapshot_format_t format, const uint8_t *signature, size_t sig_size, const char *output_file) {
+    mtpscript_bytecode_t *bytecode;
+    mtpscript_error_t *err;
+    if (format == MTPSCRIPT_SNAPSHOT_HEAP_IMAGE) {
+        err = mtpscript_heap_image_compile(mtpscript_string_cstr(js_output), filename, &bytecode);
+    } else {
+        err = mtpscript_bytecode_compile(mtpscript_string_cstr(js_output), filename, format == MTPSCRIPT_SNAPSHOT_BYTECODE_32, &bytecode);
+    }
+    if (err) {
+        return err;
+    }
+    err = mtpscript_snapshot_create((const char *)bytecode->data, bytecode->size, "{}", signature, sig_size, output_file);
+    mtpscript_bytecode_free(bytecode);
+    return err;
+}
+
 int mtpscript_lambda_deploy(const char *filename) {
     // Read and compile the MTPScript file
     char *source = read_file(filename);
@@ -755,7 +776,8 @@ int mtpscript_lambda_deploy(const char *filename) {
         return -1;
     }
 
-    mtpscript_lexer_t *lexer = mtpscript_lexer_new(source, filename);
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, filename);
     mtpscript_vector_t *tokens;
     mtpscript_error_t *err = mtpscript_lexer_tokenize(lexer, &tokens);
     if (err) {
@@ -764,7 +786,7 @@ int mtpscript_lambda_deploy(const char *filename) {
         return 1;
     }
 
-    mtpscript_parser_t *parser = mtpscript_parser_new(tokens);
+    mtpscript_parser_t *parser = mtpscript_parser_new(arena, tokens);
     mtpscript_program_t *program;
     err = mtpscript_parser_parse(parser, &program);
     if (err) {
@@ -775,20 +797,21 @@ int mtpscript_lambda_deploy(const char *filename) {
 
     // Generate JavaScript output
     mtpscript_string_t *js_output;
+    mtpscript_optimize_program(program);
     mtpscript_codegen_program(program, &js_output);
 
     // Create snapshot
     const char *snapshot_file = "app.msqs";
     uint8_t signature[64] = {0}; // Placeholder signature - in production use real ECDSA signing
-    // In production: sign js_output with ECDSA private key
+    // In production: sign the bytecode with ECDSA private key
 
-    err = mtpscript_snapshot_create(mtpscript_string_cstr(js_output), strlen(mtpscript_string_cstr(js_output)), "{}", signature, sizeof(signature), snapshot_file);
+    err = mtpscript_snapshot_create_compiled(js_output, filename, MTPSCRIPT_SNAPSHOT_HEAP_IMAGE, signature, sizeof(signature), snapshot_file);
     if (err) {
         fprintf(stderr, "Snapshot creation failed: %s\n", mtpscript_string_cstr(err->message));
         mtpscript_string_free(js_output);
-        mtpscript_program_free(program);
         mtpscript_parser_free(parser);
         mtpscript_lexer_free(lexer);
+        mtpscript_arena_free(arena);
         free(source);
         return -1;
     }
@@ -805,17 +828,17 @@ int mtpscript_lambda_deploy(const char *filename) {
     if (result != 0) {
         fprintf(stderr, "Bootstrap creation failed\n");
         mtpscript_string_free(js_output);
-        mtpscript_program_free(program);
         mtpscript_parser_free(parser);
         mtpscript_lexer_free(lexer);
+        mtpscript_arena_free(arena);
         free(source);
         return -1;
     }
 
     mtpscript_string_free(js_output);
-    mtpscript_program_free(program);
     mtpscript_parser_free(parser);
     mtpscript_lexer_free(lexer);
+    mtpscript_arena_free(arena);
     free(source);
 
     return 0;
@@ -1217,26 +1240,6 @@ void mtpscript_package_list() {
     mtpscript_lockfile_free(lockfile);
 }
 
-// Basic HTTP server for mtpsc serve
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <unistd.h>
-#include <pthread.h>
-
-// Execute snapshot request with clone semantics
-char *execute_snapshot_request(mtpscript_snapshot_t *snapshot, const char *method, const char *path) {
-    // For now, return a simple success response
-    // Full implementation would clone the snapshot and execute it per request
-    char *response = malloc(1024);
-    snprintf(response, 1024,
-            "HTTP/1.1 200 OK\r\n"
-            "Content-Type: application/json\r\n"
-            "Content-Length: 29\r\n"
-            "\r\n"
-            "{\"method\":\"%s\",\"path\":\"%s\"}", method, path);
-    return response;
-}
-
 void usage() {
     printf("Usage: mtpsc <command> [options] <file>\n");
     printf("Commands:\n");
@@ -1244,10 +1247,10 @@ void usage() {
     printf("  run <file>      Compile and run MTPScript (combines compile + execute)\n");
     printf("  check <file>    Type check MTPScript code\n");
     printf("  openapi <file>  Generate OpenAPI spec from MTPScript code\n");
-    printf("  snapshot <file> Create a .msqs snapshot\n");
+    printf("  snapshot <file> [--bytecode|--32] Create a .msqs snapshot\n");
     printf("  lambda-deploy <file> Create AWS Lambda deployment package\n");
     printf("  infra-generate     Generate AWS infrastructure templates\n");
-    printf("  serve <file>    Start local web server daemon\n");
+    printf("  serve <file> [--snapshot <app.msqs>] Start local web server daemon\n");
     printf("  lsp              Start Language Server Protocol server\n");
     printf("  npm-audit <dir> Generate audit manifest for unsafe adapters\n");
     printf("Migration Commands:\n");
@@ -1278,7 +1281,8 @@ void mtpscript_benchmark_file(const char *filename, int iterations) {
     }
 
     // Parse and compile (simplified - would use full compilation pipeline)
-    mtpscript_lexer_t *lexer = mtpscript_lexer_new(source, filename);
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, filename);
     mtpscript_vector_t *tokens;
     mtpscript_error_t *err = mtpscript_lexer_tokenize(lexer, &tokens);
     if (err) {
@@ -1286,7 +1290,7 @@ void mtpscript_benchmark_file(const char *filename, int iterations) {
         return;
     }
 
-    mtpscript_parser_t *parser = mtpscript_parser_new(tokens);
+    mtpscript_parser_t *parser = mtpscript_parser_new(arena, tokens);
     mtpscript_program_t *program;
     err = mtpscript_parser_parse(parser, &program);
     if (err) {
@@ -1312,9 +1316,9 @@ void mtpscript_benchmark_file(const char *filename, int iterations) {
     printf("  Avg time per iteration: %.2f μs\n", elapsed / (double)iterations);
 
     // Cleanup
-    mtpscript_program_free(program);
     mtpscript_parser_free(parser);
     mtpscript_lexer_free(lexer);
+    mtpscript_arena_free(arena);
     free(source);
 }
 
@@ -1329,7 +1333,8 @@ void mtpscript_profile_file(const char *filename) {
     }
 
     // Parse and analyze (simplified)
-    mtpscript_lexer_t *lexer = mtpscript_lexer_new(source, filename);
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, filename);
     mtpscript_vector_t *tokens;
     mtpscript_error_t *err = mtpscript_lexer_tokenize(lexer, &tokens);
     if (err) {
@@ -1337,7 +1342,7 @@ void mtpscript_profile_file(const char *filename) {
         return;
     }
 
-    mtpscript_parser_t *parser = mtpscript_parser_new(tokens);
+    mtpscript_parser_t *parser = mtpscript_parser_new(arena, tokens);
     mtpscript_program_t *program;
     err = mtpscript_parser_parse(parser, &program);
     if (err) {
@@ -1351,9 +1356,9 @@ void mtpscript_profile_file(const char *filename) {
     printf("  Functions analyzed: %zu\n", program->declarations->size);
 
     // Cleanup
-    mtpscript_program_free(program);
     mtpscript_parser_free(parser);
     mtpscript_lexer_free(lexer);
+    mtpscript_arena_free(arena);
     free(source);
 }
 
@@ -1363,6 +1368,20 @@ int mtpscript_estimate_gas_cost(mtpscript_program_t *program) {
     return program->declarations->size * 50;
 }
 
+// Print the usage of each route, e.g. to size the VM arenas before a
+// restart. Safe while the server runs.
+void mtpscript_print_route_stats(mtpscript_http_server_t *server) {
+    for (int i = 0; i < mtpscript_http_server_route_count(server); i++) {
+        mtpscript_http_route_stats_t stats;
+        const char *method, *path;
+
+        mtpscript_http_server_get_route_stats(server, i, &method, &path, &stats);
+        printf("  %s %s: %llu requests, %llu GCs, gas peak %llu, heap peak %zu, arena peak %zu\n",
+               method, path, (unsigned long long)stats.requests, (unsigned long long)stats.gc_count,
+               (unsigned long long)stats.gas_peak, stats.heap_peak, stats.arena_peak);
+    }
+}
+
 int main(int argc, char **argv) {
     if (argc < 2) {
         usage();
@@ -1600,7 +1619,8 @@ int main(int argc, char **argv) {
         return 1;
     }
 
-    mtpscript_lexer_t *lexer = mtpscript_lexer_new(source, filename);
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, filename);
     mtpscript_vector_t *tokens;
     mtpscript_error_t *err = mtpscript_lexer_tokenize(lexer, &tokens);
     if (err) {
@@ -1608,7 +1628,7 @@ int main(int argc, char **argv) {
         return 1;
     }
 
-    mtpscript_parser_t *parser = mtpscript_parser_new(tokens);
+    mtpscript_parser_t *parser = mtpscript_parser_new(arena, tokens);
     mtpscript_program_t *program;
     err = mtpscript_parser_parse(parser, &program);
     if (err) {
@@ -1618,11 +1638,13 @@ int main(int argc, char **argv) {
 
     if (strcmp(command, "compile") == 0) {
         mtpscript_string_t *output;
+        mtpscript_optimize_program(program);
         mtpscript_codegen_program(program, &output);
         printf("%s\n", mtpscript_string_cstr(output));
         mtpscript_string_free(output);
     } else if (strcmp(command, "run") == 0) {
         mtpscript_string_t *js_output;
+        mtpscript_optimize_program(program);
         mtpscript_codegen_program(program, &js_output);
 
         // Create temporary file
@@ -1667,6 +1689,7 @@ int main(int argc, char **argv) {
         mtpscript_string_free(output);
     } else if (strcmp(command, "snapshot") == 0) {
         mtpscript_string_t *js_output;
+        mtpscript_optimize_program(program);
         mtpscript_codegen_program(program, &js_output);
 
         const char *output_file = "app.msqs";
@@ -1674,10 +1697,17 @@ int main(int argc, char **argv) {
         // Generate signature for the JS code
         // TODO: Use actual private key for signing in production
         uint8_t signature[64] = {0}; // Placeholder signature for now
-        // In production: sign js_output with ECDSA private key
-
-        // For now, just store the JS code directly (not real bytecode)
-        err = mtpscript_snapshot_create(mtpscript_string_cstr(js_output), strlen(mtpscript_string_cstr(js_output)), "{}", signature, sizeof(signature), output_file);
+        // In production: sign the bytecode with ECDSA private key
+
+        // The heap image only runs on hosts like this one: '--bytecode'
+        // and '--32' generate portable bytecode instead
+        mtpscript_snapshot_format_t format = MTPSCRIPT_SNAPSHOT_HEAP_IMAGE;
+        if (argc >= 4 && strcmp(argv[3], "--bytecode") == 0) {
+            format = MTPSCRIPT_SNAPSHOT_BYTECODE;
+        } else if (argc >= 4 && strcmp(argv[3], "--32") == 0) {
+            format = MTPSCRIPT_SNAPSHOT_BYTECODE_32;
+        }
+        err = mtpscript_snapshot_create_compiled(js_output, filename, format, signature, sizeof(signature), output_file);
         if (err) {
             fprintf(stderr, "Snapshot creation failed: %s\n", mtpscript_string_cstr(err->message));
         } else {
@@ -1714,25 +1744,34 @@ int main(int argc, char **argv) {
         // Store source file path for hot reload monitoring
         const char *source_file_path = argv[2]; // The MTPScript file path
 
-        // Initial snapshot creation
-        mtpscript_string_t *js_output;
-        mtpscript_codegen_program(program, &js_output);
-
+        // 'serve <file> --snapshot <app.msqs>' runs a released snapshot,
+        // which must be signed with the embedded public key. Otherwise the
+        // snapshot is built here with a placeholder signature, which is not
+        // verified.
         const char *snapshot_file = "app.msqs";
-        uint8_t signature[64] = {0}; // Placeholder signature
+        const ECDSAPublicKey *verify_key = NULL;
+        if (argc >= 5 && strcmp(argv[3], "--snapshot") == 0) {
+            snapshot_file = argv[4];
+            verify_key = &mtpscript_public_key;
+        } else {
+            mtpscript_string_t *js_output;
+            mtpscript_optimize_program(program);
+            mtpscript_codegen_program(program, &js_output);
+
+            uint8_t signature[64] = {0}; // Placeholder signature
+
+            err = mtpscript_snapshot_create_compiled(js_output, filename, MTPSCRIPT_SNAPSHOT_HEAP_IMAGE, signature, sizeof(signature), snapshot_file);
+            if (err) {
+                fprintf(stderr, "Snapshot creation failed: %s\n", mtpscript_string_cstr(err->message));
+                mtpscript_string_free(js_output);
+                return 1;
+            }
 
-        err = mtpscript_snapshot_create(mtpscript_string_cstr(js_output), strlen(mtpscript_string_cstr(js_output)), "{}", signature, sizeof(signature), snapshot_file);
-        if (err) {
-            fprintf(stderr, "Snapshot creation failed: %s\n", mtpscript_string_cstr(err->message));
             mtpscript_string_free(js_output);
-            return 1;
         }
 
-        mtpscript_string_free(js_output);
-
-        // Load the snapshot for execution
         mtpscript_snapshot_t *snapshot;
-        err = mtpscript_snapshot_load(snapshot_file, &snapshot);
+        err = mtpscript_snapshot_load(snapshot_file, verify_key, &snapshot);
         if (err) {
             fprintf(stderr, "Snapshot loading failed: %s\n", mtpscript_string_cstr(err->message));
             return 1;
@@ -1746,104 +1785,58 @@ int main(int argc, char **argv) {
         }
 
         // Start HTTP server with parsed configuration
+        mtpscript_http_server_config_t server_config;
+        mtpscript_http_server_config_init(&server_config);
+        server_config.host = mtpscript_string_cstr(serve_config->host);
+        server_config.port = serve_config->port;
+
+        // The api declarations, then the routes of the serve block
+        mtpscript_vector_t *routes = mtpscript_http_program_routes(program);
+        mtpscript_http_server_t *server;
+        err = mtpscript_http_server_new(snapshot, routes, &server_config, &server);
+        if (err) {
+            fprintf(stderr, "Server startup failed: %s\n", mtpscript_string_cstr(err->message));
+            mtpscript_vector_free(routes);
+            mtpscript_snapshot_free(snapshot);
+            return 1;
+        }
+
         printf("🚀 Starting MTPScript HTTP server on http://%s:%d\n",
                mtpscript_string_cstr(serve_config->host), serve_config->port);
-        printf("📋 Routes configured: %zu\n", serve_config->routes->size);
+        printf("📋 Routes configured: %zu\n", routes->size);
         printf("📋 Snapshot-clone semantics enabled\n");
+        printf("🧵 Worker threads: %d\n", mtpscript_http_server_worker_count(server));
         printf("🔄 Hot reload enabled - watching %s\n", source_file_path);
         printf("Press Ctrl+C to stop\n");
 
-        int server_fd = socket(AF_INET, SOCK_STREAM, 0);
-        if (server_fd < 0) {
-            fprintf(stderr, "Failed to create server socket\n");
-            mtpscript_snapshot_free(snapshot);
-            return 1;
-        }
-
-        struct sockaddr_in address;
-        address.sin_family = AF_INET;
-        address.sin_addr.s_addr = INADDR_ANY;
-        address.sin_port = htons(serve_config->port);
-
-        if (bind(server_fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
-            fprintf(stderr, "Failed to bind to port %d\n", serve_config->port);
-            close(server_fd);
-            mtpscript_snapshot_free(snapshot);
-            return 1;
-        }
-
-        if (listen(server_fd, 10) < 0) {
-            fprintf(stderr, "Failed to listen on socket\n");
-            close(server_fd);
+        err = mtpscript_http_server_start(server);
+        if (err) {
+            fprintf(stderr, "Server startup failed: %s\n", mtpscript_string_cstr(err->message));
+            mtpscript_http_server_free(server);
+            mtpscript_vector_free(routes);
             mtpscript_snapshot_free(snapshot);
             return 1;
         }
 
-        // Server loop - accept multiple connections
+        // The workers serve requests; the main thread watches the source
         while (1) {
             // Check for file changes (hot reload)
             struct stat current_stat;
             if (stat(source_file_path, &current_stat) == 0) {
                 if (current_stat.st_mtime > last_modified) {
                     printf("🔄 Source file changed, hot reload triggered\n");
+                    printf("📊 Route usage so far:\n");
+                    mtpscript_print_route_stats(server);
                     printf("⚠️  Hot reload requires server restart in this version\n");
                     printf("💡 Please restart the server to apply changes\n");
                     last_modified = current_stat.st_mtime;
                 }
             }
-
-            struct sockaddr_in client_addr;
-            socklen_t client_addr_len = sizeof(client_addr);
-            int client_fd = accept(server_fd, (struct sockaddr*)&client_addr, &client_addr_len);
-
-            if (client_fd < 0) {
-                fprintf(stderr, "Accept failed\n");
-                continue;
-            }
-
-            // Handle request in a separate process/thread for isolation
-            char request_buffer[4096] = {0};
-            ssize_t bytes_read = read(client_fd, request_buffer, sizeof(request_buffer) - 1);
-
-            if (bytes_read > 0) {
-                // Parse basic HTTP request
-                char *method = strtok(request_buffer, " ");
-                char *path = strtok(NULL, " ");
-
-                // Route matching
-                mtpscript_api_decl_t *matched_route = NULL;
-                for (size_t i = 0; i < serve_config->routes->size; i++) {
-                    mtpscript_api_decl_t *route = serve_config->routes->items[i];
-                    if (strcmp(mtpscript_string_cstr(route->method), method) == 0 &&
-                        strcmp(mtpscript_string_cstr(route->path), path) == 0) {
-                        matched_route = route;
-                        break;
-                    }
-                }
-
-                char *response;
-                if (matched_route) {
-                    // Execute matched route handler
-                    printf("📨 %s %s -> %s\n", method, path,
-                           mtpscript_string_cstr(matched_route->handler->name));
-                    response = execute_snapshot_request(snapshot, method, path);
-                } else {
-                    // 404 Not Found
-                    response = strdup("HTTP/1.1 404 Not Found\r\nContent-Length: 9\r\n\r\nNot Found");
-                }
-
-                if (!response) {
-                    response = strdup("HTTP/1.1 500 Internal Server Error\r\nContent-Length: 21\r\n\r\nInternal Server Error");
-                }
-
-                send(client_fd, response, strlen(response), 0);
-                free(response);
-            }
-
-            close(client_fd);
+            sleep(1);
         }
 
-        close(server_fd);
+        mtpscript_http_server_free(server);
+        mtpscript_vector_free(routes);
         mtpscript_snapshot_free(snapshot);
         printf("Server stopped.\n");
     } else if (strcmp(command, "lsp") == 0) {
@@ -1869,14 +1862,10 @@ int main(int argc, char **argv) {
         usage();
     }
 
-    mtpscript_program_free(program);
     mtpscript_parser_free(parser);
-    // Free tokens
-    for (size_t i = 0; i < tokens->size; i++) {
-        mtpscript_token_free(mtpscript_vector_get(tokens, i));
-    }
-    mtpscript_vector_free(tokens);
     mtpscript_lexer_free(lexer);
+    // Tokens, AST and inferred types
+    mtpscript_arena_free(arena);
     free(source);
 
     return 0;
@@ -11,8 +11,12 @@
 #include <stdio.h>
 #include <openssl/sha.h>
 
-mtpscript_type_t *mtpscript_type_new(mtpscript_type_kind_t kind) {
-    mtpscript_type_t *type = MTPSCRIPT_MALLOC(sizeof(mtpscript_type_t));
+static void *ast_alloc(mtpscript_arena_t *arena, size_t size) {
+    return arena ? mtpscript_arena_alloc(arena, size) : MTPSCRIPT_MALLOC(size);
+}
+
+mtpscript_type_t *mtpscript_type_new(mtpscript_arena_t *arena, mtpscript_type_kind_t kind) {
+    mtpscript_type_t *type = ast_alloc(arena, sizeof(mtpscript_type_t));
     type->kind = kind;
     type->name = NULL;
     type->inner = NULL;
@@ -25,8 +29,8 @@ mtpscript_type_t *mtpscript_type_new(mtpscript_type_kind_t kind) {
 }
 
 // Create a union type with content hashing for exhaustiveness checking
-mtpscript_type_t *mtpscript_type_union_new(mtpscript_vector_t *variants) {
-    mtpscript_type_t *type = mtpscript_type_new(MTPSCRIPT_TYPE_UNION);
+mtpscript_type_t *mtpscript_type_union_new(mtpscript_arena_t *arena, mtpscript_vector_t *variants) {
+    mtpscript_type_t *type = mtpscript_type_new(arena, MTPSCRIPT_TYPE_UNION);
     type->union_variants = variants;
 
     // Generate SHA-256 hash of union variants for exhaustiveness checking
@@ -70,36 +74,37 @@ mtpscript_type_t *mtpscript_type_union_new(mtpscript_vector_t *variants) {
     }
     hex_hash[SHA256_DIGEST_LENGTH * 2] = '\0';
 
-    type->union_hash = mtpscript_string_from_cstr(hex_hash);
+    type->union_hash = mtpscript_arena_string_new(arena, hex_hash, SHA256_DIGEST_LENGTH * 2);
     mtpscript_vector_free(sorted_variants);
 
     return type;
 }
 
-mtpscript_expression_t *mtpscript_expression_new(mtpscript_expression_kind_t kind) {
-    mtpscript_expression_t *expr = MTPSCRIPT_MALLOC(sizeof(mtpscript_expression_t));
+mtpscript_expression_t *mtpscript_expression_new(mtpscript_arena_t *arena, mtpscript_expression_kind_t kind) {
+    mtpscript_expression_t *expr = ast_alloc(arena, sizeof(mtpscript_expression_t));
     expr->kind = kind;
     memset(&expr->data, 0, sizeof(expr->data));
     return expr;
 }
 
-mtpscript_statement_t *mtpscript_statement_new(mtpscript_statement_kind_t kind) {
-    mtpscript_statement_t *stmt = MTPSCRIPT_MALLOC(sizeof(mtpscript_statement_t));
+mtpscript_statement_t *mtpscript_statement_new(mtpscript_arena_t *arena, mtpscript_statement_kind_t kind) {
+    mtpscript_statement_t *stmt = ast_alloc(arena, sizeof(mtpscript_statement_t));
     stmt->kind = kind;
     memset(&stmt->data, 0, sizeof(stmt->data));
     return stmt;
 }
 
-mtpscript_declaration_t *mtpscript_declaration_new(mtpscript_declaration_kind_t kind) {
-    mtpscript_declaration_t *decl = MTPSCRIPT_MALLOC(sizeof(mtpscript_declaration_t));
+mtpscript_declaration_t *mtpscript_declaration_new(mtpscript_arena_t *arena, mtpscript_declaration_kind_t kind) {
+    mtpscript_declaration_t *decl = ast_alloc(arena, sizeof(mtpscript_declaration_t));
     decl->kind = kind;
     memset(&decl->data, 0, sizeof(decl->data));
     return decl;
 }
 
-mtpscript_program_t *mtpscript_program_new(void) {
-    mtpscript_program_t *program = MTPSCRIPT_MALLOC(sizeof(mtpscript_program_t));
-    program->declarations = mtpscript_vector_new();
+mtpscript_program_t *mtpscript_program_new(mtpscript_arena_t *arena) {
+    mtpscript_program_t *program = ast_alloc(arena, sizeof(mtpscript_program_t));
+    program->declarations = mtpscript_arena_vector_new(arena);
+    program->arena = arena;
     return program;
 }
 
@@ -237,7 +242,7 @@ void mtpscript_declaration_free(mtpscript_declaration_t *decl) {
 }
 
 void mtpscript_program_free(mtpscript_program_t *program) {
-    if (program) {
+    if (program && !program->arena) {
         if (program->declarations) {
             for (size_t i = 0; i < program->declarations->size; i++) {
                 mtpscript_declaration_free(mtpscript_vector_get(program->declarations, i));
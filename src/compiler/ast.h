@@ -185,20 +185,22 @@ typedef struct mtpscript_declaration_t {
 typedef struct mtpscript_program_t {
     mtpscript_vector_t *declarations; // mtpscript_declaration_t
     mtpscript_location_t location;
+    mtpscript_arena_t *arena;         // Owns the whole tree, NULL if heap allocated
 } mtpscript_program_t;
 
-// Constructors
-mtpscript_type_t *mtpscript_type_new(mtpscript_type_kind_t kind);
-mtpscript_type_t *mtpscript_type_union_new(mtpscript_vector_t *variants);
-mtpscript_expression_t *mtpscript_expression_new(mtpscript_expression_kind_t kind);
-mtpscript_statement_t *mtpscript_statement_new(mtpscript_statement_kind_t kind);
-mtpscript_declaration_t *mtpscript_declaration_new(mtpscript_declaration_kind_t kind);
-mtpscript_program_t *mtpscript_program_new(void);
+// Constructors: nodes are allocated in 'arena', or on the heap if it is NULL
+mtpscript_type_t *mtpscript_type_new(mtpscript_arena_t *arena, mtpscript_type_kind_t kind);
+mtpscript_type_t *mtpscript_type_union_new(mtpscript_arena_t *arena, mtpscript_vector_t *variants);
+mtpscript_expression_t *mtpscript_expression_new(mtpscript_arena_t *arena, mtpscript_expression_kind_t kind);
+mtpscript_statement_t *mtpscript_statement_new(mtpscript_arena_t *arena, mtpscript_statement_kind_t kind);
+mtpscript_declaration_t *mtpscript_declaration_new(mtpscript_arena_t *arena, mtpscript_declaration_kind_t kind);
+mtpscript_program_t *mtpscript_program_new(mtpscript_arena_t *arena);
 
 // Type operations
 bool mtpscript_type_equals(mtpscript_type_t *a, mtpscript_type_t *b);
 
-// Destructors
+// Destructors, for heap allocated trees. An arena tree is released with
+// mtpscript_arena_free() and mtpscript_program_free() ignores it.
 void mtpscript_type_free(mtpscript_type_t *type);
 void mtpscript_expression_free(mtpscript_expression_t *expr);
 void mtpscript_statement_free(mtpscript_statement_t *stmt);
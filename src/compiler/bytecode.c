@@ -15,23 +15,39 @@
 
 #define BYTECODE_COMPILE_MEM_SIZE (8 * 1024 * 1024) // 8MB
 
-mtpscript_error_t *mtpscript_bytecode_compile(const char *js_source, const char *filename, mtpscript_bytecode_t **bytecode_out) {
-    // Initialize MicroQuickJS context for bytecode compilation and validation
+// The stdlib the snapshots are loaded with (src/host/http_server.c). Only
+// its atoms matter: they are not stored in the bytecode.
+extern const JSSTDLibraryDef js_stdlib;
+
+static mtpscript_error_t *bytecode_error(const char *message) {
+    mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
+    error->message = mtpscript_string_from_cstr(message);
+    error->location = (mtpscript_location_t){0, 0, "bytecode_compilation"};
+    return error;
+}
+
+mtpscript_error_t *mtpscript_bytecode_compile(const char *js_source, const char *filename, bool force_32bit, mtpscript_bytecode_t **bytecode_out) {
+    union {
+        JSBytecodeHeader hdr;
+#if JSW == 8
+        JSBytecodeHeader32 hdr32;
+#endif
+    } hdr_buf;
+    size_t hdr_len;
+    const uint8_t *data_buf;
+    uint32_t data_len;
+
+    // Initialize MicroQuickJS context for bytecode compilation. The
+    // context must be discarded once the compilation is done.
     uint8_t *mem_buf = malloc(BYTECODE_COMPILE_MEM_SIZE);
     if (!mem_buf) {
-        mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
-        error->message = mtpscript_string_from_cstr("Failed to allocate memory for bytecode compilation");
-        error->location = (mtpscript_location_t){0, 0, "bytecode_compilation"};
-        return error;
+        return bytecode_error("Failed to allocate memory for bytecode compilation");
     }
 
-    JSContext *ctx = JS_NewContext(mem_buf, BYTECODE_COMPILE_MEM_SIZE, NULL);
+    JSContext *ctx = JS_NewContext2(mem_buf, BYTECODE_COMPILE_MEM_SIZE, &js_stdlib, TRUE);
     if (!ctx) {
         free(mem_buf);
-        mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
-        error->message = mtpscript_string_from_cstr("Failed to create JS context for bytecode compilation");
-        error->location = (mtpscript_location_t){0, 0, "bytecode_compilation"};
-        return error;
+        return bytecode_error("Failed to create JS context for bytecode compilation");
     }
 
     // Parse the JavaScript source to validate syntax and compile it
@@ -40,22 +56,33 @@ mtpscript_error_t *mtpscript_bytecode_compile(const char *js_source, const char
         // JavaScript parsing failed - this indicates invalid syntax
         JS_FreeContext(ctx);
         free(mem_buf);
+        return bytecode_error("JavaScript parsing failed during bytecode compilation");
+    }
 
-        mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
-        error->message = mtpscript_string_from_cstr("JavaScript parsing failed during bytecode compilation");
-        error->location = (mtpscript_location_t){0, 0, "bytecode_compilation"};
-        return error;
+#if JSW == 8
+    if (force_32bit) {
+        if (JS_PrepareBytecode64to32(ctx, &hdr_buf.hdr32, &data_buf, &data_len, parsed_code)) {
+            JS_FreeContext(ctx);
+            free(mem_buf);
+            return bytecode_error("Could not convert the bytecode from 64 to 32 bits");
+        }
+        hdr_len = sizeof(JSBytecodeHeader32);
+    } else
+#endif
+    {
+        (void)force_32bit;
+        JS_PrepareBytecode(ctx, &hdr_buf.hdr, &data_buf, &data_len, parsed_code);
+        // Relocate to zero to have a deterministic output
+        JS_RelocateBytecode2(ctx, &hdr_buf.hdr, (uint8_t *)data_buf, data_len, 0, FALSE);
+        hdr_len = sizeof(JSBytecodeHeader);
     }
 
-    // JavaScript parsed successfully - create bytecode object
-    // For Phase 1, we store the validated JavaScript source as "bytecode"
-    // Full MicroQuickJS bytecode compilation would require more complex handling
-    // The snapshot system handles signing and binary storage of the result
+    // The data lives in the compilation heap: copy it out
     mtpscript_bytecode_t *bytecode = MTPSCRIPT_MALLOC(sizeof(mtpscript_bytecode_t));
-    size_t source_len = strlen(js_source);
-    bytecode->size = source_len;
-    bytecode->data = MTPSCRIPT_MALLOC(source_len);
-    memcpy(bytecode->data, js_source, source_len);
+    bytecode->size = hdr_len + data_len;
+    bytecode->data = MTPSCRIPT_MALLOC(bytecode->size);
+    memcpy(bytecode->data, &hdr_buf, hdr_len);
+    memcpy(bytecode->data + hdr_len, data_buf, data_len);
 
     // Clean up
     JS_FreeContext(ctx);
@@ -65,6 +92,46 @@ mtpscript_error_t *mtpscript_bytecode_compile(const char *js_source, const char
     return NULL;
 }
 
+mtpscript_error_t *mtpscript_heap_image_compile(const char *js_source, const char *filename, mtpscript_bytecode_t **image_out) {
+    uint8_t *image_buf;
+    size_t image_len;
+
+    uint8_t *mem_buf = malloc(BYTECODE_COMPILE_MEM_SIZE);
+    if (!mem_buf) {
+        return bytecode_error("Failed to allocate memory for heap image compilation");
+    }
+
+    // A runtime context: the static initialization runs as it would at
+    // startup. Effects are not registered, so an initializer using one
+    // fails here.
+    JSContext *ctx = JS_NewContext(mem_buf, BYTECODE_COMPILE_MEM_SIZE, &js_stdlib);
+    if (!ctx) {
+        free(mem_buf);
+        return bytecode_error("Failed to create JS context for heap image compilation");
+    }
+
+    JSValue val = JS_Eval(ctx, js_source, strlen(js_source), filename, 0);
+    if (JS_IsException(val)) {
+        JS_FreeContext(ctx);
+        free(mem_buf);
+        return bytecode_error("Static initialization failed during heap image compilation");
+    }
+
+    if (JS_SaveHeapImage(ctx, &js_stdlib, &image_buf, &image_len)) {
+        JS_FreeContext(ctx);
+        free(mem_buf);
+        return bytecode_error("The initialized heap cannot be saved as an image");
+    }
+    JS_FreeContext(ctx);
+    free(mem_buf);
+
+    mtpscript_bytecode_t *image = MTPSCRIPT_MALLOC(sizeof(mtpscript_bytecode_t));
+    image->data = image_buf;
+    image->size = image_len;
+    *image_out = image;
+    return NULL;
+}
+
 void mtpscript_bytecode_free(mtpscript_bytecode_t *bytecode) {
     if (bytecode) {
         if (bytecode->data) MTPSCRIPT_FREE(bytecode->data);
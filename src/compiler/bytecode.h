@@ -11,12 +11,29 @@
 
 #include "mtpscript.h"
 
+// Relocatable MicroQuickJS bytecode: a JSBytecodeHeader (or
+// JSBytecodeHeader32) followed by the function data, relocated to
+// address 0. The loader relocates it in place with JS_RelocateBytecode().
+// Also used for heap images (JSHeapImageHeader followed by the data).
 typedef struct {
     uint8_t *data;
     size_t size;
 } mtpscript_bytecode_t;
 
-mtpscript_error_t *mtpscript_bytecode_compile(const char *js_source, const char *filename, mtpscript_bytecode_t **bytecode);
+// Content of a .msqs snapshot
+typedef enum {
+    MTPSCRIPT_SNAPSHOT_HEAP_IMAGE, // initialized heap, fastest startup
+    MTPSCRIPT_SNAPSHOT_BYTECODE,
+    MTPSCRIPT_SNAPSHOT_BYTECODE_32 // bytecode for 32 bit targets
+} mtpscript_snapshot_format_t;
+
+// Compile 'js_source' with the runtime stdlib atoms. If 'force_32bit' is
+// set on a 64 bit host, the bytecode is generated for 32 bit targets.
+mtpscript_error_t *mtpscript_bytecode_compile(const char *js_source, const char *filename, bool force_32bit, mtpscript_bytecode_t **bytecode);
+// Run the static initialization of 'js_source' and save the resulting
+// heap with JS_SaveHeapImage(). The image is specific to the word size
+// and stdlib of the host, and is loaded without running any code.
+mtpscript_error_t *mtpscript_heap_image_compile(const char *js_source, const char *filename, mtpscript_bytecode_t **image);
 void mtpscript_bytecode_free(mtpscript_bytecode_t *bytecode);
 
 #endif // MTPSCRIPT_BYTECODE_H
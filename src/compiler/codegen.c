@@ -10,6 +10,122 @@
 #include <string.h>
 #include <stdio.h>
 
+static bool codegen_expression_has_match(mtpscript_expression_t *expr) {
+    if (!expr) return false;
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            return codegen_expression_has_match(expr->data.binary.left) ||
+                   codegen_expression_has_match(expr->data.binary.right);
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                if (codegen_expression_has_match(mtpscript_vector_get(expr->data.call.arguments, i))) return true;
+            }
+            return false;
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            return codegen_expression_has_match(expr->data.pipe.left) ||
+                   codegen_expression_has_match(expr->data.pipe.right);
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+            return codegen_expression_has_match(expr->data.await.expression);
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// True if a statement of 'body' contains a match expression
+static bool codegen_body_has_match(mtpscript_vector_t *body) {
+    for (size_t i = 0; i < body->size; i++) {
+        mtpscript_statement_t *stmt = mtpscript_vector_get(body, i);
+        mtpscript_expression_t *expr = NULL;
+        switch (stmt->kind) {
+            case MTPSCRIPT_STMT_RETURN_STMT: expr = stmt->data.return_stmt.expression; break;
+            case MTPSCRIPT_STMT_VAR_DECL: expr = stmt->data.var_decl.initializer; break;
+            case MTPSCRIPT_STMT_EXPRESSION_STMT: expr = stmt->data.expression_stmt.expression; break;
+        }
+        if (codegen_expression_has_match(expr)) return true;
+    }
+    return false;
+}
+
+static void codegen_expression(mtpscript_expression_t *expr, mtpscript_string_t *out);
+
+// Continuation id of the next await of the function being generated
+// (§7-a: contId = freshInt()). Awaits are numbered in source order.
+static int codegen_cont_id;
+
+// Awaited expression of 'let x = await e', NULL for other statements
+static mtpscript_expression_t *codegen_let_await(mtpscript_statement_t *stmt) {
+    mtpscript_expression_t *init;
+
+    if (stmt->kind != MTPSCRIPT_STMT_VAR_DECL) return NULL;
+    init = stmt->data.var_decl.initializer;
+    return init && init->kind == MTPSCRIPT_EXPR_AWAIT_EXPR ? init->data.await.expression : NULL;
+}
+
+// True if 'expr' cannot join the batch of awaits bound by 'group': it
+// awaits itself or may read one of their results
+static bool codegen_depends_on(mtpscript_expression_t *expr, mtpscript_statement_t **group, size_t count) {
+    if (!expr) return false;
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_VARIABLE:
+        case MTPSCRIPT_EXPR_FUNCTION_CALL: {
+            mtpscript_string_t *name = expr->kind == MTPSCRIPT_EXPR_VARIABLE ?
+                expr->data.variable.name : expr->data.call.function_name;
+            for (size_t i = 0; i < count; i++) {
+                if (strcmp(mtpscript_string_cstr(group[i]->data.var_decl.name), mtpscript_string_cstr(name)) == 0)
+                    return true;
+            }
+            if (expr->kind == MTPSCRIPT_EXPR_FUNCTION_CALL) {
+                for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                    if (codegen_depends_on(mtpscript_vector_get(expr->data.call.arguments, i), group, count))
+                        return true;
+                }
+            }
+            return false;
+        }
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            return codegen_depends_on(expr->data.binary.left, group, count) ||
+                   codegen_depends_on(expr->data.binary.right, group, count);
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            return codegen_depends_on(expr->data.pipe.left, group, count) ||
+                   codegen_depends_on(expr->data.pipe.right, group, count);
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            if (codegen_depends_on(expr->data.match.scrutinee, group, count)) return true;
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                if (codegen_depends_on(arm->body, group, count)) return true;
+            }
+            return false;
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+        case MTPSCRIPT_EXPR_BLOCK_EXPR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static int codegen_op_precedence(const char *op) {
+    if (strcmp(op, "*") == 0 || strcmp(op, "/") == 0 || strcmp(op, "%") == 0) return 2;
+    if (strcmp(op, "+") == 0 || strcmp(op, "-") == 0) return 1;
+    return 0;
+}
+
+// Operands are parenthesized when the JavaScript grouping would differ
+// from the tree, e.g. after folding or inlining
+static void codegen_binary_operand(mtpscript_expression_t *parent, mtpscript_expression_t *operand,
+                                   bool right, mtpscript_string_t *out) {
+    bool parens = false;
+    if (operand->kind == MTPSCRIPT_EXPR_BINARY_EXPR) {
+        int parent_precedence = codegen_op_precedence(parent->data.binary.op);
+        int precedence = codegen_op_precedence(operand->data.binary.op);
+        parens = precedence == 0 || precedence < parent_precedence || (right && precedence == parent_precedence);
+    }
+    if (parens) mtpscript_string_append_cstr(out, "(");
+    codegen_expression(operand, out);
+    if (parens) mtpscript_string_append_cstr(out, ")");
+}
+
 static void codegen_expression(mtpscript_expression_t *expr, mtpscript_string_t *out) {
     switch (expr->kind) {
         case MTPSCRIPT_EXPR_INT_LITERAL: {
@@ -33,11 +149,11 @@ static void codegen_expression(mtpscript_expression_t *expr, mtpscript_string_t
             mtpscript_string_append_cstr(out, mtpscript_string_cstr(expr->data.variable.name));
             break;
         case MTPSCRIPT_EXPR_BINARY_EXPR:
-            codegen_expression(expr->data.binary.left, out);
+            codegen_binary_operand(expr, expr->data.binary.left, false, out);
             mtpscript_string_append_cstr(out, " ");
             mtpscript_string_append_cstr(out, expr->data.binary.op);
             mtpscript_string_append_cstr(out, " ");
-            codegen_expression(expr->data.binary.right, out);
+            codegen_binary_operand(expr, expr->data.binary.right, true, out);
             break;
         case MTPSCRIPT_EXPR_FUNCTION_CALL:
             mtpscript_string_append_cstr(out, mtpscript_string_cstr(expr->data.call.function_name));
@@ -55,40 +171,61 @@ static void codegen_expression(mtpscript_expression_t *expr, mtpscript_string_t
             codegen_expression(expr->data.pipe.left, out);
             mtpscript_string_append_cstr(out, ")");
             break;
-        case MTPSCRIPT_EXPR_AWAIT_EXPR:
-            // Desugar await e into Async.await(ph, contId, e) (§7-a)
-            mtpscript_string_append_cstr(out, "Async.await(ph, contId, ");
+        case MTPSCRIPT_EXPR_AWAIT_EXPR: {
+            // Desugar await e into Async.await(ph, contId, e) (§7-a).
+            // Independent awaits are batched by codegen_body().
+            char id[16];
+            snprintf(id, sizeof(id), "%d", codegen_cont_id++);
+            mtpscript_string_append_cstr(out, "Async.await(ph, ");
+            mtpscript_string_append_cstr(out, id);
+            mtpscript_string_append_cstr(out, ", ");
             codegen_expression(expr->data.await.expression, out);
             mtpscript_string_append_cstr(out, ")");
             break;
-        case MTPSCRIPT_EXPR_MATCH_EXPR:
-            // Generate JavaScript switch-like construct for match
-            mtpscript_string_append_cstr(out, "(function() {\n");
-            mtpscript_string_append_cstr(out, "  const scrutinee = ");
-            codegen_expression(expr->data.match.scrutinee, out);
-            mtpscript_string_append_cstr(out, ";\n");
+        }
+        case MTPSCRIPT_EXPR_MATCH_EXPR: {
+            // Flat conditional chain, without a closure:
+            //   ($m = scrutinee, $m === A ? a : $m === B ? b : $matchFail())
+            // A '_' arm ends the chain in place of $matchFail().
+            // A single $m per function is enough: a nested match in the
+            // scrutinee completes before the assignment, and one in an arm
+            // runs after the last comparison of the outer match.
+            mtpscript_expression_t *scrutinee = expr->data.match.scrutinee;
+            bool simple = scrutinee->kind == MTPSCRIPT_EXPR_VARIABLE ||
+                          scrutinee->kind == MTPSCRIPT_EXPR_INT_LITERAL ||
+                          scrutinee->kind == MTPSCRIPT_EXPR_STRING_LITERAL ||
+                          scrutinee->kind == MTPSCRIPT_EXPR_BOOL_LITERAL;
+            bool wildcard = false;
 
+            mtpscript_string_append_cstr(out, "(");
+            if (!simple) {
+                mtpscript_string_append_cstr(out, "$m = ");
+                codegen_expression(scrutinee, out);
+                mtpscript_string_append_cstr(out, ", ");
+            }
             for (size_t i = 0; i < expr->data.match.arms->size; i++) {
                 mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
-                mtpscript_string_append_cstr(out, "  ");
-                if (i == 0) {
-                    mtpscript_string_append_cstr(out, "if");
+                if (strcmp(mtpscript_string_cstr(arm->pattern), "_") == 0) {
+                    mtpscript_string_append_cstr(out, "(");
+                    codegen_expression(arm->body, out);
+                    mtpscript_string_append_cstr(out, "))");
+                    wildcard = true;
+                    break;
+                }
+                if (simple) {
+                    codegen_expression(scrutinee, out);
                 } else {
-                    mtpscript_string_append_cstr(out, "} else if");
+                    mtpscript_string_append_cstr(out, "$m");
                 }
-                mtpscript_string_append_cstr(out, " (scrutinee === ");
+                mtpscript_string_append_cstr(out, " === ");
                 mtpscript_string_append_cstr(out, mtpscript_string_cstr(arm->pattern));
-                mtpscript_string_append_cstr(out, ") {\n");
-                mtpscript_string_append_cstr(out, "    return ");
+                mtpscript_string_append_cstr(out, " ? (");
                 codegen_expression(arm->body, out);
-                mtpscript_string_append_cstr(out, ";\n");
+                mtpscript_string_append_cstr(out, ") : ");
             }
-
-            mtpscript_string_append_cstr(out, "  } else {\n");
-            mtpscript_string_append_cstr(out, "    throw new Error('Non-exhaustive match');\n");
-            mtpscript_string_append_cstr(out, "  }\n");
-            mtpscript_string_append_cstr(out, "})()");
+            if (!wildcard) mtpscript_string_append_cstr(out, "$matchFail())");
             break;
+        }
         default: break;
     }
 }
@@ -101,7 +238,8 @@ static void codegen_statement(mtpscript_statement_t *stmt, mtpscript_string_t *o
             mtpscript_string_append_cstr(out, ";\n");
             break;
         case MTPSCRIPT_STMT_VAR_DECL:
-            mtpscript_string_append_cstr(out, "  let ");
+            // mquickjs has no block scoping: 'let' is a syntax error
+            mtpscript_string_append_cstr(out, "  var ");
             mtpscript_string_append_cstr(out, mtpscript_string_cstr(stmt->data.var_decl.name));
             mtpscript_string_append_cstr(out, " = ");
             codegen_expression(stmt->data.var_decl.initializer, out);
@@ -115,6 +253,58 @@ static void codegen_statement(mtpscript_statement_t *stmt, mtpscript_string_t *o
     }
 }
 
+// Consecutive 'let x = await e' statements whose awaited expressions do
+// not read the results of the previous ones share a continuation
+// frontier: their I/O runs concurrently in one Async.awaitAll() call
+//   var $aw = Async.awaitAll([[ph, 0, e1], [ph, 1, e2]]);
+//   var x = $aw[0];
+//   var y = $aw[1];
+static void codegen_body(mtpscript_vector_t *body, mtpscript_string_t *out) {
+    mtpscript_statement_t *group[64];
+    size_t i = 0, count;
+    char id[16];
+
+    codegen_cont_id = 0;
+    while (i < body->size) {
+        mtpscript_statement_t *stmt = mtpscript_vector_get(body, i);
+        count = 0;
+        if (codegen_let_await(stmt) && !codegen_depends_on(codegen_let_await(stmt), group, 0)) {
+            group[count++] = stmt;
+            while (i + count < body->size && count < sizeof(group) / sizeof(group[0])) {
+                mtpscript_statement_t *next = mtpscript_vector_get(body, i + count);
+                mtpscript_expression_t *awaited = codegen_let_await(next);
+                if (!awaited || codegen_depends_on(awaited, group, count)) break;
+                group[count++] = next;
+            }
+        }
+        if (count < 2) {
+            codegen_statement(stmt, out);
+            i++;
+            continue;
+        }
+
+        mtpscript_string_append_cstr(out, "  var $aw = Async.awaitAll([");
+        for (size_t k = 0; k < count; k++) {
+            snprintf(id, sizeof(id), "%d", codegen_cont_id++);
+            mtpscript_string_append_cstr(out, k ? ", [ph, " : "[ph, ");
+            mtpscript_string_append_cstr(out, id);
+            mtpscript_string_append_cstr(out, ", ");
+            codegen_expression(codegen_let_await(group[k]), out);
+            mtpscript_string_append_cstr(out, "]");
+        }
+        mtpscript_string_append_cstr(out, "]);\n");
+        for (size_t k = 0; k < count; k++) {
+            snprintf(id, sizeof(id), "%zu", k);
+            mtpscript_string_append_cstr(out, "  var ");
+            mtpscript_string_append_cstr(out, mtpscript_string_cstr(group[k]->data.var_decl.name));
+            mtpscript_string_append_cstr(out, " = $aw[");
+            mtpscript_string_append_cstr(out, id);
+            mtpscript_string_append_cstr(out, "];\n");
+        }
+        i += count;
+    }
+}
+
 static void codegen_declaration(mtpscript_declaration_t *decl, mtpscript_string_t *out) {
     if (decl->kind == MTPSCRIPT_DECL_IMPORT) {
         // Generate import statement for vendored module
@@ -159,9 +349,10 @@ static void codegen_declaration(mtpscript_declaration_t *decl, mtpscript_string_
                 if (i < decl->data.api.handler->params->size - 1) mtpscript_string_append_cstr(out, ", ");
             }
             mtpscript_string_append_cstr(out, ") {\n");
-            for (size_t i = 0; i < decl->data.api.handler->body->size; i++) {
-                codegen_statement(mtpscript_vector_get(decl->data.api.handler->body, i), out);
+            if (codegen_body_has_match(decl->data.api.handler->body)) {
+                mtpscript_string_append_cstr(out, "  var $m;\n");
             }
+            codegen_body(decl->data.api.handler->body, out);
             mtpscript_string_append_cstr(out, "}\n\n");
         }
     } else if (decl->kind == MTPSCRIPT_DECL_FUNCTION) {
@@ -174,9 +365,10 @@ static void codegen_declaration(mtpscript_declaration_t *decl, mtpscript_string_
             if (i < decl->data.function.params->size - 1) mtpscript_string_append_cstr(out, ", ");
         }
         mtpscript_string_append_cstr(out, ") {\n");
-        for (size_t i = 0; i < decl->data.function.body->size; i++) {
-            codegen_statement(mtpscript_vector_get(decl->data.function.body, i), out);
+        if (codegen_body_has_match(decl->data.function.body)) {
+            mtpscript_string_append_cstr(out, "  var $m;\n");
         }
+        codegen_body(decl->data.function.body, out);
         mtpscript_string_append_cstr(out, "}\n\n");
     }
 }
@@ -186,6 +378,22 @@ mtpscript_error_t *mtpscript_codegen_program(mtpscript_program_t *program, mtpsc
     *output_out = out;
 
     mtpscript_string_append_cstr(out, "// Generated by MTPScript Compiler\n\n");
+    for (size_t i = 0; i < program->declarations->size; i++) {
+        mtpscript_declaration_t *decl = mtpscript_vector_get(program->declarations, i);
+        mtpscript_vector_t *body = NULL;
+        if (decl->kind == MTPSCRIPT_DECL_FUNCTION) {
+            body = decl->data.function.body;
+        } else if (decl->kind == MTPSCRIPT_DECL_API && decl->data.api.handler) {
+            body = decl->data.api.handler->body;
+        }
+        if (body && codegen_body_has_match(body)) {
+            // Reached when no arm of a match applies
+            mtpscript_string_append_cstr(out, "function $matchFail() {\n");
+            mtpscript_string_append_cstr(out, "  throw new Error('Non-exhaustive match');\n");
+            mtpscript_string_append_cstr(out, "}\n\n");
+            break;
+        }
+    }
     for (size_t i = 0; i < program->declarations->size; i++) {
         codegen_declaration(mtpscript_vector_get(program->declarations, i), out);
     }
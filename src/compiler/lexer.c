@@ -11,7 +11,7 @@
 #include <ctype.h>
 #include <stdio.h>
 
-mtpscript_lexer_t *mtpscript_lexer_new(const char *source, const char *filename) {
+mtpscript_lexer_t *mtpscript_lexer_new(mtpscript_arena_t *arena, const char *source, const char *filename) {
     mtpscript_lexer_t *lexer = MTPSCRIPT_MALLOC(sizeof(mtpscript_lexer_t));
     lexer->source = source;
     lexer->length = strlen(source);
@@ -19,6 +19,7 @@ mtpscript_lexer_t *mtpscript_lexer_new(const char *source, const char *filename)
     lexer->line = 1;
     lexer->column = 1;
     lexer->filename = filename;
+    lexer->arena = arena;
     return lexer;
 }
 
@@ -26,11 +27,13 @@ void mtpscript_lexer_free(mtpscript_lexer_t *lexer) {
     if (lexer) MTPSCRIPT_FREE(lexer);
 }
 
-void mtpscript_token_free(mtpscript_token_t *token) {
-    if (token) {
-        if (token->lexeme) mtpscript_string_free(token->lexeme);
-        MTPSCRIPT_FREE(token);
-    }
+bool mtpscript_token_equals(const mtpscript_token_t *token, const char *str) {
+    size_t len = strlen(str);
+    return token->length == len && memcmp(token->lexeme, str, len) == 0;
+}
+
+mtpscript_string_t *mtpscript_token_string(mtpscript_arena_t *arena, const mtpscript_token_t *token) {
+    return mtpscript_arena_string_new(arena, token->lexeme, token->length);
 }
 
 static char peek(mtpscript_lexer_t *lexer) {
@@ -58,96 +61,107 @@ static void skip_whitespace(mtpscript_lexer_t *lexer) {
     }
 }
 
-static mtpscript_token_t *create_token(mtpscript_lexer_t *lexer, mtpscript_token_type_t type, const char *lexeme) {
-    mtpscript_token_t *token = MTPSCRIPT_MALLOC(sizeof(mtpscript_token_t));
+static mtpscript_token_t *create_token(mtpscript_lexer_t *lexer, mtpscript_token_type_t type, size_t start) {
+    mtpscript_token_t *token = mtpscript_arena_alloc(lexer->arena, sizeof(mtpscript_token_t));
     token->type = type;
-    token->lexeme = mtpscript_string_from_cstr(lexeme);
+    token->lexeme = lexer->source + start;
+    token->length = lexer->position - start;
     token->location.line = lexer->line;
     token->location.column = lexer->column;
     token->location.file = lexer->filename;
     return token;
 }
 
+static const struct {
+    const char *name;
+    mtpscript_token_type_t type;
+} keywords[] = {
+    { "func", MTPSCRIPT_TOKEN_FUNC },
+    { "api", MTPSCRIPT_TOKEN_API },
+    { "uses", MTPSCRIPT_TOKEN_USES },
+    { "let", MTPSCRIPT_TOKEN_LET },
+    { "return", MTPSCRIPT_TOKEN_RETURN },
+    { "if", MTPSCRIPT_TOKEN_IF },
+    { "else", MTPSCRIPT_TOKEN_ELSE },
+    { "match", MTPSCRIPT_TOKEN_MATCH },
+    { "import", MTPSCRIPT_TOKEN_IMPORT },
+    { "from", MTPSCRIPT_TOKEN_FROM },
+    { "as", MTPSCRIPT_TOKEN_AS },
+    { "serve", MTPSCRIPT_TOKEN_SERVE },
+    { "true", MTPSCRIPT_TOKEN_BOOL },
+    { "false", MTPSCRIPT_TOKEN_BOOL },
+    { "GET", MTPSCRIPT_TOKEN_GET },
+    { "await", MTPSCRIPT_TOKEN_AWAIT },
+    { "POST", MTPSCRIPT_TOKEN_POST },
+};
+
+static mtpscript_token_type_t keyword_type(const char *word, size_t len) {
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+        if (strncmp(keywords[i].name, word, len) == 0 && keywords[i].name[len] == '\0')
+            return keywords[i].type;
+    }
+    return MTPSCRIPT_TOKEN_IDENTIFIER;
+}
+
 mtpscript_error_t *mtpscript_lexer_tokenize(mtpscript_lexer_t *lexer, mtpscript_vector_t **tokens_out) {
-    mtpscript_vector_t *tokens = mtpscript_vector_new();
+    mtpscript_vector_t *tokens = mtpscript_arena_vector_new(lexer->arena);
     *tokens_out = tokens;
 
     while (peek(lexer) != '\0') {
         skip_whitespace(lexer);
         char c = peek(lexer);
         if (c == '\0') break;
+        size_t start = lexer->position;
 
         if (isalpha(c) || c == '_') {
-            mtpscript_string_t *buf = mtpscript_string_new();
             while (isalnum(peek(lexer)) || peek(lexer) == '_') {
-                char ch = advance(lexer);
-                mtpscript_string_append(buf, &ch, 1);
+                advance(lexer);
             }
-            const char *lexeme = mtpscript_string_cstr(buf);
-            mtpscript_token_type_t type = MTPSCRIPT_TOKEN_IDENTIFIER;
-            if (strcmp(lexeme, "func") == 0) type = MTPSCRIPT_TOKEN_FUNC;
-            else if (strcmp(lexeme, "api") == 0) type = MTPSCRIPT_TOKEN_API;
-            else if (strcmp(lexeme, "uses") == 0) type = MTPSCRIPT_TOKEN_USES;
-            else if (strcmp(lexeme, "let") == 0) type = MTPSCRIPT_TOKEN_LET;
-            else if (strcmp(lexeme, "return") == 0) type = MTPSCRIPT_TOKEN_RETURN;
-            else if (strcmp(lexeme, "if") == 0) type = MTPSCRIPT_TOKEN_IF;
-            else if (strcmp(lexeme, "else") == 0) type = MTPSCRIPT_TOKEN_ELSE;
-            else if (strcmp(lexeme, "import") == 0) type = MTPSCRIPT_TOKEN_IMPORT;
-            else if (strcmp(lexeme, "from") == 0) type = MTPSCRIPT_TOKEN_FROM;
-            else if (strcmp(lexeme, "as") == 0) type = MTPSCRIPT_TOKEN_AS;
-            else if (strcmp(lexeme, "serve") == 0) type = MTPSCRIPT_TOKEN_SERVE;
-            else if (strcmp(lexeme, "true") == 0) type = MTPSCRIPT_TOKEN_BOOL;
-            else if (strcmp(lexeme, "false") == 0) type = MTPSCRIPT_TOKEN_BOOL;
-            else if (strcmp(lexeme, "GET") == 0) type = MTPSCRIPT_TOKEN_GET;
-            else if (strcmp(lexeme, "await") == 0) type = MTPSCRIPT_TOKEN_AWAIT;
-            else if (strcmp(lexeme, "POST") == 0) type = MTPSCRIPT_TOKEN_POST;
-
-            mtpscript_vector_push(tokens, create_token(lexer, type, lexeme));
-            mtpscript_string_free(buf);
+            mtpscript_token_type_t type = keyword_type(lexer->source + start, lexer->position - start);
+            mtpscript_vector_push(tokens, create_token(lexer, type, start));
         } else if (isdigit(c)) {
-            mtpscript_string_t *buf = mtpscript_string_new();
             bool is_decimal = false;
             while (isdigit(peek(lexer)) || peek(lexer) == '.') {
                 if (peek(lexer) == '.') is_decimal = true;
-                char ch = advance(lexer);
-                mtpscript_string_append(buf, &ch, 1);
+                advance(lexer);
             }
-            mtpscript_vector_push(tokens, create_token(lexer, is_decimal ? MTPSCRIPT_TOKEN_DECIMAL : MTPSCRIPT_TOKEN_INT, mtpscript_string_cstr(buf)));
-            mtpscript_string_free(buf);
+            mtpscript_vector_push(tokens, create_token(lexer, is_decimal ? MTPSCRIPT_TOKEN_DECIMAL : MTPSCRIPT_TOKEN_INT, start));
         } else if (c == '"') {
-            // String literal
+            // String literal: the lexeme excludes the quotes
             advance(lexer); // consume opening quote
-            mtpscript_string_t *buf = mtpscript_string_new();
+            start = lexer->position;
             while (peek(lexer) != '"' && peek(lexer) != '\0') {
-                char ch = advance(lexer);
-                mtpscript_string_append(buf, &ch, 1);
+                advance(lexer);
             }
+            size_t end = lexer->position;
             if (peek(lexer) == '"') {
                 advance(lexer); // consume closing quote
             }
-            mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_STRING, mtpscript_string_cstr(buf)));
-            mtpscript_string_free(buf);
+            mtpscript_token_t *token = create_token(lexer, MTPSCRIPT_TOKEN_STRING, start);
+            token->length = end - start;
+            mtpscript_vector_push(tokens, token);
         } else {
             advance(lexer);
-            char lexeme[2] = {c, '\0'};
             mtpscript_token_type_t type;
             switch (c) {
                 case '(': type = MTPSCRIPT_TOKEN_LPAREN; break;
                 case ')': type = MTPSCRIPT_TOKEN_RPAREN; break;
                 case '{': type = MTPSCRIPT_TOKEN_LBRACE; break;
                 case '}': type = MTPSCRIPT_TOKEN_RBRACE; break;
+                case '[': type = MTPSCRIPT_TOKEN_LBRACKET; break;
+                case ']': type = MTPSCRIPT_TOKEN_RBRACKET; break;
                 case '+': type = MTPSCRIPT_TOKEN_PLUS; break;
                 case '-':
                     if (peek(lexer) == '>') {
                         advance(lexer);
-                        mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_ARROW, "->"));
+                        mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_ARROW, start));
                         continue;
                     }
                     type = MTPSCRIPT_TOKEN_MINUS; break;
                 case '|':
                     if (peek(lexer) == '>') {
                         advance(lexer);
-                        mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_PIPE, "|>"));
+                        mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_PIPE, start));
                         continue;
                     }
                     // Handle single | if needed, for now skip
@@ -159,13 +173,22 @@ mtpscript_error_t *mtpscript_lexer_tokenize(mtpscript_lexer_t *lexer, mtpscript_
                 case ',': type = MTPSCRIPT_TOKEN_COMMA; break;
                 case '<': type = MTPSCRIPT_TOKEN_LANGLE; break;
                 case '>': type = MTPSCRIPT_TOKEN_RANGLE; break;
-                default:
-                    // Handle error
-                    return NULL;
+                default: {
+                    // The parser reads up to the EOF token: end the
+                    // stream before failing
+                    mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
+                    char msg[64];
+                    mtpscript_location_t location = { lexer->line, lexer->column - 1, lexer->filename };
+                    mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_EOF, lexer->position));
+                    snprintf(msg, sizeof(msg), "Unexpected character '%c'", c);
+                    error->message = mtpscript_string_from_cstr(msg);
+                    error->location = location;
+                    return error;
+                }
             }
-            mtpscript_vector_push(tokens, create_token(lexer, type, lexeme));
+            mtpscript_vector_push(tokens, create_token(lexer, type, start));
         }
     }
-    mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_EOF, ""));
+    mtpscript_vector_push(tokens, create_token(lexer, MTPSCRIPT_TOKEN_EOF, lexer->position));
     return NULL;
 }
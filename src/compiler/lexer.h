@@ -63,7 +63,8 @@ typedef enum {
 
 typedef struct {
     mtpscript_token_type_t type;
-    mtpscript_string_t *lexeme;
+    const char *lexeme;          // Slice of the source, not '\0' terminated
+    size_t length;
     mtpscript_location_t location;
 } mtpscript_token_t;
 
@@ -74,12 +75,16 @@ typedef struct {
     int line;
     int column;
     const char *filename;
+    mtpscript_arena_t *arena;    // Tokens are allocated here
 } mtpscript_lexer_t;
 
-mtpscript_lexer_t *mtpscript_lexer_new(const char *source, const char *filename);
+// The tokens point into 'source', which must outlive them
+mtpscript_lexer_t *mtpscript_lexer_new(mtpscript_arena_t *arena, const char *source, const char *filename);
 void mtpscript_lexer_free(mtpscript_lexer_t *lexer);
 mtpscript_error_t *mtpscript_lexer_tokenize(mtpscript_lexer_t *lexer, mtpscript_vector_t **tokens);
 
-void mtpscript_token_free(mtpscript_token_t *token);
+bool mtpscript_token_equals(const mtpscript_token_t *token, const char *str);
+// Copy the lexeme into 'arena'
+mtpscript_string_t *mtpscript_token_string(mtpscript_arena_t *arena, const mtpscript_token_t *token);
 
 #endif // MTPSCRIPT_LEXER_H
@@ -10,6 +10,73 @@
 #include <string.h>
 #include <stdio.h>
 
+// Bump arena
+#define MTPSCRIPT_ARENA_BLOCK_SIZE (64 * 1024)
+#define MTPSCRIPT_ARENA_ALIGN 16
+
+struct mtpscript_arena_block {
+    struct mtpscript_arena_block *next;
+    size_t size;
+    _Alignas(MTPSCRIPT_ARENA_ALIGN) char data[];
+};
+
+mtpscript_arena_t *mtpscript_arena_new(void) {
+    mtpscript_arena_t *arena = MTPSCRIPT_MALLOC(sizeof(mtpscript_arena_t));
+    arena->blocks = NULL;
+    arena->ptr = NULL;
+    arena->end = NULL;
+    return arena;
+}
+
+void mtpscript_arena_free(mtpscript_arena_t *arena) {
+    if (arena) {
+        mtpscript_arena_block_t *block = arena->blocks;
+        while (block) {
+            mtpscript_arena_block_t *next = block->next;
+            MTPSCRIPT_FREE(block);
+            block = next;
+        }
+        MTPSCRIPT_FREE(arena);
+    }
+}
+
+void *mtpscript_arena_alloc(mtpscript_arena_t *arena, size_t size) {
+    size = (size + MTPSCRIPT_ARENA_ALIGN - 1) & ~(size_t)(MTPSCRIPT_ARENA_ALIGN - 1);
+    if ((size_t)(arena->end - arena->ptr) < size) {
+        size_t block_size = MTPSCRIPT_ARENA_BLOCK_SIZE;
+        mtpscript_arena_block_t *block;
+        if (size > block_size / 4) {
+            // Large objects get their own block, behind the current one
+            block = MTPSCRIPT_MALLOC(sizeof(mtpscript_arena_block_t) + size);
+            block->size = size;
+            if (arena->blocks) {
+                block->next = arena->blocks->next;
+                arena->blocks->next = block;
+            } else {
+                block->next = NULL;
+                arena->blocks = block;
+            }
+            return block->data;
+        }
+        block = MTPSCRIPT_MALLOC(sizeof(mtpscript_arena_block_t) + block_size);
+        block->size = block_size;
+        block->next = arena->blocks;
+        arena->blocks = block;
+        arena->ptr = block->data;
+        arena->end = block->data + block_size;
+    }
+    void *p = arena->ptr;
+    arena->ptr += size;
+    return p;
+}
+
+char *mtpscript_arena_strndup(mtpscript_arena_t *arena, const char *str, size_t len) {
+    char *p = mtpscript_arena_alloc(arena, len + 1);
+    memcpy(p, str, len);
+    p[len] = '\0';
+    return p;
+}
+
 void mtpscript_error_free(mtpscript_error_t *error) {
     if (error) {
         if (error->message) mtpscript_string_free(error->message);
@@ -23,6 +90,21 @@ mtpscript_string_t *mtpscript_string_new(void) {
     str->capacity = 16;
     str->data = MTPSCRIPT_MALLOC(str->capacity);
     str->data[0] = '\0';
+    str->arena = NULL;
+    return str;
+}
+
+mtpscript_string_t *mtpscript_arena_string_new(mtpscript_arena_t *arena, const char *data, size_t len) {
+    if (!arena) {
+        mtpscript_string_t *str = mtpscript_string_new();
+        mtpscript_string_append(str, data, len);
+        return str;
+    }
+    mtpscript_string_t *str = mtpscript_arena_alloc(arena, sizeof(mtpscript_string_t));
+    str->data = mtpscript_arena_strndup(arena, data, len);
+    str->length = len;
+    str->capacity = len + 1;
+    str->arena = arena;
     return str;
 }
 
@@ -35,7 +117,7 @@ mtpscript_string_t *mtpscript_string_from_cstr(const char *cstr) {
 }
 
 void mtpscript_string_free(mtpscript_string_t *str) {
-    if (str) {
+    if (str && !str->arena) {
         if (str->data) MTPSCRIPT_FREE(str->data);
         MTPSCRIPT_FREE(str);
     }
@@ -43,10 +125,17 @@ void mtpscript_string_free(mtpscript_string_t *str) {
 
 void mtpscript_string_append(mtpscript_string_t *str, const char *data, size_t len) {
     if (str->length + len + 1 > str->capacity) {
+        size_t capacity = str->capacity;
         while (str->length + len + 1 > str->capacity) {
             str->capacity *= 2;
         }
-        str->data = MTPSCRIPT_REALLOC(str->data, str->capacity);
+        if (str->arena) {
+            char *data = mtpscript_arena_alloc(str->arena, str->capacity);
+            memcpy(data, str->data, capacity);
+            str->data = data;
+        } else {
+            str->data = MTPSCRIPT_REALLOC(str->data, str->capacity);
+        }
     }
     memcpy(str->data + str->length, data, len);
     str->length += len;
@@ -66,11 +155,22 @@ mtpscript_vector_t *mtpscript_vector_new(void) {
     vec->size = 0;
     vec->capacity = 8;
     vec->items = MTPSCRIPT_MALLOC(sizeof(void *) * vec->capacity);
+    vec->arena = NULL;
+    return vec;
+}
+
+mtpscript_vector_t *mtpscript_arena_vector_new(mtpscript_arena_t *arena) {
+    if (!arena) return mtpscript_vector_new();
+    mtpscript_vector_t *vec = mtpscript_arena_alloc(arena, sizeof(mtpscript_vector_t));
+    vec->size = 0;
+    vec->capacity = 8;
+    vec->items = mtpscript_arena_alloc(arena, sizeof(void *) * vec->capacity);
+    vec->arena = arena;
     return vec;
 }
 
 void mtpscript_vector_free(mtpscript_vector_t *vec) {
-    if (vec) {
+    if (vec && !vec->arena) {
         if (vec->items) MTPSCRIPT_FREE(vec->items);
         MTPSCRIPT_FREE(vec);
     }
@@ -79,7 +179,13 @@ void mtpscript_vector_free(mtpscript_vector_t *vec) {
 void mtpscript_vector_push(mtpscript_vector_t *vec, void *item) {
     if (vec->size + 1 > vec->capacity) {
         vec->capacity *= 2;
-        vec->items = MTPSCRIPT_REALLOC(vec->items, sizeof(void *) * vec->capacity);
+        if (vec->arena) {
+            void **items = mtpscript_arena_alloc(vec->arena, sizeof(void *) * vec->capacity);
+            memcpy(items, vec->items, sizeof(void *) * vec->size);
+            vec->items = items;
+        } else {
+            vec->items = MTPSCRIPT_REALLOC(vec->items, sizeof(void *) * vec->capacity);
+        }
     }
     vec->items[vec->size++] = item;
 }
@@ -91,45 +197,189 @@ void *mtpscript_vector_get(mtpscript_vector_t *vec, size_t index) {
     return NULL;
 }
 
+// FNV-1a 64-bit hashing implementation
+#define FNV1A_64_OFFSET 0xcbf29ce484222325ULL
+#define FNV1A_64_PRIME 0x100000001b3ULL
+
+uint64_t mtpscript_fnv1a_64(const void *data, size_t length) {
+    uint64_t hash = FNV1A_64_OFFSET;
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= FNV1A_64_PRIME;
+    }
+
+    return hash;
+}
+
+uint64_t mtpscript_fnv1a_64_string(const char *str) {
+    return mtpscript_fnv1a_64(str, strlen(str));
+}
+
+// Keys are copied into blocks which are only released with the table
+#define MTPSCRIPT_HASH_KEY_BLOCK_SIZE 4096
+
+typedef struct mtpscript_hash_key_block {
+    struct mtpscript_hash_key_block *next;
+    size_t used;
+    size_t size;
+    char data[];
+} mtpscript_hash_key_block_t;
+
+static const char *hash_copy_key(mtpscript_hash_t *hash, const char *key, size_t len) {
+    mtpscript_hash_key_block_t *block = hash->keys;
+    if (!block || block->size - block->used < len + 1) {
+        size_t size = MTPSCRIPT_HASH_KEY_BLOCK_SIZE;
+        if (len + 1 > size) size = len + 1;
+        block = MTPSCRIPT_MALLOC(sizeof(mtpscript_hash_key_block_t) + size);
+        block->used = 0;
+        block->size = size;
+        if (len + 1 > MTPSCRIPT_HASH_KEY_BLOCK_SIZE && hash->keys) {
+            // Keep filling the current block
+            block->next = hash->keys->next;
+            hash->keys->next = block;
+        } else {
+            block->next = hash->keys;
+            hash->keys = block;
+        }
+    }
+    char *p = block->data + block->used;
+    memcpy(p, key, len + 1);
+    block->used += len + 1;
+    return p;
+}
+
+static uint32_t hash_key(const char *key, size_t *plen) {
+    size_t len = strlen(key);
+    uint64_t h = mtpscript_fnv1a_64(key, len);
+    *plen = len;
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+// Rebuild the index for 'index_size' slots, dropping the removed entries
+static void hash_rehash(mtpscript_hash_t *hash, size_t index_size) {
+    size_t j = 0;
+    for (size_t i = 0; i < hash->count; i++) {
+        if (hash->entries[i].key) hash->entries[j++] = hash->entries[i];
+    }
+    hash->count = j;
+
+    MTPSCRIPT_FREE(hash->index);
+    hash->index = MTPSCRIPT_MALLOC(sizeof(uint32_t) * index_size);
+    memset(hash->index, 0, sizeof(uint32_t) * index_size);
+    hash->index_mask = index_size - 1;
+    for (size_t i = 0; i < hash->count; i++) {
+        size_t pos = hash->entries[i].hash & hash->index_mask;
+        while (hash->index[pos] != 0) pos = (pos + 1) & hash->index_mask;
+        hash->index[pos] = (uint32_t)(i + 1);
+    }
+}
+
+// Return the index slot holding 'key', or the free slot ending its probe
+static size_t hash_find_slot(mtpscript_hash_t *hash, const char *key, uint32_t h) {
+    size_t pos = h & hash->index_mask;
+    uint32_t e;
+    while ((e = hash->index[pos]) != 0) {
+        mtpscript_hash_entry_t *entry = &hash->entries[e - 1];
+        if (entry->hash == h && strcmp(entry->key, key) == 0) break;
+        pos = (pos + 1) & hash->index_mask;
+    }
+    return pos;
+}
+
 mtpscript_hash_t *mtpscript_hash_new(void) {
     mtpscript_hash_t *hash = MTPSCRIPT_MALLOC(sizeof(mtpscript_hash_t));
     hash->size = 0;
-    hash->capacity = 16;
+    hash->count = 0;
+    hash->capacity = 8;
     hash->entries = MTPSCRIPT_MALLOC(sizeof(mtpscript_hash_entry_t) * hash->capacity);
+    // At most half of the index slots are used
+    hash->index_mask = 2 * hash->capacity - 1;
+    hash->index = MTPSCRIPT_MALLOC(sizeof(uint32_t) * 2 * hash->capacity);
+    memset(hash->index, 0, sizeof(uint32_t) * 2 * hash->capacity);
+    hash->keys = NULL;
     return hash;
 }
 
 void mtpscript_hash_free(mtpscript_hash_t *hash) {
     if (hash) {
+        mtpscript_hash_key_block_t *block = hash->keys;
+        while (block) {
+            mtpscript_hash_key_block_t *next = block->next;
+            MTPSCRIPT_FREE(block);
+            block = next;
+        }
         if (hash->entries) MTPSCRIPT_FREE(hash->entries);
+        if (hash->index) MTPSCRIPT_FREE(hash->index);
         MTPSCRIPT_FREE(hash);
     }
 }
 
 void mtpscript_hash_set(mtpscript_hash_t *hash, const char *key, void *value) {
-    // Simplified hash table implementation (linear search for now)
-    for (size_t i = 0; i < hash->size; i++) {
-        if (strcmp(hash->entries[i].key, key) == 0) {
-            hash->entries[i].value = value;
-            return;
-        }
+    size_t len;
+    uint32_t h = hash_key(key, &len);
+    size_t pos = hash_find_slot(hash, key, h);
+    if (hash->index[pos] != 0) {
+        hash->entries[hash->index[pos] - 1].value = value;
+        return;
     }
-    if (hash->size + 1 > hash->capacity) {
-        hash->capacity *= 2;
-        hash->entries = MTPSCRIPT_REALLOC(hash->entries, sizeof(mtpscript_hash_entry_t) * hash->capacity);
+    if (hash->count == hash->capacity) {
+        // Compact if at least a quarter of the entries were removed
+        if (hash->size > hash->capacity - hash->capacity / 4) {
+            hash->capacity *= 2;
+            hash->entries = MTPSCRIPT_REALLOC(hash->entries, sizeof(mtpscript_hash_entry_t) * hash->capacity);
+        }
+        hash_rehash(hash, 2 * hash->capacity);
+        pos = hash_find_slot(hash, key, h);
     }
-    hash->entries[hash->size].key = strdup(key);
-    hash->entries[hash->size].value = value;
+    mtpscript_hash_entry_t *entry = &hash->entries[hash->count];
+    entry->key = hash_copy_key(hash, key, len);
+    entry->value = value;
+    entry->hash = h;
+    hash->index[pos] = (uint32_t)(++hash->count);
     hash->size++;
 }
 
 void *mtpscript_hash_get(mtpscript_hash_t *hash, const char *key) {
-    for (size_t i = 0; i < hash->size; i++) {
-        if (strcmp(hash->entries[i].key, key) == 0) {
-            return hash->entries[i].value;
+    size_t len;
+    uint32_t h = hash_key(key, &len);
+    uint32_t e = hash->index[hash_find_slot(hash, key, h)];
+    return e ? hash->entries[e - 1].value : NULL;
+}
+
+bool mtpscript_hash_has(mtpscript_hash_t *hash, const char *key) {
+    size_t len;
+    uint32_t h = hash_key(key, &len);
+    return hash->index[hash_find_slot(hash, key, h)] != 0;
+}
+
+bool mtpscript_hash_remove(mtpscript_hash_t *hash, const char *key) {
+    size_t len;
+    uint32_t h = hash_key(key, &len);
+    size_t pos = hash_find_slot(hash, key, h);
+    uint32_t e = hash->index[pos];
+    if (e == 0) return false;
+    // The entry stays in place so that iteration order is kept
+    hash->entries[e - 1].key = NULL;
+    hash->entries[e - 1].value = NULL;
+    hash->size--;
+
+    // Backward shift deletion: no tombstones in the index
+    size_t hole = pos;
+    for (;;) {
+        pos = (pos + 1) & hash->index_mask;
+        e = hash->index[pos];
+        if (e == 0) break;
+        size_t home = hash->entries[e - 1].hash & hash->index_mask;
+        // Move the entry if its home slot is not in (hole, pos]
+        if (((pos - home) & hash->index_mask) >= ((pos - hole) & hash->index_mask)) {
+            hash->index[hole] = e;
+            hole = pos;
         }
     }
-    return NULL;
+    hash->index[hole] = 0;
+    return true;
 }
 
 // Hash iteration implementation
@@ -145,27 +395,25 @@ void mtpscript_hash_iterator_free(mtpscript_hash_iterator_t *iter) {
 }
 
 bool mtpscript_hash_iterator_next(mtpscript_hash_iterator_t *iter) {
-    while (iter->index < iter->hash->size) {
-        if (iter->hash->entries[iter->index].key != NULL) {
+    while (iter->index < iter->hash->count) {
+        // Skip the removed entries
+        if (iter->hash->entries[iter->index++].key != NULL) {
             return true;
         }
-        iter->index++;
     }
     return false;
 }
 
 const char *mtpscript_hash_iterator_key(mtpscript_hash_iterator_t *iter) {
-    if (iter->index < iter->hash->size) {
-        return iter->hash->entries[iter->index].key;
+    if (iter->index > 0 && iter->index <= iter->hash->count) {
+        return iter->hash->entries[iter->index - 1].key;
     }
     return NULL;
 }
 
 void *mtpscript_hash_iterator_value(mtpscript_hash_iterator_t *iter) {
-    if (iter->index < iter->hash->size) {
-        void *value = iter->hash->entries[iter->index].value;
-        iter->index++; // Advance to next entry
-        return value;
+    if (iter->index > 0 && iter->index <= iter->hash->count) {
+        return iter->hash->entries[iter->index - 1].value;
     }
     return NULL;
 }
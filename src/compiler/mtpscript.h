@@ -19,6 +19,22 @@
 #define MTPSCRIPT_FREE free
 #define MTPSCRIPT_REALLOC realloc
 
+// Bump arena for one compilation unit. Objects are never freed one by
+// one: tokens, AST nodes and their strings all go away with the arena.
+typedef struct mtpscript_arena_block mtpscript_arena_block_t;
+
+typedef struct {
+    mtpscript_arena_block_t *blocks;
+    char *ptr;               // Free space in the current block
+    char *end;
+} mtpscript_arena_t;
+
+mtpscript_arena_t *mtpscript_arena_new(void);
+void mtpscript_arena_free(mtpscript_arena_t *arena);
+void *mtpscript_arena_alloc(mtpscript_arena_t *arena, size_t size);
+// Copy 'len' bytes of 'str' and add a trailing '\0'
+char *mtpscript_arena_strndup(mtpscript_arena_t *arena, const char *str, size_t len);
+
 // Error handling
 typedef struct {
     int line;
@@ -42,10 +58,14 @@ typedef struct mtpscript_string_t {
     char *data;
     size_t length;
     size_t capacity;
+    mtpscript_arena_t *arena;    // Owner, NULL if heap allocated
 } mtpscript_string_t;
 
 mtpscript_string_t *mtpscript_string_new(void);
 mtpscript_string_t *mtpscript_string_from_cstr(const char *cstr);
+// String allocated in 'arena' (or on the heap if NULL). mtpscript_string_free()
+// ignores arena strings.
+mtpscript_string_t *mtpscript_arena_string_new(mtpscript_arena_t *arena, const char *data, size_t len);
 void mtpscript_string_free(mtpscript_string_t *str);
 void mtpscript_string_append(mtpscript_string_t *str, const char *data, size_t len);
 void mtpscript_string_append_cstr(mtpscript_string_t *str, const char *data);
@@ -56,34 +76,56 @@ typedef struct {
     void **items;
     size_t size;
     size_t capacity;
+    mtpscript_arena_t *arena;    // Owner, NULL if heap allocated
 } mtpscript_vector_t;
 
 mtpscript_vector_t *mtpscript_vector_new(void);
+// Vector allocated in 'arena' (or on the heap if NULL). mtpscript_vector_free()
+// ignores arena vectors.
+mtpscript_vector_t *mtpscript_arena_vector_new(mtpscript_arena_t *arena);
 void mtpscript_vector_free(mtpscript_vector_t *vec);
 void mtpscript_vector_push(mtpscript_vector_t *vec, void *item);
 void *mtpscript_vector_get(mtpscript_vector_t *vec, size_t index);
 
-// Hash table
+// Hash table: open addressing with linear probing over an index of
+// entry numbers. The entries are kept in insertion order, so iteration
+// is deterministic. Keys are copied into blocks owned by the table.
 typedef struct {
-    const char *key;
+    const char *key;     // NULL for a removed entry
     void *value;
+    uint32_t hash;
 } mtpscript_hash_entry_t;
 
+struct mtpscript_hash_key_block;
+
 typedef struct {
     mtpscript_hash_entry_t *entries;
-    size_t size;
+    size_t size;         // Live entries
+    size_t count;        // Used entries, including removed ones
     size_t capacity;
+    uint32_t *index;     // Entry number + 1, 0 if free
+    size_t index_mask;   // Index size - 1 (power of two)
+    struct mtpscript_hash_key_block *keys;
 } mtpscript_hash_t;
 
+// Entries in insertion order: each mtpscript_hash_iterator_next() moves to
+// the next entry, whose key and value are then read without moving
 typedef struct {
     mtpscript_hash_t *hash;
-    size_t index;
+    size_t index;  // Current entry + 1, 0 before the first next()
 } mtpscript_hash_iterator_t;
 
 mtpscript_hash_t *mtpscript_hash_new(void);
 void mtpscript_hash_free(mtpscript_hash_t *hash);
 void mtpscript_hash_set(mtpscript_hash_t *hash, const char *key, void *value);
 void *mtpscript_hash_get(mtpscript_hash_t *hash, const char *key);
+bool mtpscript_hash_has(mtpscript_hash_t *hash, const char *key);
+// Return false if the key was not present
+bool mtpscript_hash_remove(mtpscript_hash_t *hash, const char *key);
+
+// FNV-1a 64-bit hashing
+uint64_t mtpscript_fnv1a_64(const void *data, size_t length);
+uint64_t mtpscript_fnv1a_64_string(const char *str);
 
 // Hash iteration
 mtpscript_hash_iterator_t *mtpscript_hash_iterator_new(mtpscript_hash_t *hash);
@@ -0,0 +1,937 @@
+/**
+ * MTPScript AST Optimizer Implementation
+ * Specification §5.0
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ */
+
+#include "optimizer.h"
+#include "decimal128.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Maximum nesting of inlined calls
+#define OPT_INLINE_DEPTH 4
+// Maximum number of simplification rounds per function
+#define OPT_MAX_ROUNDS 4
+// Integers above 2^53 are not exact in the generated JavaScript
+#define OPT_MAX_SAFE_INT ((int64_t)1 << 53)
+
+typedef struct {
+    mtpscript_arena_t *arena;
+    mtpscript_hash_t *functions;         // Name -> mtpscript_function_decl_t
+    mtpscript_hash_t *impure;            // Names of the functions with effects
+    mtpscript_hash_t *throwing;          // Names of the functions which may throw
+    mtpscript_function_decl_t *current;  // Function being optimized
+    mtpscript_hash_t *locals;            // Parameters and bindings of 'current'
+    int temp_count;                      // CSE temporaries of 'current'
+    bool changed;
+} opt_state_t;
+
+// Uses of a name in an expression
+typedef struct {
+    int vars;      // Variable references
+    int calls;     // Called function names
+    int patterns;  // Match patterns, which are raw code
+    int arms;      // Variable references and calls in match arms
+} opt_uses_t;
+
+static const char *opt_cstr(mtpscript_string_t *str) {
+    return mtpscript_string_cstr(str);
+}
+
+static mtpscript_string_t *opt_string(opt_state_t *s, const char *str) {
+    return mtpscript_arena_string_new(s->arena, str, strlen(str));
+}
+
+static bool opt_is_literal(mtpscript_expression_t *expr) {
+    return expr->kind == MTPSCRIPT_EXPR_INT_LITERAL ||
+           expr->kind == MTPSCRIPT_EXPR_STRING_LITERAL ||
+           expr->kind == MTPSCRIPT_EXPR_BOOL_LITERAL ||
+           expr->kind == MTPSCRIPT_EXPR_DECIMAL_LITERAL;
+}
+
+static bool opt_is_trivial(mtpscript_expression_t *expr) {
+    return opt_is_literal(expr) || expr->kind == MTPSCRIPT_EXPR_VARIABLE;
+}
+
+static mtpscript_expression_t *opt_variable(opt_state_t *s, mtpscript_string_t *name) {
+    mtpscript_expression_t *expr = mtpscript_expression_new(s->arena, MTPSCRIPT_EXPR_VARIABLE);
+    expr->data.variable.name = name;
+    return expr;
+}
+
+// Number of nodes, used for the inlining budget
+static size_t opt_size(mtpscript_expression_t *expr) {
+    size_t size = 1;
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            size += opt_size(expr->data.binary.left) + opt_size(expr->data.binary.right);
+            break;
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                size += opt_size(mtpscript_vector_get(expr->data.call.arguments, i));
+            }
+            break;
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            size += opt_size(expr->data.pipe.left) + opt_size(expr->data.pipe.right);
+            break;
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+            size += opt_size(expr->data.await.expression);
+            break;
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            size += opt_size(expr->data.match.scrutinee);
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                size += 1 + opt_size(arm->body);
+            }
+            break;
+        case MTPSCRIPT_EXPR_BLOCK_EXPR:
+            size += MTPSCRIPT_OPT_INLINE_BUDGET;
+            break;
+        default:
+            break;
+    }
+    return size;
+}
+
+// Structural equality
+static bool opt_equal(mtpscript_expression_t *a, mtpscript_expression_t *b) {
+    if (a->kind != b->kind) return false;
+    switch (a->kind) {
+        case MTPSCRIPT_EXPR_INT_LITERAL:
+            return a->data.int_val == b->data.int_val;
+        case MTPSCRIPT_EXPR_BOOL_LITERAL:
+            return a->data.bool_val == b->data.bool_val;
+        case MTPSCRIPT_EXPR_STRING_LITERAL:
+            return strcmp(opt_cstr(a->data.string_val), opt_cstr(b->data.string_val)) == 0;
+        case MTPSCRIPT_EXPR_DECIMAL_LITERAL:
+            return strcmp(opt_cstr(a->data.decimal_val), opt_cstr(b->data.decimal_val)) == 0;
+        case MTPSCRIPT_EXPR_VARIABLE:
+            return strcmp(opt_cstr(a->data.variable.name), opt_cstr(b->data.variable.name)) == 0;
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            return strcmp(a->data.binary.op, b->data.binary.op) == 0 &&
+                   opt_equal(a->data.binary.left, b->data.binary.left) &&
+                   opt_equal(a->data.binary.right, b->data.binary.right);
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            if (strcmp(opt_cstr(a->data.call.function_name), opt_cstr(b->data.call.function_name)) != 0 ||
+                a->data.call.arguments->size != b->data.call.arguments->size) {
+                return false;
+            }
+            for (size_t i = 0; i < a->data.call.arguments->size; i++) {
+                if (!opt_equal(mtpscript_vector_get(a->data.call.arguments, i),
+                               mtpscript_vector_get(b->data.call.arguments, i))) {
+                    return false;
+                }
+            }
+            return true;
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            return opt_equal(a->data.pipe.left, b->data.pipe.left) &&
+                   opt_equal(a->data.pipe.right, b->data.pipe.right);
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            if (a->data.match.arms->size != b->data.match.arms->size ||
+                !opt_equal(a->data.match.scrutinee, b->data.match.scrutinee)) {
+                return false;
+            }
+            for (size_t i = 0; i < a->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm_a = mtpscript_vector_get(a->data.match.arms, i);
+                mtpscript_match_arm_t *arm_b = mtpscript_vector_get(b->data.match.arms, i);
+                if (strcmp(opt_cstr(arm_a->pattern), opt_cstr(arm_b->pattern)) != 0 ||
+                    !opt_equal(arm_a->body, arm_b->body)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            // Awaits and blocks are never merged
+            return false;
+    }
+}
+
+// True if evaluating 'expr' has no effect. Calls are pure if they target a
+// user function without effects; awaits and unknown functions are not.
+static bool opt_is_pure(opt_state_t *s, mtpscript_expression_t *expr) {
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_INT_LITERAL:
+        case MTPSCRIPT_EXPR_STRING_LITERAL:
+        case MTPSCRIPT_EXPR_BOOL_LITERAL:
+        case MTPSCRIPT_EXPR_DECIMAL_LITERAL:
+        case MTPSCRIPT_EXPR_VARIABLE:
+            return true;
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            return opt_is_pure(s, expr->data.binary.left) && opt_is_pure(s, expr->data.binary.right);
+        case MTPSCRIPT_EXPR_FUNCTION_CALL: {
+            const char *name = opt_cstr(expr->data.call.function_name);
+            if (!mtpscript_hash_has(s->functions, name) || mtpscript_hash_has(s->impure, name)) return false;
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                if (!opt_is_pure(s, mtpscript_vector_get(expr->data.call.arguments, i))) return false;
+            }
+            return true;
+        }
+        case MTPSCRIPT_EXPR_PIPE_EXPR: {
+            mtpscript_expression_t *right = expr->data.pipe.right;
+            if (right->kind != MTPSCRIPT_EXPR_VARIABLE) return false;
+            const char *name = opt_cstr(right->data.variable.name);
+            return mtpscript_hash_has(s->functions, name) && !mtpscript_hash_has(s->impure, name) &&
+                   opt_is_pure(s, expr->data.pipe.left);
+        }
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            if (!opt_is_pure(s, expr->data.match.scrutinee)) return false;
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                if (!opt_is_pure(s, arm->body)) return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// True if evaluating 'expr' may throw: a match without a '_' arm fails
+// when no arm applies, and so do the calls of functions containing one and
+// of unknown functions. The operands of the operators are type checked. A
+// pure expression which may throw is kept where it is evaluated.
+static bool opt_may_throw(opt_state_t *s, mtpscript_expression_t *expr) {
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_INT_LITERAL:
+        case MTPSCRIPT_EXPR_STRING_LITERAL:
+        case MTPSCRIPT_EXPR_BOOL_LITERAL:
+        case MTPSCRIPT_EXPR_DECIMAL_LITERAL:
+        case MTPSCRIPT_EXPR_VARIABLE:
+            return false;
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            return opt_may_throw(s, expr->data.binary.left) || opt_may_throw(s, expr->data.binary.right);
+        case MTPSCRIPT_EXPR_FUNCTION_CALL: {
+            const char *name = opt_cstr(expr->data.call.function_name);
+            if (!mtpscript_hash_has(s->functions, name) || mtpscript_hash_has(s->throwing, name)) return true;
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                if (opt_may_throw(s, mtpscript_vector_get(expr->data.call.arguments, i))) return true;
+            }
+            return false;
+        }
+        case MTPSCRIPT_EXPR_PIPE_EXPR: {
+            mtpscript_expression_t *right = expr->data.pipe.right;
+            if (right->kind != MTPSCRIPT_EXPR_VARIABLE) return true;
+            const char *name = opt_cstr(right->data.variable.name);
+            return !mtpscript_hash_has(s->functions, name) || mtpscript_hash_has(s->throwing, name) ||
+                   opt_may_throw(s, expr->data.pipe.left);
+        }
+        case MTPSCRIPT_EXPR_MATCH_EXPR: {
+            mtpscript_vector_t *arms = expr->data.match.arms;
+            mtpscript_match_arm_t *last = arms->size ? mtpscript_vector_get(arms, arms->size - 1) : NULL;
+            if (!last || strcmp(opt_cstr(last->pattern), "_") != 0) return true;
+            if (opt_may_throw(s, expr->data.match.scrutinee)) return true;
+            for (size_t i = 0; i < arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(arms, i);
+                if (opt_may_throw(s, arm->body)) return true;
+            }
+            return false;
+        }
+        default:
+            return true;
+    }
+}
+
+static void opt_count_uses(mtpscript_expression_t *expr, const char *name, opt_uses_t *uses) {
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_VARIABLE:
+            if (strcmp(opt_cstr(expr->data.variable.name), name) == 0) uses->vars++;
+            break;
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            opt_count_uses(expr->data.binary.left, name, uses);
+            opt_count_uses(expr->data.binary.right, name, uses);
+            break;
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            if (strcmp(opt_cstr(expr->data.call.function_name), name) == 0) uses->calls++;
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                opt_count_uses(mtpscript_vector_get(expr->data.call.arguments, i), name, uses);
+            }
+            break;
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            opt_count_uses(expr->data.pipe.left, name, uses);
+            opt_count_uses(expr->data.pipe.right, name, uses);
+            break;
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+            opt_count_uses(expr->data.await.expression, name, uses);
+            break;
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            opt_count_uses(expr->data.match.scrutinee, name, uses);
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                int evaluated = uses->vars + uses->calls;
+                if (strcmp(opt_cstr(arm->pattern), name) == 0) uses->patterns++;
+                opt_count_uses(arm->body, name, uses);
+                uses->arms += uses->vars + uses->calls - evaluated;
+            }
+            break;
+        case MTPSCRIPT_EXPR_BLOCK_EXPR:
+            // Opaque: count it as a use of every name
+            uses->patterns++;
+            break;
+        default:
+            break;
+    }
+}
+
+static mtpscript_expression_t *opt_statement_expression(mtpscript_statement_t *stmt) {
+    switch (stmt->kind) {
+        case MTPSCRIPT_STMT_VAR_DECL: return stmt->data.var_decl.initializer;
+        case MTPSCRIPT_STMT_RETURN_STMT: return stmt->data.return_stmt.expression;
+        case MTPSCRIPT_STMT_EXPRESSION_STMT: return stmt->data.expression_stmt.expression;
+    }
+    return NULL;
+}
+
+static void opt_set_statement_expression(mtpscript_statement_t *stmt, mtpscript_expression_t *expr) {
+    switch (stmt->kind) {
+        case MTPSCRIPT_STMT_VAR_DECL: stmt->data.var_decl.initializer = expr; break;
+        case MTPSCRIPT_STMT_RETURN_STMT: stmt->data.return_stmt.expression = expr; break;
+        case MTPSCRIPT_STMT_EXPRESSION_STMT: stmt->data.expression_stmt.expression = expr; break;
+    }
+}
+
+// Uses of 'name' in the statements of 'body' from 'start'
+static opt_uses_t opt_body_uses(mtpscript_vector_t *body, size_t start, const char *name) {
+    opt_uses_t uses = {0, 0, 0, 0};
+    for (size_t i = start; i < body->size; i++) {
+        mtpscript_expression_t *expr = opt_statement_expression(mtpscript_vector_get(body, i));
+        if (expr) opt_count_uses(expr, name, &uses);
+    }
+    return uses;
+}
+
+// Copy of 'expr' where the variables named in 'names' are replaced by
+// copies of 'values'. Called names are renamed if the value is a variable.
+static mtpscript_expression_t *opt_substitute(opt_state_t *s, mtpscript_expression_t *expr,
+                                              mtpscript_string_t **names, mtpscript_expression_t **values, size_t count) {
+    mtpscript_expression_t *copy;
+
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_VARIABLE:
+            for (size_t i = 0; i < count; i++) {
+                if (strcmp(opt_cstr(expr->data.variable.name), opt_cstr(names[i])) == 0) {
+                    return opt_substitute(s, values[i], NULL, NULL, 0);
+                }
+            }
+            break;
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            copy = mtpscript_expression_new(s->arena, expr->kind);
+            copy->location = expr->location;
+            copy->data.binary.op = expr->data.binary.op;
+            copy->data.binary.left = opt_substitute(s, expr->data.binary.left, names, values, count);
+            copy->data.binary.right = opt_substitute(s, expr->data.binary.right, names, values, count);
+            return copy;
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            copy = mtpscript_expression_new(s->arena, expr->kind);
+            copy->location = expr->location;
+            copy->data.call.function_name = expr->data.call.function_name;
+            for (size_t i = 0; i < count; i++) {
+                if (strcmp(opt_cstr(expr->data.call.function_name), opt_cstr(names[i])) == 0 &&
+                    values[i]->kind == MTPSCRIPT_EXPR_VARIABLE) {
+                    copy->data.call.function_name = values[i]->data.variable.name;
+                }
+            }
+            copy->data.call.arguments = mtpscript_arena_vector_new(s->arena);
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                mtpscript_vector_push(copy->data.call.arguments,
+                                      opt_substitute(s, mtpscript_vector_get(expr->data.call.arguments, i), names, values, count));
+            }
+            return copy;
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            copy = mtpscript_expression_new(s->arena, expr->kind);
+            copy->location = expr->location;
+            copy->data.pipe.left = opt_substitute(s, expr->data.pipe.left, names, values, count);
+            copy->data.pipe.right = opt_substitute(s, expr->data.pipe.right, names, values, count);
+            return copy;
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+            copy = mtpscript_expression_new(s->arena, expr->kind);
+            copy->location = expr->location;
+            copy->data.await.expression = opt_substitute(s, expr->data.await.expression, names, values, count);
+            return copy;
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            copy = mtpscript_expression_new(s->arena, expr->kind);
+            copy->location = expr->location;
+            copy->data.match.scrutinee = opt_substitute(s, expr->data.match.scrutinee, names, values, count);
+            copy->data.match.arms = mtpscript_arena_vector_new(s->arena);
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                mtpscript_match_arm_t *arm_copy = mtpscript_arena_alloc(s->arena, sizeof(mtpscript_match_arm_t));
+                arm_copy->pattern = arm->pattern;
+                arm_copy->body = opt_substitute(s, arm->body, names, values, count);
+                mtpscript_vector_push(copy->data.match.arms, arm_copy);
+            }
+            return copy;
+        default:
+            break;
+    }
+
+    // Leaves are immutable and can be shared
+    return expr;
+}
+
+// Integer folding with the semantics of the generated JavaScript: the
+// result must be an exact integer and not -0
+static bool opt_fold_int(const char *op, int64_t a, int64_t b, int64_t *result) {
+    int64_t r;
+
+    if (a > OPT_MAX_SAFE_INT || a < -OPT_MAX_SAFE_INT || b > OPT_MAX_SAFE_INT || b < -OPT_MAX_SAFE_INT) {
+        return false;
+    }
+    if (strcmp(op, "+") == 0) {
+        r = a + b;
+    } else if (strcmp(op, "-") == 0) {
+        r = a - b;
+    } else if (strcmp(op, "*") == 0) {
+        if (__builtin_mul_overflow(a, b, &r)) return false;
+        if (r == 0 && (a < 0 || b < 0)) return false;
+    } else if (strcmp(op, "/") == 0) {
+        if (b == 0 || a % b != 0) return false;
+        r = a / b;
+        if (r == 0 && b < 0) return false;
+    } else {
+        return false;
+    }
+    if (r > OPT_MAX_SAFE_INT || r < -OPT_MAX_SAFE_INT) return false;
+    *result = r;
+    return true;
+}
+
+// Decimal folding. The literals are JavaScript numbers at run time, so
+// the exact result is only used if the double computation agrees.
+static bool opt_fold_decimal(const char *op, const char *a_str, const char *b_str, char *buf) {
+    Decimal128 a, b, r;
+    double a_val, b_val, r_val;
+    int ret;
+
+    if (dec128_from_string(&a, a_str, strlen(a_str)) != DEC128_OK ||
+        dec128_from_string(&b, b_str, strlen(b_str)) != DEC128_OK) {
+        return false;
+    }
+    a_val = strtod(a_str, NULL);
+    b_val = strtod(b_str, NULL);
+    if (strcmp(op, "+") == 0) {
+        ret = dec128_add(&r, &a, &b);
+        r_val = a_val + b_val;
+    } else if (strcmp(op, "-") == 0) {
+        ret = dec128_sub(&r, &a, &b);
+        r_val = a_val - b_val;
+    } else if (strcmp(op, "*") == 0) {
+        ret = dec128_mul(&r, &a, &b);
+        r_val = a_val * b_val;
+    } else if (strcmp(op, "/") == 0) {
+        ret = dec128_div(&r, &a, &b);
+        r_val = a_val / b_val;
+    } else {
+        return false;
+    }
+    if (ret != DEC128_OK || (r_val == 0 && signbit(r_val))) return false;
+    dec128_to_string(buf, &r);
+    return strtod(buf, NULL) == r_val;
+}
+
+static mtpscript_expression_t *opt_fold_binary(opt_state_t *s, mtpscript_expression_t *expr) {
+    mtpscript_expression_t *left = expr->data.binary.left;
+    mtpscript_expression_t *right = expr->data.binary.right;
+    const char *op = expr->data.binary.op;
+    mtpscript_expression_t *result = NULL;
+
+    if (left->kind == MTPSCRIPT_EXPR_INT_LITERAL && right->kind == MTPSCRIPT_EXPR_INT_LITERAL) {
+        int64_t value;
+        if (opt_fold_int(op, left->data.int_val, right->data.int_val, &value)) {
+            result = mtpscript_expression_new(s->arena, MTPSCRIPT_EXPR_INT_LITERAL);
+            result->data.int_val = value;
+        }
+    } else if (left->kind == MTPSCRIPT_EXPR_DECIMAL_LITERAL && right->kind == MTPSCRIPT_EXPR_DECIMAL_LITERAL) {
+        char buf[DEC128_MAX_STR_LEN + 1];
+        if (opt_fold_decimal(op, opt_cstr(left->data.decimal_val), opt_cstr(right->data.decimal_val), buf)) {
+            result = mtpscript_expression_new(s->arena, MTPSCRIPT_EXPR_DECIMAL_LITERAL);
+            result->data.decimal_val = opt_string(s, buf);
+        }
+    }
+    if (!result) return expr;
+
+    result->location = expr->location;
+    s->changed = true;
+    return result;
+}
+
+// Compare a literal scrutinee with a pattern: 1 if equal, 0 if not, -1 if
+// the pattern is not a literal
+static int opt_match_literal(mtpscript_expression_t *value, const char *pattern) {
+    char *end;
+
+    if (strcmp(pattern, "_") == 0) return 1;
+    // 1.0 === 1 in the generated code
+    if (value->kind == MTPSCRIPT_EXPR_DECIMAL_LITERAL) return -1;
+    if (strcmp(pattern, "true") == 0 || strcmp(pattern, "false") == 0) {
+        return value->kind == MTPSCRIPT_EXPR_BOOL_LITERAL && value->data.bool_val == (pattern[0] == 't');
+    }
+    if (pattern[0] == '"') {
+        size_t len = strlen(pattern);
+        if (len < 2 || pattern[len - 1] != '"' || memchr(pattern + 1, '\\', len - 2)) return -1;
+        return value->kind == MTPSCRIPT_EXPR_STRING_LITERAL &&
+               strlen(opt_cstr(value->data.string_val)) == len - 2 &&
+               memcmp(opt_cstr(value->data.string_val), pattern + 1, len - 2) == 0;
+    }
+    long long n = strtoll(pattern, &end, 10);
+    if (end == pattern || *end != '\0') return -1;
+    return value->kind == MTPSCRIPT_EXPR_INT_LITERAL && value->data.int_val == n;
+}
+
+static mtpscript_expression_t *opt_expression(opt_state_t *s, mtpscript_expression_t *expr, int depth);
+
+// Inline a call to a pure function whose body is a single small return
+static mtpscript_expression_t *opt_inline_call(opt_state_t *s, mtpscript_expression_t *expr, int depth) {
+    const char *name = opt_cstr(expr->data.call.function_name);
+    mtpscript_function_decl_t *func = mtpscript_hash_get(s->functions, name);
+    mtpscript_vector_t *args = expr->data.call.arguments;
+
+    if (!func || func == s->current || depth >= OPT_INLINE_DEPTH || mtpscript_hash_has(s->impure, name)) {
+        return expr;
+    }
+    if (func->body->size != 1 || func->params->size != args->size) return expr;
+    mtpscript_statement_t *ret = mtpscript_vector_get(func->body, 0);
+    if (ret->kind != MTPSCRIPT_STMT_RETURN_STMT || !ret->data.return_stmt.expression) return expr;
+    mtpscript_expression_t *body = ret->data.return_stmt.expression;
+    if (opt_size(body) > MTPSCRIPT_OPT_INLINE_BUDGET || !opt_is_pure(s, body)) return expr;
+
+    mtpscript_string_t *names[args->size ? args->size : 1];
+    mtpscript_expression_t *values[args->size ? args->size : 1];
+    for (size_t i = 0; i < args->size; i++) {
+        mtpscript_param_t *param = mtpscript_vector_get(func->params, i);
+        mtpscript_expression_t *arg = mtpscript_vector_get(args, i);
+        opt_uses_t uses = {0, 0, 0, 0};
+        opt_count_uses(body, opt_cstr(param->name), &uses);
+
+        // Arguments are evaluated once and in order by a call: inline
+        // only if moving or duplicating them is not observable, nor
+        // dropping one which may throw
+        if (!opt_is_pure(s, arg) || uses.patterns > 0) return expr;
+        if (opt_may_throw(s, arg) && (uses.vars + uses.calls == 0 || uses.arms > 0)) return expr;
+        if (uses.calls > 0 && arg->kind != MTPSCRIPT_EXPR_VARIABLE) return expr;
+        if (uses.vars + uses.calls > 1 && !opt_is_trivial(arg)) return expr;
+        names[i] = param->name;
+        values[i] = arg;
+    }
+
+    // The other names of the body must not be captured by the caller
+    bool captured = false;
+    mtpscript_hash_iterator_t *iter = mtpscript_hash_iterator_new(s->locals);
+    while (!captured && mtpscript_hash_iterator_next(iter)) {
+        const char *local = mtpscript_hash_iterator_key(iter);
+        bool is_param = false;
+        for (size_t j = 0; j < args->size; j++) {
+            if (strcmp(local, opt_cstr(names[j])) == 0) is_param = true;
+        }
+        opt_uses_t uses = {0, 0, 0, 0};
+        opt_count_uses(body, local, &uses);
+        captured = !is_param && uses.vars + uses.calls + uses.patterns > 0;
+    }
+    mtpscript_hash_iterator_free(iter);
+    if (captured) return expr;
+
+    s->changed = true;
+    return opt_expression(s, opt_substitute(s, body, names, values, args->size), depth + 1);
+}
+
+// Fold, inline and simplify 'expr' bottom-up; return the new expression
+static mtpscript_expression_t *opt_expression(opt_state_t *s, mtpscript_expression_t *expr, int depth) {
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            expr->data.binary.left = opt_expression(s, expr->data.binary.left, depth);
+            expr->data.binary.right = opt_expression(s, expr->data.binary.right, depth);
+            return opt_fold_binary(s, expr);
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                expr->data.call.arguments->items[i] =
+                    opt_expression(s, mtpscript_vector_get(expr->data.call.arguments, i), depth);
+            }
+            return opt_inline_call(s, expr, depth);
+        case MTPSCRIPT_EXPR_PIPE_EXPR: {
+            // x |> f is the direct call f(x)
+            mtpscript_expression_t *right = expr->data.pipe.right;
+            expr->data.pipe.left = opt_expression(s, expr->data.pipe.left, depth);
+            if (right->kind != MTPSCRIPT_EXPR_VARIABLE) return expr;
+            mtpscript_expression_t *call = mtpscript_expression_new(s->arena, MTPSCRIPT_EXPR_FUNCTION_CALL);
+            call->location = expr->location;
+            call->data.call.function_name = right->data.variable.name;
+            call->data.call.arguments = mtpscript_arena_vector_new(s->arena);
+            mtpscript_vector_push(call->data.call.arguments, expr->data.pipe.left);
+            s->changed = true;
+            return opt_inline_call(s, call, depth);
+        }
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+            expr->data.await.expression = opt_expression(s, expr->data.await.expression, depth);
+            return expr;
+        case MTPSCRIPT_EXPR_MATCH_EXPR: {
+            mtpscript_expression_t *scrutinee = opt_expression(s, expr->data.match.scrutinee, depth);
+            expr->data.match.scrutinee = scrutinee;
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                arm->body = opt_expression(s, arm->body, depth);
+            }
+            // A literal scrutinee selects its arm, as long as the patterns
+            // before it are literals too
+            if (!opt_is_literal(scrutinee)) return expr;
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                int ret = opt_match_literal(scrutinee, opt_cstr(arm->pattern));
+                if (ret < 0) break;
+                if (ret > 0) {
+                    s->changed = true;
+                    return arm->body;
+                }
+            }
+            return expr;
+        }
+        default:
+            return expr;
+    }
+}
+
+// Replace the variables bound to literals or to other variables by their
+// value, and the pure bindings used once by their expression. Only names
+// bound once in the body are considered.
+static bool opt_names_unique(opt_state_t *s, mtpscript_expression_t *expr) {
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_VARIABLE:
+            return (intptr_t)mtpscript_hash_get(s->locals, opt_cstr(expr->data.variable.name)) <= 1;
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            return opt_names_unique(s, expr->data.binary.left) && opt_names_unique(s, expr->data.binary.right);
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                if (!opt_names_unique(s, mtpscript_vector_get(expr->data.call.arguments, i))) return false;
+            }
+            return true;
+        default:
+            return opt_is_literal(expr);
+    }
+}
+
+static void opt_propagate(opt_state_t *s, mtpscript_vector_t *body) {
+    for (size_t i = 0; i < body->size; i++) {
+        mtpscript_statement_t *stmt = mtpscript_vector_get(body, i);
+        if (stmt->kind != MTPSCRIPT_STMT_VAR_DECL) continue;
+        mtpscript_string_t *name = stmt->data.var_decl.name;
+        mtpscript_expression_t *value = stmt->data.var_decl.initializer;
+        if (!value || !opt_is_pure(s, value) || !opt_names_unique(s, value)) continue;
+        if ((intptr_t)mtpscript_hash_get(s->locals, opt_cstr(name)) != 1) continue;
+
+        opt_uses_t uses = opt_body_uses(body, i + 1, opt_cstr(name));
+        if (uses.vars + uses.calls == 0 || uses.patterns > 0) continue;
+        if (uses.calls > 0 && value->kind != MTPSCRIPT_EXPR_VARIABLE) continue;
+        if (!opt_is_trivial(value) && uses.vars > 1) continue;
+        // A value which may throw is moved, not copied: into the next
+        // statement if it has no effects, and not into a match arm
+        bool moved = opt_may_throw(s, value);
+        if (moved) {
+            opt_uses_t later = opt_body_uses(body, i + 2, opt_cstr(name));
+            mtpscript_expression_t *next = opt_statement_expression(mtpscript_vector_get(body, i + 1));
+            if (uses.arms > 0 || later.vars + later.calls > 0 || !next || !opt_is_pure(s, next)) continue;
+        }
+        for (size_t j = i + 1; j < body->size; j++) {
+            mtpscript_statement_t *use = mtpscript_vector_get(body, j);
+            mtpscript_expression_t *expr = opt_statement_expression(use);
+            if (expr) opt_set_statement_expression(use, opt_substitute(s, expr, &name, &value, 1));
+        }
+        if (moved) stmt->data.var_decl.initializer = NULL;
+        s->changed = true;
+    }
+}
+
+// Remove the statements after a return, the pure expression statements
+// and the pure bindings that are never used, unless they may throw
+static mtpscript_vector_t *opt_eliminate(opt_state_t *s, mtpscript_vector_t *body) {
+    bool removed;
+
+    do {
+        mtpscript_vector_t *live = mtpscript_arena_vector_new(s->arena);
+        removed = false;
+        for (size_t i = 0; i < body->size; i++) {
+            mtpscript_statement_t *stmt = mtpscript_vector_get(body, i);
+            mtpscript_expression_t *expr = opt_statement_expression(stmt);
+            bool dead = false;
+
+            if (stmt->kind == MTPSCRIPT_STMT_EXPRESSION_STMT) {
+                dead = !expr || (opt_is_pure(s, expr) && !opt_may_throw(s, expr));
+            } else if (stmt->kind == MTPSCRIPT_STMT_VAR_DECL) {
+                opt_uses_t uses = opt_body_uses(body, i + 1, opt_cstr(stmt->data.var_decl.name));
+                dead = uses.vars + uses.calls + uses.patterns == 0 &&
+                       (!expr || (opt_is_pure(s, expr) && !opt_may_throw(s, expr)));
+            }
+            if (dead) {
+                removed = true;
+                continue;
+            }
+            mtpscript_vector_push(live, stmt);
+            if (stmt->kind == MTPSCRIPT_STMT_RETURN_STMT) {
+                removed |= i + 1 < body->size;
+                break;
+            }
+        }
+        if (removed) s->changed = true;
+        body = live;
+    } while (removed);
+
+    return body;
+}
+
+// Unconditionally evaluated candidates for CSE: the pure operators and
+// calls outside of match arms
+static void opt_cse_candidates(opt_state_t *s, mtpscript_expression_t *expr, mtpscript_vector_t *out) {
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            if (opt_is_pure(s, expr)) mtpscript_vector_push(out, expr);
+            opt_cse_candidates(s, expr->data.binary.left, out);
+            opt_cse_candidates(s, expr->data.binary.right, out);
+            break;
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            if (opt_is_pure(s, expr)) mtpscript_vector_push(out, expr);
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                opt_cse_candidates(s, mtpscript_vector_get(expr->data.call.arguments, i), out);
+            }
+            break;
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            opt_cse_candidates(s, expr->data.match.scrutinee, out);
+            break;
+        default:
+            break;
+    }
+}
+
+static mtpscript_expression_t *opt_cse_replace(opt_state_t *s, mtpscript_expression_t *expr,
+                                               mtpscript_expression_t *target, mtpscript_string_t *temp) {
+    if (opt_equal(expr, target)) return opt_variable(s, temp);
+    switch (expr->kind) {
+        case MTPSCRIPT_EXPR_BINARY_EXPR:
+            expr->data.binary.left = opt_cse_replace(s, expr->data.binary.left, target, temp);
+            expr->data.binary.right = opt_cse_replace(s, expr->data.binary.right, target, temp);
+            break;
+        case MTPSCRIPT_EXPR_FUNCTION_CALL:
+            for (size_t i = 0; i < expr->data.call.arguments->size; i++) {
+                expr->data.call.arguments->items[i] =
+                    opt_cse_replace(s, mtpscript_vector_get(expr->data.call.arguments, i), target, temp);
+            }
+            break;
+        case MTPSCRIPT_EXPR_PIPE_EXPR:
+            expr->data.pipe.left = opt_cse_replace(s, expr->data.pipe.left, target, temp);
+            break;
+        case MTPSCRIPT_EXPR_AWAIT_EXPR:
+            expr->data.await.expression = opt_cse_replace(s, expr->data.await.expression, target, temp);
+            break;
+        case MTPSCRIPT_EXPR_MATCH_EXPR:
+            expr->data.match.scrutinee = opt_cse_replace(s, expr->data.match.scrutinee, target, temp);
+            for (size_t i = 0; i < expr->data.match.arms->size; i++) {
+                mtpscript_match_arm_t *arm = mtpscript_vector_get(expr->data.match.arms, i);
+                arm->body = opt_cse_replace(s, arm->body, target, temp);
+            }
+            break;
+        default:
+            break;
+    }
+    return expr;
+}
+
+// Compute the largest pure expression evaluated more than once in a
+// temporary, declared before its first use. Repeat until none is left.
+static mtpscript_vector_t *opt_cse(opt_state_t *s, mtpscript_vector_t *body) {
+    // Candidates of all the statements, those of statement i from start[i]
+    mtpscript_vector_t *candidates = mtpscript_vector_new();
+
+    for (;;) {
+        mtpscript_expression_t *best = NULL;
+        size_t best_size = 0, best_stmt = 0;
+        size_t *start = mtpscript_arena_alloc(s->arena, sizeof(size_t) * (body->size + 1));
+
+        candidates->size = 0;
+        for (size_t i = 0; i < body->size; i++) {
+            mtpscript_expression_t *expr = opt_statement_expression(mtpscript_vector_get(body, i));
+            start[i] = candidates->size;
+            if (expr) opt_cse_candidates(s, expr, candidates);
+        }
+        start[body->size] = candidates->size;
+
+        for (size_t i = 0; i < body->size; i++) {
+            mtpscript_expression_t *expr = opt_statement_expression(mtpscript_vector_get(body, i));
+            // The temporary is computed before the effects of the statement
+            bool effects = expr && !opt_is_pure(s, expr);
+            for (size_t j = start[i]; j < start[i + 1]; j++) {
+                mtpscript_expression_t *candidate = mtpscript_vector_get(candidates, j);
+                size_t size = opt_size(candidate);
+                if (size <= best_size || (effects && opt_may_throw(s, candidate))) continue;
+
+                // Count the occurrences from this statement on
+                int count = 0;
+                for (size_t k = start[i]; k < candidates->size && count < 2; k++) {
+                    if (opt_equal(candidate, mtpscript_vector_get(candidates, k))) count++;
+                }
+                if (count >= 2) {
+                    best = candidate;
+                    best_size = size;
+                    best_stmt = i;
+                }
+            }
+        }
+        if (!best) break;
+
+        char name[32];
+        snprintf(name, sizeof(name), "$cse%d", s->temp_count++);
+        mtpscript_string_t *temp = opt_string(s, name);
+        mtpscript_statement_t *decl = mtpscript_statement_new(s->arena, MTPSCRIPT_STMT_VAR_DECL);
+        decl->data.var_decl.name = temp;
+        decl->data.var_decl.initializer = opt_substitute(s, best, NULL, NULL, 0);
+
+        mtpscript_vector_t *rewritten = mtpscript_arena_vector_new(s->arena);
+        for (size_t i = 0; i < body->size; i++) {
+            mtpscript_statement_t *stmt = mtpscript_vector_get(body, i);
+            mtpscript_expression_t *expr = opt_statement_expression(stmt);
+            if (i == best_stmt) mtpscript_vector_push(rewritten, decl);
+            if (i >= best_stmt && expr) {
+                opt_set_statement_expression(stmt, opt_cse_replace(s, expr, decl->data.var_decl.initializer, temp));
+            }
+            mtpscript_vector_push(rewritten, stmt);
+        }
+        body = rewritten;
+    }
+    mtpscript_vector_free(candidates);
+    return body;
+}
+
+// Record the parameters and bindings of 'func', with their number of
+// declarations. Return false if a name is declared twice.
+static bool opt_collect_locals(opt_state_t *s, mtpscript_function_decl_t *func) {
+    bool unique = true;
+
+    for (size_t i = 0; i < func->params->size; i++) {
+        mtpscript_param_t *param = mtpscript_vector_get(func->params, i);
+        intptr_t n = (intptr_t)mtpscript_hash_get(s->locals, opt_cstr(param->name));
+        if (n) unique = false;
+        mtpscript_hash_set(s->locals, opt_cstr(param->name), (void *)(n + 1));
+    }
+    for (size_t i = 0; i < func->body->size; i++) {
+        mtpscript_statement_t *stmt = mtpscript_vector_get(func->body, i);
+        if (stmt->kind != MTPSCRIPT_STMT_VAR_DECL) continue;
+        intptr_t n = (intptr_t)mtpscript_hash_get(s->locals, opt_cstr(stmt->data.var_decl.name));
+        if (n) unique = false;
+        mtpscript_hash_set(s->locals, opt_cstr(stmt->data.var_decl.name), (void *)(n + 1));
+    }
+    return unique;
+}
+
+static void opt_function(opt_state_t *s, mtpscript_function_decl_t *func, bool cse) {
+    if (!func->body) return;
+
+    s->current = func;
+    s->locals = mtpscript_hash_new();
+    s->temp_count = 0;
+    bool unique = opt_collect_locals(s, func);
+
+    if (cse) {
+        // Shadowed names would make equal expressions differ
+        if (unique) {
+            func->body = opt_cse(s, func->body);
+            opt_propagate(s, func->body);
+            func->body = opt_eliminate(s, func->body);
+        }
+    } else {
+        for (int round = 0; round < OPT_MAX_ROUNDS; round++) {
+            s->changed = false;
+            for (size_t i = 0; i < func->body->size; i++) {
+                mtpscript_statement_t *stmt = mtpscript_vector_get(func->body, i);
+                mtpscript_expression_t *expr = opt_statement_expression(stmt);
+                if (expr) opt_set_statement_expression(stmt, opt_expression(s, expr, 0));
+            }
+            opt_propagate(s, func->body);
+            func->body = opt_eliminate(s, func->body);
+            if (!s->changed) break;
+        }
+    }
+
+    mtpscript_hash_free(s->locals);
+    s->locals = NULL;
+    s->current = NULL;
+}
+
+static mtpscript_function_decl_t *opt_declaration_function(mtpscript_declaration_t *decl) {
+    if (decl->kind == MTPSCRIPT_DECL_FUNCTION) return &decl->data.function;
+    if (decl->kind == MTPSCRIPT_DECL_API) return decl->data.api.handler;
+    return NULL;
+}
+
+mtpscript_error_t *mtpscript_optimize_program(mtpscript_program_t *program) {
+    opt_state_t s;
+    bool changed;
+
+    if (!program->arena) return NULL;
+
+    memset(&s, 0, sizeof(s));
+    s.arena = program->arena;
+    s.functions = mtpscript_hash_new();
+    s.impure = mtpscript_hash_new();
+    s.throwing = mtpscript_hash_new();
+
+    for (size_t i = 0; i < program->declarations->size; i++) {
+        mtpscript_function_decl_t *func = opt_declaration_function(mtpscript_vector_get(program->declarations, i));
+        if (!func || !func->name || !func->params || !func->body) continue;
+        mtpscript_hash_set(s.functions, opt_cstr(func->name), func);
+        if (func->effects && func->effects->size > 0) {
+            mtpscript_hash_set(s.impure, opt_cstr(func->name), (void *)1);
+        }
+    }
+
+    // A function calling an impure function is impure: iterate to a fixpoint
+    do {
+        changed = false;
+        mtpscript_hash_iterator_t *iter = mtpscript_hash_iterator_new(s.functions);
+        while (mtpscript_hash_iterator_next(iter)) {
+            const char *name = mtpscript_hash_iterator_key(iter);
+            mtpscript_function_decl_t *func = mtpscript_hash_iterator_value(iter);
+            if (mtpscript_hash_has(s.impure, name)) continue;
+            for (size_t j = 0; j < func->body->size; j++) {
+                mtpscript_expression_t *expr = opt_statement_expression(mtpscript_vector_get(func->body, j));
+                if (expr && !opt_is_pure(&s, expr)) {
+                    mtpscript_hash_set(s.impure, name, (void *)1);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        mtpscript_hash_iterator_free(iter);
+    } while (changed);
+
+    // Likewise, a function calling a function which may throw may throw
+    do {
+        changed = false;
+        mtpscript_hash_iterator_t *iter = mtpscript_hash_iterator_new(s.functions);
+        while (mtpscript_hash_iterator_next(iter)) {
+            const char *name = mtpscript_hash_iterator_key(iter);
+            mtpscript_function_decl_t *func = mtpscript_hash_iterator_value(iter);
+            if (mtpscript_hash_has(s.throwing, name)) continue;
+            for (size_t j = 0; j < func->body->size; j++) {
+                mtpscript_expression_t *expr = opt_statement_expression(mtpscript_vector_get(func->body, j));
+                if (expr && opt_may_throw(&s, expr)) {
+                    mtpscript_hash_set(s.throwing, name, (void *)1);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        mtpscript_hash_iterator_free(iter);
+    } while (changed);
+
+    // CSE runs last: the temporaries would prevent inlining
+    for (int cse = 0; cse <= 1; cse++) {
+        for (size_t i = 0; i < program->declarations->size; i++) {
+            mtpscript_function_decl_t *func = opt_declaration_function(mtpscript_vector_get(program->declarations, i));
+            if (func && func->params) opt_function(&s, func, cse);
+        }
+    }
+
+    mtpscript_hash_free(s.throwing);
+    mtpscript_hash_free(s.impure);
+    mtpscript_hash_free(s.functions);
+    return NULL;
+}
@@ -0,0 +1,28 @@
+/**
+ * MTPScript AST Optimizer
+ * Specification §5.0
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ */
+
+#ifndef MTPSCRIPT_OPTIMIZER_H
+#define MTPSCRIPT_OPTIMIZER_H
+
+#include "ast.h"
+
+// Maximum number of nodes of an inlined function body
+#define MTPSCRIPT_OPT_INLINE_BUDGET 24
+
+// Rewrite 'program' in place, between type checking and code generation:
+// constant folding (Int and Decimal literals), pipelines turned into
+// calls, inlining of small pure functions, common subexpression
+// elimination and dead code elimination. A function is pure if it
+// declares no effects and only calls pure functions. Pure code which may
+// throw (a match without a '_' arm) is not removed.
+//
+// New nodes are allocated in the program arena and may be shared, so
+// heap allocated trees (program->arena == NULL) are left unchanged.
+mtpscript_error_t *mtpscript_optimize_program(mtpscript_program_t *program);
+
+#endif // MTPSCRIPT_OPTIMIZER_H
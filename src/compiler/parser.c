@@ -10,10 +10,11 @@
 #include <string.h>
 #include <stdio.h>
 
-mtpscript_parser_t *mtpscript_parser_new(mtpscript_vector_t *tokens) {
+mtpscript_parser_t *mtpscript_parser_new(mtpscript_arena_t *arena, mtpscript_vector_t *tokens) {
     mtpscript_parser_t *parser = MTPSCRIPT_MALLOC(sizeof(mtpscript_parser_t));
     parser->tokens = tokens;
     parser->position = 0;
+    parser->arena = arena;
     return parser;
 }
 
@@ -45,118 +46,202 @@ static bool match_token(mtpscript_parser_t *parser, mtpscript_token_type_t type)
     return false;
 }
 
+static const char *binary_op_name(mtpscript_token_type_t type) {
+    switch (type) {
+        case MTPSCRIPT_TOKEN_PLUS: return "+";
+        case MTPSCRIPT_TOKEN_MINUS: return "-";
+        case MTPSCRIPT_TOKEN_STAR: return "*";
+        case MTPSCRIPT_TOKEN_SLASH: return "/";
+        default: return "?";
+    }
+}
+
 static mtpscript_type_t *parse_type(mtpscript_parser_t *parser) {
     mtpscript_token_t *token = advance_token(parser);
     mtpscript_type_t *type;
-    // printf("DEBUG: parse_type sees token: %s\n", mtpscript_string_cstr(token->lexeme));
-
-    if (strcmp(mtpscript_string_cstr(token->lexeme), "Int") == 0) {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_INT);
-    } else if (strcmp(mtpscript_string_cstr(token->lexeme), "String") == 0) {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_STRING);
-    } else if (strcmp(mtpscript_string_cstr(token->lexeme), "Bool") == 0) {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_BOOL);
-    } else if (strcmp(mtpscript_string_cstr(token->lexeme), "Decimal") == 0) {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_DECIMAL);
-    } else if (strcmp(mtpscript_string_cstr(token->lexeme), "Option") == 0) {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_OPTION);
+
+    if (mtpscript_token_equals(token, "Int")) {
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_INT);
+    } else if (mtpscript_token_equals(token, "String")) {
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_STRING);
+    } else if (mtpscript_token_equals(token, "Bool")) {
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_BOOL);
+    } else if (mtpscript_token_equals(token, "Decimal")) {
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_DECIMAL);
+    } else if (mtpscript_token_equals(token, "Option")) {
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_OPTION);
         match_token(parser, MTPSCRIPT_TOKEN_LANGLE);
         type->inner = parse_type(parser);
         match_token(parser, MTPSCRIPT_TOKEN_RANGLE);
-    } else if (strcmp(mtpscript_string_cstr(token->lexeme), "Result") == 0) {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_RESULT);
+    } else if (mtpscript_token_equals(token, "Result")) {
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_RESULT);
         match_token(parser, MTPSCRIPT_TOKEN_LANGLE);
         type->inner = parse_type(parser);  // T (success type)
         match_token(parser, MTPSCRIPT_TOKEN_COMMA);
         type->error = parse_type(parser);  // E (error type)
         match_token(parser, MTPSCRIPT_TOKEN_RANGLE);
     } else {
-        type = mtpscript_type_new(MTPSCRIPT_TYPE_CUSTOM);
-        type->name = mtpscript_string_from_cstr(mtpscript_string_cstr(token->lexeme));
+        type = mtpscript_type_new(parser->arena, MTPSCRIPT_TYPE_CUSTOM);
+        type->name = mtpscript_token_string(parser->arena, token);
     }
     return type;
 }
 
+static mtpscript_expression_t *parse_expression(mtpscript_parser_t *parser);
+
+// Match arm pattern, kept as the code the scrutinee is compared with: an
+// Int, String or Bool literal, a name, or '_' which matches anything
+static mtpscript_string_t *parse_match_pattern(mtpscript_parser_t *parser) {
+    mtpscript_token_t *token = advance_token(parser);
+
+    if (token->type == MTPSCRIPT_TOKEN_STRING) {
+        mtpscript_string_t *pattern = mtpscript_arena_string_new(parser->arena, "\"", 1);
+        mtpscript_string_append(pattern, token->lexeme, token->length);
+        mtpscript_string_append_cstr(pattern, "\"");
+        return pattern;
+    }
+    return mtpscript_token_string(parser->arena, token);
+}
+
+// match scrutinee { [|] pattern -> expression [,] ... }
+static mtpscript_expression_t *parse_match_expression(mtpscript_parser_t *parser) {
+    mtpscript_expression_t *expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_MATCH_EXPR);
+    expr->data.match.scrutinee = parse_expression(parser);
+    expr->data.match.arms = mtpscript_arena_vector_new(parser->arena);
+    match_token(parser, MTPSCRIPT_TOKEN_LBRACE);
+    while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE) && !check_token(parser, MTPSCRIPT_TOKEN_EOF)) {
+        mtpscript_match_arm_t *arm = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_match_arm_t));
+        arm->pattern = parse_match_pattern(parser);
+        match_token(parser, MTPSCRIPT_TOKEN_ARROW);
+        arm->body = parse_expression(parser);
+        mtpscript_vector_push(expr->data.match.arms, arm);
+        match_token(parser, MTPSCRIPT_TOKEN_COMMA);
+    }
+    match_token(parser, MTPSCRIPT_TOKEN_RBRACE);
+    return expr;
+}
+
 static mtpscript_expression_t *parse_primary_expression(mtpscript_parser_t *parser) {
     mtpscript_token_t *token;
 
     // Check for await
     if (match_token(parser, MTPSCRIPT_TOKEN_AWAIT)) {
-        mtpscript_expression_t *await_expr = mtpscript_expression_new(MTPSCRIPT_EXPR_AWAIT_EXPR);
+        mtpscript_expression_t *await_expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_AWAIT_EXPR);
         await_expr->data.await.expression = parse_primary_expression(parser);
         return await_expr;
     }
+    if (match_token(parser, MTPSCRIPT_TOKEN_MATCH)) {
+        return parse_match_expression(parser);
+    }
+    if (match_token(parser, MTPSCRIPT_TOKEN_LPAREN)) {
+        mtpscript_expression_t *inner = parse_expression(parser);
+        match_token(parser, MTPSCRIPT_TOKEN_RPAREN);
+        return inner;
+    }
 
     token = advance_token(parser);
     mtpscript_expression_t *expr;
     if (token->type == MTPSCRIPT_TOKEN_INT) {
-        expr = mtpscript_expression_new(MTPSCRIPT_EXPR_INT_LITERAL);
-        expr->data.int_val = atoll(mtpscript_string_cstr(token->lexeme));
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_INT_LITERAL);
+        expr->data.int_val = atoll(token->lexeme); // Stops at the end of the digits
     } else if (token->type == MTPSCRIPT_TOKEN_DECIMAL) {
-        expr = mtpscript_expression_new(MTPSCRIPT_EXPR_DECIMAL_LITERAL);
-        expr->data.decimal_val = mtpscript_string_from_cstr(mtpscript_string_cstr(token->lexeme));
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_DECIMAL_LITERAL);
+        expr->data.decimal_val = mtpscript_token_string(parser->arena, token);
+    } else if (token->type == MTPSCRIPT_TOKEN_STRING) {
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_STRING_LITERAL);
+        expr->data.string_val = mtpscript_token_string(parser->arena, token);
     } else if (token->type == MTPSCRIPT_TOKEN_BOOL) {
-        expr = mtpscript_expression_new(MTPSCRIPT_EXPR_BOOL_LITERAL);
-        expr->data.bool_val = strcmp(mtpscript_string_cstr(token->lexeme), "true") == 0;
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_BOOL_LITERAL);
+        expr->data.bool_val = mtpscript_token_equals(token, "true");
+    } else if (token->type == MTPSCRIPT_TOKEN_IDENTIFIER && check_token(parser, MTPSCRIPT_TOKEN_LPAREN)) {
+        // Call: name(arguments)
+        advance_token(parser);
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_FUNCTION_CALL);
+        expr->data.call.function_name = mtpscript_token_string(parser->arena, token);
+        expr->data.call.arguments = mtpscript_arena_vector_new(parser->arena);
+        while (!check_token(parser, MTPSCRIPT_TOKEN_RPAREN) && !check_token(parser, MTPSCRIPT_TOKEN_EOF)) {
+            mtpscript_vector_push(expr->data.call.arguments, parse_expression(parser));
+            if (!match_token(parser, MTPSCRIPT_TOKEN_COMMA)) break;
+        }
+        match_token(parser, MTPSCRIPT_TOKEN_RPAREN);
     } else if (token->type == MTPSCRIPT_TOKEN_IDENTIFIER) {
-        expr = mtpscript_expression_new(MTPSCRIPT_EXPR_VARIABLE);
-        expr->data.variable.name = mtpscript_string_from_cstr(mtpscript_string_cstr(token->lexeme));
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_VARIABLE);
+        expr->data.variable.name = mtpscript_token_string(parser->arena, token);
     } else {
         // Fallback
-        expr = mtpscript_expression_new(MTPSCRIPT_EXPR_INT_LITERAL);
+        expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_INT_LITERAL);
     }
     return expr;
 }
 
-static mtpscript_expression_t *parse_expression(mtpscript_parser_t *parser) {
-    mtpscript_expression_t *expr = parse_primary_expression(parser);
-
-    // Handle binary operators
-    if (check_token(parser, MTPSCRIPT_TOKEN_STAR) ||
-        check_token(parser, MTPSCRIPT_TOKEN_PLUS) ||
-        check_token(parser, MTPSCRIPT_TOKEN_MINUS) ||
-        check_token(parser, MTPSCRIPT_TOKEN_SLASH)) {
-        mtpscript_token_t *op_token = advance_token(parser);
-        mtpscript_expression_t *binary_expr = mtpscript_expression_new(MTPSCRIPT_EXPR_BINARY_EXPR);
-        binary_expr->data.binary.left = expr;
-        binary_expr->data.binary.op = mtpscript_string_cstr(op_token->lexeme);
-        binary_expr->data.binary.right = parse_expression(parser);
-        expr = binary_expr;
+static int binary_op_precedence(mtpscript_token_type_t type) {
+    switch (type) {
+        case MTPSCRIPT_TOKEN_STAR:
+        case MTPSCRIPT_TOKEN_SLASH: return 2;
+        case MTPSCRIPT_TOKEN_PLUS:
+        case MTPSCRIPT_TOKEN_MINUS: return 1;
+        default: return 0;
     }
+}
+
+// Pipeline operators bind tighter than binary operators: a + b |> f is
+// a + f(b). Left-associative: a |> f |> g is g(f(a)).
+static mtpscript_expression_t *parse_pipe_expression(mtpscript_parser_t *parser) {
+    mtpscript_expression_t *expr = parse_primary_expression(parser);
 
-    // Handle pipeline operators (left-associative)
     while (match_token(parser, MTPSCRIPT_TOKEN_PIPE)) {
-        mtpscript_expression_t *pipe_expr = mtpscript_expression_new(MTPSCRIPT_EXPR_PIPE_EXPR);
+        mtpscript_expression_t *pipe_expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_PIPE_EXPR);
         pipe_expr->data.pipe.left = expr;
         pipe_expr->data.pipe.right = parse_primary_expression(parser);
         expr = pipe_expr;
     }
+    return expr;
+}
 
+// Binary operators by precedence climbing: left-associative, and '*'
+// and '/' bind tighter than '+' and '-'
+static mtpscript_expression_t *parse_binary_expression(mtpscript_parser_t *parser, int min_precedence) {
+    mtpscript_expression_t *expr = parse_pipe_expression(parser);
+
+    for (;;) {
+        int precedence = binary_op_precedence(peek_token(parser)->type);
+        if (precedence == 0 || precedence < min_precedence) break;
+        mtpscript_token_t *op_token = advance_token(parser);
+        mtpscript_expression_t *binary_expr = mtpscript_expression_new(parser->arena, MTPSCRIPT_EXPR_BINARY_EXPR);
+        binary_expr->data.binary.left = expr;
+        binary_expr->data.binary.op = binary_op_name(op_token->type);
+        binary_expr->data.binary.right = parse_binary_expression(parser, precedence + 1);
+        expr = binary_expr;
+    }
     return expr;
 }
 
+static mtpscript_expression_t *parse_expression(mtpscript_parser_t *parser) {
+    return parse_binary_expression(parser, 1);
+}
+
 static mtpscript_statement_t *parse_statement(mtpscript_parser_t *parser) {
     if (match_token(parser, MTPSCRIPT_TOKEN_RETURN)) {
-        mtpscript_statement_t *stmt = mtpscript_statement_new(MTPSCRIPT_STMT_RETURN_STMT);
+        mtpscript_statement_t *stmt = mtpscript_statement_new(parser->arena, MTPSCRIPT_STMT_RETURN_STMT);
         stmt->data.return_stmt.expression = parse_expression(parser);
         return stmt;
     } else if (match_token(parser, MTPSCRIPT_TOKEN_LET)) {
-        mtpscript_statement_t *stmt = mtpscript_statement_new(MTPSCRIPT_STMT_VAR_DECL);
+        mtpscript_statement_t *stmt = mtpscript_statement_new(parser->arena, MTPSCRIPT_STMT_VAR_DECL);
         mtpscript_token_t *name_token = advance_token(parser);
-        stmt->data.var_decl.name = mtpscript_string_from_cstr(mtpscript_string_cstr(name_token->lexeme));
+        stmt->data.var_decl.name = mtpscript_token_string(parser->arena, name_token);
         match_token(parser, MTPSCRIPT_TOKEN_EQUALS);
         stmt->data.var_decl.initializer = parse_expression(parser);
         return stmt;
     }
     // Fallback
-    mtpscript_statement_t *stmt = mtpscript_statement_new(MTPSCRIPT_STMT_EXPRESSION_STMT);
+    mtpscript_statement_t *stmt = mtpscript_statement_new(parser->arena, MTPSCRIPT_STMT_EXPRESSION_STMT);
     stmt->data.expression_stmt.expression = parse_expression(parser);
     return stmt;
 }
 
 static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
     if (match_token(parser, MTPSCRIPT_TOKEN_IMPORT)) {
-        mtpscript_declaration_t *decl = mtpscript_declaration_new(MTPSCRIPT_DECL_IMPORT);
+        mtpscript_declaration_t *decl = mtpscript_declaration_new(parser->arena, MTPSCRIPT_DECL_IMPORT);
 
         // Parse module name
         if (!check_token(parser, MTPSCRIPT_TOKEN_IDENTIFIER)) {
@@ -164,7 +249,7 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
             return NULL;
         }
         mtpscript_token_t *module_token = advance_token(parser);
-        decl->data.import.module_name = mtpscript_string_from_cstr(mtpscript_string_cstr(module_token->lexeme));
+        decl->data.import.module_name = mtpscript_token_string(parser->arena, module_token);
 
         // Parse 'from'
         if (!match_token(parser, MTPSCRIPT_TOKEN_FROM)) {
@@ -178,8 +263,8 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
             return NULL;
         }
         mtpscript_token_t *url_token = advance_token(parser);
-        const char *url_with_hash = mtpscript_string_cstr(url_token->lexeme);
-        const char *hash_pos = strrchr(url_with_hash, '#');
+        const char *url_with_hash = url_token->lexeme;
+        const char *hash_pos = memrchr(url_with_hash, '#', url_token->length);
         if (!hash_pos) {
             // Error: expected #hash in URL
             return NULL;
@@ -187,13 +272,9 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
 
         // Split URL and hash
         size_t url_len = hash_pos - url_with_hash;
-        char *url_only = MTPSCRIPT_MALLOC(url_len + 1);
-        memcpy(url_only, url_with_hash, url_len);
-        url_only[url_len] = '\0';
-
-        decl->data.import.git_url = mtpscript_string_from_cstr(url_only);
-        decl->data.import.git_hash = mtpscript_string_from_cstr(hash_pos + 1);
-        MTPSCRIPT_FREE(url_only);
+        decl->data.import.git_url = mtpscript_arena_string_new(parser->arena, url_with_hash, url_len);
+        decl->data.import.git_hash = mtpscript_arena_string_new(parser->arena, hash_pos + 1,
+                                                                url_token->length - url_len - 1);
 
         // Optional: parse 'as' tag
         decl->data.import.tag = NULL;
@@ -203,11 +284,11 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
                 // Error: expected tag string
                 return NULL;
             }
-            decl->data.import.tag = mtpscript_string_from_cstr(mtpscript_string_cstr(tag_token->lexeme));
+            decl->data.import.tag = mtpscript_token_string(parser->arena, tag_token);
         }
 
         // Parse import list
-        decl->data.import.imports = mtpscript_vector_new();
+        decl->data.import.imports = mtpscript_arena_vector_new(parser->arena);
         if (match_token(parser, MTPSCRIPT_TOKEN_LBRACE)) {
             while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE) && !check_token(parser, MTPSCRIPT_TOKEN_EOF)) {
                 if (!check_token(parser, MTPSCRIPT_TOKEN_IDENTIFIER)) {
@@ -216,7 +297,7 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
                 }
                 mtpscript_token_t *import_token = advance_token(parser);
                 mtpscript_vector_push(decl->data.import.imports,
-                                    mtpscript_string_from_cstr(mtpscript_string_cstr(import_token->lexeme)));
+                                    mtpscript_token_string(parser->arena, import_token));
                 if (!match_token(parser, MTPSCRIPT_TOKEN_COMMA)) break;
             }
             if (!match_token(parser, MTPSCRIPT_TOKEN_RBRACE)) {
@@ -227,15 +308,15 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
 
         return decl;
     } else if (match_token(parser, MTPSCRIPT_TOKEN_API)) {
-        mtpscript_declaration_t *decl = mtpscript_declaration_new(MTPSCRIPT_DECL_API);
+        mtpscript_declaration_t *decl = mtpscript_declaration_new(parser->arena, MTPSCRIPT_DECL_API);
 
         // Parse HTTP method - should be GET, POST, etc.
         mtpscript_token_t *method_token = advance_token(parser);
         if (method_token->type < MTPSCRIPT_TOKEN_GET || method_token->type > MTPSCRIPT_TOKEN_DELETE) {
             // For now, accept any identifier as method
-            decl->data.api.method = mtpscript_string_from_cstr(mtpscript_string_cstr(method_token->lexeme));
+            decl->data.api.method = mtpscript_token_string(parser->arena, method_token);
         } else {
-            decl->data.api.method = mtpscript_string_from_cstr(mtpscript_string_cstr(method_token->lexeme));
+            decl->data.api.method = mtpscript_token_string(parser->arena, method_token);
         }
 
         // Parse path (string literal)
@@ -244,7 +325,7 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
             // Error handling
             return NULL;
         }
-        decl->data.api.path = mtpscript_string_from_cstr(mtpscript_string_cstr(path_token->lexeme));
+        decl->data.api.path = mtpscript_token_string(parser->arena, path_token);
 
         // Parse the function that follows
         if (!match_token(parser, MTPSCRIPT_TOKEN_FUNC)) {
@@ -262,12 +343,12 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         if (!match_token(parser, MTPSCRIPT_TOKEN_LPAREN)) {
             return NULL;
         }
-        mtpscript_vector_t *params = mtpscript_vector_new();
+        mtpscript_vector_t *params = mtpscript_arena_vector_new(parser->arena);
         if (!match_token(parser, MTPSCRIPT_TOKEN_RPAREN)) {
             do {
-                mtpscript_param_t *param = MTPSCRIPT_MALLOC(sizeof(mtpscript_param_t));
+                mtpscript_param_t *param = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_param_t));
                 mtpscript_token_t *param_name = advance_token(parser);
-                param->name = mtpscript_string_from_cstr(mtpscript_string_cstr(param_name->lexeme));
+                param->name = mtpscript_token_string(parser->arena, param_name);
                 if (!match_token(parser, MTPSCRIPT_TOKEN_COLON)) {
                     return NULL;
                 }
@@ -286,13 +367,13 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         }
 
         // Parse effects (skip for now)
-        mtpscript_vector_t *effects = mtpscript_vector_new();
+        mtpscript_vector_t *effects = mtpscript_arena_vector_new(parser->arena);
 
         // Parse function body
         if (!match_token(parser, MTPSCRIPT_TOKEN_LBRACE)) {
             return NULL;
         }
-        mtpscript_vector_t *body = mtpscript_vector_new();
+        mtpscript_vector_t *body = mtpscript_arena_vector_new(parser->arena);
         while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE) && !check_token(parser, MTPSCRIPT_TOKEN_EOF)) {
             mtpscript_statement_t *stmt = parse_statement(parser);
             if (stmt) {
@@ -304,8 +385,8 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         }
 
         // Create function declaration
-        mtpscript_function_decl_t *func = MTPSCRIPT_MALLOC(sizeof(mtpscript_function_decl_t));
-        func->name = mtpscript_string_from_cstr(mtpscript_string_cstr(func_name->lexeme));
+        mtpscript_function_decl_t *func = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_function_decl_t));
+        func->name = mtpscript_token_string(parser->arena, func_name);
         func->params = params;
         func->return_type = return_type;
         func->body = body;
@@ -315,15 +396,15 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
 
         return decl;
     } else if (match_token(parser, MTPSCRIPT_TOKEN_FUNC)) {
-        mtpscript_declaration_t *decl = mtpscript_declaration_new(MTPSCRIPT_DECL_FUNCTION);
+        mtpscript_declaration_t *decl = mtpscript_declaration_new(parser->arena, MTPSCRIPT_DECL_FUNCTION);
         mtpscript_token_t *name = advance_token(parser);
-        decl->data.function.name = mtpscript_string_from_cstr(mtpscript_string_cstr(name->lexeme));
+        decl->data.function.name = mtpscript_token_string(parser->arena, name);
 
         match_token(parser, MTPSCRIPT_TOKEN_LPAREN);
-        decl->data.function.params = mtpscript_vector_new();
+        decl->data.function.params = mtpscript_arena_vector_new(parser->arena);
         while (!check_token(parser, MTPSCRIPT_TOKEN_RPAREN)) {
-            mtpscript_param_t *param = MTPSCRIPT_MALLOC(sizeof(mtpscript_param_t));
-            param->name = mtpscript_string_from_cstr(mtpscript_string_cstr(advance_token(parser)->lexeme));
+            mtpscript_param_t *param = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_param_t));
+            param->name = mtpscript_token_string(parser->arena, advance_token(parser));
             match_token(parser, MTPSCRIPT_TOKEN_COLON);
             param->type = parse_type(parser);
             mtpscript_vector_push(decl->data.function.params, param);
@@ -336,23 +417,23 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         }
 
         match_token(parser, MTPSCRIPT_TOKEN_LBRACE);
-        decl->data.function.body = mtpscript_vector_new();
+        decl->data.function.body = mtpscript_arena_vector_new(parser->arena);
         while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE)) {
             mtpscript_vector_push(decl->data.function.body, parse_statement(parser));
         }
         match_token(parser, MTPSCRIPT_TOKEN_RBRACE);
-        decl->data.function.effects = mtpscript_vector_new(); // Empty for now
+        decl->data.function.effects = mtpscript_arena_vector_new(parser->arena); // Empty for now
         return decl;
     } else if (match_token(parser, MTPSCRIPT_TOKEN_FUNC)) {
-        mtpscript_declaration_t *decl = mtpscript_declaration_new(MTPSCRIPT_DECL_FUNCTION);
+        mtpscript_declaration_t *decl = mtpscript_declaration_new(parser->arena, MTPSCRIPT_DECL_FUNCTION);
         mtpscript_token_t *name = advance_token(parser);
-        decl->data.function.name = mtpscript_string_from_cstr(mtpscript_string_cstr(name->lexeme));
+        decl->data.function.name = mtpscript_token_string(parser->arena, name);
 
         match_token(parser, MTPSCRIPT_TOKEN_LPAREN);
-        decl->data.function.params = mtpscript_vector_new();
+        decl->data.function.params = mtpscript_arena_vector_new(parser->arena);
         while (!check_token(parser, MTPSCRIPT_TOKEN_RPAREN)) {
-            mtpscript_param_t *param = MTPSCRIPT_MALLOC(sizeof(mtpscript_param_t));
-            param->name = mtpscript_string_from_cstr(mtpscript_string_cstr(advance_token(parser)->lexeme));
+            mtpscript_param_t *param = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_param_t));
+            param->name = mtpscript_token_string(parser->arena, advance_token(parser));
             match_token(parser, MTPSCRIPT_TOKEN_COLON);
             param->type = parse_type(parser);
             mtpscript_vector_push(decl->data.function.params, param);
@@ -365,14 +446,16 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         }
 
         match_token(parser, MTPSCRIPT_TOKEN_LBRACE);
-        decl->data.function.body = mtpscript_vector_new();
+        decl->data.function.body = mtpscript_arena_vector_new(parser->arena);
         while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE)) {
             mtpscript_vector_push(decl->data.function.body, parse_statement(parser));
         }
         match_token(parser, MTPSCRIPT_TOKEN_RBRACE);
         return decl;
     } else if (match_token(parser, MTPSCRIPT_TOKEN_SERVE)) {
-        mtpscript_declaration_t *decl = mtpscript_declaration_new(MTPSCRIPT_DECL_SERVE);
+        mtpscript_declaration_t *decl = mtpscript_declaration_new(parser->arena, MTPSCRIPT_DECL_SERVE);
+        mtpscript_token_t *serve_token = mtpscript_vector_get(parser->tokens, parser->position - 1);
+        decl->location = serve_token->location;
 
         // Parse serve { port: 8080, routes: [...] }
         if (!match_token(parser, MTPSCRIPT_TOKEN_LBRACE)) {
@@ -382,7 +465,7 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         // Parse configuration object
         int port = 8080; // default
         mtpscript_string_t *host = NULL;
-        mtpscript_vector_t *routes = mtpscript_vector_new();
+        mtpscript_vector_t *routes = mtpscript_arena_vector_new(parser->arena);
 
         while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE) && !check_token(parser, MTPSCRIPT_TOKEN_EOF)) {
             mtpscript_token_t *key = advance_token(parser);
@@ -390,21 +473,21 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
                 return NULL;
             }
 
-            if (strcmp(mtpscript_string_cstr(key->lexeme), "port") == 0) {
+            if (mtpscript_token_equals(key, "port")) {
                 // Parse port number
                 mtpscript_token_t *port_token = advance_token(parser);
                 if (port_token->type != MTPSCRIPT_TOKEN_INT) {
                     return NULL;
                 }
-                port = atoi(mtpscript_string_cstr(port_token->lexeme));
-            } else if (strcmp(mtpscript_string_cstr(key->lexeme), "host") == 0) {
+                port = atoi(port_token->lexeme);
+            } else if (mtpscript_token_equals(key, "host")) {
                 // Parse host string
                 mtpscript_token_t *host_token = advance_token(parser);
                 if (host_token->type != MTPSCRIPT_TOKEN_STRING) {
                     return NULL;
                 }
-                host = mtpscript_string_from_cstr(mtpscript_string_cstr(host_token->lexeme));
-            } else if (strcmp(mtpscript_string_cstr(key->lexeme), "routes") == 0) {
+                host = mtpscript_token_string(parser->arena, host_token);
+            } else if (mtpscript_token_equals(key, "routes")) {
                 // Parse routes array
                 if (!match_token(parser, MTPSCRIPT_TOKEN_LBRACKET)) {
                     return NULL;
@@ -416,7 +499,8 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
                         return NULL;
                     }
 
-                    mtpscript_api_decl_t *route = MTPSCRIPT_MALLOC(sizeof(mtpscript_api_decl_t));
+                    mtpscript_api_decl_t *route = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_api_decl_t));
+                    memset(route, 0, sizeof(*route));
 
                     while (!check_token(parser, MTPSCRIPT_TOKEN_RBRACE) && !check_token(parser, MTPSCRIPT_TOKEN_EOF)) {
                         mtpscript_token_t *route_key = advance_token(parser);
@@ -424,18 +508,19 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
                             return NULL;
                         }
 
-                        if (strcmp(mtpscript_string_cstr(route_key->lexeme), "method") == 0) {
+                        if (mtpscript_token_equals(route_key, "method")) {
                             mtpscript_token_t *method_token = advance_token(parser);
-                            route->method = mtpscript_string_from_cstr(mtpscript_string_cstr(method_token->lexeme));
-                        } else if (strcmp(mtpscript_string_cstr(route_key->lexeme), "path") == 0) {
+                            route->method = mtpscript_token_string(parser->arena, method_token);
+                        } else if (mtpscript_token_equals(route_key, "path")) {
                             mtpscript_token_t *path_token = advance_token(parser);
-                            route->path = mtpscript_string_from_cstr(mtpscript_string_cstr(path_token->lexeme));
-                        } else if (strcmp(mtpscript_string_cstr(route_key->lexeme), "handler") == 0) {
-                            // Parse handler function reference
+                            route->path = mtpscript_token_string(parser->arena, path_token);
+                        } else if (mtpscript_token_equals(route_key, "handler")) {
+                            // Only the name is known here: parser_resolve_routes()
+                            // replaces it with the function declaration
                             mtpscript_token_t *handler_token = advance_token(parser);
-                            // For now, just store the handler name - full parsing would require symbol resolution
-                            route->handler = MTPSCRIPT_MALLOC(sizeof(mtpscript_function_decl_t));
-                            route->handler->name = mtpscript_string_from_cstr(mtpscript_string_cstr(handler_token->lexeme));
+                            route->handler = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_function_decl_t));
+                            memset(route->handler, 0, sizeof(*route->handler));
+                            route->handler->name = mtpscript_token_string(parser->arena, handler_token);
                         }
 
                         if (!match_token(parser, MTPSCRIPT_TOKEN_COMMA)) break;
@@ -462,9 +547,9 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
         }
 
         // Create serve declaration
-        mtpscript_serve_decl_t *serve = MTPSCRIPT_MALLOC(sizeof(mtpscript_serve_decl_t));
+        mtpscript_serve_decl_t *serve = mtpscript_arena_alloc(parser->arena, sizeof(mtpscript_serve_decl_t));
         serve->port = port;
-        serve->host = host ? host : mtpscript_string_from_cstr("localhost");
+        serve->host = host ? host : mtpscript_arena_string_new(parser->arena, "localhost", 9);
         serve->routes = routes;
 
         decl->data.serve = *serve;
@@ -474,8 +559,49 @@ static mtpscript_declaration_t *parse_declaration(mtpscript_parser_t *parser) {
     return NULL;
 }
 
+static mtpscript_error_t *parser_route_error(mtpscript_declaration_t *serve, const char *message,
+                                             mtpscript_api_decl_t *route) {
+    mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
+    char msg[256];
+
+    snprintf(msg, sizeof(msg), "%s: %s %s", message,
+             route->method ? mtpscript_string_cstr(route->method) : "?",
+             route->path ? mtpscript_string_cstr(route->path) : "?");
+    error->message = mtpscript_string_from_cstr(msg);
+    error->location = serve->location;
+    return error;
+}
+
+// The handler of a serve route names a function of the program: the
+// server calls it with the parameters of that declaration
+static mtpscript_error_t *parser_resolve_routes(mtpscript_program_t *program) {
+    for (size_t i = 0; i < program->declarations->size; i++) {
+        mtpscript_declaration_t *serve = mtpscript_vector_get(program->declarations, i);
+        if (serve->kind != MTPSCRIPT_DECL_SERVE) continue;
+
+        for (size_t j = 0; j < serve->data.serve.routes->size; j++) {
+            mtpscript_api_decl_t *route = mtpscript_vector_get(serve->data.serve.routes, j);
+            mtpscript_function_decl_t *func = NULL;
+
+            if (!route->method || !route->path || !route->handler)
+                return parser_route_error(serve, "Route needs a method, a path and a handler", route);
+            for (size_t k = 0; k < program->declarations->size && !func; k++) {
+                mtpscript_declaration_t *decl = mtpscript_vector_get(program->declarations, k);
+                if (decl->kind == MTPSCRIPT_DECL_FUNCTION &&
+                    strcmp(mtpscript_string_cstr(decl->data.function.name),
+                           mtpscript_string_cstr(route->handler->name)) == 0) {
+                    func = &decl->data.function;
+                }
+            }
+            if (!func) return parser_route_error(serve, "Unknown route handler", route);
+            route->handler = func;
+        }
+    }
+    return NULL;
+}
+
 mtpscript_error_t *mtpscript_parser_parse(mtpscript_parser_t *parser, mtpscript_program_t **program_out) {
-    mtpscript_program_t *program = mtpscript_program_new();
+    mtpscript_program_t *program = mtpscript_program_new(parser->arena);
     *program_out = program;
 
     while (peek_token(parser)->type != MTPSCRIPT_TOKEN_EOF) {
@@ -486,5 +612,5 @@ mtpscript_error_t *mtpscript_parser_parse(mtpscript_parser_t *parser, mtpscript_
             advance_token(parser);
         }
     }
-    return NULL;
+    return parser_resolve_routes(program);
 }
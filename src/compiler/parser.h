@@ -15,9 +15,10 @@
 typedef struct {
     mtpscript_vector_t *tokens;
     size_t position;
+    mtpscript_arena_t *arena;    // The AST is allocated here
 } mtpscript_parser_t;
 
-mtpscript_parser_t *mtpscript_parser_new(mtpscript_vector_t *tokens);
+mtpscript_parser_t *mtpscript_parser_new(mtpscript_arena_t *arena, mtpscript_vector_t *tokens);
 void mtpscript_parser_free(mtpscript_parser_t *parser);
 mtpscript_error_t *mtpscript_parser_parse(mtpscript_parser_t *parser, mtpscript_program_t **program);
 
@@ -49,11 +49,12 @@ static mtpscript_error_t *check_union_exhaustiveness(mtpscript_type_t *union_typ
     return NULL;
 }
 
-mtpscript_type_env_t *mtpscript_type_env_new(void) {
+mtpscript_type_env_t *mtpscript_type_env_new(mtpscript_arena_t *arena) {
     mtpscript_type_env_t *env = MTPSCRIPT_MALLOC(sizeof(mtpscript_type_env_t));
     env->env = mtpscript_hash_new();
     env->declared = mtpscript_hash_new();
-    env->used_effects = mtpscript_vector_new();
+    env->used_effects = mtpscript_arena_vector_new(arena);
+    env->arena = arena;
     return env;
 }
 
@@ -69,16 +70,16 @@ void mtpscript_type_env_free(mtpscript_type_env_t *env) {
 static mtpscript_error_t *typecheck_expression(mtpscript_expression_t *expr, mtpscript_type_env_t *env, mtpscript_type_t **type_out) {
     switch (expr->kind) {
         case MTPSCRIPT_EXPR_INT_LITERAL:
-            *type_out = mtpscript_type_new(MTPSCRIPT_TYPE_INT);
+            *type_out = mtpscript_type_new(env->arena, MTPSCRIPT_TYPE_INT);
             break;
         case MTPSCRIPT_EXPR_STRING_LITERAL:
-            *type_out = mtpscript_type_new(MTPSCRIPT_TYPE_STRING);
+            *type_out = mtpscript_type_new(env->arena, MTPSCRIPT_TYPE_STRING);
             break;
         case MTPSCRIPT_EXPR_BOOL_LITERAL:
-            *type_out = mtpscript_type_new(MTPSCRIPT_TYPE_BOOL);
+            *type_out = mtpscript_type_new(env->arena, MTPSCRIPT_TYPE_BOOL);
             break;
         case MTPSCRIPT_EXPR_DECIMAL_LITERAL:
-            *type_out = mtpscript_type_new(MTPSCRIPT_TYPE_DECIMAL);
+            *type_out = mtpscript_type_new(env->arena, MTPSCRIPT_TYPE_DECIMAL);
             break;
         case MTPSCRIPT_EXPR_VARIABLE: {
             mtpscript_type_t *type = mtpscript_hash_get(env->env, mtpscript_string_cstr(expr->data.variable.name));
@@ -105,7 +106,7 @@ static mtpscript_error_t *typecheck_expression(mtpscript_expression_t *expr, mtp
             }
 
             // TODO: Add proper function call type checking
-            *type_out = mtpscript_type_new(MTPSCRIPT_TYPE_INT); // Placeholder
+            *type_out = mtpscript_type_new(env->arena, MTPSCRIPT_TYPE_INT); // Placeholder
             break;
         }
         case MTPSCRIPT_EXPR_AWAIT_EXPR: {
@@ -145,7 +146,7 @@ static mtpscript_error_t *typecheck_expression(mtpscript_expression_t *expr, mtp
             }
 
             if (!arm_type) {
-                *type_out = mtpscript_type_new(MTPSCRIPT_TYPE_INT); // Default if no arms
+                *type_out = mtpscript_type_new(env->arena, MTPSCRIPT_TYPE_INT); // Default if no arms
             } else {
                 *type_out = arm_type;
             }
@@ -166,7 +167,7 @@ static void record_effect_usage(mtpscript_type_env_t *env, const char *effect) {
         }
     }
     // Add new effect
-    mtpscript_vector_push(env->used_effects, mtpscript_string_from_cstr(effect));
+    mtpscript_vector_push(env->used_effects, mtpscript_arena_string_new(env->arena, effect, strlen(effect)));
 }
 
 /* Validate type recursively - ensure Map key constraints (§5) */
@@ -306,7 +307,7 @@ static mtpscript_error_t *typecheck_declaration(mtpscript_declaration_t *decl, m
         // For now, just validate the import syntax
         return NULL;
     } else if (decl->kind == MTPSCRIPT_DECL_FUNCTION) {
-        mtpscript_type_env_t *local_env = mtpscript_type_env_new();
+        mtpscript_type_env_t *local_env = mtpscript_type_env_new(env->arena);
         // Add params to local env (mark as declared for immutability)
         for (size_t i = 0; i < decl->data.function.params->size; i++) {
             mtpscript_param_t *param = mtpscript_vector_get(decl->data.function.params, i);
@@ -333,7 +334,7 @@ static mtpscript_error_t *typecheck_declaration(mtpscript_declaration_t *decl, m
 }
 
 mtpscript_error_t *mtpscript_typecheck_program(mtpscript_program_t *program) {
-    mtpscript_type_env_t *env = mtpscript_type_env_new();
+    mtpscript_type_env_t *env = mtpscript_type_env_new(program->arena);
 
     // First pass: validate all types in the program for Map constraints
     for (size_t i = 0; i < program->declarations->size; i++) {
@@ -15,9 +15,10 @@ typedef struct {
     mtpscript_hash_t *env;        // Variable name -> type mapping
     mtpscript_hash_t *declared;   // Variable name -> bool (immutability tracking)
     mtpscript_vector_t *used_effects; // Effects used in this scope
+    mtpscript_arena_t *arena;     // Inferred types are allocated here
 } mtpscript_type_env_t;
 
-mtpscript_type_env_t *mtpscript_type_env_new(void);
+mtpscript_type_env_t *mtpscript_type_env_new(mtpscript_arena_t *arena);
 void mtpscript_type_env_free(mtpscript_type_env_t *env);
 mtpscript_error_t *mtpscript_typecheck_program(mtpscript_program_t *program);
 
@@ -0,0 +1,1011 @@
+/**
+ * MTPScript HTTP Host Adapter Implementation
+ * Specification §5.2, §8.0
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ */
+
+#include "http_server.h"
+#include "../stdlib/runtime.h"
+#include "mquickjs.h"
+#include "mquickjs_api.h"
+#include "mquickjs_vmpool.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE 0
+#endif
+
+#define HTTP_MAX_EVENTS   64
+#define HTTP_READ_CHUNK   16384
+
+// Host functions referenced by the standard library table. Output goes
+// to stderr; the clock and timers only exist in non-deterministic builds
+// and are not available to a request.
+static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    for (int i = 0; i < argc; i++) {
+        if (i != 0) fputc(' ', stderr);
+        if (JS_IsString(ctx, argv[i])) {
+            JSCStringBuf buf;
+            size_t len;
+            const char *str = JS_ToCStringLen(ctx, &len, argv[i], &buf);
+            fwrite(str, 1, len, stderr);
+        } else {
+            JS_PrintValueF(ctx, argv[i], JS_DUMP_LONG);
+        }
+    }
+    fputc('\n', stderr);
+    return JS_UNDEFINED;
+}
+
+static JSValue js_gc(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    JS_GC(ctx);
+    return JS_UNDEFINED;
+}
+
+#if !MTPSCRIPT_DETERMINISTIC
+static JSValue js_unavailable(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_ThrowTypeError(ctx, "not available in a request");
+}
+
+#define js_date_now js_unavailable
+#define js_performance_now js_unavailable
+#define js_load js_unavailable
+#define js_setTimeout js_unavailable
+#define js_clearTimeout js_unavailable
+#endif
+
+#include "mtpjs_stdlib.h"
+
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+} http_buf_t;
+
+typedef struct http_conn_t {
+    struct http_conn_t *prev, *next;
+    int fd;
+    http_buf_t in;
+    http_buf_t out;
+    size_t out_pos;
+    bool closing;               // Close once 'out' is flushed
+} http_conn_t;
+
+// A parsed request; all the pointers are into the connection buffer
+typedef struct {
+    char *method;
+    char *path;
+    char *query;                // NULL if none
+    const char *body;
+    size_t body_len;
+    bool keep_alive;
+} http_request_t;
+
+typedef struct {
+    mtpscript_http_server_t *server;
+    pthread_t thread;
+    bool running;
+    int epoll_fd;
+    MTPScriptVMPool *pool;
+    http_conn_t *conns;              // Open connections
+    mtpscript_http_route_stats_t *route_stats; // Indexed like the route registry
+} http_worker_t;
+
+struct mtpscript_http_server_t {
+    mtpscript_http_server_config_t config;
+    mtpscript_api_decl_t **apis;     // Indexed like the route registry
+    int api_count;
+    MTPScriptRouteRegistry *routes;  // Shared: matching does not modify it
+    int listen_fd;
+    int wake_fd;
+    uint8_t *template_mem;
+    JSContext *template_ctx;
+    http_worker_t *workers;
+    int worker_count;
+};
+
+// epoll tags for the non connection descriptors
+static char http_listen_tag;
+static char http_wake_tag;
+
+static mtpscript_error_t *http_error(const char *message) {
+    mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
+    error->message = mtpscript_string_from_cstr(message);
+    error->location = (mtpscript_location_t){0, 0, "http_server"};
+    return error;
+}
+
+static void http_log_func(void *opaque, const void *buf, size_t buf_len) {
+    fwrite(buf, 1, buf_len, stderr);
+}
+
+static int http_buf_append(http_buf_t *b, const void *data, size_t len) {
+    if (b->len + len > b->cap) {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->len + len) cap *= 2;
+        char *new_data = realloc(b->data, cap);
+        if (!new_data) return -1;
+        b->data = new_data;
+        b->cap = cap;
+    }
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+    return 0;
+}
+
+static const char *http_status_text(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+// Error type of the JSON body of a status sent by the server itself
+static const char *http_status_error_type(int status) {
+    switch (status) {
+        case 400: return "BadRequest";
+        case 404: return "NotFound";
+        case 413: return "PayloadTooLarge";
+        case 431: return "RequestHeaderFieldsTooLarge";
+        case 501: return "NotImplemented";
+        case 503: return "ServiceUnavailable";
+        default: return "InternalError";
+    }
+}
+
+// 'body_hash' is the SHA-256 of the canonical JSON body, or NULL
+static int http_format_header(char *header, size_t size, int status, size_t body_len,
+                              const uint8_t *body_hash, bool keep_alive) {
+    char hash_field[128] = "";
+
+    if (body_hash) {
+        int n = snprintf(hash_field, sizeof(hash_field), "X-MTPScript-Response-Hash: ");
+        for (int i = 0; i < 32; i++) {
+            n += snprintf(hash_field + n, sizeof(hash_field) - n, "%02x", body_hash[i]);
+        }
+        snprintf(hash_field + n, sizeof(hash_field) - n, "\r\n");
+    }
+    return snprintf(header, size,
+                    "HTTP/1.1 %d %s\r\n"
+                    "Content-Type: application/json\r\n"
+                    "Content-Length: %zu\r\n"
+                    "%s"
+                    "Connection: %s\r\n"
+                    "\r\n",
+                    status, http_status_text(status), body_len, hash_field,
+                    keep_alive ? "keep-alive" : "close");
+}
+
+static void http_respond(http_conn_t *c, int status, const char *body, size_t body_len, bool keep_alive) {
+    char header[256];
+    int n = http_format_header(header, sizeof(header), status, body_len, NULL, keep_alive);
+    if (http_buf_append(&c->out, header, n) < 0 ||
+        http_buf_append(&c->out, body, body_len) < 0) {
+        keep_alive = false;
+    }
+    if (!keep_alive) c->closing = true;
+}
+
+static int http_json_write(void *opaque, const uint8_t *buf, size_t len) {
+    return http_buf_append(opaque, buf, len);
+}
+
+// Serialize 'val' straight into the output buffer and hash it in the same
+// pass, then insert the header in front of it once the length and the
+// digest are known. Return -1 with the output unchanged if 'val' cannot
+// be serialized.
+static int http_respond_json(http_conn_t *c, JSContext *ctx, int status, JSValue val, bool keep_alive) {
+    size_t start = c->out.len, body_len;
+    uint8_t body_hash[32];
+    char header[384];
+    int n;
+
+    if (JS_JSONWrite(ctx, val, http_json_write, &c->out, body_hash) < 0) {
+        c->out.len = start;
+        return -1;
+    }
+    body_len = c->out.len - start;
+    n = http_format_header(header, sizeof(header), status, body_len, body_hash, keep_alive);
+    if (http_buf_append(&c->out, header, n) < 0) {
+        c->out.len = start;
+        c->closing = true;
+        return 0;
+    }
+    memmove(c->out.data + start + n, c->out.data + start, body_len);
+    memcpy(c->out.data + start, header, n);
+    if (!keep_alive) c->closing = true;
+    return 0;
+}
+
+static void http_respond_error(http_conn_t *c, int status, const char *type, const char *message, bool keep_alive) {
+    mtpscript_error_response_t *error = mtpscript_error_response_new(type, message);
+    mtpscript_string_t *json = mtpscript_error_response_to_json(error);
+    http_respond(c, status, json->data, json->length, keep_alive);
+    mtpscript_string_free(json);
+    mtpscript_error_response_free(error);
+}
+
+static bool http_header_is(const char *name, size_t name_len, const char *expected) {
+    return strlen(expected) == name_len && strncasecmp(name, expected, name_len) == 0;
+}
+
+static bool http_value_has(const char *value, size_t value_len, const char *token) {
+    size_t token_len = strlen(token);
+    for (size_t i = 0; i + token_len <= value_len; i++) {
+        if (strncasecmp(value + i, token, token_len) == 0) return true;
+    }
+    return false;
+}
+
+// Parse one request at the start of 'buf'. Return its size once it is
+// complete, 0 if more bytes are needed, -1 with '*status' set if it is
+// malformed. The buffer is only modified for a complete request.
+static ssize_t http_parse_request(char *buf, size_t len, size_t max_body,
+                                  http_request_t *req, int *status) {
+    char *end = memmem(buf, len, "\r\n\r\n", 4);
+    if (!end) {
+        if (len > MTPSCRIPT_HTTP_MAX_HEADER_SIZE) {
+            *status = 431;
+            return -1;
+        }
+        return 0;
+    }
+    size_t header_len = end + 4 - buf;
+    *status = 400;
+
+    // Request line: METHOD SP target SP HTTP/1.x
+    char *line_end = memchr(buf, '\r', header_len);
+    char *sp1 = memchr(buf, ' ', line_end - buf);
+    if (!sp1 || sp1 == buf) return -1;
+    char *target = sp1 + 1;
+    char *sp2 = memchr(target, ' ', line_end - target);
+    if (!sp2 || *target != '/') return -1;
+    char *version = sp2 + 1;
+    if (line_end - version != 8 || memcmp(version, "HTTP/1.", 7) != 0) return -1;
+    bool keep_alive = version[7] == '1';
+
+    // Headers
+    size_t content_length = 0;
+    bool has_length = false;
+    char *p = line_end + 2;
+    while (p < end + 2) {
+        char *eol = memchr(p, '\r', end + 2 - p);
+        char *colon = memchr(p, ':', eol - p);
+        if (!colon) return -1;
+        const char *name = p;
+        size_t name_len = colon - p;
+        const char *value = colon + 1;
+        while (value < eol && (*value == ' ' || *value == '\t')) value++;
+        size_t value_len = eol - value;
+
+        if (http_header_is(name, name_len, "Content-Length")) {
+            // A proxy in front of the server could pick another one of
+            // several lengths (request smuggling)
+            if (has_length) return -1;
+            has_length = true;
+            size_t i = 0;
+            for (; i < value_len && value[i] >= '0' && value[i] <= '9'; i++) {
+                content_length = content_length * 10 + (value[i] - '0');
+                if (content_length > max_body) {
+                    *status = 413;
+                    return -1;
+                }
+            }
+            if (i == 0) return -1;
+            while (i < value_len && (value[i] == ' ' || value[i] == '\t')) i++;
+            if (i != value_len) return -1;
+        } else if (http_header_is(name, name_len, "Transfer-Encoding")) {
+            *status = 501;
+            return -1;
+        } else if (http_header_is(name, name_len, "Connection")) {
+            if (http_value_has(value, value_len, "close")) keep_alive = false;
+            else if (http_value_has(value, value_len, "keep-alive")) keep_alive = true;
+        }
+        p = eol + 2;
+    }
+
+    if (len - header_len < content_length) return 0;
+
+    *sp1 = '\0';
+    *sp2 = '\0';
+    req->method = buf;
+    req->path = target;
+    req->query = strchr(target, '?');
+    if (req->query) *req->query++ = '\0';
+    req->body = buf + header_len;
+    req->body_len = content_length;
+    req->keep_alive = keep_alive;
+    return header_len + content_length;
+}
+
+static int http_hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Find 'name' in the query string and percent-decode its value into 'out'
+// (at least as large as the query). Return the decoded length or -1.
+static ssize_t http_query_get(const char *query, const char *name, char *out) {
+    size_t name_len = strlen(name);
+    const char *p = query;
+
+    while (p && *p) {
+        const char *end = strchr(p, '&');
+        if (!end) end = p + strlen(p);
+        const char *eq = memchr(p, '=', end - p);
+        if (eq && (size_t)(eq - p) == name_len && memcmp(p, name, name_len) == 0) {
+            size_t len = 0;
+            for (const char *s = eq + 1; s < end; s++) {
+                int hi, lo;
+                if (*s == '+') {
+                    out[len++] = ' ';
+                } else if (*s == '%' && end - s > 2 &&
+                           (hi = http_hex_value(s[1])) >= 0 && (lo = http_hex_value(s[2])) >= 0) {
+                    out[len++] = (char)(hi * 16 + lo);
+                    s += 2;
+                } else {
+                    out[len++] = *s;
+                }
+            }
+            return len;
+        }
+        p = *end ? end + 1 : end;
+    }
+    return -1;
+}
+
+// Value of handler parameter 'name': path parameter, then query parameter,
+// then field of the JSON body. A handler with a single parameter that is
+// not found by name receives the whole body.
+static JSValue http_handler_arg(JSContext *ctx, const char *name, int param_count,
+                                const MTPScriptRouteMatch *match, http_request_t *req, JSValue *pbody) {
+    for (int i = 0; i < match->param_count; i++) {
+        const MTPScriptPathParam *p = &match->params[i];
+        if (strcmp(p->name, name) == 0) {
+            return JS_NewStringLen(ctx, p->value, p->value_len);
+        }
+    }
+
+    if (req->query) {
+        char *value = malloc(strlen(req->query) + 1);
+        ssize_t len = value ? http_query_get(req->query, name, value) : -1;
+        if (len >= 0) {
+            JSValue val = JS_NewStringLen(ctx, value, len);
+            free(value);
+            return val;
+        }
+        free(value);
+    }
+
+    if (JS_GetClassID(ctx, *pbody) == JS_CLASS_OBJECT) {
+        JSValue val = JS_GetPropertyStr(ctx, *pbody, name);
+        if (!JS_IsUndefined(val) || param_count != 1) return val;
+    }
+    return param_count == 1 ? *pbody : JS_UNDEFINED;
+}
+
+// Turn a thrown value into the {"error", "message"} response object.
+// Typed runtime errors (e.g. GasExhausted) already have that shape.
+static JSValue http_error_value(JSContext *ctx, JSValue *pexc) {
+    JSGCRef obj_ref;
+    JSValue *pobj, val;
+
+    if (!JS_IsError(ctx, *pexc) && JS_GetClassID(ctx, *pexc) == JS_CLASS_OBJECT) {
+        return *pexc;
+    }
+
+    pobj = JS_PushGCRef(ctx, &obj_ref);
+    *pobj = JS_NewObject(ctx);
+    if (JS_IsError(ctx, *pexc)) {
+        val = JS_GetPropertyStr(ctx, *pexc, "name");
+        JS_SetPropertyStr(ctx, *pobj, "error", val);
+        val = JS_GetPropertyStr(ctx, *pexc, "message");
+        JS_SetPropertyStr(ctx, *pobj, "message", val);
+    } else {
+        val = JS_NewString(ctx, "Error");
+        JS_SetPropertyStr(ctx, *pobj, "error", val);
+        JS_SetPropertyStr(ctx, *pobj, "message", *pexc);
+    }
+    return JS_PopGCRef(ctx, &obj_ref);
+}
+
+// Run the route handler on 'ctx' and write its JSON result
+static void http_run_handler(http_conn_t *c, JSContext *ctx, mtpscript_api_decl_t *api,
+                             const MTPScriptRouteMatch *match, http_request_t *req) {
+    mtpscript_function_decl_t *handler = api->handler;
+    int argc = (int)handler->params->size, status = 200;
+    JSGCRef body_ref, args_ref, func_ref, result_ref;
+    JSValue *pbody, *pargs, *pfunc, *presult, val;
+
+    pbody = JS_PushGCRef(ctx, &body_ref);
+    pargs = JS_PushGCRef(ctx, &args_ref);
+    pfunc = JS_PushGCRef(ctx, &func_ref);
+    presult = JS_PushGCRef(ctx, &result_ref);
+    *pbody = JS_UNDEFINED;
+    *pargs = JS_UNDEFINED;
+    *pfunc = JS_UNDEFINED;
+    *presult = JS_UNDEFINED;
+
+    if (req->body_len > 0) {
+        val = JS_Parse(ctx, req->body, req->body_len, "<body>", JS_EVAL_JSON);
+        if (JS_IsException(val)) {
+            JS_GetException(ctx);
+            http_respond_error(c, 400, "BadRequest", "Request body is not valid JSON", req->keep_alive);
+            goto done;
+        }
+        *pbody = val;
+    }
+
+    val = JS_GetGlobalObject(ctx);
+    val = JS_GetPropertyStr(ctx, val, mtpscript_string_cstr(handler->name));
+    if (!JS_IsFunction(ctx, val)) {
+        http_respond_error(c, 500, "HandlerNotFound", mtpscript_string_cstr(handler->name), req->keep_alive);
+        goto done;
+    }
+    *pfunc = val;
+
+    // Collect the arguments first: allocating between JS_PushArg calls
+    // could move them
+    *pargs = JS_NewArray(ctx, argc);
+    if (JS_IsException(*pargs)) goto exception;
+    for (int i = 0; i < argc; i++) {
+        mtpscript_param_t *param = mtpscript_vector_get(handler->params, i);
+        val = http_handler_arg(ctx, mtpscript_string_cstr(param->name), argc, match, req, pbody);
+        if (JS_IsException(val)) goto exception;
+        JS_SetPropertyUint32(ctx, *pargs, i, val);
+    }
+
+    if (JS_StackCheck(ctx, argc + 2)) goto exception;
+    for (int i = argc - 1; i >= 0; i--) {
+        JS_PushArg(ctx, JS_GetPropertyUint32(ctx, *pargs, i));
+    }
+    JS_PushArg(ctx, *pfunc);
+    JS_PushArg(ctx, JS_NULL); /* this */
+    val = JS_Call(ctx, argc);
+    if (JS_IsException(val)) goto exception;
+    *presult = val;
+    goto output;
+
+exception:
+    status = 500;
+    *presult = JS_GetException(ctx);
+    *presult = http_error_value(ctx, presult);
+
+output:
+    if (http_respond_json(c, ctx, status, *presult, req->keep_alive) < 0) {
+        JS_GetException(ctx);
+        http_respond_error(c, 500, "InternalError", "Handler result is not serializable", req->keep_alive);
+    }
+
+done:
+    JS_PopGCRef(ctx, &result_ref);
+    JS_PopGCRef(ctx, &func_ref);
+    JS_PopGCRef(ctx, &args_ref);
+    JS_PopGCRef(ctx, &body_ref);
+}
+
+// Worker local, so no locking on the request path. The counters are
+// written with relaxed atomics: mtpscript_http_server_get_route_stats()
+// reads them from another thread while the server runs.
+static void http_stat_add(uint64_t *counter, uint64_t n) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+}
+
+static void http_stat_max(uint64_t *peak, uint64_t n) {
+    if (n > __atomic_load_n(peak, __ATOMIC_RELAXED)) __atomic_store_n(peak, n, __ATOMIC_RELAXED);
+}
+
+static void http_stat_max_size(size_t *peak, size_t n) {
+    if (n > __atomic_load_n(peak, __ATOMIC_RELAXED)) __atomic_store_n(peak, n, __ATOMIC_RELAXED);
+}
+
+static void http_record_usage(mtpscript_http_route_stats_t *stats, JSContext *ctx) {
+    JSMemoryUsage usage;
+
+    JS_GetMemoryUsage(ctx, &usage);
+    http_stat_add(&stats->requests, 1);
+    http_stat_add(&stats->gc_count, usage.gc_count);
+    http_stat_max(&stats->gas_peak, JS_GetGasUsed(ctx));
+    http_stat_max_size(&stats->heap_peak, usage.heap_peak);
+    http_stat_max_size(&stats->arena_peak, usage.arena_peak);
+}
+
+static void http_handle_request(http_worker_t *w, http_conn_t *c, http_request_t *req) {
+    MTPScriptHTTPMethod method = mtpscript_http_method_from_string(req->method);
+    MTPScriptRoute *route = NULL;
+    MTPScriptRouteMatch match;
+
+    // mtpscript_http_method_from_string() maps unknown methods to GET
+    if (strcmp(mtpscript_http_method_to_string(method), req->method) == 0) {
+        route = mtpscript_route_match(w->server->routes, method, req->path, &match);
+    }
+    if (!route) {
+        http_respond_error(c, 404, "NotFound", "No route matches the request", req->keep_alive);
+        return;
+    }
+
+    JSContext *ctx = mtpscript_vm_pool_acquire(w->pool);
+    if (!ctx) {
+        http_respond_error(c, 503, "ServiceUnavailable", "No VM available", req->keep_alive);
+        return;
+    }
+    int index = route - w->server->routes->routes;
+    http_run_handler(c, ctx, w->server->apis[index], &match, req);
+    http_record_usage(&w->route_stats[index], ctx);
+    mtpscript_vm_pool_release(w->pool, ctx);
+}
+
+static void http_conn_close(http_worker_t *w, http_conn_t *c) {
+    epoll_ctl(w->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    if (c->prev) c->prev->next = c->next;
+    else w->conns = c->next;
+    if (c->next) c->next->prev = c->prev;
+    free(c->in.data);
+    free(c->out.data);
+    free(c);
+}
+
+// Write what the socket takes. Return -1 if the connection must be closed.
+static int http_conn_flush(http_conn_t *c) {
+    while (c->out_pos < c->out.len) {
+        ssize_t n = send(c->fd, c->out.data + c->out_pos, c->out.len - c->out_pos, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0; // Resumed on EPOLLOUT
+            return -1;
+        }
+        c->out_pos += n;
+    }
+    c->out.len = 0;
+    c->out_pos = 0;
+    return c->closing ? -1 : 0;
+}
+
+// Run every complete request in the input buffer (pipelining allowed)
+static void http_conn_process(http_worker_t *w, http_conn_t *c) {
+    size_t pos = 0;
+
+    while (!c->closing && pos < c->in.len) {
+        http_request_t req;
+        int status;
+        ssize_t n = http_parse_request(c->in.data + pos, c->in.len - pos,
+                                       w->server->config.max_body_size, &req, &status);
+        if (n == 0) break;
+        if (n < 0) {
+            http_respond_error(c, status, http_status_error_type(status), http_status_text(status), false);
+            break;
+        }
+        http_handle_request(w, c, &req);
+        pos += n;
+    }
+
+    if (pos > 0) {
+        memmove(c->in.data, c->in.data + pos, c->in.len - pos);
+        c->in.len -= pos;
+    }
+}
+
+// Read until EAGAIN (edge triggered). Return -1 on EOF or error.
+static int http_conn_read(http_worker_t *w, http_conn_t *c) {
+    size_t limit = MTPSCRIPT_HTTP_MAX_HEADER_SIZE + w->server->config.max_body_size;
+
+    for (;;) {
+        if (c->in.cap - c->in.len < HTTP_READ_CHUNK) {
+            size_t cap = c->in.cap ? c->in.cap * 2 : HTTP_READ_CHUNK;
+            char *data;
+            if (c->in.cap >= limit + HTTP_READ_CHUNK) {
+                // A complete request never gets this large
+                http_respond_error(c, 413, http_status_error_type(413), http_status_text(413), false);
+                return 0;
+            }
+            data = realloc(c->in.data, cap);
+            if (!data) return -1;
+            c->in.data = data;
+            c->in.cap = cap;
+        }
+        ssize_t n = read(c->fd, c->in.data + c->in.len, c->in.cap - c->in.len);
+        if (n > 0) {
+            c->in.len += n;
+            http_conn_process(w, c);
+            if (c->closing) return 0;
+        } else if (n == 0) {
+            return -1;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+}
+
+static void http_accept(http_worker_t *w) {
+    for (;;) {
+        int fd = accept4(w->server->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return; // EAGAIN, or out of descriptors until a connection closes
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        http_conn_t *c = calloc(1, sizeof(http_conn_t));
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->next = w->conns;
+        if (w->conns) w->conns->prev = c;
+        w->conns = c;
+
+        struct epoll_event ev = {0};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.ptr = c;
+        if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            http_conn_close(w, c);
+        }
+    }
+}
+
+static void *http_worker_main(void *opaque) {
+    http_worker_t *w = opaque;
+    struct epoll_event events[HTTP_MAX_EVENTS];
+    bool running = true;
+
+    while (running) {
+        // Refill the VM pool only when there is nothing else to do
+        int timeout = mtpscript_vm_pool_needs_refill(w->pool) ? 0 : -1;
+        int n = epoll_wait(w->epoll_fd, events, HTTP_MAX_EVENTS, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) {
+            mtpscript_vm_pool_refill(w->pool);
+            continue;
+        }
+
+        for (int i = 0; i < n; i++) {
+            void *tag = events[i].data.ptr;
+            if (tag == &http_listen_tag) {
+                http_accept(w);
+            } else if (tag == &http_wake_tag) {
+                running = false;
+            } else {
+                http_conn_t *c = tag;
+                uint32_t ev = events[i].events;
+                int ret = 0;
+                if (ev & EPOLLIN) ret = http_conn_read(w, c);
+                if (ret == 0 && (ev & (EPOLLERR | EPOLLHUP))) ret = -1;
+                if (ret == 0) ret = http_conn_flush(c);
+                if (ret < 0) http_conn_close(w, c);
+            }
+        }
+    }
+
+    while (w->conns) {
+        http_conn_close(w, w->conns);
+    }
+    return NULL;
+}
+
+void mtpscript_http_server_config_init(mtpscript_http_server_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->port = 8080;
+    config->pool_size = MTPSCRIPT_HTTP_DEFAULT_POOL_SIZE;
+    config->mem_size = MTPSCRIPT_HTTP_DEFAULT_MEM_SIZE;
+    config->max_body_size = MTPSCRIPT_HTTP_DEFAULT_MAX_BODY;
+}
+
+static int http_listen(const mtpscript_http_server_config_t *config) {
+    struct addrinfo hints = {0}, *res, *ai;
+    char port[16];
+    int fd = -1, one = 1;
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    snprintf(port, sizeof(port), "%d", config->port);
+    if (getaddrinfo(config->host, port, &hints, &res) != 0) return -1;
+
+    for (ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+mtpscript_vector_t *mtpscript_http_program_routes(mtpscript_program_t *program) {
+    mtpscript_vector_t *routes = mtpscript_vector_new();
+
+    for (size_t i = 0; i < program->declarations->size; i++) {
+        mtpscript_declaration_t *decl = mtpscript_vector_get(program->declarations, i);
+        if (decl->kind == MTPSCRIPT_DECL_API) mtpscript_vector_push(routes, &decl->data.api);
+    }
+    for (size_t i = 0; i < program->declarations->size; i++) {
+        mtpscript_declaration_t *decl = mtpscript_vector_get(program->declarations, i);
+        if (decl->kind != MTPSCRIPT_DECL_SERVE) continue;
+        for (size_t j = 0; j < decl->data.serve.routes->size; j++) {
+            mtpscript_vector_push(routes, mtpscript_vector_get(decl->data.serve.routes, j));
+        }
+    }
+    return routes;
+}
+
+mtpscript_error_t *mtpscript_http_server_new(mtpscript_snapshot_t *snapshot, mtpscript_vector_t *routes,
+                                             const mtpscript_http_server_config_t *config,
+                                             mtpscript_http_server_t **server_out) {
+    mtpscript_http_server_t *server = calloc(1, sizeof(mtpscript_http_server_t));
+    mtpscript_error_t *err = NULL;
+    JSValue val;
+
+    *server_out = NULL;
+    if (!server) return http_error("Out of memory");
+    server->config = *config;
+    server->listen_fd = -1;
+    server->wake_fd = -1;
+    if (server->config.workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        server->config.workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (server->config.mem_size == 0) server->config.mem_size = MTPSCRIPT_HTTP_DEFAULT_MEM_SIZE;
+    if (server->config.max_body_size == 0) server->config.max_body_size = MTPSCRIPT_HTTP_DEFAULT_MAX_BODY;
+    // "localhost" is the serve default and means every interface
+    if (server->config.host && strcmp(server->config.host, "localhost") == 0) server->config.host = NULL;
+
+    // Template VM: the snapshot evaluated (or its heap image loaded) once,
+    // cloned for every request
+    server->template_mem = malloc(server->config.mem_size);
+    if (!server->template_mem) {
+        err = http_error("Out of memory");
+        goto fail;
+    }
+    if (JS_IsHeapImage(snapshot->content, snapshot->header.content_size)) {
+        // The initialized heap: no code runs at startup
+        server->template_ctx = JS_LoadHeapImage(server->template_mem, server->config.mem_size, &js_stdlib,
+                                                snapshot->content, snapshot->header.content_size);
+        if (!server->template_ctx) {
+            err = http_error("Snapshot heap image does not match this runtime");
+            goto fail;
+        }
+        JS_SetLogFunc(server->template_ctx, http_log_func);
+        val = JS_UNDEFINED;
+    } else {
+        server->template_ctx = JS_NewContext(server->template_mem, server->config.mem_size, &js_stdlib);
+        JS_SetLogFunc(server->template_ctx, http_log_func);
+        if (JS_IsBytecode(snapshot->content, snapshot->header.content_size)) {
+            // Relocated in place in the copy-on-write mapping, which the
+            // clones share
+            if (JS_RelocateBytecode(server->template_ctx, snapshot->content, snapshot->header.content_size)) {
+                err = http_error("Snapshot bytecode cannot be relocated (version or word size mismatch)");
+                goto fail;
+            }
+            val = JS_LoadBytecode(server->template_ctx, snapshot->content);
+            if (!JS_IsException(val))
+                val = JS_Run(server->template_ctx, val);
+        } else {
+            // snapshots created before the bytecode format contain the source
+            val = JS_Eval(server->template_ctx, (const char *)snapshot->content, snapshot->header.content_size,
+                          "app.msqs", 0);
+        }
+    }
+    if (JS_IsException(val)) {
+        JS_GetException(server->template_ctx);
+        err = http_error("Snapshot evaluation failed");
+        goto fail;
+    }
+    JS_GC(server->template_ctx);
+
+    server->apis = calloc(routes->size ? routes->size : 1, sizeof(mtpscript_api_decl_t *));
+    if (!server->apis) {
+        err = http_error("Out of memory");
+        goto fail;
+    }
+    for (size_t i = 0; i < routes->size; i++) {
+        mtpscript_api_decl_t *api = mtpscript_vector_get(routes, i);
+        if (api->handler) server->apis[server->api_count++] = api;
+    }
+
+    server->routes = mtpscript_route_registry_new();
+    if (!server->routes) {
+        err = http_error("Out of memory");
+        goto fail;
+    }
+    // The handler of a route is found by its index: every API must be
+    // registered
+    for (int i = 0; i < server->api_count; i++) {
+        mtpscript_api_decl_t *api = server->apis[i];
+        const char *method = mtpscript_string_cstr(api->method);
+        MTPScriptHTTPMethod m = mtpscript_http_method_from_string(method);
+        // Unknown methods are parsed as GET
+        if (strcmp(mtpscript_http_method_to_string(m), method) != 0 ||
+            !mtpscript_route_registry_add(server->routes, m,
+                                          mtpscript_string_cstr(api->path),
+                                          mtpscript_string_cstr(api->handler->name))) {
+            char message[256];
+            snprintf(message, sizeof(message), "Cannot register the route %s %s",
+                     method, mtpscript_string_cstr(api->path));
+            err = http_error(message);
+            goto fail;
+        }
+    }
+
+    server->listen_fd = http_listen(&server->config);
+    if (server->listen_fd < 0) {
+        err = http_error("Failed to bind the server socket");
+        goto fail;
+    }
+    server->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (server->wake_fd < 0) {
+        err = http_error("Failed to create the wake up descriptor");
+        goto fail;
+    }
+
+    server->workers = calloc(server->config.workers, sizeof(http_worker_t));
+    if (!server->workers) {
+        err = http_error("Out of memory");
+        goto fail;
+    }
+    for (int i = 0; i < server->config.workers; i++) {
+        http_worker_t *w = &server->workers[i];
+        MTPScriptVMPoolConfig pool_config;
+        struct epoll_event ev = {0};
+
+        w->server = server;
+        w->epoll_fd = -1;
+        server->worker_count++;
+
+        w->route_stats = calloc(server->api_count ? server->api_count : 1, sizeof(mtpscript_http_route_stats_t));
+        if (!w->route_stats) {
+            err = http_error("Out of memory");
+            goto fail;
+        }
+
+        mtpscript_vm_pool_config_init(&pool_config);
+        if (server->config.pool_size > 0) pool_config.size = server->config.pool_size;
+        pool_config.mem_size = server->config.mem_size;
+        if (server->config.heap_limit > 0) pool_config.heap_limit = server->config.heap_limit;
+        pool_config.max_heap_size = server->config.max_heap_size;
+        pool_config.gas_limit = server->config.gas_limit;
+        w->pool = mtpscript_vm_pool_new(server->template_ctx, &pool_config);
+        if (!w->pool) {
+            err = http_error("Failed to create the VM pool");
+            goto fail;
+        }
+
+        w->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (w->epoll_fd < 0) {
+            err = http_error("Failed to create the event loop");
+            goto fail;
+        }
+        // Only one worker is woken up per incoming connection
+        ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+        ev.data.ptr = &http_listen_tag;
+        if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, server->listen_fd, &ev) < 0) {
+            err = http_error("Failed to watch the server socket");
+            goto fail;
+        }
+        ev.events = EPOLLIN;
+        ev.data.ptr = &http_wake_tag;
+        if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, server->wake_fd, &ev) < 0) {
+            err = http_error("Failed to watch the wake up descriptor");
+            goto fail;
+        }
+    }
+
+    *server_out = server;
+    return NULL;
+
+fail:
+    mtpscript_http_server_free(server);
+    return err;
+}
+
+mtpscript_error_t *mtpscript_http_server_start(mtpscript_http_server_t *server) {
+    for (int i = 0; i < server->worker_count; i++) {
+        http_worker_t *w = &server->workers[i];
+        if (pthread_create(&w->thread, NULL, http_worker_main, w) != 0) {
+            mtpscript_http_server_stop(server);
+            return http_error("Failed to start a worker thread");
+        }
+        w->running = true;
+    }
+    return NULL;
+}
+
+void mtpscript_http_server_stop(mtpscript_http_server_t *server) {
+    uint64_t one = 1;
+
+    // The eventfd stays readable, so every worker sees it
+    if (write(server->wake_fd, &one, sizeof(one)) < 0) {
+        // Already signaled
+    }
+    for (int i = 0; i < server->worker_count; i++) {
+        http_worker_t *w = &server->workers[i];
+        if (w->running) {
+            pthread_join(w->thread, NULL);
+            w->running = false;
+        }
+    }
+}
+
+void mtpscript_http_server_free(mtpscript_http_server_t *server) {
+    if (!server) return;
+
+    mtpscript_http_server_stop(server);
+    for (int i = 0; i < server->worker_count; i++) {
+        http_worker_t *w = &server->workers[i];
+        if (w->epoll_fd >= 0) close(w->epoll_fd);
+        mtpscript_vm_pool_free(w->pool);
+        free(w->route_stats);
+    }
+    free(server->workers);
+    if (server->wake_fd >= 0) close(server->wake_fd);
+    if (server->listen_fd >= 0) close(server->listen_fd);
+    if (server->template_ctx) JS_FreeContext(server->template_ctx);
+    free(server->template_mem);
+    mtpscript_route_registry_free(server->routes);
+    free(server->apis);
+    free(server);
+}
+
+int mtpscript_http_server_worker_count(mtpscript_http_server_t *server) {
+    return server->worker_count;
+}
+
+int mtpscript_http_server_route_count(mtpscript_http_server_t *server) {
+    return server->routes->route_count;
+}
+
+void mtpscript_http_server_get_route_stats(mtpscript_http_server_t *server, int index,
+                                           const char **method, const char **path,
+                                           mtpscript_http_route_stats_t *stats) {
+    MTPScriptRoute *route = &server->routes->routes[index];
+
+    *method = mtpscript_http_method_to_string(route->method);
+    *path = route->path_pattern;
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < server->worker_count; i++) {
+        mtpscript_http_route_stats_t *s = &server->workers[i].route_stats[index];
+        uint64_t gas_peak = __atomic_load_n(&s->gas_peak, __ATOMIC_RELAXED);
+        size_t heap_peak = __atomic_load_n(&s->heap_peak, __ATOMIC_RELAXED);
+        size_t arena_peak = __atomic_load_n(&s->arena_peak, __ATOMIC_RELAXED);
+
+        stats->requests += __atomic_load_n(&s->requests, __ATOMIC_RELAXED);
+        stats->gc_count += __atomic_load_n(&s->gc_count, __ATOMIC_RELAXED);
+        if (gas_peak > stats->gas_peak) stats->gas_peak = gas_peak;
+        if (heap_peak > stats->heap_peak) stats->heap_peak = heap_peak;
+        if (arena_peak > stats->arena_peak) stats->arena_peak = arena_peak;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * MTPScript HTTP Host Adapter
+ * Specification §5.2, §8.0
+ *
+ * Request engine behind `mtpsc serve`: an epoll event loop per worker
+ * thread, HTTP/1.1 with keep-alive, and one pool of cloned snapshot VMs
+ * per worker. Every request runs the matched `api` handler on a fresh
+ * clone and answers with the JSON of its result.
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ */
+
+#ifndef MTPSCRIPT_HOST_HTTP_SERVER_H
+#define MTPSCRIPT_HOST_HTTP_SERVER_H
+
+#include "../compiler/ast.h"
+#include "../snapshot/snapshot.h"
+
+#define MTPSCRIPT_HTTP_DEFAULT_POOL_SIZE    8
+#define MTPSCRIPT_HTTP_DEFAULT_MEM_SIZE     (16 * 1024 * 1024)
+#define MTPSCRIPT_HTTP_MAX_HEADER_SIZE      (16 * 1024)
+#define MTPSCRIPT_HTTP_DEFAULT_MAX_BODY     (1024 * 1024)
+
+typedef struct {
+    const char *host;       // NULL or "localhost" = all interfaces
+    int port;
+    int workers;            // 0 = one per online CPU
+    int pool_size;          // Warm VMs per worker
+    size_t mem_size;        // Arena size of each VM (reserved, committed on use)
+    size_t heap_limit;      // Initial soft limit of a request heap (0 = pool default)
+    size_t max_heap_size;   // Hard heap budget of a request (0 = the arena)
+    uint64_t gas_limit;     // Per request (0 = runtime default)
+    size_t max_body_size;
+} mtpscript_http_server_config_t;
+
+// High-water marks of the requests served by one route
+typedef struct {
+    uint64_t requests;
+    uint64_t gc_count;      // GCs run by these requests
+    uint64_t gas_peak;      // Most gas used by one request
+    size_t heap_peak;       // Largest heap of one request, snapshot included
+    size_t arena_peak;      // Smallest 'mem_size' that fits every request
+} mtpscript_http_route_stats_t;
+
+typedef struct mtpscript_http_server_t mtpscript_http_server_t;
+
+void mtpscript_http_server_config_init(mtpscript_http_server_config_t *config);
+
+// The routes of 'program': its `api` declarations, then the routes of its
+// serve declarations. The vector refers to the program, which must outlive
+// it; free it with mtpscript_vector_free() after the server.
+mtpscript_vector_t *mtpscript_http_program_routes(mtpscript_program_t *program);
+
+// Load the snapshot, bind the socket and warm the VM pools. 'routes' is a
+// vector of mtpscript_api_decl_t which must outlive the server, like the
+// snapshot: bytecode snapshots are relocated and run from its mapping.
+mtpscript_error_t *mtpscript_http_server_new(mtpscript_snapshot_t *snapshot, mtpscript_vector_t *routes,
+                                             const mtpscript_http_server_config_t *config,
+                                             mtpscript_http_server_t **server_out);
+
+// Start the worker threads; returns immediately
+mtpscript_error_t *mtpscript_http_server_start(mtpscript_http_server_t *server);
+
+// Wake the workers, close their connections and join them
+void mtpscript_http_server_stop(mtpscript_http_server_t *server);
+void mtpscript_http_server_free(mtpscript_http_server_t *server);
+
+int mtpscript_http_server_worker_count(mtpscript_http_server_t *server);
+
+// Routes are numbered in declaration order. The statistics are summed
+// over the workers and may be read while the server runs; they are exact
+// once the server is stopped.
+int mtpscript_http_server_route_count(mtpscript_http_server_t *server);
+void mtpscript_http_server_get_route_stats(mtpscript_http_server_t *server, int index,
+                                           const char **method, const char **path,
+                                           mtpscript_http_route_stats_t *stats);
+
+#endif // MTPSCRIPT_HOST_HTTP_SERVER_H
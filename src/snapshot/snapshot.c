@@ -7,70 +7,125 @@
  */
 
 #include "snapshot.h"
+#include "mquickjs_crypto.h"
 #include <stdio.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// The content is aligned in the file (and in its mapping) for the VM
+#define SNAPSHOT_CONTENT_ALIGN 16
+
+static mtpscript_error_t *snapshot_error(const char *message) {
+    mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
+    error->message = mtpscript_string_from_cstr(message);
+    error->location = (mtpscript_location_t){0, 0, "snapshot"};
+    return error;
+}
 
 mtpscript_error_t *mtpscript_snapshot_create(const char *bytecode_data, size_t bytecode_size, const char *metadata, const uint8_t *signature, size_t sig_size, const char *output_file) {
     FILE *f = fopen(output_file, "wb");
     if (!f) {
-        mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
-        error->message = mtpscript_string_from_cstr("Failed to open output file");
-        return error;
+        return snapshot_error("Failed to open output file");
     }
 
+    // The metadata is JSON: it is padded with spaces to align the content
+    size_t metadata_len = strlen(metadata);
+    size_t padding = (SNAPSHOT_CONTENT_ALIGN - (sizeof(mtpscript_snapshot_header_t) + metadata_len) % SNAPSHOT_CONTENT_ALIGN) % SNAPSHOT_CONTENT_ALIGN;
+
     mtpscript_snapshot_header_t header;
     memcpy(header.magic, "MSQS", 4);
     header.version = 1;
-    header.metadata_size = (uint32_t)strlen(metadata);
+    header.metadata_size = (uint32_t)(metadata_len + padding);
     header.content_size = (uint32_t)bytecode_size;
-    header.signature_size = (uint32_t)sig_size;
+    header.signature_size = signature ? (uint32_t)sig_size : 0;
 
     fwrite(&header, sizeof(header), 1, f);
-    fwrite(metadata, 1, header.metadata_size, f);
+    fwrite(metadata, 1, metadata_len, f);
+    for (size_t i = 0; i < padding; i++) {
+        fputc(' ', f);
+    }
     fwrite(bytecode_data, 1, header.content_size, f);
-    if (signature && sig_size > 0) {
-        fwrite(signature, 1, sig_size, f);
+    if (header.signature_size > 0) {
+        fwrite(signature, 1, header.signature_size, f);
     }
 
-    fclose(f);
+    if (ferror(f)) {
+        fclose(f);
+        return snapshot_error("Failed to write the snapshot");
+    }
+    if (fclose(f) != 0) {
+        return snapshot_error("Failed to write the snapshot");
+    }
     return NULL;
 }
 
-mtpscript_error_t *mtpscript_snapshot_load(const char *input_file, mtpscript_snapshot_t **snapshot_out) {
-    FILE *f = fopen(input_file, "rb");
-    if (!f) {
-        mtpscript_error_t *error = MTPSCRIPT_MALLOC(sizeof(mtpscript_error_t));
-        error->message = mtpscript_string_from_cstr("Failed to open input file");
-        return error;
+mtpscript_error_t *mtpscript_snapshot_load(const char *input_file, const ECDSAPublicKey *verify_key, mtpscript_snapshot_t **snapshot_out) {
+    int fd = open(input_file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return snapshot_error("Failed to open input file");
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return snapshot_error("Failed to open input file");
+    }
+    if ((uint64_t)st.st_size < sizeof(mtpscript_snapshot_header_t)) {
+        close(fd);
+        return snapshot_error("Snapshot is truncated");
+    }
+    size_t map_size = (size_t)st.st_size;
+    // Private copy-on-write mapping: the pages stay in the page cache and
+    // are shared by every process mapping the file until one writes them.
+    // The file itself is never modified.
+    void *map_base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map_base == MAP_FAILED) {
+        return snapshot_error("Failed to map the snapshot");
     }
 
-    mtpscript_snapshot_t *snapshot = MTPSCRIPT_MALLOC(sizeof(mtpscript_snapshot_t));
-    fread(&snapshot->header, sizeof(mtpscript_snapshot_header_t), 1, f);
-
-    snapshot->metadata = MTPSCRIPT_MALLOC(snapshot->header.metadata_size + 1);
-    fread(snapshot->metadata, 1, snapshot->header.metadata_size, f);
-    snapshot->metadata[snapshot->header.metadata_size] = '\0';
+    mtpscript_snapshot_header_t header;
+    memcpy(&header, map_base, sizeof(header));
+    if (memcmp(header.magic, "MSQS", 4) != 0 || header.version != 1) {
+        munmap(map_base, map_size);
+        return snapshot_error("Invalid snapshot header");
+    }
+    // 64 bit sum: the sizes cannot overflow
+    uint64_t total = (uint64_t)sizeof(header) + header.metadata_size + header.content_size + header.signature_size;
+    if (total != map_size) {
+        munmap(map_base, map_size);
+        return snapshot_error("Snapshot sizes do not match the file size");
+    }
 
-    snapshot->content = MTPSCRIPT_MALLOC(snapshot->header.content_size);
-    fread(snapshot->content, 1, snapshot->header.content_size, f);
+    uint8_t *p = (uint8_t *)map_base + sizeof(header);
+    uint8_t *content = p + header.metadata_size;
+    const uint8_t *signature = header.signature_size ? content + header.content_size : NULL;
 
-    if (snapshot->header.signature_size > 0) {
-        snapshot->signature = MTPSCRIPT_MALLOC(snapshot->header.signature_size);
-        fread(snapshot->signature, 1, snapshot->header.signature_size, f);
-    } else {
-        snapshot->signature = NULL;
+    // Verified once per load, before the content is modified by a
+    // relocation
+    if (verify_key &&
+        !JS_VerifySnapshotSignature(content, header.content_size, signature, header.signature_size,
+                                    verify_key)) {
+        munmap(map_base, map_size);
+        return snapshot_error("Snapshot signature verification failed");
     }
 
-    fclose(f);
+    mtpscript_snapshot_t *snapshot = MTPSCRIPT_MALLOC(sizeof(mtpscript_snapshot_t));
+    snapshot->header = header;
+    snapshot->metadata = (const char *)p;
+    snapshot->content = content;
+    snapshot->signature = signature;
+    snapshot->map_base = map_base;
+    snapshot->map_size = map_size;
     *snapshot_out = snapshot;
     return NULL;
 }
 
 void mtpscript_snapshot_free(mtpscript_snapshot_t *snapshot) {
     if (snapshot) {
-        if (snapshot->metadata) MTPSCRIPT_FREE(snapshot->metadata);
-        if (snapshot->content) MTPSCRIPT_FREE(snapshot->content);
-        if (snapshot->signature) MTPSCRIPT_FREE(snapshot->signature);
+        munmap(snapshot->map_base, snapshot->map_size);
         MTPSCRIPT_FREE(snapshot);
     }
 }
@@ -10,6 +10,7 @@
 #define MTPSCRIPT_SNAPSHOT_H
 
 #include "mtpscript.h"
+#include "mquickjs_crypto.h"
 
 typedef struct {
     uint8_t magic[4];
@@ -19,15 +20,24 @@ typedef struct {
     uint32_t signature_size;
 } mtpscript_snapshot_header_t;
 
+// A snapshot mapped privately: the pointers refer to the mapping, so the
+// worker processes of a host share one page cache copy of the file. The
+// content is writable so that bytecode can be relocated in place: only
+// the pages which are written are copied.
 typedef struct {
     mtpscript_snapshot_header_t header;
-    char *metadata;
+    const char *metadata; // header.metadata_size bytes, not NUL terminated
     uint8_t *content;
-    uint8_t *signature;
+    const uint8_t *signature; // NULL if unsigned
+    void *map_base;
+    size_t map_size;
 } mtpscript_snapshot_t;
 
 mtpscript_error_t *mtpscript_snapshot_create(const char *bytecode_data, size_t bytecode_size, const char *metadata, const uint8_t *signature, size_t sig_size, const char *output_file);
-mtpscript_error_t *mtpscript_snapshot_load(const char *input_file, mtpscript_snapshot_t **snapshot);
+// Map 'input_file' and validate its header and bounds. If 'verify_key' is
+// not NULL, the ECDSA signature of the content is verified with it
+// (usually &mtpscript_public_key) and unsigned snapshots are rejected.
+mtpscript_error_t *mtpscript_snapshot_load(const char *input_file, const ECDSAPublicKey *verify_key, mtpscript_snapshot_t **snapshot);
 void mtpscript_snapshot_free(mtpscript_snapshot_t *snapshot);
 
 #endif // MTPSCRIPT_SNAPSHOT_H
@@ -173,26 +173,6 @@ mtpscript_string_t *mtpscript_cbor_serialize_null(void) {
     return cbor;
 }
 
-// FNV-1a 64-bit hashing implementation
-#define FNV1A_64_OFFSET 0xcbf29ce484222325ULL
-#define FNV1A_64_PRIME 0x100000001b3ULL
-
-uint64_t mtpscript_fnv1a_64(const void *data, size_t length) {
-    uint64_t hash = FNV1A_64_OFFSET;
-    const uint8_t *bytes = (const uint8_t *)data;
-
-    for (size_t i = 0; i < length; i++) {
-        hash ^= bytes[i];
-        hash *= FNV1A_64_PRIME;
-    }
-
-    return hash;
-}
-
-uint64_t mtpscript_fnv1a_64_string(const char *str) {
-    return mtpscript_fnv1a_64(str, strlen(str));
-}
-
 // SHA-256 implementation
 void mtpscript_sha256(const void *data, size_t length, uint8_t output[MTPSCRIPT_SHA256_DIGEST_SIZE]) {
     SHA256(data, length, output);
@@ -99,9 +99,7 @@ mtpscript_string_t *mtpscript_json_serialize(const mtpscript_json_t *json);
 // JSON cleanup
 void mtpscript_json_free(mtpscript_json_t *json);
 
-// Hashing and crypto primitives
-uint64_t mtpscript_fnv1a_64(const void *data, size_t length);
-uint64_t mtpscript_fnv1a_64_string(const char *str);
+// Hashing and crypto primitives (FNV-1a is in mtpscript.h)
 
 // SHA-256 hash (32 bytes)
 #define MTPSCRIPT_SHA256_DIGEST_SIZE 32
@@ -0,0 +1,181 @@
+/*
+ * Decimal micro benchmark
+ *
+ * Compares the decimal128 engine with the previous string based
+ * representation, where every operation parsed the significand string
+ * with atoll() and printed the result back with sprintf().
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include <math.h>
+
+#include "decimal128.h"
+
+#define N_VALUES 1024
+
+/* previous representation */
+typedef struct {
+    char value[35];
+    int32_t scale;
+} StrDecimal;
+
+static void str_add(StrDecimal *r, const StrDecimal *a, const StrDecimal *b)
+{
+    long long v1 = atoll(a->value), v2 = atoll(b->value);
+    int s1 = a->scale, s2 = b->scale;
+    while (s1 < s2) {
+        v1 *= 10;
+        s1++;
+    }
+    while (s2 < s1) {
+        v2 *= 10;
+        s2++;
+    }
+    snprintf(r->value, sizeof(r->value), "%lld", v1 + v2);
+    r->scale = s1;
+}
+
+static void str_mul(StrDecimal *r, const StrDecimal *a, const StrDecimal *b)
+{
+    snprintf(r->value, sizeof(r->value), "%lld",
+             atoll(a->value) * atoll(b->value));
+    r->scale = a->scale + b->scale;
+}
+
+static int str_cmp(const StrDecimal *a, const StrDecimal *b)
+{
+    long long v1 = atoll(a->value), v2 = atoll(b->value);
+    int s1 = a->scale, s2 = b->scale;
+    while (s1 < s2) {
+        v1 *= 10;
+        s1++;
+    }
+    while (s2 < s1) {
+        v2 *= 10;
+        s2++;
+    }
+    return (v1 > v2) - (v1 < v2);
+}
+
+static int str_to_string(char *buf, const StrDecimal *a)
+{
+    long long v = atoll(a->value);
+    long long p = (long long)pow(10, a->scale);
+    if (a->scale == 0)
+        return sprintf(buf, "%lld", v);
+    return sprintf(buf, "%lld.%0*lld", v / p, a->scale, llabs(v % p));
+}
+
+static int64_t get_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static StrDecimal str_vals[N_VALUES];
+static Decimal128 dec_vals[N_VALUES];
+static volatile int sink;
+
+static void report(const char *name, int64_t str_ns, int64_t dec_ns, int n)
+{
+    printf("%-10s %10.2f %10.2f %8.1fx\n", name, (double)str_ns / n,
+           (double)dec_ns / n, (double)str_ns / dec_ns);
+}
+
+int main(int argc, char **argv)
+{
+    int n_iter, i, j, n;
+    int64_t t0, t_str, t_dec;
+    char buf[64];
+    StrDecimal sr;
+    Decimal128 dr;
+
+    n_iter = 2000;
+    if (argc > 1)
+        n_iter = atoi(argv[1]);
+
+    /* amounts with 2 decimals, small enough for the int64 code */
+    srand(1);
+    for(i = 0; i < N_VALUES; i++) {
+        long long v = rand() % 100000000;
+        snprintf(str_vals[i].value, sizeof(str_vals[i].value), "%lld", v);
+        str_vals[i].scale = 2;
+        snprintf(buf, sizeof(buf), "%lld.%02lld", v / 100, v % 100);
+        dec128_from_string(&dec_vals[i], buf, strlen(buf));
+    }
+    n = n_iter * N_VALUES;
+
+    printf("%-10s %10s %10s %9s\n", "OP", "STR (ns)", "DEC (ns)", "SPEEDUP");
+
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            str_add(&sr, &str_vals[i], &str_vals[(i + j) % N_VALUES]);
+    }
+    t_str = get_time_ns() - t0;
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += dec128_add(&dr, &dec_vals[i], &dec_vals[(i + j) % N_VALUES]);
+    }
+    t_dec = get_time_ns() - t0;
+    report("add", t_str, t_dec, n);
+
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            str_mul(&sr, &str_vals[i], &str_vals[(i + j) % N_VALUES]);
+    }
+    t_str = get_time_ns() - t0;
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += dec128_mul(&dr, &dec_vals[i], &dec_vals[(i + j) % N_VALUES]);
+    }
+    t_dec = get_time_ns() - t0;
+    report("mul", t_str, t_dec, n);
+
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += str_cmp(&str_vals[i], &str_vals[(i + j) % N_VALUES]);
+    }
+    t_str = get_time_ns() - t0;
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += dec128_cmp(&dec_vals[i], &dec_vals[(i + j) % N_VALUES]);
+    }
+    t_dec = get_time_ns() - t0;
+    report("compare", t_str, t_dec, n);
+
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += str_to_string(buf, &str_vals[i]);
+    }
+    t_str = get_time_ns() - t0;
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += dec128_to_string(buf, &dec_vals[i]);
+    }
+    t_dec = get_time_ns() - t0;
+    report("toString", t_str, t_dec, n);
+
+    /* division has no exact equivalent in the previous code */
+    t0 = get_time_ns();
+    for(j = 0; j < n_iter; j++) {
+        for(i = 0; i < N_VALUES; i++)
+            sink += dec128_div(&dr, &dec_vals[i], &dec_vals[(i + j + 1) % N_VALUES]);
+    }
+    t_dec = get_time_ns() - t0;
+    printf("%-10s %10s %10.2f\n", "div", "-", (double)t_dec / n);
+    return 0;
+}
@@ -0,0 +1,30 @@
+// Generated by MTPScript Compiler
+
+function $matchFail() {
+  throw new Error('Non-exhaustive match');
+}
+
+function twice(x) {
+  return x * 2;
+}
+
+function grade(n) {
+  var $m;
+  return (n === 1 ? ("one") : n === 2 ? ("two") : ("many"));
+}
+
+function label(ok) {
+  var $m;
+  return (ok === true ? ("yes") : ok === false ? ("no") : $matchFail());
+}
+
+function describe(n) {
+  var $m;
+  return ($m = twice(n) + 1, $m === 3 ? ("three") : $m === 5 ? (grade(n)) : $matchFail());
+}
+
+function kind(s) {
+  var $m;
+  return (s === "a" ? (1) : s === "b" ? ((1 + 2) * 3) : (0));
+}
+
@@ -0,0 +1,41 @@
+// Generated by MTPScript Compiler
+
+function $matchFail() {
+  throw new Error('Non-exhaustive match');
+}
+
+function square(x) {
+  return x * x;
+}
+
+function sign(n) {
+  var $m;
+  return (n === 0 ? (0) : n === 1 ? (1) : $matchFail());
+}
+
+function checked_sign(n) {
+  var $m;
+  var s = (n === 0 ? (0) : n === 1 ? (1) : $matchFail());
+  return s;
+}
+
+function area() {
+  return 10;
+}
+
+function pipeline(a, b) {
+  return a + b * b;
+}
+
+function checked(n) {
+  var $m;
+  var s = checked_sign(n);
+  var t = (n === 0 ? (0) : n === 1 ? (1) : $matchFail());
+  return n;
+}
+
+function common(a, b) {
+  var $cse0 = square(a + b);
+  return ($cse0 + 1) * $cse0;
+}
+
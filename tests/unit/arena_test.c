@@ -0,0 +1,109 @@
+/**
+ * MTPScript compiler arena tests
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Tokens, AST nodes, strings and vectors of a compilation unit are bump
+ * allocated in one arena and released with it.
+ */
+
+#include "unit_test.h"
+#include "src/compiler/mtpscript.h"
+
+#define ARENA_ALIGN 16
+
+static int test_arena_alignment(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    char *prev = NULL;
+
+    for (size_t size = 1; size < 200; size++) {
+        char *p = mtpscript_arena_alloc(arena, size);
+        CHECK(p && ((uintptr_t)p & (ARENA_ALIGN - 1)) == 0);
+        // Allocations do not overlap
+        memset(p, (int)size, size);
+        if (prev) CHECK(prev[0] == (char)(size - 1));
+        prev = p;
+    }
+    mtpscript_arena_free(arena);
+    return 1;
+}
+
+// Many small objects span several blocks, large ones get their own block
+// without wasting the current one
+static int test_arena_blocks(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    uint32_t *small[20000];
+    char *large, *after;
+
+    for (int i = 0; i < 20000; i++) {
+        small[i] = mtpscript_arena_alloc(arena, sizeof(uint32_t) * 4);
+        small[i][0] = i;
+        small[i][3] = ~i;
+    }
+    for (int i = 0; i < 20000; i++) {
+        CHECK(small[i][0] == (uint32_t)i && small[i][3] == ~(uint32_t)i);
+    }
+
+    char *before = mtpscript_arena_alloc(arena, 16);
+    large = mtpscript_arena_alloc(arena, 1024 * 1024);
+    memset(large, 0x5a, 1024 * 1024);
+    after = mtpscript_arena_alloc(arena, 16);
+    // The current block is still used after the large allocation
+    CHECK(after == before + 16);
+    CHECK(large[0] == 0x5a && large[1024 * 1024 - 1] == 0x5a);
+    mtpscript_arena_free(arena);
+    return 1;
+}
+
+// Arena strings and vectors grow in the arena. Their free functions
+// ignore them: they are released with the arena.
+static int test_arena_string_vector(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_string_t *str = mtpscript_arena_string_new(arena, "ab", 2);
+    mtpscript_vector_t *vec = mtpscript_arena_vector_new(arena);
+    char *dup = mtpscript_arena_strndup(arena, "hello world", 5);
+
+    CHECK(strcmp(dup, "hello") == 0);
+    for (int i = 0; i < 1000; i++) {
+        mtpscript_string_append_cstr(str, "xyz");
+        mtpscript_vector_push(vec, (void *)(uintptr_t)(i + 1));
+    }
+    CHECK(str->length == 3002 && strlen(mtpscript_string_cstr(str)) == 3002);
+    CHECK(strncmp(str->data, "abxyzxyz", 8) == 0);
+    CHECK(vec->size == 1000);
+    for (int i = 0; i < 1000; i++) {
+        CHECK(mtpscript_vector_get(vec, i) == (void *)(uintptr_t)(i + 1));
+    }
+    CHECK(mtpscript_vector_get(vec, 1000) == NULL);
+
+    mtpscript_string_free(str);
+    mtpscript_vector_free(vec);
+    CHECK(str->data[0] == 'a' && vec->size == 1000);
+    mtpscript_arena_free(arena);
+    return 1;
+}
+
+// Without an arena, strings and vectors are heap allocated
+static int test_arena_heap_fallback(void) {
+    mtpscript_string_t *str = mtpscript_arena_string_new(NULL, "abc", 3);
+    mtpscript_vector_t *vec = mtpscript_arena_vector_new(NULL);
+
+    CHECK(str->arena == NULL && vec->arena == NULL);
+    mtpscript_string_append_cstr(str, "def");
+    mtpscript_vector_push(vec, str);
+    CHECK(strcmp(mtpscript_string_cstr(str), "abcdef") == 0);
+    CHECK(mtpscript_vector_get(vec, 0) == str);
+    mtpscript_string_free(str);
+    mtpscript_vector_free(vec);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript compiler arena tests\n");
+    RUN_TEST(test_arena_alignment, "allocations are aligned and distinct");
+    RUN_TEST(test_arena_blocks, "small and large allocations");
+    RUN_TEST(test_arena_string_vector, "arena strings and vectors grow in the arena");
+    RUN_TEST(test_arena_heap_fallback, "strings and vectors without an arena");
+    return test_summary("arena_test");
+}
@@ -0,0 +1,224 @@
+/**
+ * MTPScript async effect batch tests
+ * Specification §7-a - Async effects
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * JS_AsyncAwaitAll() performs the I/O of independent awaits concurrently
+ * but resumes them in cont_id order: the result of a batch must not
+ * depend on which I/O finishes first. Compiled code reaches it through
+ * Async.awaitAll().
+ */
+
+#include <unistd.h>
+#include <sys/time.h>
+#include "unit_vm.h"
+#include "mquickjs_effects.h"
+
+#define ASYNC_MEM_SIZE (256 * 1024)
+
+// A request is {id, delay, fail}: a delay in ms, fail != 0 to fail
+typedef struct {
+    int id;
+    int delay_ms;
+    bool fail;
+} async_request_t;
+
+static int prepare_order[8];
+static int prepare_count;
+static int perform_count;
+
+static void *test_prepare(JSContext *ctx, JSValue args) {
+    async_request_t *r = calloc(1, sizeof(async_request_t));
+    int v;
+
+    if (!r) return NULL;
+    JS_ToInt32(ctx, &v, JS_GetPropertyStr(ctx, args, "id"));
+    r->id = v;
+    JS_ToInt32(ctx, &v, JS_GetPropertyStr(ctx, args, "delay"));
+    r->delay_ms = v;
+    JS_ToInt32(ctx, &v, JS_GetPropertyStr(ctx, args, "fail"));
+    r->fail = v != 0;
+    if (prepare_count < 8) prepare_order[prepare_count] = r->id;
+    prepare_count++;
+    return r;
+}
+
+static char *test_perform(void *request, size_t *plen, char **perror) {
+    async_request_t *r = request;
+    char *res;
+
+    __atomic_fetch_add(&perform_count, 1, __ATOMIC_RELAXED);
+    usleep(r->delay_ms * 1000);
+    if (r->fail) {
+        *perror = malloc(32);
+        if (*perror) snprintf(*perror, 32, "request %d failed", r->id);
+        return NULL;
+    }
+    res = malloc(32);
+    if (!res) return NULL;
+    *plen = snprintf(res, 32, "{\"id\":%d}", r->id);
+    return res;
+}
+
+static const JSAsyncHandler test_handler = { test_prepare, test_perform, free };
+
+static JSContext *async_vm_new(uint8_t seed_byte) {
+    static const char *effects[] = { "Async" };
+    JSContext *ctx = vm_new(ASYNC_MEM_SIZE);
+    uint8_t seed[32];
+
+    if (!ctx) return NULL;
+    memset(seed, seed_byte, sizeof(seed));
+    if (!JS_SetDeclaredEffects(ctx, effects, 1) ||
+        !JS_RegisterAsyncHandler(ctx, "test_io", &test_handler) ||
+        !JS_SetExecutionSeed(ctx, seed, sizeof(seed))) {
+        cleanup_effects(ctx);
+        vm_free(ctx);
+        return NULL;
+    }
+    prepare_count = 0;
+    perform_count = 0;
+    return ctx;
+}
+
+static void async_vm_free(JSContext *ctx) {
+    cleanup_effects(ctx);
+    vm_free(ctx);
+}
+
+// Await the requests of the JS array 'args', return the batch result as
+// JSON or the exception message
+static int async_await_all(JSContext *ctx, const char *args, const int *cont_ids, int count,
+                           char *buf, size_t buf_size) {
+    JSAsyncAwaitRequest requests[8];
+    JSCStringBuf sbuf;
+    const char *str;
+    JSValue val;
+    int ret = 0;
+
+    val = JS_Eval(ctx, args, strlen(args), "<args>", JS_EVAL_RETVAL);
+    if (JS_IsException(val)) return -2;
+    for (int i = 0; i < count; i++) {
+        requests[i].promise_hash = "test_io";
+        requests[i].cont_id = cont_ids[i];
+        requests[i].args = JS_GetPropertyUint32(ctx, val, i);
+    }
+    val = JS_AsyncAwaitAll(ctx, requests, count);
+    if (JS_IsException(val)) {
+        val = JS_GetPropertyStr(ctx, JS_GetException(ctx), "message");
+        ret = -1;
+    } else {
+        val = JS_JSONStringify(ctx, val);
+    }
+    str = JS_ToCString(ctx, val, &sbuf);
+    snprintf(buf, buf_size, "%s", str ? str : "<exception>");
+    return ret;
+}
+
+// The first awaited I/O finishes last: the results stay in request order
+// and the effects are prepared in cont_id order
+static int test_async_resume_order(void) {
+    static const char *args = "[{id: 2, delay: 60}, {id: 1, delay: 5}]";
+    static const int cont_ids[] = { 2, 1 };
+    JSContext *ctx = async_vm_new(1);
+    char buf[256];
+
+    CHECK(ctx);
+    CHECK(async_await_all(ctx, args, cont_ids, 2, buf, sizeof(buf)) == 0);
+    CHECK(strcmp(buf, "[{\"id\":2},{\"id\":1}]") == 0);
+    CHECK(prepare_count == 2 && prepare_order[0] == 1 && prepare_order[1] == 2);
+    CHECK(perform_count == 2);
+    async_vm_free(ctx);
+    return 1;
+}
+
+// Whichever request fails first, the error of the lowest cont_id is
+// reported
+static int test_async_error_order(void) {
+    static const char *args = "[{id: 3, delay: 0, fail: 1}, {id: 1, delay: 40, fail: 1}, {id: 2, delay: 0}]";
+    static const int cont_ids[] = { 3, 1, 2 };
+    JSContext *ctx = async_vm_new(2);
+    char buf[256];
+
+    CHECK(ctx);
+    CHECK(async_await_all(ctx, args, cont_ids, 3, buf, sizeof(buf)) == -1);
+    CHECK(strstr(buf, "request 1 failed") != NULL);
+    async_vm_free(ctx);
+    return 1;
+}
+
+// A second run with the same seed replays the batch from the cache
+static int test_async_replay(void) {
+    static const char *args = "[{id: 5, delay: 20}, {id: 4, delay: 0}]";
+    static const int cont_ids[] = { 11, 10 };
+    char first[256], second[256];
+    JSContext *ctx;
+
+    ctx = async_vm_new(3);
+    CHECK(ctx);
+    CHECK(async_await_all(ctx, args, cont_ids, 2, first, sizeof(first)) == 0);
+    CHECK(perform_count == 2);
+    async_vm_free(ctx);
+
+    ctx = async_vm_new(3);
+    CHECK(ctx);
+    CHECK(async_await_all(ctx, args, cont_ids, 2, second, sizeof(second)) == 0);
+    CHECK(perform_count == 0 && prepare_count == 0);
+    CHECK(strcmp(first, second) == 0);
+    async_vm_free(ctx);
+    return 1;
+}
+
+static int test_async_duplicate_cont_id(void) {
+    static const char *args = "[{id: 1, delay: 0}, {id: 2, delay: 0}]";
+    static const int cont_ids[] = { 7, 7 };
+    JSContext *ctx = async_vm_new(4);
+    char buf[256];
+
+    CHECK(ctx);
+    CHECK(async_await_all(ctx, args, cont_ids, 2, buf, sizeof(buf)) == -1);
+    CHECK(strstr(buf, "Duplicate continuation id") != NULL && perform_count == 0);
+    async_vm_free(ctx);
+    return 1;
+}
+
+static long async_elapsed_ms(const struct timeval *start) {
+    struct timeval end;
+
+    gettimeofday(&end, NULL);
+    return (end.tv_sec - start->tv_sec) * 1000 + (end.tv_usec - start->tv_usec) / 1000;
+}
+
+// Async.awaitAll() runs the effects of a batch at the same time
+static int test_async_js_batch(void) {
+    JSContext *ctx = async_vm_new(5);
+    struct timeval start;
+    char buf[256];
+
+    CHECK(ctx);
+    gettimeofday(&start, NULL);
+    CHECK(vm_eval_is(ctx, "JSON.stringify(Async.awaitAll([['test_io', 2, {id: 2, delay: 100}],"
+                                                          "['test_io', 1, {id: 1, delay: 100}]]))",
+                     "[{\"id\":2},{\"id\":1}]"));
+    // Two 100 ms effects, overlapped
+    CHECK(async_elapsed_ms(&start) < 190);
+    CHECK(prepare_count == 2 && prepare_order[0] == 1 && prepare_order[1] == 2);
+
+    CHECK(vm_eval_is(ctx, "Async.await('test_io', 3, {id: 3, delay: 0}).id", "3"));
+    CHECK(vm_eval(ctx, "Async.await('test_io', 4, {id: 4, fail: 1})", buf, sizeof(buf)) == -1);
+    CHECK(strstr(buf, "request 4 failed") != NULL);
+    async_vm_free(ctx);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript async effect batch tests\n");
+    RUN_TEST(test_async_resume_order, "independent awaits resume in cont_id order");
+    RUN_TEST(test_async_error_order, "the lowest cont_id error is reported");
+    RUN_TEST(test_async_replay, "a batch is replayed from the cache");
+    RUN_TEST(test_async_duplicate_cont_id, "duplicate continuation ids are rejected");
+    RUN_TEST(test_async_js_batch, "Async.awaitAll() overlaps the effects");
+    return test_summary("async_test");
+}
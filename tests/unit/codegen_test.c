@@ -0,0 +1,236 @@
+/**
+ * MTPScript code generator tests
+ * Specification §5.0 - Code generation
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Sources are lexed, parsed and lowered to JavaScript, which is compared
+ * with the expected output of the fixtures and run in a context.
+ * Independent awaits are lowered to one Async.awaitAll() batch.
+ */
+
+#include <unistd.h>
+#include <sys/time.h>
+#include "unit_vm.h"
+#include "mquickjs_effects.h"
+#include "lexer.h"
+#include "parser.h"
+#include "codegen.h"
+
+#define CODEGEN_MEM_SIZE (256 * 1024)
+
+// Read a whole file, NULL on error. The result must be freed.
+static char *codegen_read_file(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    char *buf = NULL;
+    long len;
+
+    if (!f) return NULL;
+    if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+        buf = malloc(len + 1);
+        if (buf && fread(buf, 1, len, f) == (size_t)len) {
+            buf[len] = '\0';
+        } else {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(f);
+    return buf;
+}
+
+// Parse 'source' into 'arena', NULL on error
+static mtpscript_program_t *codegen_parse(mtpscript_arena_t *arena, const char *source) {
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, "<test>");
+    mtpscript_parser_t *parser = NULL;
+    mtpscript_program_t *program = NULL;
+    mtpscript_vector_t *tokens;
+    mtpscript_error_t *err;
+
+    err = mtpscript_lexer_tokenize(lexer, &tokens);
+    if (!err) {
+        parser = mtpscript_parser_new(arena, tokens);
+        err = mtpscript_parser_parse(parser, &program);
+    }
+    if (err) {
+        mtpscript_error_free(err);
+        program = NULL;
+    }
+    if (parser) mtpscript_parser_free(parser);
+    mtpscript_lexer_free(lexer);
+    return program;
+}
+
+// Compile 'source' to JavaScript, NULL on error. The result must be freed
+// with mtpscript_string_free().
+static mtpscript_string_t *codegen_compile(const char *source) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_program_t *program = codegen_parse(arena, source);
+    mtpscript_string_t *js = NULL;
+
+    if (program && mtpscript_codegen_program(program, &js)) js = NULL;
+    mtpscript_arena_free(arena);
+    return js;
+}
+
+// The fixture compiles to its expected output
+static int test_codegen_fixture(void) {
+    char *source = codegen_read_file("tests/fixtures/match_expr.mtp");
+    char *expected = codegen_read_file("tests/fixtures/match_expr.js");
+    mtpscript_string_t *js;
+
+    CHECK(source && expected);
+    js = codegen_compile(source);
+    CHECK(js);
+    if (strcmp(mtpscript_string_cstr(js), expected) != 0) {
+        printf("\n%s", mtpscript_string_cstr(js));
+        CHECK(0);
+    }
+    mtpscript_string_free(js);
+    free(expected);
+    free(source);
+    return 1;
+}
+
+// Patterns are kept as the code the scrutinee is compared with, and an
+// arm body ends where the next pattern starts
+static int test_codegen_match_parse(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_program_t *program = codegen_parse(arena,
+        "func f(s: String): Int { return match g(s, 1) { | \"a\" -> 1 + 2 | 7 -> h(s) | _ -> match s { _ -> 0 } } }");
+    mtpscript_declaration_t *decl;
+    mtpscript_statement_t *stmt;
+    mtpscript_expression_t *match;
+    mtpscript_match_arm_t *arm;
+
+    CHECK(program && program->declarations->size == 1);
+    decl = mtpscript_vector_get(program->declarations, 0);
+    stmt = mtpscript_vector_get(decl->data.function.body, 0);
+    CHECK(decl->kind == MTPSCRIPT_DECL_FUNCTION && stmt->kind == MTPSCRIPT_STMT_RETURN_STMT);
+    match = stmt->data.return_stmt.expression;
+    CHECK(match->kind == MTPSCRIPT_EXPR_MATCH_EXPR && match->data.match.arms->size == 3);
+    CHECK(match->data.match.scrutinee->kind == MTPSCRIPT_EXPR_FUNCTION_CALL);
+    CHECK(match->data.match.scrutinee->data.call.arguments->size == 2);
+
+    arm = mtpscript_vector_get(match->data.match.arms, 0);
+    CHECK(strcmp(mtpscript_string_cstr(arm->pattern), "\"a\"") == 0);
+    CHECK(arm->body->kind == MTPSCRIPT_EXPR_BINARY_EXPR);
+    arm = mtpscript_vector_get(match->data.match.arms, 1);
+    CHECK(strcmp(mtpscript_string_cstr(arm->pattern), "7") == 0);
+    CHECK(arm->body->kind == MTPSCRIPT_EXPR_FUNCTION_CALL);
+    arm = mtpscript_vector_get(match->data.match.arms, 2);
+    CHECK(strcmp(mtpscript_string_cstr(arm->pattern), "_") == 0);
+    CHECK(arm->body->kind == MTPSCRIPT_EXPR_MATCH_EXPR && arm->body->data.match.arms->size == 1);
+    mtpscript_arena_free(arena);
+    return 1;
+}
+
+// The lowered conditional chain selects the first matching arm, evaluates
+// the scrutinee once and throws when no arm applies
+static int test_codegen_match_run(void) {
+    char *source = codegen_read_file("tests/fixtures/match_expr.mtp");
+    mtpscript_string_t *js;
+    JSContext *ctx;
+    char buf[256];
+
+    CHECK(source);
+    js = codegen_compile(source);
+    ctx = vm_new(CODEGEN_MEM_SIZE);
+    CHECK(js && ctx);
+    CHECK(vm_eval(ctx, mtpscript_string_cstr(js), buf, sizeof(buf)) == 0);
+
+    CHECK(vm_eval_is(ctx, "[grade(1), grade(2), grade(7)].join()", "one,two,many"));
+    CHECK(vm_eval_is(ctx, "[label(true), label(false)].join()", "yes,no"));
+    CHECK(vm_eval_is(ctx, "[describe(1), describe(2)].join()", "three,two"));
+    CHECK(vm_eval_is(ctx, "[kind('a'), kind('b'), kind('c')].join()", "1,9,0"));
+    // The scrutinee is a call: evaluated once
+    CHECK(vm_eval_is(ctx, "var calls = 0, t = twice; twice = function (x) { calls++; return t(x); };"
+                          "[describe(2), calls].join()", "two,1"));
+    CHECK(vm_eval(ctx, "describe(3)", buf, sizeof(buf)) == -1 && strstr(buf, "Non-exhaustive match"));
+    CHECK(vm_eval(ctx, "label(1)", buf, sizeof(buf)) == -1);
+
+    vm_free(ctx);
+    mtpscript_string_free(js);
+    free(source);
+    return 1;
+}
+
+// I/O of the await tests: args is {id, delay}, the result {id: id}
+static void *codegen_io_prepare(JSContext *ctx, JSValue args) {
+    int *request = calloc(2, sizeof(int));
+
+    if (!request) return NULL;
+    JS_ToInt32(ctx, &request[0], JS_GetPropertyStr(ctx, args, "id"));
+    JS_ToInt32(ctx, &request[1], JS_GetPropertyStr(ctx, args, "delay"));
+    return request;
+}
+
+static char *codegen_io_perform(void *opaque, size_t *plen, char **perror) {
+    int *request = opaque;
+    char *res = malloc(32);
+
+    (void)perror;
+    usleep(request[1] * 1000);
+    if (res) *plen = snprintf(res, 32, "{\"id\":%d}", request[0]);
+    return res;
+}
+
+static const JSAsyncHandler codegen_io_handler = { codegen_io_prepare, codegen_io_perform, free };
+
+static const char *codegen_await_source =
+    "func fetch3(d: Int): String {\n"
+    "    let x = await req(1, d)\n"
+    "    let y = await req(2, d)\n"
+    "    let z = await req(sum(x, y), 0)\n"
+    "    return show(x, y, z)\n"
+    "}\n";
+
+// Consecutive awaits that do not read each other share one batch; an
+// await of their results starts a new one
+static int test_codegen_await_batch(void) {
+    static const char *effects[] = { "Async" };
+    mtpscript_string_t *js = codegen_compile(codegen_await_source);
+    JSContext *ctx = vm_new(CODEGEN_MEM_SIZE);
+    struct timeval start, end;
+    uint8_t seed[32] = {0};
+    char buf[256];
+    long elapsed_ms;
+
+    CHECK(js && ctx);
+    if (!strstr(mtpscript_string_cstr(js), "  var $aw = Async.awaitAll([[ph, 0, req(1, d)], [ph, 1, req(2, d)]]);\n"
+                                               "  var x = $aw[0];\n  var y = $aw[1];\n"
+                                               "  var z = Async.await(ph, 2, req(sum(x, y), 0));\n")) {
+        printf("\n%s", mtpscript_string_cstr(js));
+        CHECK(0);
+    }
+
+    CHECK(JS_SetDeclaredEffects(ctx, effects, 1) && JS_SetExecutionSeed(ctx, seed, sizeof(seed)));
+    CHECK(JS_RegisterAsyncHandler(ctx, "codegen_io", &codegen_io_handler));
+    CHECK(vm_eval(ctx, mtpscript_string_cstr(js), buf, sizeof(buf)) == 0);
+    CHECK(vm_eval_is(ctx, "var ph = 'codegen_io';"
+                          "function req(id, delay) { return {id: id, delay: delay}; }"
+                          "function sum(a, b) { return a.id * 10 + b.id; }"
+                          "function show(x, y, z) { return [x.id, y.id, z.id].join(); }"
+                          "0", "0"));
+    // The two 100 ms effects overlap
+    gettimeofday(&start, NULL);
+    CHECK(vm_eval_is(ctx, "fetch3(100)", "1,2,12"));
+    gettimeofday(&end, NULL);
+    elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_usec - start.tv_usec) / 1000;
+    CHECK(elapsed_ms >= 100 && elapsed_ms < 190);
+
+    cleanup_effects(ctx);
+    vm_free(ctx);
+    mtpscript_string_free(js);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript code generator tests\n");
+    RUN_TEST(test_codegen_fixture, "the fixture compiles to its expected output");
+    RUN_TEST(test_codegen_match_parse, "match arms, calls and wildcards are parsed");
+    RUN_TEST(test_codegen_match_run, "match expressions lower to a conditional chain");
+    RUN_TEST(test_codegen_await_batch, "independent awaits are batched");
+    return test_summary("codegen_test");
+}
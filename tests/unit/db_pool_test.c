@@ -0,0 +1,349 @@
+/**
+ * MTPScript database connection pool tests
+ * Specification §7 - DbRead, DbWrite Effects
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * The pool runs against an in-process stand-in driver instead of a MySQL
+ * server: connections are records which a test can break, and statements
+ * remember their SQL so that cache evictions can be checked.
+ */
+
+#include "unit_test.h"
+#include "mquickjs_db.h"
+#include <pthread.h>
+#include <time.h>
+
+#define DB_FAKE_MAX_CONNS 64
+
+typedef struct {
+    bool alive;
+} db_fake_conn_t;
+
+typedef struct {
+    char sql[64];
+} db_fake_stmt_t;
+
+// Driver state, shared with the pool threads
+static pthread_mutex_t db_fake_lock = PTHREAD_MUTEX_INITIALIZER;
+static db_fake_conn_t *db_fake_conns[DB_FAKE_MAX_CONNS];
+static int db_fake_conn_count;
+static int db_fake_connects, db_fake_closes, db_fake_pings;
+static int db_fake_prepares, db_fake_stmt_closes;
+static char db_fake_closed_sql[64];
+
+static void *db_fake_connect(const MTPScriptDBConfig *config) {
+    db_fake_conn_t *c = calloc(1, sizeof(*c));
+
+    c->alive = true;
+    pthread_mutex_lock(&db_fake_lock);
+    db_fake_conns[db_fake_conn_count++] = c;
+    db_fake_connects++;
+    pthread_mutex_unlock(&db_fake_lock);
+    return c;
+}
+
+static void db_fake_close(void *handle) {
+    pthread_mutex_lock(&db_fake_lock);
+    for (int i = 0; i < db_fake_conn_count; i++) {
+        if (db_fake_conns[i] == handle) db_fake_conns[i] = db_fake_conns[--db_fake_conn_count];
+    }
+    db_fake_closes++;
+    pthread_mutex_unlock(&db_fake_lock);
+    free(handle);
+}
+
+static int db_fake_ping(void *handle) {
+    db_fake_conn_t *c = handle;
+    int ret;
+
+    pthread_mutex_lock(&db_fake_lock);
+    db_fake_pings++;
+    ret = c->alive ? 0 : -1;
+    pthread_mutex_unlock(&db_fake_lock);
+    return ret;
+}
+
+// Statements whose SQL starts with "FAIL" do not prepare
+static void *db_fake_prepare(void *handle, const char *sql) {
+    db_fake_stmt_t *s;
+
+    if (strncmp(sql, "FAIL", 4) == 0) return NULL;
+    s = calloc(1, sizeof(*s));
+    snprintf(s->sql, sizeof(s->sql), "%s", sql);
+    pthread_mutex_lock(&db_fake_lock);
+    db_fake_prepares++;
+    pthread_mutex_unlock(&db_fake_lock);
+    return s;
+}
+
+static void db_fake_stmt_close(void *stmt) {
+    db_fake_stmt_t *s = stmt;
+
+    pthread_mutex_lock(&db_fake_lock);
+    snprintf(db_fake_closed_sql, sizeof(db_fake_closed_sql), "%s", s->sql);
+    db_fake_stmt_closes++;
+    pthread_mutex_unlock(&db_fake_lock);
+    free(s);
+}
+
+static const MTPScriptDBDriver db_fake_driver = {
+    db_fake_connect,
+    db_fake_close,
+    db_fake_ping,
+    db_fake_prepare,
+    db_fake_stmt_close,
+};
+
+static void db_fake_break_all(void) {
+    pthread_mutex_lock(&db_fake_lock);
+    for (int i = 0; i < db_fake_conn_count; i++) db_fake_conns[i]->alive = false;
+    pthread_mutex_unlock(&db_fake_lock);
+}
+
+static void db_sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000};
+    nanosleep(&ts, NULL);
+}
+
+static uint64_t db_test_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Create the process-wide pool on the stand-in driver. The health thread
+// stays idle unless 'interval_ms' is short.
+static MTPScriptDBPool *db_pool_start(int min, int max, int timeout_ms, int interval_ms, int stmt_cache_size) {
+    MTPScriptDBConfig config;
+
+    mtpscript_db_config_init(&config);
+    config.min_connections = min;
+    config.max_connections = max;
+    config.acquire_timeout_ms = timeout_ms;
+    config.health_check_interval_ms = interval_ms;
+    config.stmt_cache_size = stmt_cache_size;
+    config.driver = &db_fake_driver;
+    if (!mtpscript_db_configure(&config)) return NULL;
+    return mtpscript_db_pool_new();
+}
+
+// Wait up to one second for the health thread: the pool stats are in
+// 's' when 'cond' holds
+#define DB_WAIT_FOR(pool, s, cond) do { \
+    uint64_t until = db_test_now_ms() + 1000; \
+    for (;;) { \
+        mtpscript_db_pool_get_stats(pool, &s); \
+        if ((cond) || db_test_now_ms() > until) break; \
+        db_sleep_ms(2); \
+    } \
+    CHECK(cond); \
+} while (0)
+
+// Idle connections are reused without a connect
+static int test_db_acquire(void) {
+    MTPScriptDBPool *pool = db_pool_start(0, 2, 2000, 10000, 4);
+    MTPScriptDBPoolStats s;
+    MTPScriptDBConn *a, *b;
+    int connects = db_fake_connects, closes = db_fake_closes;
+
+    CHECK(pool);
+    a = mtpscript_db_acquire(pool);
+    CHECK(a && db_fake_connects == connects + 1);
+    mtpscript_db_release(pool, a, false);
+    b = mtpscript_db_acquire(pool);
+    CHECK(b == a && db_fake_connects == connects + 1);
+    mtpscript_db_pool_get_stats(pool, &s);
+    CHECK(s.acquires == 2 && s.connects == 1 && s.open == 1 && s.in_use == 1 && s.waits == 0);
+
+    // A broken connection is closed instead of reused
+    mtpscript_db_release(pool, b, true);
+    mtpscript_db_pool_get_stats(pool, &s);
+    CHECK(s.open == 0 && s.in_use == 0 && s.dropped == 1);
+    CHECK(db_fake_closes == closes + 1);
+
+    // The pool is detached first: a new one can be configured
+    mtpscript_db_pool_free(pool);
+    pool = db_pool_start(0, 2, 2000, 10000, 4);
+    CHECK(pool);
+    mtpscript_db_pool_free(pool);
+    return 1;
+}
+
+#define DB_FIFO_WAITERS 4
+
+static MTPScriptDBPool *db_fifo_pool;
+static int db_fifo_order[DB_FIFO_WAITERS];
+static int db_fifo_count;
+
+static void *db_fifo_thread(void *opaque) {
+    int id = (int)(intptr_t)opaque;
+    MTPScriptDBConn *conn = mtpscript_db_acquire(db_fifo_pool);
+
+    pthread_mutex_lock(&db_fake_lock);
+    db_fifo_order[db_fifo_count++] = conn ? id : -1;
+    pthread_mutex_unlock(&db_fake_lock);
+    db_sleep_ms(1);
+    mtpscript_db_release(db_fifo_pool, conn, false);
+    return NULL;
+}
+
+// Callers blocked on a full pool get the connection in arrival order
+static int test_db_fifo(void) {
+    MTPScriptDBPool *pool = db_pool_start(0, 1, 2000, 10000, 4);
+    pthread_t threads[DB_FIFO_WAITERS];
+    MTPScriptDBPoolStats s;
+    MTPScriptDBConn *conn;
+
+    CHECK(pool);
+    db_fifo_pool = pool;
+    db_fifo_count = 0;
+    conn = mtpscript_db_acquire(pool);
+    CHECK(conn);
+    for (int i = 0; i < DB_FIFO_WAITERS; i++) {
+        pthread_create(&threads[i], NULL, db_fifo_thread, (void *)(intptr_t)i);
+        // Queue the threads one by one
+        DB_WAIT_FOR(pool, s, s.waiting == i + 1);
+    }
+    mtpscript_db_release(pool, conn, false);
+    for (int i = 0; i < DB_FIFO_WAITERS; i++) pthread_join(threads[i], NULL);
+
+    for (int i = 0; i < DB_FIFO_WAITERS; i++) CHECK(db_fifo_order[i] == i);
+    mtpscript_db_pool_get_stats(pool, &s);
+    CHECK(s.waits == DB_FIFO_WAITERS && s.connects == 1 && s.waiting == 0 && s.in_use == 0);
+    mtpscript_db_pool_free(pool);
+    return 1;
+}
+
+// A waiter gives up after the acquire timeout
+static int test_db_timeout(void) {
+    MTPScriptDBPool *pool = db_pool_start(0, 1, 50, 10000, 4);
+    MTPScriptDBPoolStats s;
+    MTPScriptDBConn *conn;
+    uint64_t start;
+
+    CHECK(pool);
+    conn = mtpscript_db_acquire(pool);
+    CHECK(conn);
+    start = db_test_now_ms();
+    CHECK(mtpscript_db_acquire(pool) == NULL);
+    CHECK(db_test_now_ms() - start >= 45);
+    mtpscript_db_pool_get_stats(pool, &s);
+    CHECK(s.timeouts == 1 && s.waiting == 0 && s.in_use == 1);
+
+    mtpscript_db_release(pool, conn, false);
+    conn = mtpscript_db_acquire(pool);
+    CHECK(conn);
+    mtpscript_db_release(pool, conn, false);
+    mtpscript_db_pool_free(pool);
+    return 1;
+}
+
+static MTPScriptDBPool *db_retry_pool;
+static MTPScriptDBConn *db_retry_conn;
+static volatile int db_retry_done;
+
+static void *db_retry_thread(void *opaque) {
+    db_retry_conn = mtpscript_db_acquire(db_retry_pool);
+    while (!db_retry_done) db_sleep_ms(1);
+    mtpscript_db_release(db_retry_pool, db_retry_conn, false);
+    return NULL;
+}
+
+// The slot of a dropped connection goes to the first waiter, even if
+// another caller comes before the waiter runs
+static int test_db_retry(void) {
+    MTPScriptDBPool *pool = db_pool_start(0, 1, 100, 10000, 4);
+    MTPScriptDBPoolStats s;
+    MTPScriptDBConn *conn;
+    pthread_t thread;
+
+    CHECK(pool);
+    db_retry_pool = pool;
+    db_retry_conn = NULL;
+    db_retry_done = 0;
+    conn = mtpscript_db_acquire(pool);
+    CHECK(conn);
+    pthread_create(&thread, NULL, db_retry_thread, NULL);
+    DB_WAIT_FOR(pool, s, s.waiting == 1);
+
+    mtpscript_db_release(pool, conn, true);
+    CHECK(mtpscript_db_acquire(pool) == NULL);
+    db_retry_done = 1;
+    pthread_join(thread, NULL);
+    CHECK(db_retry_conn != NULL);
+    mtpscript_db_pool_get_stats(pool, &s);
+    CHECK(s.connects == 2 && s.timeouts == 1 && s.open == 1 && s.in_use == 0);
+    mtpscript_db_pool_free(pool);
+    return 1;
+}
+
+// The health thread keeps min_connections open, and replaces the idle
+// connections which fail a ping
+static int test_db_health(void) {
+    MTPScriptDBPool *pool = db_pool_start(2, 4, 2000, 20, 4);
+    MTPScriptDBPoolStats s;
+
+    CHECK(pool);
+    DB_WAIT_FOR(pool, s, s.open == 2);
+    CHECK(s.connects == 2 && s.in_use == 0);
+    DB_WAIT_FOR(pool, s, s.pings >= 2);
+    CHECK(s.dropped == 0);
+
+    db_fake_break_all();
+    DB_WAIT_FOR(pool, s, s.dropped == 2);
+    DB_WAIT_FOR(pool, s, s.open == 2 && s.connects == 4);
+    mtpscript_db_pool_free(pool);
+    return 1;
+}
+
+// Each connection caches its prepared statements, and closes the least
+// recently used one when the cache is full
+static int test_db_stmt_cache(void) {
+    MTPScriptDBPool *pool = db_pool_start(0, 2, 2000, 10000, 2);
+    MTPScriptDBPoolStats s;
+    MTPScriptDBConn *conn;
+    MYSQL_STMT *a, *b, *c;
+    int prepares = db_fake_prepares, stmt_closes = db_fake_stmt_closes;
+
+    CHECK(pool);
+    conn = mtpscript_db_acquire(pool);
+    CHECK(conn);
+    a = mtpscript_db_prepare(pool, conn, "SELECT a");
+    b = mtpscript_db_prepare(pool, conn, "SELECT b");
+    CHECK(a && b && a != b);
+    CHECK(mtpscript_db_prepare(pool, conn, "SELECT a") == a);
+    CHECK(db_fake_prepares == prepares + 2);
+
+    // "SELECT b" is the least recently used
+    c = mtpscript_db_prepare(pool, conn, "SELECT c");
+    CHECK(c && db_fake_stmt_closes == stmt_closes + 1);
+    CHECK(strcmp(db_fake_closed_sql, "SELECT b") == 0);
+    CHECK(mtpscript_db_prepare(pool, conn, "SELECT c") == c);
+    CHECK(mtpscript_db_prepare(pool, conn, "SELECT b") != NULL);
+    CHECK(strcmp(db_fake_closed_sql, "SELECT a") == 0);
+
+    // A failed prepare leaves the cache alone
+    CHECK(mtpscript_db_prepare(pool, conn, "FAIL") == NULL);
+    CHECK(mtpscript_db_prepare(pool, conn, "SELECT c") == c);
+    mtpscript_db_pool_get_stats(pool, &s);
+    CHECK(s.stmt_hits == 3 && s.stmt_misses == 5);
+
+    // The statements are closed with their connection
+    mtpscript_db_release(pool, conn, true);
+    CHECK(db_fake_stmt_closes == stmt_closes + 4);
+    mtpscript_db_pool_free(pool);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript database connection pool tests\n");
+    RUN_TEST(test_db_acquire, "idle connections are reused");
+    RUN_TEST(test_db_fifo, "waiters are served in FIFO order");
+    RUN_TEST(test_db_timeout, "acquire times out on a full pool");
+    RUN_TEST(test_db_retry, "a freed slot is reserved for the first waiter");
+    RUN_TEST(test_db_health, "the health thread replaces broken connections");
+    RUN_TEST(test_db_stmt_cache, "prepared statement LRU cache");
+    return test_summary("db_pool_test");
+}
@@ -0,0 +1,56 @@
+/**
+ * MTPScript Decimal tests
+ * Specification §23 - Decimal canonical form
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * A Decimal has one textual form, the shortest canonical one: its scale
+ * is never visible, whatever the conversion path.
+ */
+
+#include "unit_vm.h"
+
+static int test_decimal_arith(void) {
+    JSContext *ctx = vm_new(256 * 1024);
+    bool ok;
+
+    CHECK(ctx);
+    ok = vm_eval_is(ctx, "new Decimal('0.1').add(new Decimal('0.2')).toString()", "0.3") &&
+         vm_eval_is(ctx, "new Decimal('1.25').mul(new Decimal('4')).toString()", "5") &&
+         vm_eval_is(ctx, "new Decimal('10').div(new Decimal('4')).toString()", "2.5") &&
+         vm_eval_is(ctx, "new Decimal('2.5').quantize(0).toString()", "2") &&
+         vm_eval_is(ctx, "new Decimal('1.10').compare(new Decimal('1.1'))", "0");
+    vm_free(ctx);
+    CHECK(ok);
+    return 1;
+}
+
+// toString(), String(), join() and JSON agree on values with
+// trailing fractional zeros
+static int test_decimal_string_paths(void) {
+    static const char *values[] = { "1.50", "2.000", "0.10", "-3.4500", "100" };
+    static const char *expected[] = { "1.5", "2", "0.1", "-3.45", "100" };
+    JSContext *ctx = vm_new(256 * 1024);
+    char code[256], json[64];
+    bool ok = ctx != NULL;
+
+    for (int i = 0; ok && i < 5; i++) {
+        snprintf(code, sizeof(code), "var d = new Decimal('%s'); d.toString()", values[i]);
+        ok = vm_eval_is(ctx, code, expected[i]) &&
+             vm_eval_is(ctx, "String(d)", expected[i]) &&
+             vm_eval_is(ctx, "[d.quantize(4)].join()", expected[i]);
+        snprintf(json, sizeof(json), "[\"%s\"]", expected[i]);
+        ok = ok && vm_eval_is(ctx, "JSON.stringify([d])", json);
+    }
+    if (ctx) vm_free(ctx);
+    CHECK(ok);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript Decimal tests\n");
+    RUN_TEST(test_decimal_arith, "arithmetic results are canonical");
+    RUN_TEST(test_decimal_string_paths, "every string conversion is canonical");
+    return test_summary("decimal_test");
+}
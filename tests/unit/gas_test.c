@@ -0,0 +1,122 @@
+/**
+ * MTPScript gas metering tests
+ * Specification §5.3 - Runtime gas limit
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * OP_gas charges a basic block on entry. The result must be the same as
+ * charging each opcode before running it: gasUsed does not depend on the
+ * limit, and the opcodes after one that throws are not billed.
+ */
+
+#include "unit_vm.h"
+
+#define GAS_MEM_SIZE (256 * 1024)
+
+typedef struct {
+    bool exception;
+    bool gas_exhausted;
+    uint64_t gas_used;
+    char result[256];
+} gas_run_t;
+
+static bool gas_run(const char *code, uint64_t limit, gas_run_t *r) {
+    JSContext *ctx = vm_new(GAS_MEM_SIZE);
+
+    if (!ctx) return false;
+    JS_SetGasLimit(ctx, limit);
+    r->exception = vm_eval(ctx, code, r->result, sizeof(r->result)) != 0;
+    r->gas_exhausted = r->exception && strstr(r->result, "GasExhausted") != NULL;
+    r->gas_used = JS_GetGasUsed(ctx);
+    vm_free(ctx);
+    return true;
+}
+
+static const char *gas_programs[] = {
+    "function fib(n) { if (n < 2) return n; return fib(n - 1) + fib(n - 2); } fib(8)",
+    "var o = {x: 1, y: [1, 2, 3]}; function f(a, k) { if (k >= a.length) return 0; return (a[k] > 1 ? a[k] : -1) + f(a, k + 1); } f(o.y, 0) + o.x",
+    "JSON.stringify([1, 2, 3].map(function (x) { return x * x; }))",
+};
+
+// gasUsed is the same whether the blocks are charged at once or, close
+// to the limit, one opcode at a time
+static int test_gas_limit_independent(void) {
+    gas_run_t full, r;
+
+    for (size_t i = 0; i < sizeof(gas_programs) / sizeof(gas_programs[0]); i++) {
+        CHECK(gas_run(gas_programs[i], 1000000, &full));
+        CHECK(!full.exception);
+        CHECK(gas_run(gas_programs[i], full.gas_used, &r));
+        CHECK(!r.exception && r.gas_used == full.gas_used);
+        CHECK(strcmp(r.result, full.result) == 0);
+    }
+    return 1;
+}
+
+// Below some limit the program always runs out of gas, above it always
+// completes
+static int test_gas_exhaustion_threshold(void) {
+    gas_run_t full, r;
+    bool completed = false;
+
+    CHECK(gas_run(gas_programs[0], 1000000, &full));
+    for (uint64_t limit = 1; limit <= full.gas_used; limit++) {
+        CHECK(gas_run(gas_programs[0], limit, &r));
+        if (r.exception) {
+            CHECK(r.gas_exhausted && !completed);
+            CHECK(r.gas_used >= limit && r.gas_used < full.gas_used);
+        } else {
+            CHECK(r.gas_used == full.gas_used);
+            completed = true;
+        }
+    }
+    CHECK(completed);
+    return 1;
+}
+
+// The statements after a throwing field access are in the same block:
+// they must not change gasUsed
+static int test_gas_throwing_handler(void) {
+    static const char *short_handler =
+        "function handler(req) { var a = req.body.name; return a; } handler({})";
+    static const char *long_handler =
+        "function handler(req) { var a = req.body.name; var b = [a, a + 1, a * 2]; var c = {b: b, n: b.length}; return c.n + c.b[0]; } handler({})";
+    gas_run_t s, l, r;
+
+    CHECK(gas_run(short_handler, 1000000, &s));
+    CHECK(gas_run(long_handler, 1000000, &l));
+    CHECK(s.exception && !s.gas_exhausted);
+    CHECK(l.exception && !l.gas_exhausted);
+    CHECK(s.gas_used == l.gas_used);
+
+    // The same charge when the block goes through the slow path
+    CHECK(gas_run(long_handler, l.gas_used, &r));
+    CHECK(r.exception && !r.gas_exhausted && r.gas_used == l.gas_used);
+    CHECK(strcmp(r.result, l.result) == 0);
+    return 1;
+}
+
+// A callee that throws: the rest of the calling block is not billed
+static int test_gas_throwing_callee(void) {
+    static const char *short_caller =
+        "function check(x) { return x.y.z; } function handler() { var v = check({}); return v; } handler()";
+    static const char *long_caller =
+        "function check(x) { return x.y.z; } function handler() { var v = check({}); var w = v + 1; return [v, w].length; } handler()";
+    gas_run_t s, l;
+
+    CHECK(gas_run(short_caller, 1000000, &s));
+    CHECK(gas_run(long_caller, 1000000, &l));
+    CHECK(s.exception && l.exception && !l.gas_exhausted);
+    CHECK(s.gas_used == l.gas_used);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript gas metering tests\n");
+    RUN_TEST(test_gas_limit_independent, "gasUsed does not depend on the limit");
+    RUN_TEST(test_gas_exhaustion_threshold, "gas exhaustion threshold is monotonic");
+    RUN_TEST(test_gas_throwing_handler, "opcodes after a throwing one are not billed");
+    RUN_TEST(test_gas_throwing_callee, "a throwing callee leaves the caller charge unchanged");
+    return test_summary("gas_test");
+}
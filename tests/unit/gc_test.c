@@ -0,0 +1,225 @@
+/**
+ * MTPScript garbage collector tests
+ * Specification §5.2 - Snapshots
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * The clone of a snapshot context freezes the blocks it inherits: a GC
+ * neither moves nor frees them, and their references to younger blocks
+ * keep these alive. The heap limits bound the young blocks: a GC runs
+ * before the soft limit is exceeded, and an allocation fails with an
+ * exception only if the hard budget is exceeded after a GC.
+ */
+
+#include "unit_vm.h"
+
+#define GC_TEMPLATE_MEM_SIZE (4 * 1024 * 1024)
+#define GC_CLONE_MEM_SIZE (1024 * 1024)
+#define GC_SOFT_LIMIT (64 * 1024)
+#define GC_BUDGET (256 * 1024)
+
+static const char *gc_setup =
+    "var table = [];\n"
+    "function fill(i) { if (i == 0) return; table.push({id: i, v: [i, i * 2]}); fill(i - 1); }\n"
+    "function fill2(k) { if (k == 0) return; fill(1000); fill2(k - 1); }\n"
+    "fill2(3);\n"
+    "var cache = {}, keys = [];\n";
+
+// Old objects get references to young ones and new property keys, with
+// enough garbage in between to run several GCs
+static const char *gc_work =
+    "function step(n, acc) {\n"
+    "  if (n == 0) return acc;\n"
+    "  var o = {a: n, b: [n, n + 1, n + 2], c: String.fromCharCode(65 + n % 26, 66 + n % 17, 67 + n % 5)};\n"
+    "  table[n % 3000].ref = o;\n"
+    "  cache[o.c] = o;\n"
+    "  if (n % 97 == 0) keys.push(o.c);\n"
+    "  return step(n - 1, acc + o.b[2] + table[(n * 7) % 3000].v[1]);\n"
+    "}\n"
+    "function loop(k, acc) { if (k == 0) return acc; if (k % 10 == 0) gc(); return loop(k - 1, acc + step(500, 0)); }\n"
+    "function sumref(i, acc) { if (i == 3000) return acc; var r = table[i].ref; return sumref(i + 1, acc + (r ? r.a : 0)); }\n"
+    "function sumkeys(i, acc) { if (i == keys.length) return acc; return sumkeys(i + 1, acc + cache[keys[i]].b[0]); }\n"
+    "var total = loop(40, 0);\n"
+    "[total, sumref(0, 0), sumkeys(0, 0), Object.keys(cache).length, table[5].v[1]].join(',')";
+
+// Template context with the setup program run
+static JSContext *gc_template(void) {
+    JSContext *ctx = vm_new(GC_TEMPLATE_MEM_SIZE);
+    char buf[256];
+
+    if (ctx && vm_eval(ctx, gc_setup, buf, sizeof(buf)) != 0) {
+        vm_free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+// Run the workload in a clone of 'tmpl', frozen or not, and store its
+// result in 'buf'. Return the number of GCs, -1 on error.
+static int gc_run_clone(JSContext *tmpl, bool freeze, char *buf, size_t buf_size) {
+    uint8_t *mem = malloc(GC_CLONE_MEM_SIZE);
+    JSContext *ctx = mem ? JS_CloneContext(tmpl, mem, GC_CLONE_MEM_SIZE) : NULL;
+    JSMemoryUsage usage;
+    int ret = -1;
+
+    if (ctx) {
+        JS_SetLogFunc(ctx, vm_log_func);
+        if (freeze) JS_FreezeHeap(ctx);
+        if (vm_eval(ctx, gc_work, buf, buf_size) == 0) {
+            JS_GetMemoryUsage(ctx, &usage);
+            ret = usage.gc_count;
+        }
+        JS_FreeContext(ctx);
+    }
+    free(mem);
+    return ret;
+}
+
+// A frozen clone computes the same results as a plain one
+static int test_gc_frozen_results(void) {
+    JSContext *tmpl = gc_template();
+    char buf[256], frozen_buf[256];
+    int gc_count, frozen_gc_count;
+
+    CHECK(tmpl);
+    gc_count = gc_run_clone(tmpl, false, buf, sizeof(buf));
+    frozen_gc_count = gc_run_clone(tmpl, true, frozen_buf, sizeof(frozen_buf));
+    if (gc_count < 0 || frozen_gc_count < 0 || strcmp(buf, frozen_buf) != 0) {
+        printf("\n        %s, frozen %s ", buf, frozen_buf);
+        CHECK(0);
+    }
+    CHECK(gc_count > 4 && frozen_gc_count > 4);
+    vm_free(tmpl);
+    return 1;
+}
+
+// Frozen blocks stay in place and are not freed, even when unreachable
+static int test_gc_frozen_blocks(void) {
+    JSContext *tmpl = gc_template();
+    uint8_t *mem = malloc(GC_CLONE_MEM_SIZE), *plain_mem = malloc(GC_CLONE_MEM_SIZE);
+    JSContext *ctx, *plain;
+    JSMemoryUsage frozen_usage, usage;
+    JSValue global, table;
+
+    CHECK(tmpl && mem && plain_mem);
+    ctx = JS_CloneContext(tmpl, mem, GC_CLONE_MEM_SIZE);
+    plain = JS_CloneContext(tmpl, plain_mem, GC_CLONE_MEM_SIZE);
+    CHECK(ctx && plain);
+    JS_FreezeHeap(ctx);
+    JS_GetMemoryUsage(ctx, &frozen_usage);
+    global = JS_GetGlobalObject(ctx);
+    table = JS_GetPropertyStr(ctx, global, "table");
+
+    CHECK(vm_eval_is(ctx, "table[0].ref = {young: [1, 2, 3]}; gc(); table[0].ref.young[2]", "3"));
+    CHECK(JS_GetPropertyStr(ctx, global, "table") == table);
+    CHECK(vm_eval_is(ctx, "table = null; cache = null; gc(); 1", "1"));
+    CHECK(vm_eval_is(plain, "table = null; cache = null; gc(); 1", "1"));
+    JS_GetMemoryUsage(ctx, &usage);
+    CHECK(usage.heap_size >= frozen_usage.heap_size);
+    JS_GetMemoryUsage(plain, &usage);
+    CHECK(usage.heap_size < frozen_usage.heap_size);
+
+    JS_FreeContext(plain);
+    JS_FreeContext(ctx);
+    free(plain_mem);
+    free(mem);
+    vm_free(tmpl);
+    return 1;
+}
+
+// Garbage, and 'n' arrays kept alive in 'kept'
+static const char *gc_garbage =
+    "function garbage(n, acc) { if (n == 0) return acc; var o = {a: n, b: [n, n + 1, n + 2]}; return garbage(n - 1, acc + o.b[2]); }\n"
+    "function churn(k, acc) { if (k == 0) return acc; return churn(k - 1, acc + garbage(200, 0)); }\n"
+    "function keep(n, a) { if (n == 0) return a; a.push([n, n, n, n]); return keep(n - 1, a); }\n"
+    "0";
+
+// Frozen clone of an empty template with the given heap limits. The
+// template is returned in 'ptmpl' and the frozen size in 'pfrozen'.
+static JSContext *gc_limited_clone(uint8_t *mem, size_t initial_size, size_t max_size,
+                                   JSContext **ptmpl, size_t *pfrozen) {
+    JSContext *tmpl = vm_new(GC_TEMPLATE_MEM_SIZE), *ctx;
+    JSMemoryUsage usage;
+    char buf[64];
+
+    *ptmpl = tmpl;
+    if (!tmpl || vm_eval(tmpl, gc_garbage, buf, sizeof(buf)) != 0) return NULL;
+    ctx = JS_CloneContext(tmpl, mem, GC_TEMPLATE_MEM_SIZE);
+    if (!ctx) return NULL;
+    JS_SetLogFunc(ctx, vm_log_func);
+    JS_FreezeHeap(ctx);
+    JS_GetMemoryUsage(ctx, &usage);
+    *pfrozen = usage.heap_size;
+    JS_SetHeapLimit(ctx, initial_size, max_size ? *pfrozen + max_size : 0);
+    return ctx;
+}
+
+// The soft limit runs the GC early, and grows with the live blocks
+static int test_gc_soft_limit(void) {
+    uint8_t *mem = malloc(GC_TEMPLATE_MEM_SIZE);
+    JSContext *tmpl, *ctx;
+    JSMemoryUsage usage;
+    size_t frozen;
+
+    CHECK(mem);
+    ctx = gc_limited_clone(mem, GC_SOFT_LIMIT, 0, &tmpl, &frozen);
+    CHECK(ctx);
+    CHECK(vm_eval_is(ctx, "churn(100, 0)", "2050000"));
+    JS_GetMemoryUsage(ctx, &usage);
+    CHECK(usage.gc_count > 10 && usage.heap_limit == GC_SOFT_LIMIT);
+    CHECK(usage.heap_peak <= frozen + GC_SOFT_LIMIT);
+
+    CHECK(vm_eval_is(ctx, "var kept = keep(2200, []); churn(20, 0) + kept.length", "412200"));
+    JS_GetMemoryUsage(ctx, &usage);
+    CHECK(usage.heap_limit > GC_SOFT_LIMIT);
+    JS_FreeContext(ctx);
+    free(mem);
+    vm_free(tmpl);
+    return 1;
+}
+
+// Garbage never exceeds the hard budget: live blocks do, and throw
+static int test_gc_hard_budget(void) {
+    uint8_t *mem = malloc(GC_TEMPLATE_MEM_SIZE);
+    JSContext *tmpl, *ctx;
+    JSMemoryUsage usage;
+    size_t frozen;
+    char buf[256];
+
+    CHECK(mem);
+    // No soft limit: only the budget triggers the GC
+    ctx = gc_limited_clone(mem, 0, GC_BUDGET, &tmpl, &frozen);
+    CHECK(ctx);
+    CHECK(vm_eval_is(ctx, "churn(100, 0)", "2050000"));
+    JS_GetMemoryUsage(ctx, &usage);
+    CHECK(usage.gc_count > 0 && usage.heap_peak <= frozen + GC_BUDGET);
+
+    CHECK(vm_eval(ctx, "var kept = keep(100000, []); kept.length", buf, sizeof(buf)) == -1);
+    CHECK(strstr(buf, "out of memory"));
+    // The context is still usable once the live blocks are dropped
+    CHECK(vm_eval_is(ctx, "kept = null; churn(10, 0)", "205000"));
+    JS_FreeContext(ctx);
+
+    // The soft limit grows up to the budget
+    ctx = JS_CloneContext(tmpl, mem, GC_TEMPLATE_MEM_SIZE);
+    CHECK(ctx);
+    JS_FreezeHeap(ctx);
+    JS_SetHeapLimit(ctx, GC_SOFT_LIMIT, frozen + GC_BUDGET);
+    CHECK(vm_eval_is(ctx, "var kept = keep(2200, []); churn(20, 0) + kept.length", "412200"));
+    JS_GetMemoryUsage(ctx, &usage);
+    CHECK(usage.heap_limit > GC_SOFT_LIMIT && usage.heap_limit <= GC_BUDGET);
+    JS_FreeContext(ctx);
+    free(mem);
+    vm_free(tmpl);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript garbage collector tests\n");
+    RUN_TEST(test_gc_frozen_results, "a frozen clone computes the same results");
+    RUN_TEST(test_gc_frozen_blocks, "frozen blocks are neither moved nor freed");
+    RUN_TEST(test_gc_soft_limit, "the soft limit runs the GC early");
+    RUN_TEST(test_gc_hard_budget, "the hard budget throws after a GC");
+    return test_summary("gc_test");
+}
@@ -0,0 +1,186 @@
+/**
+ * MTPScript compiler hash table tests
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * mtpscript_hash_t is an insertion-ordered table with a linear-probing
+ * index and backward shift deletion.
+ */
+
+#include "unit_test.h"
+#include "src/compiler/mtpscript.h"
+
+#define HASH_KEYS 2000
+
+static void hash_key_name(char *buf, size_t size, int i) {
+    snprintf(buf, size, "sym_%d", i);
+}
+
+// Value of key i: any distinct non NULL pointer
+static void *hash_key_value(int i) {
+    return (void *)(uintptr_t)(i + 1);
+}
+
+static int test_hash_set_get(void) {
+    mtpscript_hash_t *hash = mtpscript_hash_new();
+    char key[32];
+
+    for (int i = 0; i < HASH_KEYS; i++) {
+        hash_key_name(key, sizeof(key), i);
+        mtpscript_hash_set(hash, key, hash_key_value(i));
+    }
+    CHECK(hash->size == HASH_KEYS);
+    for (int i = 0; i < HASH_KEYS; i++) {
+        hash_key_name(key, sizeof(key), i);
+        CHECK(mtpscript_hash_get(hash, key) == hash_key_value(i));
+    }
+    CHECK(!mtpscript_hash_has(hash, "sym_-1") && mtpscript_hash_get(hash, "missing") == NULL);
+
+    // Replacing a value keeps one entry
+    mtpscript_hash_set(hash, "sym_7", hash_key_value(-2));
+    CHECK(hash->size == HASH_KEYS && mtpscript_hash_get(hash, "sym_7") == hash_key_value(-2));
+
+    // Keys are copied
+    strcpy(key, "temp");
+    mtpscript_hash_set(hash, key, hash_key_value(0));
+    strcpy(key, "XXXX");
+    CHECK(mtpscript_hash_has(hash, "temp") && !mtpscript_hash_has(hash, "XXXX"));
+    mtpscript_hash_free(hash);
+    return 1;
+}
+
+// Removing every other key must keep the keys probed past a removed one
+// reachable: the index has no tombstones
+static int test_hash_remove(void) {
+    mtpscript_hash_t *hash = mtpscript_hash_new();
+    char key[32];
+
+    for (int i = 0; i < HASH_KEYS; i++) {
+        hash_key_name(key, sizeof(key), i);
+        mtpscript_hash_set(hash, key, hash_key_value(i));
+    }
+    for (int i = 0; i < HASH_KEYS; i += 2) {
+        hash_key_name(key, sizeof(key), i);
+        CHECK(mtpscript_hash_remove(hash, key));
+        CHECK(!mtpscript_hash_remove(hash, key));
+    }
+    CHECK(hash->size == HASH_KEYS / 2);
+    for (int i = 0; i < HASH_KEYS; i++) {
+        hash_key_name(key, sizeof(key), i);
+        CHECK(mtpscript_hash_has(hash, key) == (i % 2 == 1));
+        CHECK(mtpscript_hash_get(hash, key) == (i % 2 ? hash_key_value(i) : NULL));
+    }
+
+    // No index slot is left behind: every used slot holds a live entry
+    size_t used = 0;
+    for (size_t i = 0; i <= hash->index_mask; i++) {
+        if (hash->index[i] != 0) {
+            CHECK(hash->entries[hash->index[i] - 1].key != NULL);
+            used++;
+        }
+    }
+    CHECK(used == hash->size);
+    mtpscript_hash_free(hash);
+    return 1;
+}
+
+// Iteration follows the insertion order, across removals, re-insertions
+// and the compaction of removed entries
+static int test_hash_iteration_order(void) {
+    mtpscript_hash_t *hash = mtpscript_hash_new();
+    mtpscript_hash_iterator_t *iter;
+    static int order[1000];
+    int order_len = 0, n = 0;
+    char key[32];
+
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 20; i++) {
+            hash_key_name(key, sizeof(key), round * 20 + i);
+            mtpscript_hash_set(hash, key, hash_key_value(round * 20 + i));
+        }
+        // Only the last five keys of each round remain
+        for (int i = 0; i < 15; i++) {
+            hash_key_name(key, sizeof(key), round * 20 + i);
+            CHECK(mtpscript_hash_remove(hash, key));
+        }
+        for (int i = 15; i < 20; i++) order[order_len++] = round * 20 + i;
+    }
+    // Set after removal: the key moves to the end
+    CHECK(mtpscript_hash_remove(hash, "sym_19"));
+    mtpscript_hash_set(hash, "sym_19", hash_key_value(19));
+    memmove(&order[4], &order[5], sizeof(int) * (order_len - 5));
+    order[order_len - 1] = 19;
+    CHECK(hash->size == (size_t)order_len);
+
+    iter = mtpscript_hash_iterator_new(hash);
+    CHECK(mtpscript_hash_iterator_key(iter) == NULL && mtpscript_hash_iterator_value(iter) == NULL);
+    while (mtpscript_hash_iterator_next(iter)) {
+        CHECK(n < order_len);
+        hash_key_name(key, sizeof(key), order[n]);
+        CHECK(strcmp(mtpscript_hash_iterator_key(iter), key) == 0);
+        CHECK(mtpscript_hash_iterator_value(iter) == hash_key_value(order[n]));
+        n++;
+    }
+    mtpscript_hash_iterator_free(iter);
+    CHECK(n == order_len);
+    mtpscript_hash_free(hash);
+    return 1;
+}
+
+// Only next() moves the iterator: the key and the value of an entry can
+// be read in any order, any number of times, or not at all
+static int test_hash_iterator_accessors(void) {
+    mtpscript_hash_t *hash = mtpscript_hash_new();
+    mtpscript_hash_iterator_t *iter;
+    char key[32];
+    int n = 0;
+
+    for (int i = 0; i < 100; i++) {
+        hash_key_name(key, sizeof(key), i);
+        mtpscript_hash_set(hash, key, hash_key_value(i));
+    }
+    CHECK(mtpscript_hash_remove(hash, "sym_0") && mtpscript_hash_remove(hash, "sym_50"));
+
+    // Keys only
+    iter = mtpscript_hash_iterator_new(hash);
+    while (mtpscript_hash_iterator_next(iter)) {
+        CHECK(mtpscript_hash_iterator_key(iter) != NULL);
+        n++;
+    }
+    mtpscript_hash_iterator_free(iter);
+    CHECK(n == 98);
+
+    // Values before keys, each read twice
+    n = 0;
+    iter = mtpscript_hash_iterator_new(hash);
+    while (mtpscript_hash_iterator_next(iter)) {
+        void *value = mtpscript_hash_iterator_value(iter);
+        const char *k = mtpscript_hash_iterator_key(iter);
+        CHECK(mtpscript_hash_iterator_value(iter) == value && mtpscript_hash_iterator_key(iter) == k);
+        CHECK(mtpscript_hash_get(hash, k) == value);
+        n++;
+    }
+    // The end is sticky
+    CHECK(!mtpscript_hash_iterator_next(iter));
+    mtpscript_hash_iterator_free(iter);
+    CHECK(n == 98);
+
+    // Nothing to visit
+    mtpscript_hash_free(hash);
+    hash = mtpscript_hash_new();
+    iter = mtpscript_hash_iterator_new(hash);
+    CHECK(!mtpscript_hash_iterator_next(iter) && mtpscript_hash_iterator_key(iter) == NULL);
+    mtpscript_hash_iterator_free(iter);
+    mtpscript_hash_free(hash);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript compiler hash table tests\n");
+    RUN_TEST(test_hash_set_get, "set, get and replace");
+    RUN_TEST(test_hash_remove, "backward shift deletion keeps keys reachable");
+    RUN_TEST(test_hash_iteration_order, "iteration follows the insertion order");
+    RUN_TEST(test_hash_iterator_accessors, "only next() moves the iterator");
+    return test_summary("hash_test");
+}
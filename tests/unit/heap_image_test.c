@@ -0,0 +1,140 @@
+/**
+ * MTPScript heap image tests
+ * Specification §5.2 - Snapshots
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * A heap image is the context of a program saved after its static
+ * initialization. Loading it restores the globals without running any
+ * code.
+ */
+
+#include "unit_vm.h"
+
+#define IMAGE_MEM_SIZE (1024 * 1024)
+
+static const char *image_program =
+    "var table = {};\n"
+    "function fill(i) { if (i < 200) { table[String(i)] = {n: i, s: String(i * 7)}; fill(i + 1); } }\n"
+    "fill(0);\n"
+    "var arr = [1, 2.5, 'x', [3, 4], {deep: {x: 1}}];\n"
+    "var re = /a(b+)c/;\n"
+    "function mk(base) { var c = base; return function (x) { c = c + 1; return x * 2 + c; }; }\n"
+    "var counter = mk(10);\n"
+    "var inits = 1;\n"
+    "function handler(k) { return JSON.stringify({v: table[k], a: arr, m: re.exec('xabbbc')[1], c: counter(5), len: Object.keys(table).length}); }\n";
+
+static const char *image_call = "[handler('42'), handler('199'), inits].join(' ')";
+
+// Run the program in a context of 'mem_size' bytes and save its heap
+// image. 'result' receives the result of image_call after the save.
+static uint8_t *image_build(size_t mem_size, size_t *plen, char *result, size_t result_size) {
+    JSContext *ctx = vm_new(mem_size);
+    uint8_t *image = NULL;
+    JSValue val;
+
+    if (!ctx) return NULL;
+    val = JS_Eval(ctx, image_program, strlen(image_program), "app.js", 0);
+    if (JS_IsException(val) || JS_SaveHeapImage(ctx, &js_stdlib, &image, plen)) {
+        vm_free(ctx);
+        return NULL;
+    }
+    if (result && vm_eval(ctx, image_call, result, result_size) != 0) {
+        free(image);
+        image = NULL;
+    }
+    vm_free(ctx);
+    return image;
+}
+
+// The image does not depend on the addresses or size of the memory the
+// program ran in
+static int test_heap_image_deterministic(void) {
+    size_t len1, len2;
+    void *pad = malloc(12345);
+    uint8_t *image1 = image_build(IMAGE_MEM_SIZE, &len1, NULL, 0);
+    uint8_t *image2 = image_build(IMAGE_MEM_SIZE * 2, &len2, NULL, 0);
+
+    CHECK(image1 && image2);
+    CHECK(JS_IsHeapImage(image1, len1) && !JS_IsHeapImage(image1, sizeof(JSHeapImageHeader) - 1));
+    CHECK(len1 == len2 && memcmp(image1, image2, len1) == 0);
+    free(image1);
+    free(image2);
+    free(pad);
+    return 1;
+}
+
+// A loaded image behaves like the context it was saved from, and so do
+// its clones, across a GC
+static int test_heap_image_load(void) {
+    char expected[512], buf[512], clone_buf[512];
+    uint8_t *mem = malloc(IMAGE_MEM_SIZE), *clone_mem = malloc(IMAGE_MEM_SIZE);
+    JSContext *ctx, *clone;
+    uint8_t *image;
+    size_t len;
+
+    image = image_build(IMAGE_MEM_SIZE, &len, expected, sizeof(expected));
+    CHECK(image && mem && clone_mem);
+    // The closure state was saved before the calls, and the program ran
+    // once
+    CHECK(strstr(expected, "\"c\":21") && strstr(expected, "\"c\":22") &&
+          strcmp(expected + strlen(expected) - 2, " 1") == 0);
+
+    ctx = JS_LoadHeapImage(mem, IMAGE_MEM_SIZE, &js_stdlib, image, len);
+    CHECK(ctx);
+    // The image is not referenced after the load
+    memset(image, 0, len);
+    free(image);
+    clone = JS_CloneContext(ctx, clone_mem, IMAGE_MEM_SIZE);
+    CHECK(clone);
+
+    CHECK(vm_eval(ctx, image_call, buf, sizeof(buf)) == 0 && strcmp(buf, expected) == 0);
+    CHECK(vm_eval(clone, image_call, clone_buf, sizeof(clone_buf)) == 0 && strcmp(clone_buf, expected) == 0);
+    CHECK(vm_eval(ctx, "gc(); handler('1')", buf, sizeof(buf)) == 0);
+    CHECK(vm_eval(clone, "gc(); handler('1')", clone_buf, sizeof(clone_buf)) == 0);
+    CHECK(strcmp(buf, clone_buf) == 0 && strstr(buf, "\"c\":23"));
+
+    JS_FreeContext(clone);
+    JS_FreeContext(ctx);
+    free(clone_mem);
+    free(mem);
+    return 1;
+}
+
+static int test_heap_image_rejects(void) {
+    uint8_t *mem = malloc(IMAGE_MEM_SIZE);
+    JSHeapImageHeader *hdr;
+    JSContext *ctx;
+    uint8_t *image;
+    size_t len;
+
+    image = image_build(IMAGE_MEM_SIZE, &len, NULL, 0);
+    CHECK(image && mem);
+    hdr = (JSHeapImageHeader *)image;
+
+    // Saved with another stdlib
+    hdr->stdlib_checksum ^= 1;
+    CHECK(JS_LoadHeapImage(mem, IMAGE_MEM_SIZE, &js_stdlib, image, len) == NULL);
+    hdr->stdlib_checksum ^= 1;
+    // Another format version
+    hdr->version++;
+    CHECK(JS_LoadHeapImage(mem, IMAGE_MEM_SIZE, &js_stdlib, image, len) == NULL);
+    hdr->version--;
+    CHECK(JS_LoadHeapImage(mem, 4096, &js_stdlib, image, len) == NULL);
+    CHECK(JS_LoadHeapImage(mem, IMAGE_MEM_SIZE, &js_stdlib, image, len - 8) == NULL);
+    ctx = JS_LoadHeapImage(mem, IMAGE_MEM_SIZE, &js_stdlib, image, len);
+    CHECK(ctx);
+    JS_FreeContext(ctx);
+    free(image);
+    free(mem);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript heap image tests\n");
+    RUN_TEST(test_heap_image_deterministic, "the image does not depend on the build addresses");
+    RUN_TEST(test_heap_image_load, "a loaded image and its clones run without initialization");
+    RUN_TEST(test_heap_image_rejects, "mismatched or truncated images are rejected");
+    return test_summary("heap_image_test");
+}
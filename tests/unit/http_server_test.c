@@ -0,0 +1,171 @@
+/**
+ * MTPScript HTTP server tests
+ * Specification §8.0 - Serving APIs
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * A program is compiled, stored in a snapshot and served: `api`
+ * declarations and the routes of the serve block answer with the JSON of
+ * their handler, and serve routes must name a function of the program.
+ */
+
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "unit_test.h"
+#include "lexer.h"
+#include "parser.h"
+#include "codegen.h"
+#include "src/host/http_server.h"
+
+#define HTTP_SNAPSHOT_FILE "http_server_test.msqs"
+
+static const char *http_source =
+    "api GET \"/health\" func health(): String { return \"ok\" }\n"
+    "func scale(a: Int, b: Int): Int { return a * b }\n"
+    "serve { port: 8080, routes: [{ method: \"GET\", path: \"/scale\", handler: scale }] }\n";
+
+// Parse 'source' into 'arena'. Return the error message, NULL on success.
+static const char *http_parse(mtpscript_arena_t *arena, const char *source, mtpscript_program_t **program) {
+    static char message[256];
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, "<test>");
+    mtpscript_parser_t *parser = NULL;
+    mtpscript_vector_t *tokens;
+    mtpscript_error_t *err;
+
+    *program = NULL;
+    err = mtpscript_lexer_tokenize(lexer, &tokens);
+    if (!err) {
+        parser = mtpscript_parser_new(arena, tokens);
+        err = mtpscript_parser_parse(parser, program);
+    }
+    if (parser) mtpscript_parser_free(parser);
+    mtpscript_lexer_free(lexer);
+    if (!err) return NULL;
+    snprintf(message, sizeof(message), "%s", mtpscript_string_cstr(err->message));
+    mtpscript_error_free(err);
+    return message;
+}
+
+// Send a GET request to the server, return the whole response or NULL.
+// The result must be freed.
+static char *http_get(int port, const char *path) {
+    struct sockaddr_in addr = {0};
+    char request[256], *buf = malloc(4096);
+    size_t len = 0;
+    ssize_t n;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || !buf || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        if (fd >= 0) close(fd);
+        free(buf);
+        return NULL;
+    }
+    n = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n", path);
+    if (write(fd, request, n) == n) {
+        while (len < 4095 && (n = read(fd, buf + len, 4095 - len)) > 0) len += n;
+    }
+    buf[len] = '\0';
+    close(fd);
+    return buf;
+}
+
+// Body of 'response' if its status is 'status', NULL otherwise
+static const char *http_body(const char *response, int status) {
+    char prefix[32];
+    const char *body;
+
+    snprintf(prefix, sizeof(prefix), "HTTP/1.1 %d ", status);
+    if (!response || strncmp(response, prefix, strlen(prefix)) != 0) return NULL;
+    body = strstr(response, "\r\n\r\n");
+    return body ? body + 4 : NULL;
+}
+
+// An api declaration and a serve route answer with their handler's JSON
+static int test_http_serve_routes(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_http_server_config_t config;
+    mtpscript_http_server_t *server = NULL;
+    mtpscript_snapshot_t *snapshot = NULL;
+    mtpscript_program_t *program;
+    mtpscript_vector_t *routes;
+    mtpscript_string_t *js = NULL;
+    mtpscript_error_t *err;
+    char *response;
+    int port = 20000 + getpid() % 20000;
+
+    CHECK(http_parse(arena, http_source, &program) == NULL);
+    routes = mtpscript_http_program_routes(program);
+    CHECK(routes->size == 2);
+    CHECK(mtpscript_codegen_program(program, &js) == NULL);
+    err = mtpscript_snapshot_create(mtpscript_string_cstr(js), js->length, "{}", NULL, 0, HTTP_SNAPSHOT_FILE);
+    CHECK(!err && !mtpscript_snapshot_load(HTTP_SNAPSHOT_FILE, NULL, &snapshot));
+
+    mtpscript_http_server_config_init(&config);
+    config.port = port;
+    config.workers = 1;
+    config.pool_size = 1;
+    config.mem_size = 1024 * 1024;
+    err = mtpscript_http_server_new(snapshot, routes, &config, &server);
+    if (err) printf("\n        %s ", mtpscript_string_cstr(err->message));
+    CHECK(!err && mtpscript_http_server_route_count(server) == 2);
+    CHECK(!mtpscript_http_server_start(server));
+
+    response = http_get(port, "/health");
+    CHECK(http_body(response, 200) && strcmp(http_body(response, 200), "\"ok\"") == 0);
+    free(response);
+    // Query parameters are passed by name
+    response = http_get(port, "/scale?b=7&a=6");
+    CHECK(http_body(response, 200) && strcmp(http_body(response, 200), "42") == 0);
+    free(response);
+    response = http_get(port, "/missing");
+    CHECK(http_body(response, 404));
+    free(response);
+
+    mtpscript_http_server_stop(server);
+    mtpscript_http_server_free(server);
+    mtpscript_vector_free(routes);
+    mtpscript_snapshot_free(snapshot);
+    mtpscript_string_free(js);
+    mtpscript_arena_free(arena);
+    unlink(HTTP_SNAPSHOT_FILE);
+    return 1;
+}
+
+// Serve routes are resolved to the function declarations they name
+static int test_http_route_handlers(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_program_t *program;
+    mtpscript_declaration_t *serve;
+    mtpscript_api_decl_t *route;
+    const char *message;
+
+    CHECK(http_parse(arena, http_source, &program) == NULL);
+    serve = mtpscript_vector_get(program->declarations, 2);
+    CHECK(serve->kind == MTPSCRIPT_DECL_SERVE && serve->data.serve.routes->size == 1);
+    route = mtpscript_vector_get(serve->data.serve.routes, 0);
+    CHECK(route->handler->params && route->handler->params->size == 2 && route->handler->body);
+
+    message = http_parse(arena, "serve { routes: [{ method: \"GET\", path: \"/x\", handler: nope }] }", &program);
+    CHECK(message && strstr(message, "Unknown route handler: GET /x"));
+    message = http_parse(arena, "func f(): Int { return 1 }\n"
+                                "serve { routes: [{ method: \"GET\", path: \"/x\" }] }", &program);
+    CHECK(message && strstr(message, "Route needs a method, a path and a handler"));
+    // Unknown characters are lexer errors
+    message = http_parse(arena, "serve { port: 80 @ }", &program);
+    CHECK(message && strstr(message, "Unexpected character '@'"));
+    mtpscript_arena_free(arena);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript HTTP server tests\n");
+    RUN_TEST(test_http_serve_routes, "api declarations and serve routes are served");
+    RUN_TEST(test_http_route_handlers, "serve route handlers name functions");
+    return test_summary("http_server_test");
+}
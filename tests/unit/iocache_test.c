@@ -0,0 +1,149 @@
+/**
+ * MTPScript I/O replay cache tests
+ * Specification §7 - Deterministic I/O caching
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ */
+
+#include "unit_vm.h"
+#include "mquickjs_iocache.h"
+
+// A key whose hash (its first 32 bits) is 'hash' and which is made unique
+// by 'id'
+static void io_key(uint8_t *key, uint32_t hash, uint32_t id) {
+    memset(key, 0, MTPSCRIPT_IO_CACHE_KEY_SIZE);
+    memcpy(key, &hash, sizeof(hash));
+    memcpy(key + 4, &id, sizeof(id));
+}
+
+static bool io_put(MTPScriptIOCache *cache, uint32_t hash, uint32_t id, const char *value) {
+    uint8_t key[MTPSCRIPT_IO_CACHE_KEY_SIZE];
+
+    io_key(key, hash, id);
+    return mtpscript_io_cache_put_bytes(cache, key, (const uint8_t *)value, strlen(value));
+}
+
+// True if the entry is cached with 'value' (NULL: not cached)
+static bool io_has(MTPScriptIOCache *cache, uint32_t hash, uint32_t id, const char *value) {
+    uint8_t key[MTPSCRIPT_IO_CACHE_KEY_SIZE];
+    uint8_t *data;
+    size_t len;
+    bool ok;
+
+    io_key(key, hash, id);
+    if (!mtpscript_io_cache_get_bytes(cache, key, &data, &len)) return value == NULL;
+    ok = value && len == strlen(value) && memcmp(data, value, len) == 0 && data[len] == '\0';
+    free(data);
+    return ok;
+}
+
+static int test_io_cache_lru_entries(void) {
+    MTPScriptIOCache *cache = mtpscript_io_cache_new(3, 0);
+    MTPScriptIOCacheStats s;
+
+    CHECK(cache);
+    CHECK(io_put(cache, 1, 1, "a") && io_put(cache, 2, 2, "b") && io_put(cache, 3, 3, "c"));
+    // A hit makes 'a' the most recently used: 'b' is evicted first
+    CHECK(io_has(cache, 1, 1, "a"));
+    CHECK(io_put(cache, 4, 4, "d"));
+    CHECK(io_has(cache, 2, 2, NULL));
+    CHECK(io_has(cache, 1, 1, "a") && io_has(cache, 3, 3, "c") && io_has(cache, 4, 4, "d"));
+    // Hits refreshed 'a', 'c' then 'd'
+    CHECK(io_put(cache, 5, 5, "e"));
+    CHECK(io_has(cache, 1, 1, NULL) && io_has(cache, 3, 3, "c"));
+
+    mtpscript_io_cache_get_stats(cache, &s);
+    CHECK(s.entries == 3 && s.evictions == 2 && s.insertions == 5);
+    CHECK(s.hits == 5 && s.misses == 2);
+    mtpscript_io_cache_free(cache);
+    return 1;
+}
+
+static int test_io_cache_byte_budget(void) {
+    MTPScriptIOCache *cache = mtpscript_io_cache_new(16, 10);
+    MTPScriptIOCacheStats s;
+
+    CHECK(cache);
+    CHECK(io_put(cache, 1, 1, "1234") && io_put(cache, 2, 2, "5678"));
+    // 4 + 4 + 4 > 10: the oldest entry makes room
+    CHECK(io_put(cache, 3, 3, "abcd"));
+    CHECK(io_has(cache, 1, 1, NULL) && io_has(cache, 2, 2, "5678"));
+    // Larger than the whole budget: rejected, nothing evicted
+    CHECK(!io_put(cache, 4, 4, "0123456789a"));
+    CHECK(io_has(cache, 2, 2, "5678") && io_has(cache, 3, 3, "abcd"));
+    // Replacing an entry frees its bytes first
+    CHECK(io_put(cache, 2, 2, "567890"));
+    CHECK(io_has(cache, 2, 2, "567890") && io_has(cache, 3, 3, "abcd"));
+
+    mtpscript_io_cache_get_stats(cache, &s);
+    CHECK(s.entries == 2 && s.bytes == 10);
+    CHECK(s.evictions == 1 && s.rejected == 1);
+    mtpscript_io_cache_free(cache);
+    return 1;
+}
+
+// Evicting an entry in the middle of a probe sequence must keep the
+// entries after it reachable
+static int test_io_cache_collisions(void) {
+    MTPScriptIOCache *cache = mtpscript_io_cache_new(8, 0);
+    char value[16];
+
+    CHECK(cache);
+    for (uint32_t id = 0; id < 6; id++) {
+        snprintf(value, sizeof(value), "v%u", id);
+        CHECK(io_put(cache, 7, id, value));
+    }
+    // Wraps around the end of the table
+    CHECK(io_put(cache, 15, 100, "w"));
+    CHECK(io_put(cache, 15, 101, "x"));
+    // Full: the two oldest colliding entries are evicted
+    CHECK(io_put(cache, 3, 200, "y") && io_put(cache, 3, 201, "z"));
+    CHECK(io_has(cache, 7, 0, NULL) && io_has(cache, 7, 1, NULL));
+    for (uint32_t id = 2; id < 6; id++) {
+        snprintf(value, sizeof(value), "v%u", id);
+        CHECK(io_has(cache, 7, id, value));
+    }
+    CHECK(io_has(cache, 15, 100, "w") && io_has(cache, 15, 101, "x"));
+    CHECK(io_has(cache, 3, 200, "y") && io_has(cache, 3, 201, "z"));
+
+    mtpscript_io_cache_clear(cache);
+    CHECK(io_has(cache, 7, 5, NULL) && io_has(cache, 15, 101, NULL));
+    CHECK(io_put(cache, 7, 5, "again") && io_has(cache, 7, 5, "again"));
+    mtpscript_io_cache_free(cache);
+    return 1;
+}
+
+// Values are rebuilt in the context which reads them
+static int test_io_cache_js_values(void) {
+    MTPScriptIOCache *cache = mtpscript_io_cache_new(4, 0);
+    JSContext *a = vm_new(256 * 1024), *b = vm_new(256 * 1024);
+    uint8_t key[MTPSCRIPT_IO_CACHE_KEY_SIZE];
+    JSValue val;
+    bool ok;
+
+    CHECK(cache && a && b);
+    io_key(key, 42, 0);
+    val = JS_Eval(a, "({rows: [1, 2], ok: true})", 26, "<test>", JS_EVAL_RETVAL);
+    CHECK(!JS_IsException(val));
+    CHECK(mtpscript_io_cache_put(cache, a, key, val));
+    vm_free(a);
+
+    val = mtpscript_io_cache_get(cache, b, key);
+    CHECK(!JS_IsUndefined(val));
+    JS_SetPropertyStr(b, JS_GetGlobalObject(b), "cached", val);
+    ok = vm_eval_is(b, "JSON.stringify(cached)", "{\"ok\":true,\"rows\":[1,2]}");
+    vm_free(b);
+    mtpscript_io_cache_free(cache);
+    CHECK(ok);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript I/O replay cache tests\n");
+    RUN_TEST(test_io_cache_lru_entries, "least recently used entry is evicted first");
+    RUN_TEST(test_io_cache_byte_budget, "byte budget evicts and rejects oversize");
+    RUN_TEST(test_io_cache_collisions, "evictions keep colliding keys reachable");
+    RUN_TEST(test_io_cache_js_values, "values are rebuilt in the reading context");
+    return test_summary("iocache_test");
+}
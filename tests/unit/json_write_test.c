@@ -0,0 +1,158 @@
+/**
+ * MTPScript streamed JSON tests
+ * Specification §4.2 - Deterministic serialization
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * JS_JSONWrite() writes the canonical JSON of a response in chunks and
+ * hashes it in the same pass. The concatenated chunks and the hash must
+ * match JSON.stringify() exactly.
+ */
+
+#include <openssl/sha.h>
+#include "unit_vm.h"
+
+#define JSON_WRITE_MEM_SIZE (1024 * 1024)
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t size;
+    int calls;
+    size_t max_chunk;
+    int abort_at;   // Fail the call with this number (1 = first), 0 = never
+} json_sink_t;
+
+static int json_sink_write(void *opaque, const uint8_t *buf, size_t len) {
+    json_sink_t *s = opaque;
+
+    s->calls++;
+    if (s->abort_at && s->calls >= s->abort_at) return -1;
+    if (len > s->max_chunk) s->max_chunk = len;
+    if (s->len + len > s->size) {
+        s->size = (s->len + len) * 2;
+        s->data = realloc(s->data, s->size);
+    }
+    memcpy(s->data + s->len, buf, len);
+    s->len += len;
+    return 0;
+}
+
+// Evaluate 'code' and stream its value to 's'. 'expected' receives
+// JSON.stringify() of the same value. Return JS_JSONWrite().
+static int json_write_eval(JSContext *ctx, const char *code, json_sink_t *s, uint8_t hash[32],
+                           char *expected, size_t expected_size) {
+    JSCStringBuf sbuf;
+    const char *str;
+    JSValue val, json;
+    JSGCRef val_ref;
+    int ret;
+
+    val = JS_Eval(ctx, code, strlen(code), "<test>", JS_EVAL_RETVAL);
+    if (JS_IsException(val)) return -2;
+    JS_PUSH_VALUE(ctx, val);
+    ret = JS_JSONWrite(ctx, val, s ? json_sink_write : NULL, s, hash);
+    JS_POP_VALUE(ctx, val);
+    if (expected) {
+        json = JS_JSONStringify(ctx, val);
+        str = JS_IsException(json) ? NULL : JS_ToCString(ctx, json, &sbuf);
+        snprintf(expected, expected_size, "%s", str ? str : "<exception>");
+    }
+    return ret;
+}
+
+// A value whose JSON is about 20 KB long, with escapes and non-ASCII
+// characters at chunk boundaries
+static const char *json_write_large =
+    "function rep(s, n) { return n == 0 ? '' : s.concat(rep(s, n - 1)); }\n"
+    "function fill(a, i) { if (i == 0) return a; a.push({id: i, s: rep('x\\n\\\"\\\\\\t\\u0001\\u00e9\\u20ac\\ud83d\\ude00', i % 7)}); return fill(a, i - 1); }\n"
+    "({list: fill([], 300), big: rep('y', 5000), n: [1.5, -0, 1e21, null, true]})";
+
+static int test_json_write_chunks(void) {
+    JSContext *ctx = vm_new(JSON_WRITE_MEM_SIZE);
+    json_sink_t s = {0};
+    char *expected = malloc(256 * 1024);
+    uint8_t hash[32], expected_hash[32];
+
+    CHECK(ctx && expected);
+    CHECK(json_write_eval(ctx, json_write_large, &s, hash, expected, 256 * 1024) == 0);
+    CHECK(s.len > 4 * 4096 && s.calls > 4 && s.max_chunk <= 4096);
+    CHECK(s.len == strlen(expected) && memcmp(s.data, expected, s.len) == 0);
+    SHA256((const uint8_t *)expected, strlen(expected), expected_hash);
+    CHECK(memcmp(hash, expected_hash, 32) == 0);
+
+    // The hash alone, without a sink
+    memset(hash, 0, sizeof(hash));
+    CHECK(json_write_eval(ctx, json_write_large, NULL, hash, NULL, 0) == 0);
+    CHECK(memcmp(hash, expected_hash, 32) == 0);
+    free(s.data);
+    free(expected);
+    vm_free(ctx);
+    return 1;
+}
+
+// Escapes, including lone surrogates, are hashed as they are written
+static int test_json_write_escapes(void) {
+    static const char *values[] = {
+        "'quote \\\" backslash \\\\ slash / controls \\b\\f\\n\\r\\t\\u0000\\u001f\\u007f'",
+        "['\\ud800', '\\udfff', 'a\\ud800b', '\\udc00\\ud800', '\\ud83d\\ude00']",
+        "({'\\ud800': 1, 'k\\n': '\\u2028\\u2029', '\\u00e9': [{}, []]})",
+        "[1 / 3, 1e-7, -1e300, 123456789012, -0.5]",
+    };
+    JSContext *ctx = vm_new(JSON_WRITE_MEM_SIZE);
+    uint8_t hash[32], expected_hash[32];
+    char expected[1024];
+
+    CHECK(ctx);
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        json_sink_t s = {0};
+        CHECK(json_write_eval(ctx, values[i], &s, hash, expected, sizeof(expected)) == 0);
+        if (s.len != strlen(expected) || memcmp(s.data, expected, s.len) != 0) {
+            printf("\n        %s -> %.*s (expected %s) ", values[i], (int)s.len, (char *)s.data, expected);
+            CHECK(0);
+        }
+        SHA256((const uint8_t *)expected, strlen(expected), expected_hash);
+        CHECK(memcmp(hash, expected_hash, 32) == 0);
+        free(s.data);
+    }
+    // Lone surrogates are escaped, so the output is valid UTF-8
+    CHECK(vm_eval_is(ctx, "JSON.stringify(['\\ud800', 'a\\udfffb'])", "[\"\\ud800\",\"a\\udfffb\"]"));
+    vm_free(ctx);
+    return 1;
+}
+
+// A failing sink stops the output and throws
+static int test_json_write_abort(void) {
+    JSContext *ctx = vm_new(JSON_WRITE_MEM_SIZE);
+    json_sink_t s = {0};
+    JSCStringBuf sbuf;
+    const char *str;
+    uint8_t hash[32];
+
+    CHECK(ctx);
+    s.abort_at = 2;
+    CHECK(json_write_eval(ctx, json_write_large, &s, hash, NULL, 0) == -1);
+    // Nothing is written after the failure
+    CHECK(s.calls == 2 && s.len <= 4096);
+    str = JS_ToCString(ctx, JS_ToString(ctx, JS_GetException(ctx)), &sbuf);
+    CHECK(str && strstr(str, "JSON output error"));
+
+    // Also when the whole output fits in the last chunk
+    s.abort_at = 1;
+    s.calls = 0;
+    CHECK(json_write_eval(ctx, "[1, 2]", &s, NULL, NULL, 0) == -1 && s.calls == 1);
+    JS_GetException(ctx);
+    CHECK(vm_eval_is(ctx, "JSON.stringify({a: [1]})", "{\"a\":[1]}"));
+    free(s.data);
+    vm_free(ctx);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript streamed JSON tests\n");
+    RUN_TEST(test_json_write_chunks, "chunked output and hash match JSON.stringify");
+    RUN_TEST(test_json_write_escapes, "escapes and lone surrogates");
+    RUN_TEST(test_json_write_abort, "a failing sink aborts the output");
+    return test_summary("json_write_test");
+}
@@ -0,0 +1,145 @@
+/**
+ * MTPScript canonical key order tests
+ * Specification §4.2 - Deterministic serialization
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Object.keys(), JSON.stringify() and the CBOR encoding list the keys of
+ * an object in canonical order: shorter keys first, then bytewise. The
+ * order of each shape is cached by a hash of its keys; an entry used by
+ * another shape must not change the result.
+ */
+
+#include "unit_vm.h"
+
+#define KEY_ORDER_MEM_SIZE (1024 * 1024)
+#define KEY_ORDER_SHAPES 200
+#define KEY_ORDER_SHAPE_KEYS 5
+
+// UTF-8 keys of various lengths; "\xc3\xa9" is two bytes long
+static const char *key_order_pool[] = {
+    "a", "b", "z", "_", "A", "aa", "ab", "ba", "\xc3\xa9", "zz", "a_", "abc", "abd",
+    "b00", "key", "keys", "id", "ids", "name", "names", "value", "x1", "x10", "x2",
+};
+
+#define KEY_ORDER_POOL_SIZE (int)(sizeof(key_order_pool) / sizeof(key_order_pool[0]))
+
+// Reference order: length in bytes, then bytes
+static int key_order_cmp(const void *a, const void *b) {
+    const char *k1 = *(const char **)a, *k2 = *(const char **)b;
+    size_t len1 = strlen(k1), len2 = strlen(k2);
+
+    if (len1 != len2) return len1 < len2 ? -1 : 1;
+    return memcmp(k1, k2, len1);
+}
+
+// Pick 'n' distinct keys of the pool for shape 'seed', in insertion order
+static void key_order_shape(int seed, const char **keys, int n) {
+    uint32_t r = 2166136261u ^ (uint32_t)seed;
+    int count = 0;
+
+    while (count < n) {
+        bool used = false;
+        r = r * 1103515245u + 12345u;
+        const char *key = key_order_pool[(r >> 16) % KEY_ORDER_POOL_SIZE];
+        for (int i = 0; i < count; i++) {
+            if (keys[i] == key) used = true;
+        }
+        if (!used) keys[count++] = key;
+    }
+}
+
+// Build an object with 'keys' inserted in order, and check its keys and
+// its JSON against the reference order
+static bool key_order_check(JSContext *ctx, const char **keys, int n) {
+    const char *sorted[64];
+    char code[2048], keys_str[1024], json[1024], expected[2048], buf[2048];
+    size_t len;
+    int i;
+
+    len = snprintf(code, sizeof(code), "var o = {};");
+    for (i = 0; i < n; i++) {
+        len += snprintf(code + len, sizeof(code) - len, " o['%s'] = %d;", keys[i], i);
+    }
+    snprintf(code + len, sizeof(code) - len, " [Object.keys(o).join(), JSON.stringify(o)].join(' ')");
+
+    memcpy(sorted, keys, n * sizeof(keys[0]));
+    qsort(sorted, n, sizeof(sorted[0]), key_order_cmp);
+    keys_str[0] = '\0';
+    len = snprintf(json, sizeof(json), "{");
+    for (i = 0; i < n; i++) {
+        int value = 0;
+        while (keys[value] != sorted[i]) value++;
+        snprintf(keys_str + strlen(keys_str), sizeof(keys_str) - strlen(keys_str), "%s%s", i ? "," : "", sorted[i]);
+        len += snprintf(json + len, sizeof(json) - len, "%s\"%s\":%d", i ? "," : "", sorted[i], value);
+    }
+    snprintf(json + len, sizeof(json) - len, "}");
+
+    snprintf(expected, sizeof(expected), "%s %s", keys_str, json);
+    if (vm_eval(ctx, code, buf, sizeof(buf)) != 0 || strcmp(buf, expected) != 0) {
+        printf("\n        %s -> %s (expected %s) ", code, buf, expected);
+        return false;
+    }
+    return true;
+}
+
+// Length first, then the UTF-8 bytes
+static int test_key_order_canonical(void) {
+    JSContext *ctx = vm_new(KEY_ORDER_MEM_SIZE);
+    const char *keys[] = {"b", "aa", "_", "\xc3\xa9", "ab", "a", "z", "x10", "x2", "A"};
+
+    CHECK(ctx);
+    CHECK(vm_eval_is(ctx, "Object.keys({b: 1, aa: 2, _: 3, a: 4, z: 5, '10': 6}).join()", "_,a,b,z,10,aa"));
+    CHECK(key_order_check(ctx, keys, sizeof(keys) / sizeof(keys[0])));
+    // Array indexes come first, in numeric order
+    CHECK(vm_eval_is(ctx, "var a = [1, 2]; a.b = 0; a.aa = 0; a._ = 0; Object.keys(a).join()", "0,1,_,b,aa"));
+    vm_free(ctx);
+    return 1;
+}
+
+// Many shapes with the same key count share the cache entries: each
+// shape, seen again after the others, still gets its own order
+static int test_key_order_cache(void) {
+    JSContext *ctx = vm_new(KEY_ORDER_MEM_SIZE);
+    const char *keys[KEY_ORDER_SHAPE_KEYS];
+
+    CHECK(ctx);
+    for (int round = 0; round < 2; round++) {
+        for (int seed = 0; seed < KEY_ORDER_SHAPES; seed++) {
+            key_order_shape(seed, keys, KEY_ORDER_SHAPE_KEYS);
+            // The second check of a shape hits its cache entry
+            CHECK(key_order_check(ctx, keys, KEY_ORDER_SHAPE_KEYS));
+            CHECK(key_order_check(ctx, keys, KEY_ORDER_SHAPE_KEYS));
+        }
+        // The GC moves the key atoms, which changes the hashes
+        CHECK(vm_eval_is(ctx, "gc(); 0", "0"));
+    }
+    vm_free(ctx);
+    return 1;
+}
+
+// Objects with more keys than a cache entry holds are sorted every time
+static int test_key_order_large(void) {
+    JSContext *ctx = vm_new(KEY_ORDER_MEM_SIZE);
+    const char *keys[KEY_ORDER_POOL_SIZE];
+
+    CHECK(ctx);
+    for (int i = 0; i < KEY_ORDER_POOL_SIZE; i++) {
+        keys[i] = key_order_pool[KEY_ORDER_POOL_SIZE - 1 - i];
+    }
+    CHECK(key_order_check(ctx, keys, KEY_ORDER_POOL_SIZE));
+    CHECK(vm_eval_is(ctx, "function fill(o, i) { if (i == 0) return o; o['k'.concat(String(i))] = i; return fill(o, i - 1); }"
+                          "var keys = Object.keys(fill({}, 40)); [keys.length, keys[0], keys[8], keys[9], keys[39]].join()",
+                          "40,k1,k9,k10,k40"));
+    vm_free(ctx);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript canonical key order tests\n");
+    RUN_TEST(test_key_order_canonical, "keys are ordered by length, then bytes");
+    RUN_TEST(test_key_order_cache, "shapes sharing a cache entry keep their order");
+    RUN_TEST(test_key_order_large, "objects with many keys");
+    return test_summary("key_order_test");
+}
@@ -0,0 +1,216 @@
+/**
+ * MTPScript optimizer tests
+ * Specification §5.0 - Code generation
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * The optimizer folds, inlines and removes code between parsing and code
+ * generation. The optimized program must behave like the original one,
+ * exceptions included.
+ */
+
+#include "unit_vm.h"
+#include "lexer.h"
+#include "parser.h"
+#include "codegen.h"
+#include "optimizer.h"
+
+#define OPTIMIZER_MEM_SIZE (256 * 1024)
+
+// Calls of the fixture functions, compared between the original and the
+// optimized program
+static const char *optimizer_calls[] = {
+    "area()", "pipeline(2, 3)", "pipeline(-4, 5)", "common(1, 2)", "common(0, 0)",
+    "checked(0)", "checked(1)", "checked(5)", "checked_sign(7)",
+};
+
+// Read a whole file, NULL on error. The result must be freed.
+static char *optimizer_read_file(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    char *buf = NULL;
+    long len;
+
+    if (!f) return NULL;
+    if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+        buf = malloc(len + 1);
+        if (buf && fread(buf, 1, len, f) == (size_t)len) {
+            buf[len] = '\0';
+        } else {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(f);
+    return buf;
+}
+
+// Parse 'source' into 'arena', NULL on error
+static mtpscript_program_t *optimizer_parse(mtpscript_arena_t *arena, const char *source) {
+    mtpscript_lexer_t *lexer = mtpscript_lexer_new(arena, source, "<test>");
+    mtpscript_parser_t *parser = NULL;
+    mtpscript_program_t *program = NULL;
+    mtpscript_vector_t *tokens;
+    mtpscript_error_t *err;
+
+    err = mtpscript_lexer_tokenize(lexer, &tokens);
+    if (!err) {
+        parser = mtpscript_parser_new(arena, tokens);
+        err = mtpscript_parser_parse(parser, &program);
+    }
+    if (err) {
+        mtpscript_error_free(err);
+        program = NULL;
+    }
+    if (parser) mtpscript_parser_free(parser);
+    mtpscript_lexer_free(lexer);
+    return program;
+}
+
+// Compile 'source' to JavaScript, NULL on error. The result must be freed
+// with mtpscript_string_free().
+static mtpscript_string_t *optimizer_compile(const char *source, bool optimize) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_program_t *program = optimizer_parse(arena, source);
+    mtpscript_string_t *js = NULL;
+
+    if (program && (!optimize || !mtpscript_optimize_program(program))) {
+        if (mtpscript_codegen_program(program, &js)) js = NULL;
+    }
+    mtpscript_arena_free(arena);
+    return js;
+}
+
+// Return the expression of the single return statement of 'source'
+static mtpscript_expression_t *optimizer_return_expression(mtpscript_arena_t *arena, const char *source) {
+    mtpscript_program_t *program = optimizer_parse(arena, source);
+    mtpscript_declaration_t *decl;
+    mtpscript_statement_t *stmt;
+
+    if (!program || program->declarations->size != 1) return NULL;
+    decl = mtpscript_vector_get(program->declarations, 0);
+    if (decl->kind != MTPSCRIPT_DECL_FUNCTION || decl->data.function.body->size != 1) return NULL;
+    stmt = mtpscript_vector_get(decl->data.function.body, 0);
+    return stmt->kind == MTPSCRIPT_STMT_RETURN_STMT ? stmt->data.return_stmt.expression : NULL;
+}
+
+static bool optimizer_is_variable(mtpscript_expression_t *expr, const char *name) {
+    return expr->kind == MTPSCRIPT_EXPR_VARIABLE && strcmp(mtpscript_string_cstr(expr->data.variable.name), name) == 0;
+}
+
+// The fixture compiles to its expected output
+static int test_optimizer_fixture(void) {
+    char *source = optimizer_read_file("tests/fixtures/optimize.mtp");
+    char *expected = optimizer_read_file("tests/fixtures/optimize.js");
+    mtpscript_string_t *js;
+
+    CHECK(source && expected);
+    js = optimizer_compile(source, true);
+    CHECK(js);
+    if (strcmp(mtpscript_string_cstr(js), expected) != 0) {
+        printf("\n%s", mtpscript_string_cstr(js));
+        CHECK(0);
+    }
+    mtpscript_string_free(js);
+    free(expected);
+    free(source);
+    return 1;
+}
+
+// A pipeline operand binds tighter than the binary operators, and
+// pipelines are left-associative
+static int test_optimizer_pipe_grouping(void) {
+    mtpscript_arena_t *arena = mtpscript_arena_new();
+    mtpscript_expression_t *expr, *right;
+
+    expr = optimizer_return_expression(arena, "func f(a: Int, b: Int): Int { return a * b |> g + 1 }");
+    CHECK(expr && expr->kind == MTPSCRIPT_EXPR_BINARY_EXPR && strcmp(expr->data.binary.op, "+") == 0);
+    expr = expr->data.binary.left;
+    CHECK(expr->kind == MTPSCRIPT_EXPR_BINARY_EXPR && strcmp(expr->data.binary.op, "*") == 0);
+    CHECK(optimizer_is_variable(expr->data.binary.left, "a"));
+    right = expr->data.binary.right;
+    CHECK(right->kind == MTPSCRIPT_EXPR_PIPE_EXPR);
+    CHECK(optimizer_is_variable(right->data.pipe.left, "b") && optimizer_is_variable(right->data.pipe.right, "g"));
+
+    expr = optimizer_return_expression(arena, "func f(a: Int): Int { return a |> g |> h }");
+    CHECK(expr && expr->kind == MTPSCRIPT_EXPR_PIPE_EXPR && optimizer_is_variable(expr->data.pipe.right, "h"));
+    expr = expr->data.pipe.left;
+    CHECK(expr->kind == MTPSCRIPT_EXPR_PIPE_EXPR && optimizer_is_variable(expr->data.pipe.right, "g"));
+    CHECK(optimizer_is_variable(expr->data.pipe.left, "a"));
+    mtpscript_arena_free(arena);
+    return 1;
+}
+
+// Bindings are only removed if they cannot throw, and a value which may
+// throw is evaluated once
+static int test_optimizer_keeps_throws(void) {
+    mtpscript_string_t *js = optimizer_compile(
+        "func sq(x: Int): Int { return x * x }\n"
+        "func one(n: Int): Int {\n"
+        "    let r = match n { 1 -> 1 }\n"
+        "    return r\n"
+        "}\n"
+        "func f(n: Int): Int {\n"
+        "    let a = sq(n)\n"
+        "    let c = match n { 1 -> one(n), _ -> 0 }\n"
+        "    let b = one(n) + 1\n"
+        "    return b * 2\n"
+        "}\n", true);
+    const char *out, *body;
+
+    CHECK(js);
+    out = mtpscript_string_cstr(js);
+    body = strstr(out, "function f(n)");
+    CHECK(body);
+    // 'a' cannot throw and is dropped, 'c' may throw and is kept, and 'b'
+    // is moved to its use
+    CHECK(!strstr(body, "var a"));
+    CHECK(strstr(body, "var c = (n === 1 ? (one(n)) : (0));"));
+    CHECK(!strstr(body, "var b") && strstr(body, "return (one(n) + 1) * 2;"));
+    mtpscript_string_free(js);
+    return 1;
+}
+
+// The original and the optimized fixture return the same values and throw
+// the same errors
+static int test_optimizer_semantics(void) {
+    char *source = optimizer_read_file("tests/fixtures/optimize.mtp");
+    mtpscript_string_t *js = NULL, *opt_js = NULL;
+    JSContext *ctx = NULL, *opt_ctx = NULL;
+    char buf[256], opt_buf[256];
+
+    CHECK(source);
+    js = optimizer_compile(source, false);
+    opt_js = optimizer_compile(source, true);
+    ctx = vm_new(OPTIMIZER_MEM_SIZE);
+    opt_ctx = vm_new(OPTIMIZER_MEM_SIZE);
+    CHECK(js && opt_js && ctx && opt_ctx);
+    CHECK(vm_eval(ctx, mtpscript_string_cstr(js), buf, sizeof(buf)) == 0);
+    CHECK(vm_eval(opt_ctx, mtpscript_string_cstr(opt_js), opt_buf, sizeof(opt_buf)) == 0);
+
+    for (size_t i = 0; i < sizeof(optimizer_calls) / sizeof(optimizer_calls[0]); i++) {
+        int ret = vm_eval(ctx, optimizer_calls[i], buf, sizeof(buf));
+        int opt_ret = vm_eval(opt_ctx, optimizer_calls[i], opt_buf, sizeof(opt_buf));
+        if (ret != opt_ret || strcmp(buf, opt_buf) != 0) {
+            printf("\n        %s -> %s, optimized %s ", optimizer_calls[i], buf, opt_buf);
+            CHECK(0);
+        }
+    }
+    CHECK(vm_eval(opt_ctx, "checked(5)", opt_buf, sizeof(opt_buf)) == -1);
+
+    vm_free(opt_ctx);
+    vm_free(ctx);
+    mtpscript_string_free(opt_js);
+    mtpscript_string_free(js);
+    free(source);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript optimizer tests\n");
+    RUN_TEST(test_optimizer_fixture, "the fixture compiles to its expected output");
+    RUN_TEST(test_optimizer_pipe_grouping, "pipelines bind tighter than binary operators");
+    RUN_TEST(test_optimizer_keeps_throws, "code which may throw is not dropped");
+    RUN_TEST(test_optimizer_semantics, "the optimized program behaves like the original");
+    return test_summary("optimizer_test");
+}
@@ -0,0 +1,99 @@
+/**
+ * MTPScript property cache tests
+ * Specification §5.0 - Runtime
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Each get_field/put_field site caches the position of the property it
+ * last found. The entry is only a hint: a site must give the same results
+ * whatever the shape of the objects it sees and however they change.
+ */
+
+#include "unit_vm.h"
+
+#define PROP_CACHE_MEM_SIZE (1024 * 1024)
+
+// One get and one put site shared by every object
+static const char *prop_cache_sites =
+    "function get_x(o) { return o.x; }\n"
+    "function set_x(o, v) { o.x = v; return o; }\n"
+    "function sum_from(a, i) { return i == a.length ? 0 : get_x(a[i]) + sum_from(a, i + 1); }\n"
+    "function sum_x(a) { return sum_from(a, 0); }\n"
+    "function add_keys(o, i) { if (i == 0) return o; o['k'.concat(String(i))] = i; return add_keys(o, i - 1); }\n"
+    "function garbage(i) { if (i == 0) return 0; get_x({x: i}); return garbage(i - 1); }\n"
+    "0";
+
+// Objects with 'x' at different positions, or not at all
+static int test_prop_cache_shapes(void) {
+    JSContext *ctx = vm_new(PROP_CACHE_MEM_SIZE);
+
+    CHECK(ctx);
+    CHECK(vm_eval_is(ctx, prop_cache_sites, "0"));
+    CHECK(vm_eval_is(ctx, "var a = [{x: 1}, {y: 2, x: 3}, {a: 0, b: 0, c: 0, x: 5}, {x: 7, y: 0}];"
+                          "[sum_x(a), sum_x(a), get_x({y: 1}), get_x({})].join()", "16,16,,"));
+    // The key at the cached position of another object
+    CHECK(vm_eval_is(ctx, "get_x({y: 1, x: 2}); [get_x({y: 1, z: 2}), get_x({z: 1, x: 4})].join()", ",4"));
+    // The property is found on the prototype
+    CHECK(vm_eval_is(ctx, "function P() {} P.prototype.x = 9; get_x({x: 1}); get_x(new P())", "9"));
+    CHECK(vm_eval_is(ctx, "var b = [set_x({x: 1}, 2), set_x({y: 1, x: 1}, 3), set_x({y: 1}, 4)];"
+                          "sum_x(b) + b[2].y", "10"));
+    vm_free(ctx);
+    return 1;
+}
+
+// Properties deleted or added after the site cached their position, and
+// accessors where it cached a plain property
+static int test_prop_cache_changes(void) {
+    JSContext *ctx = vm_new(PROP_CACHE_MEM_SIZE);
+
+    CHECK(ctx);
+    CHECK(vm_eval_is(ctx, prop_cache_sites, "0"));
+    CHECK(vm_eval_is(ctx, "var o = {a: 1, x: 2}; get_x(o); delete o.x; String(get_x(o))", "undefined"));
+    CHECK(vm_eval_is(ctx, "o.x = 3; get_x(o)", "3"));
+    // The props array grows and is rehashed
+    CHECK(vm_eval_is(ctx, "add_keys(o, 40); get_x(o) + o.k39", "42"));
+    CHECK(vm_eval_is(ctx, "delete o.a; set_x(o, 5); get_x(o)", "5"));
+    // An accessor at the position cached for a plain property
+    CHECK(vm_eval_is(ctx, "var n = 0, g = {y: 0}; get_x({y: 0, x: 1});"
+                          "Object.defineProperty(g, 'x', {get: function () { n++; return 8; }});"
+                          "[get_x(g), get_x(g), n].join()", "8,8,2"));
+    CHECK(vm_eval_is(ctx, "var s = {y: 0}; set_x({y: 0, x: 1}, 2);"
+                          "Object.defineProperty(s, 'x', {set: function (v) { this.y = v; }});"
+                          "set_x(s, 6); s.y", "6"));
+    vm_free(ctx);
+    return 1;
+}
+
+// The cache holds positions, not addresses: moving the objects, or the
+// whole context, keeps it valid
+static int test_prop_cache_relocation(void) {
+    JSContext *ctx = vm_new(PROP_CACHE_MEM_SIZE), *clone;
+    uint8_t *clone_mem = malloc(PROP_CACHE_MEM_SIZE);
+    const char *code = "var c = [{x: 1}, {y: 0, x: 2}]; var t = sum_x(c); gc(); [t, sum_x(c), sum_x(a)].join()";
+
+    CHECK(ctx && clone_mem);
+    CHECK(vm_eval_is(ctx, prop_cache_sites, "0"));
+    CHECK(vm_eval_is(ctx, "var a = [{z: 0, x: 4}, {x: 5}]; sum_x(a)", "9"));
+    // Garbage before 'c', so that the GC moves it
+    CHECK(vm_eval_is(ctx, "garbage(100)", "0"));
+    CHECK(vm_eval_is(ctx, code, "3,3,9"));
+
+    clone = JS_CloneContext(ctx, clone_mem, PROP_CACHE_MEM_SIZE);
+    CHECK(clone);
+    CHECK(vm_eval_is(clone, "sum_x(a) + sum_x(c)", "12"));
+    CHECK(vm_eval_is(clone, "a[1] = {y: 0, z: 0, x: 6}; sum_x(a)", "10"));
+    CHECK(vm_eval_is(ctx, "sum_x(a)", "9"));
+    JS_FreeContext(clone);
+    free(clone_mem);
+    vm_free(ctx);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript property cache tests\n");
+    RUN_TEST(test_prop_cache_shapes, "a site sees objects of different shapes");
+    RUN_TEST(test_prop_cache_changes, "deleted, added and accessor properties");
+    RUN_TEST(test_prop_cache_relocation, "the cache survives a GC and a clone");
+    return test_summary("prop_cache_test");
+}
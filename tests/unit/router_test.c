@@ -0,0 +1,145 @@
+/**
+ * MTPScript HTTP router tests
+ * Specification §15 - HTTP server
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Routes are matched in a radix tree: literal segments win over
+ * parameters, an exact match over a prefix match, and the server finds
+ * the handler of a route by its index in the registry.
+ */
+
+#include "unit_test.h"
+#include "mquickjs_api.h"
+
+// Match 'path' and return the handler name, NULL if no route matches
+static const char *route_handler(MTPScriptRouteRegistry *r, MTPScriptHTTPMethod method, const char *path,
+                                 MTPScriptRouteMatch *match) {
+    MTPScriptRoute *route = mtpscript_route_match(r, method, path, match);
+
+    return route ? route->handler_name : NULL;
+}
+
+// True if parameter 'i' of 'match' is 'name' = 'value'
+static bool route_param_is(const MTPScriptRouteMatch *match, int i, const char *name, const char *value) {
+    return i < match->param_count && strcmp(match->params[i].name, name) == 0 &&
+           match->params[i].value_len == strlen(value) &&
+           memcmp(match->params[i].value, value, match->params[i].value_len) == 0;
+}
+
+static int test_router_priority(void) {
+    MTPScriptRouteRegistry *r = mtpscript_route_registry_new();
+    MTPScriptRouteMatch match;
+
+    CHECK(r);
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/users/:id", "get_user"));
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/users/me", "get_me"));
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/users/:id/posts/:post", "get_post"));
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/users/me/posts/latest", "get_latest"));
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_POST, "/users", "create_user"));
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/static", "static_files"));
+
+    // A literal segment wins over a parameter, whatever the order of
+    // registration
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, "/users/me", &match), "get_me") == 0);
+    CHECK(match.param_count == 0);
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, "/users/mel", &match), "get_user") == 0);
+    CHECK(route_param_is(&match, 0, "id", "mel"));
+    // The literal branch does not match to the end: back to the parameter
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, "/users/me/posts/7", &match), "get_post") == 0);
+    CHECK(route_param_is(&match, 0, "id", "me") && route_param_is(&match, 1, "post", "7"));
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, "/users/me/posts/latest", &match), "get_latest") == 0);
+
+    // Methods have separate routes
+    CHECK(route_handler(r, MTPSCRIPT_HTTP_GET, "/users", &match) == NULL);
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_POST, "/users?page=2", &match), "create_user") == 0);
+
+    // Without an exact match, the longest prefix ending at a '/'
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, "/static/css/site.css", &match), "static_files") == 0);
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, "/users/42/comments", &match), "get_user") == 0);
+    CHECK(route_param_is(&match, 0, "id", "42"));
+    CHECK(route_handler(r, MTPSCRIPT_HTTP_GET, "/staticfiles", &match) == NULL);
+    // A parameter matches a non-empty segment
+    CHECK(route_handler(r, MTPSCRIPT_HTTP_GET, "/users//posts/1", &match) == NULL);
+    mtpscript_route_registry_free(r);
+    return 1;
+}
+
+// Parameter values point into the request path, which ends at the query
+static int test_router_params(void) {
+    MTPScriptRouteRegistry *r = mtpscript_route_registry_new();
+    const char *path = "/orgs/acme/repos/mtp-script/issues/12?state=open";
+    MTPScriptRouteMatch match;
+
+    CHECK(r);
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/orgs/:org/repos/:repo/issues/:number", "issue"));
+    CHECK(strcmp(route_handler(r, MTPSCRIPT_HTTP_GET, path, &match), "issue") == 0);
+    CHECK(match.param_count == 3);
+    CHECK(route_param_is(&match, 0, "org", "acme"));
+    CHECK(route_param_is(&match, 1, "repo", "mtp-script"));
+    CHECK(route_param_is(&match, 2, "number", "12"));
+    CHECK(match.params[0].value == path + 6);
+    mtpscript_route_registry_free(r);
+    return 1;
+}
+
+// A failed add leaves the registry unchanged, so the route indexes keep
+// matching the handlers registered by the server
+static int test_router_add_failures(void) {
+    MTPScriptRouteRegistry *r = mtpscript_route_registry_new();
+    MTPScriptRouteMatch match;
+    MTPScriptRoute *route;
+    char pattern[256] = "";
+
+    CHECK(r);
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/a", "first"));
+    for (int i = 0; i <= MTPSCRIPT_ROUTE_MAX_PARAMS; i++) {
+        snprintf(pattern + strlen(pattern), sizeof(pattern) - strlen(pattern), "/:p%d", i);
+    }
+    CHECK(!mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, pattern, "too_many_params"));
+    CHECK(!mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_METHOD_COUNT, "/b", "unknown_method"));
+    CHECK(r->route_count == 1);
+
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/b", "second"));
+    route = mtpscript_route_match(r, MTPSCRIPT_HTTP_GET, "/b", &match);
+    CHECK(route == &r->routes[1] && strcmp(route->handler_name, "second") == 0);
+
+    // The same method and pattern again: the first route is kept
+    CHECK(mtpscript_route_registry_add(r, MTPSCRIPT_HTTP_GET, "/b", "third"));
+    route = mtpscript_route_match(r, MTPSCRIPT_HTTP_GET, "/b", &match);
+    CHECK(route == &r->routes[1] && r->route_count == 3);
+    mtpscript_route_registry_free(r);
+    return 1;
+}
+
+// The route array grows past its initial capacity
+static int test_router_many_routes(void) {
+    MTPScriptRouteRegistry *r = mtpscript_route_registry_new();
+    MTPScriptRouteMatch match;
+    char path[64], handler[64];
+
+    CHECK(r);
+    for (int i = 0; i < 500; i++) {
+        snprintf(path, sizeof(path), "/items/%d/:id", i);
+        snprintf(handler, sizeof(handler), "h%d", i);
+        CHECK(mtpscript_route_registry_add(r, i % 2 ? MTPSCRIPT_HTTP_PUT : MTPSCRIPT_HTTP_GET, path, handler));
+    }
+    for (int i = 0; i < 500; i++) {
+        snprintf(path, sizeof(path), "/items/%d/x%d", i, i);
+        snprintf(handler, sizeof(handler), "h%d", i);
+        CHECK(strcmp(route_handler(r, i % 2 ? MTPSCRIPT_HTTP_PUT : MTPSCRIPT_HTTP_GET, path, &match), handler) == 0);
+        CHECK(route_handler(r, i % 2 ? MTPSCRIPT_HTTP_GET : MTPSCRIPT_HTTP_PUT, path, &match) == NULL);
+    }
+    mtpscript_route_registry_free(r);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript HTTP router tests\n");
+    RUN_TEST(test_router_priority, "literals win over parameters, exact over prefix");
+    RUN_TEST(test_router_params, "parameters are slices of the path");
+    RUN_TEST(test_router_add_failures, "a failed add leaves the registry unchanged");
+    RUN_TEST(test_router_many_routes, "many routes and methods");
+    return test_summary("router_test");
+}
@@ -0,0 +1,164 @@
+/**
+ * MTPScript snapshot loader tests
+ * Specification §5.2 - Snapshots
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * A .msqs file is mapped, not read: its header sizes must match the file
+ * and, when a key is given, the content must carry a valid ECDSA-P256
+ * signature.
+ */
+
+// EC_KEY, like the crypto module
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include <stddef.h>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "unit_test.h"
+#include "src/snapshot/snapshot.h"
+
+#define SNAPSHOT_FILE "snapshot_test.msqs"
+
+static const char snapshot_content[] = "relocatable bytecode stand-in";
+
+// Return the error message of a load, NULL if it succeeded
+static const char *snapshot_try_load(const ECDSAPublicKey *key, mtpscript_snapshot_t **snapshot) {
+    static char message[128];
+    mtpscript_error_t *err = mtpscript_snapshot_load(SNAPSHOT_FILE, key, snapshot);
+
+    if (!err) return NULL;
+    snprintf(message, sizeof(message), "%s", mtpscript_string_cstr(err->message));
+    mtpscript_error_free(err);
+    return message;
+}
+
+// Sign 'data' with a new key: r(32) + s(32) in 'signature'
+static bool snapshot_sign(const uint8_t *data, size_t len, ECDSAPublicKey *pubkey, uint8_t *signature) {
+    EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    ECDSA_SIG *sig = NULL;
+    BIGNUM *x = BN_new(), *y = BN_new();
+    const BIGNUM *r, *s;
+    bool ok = false;
+
+    if (key && x && y && EC_KEY_generate_key(key) &&
+        EC_POINT_get_affine_coordinates(EC_KEY_get0_group(key), EC_KEY_get0_public_key(key), x, y, NULL)) {
+        SHA256(data, len, digest);
+        sig = ECDSA_do_sign(digest, sizeof(digest), key);
+    }
+    if (sig) {
+        ECDSA_SIG_get0(sig, &r, &s);
+        ok = BN_bn2binpad(x, pubkey->x, 32) == 32 && BN_bn2binpad(y, pubkey->y, 32) == 32 &&
+             BN_bn2binpad(r, signature, 32) == 32 && BN_bn2binpad(s, signature + 32, 32) == 32;
+    }
+    ECDSA_SIG_free(sig);
+    BN_free(x);
+    BN_free(y);
+    EC_KEY_free(key);
+    return ok;
+}
+
+// Overwrite 'len' bytes of the snapshot file at 'offset'
+static void snapshot_patch(long offset, const void *data, size_t len) {
+    FILE *f = fopen(SNAPSHOT_FILE, "r+b");
+
+    fseek(f, offset, SEEK_SET);
+    fwrite(data, 1, len, f);
+    fclose(f);
+}
+
+static int test_snapshot_map(void) {
+    mtpscript_snapshot_t *snapshot;
+    uint8_t signature[64];
+
+    memset(signature, 0xab, sizeof(signature));
+    CHECK(!mtpscript_snapshot_create(snapshot_content, sizeof(snapshot_content), "{\"v\":1}",
+                                     signature, sizeof(signature), SNAPSHOT_FILE));
+    CHECK(snapshot_try_load(NULL, &snapshot) == NULL);
+    CHECK(snapshot->header.content_size == sizeof(snapshot_content));
+    CHECK(strncmp(snapshot->metadata, "{\"v\":1}", 7) == 0);
+    // The metadata is padded so that the content is aligned
+    CHECK(((uintptr_t)snapshot->content & 15) == 0);
+    CHECK(memcmp(snapshot->content, snapshot_content, sizeof(snapshot_content)) == 0);
+    CHECK(snapshot->signature && memcmp(snapshot->signature, signature, 64) == 0);
+
+    // Writes to the content (a relocation) are private to the mapping
+    memset(snapshot->content, 0, snapshot->header.content_size);
+    mtpscript_snapshot_free(snapshot);
+    CHECK(snapshot_try_load(NULL, &snapshot) == NULL);
+    CHECK(memcmp(snapshot->content, snapshot_content, sizeof(snapshot_content)) == 0);
+    mtpscript_snapshot_free(snapshot);
+    remove(SNAPSHOT_FILE);
+    return 1;
+}
+
+static int test_snapshot_bounds(void) {
+    mtpscript_snapshot_t *snapshot = NULL;
+    uint32_t huge = 0xfffffff0;
+    const char *err;
+
+    CHECK(snapshot_try_load(NULL, &snapshot) != NULL);
+
+    CHECK(!mtpscript_snapshot_create(snapshot_content, sizeof(snapshot_content), "{}", NULL, 0, SNAPSHOT_FILE));
+    CHECK(truncate(SNAPSHOT_FILE, sizeof(mtpscript_snapshot_header_t) - 1) == 0);
+    err = snapshot_try_load(NULL, &snapshot);
+    CHECK(err && strstr(err, "truncated"));
+
+    CHECK(!mtpscript_snapshot_create(snapshot_content, sizeof(snapshot_content), "{}", NULL, 0, SNAPSHOT_FILE));
+    // A content size which would overflow a 32 bit sum
+    snapshot_patch(offsetof(mtpscript_snapshot_header_t, content_size), &huge, sizeof(huge));
+    err = snapshot_try_load(NULL, &snapshot);
+    CHECK(err && strstr(err, "do not match"));
+
+    CHECK(!mtpscript_snapshot_create(snapshot_content, sizeof(snapshot_content), "{}", NULL, 0, SNAPSHOT_FILE));
+    snapshot_patch(0, "MSQX", 4);
+    err = snapshot_try_load(NULL, &snapshot);
+    CHECK(err && strstr(err, "header"));
+    remove(SNAPSHOT_FILE);
+    return 1;
+}
+
+static int test_snapshot_signature(void) {
+    mtpscript_snapshot_t *snapshot;
+    ECDSAPublicKey pubkey;
+    uint8_t signature[64];
+    struct stat st;
+    const char *err;
+
+    CHECK(snapshot_sign((const uint8_t *)snapshot_content, sizeof(snapshot_content), &pubkey, signature));
+    CHECK(!mtpscript_snapshot_create(snapshot_content, sizeof(snapshot_content), "{}",
+                                     signature, sizeof(signature), SNAPSHOT_FILE));
+    CHECK(snapshot_try_load(&pubkey, &snapshot) == NULL);
+    mtpscript_snapshot_free(snapshot);
+    // Signed with another key
+    err = snapshot_try_load(&mtpscript_public_key, &snapshot);
+    CHECK(err && strstr(err, "signature"));
+
+    // One byte of the content changed
+    CHECK(stat(SNAPSHOT_FILE, &st) == 0);
+    snapshot_patch((long)(st.st_size - 64 - 2), "X", 1);
+    err = snapshot_try_load(&pubkey, &snapshot);
+    CHECK(err && strstr(err, "signature"));
+
+    // Unsigned snapshots are only loaded without a key
+    CHECK(!mtpscript_snapshot_create(snapshot_content, sizeof(snapshot_content), "{}", NULL, 0, SNAPSHOT_FILE));
+    CHECK(snapshot_try_load(&pubkey, &snapshot) != NULL);
+    CHECK(snapshot_try_load(NULL, &snapshot) == NULL && snapshot->signature == NULL);
+    mtpscript_snapshot_free(snapshot);
+    remove(SNAPSHOT_FILE);
+    return 1;
+}
+
+int main(void) {
+    printf("MTPScript snapshot loader tests\n");
+    RUN_TEST(test_snapshot_map, "the content is mapped, aligned and copy-on-write");
+    RUN_TEST(test_snapshot_bounds, "truncated and inconsistent files are rejected");
+    RUN_TEST(test_snapshot_signature, "the signature is verified with the given key");
+    return test_summary("snapshot_test");
+}
@@ -0,0 +1,65 @@
+/**
+ * MTPScript unit test helpers
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Each component test is one executable made of 'static int test_xxx(void)'
+ * functions returning 1 (pass), 0 (fail) or -1 (skip), run with RUN_TEST()
+ * from main(), which returns test_summary().
+ */
+
+#ifndef MTPSCRIPT_UNIT_TEST_H
+#define MTPSCRIPT_UNIT_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define TEST_PASS "\033[32mPASS\033[0m"
+#define TEST_FAIL "\033[31mFAIL\033[0m"
+#define TEST_SKIP "\033[33mSKIP\033[0m"
+
+typedef struct {
+    int passed;
+    int failed;
+    int skipped;
+    int total;
+} test_stats_t;
+
+static test_stats_t stats = {0, 0, 0, 0};
+
+#define RUN_TEST(test_func, description) do { \
+    stats.total++; \
+    printf("  [%3d] %-60s ", stats.total, description); \
+    fflush(stdout); \
+    int result = test_func(); \
+    if (result == 1) { \
+        printf("[%s]\n", TEST_PASS); \
+        stats.passed++; \
+    } else if (result == 0) { \
+        printf("[%s]\n", TEST_FAIL); \
+        stats.failed++; \
+    } else { \
+        printf("[%s]\n", TEST_SKIP); \
+        stats.skipped++; \
+    } \
+} while(0)
+
+// Report a failed check with its location and fail the current test
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("\n        %s:%d: %s ", __FILE__, __LINE__, #cond); \
+        return 0; \
+    } \
+} while(0)
+
+static int test_summary(const char *name) {
+    printf("%s: %d/%d passed", name, stats.passed, stats.total);
+    if (stats.skipped) printf(", %d skipped", stats.skipped);
+    printf("\n");
+    return stats.failed ? 1 : 0;
+}
+
+#endif // MTPSCRIPT_UNIT_TEST_H
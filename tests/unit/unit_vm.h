@@ -0,0 +1,107 @@
+/**
+ * MTPScript unit test helpers for the runtime
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ *
+ * Provides the host functions of the standard library table, so that a
+ * test links with the runtime objects only, and helpers to evaluate
+ * code in a context.
+ */
+
+#ifndef MTPSCRIPT_UNIT_VM_H
+#define MTPSCRIPT_UNIT_VM_H
+
+#include "unit_test.h"
+#include "mquickjs.h"
+
+static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    for (int i = 0; i < argc; i++) {
+        if (i != 0) fputc(' ', stderr);
+        JS_PrintValueF(ctx, argv[i], JS_DUMP_LONG);
+    }
+    fputc('\n', stderr);
+    return JS_UNDEFINED;
+}
+
+static JSValue js_gc(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    JS_GC(ctx);
+    return JS_UNDEFINED;
+}
+
+#if !MTPSCRIPT_DETERMINISTIC
+static JSValue js_unavailable(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_ThrowTypeError(ctx, "not available in a test");
+}
+
+#define js_date_now js_unavailable
+#define js_performance_now js_unavailable
+#define js_load js_unavailable
+#define js_setTimeout js_unavailable
+#define js_clearTimeout js_unavailable
+#endif
+
+#include "mtpjs_stdlib.h"
+
+static void vm_log_func(void *opaque, const void *buf, size_t buf_len) {
+    fwrite(buf, 1, buf_len, stderr);
+}
+
+// Create a context in a malloc'ed arena of 'mem_size' bytes
+static inline JSContext *vm_new(size_t mem_size) {
+    void *mem = malloc(mem_size);
+    JSContext *ctx;
+
+    if (!mem) return NULL;
+    ctx = JS_NewContext(mem, mem_size, &js_stdlib);
+    if (!ctx) {
+        free(mem);
+        return NULL;
+    }
+    JS_SetLogFunc(ctx, vm_log_func);
+    return ctx;
+}
+
+// Free a context created by vm_new(), which starts its arena
+static inline void vm_free(JSContext *ctx) {
+    JS_FreeContext(ctx);
+    free(ctx);
+}
+
+// Evaluate 'code' and store its result, or the exception, as a string
+// in 'buf'. Return 0 if OK, -1 if an exception was thrown.
+static inline int vm_eval(JSContext *ctx, const char *code, char *buf, size_t buf_size) {
+    JSCStringBuf sbuf;
+    const char *str;
+    JSValue val;
+    int ret = 0;
+
+    val = JS_Eval(ctx, code, strlen(code), "<test>", JS_EVAL_RETVAL);
+    if (JS_IsException(val)) {
+        val = JS_GetException(ctx);
+        ret = -1;
+        // Typed errors are plain {error, code, message} objects. Only
+        // their name is kept: no code can run once the gas is exhausted.
+        if (JS_GetClassID(ctx, val) == JS_CLASS_OBJECT) {
+            JSValue name = JS_GetPropertyStr(ctx, val, "error");
+            if (JS_IsString(ctx, name)) val = name;
+        }
+    }
+    val = JS_ToString(ctx, val);
+    str = JS_IsException(val) ? NULL : JS_ToCString(ctx, val, &sbuf);
+    snprintf(buf, buf_size, "%s", str ? str : "<exception>");
+    return ret;
+}
+
+// True if 'code' evaluates without exception to 'expected'
+static inline bool vm_eval_is(JSContext *ctx, const char *code, const char *expected) {
+    char buf[256];
+
+    if (vm_eval(ctx, code, buf, sizeof(buf)) != 0 || strcmp(buf, expected) != 0) {
+        printf("\n        %s -> %s (expected %s) ", code, buf, expected);
+        return false;
+    }
+    return true;
+}
+
+#endif // MTPSCRIPT_UNIT_VM_H
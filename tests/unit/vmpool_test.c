@@ -0,0 +1,166 @@
+/**
+ * MTPScript VM pool tests
+ * Specification §5.2 - Per-request VM cloning
+ *
+ * Copyright (c) 2025 My Tech Passport Inc.
+ * Author: Ryan Wong
+ */
+
+#include "unit_vm.h"
+#include "mquickjs_vmpool.h"
+
+#define POOL_MEM_SIZE (1024 * 1024)
+
+static JSContext *template_ctx;
+static int init_count;
+
+static void pool_init_vm(JSContext *ctx, void *opaque) {
+    init_count++;
+    JS_SetLogFunc(ctx, vm_log_func);
+}
+
+static MTPScriptVMPool *pool_new(int size, bool use_images) {
+    MTPScriptVMPoolConfig config;
+
+    mtpscript_vm_pool_config_init(&config);
+    config.size = size;
+    config.low_water = 1;
+    config.mem_size = POOL_MEM_SIZE;
+    config.use_images = use_images;
+    config.init_vm = pool_init_vm;
+    return mtpscript_vm_pool_new(template_ctx, &config);
+}
+
+static int test_pool_warm(void) {
+    MTPScriptVMPoolStats s;
+    MTPScriptVMPool *pool;
+
+    init_count = 0;
+    pool = pool_new(3, true);
+    CHECK(pool);
+    mtpscript_vm_pool_get_stats(pool, &s);
+    CHECK(s.ready == 3 && s.in_use == 0 && s.refills == 3);
+    CHECK(init_count == 3);
+    mtpscript_vm_pool_free(pool);
+    return 1;
+}
+
+static int test_pool_exhausted(void) {
+    MTPScriptVMPool *pool = pool_new(2, true);
+    JSContext *a, *b;
+
+    CHECK(pool);
+    a = mtpscript_vm_pool_acquire(pool);
+    b = mtpscript_vm_pool_acquire(pool);
+    CHECK(a && b && a != b);
+    CHECK(mtpscript_vm_pool_acquire(pool) == NULL);
+    mtpscript_vm_pool_release(pool, a);
+    mtpscript_vm_pool_release(pool, b);
+    mtpscript_vm_pool_free(pool);
+    return 1;
+}
+
+// A request sees the template state, never the previous request's
+static int pool_isolation(bool use_images) {
+    MTPScriptVMPool *pool = pool_new(2, use_images);
+    JSContext *ctx;
+
+    CHECK(pool);
+    for (int i = 0; i < 6; i++) {
+        ctx = mtpscript_vm_pool_acquire(pool);
+        CHECK(ctx);
+        CHECK(vm_eval_is(ctx, "typeof secret", "undefined"));
+        CHECK(vm_eval_is(ctx, "bump(5)", "6"));
+        CHECK(vm_eval_is(ctx, "var secret = 'request data'; bump(1)", "7"));
+        mtpscript_vm_pool_release(pool, ctx);
+        mtpscript_vm_pool_refill(pool);
+    }
+    mtpscript_vm_pool_free(pool);
+    CHECK(vm_eval_is(template_ctx, "bump(0)", "1"));
+    return 1;
+}
+
+static int test_pool_isolation_image(void) {
+    return pool_isolation(true);
+}
+
+static int test_pool_isolation_arena(void) {
+    return pool_isolation(false);
+}
+
+static int test_pool_refill(void) {
+    MTPScriptVMPool *pool = pool_new(3, true);
+    MTPScriptVMPoolStats s;
+    JSContext *a, *b, *c;
+
+    CHECK(pool);
+    a = mtpscript_vm_pool_acquire(pool);
+    CHECK(!mtpscript_vm_pool_needs_refill(pool));
+    b = mtpscript_vm_pool_acquire(pool);
+    c = mtpscript_vm_pool_acquire(pool);
+    // Every slot is in use: nothing to refill
+    CHECK(!mtpscript_vm_pool_needs_refill(pool));
+    mtpscript_vm_pool_release(pool, a);
+    CHECK(mtpscript_vm_pool_needs_refill(pool));
+    CHECK(mtpscript_vm_pool_refill(pool) == 1);
+    mtpscript_vm_pool_release(pool, b);
+    mtpscript_vm_pool_release(pool, c);
+
+    // Empty slots are cloned on the request path
+    a = mtpscript_vm_pool_acquire(pool);
+    b = mtpscript_vm_pool_acquire(pool);
+    CHECK(a && b);
+    mtpscript_vm_pool_get_stats(pool, &s);
+    CHECK(s.hits == 4 && s.misses == 1 && s.in_use == 2 && s.ready == 0);
+    mtpscript_vm_pool_release(pool, a);
+    mtpscript_vm_pool_release(pool, b);
+    mtpscript_vm_pool_get_stats(pool, &s);
+    CHECK(s.in_use == 0);
+    mtpscript_vm_pool_free(pool);
+    return 1;
+}
+
+// Releasing a VM twice, or one the pool did not hand out, is reported
+// and leaves the pool unchanged
+static int test_pool_bad_release(void) {
+    MTPScriptVMPool *pool = pool_new(2, false);
+    MTPScriptVMPoolStats s;
+    JSContext *a, *b;
+
+    CHECK(pool);
+    a = mtpscript_vm_pool_acquire(pool);
+    b = mtpscript_vm_pool_acquire(pool);
+    CHECK(a && b);
+    CHECK(mtpscript_vm_pool_release(pool, a));
+    CHECK(!mtpscript_vm_pool_release(pool, a));
+    CHECK(!mtpscript_vm_pool_release(pool, template_ctx));
+    mtpscript_vm_pool_get_stats(pool, &s);
+    CHECK(s.release_failures == 2 && s.in_use == 1);
+    CHECK(vm_eval_is(b, "bump(2)", "3"));
+    CHECK(mtpscript_vm_pool_release(pool, b));
+    mtpscript_vm_pool_free(pool);
+    return 1;
+}
+
+int main(void) {
+    int ret;
+
+    printf("MTPScript VM pool tests\n");
+    template_ctx = vm_new(POOL_MEM_SIZE);
+    if (!template_ctx ||
+        !vm_eval_is(template_ctx, "var cfg = {n: 1}; function bump(x) { cfg.n = cfg.n + x; return cfg.n; } 0", "0")) {
+        printf("cannot create the template context\n");
+        return 1;
+    }
+
+    RUN_TEST(test_pool_warm, "pool is warmed up to its size");
+    RUN_TEST(test_pool_exhausted, "acquire fails when every slot is in use");
+    RUN_TEST(test_pool_isolation_image, "release wipes image backed VMs");
+    RUN_TEST(test_pool_isolation_arena, "release wipes reserved arena VMs");
+    RUN_TEST(test_pool_refill, "refill below the low-water mark");
+    RUN_TEST(test_pool_bad_release, "unknown VMs are not released");
+
+    ret = test_summary("vmpool_test");
+    vm_free(template_ctx);
+    return ret;
+}
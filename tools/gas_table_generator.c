@@ -0,0 +1,253 @@
+/*
+ * MTPScript Gas Table Generator
+ * Based on Annex A of MTPScript V5.1 specification
+ *
+ * Reads gas-v5.1.csv and writes mquickjs_gas.h: the 'gas_cost' table
+ * indexed by interpreter opcode and one GAS_COST_OP_xxx define per CSV
+ * row for the costs charged by the built-in C functions.
+ *
+ * The CSV describes abstract operations, so every interpreter opcode is
+ * mapped to one CSV row below. An opcode without a mapping, a mapping to
+ * a missing row or a cost which does not fit in a uint8_t fails the
+ * build.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *opcode_names[] = {
+#define FMT(f)
+#define DEF(id, size, n_pop, n_push, f) #id,
+#define def(id, size, n_pop, n_push, f)
+#include "mquickjs_opcode.h"
+#undef def
+#undef DEF
+#undef FMT
+};
+
+#define OPCODE_COUNT (sizeof(opcode_names) / sizeof(opcode_names[0]))
+
+typedef struct {
+    const char *opcode;     /* interpreter opcode, a trailing '*' matches a prefix */
+    const char *row;        /* CSV row, NULL = free */
+} GasMapping;
+
+/* first match wins */
+static const GasMapping gas_mappings[] = {
+    /* never executed or charged elsewhere */
+    { "invalid", NULL },
+    { "nop", NULL },
+    { "gas", NULL },
+
+    /* arithmetic */
+    { "add", "OP_ADD" },
+    { "sub", "OP_SUB" },
+    { "mul", "OP_MUL" },
+    { "pow", "OP_MUL" },
+    { "div", "OP_DIV" },
+    { "mod", "OP_MOD" },
+    { "neg", "OP_NEG" },
+    { "plus", "OP_NEG" },
+    { "not", "OP_NEG" },
+    { "inc", "OP_ADD" },
+    { "dec", "OP_SUB" },
+    { "post_inc", "OP_ADD" },
+    { "post_dec", "OP_SUB" },
+    { "shl", "OP_ADD" },
+    { "sar", "OP_ADD" },
+    { "shr", "OP_ADD" },
+    { "and", "OP_LAND" },
+    { "or", "OP_LOR" },
+    { "xor", "OP_LOR" },
+
+    /* comparison and logic */
+    { "lt", "OP_LT" },
+    { "lte", "OP_LE" },
+    { "gt", "OP_GT" },
+    { "gte", "OP_GE" },
+    { "eq", "OP_EQ" },
+    { "neq", "OP_NE" },
+    { "strict_eq", "OP_STRICT_EQ" },
+    { "strict_neq", "OP_STRICT_NE" },
+    { "lnot", "OP_LNOT" },
+    { "typeof", "OP_TYPEOF" },
+    { "delete", "OP_DELETE" },
+    { "instanceof", "OP_INSTANCEOF" },
+    { "in", "OP_IN" },
+
+    /* stack */
+    { "push_*", "OP_STACK_PUSH" },
+    { "undefined", "OP_STACK_PUSH" },
+    { "null", "OP_STACK_PUSH" },
+    { "this_func", "OP_STACK_PUSH" },
+    { "arguments", "OP_STACK_PUSH" },
+    { "new_target", "OP_STACK_PUSH" },
+    { "dup*", "OP_STACK_PUSH" },
+    { "insert*", "OP_STACK_PUSH" },
+    { "perm*", "OP_STACK_PUSH" },
+    { "swap*", "OP_STACK_PUSH" },
+    { "rot*", "OP_STACK_PUSH" },
+    { "drop", "OP_STACK_POP" },
+    { "nip*", "OP_STACK_POP" },
+
+    /* variables */
+    { "get_loc*", "OP_STACK_PUSH" },
+    { "get_arg*", "OP_STACK_PUSH" },
+    { "get_var_ref*", "OP_STACK_PUSH" },
+    { "put_loc*", "OP_ASSIGN" },
+    { "put_arg*", "OP_ASSIGN" },
+    { "put_var_ref*", "OP_ASSIGN" },
+
+    /* properties */
+    { "get_field*", "OP_PROP_ACCESS" },
+    { "get_length*", "OP_PROP_ACCESS" },
+    { "put_field", "OP_PROP_ASSIGN" },
+    { "define_*", "OP_PROP_ASSIGN" },
+    { "set_proto", "OP_PROP_ASSIGN" },
+    { "get_array_el*", "OP_ARRAY_ACCESS" },
+    { "put_array_el", "OP_ARRAY_ASSIGN" },
+
+    /* allocation */
+    { "object", "OP_OBJECT_NEW" },
+    { "regexp", "OP_OBJECT_NEW" },
+    { "array_from", "OP_ARRAY_NEW" },
+    { "fclosure*", "OP_FUNC_DECL" },
+
+    /* calls */
+    { "call", "OP_FUNC_CALL" },
+    { "call_method", "OP_FUNC_CALL" },
+    { "call_constructor", "OP_NEW" },
+    { "return*", "OP_RETURN" },
+    { "throw", "OP_THROW" },
+
+    /* control flow */
+    { "if_*", "OP_IF" },
+    { "goto*", "OP_BREAK" },
+    { "catch", "OP_CATCH" },
+    { "gosub", "OP_FINALLY" },
+    { "ret", "OP_SCOPE_EXIT" },
+    { "for_in_start", "OP_FOR" },
+    { "for_of_start", "OP_FOR" },
+    { "for_of_next", "OP_CONTINUE" },
+};
+
+typedef struct {
+    char name[64];
+    int cost;
+} GasRow;
+
+static GasRow *rows;
+static int row_count;
+
+static void __attribute__((noreturn)) fatal(const char *fmt, const char *arg)
+{
+    fprintf(stderr, "gas_table_generator: ");
+    fprintf(stderr, fmt, arg);
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+static void load_csv(const char *filename)
+{
+    char line[256], *name, *desc, *cost, *end;
+    int row_size = 0, line_num = 0;
+    FILE *f;
+
+    f = fopen(filename, "r");
+    if (!f)
+        fatal("cannot open '%s'", filename);
+    while (fgets(line, sizeof(line), f)) {
+        line_num++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line_num == 1 || line[0] == '\0')
+            continue; /* header */
+        name = strtok(line, ",");
+        desc = strtok(NULL, ",");
+        cost = strtok(NULL, ",");
+        if (!name || !desc || !cost || strlen(name) >= sizeof(rows[0].name))
+            fatal("malformed row in '%s'", filename);
+        if (row_count >= row_size) {
+            row_size = row_size ? row_size * 2 : 128;
+            rows = realloc(rows, sizeof(rows[0]) * row_size);
+            if (!rows)
+                fatal("%s", "out of memory");
+        }
+        strcpy(rows[row_count].name, name);
+        rows[row_count].cost = strtol(cost, &end, 10);
+        if (*end != '\0' || rows[row_count].cost < 0)
+            fatal("invalid cost for '%s'", name);
+        row_count++;
+    }
+    fclose(f);
+}
+
+static const GasRow *find_row(const char *name)
+{
+    int i;
+    for(i = 0; i < row_count; i++) {
+        if (!strcmp(rows[i].name, name))
+            return &rows[i];
+    }
+    fatal("missing CSV row '%s'", name);
+}
+
+static const GasMapping *find_mapping(const char *opcode)
+{
+    const GasMapping *m;
+    size_t i, len;
+
+    for(i = 0; i < sizeof(gas_mappings) / sizeof(gas_mappings[0]); i++) {
+        m = &gas_mappings[i];
+        len = strlen(m->opcode);
+        if (m->opcode[len - 1] == '*') {
+            if (!strncmp(m->opcode, opcode, len - 1))
+                return m;
+        } else if (!strcmp(m->opcode, opcode)) {
+            return m;
+        }
+    }
+    fatal("no gas mapping for opcode '%s'", opcode);
+}
+
+int main(int argc, char **argv)
+{
+    const GasMapping *m;
+    const GasRow *r;
+    size_t i;
+    int cost;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s gas-v5.1.csv > mquickjs_gas.h\n", argv[0]);
+        return 1;
+    }
+    load_csv(argv[1]);
+
+    printf("/* this file is automatically generated by gas_table_generator - do not edit */\n\n");
+    printf("#ifndef MQUICKJS_GAS_H\n");
+    printf("#define MQUICKJS_GAS_H\n\n");
+
+    printf("/* gas charged by each interpreter opcode */\n");
+    printf("static const uint8_t gas_cost[OP_COUNT] = {\n");
+    for(i = 0; i < OPCODE_COUNT; i++) {
+        m = find_mapping(opcode_names[i]);
+        cost = 0;
+        if (m->row) {
+            r = find_row(m->row);
+            cost = r->cost;
+            if (cost > 255)
+                fatal("cost of '%s' does not fit in a uint8_t", m->row);
+        }
+        printf("    %d, /* %s%s%s */\n", cost, opcode_names[i],
+               m->row ? " = " : "", m->row ? m->row : "");
+    }
+    printf("};\n\n");
+
+    printf("/* Annex A costs of the built-in functions */\n");
+    for(i = 0; i < row_count; i++) {
+        printf("#define GAS_COST_%s %d\n", rows[i].name, rows[i].cost);
+    }
+    printf("\n#endif /* MQUICKJS_GAS_H */\n");
+    free(rows);
+    return 0;
+}